@@ -151,6 +151,7 @@ SOURCES += \
     qsettings.cpp \
     qstring.cpp \
     qstringlist.cpp \
+    qstringsearch.cpp \
     qsystemerror.cpp \
     qtemporaryfile.cpp \
     qtextstream.cpp \
@@ -205,6 +206,7 @@ HEADERS += \
     qstring.h \
     qstringlist.h \
     qstringmatcher.h \
+    qstringsearch_p.h \
     qsystemerror_p.h \
     qtemporaryfile.h \
     qtextstream.h \
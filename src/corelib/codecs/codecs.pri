@@ -2,11 +2,15 @@
 
 HEADERS += \
     codecs/qtextcodec_p.h \
-    codecs/qutfcodec_p.h
+    codecs/qutfcodec_p.h \
+    codecs/qutfcodec_simd_p.h
 
 SOURCES += \
     codecs/qutfcodec.cpp
 
+SSE4_1_SOURCES += codecs/qutfcodec_sse4.cpp
+AVX2_SOURCES += codecs/qutfcodec_avx2.cpp
+
 qtConfig(textcodec) {
     HEADERS += \
         codecs/qlatincodec_p.h \
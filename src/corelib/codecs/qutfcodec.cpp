@@ -39,6 +39,7 @@
 ****************************************************************************/
 
 #include "qutfcodec_p.h"
+#include "qutfcodec_simd_p.h"
 #include "qlist.h"
 #include "qendian.h"
 #include "qchar.h"
@@ -370,6 +371,171 @@ static inline const uchar *simdFindNonAscii(const uchar *src, const uchar *end,
 }
 #endif
 
+#ifdef QT_UTF8_SIMD
+static Q_DECL_RELAXED_CONSTEXPR QUtf8SimdTables makeUtf8SimdTables()
+{
+    QUtf8SimdTables tables = {};
+
+    // UTF-8 to UTF-16, six code points of one or two bytes: bit n of the
+    // index is set if code point n has two bytes
+    for (int index = 0; index < 64; ++index) {
+        uchar *shuffle = tables.decodeShuffle[index];
+        int pos = 0;
+        for (int n = 0; n < 6; ++n) {
+            const int length = 1 + ((index >> n) & 1);
+            shuffle[2 * n] = uchar(pos + length - 1);
+            shuffle[2 * n + 1] = length == 2 ? uchar(pos) : 0xff;
+            pos += length;
+        }
+        for (int i = 12; i < 16; ++i)
+            shuffle[i] = 0xff;
+    }
+
+    // four code points of one to three bytes: the index is 64 plus the
+    // lengths minus one, as a number in base 3
+    for (int index = 0; index < 81; ++index) {
+        uchar *shuffle = tables.decodeShuffle[64 + index];
+        int pos = 0;
+        for (int n = 0, lengths = index; n < 4; ++n, lengths /= 3) {
+            const int length = 1 + lengths % 3;
+            shuffle[4 * n] = uchar(pos + length - 1);
+            shuffle[4 * n + 1] = length >= 2 ? uchar(pos + length - 2) : 0xff;
+            shuffle[4 * n + 2] = length == 3 ? uchar(pos) : 0xff;
+            shuffle[4 * n + 3] = 0xff;
+            pos += length;
+        }
+    }
+
+    for (int ends = 0; ends < 4096; ++ends) {
+        int lengths[12] = {};
+        int count = 0;
+        for (int i = 0, start = 0; i < 12; ++i) {
+            if (ends & (1 << i)) {
+                lengths[count++] = i - start + 1;
+                start = i + 1;
+            }
+        }
+
+        int twoBytes = 0;
+        int threeBytes = 0;
+        int consumed6 = 0;
+        int consumed4 = 0;
+        for (int n = 0, weight = 1; n < 6; ++n, weight *= 3) {
+            twoBytes |= (lengths[n] > 2 ? 0x100 : lengths[n] == 2) << n;
+            consumed6 += lengths[n];
+            if (n < 4) {
+                threeBytes += lengths[n] > 3 ? 0x100 : (lengths[n] - 1) * weight;
+                consumed4 += lengths[n];
+            }
+        }
+
+        uchar *index = tables.decodeIndex[ends];
+        if (count >= 6 && twoBytes < 64) {
+            index[0] = uchar(twoBytes);
+            index[1] = uchar(consumed6);
+        } else if (count >= 4 && threeBytes < 81) {
+            index[0] = uchar(64 + threeBytes);
+            index[1] = uchar(consumed4);
+        } else {
+            index[0] = QUtf8SimdTables::DecodeOne;
+        }
+    }
+
+    // UTF-16 to UTF-8, eight code units of one or two bytes
+    for (int index = 0; index < 256; ++index) {
+        uchar *shuffle = tables.encode2Shuffle[index];
+        int pos = 0;
+        for (int n = 0; n < 8; ++n) {
+            shuffle[pos++] = uchar(2 * n);
+            if (!(index & (1 << n)))
+                shuffle[pos++] = uchar(2 * n + 1);
+        }
+        while (pos < 16)
+            shuffle[pos++] = 0xff;
+    }
+
+    // four code units of one to three bytes
+    for (int index = 0; index < 256; ++index) {
+        uchar *shuffle = tables.encode3Shuffle[index];
+        int pos = 0;
+        for (int n = 0; n < 4; ++n) {
+            const int length = (index & (0x10 << n)) ? 3 : (index & (1 << n)) ? 2 : 1;
+            for (int i = 0; i < length; ++i)
+                shuffle[pos++] = uchar(4 * n + i);
+        }
+        tables.encode3Length[index] = uchar(pos);
+        while (pos < 16)
+            shuffle[pos++] = 0xff;
+    }
+    return tables;
+}
+
+constexpr QUtf8SimdTables qt_utf8SimdTables = makeUtf8SimdTables();
+#endif // QT_UTF8_SIMD
+
+// Converts the multi-byte sequences starting at src in bulk, if the CPU
+// allows it. The caller continues with the scalar code up to nextAscii.
+static inline void simdDecodeUtf8(ushort *&dst, const uchar *&nextAscii, const uchar *&src, const uchar *end)
+{
+#ifdef QT_UTF8_SIMD
+#  if defined(QT_COMPILER_SUPPORTS_AVX2)
+    if (qCpuHasFeature(AVX2)) {
+        nextAscii = qt_utf8ToUtf16_avx2(dst, src, end);
+        return;
+    }
+#  endif
+    if (qCpuHasFeature(SSE4_1))
+        nextAscii = qt_utf8ToUtf16_sse4(dst, src, end);
+#else
+    Q_UNUSED(dst);
+    Q_UNUSED(nextAscii);
+    Q_UNUSED(src);
+    Q_UNUSED(end);
+#endif
+}
+
+static inline void simdEncodeUtf8(uchar *&dst, const ushort *&nextAscii, const ushort *&src, const ushort *end)
+{
+#ifdef QT_UTF8_SIMD
+#  if defined(QT_COMPILER_SUPPORTS_AVX2)
+    if (qCpuHasFeature(AVX2)) {
+        nextAscii = qt_utf16ToUtf8_avx2(dst, src, end);
+        return;
+    }
+#  endif
+    if (qCpuHasFeature(SSE4_1))
+        nextAscii = qt_utf16ToUtf8_sse4(dst, src, end);
+#else
+    Q_UNUSED(dst);
+    Q_UNUSED(nextAscii);
+    Q_UNUSED(src);
+    Q_UNUSED(end);
+#endif
+}
+
+// Returns false if [src, end) is known to be invalid. Otherwise, the caller
+// continues with the scalar code up to nextAscii.
+static inline bool simdValidateUtf8(const uchar *&nextAscii, const uchar *&src, const uchar *end)
+{
+#ifdef QT_UTF8_SIMD
+#  if defined(QT_COMPILER_SUPPORTS_AVX2)
+    if (qCpuHasFeature(AVX2)) {
+        nextAscii = end;
+        return qt_validateUtf8_avx2(src, end);
+    }
+#  endif
+    if (qCpuHasFeature(SSE4_1)) {
+        nextAscii = end;
+        return qt_validateUtf8_sse4(src, end);
+    }
+#else
+    Q_UNUSED(nextAscii);
+    Q_UNUSED(src);
+    Q_UNUSED(end);
+#endif
+    return true;
+}
+
 QByteArray QUtf8::convertFromUnicode(const QChar *uc, int len)
 {
     // create a QByteArray with the worst case scenario size
@@ -383,6 +549,10 @@ QByteArray QUtf8::convertFromUnicode(const QChar *uc, int len)
         if (simdEncodeAscii(dst, nextAscii, src, end))
             break;
 
+        simdEncodeUtf8(dst, nextAscii, src, end);
+        if (src == end)
+            break;
+
         do {
             ushort uc = *src++;
             int res = QUtf8Functions::toUtf8<QUtf8BaseTraits>(uc, dst, src, end);
@@ -434,8 +604,13 @@ QByteArray QUtf8::convertFromUnicode(const QChar *uc, int len, QTextCodec::Conve
             surrogate_high = -1;
             res = QUtf8Functions::toUtf8<QUtf8BaseTraits>(uc, cursor, src, end);
         } else {
-            if (src >= nextAscii && simdEncodeAscii(cursor, nextAscii, src, end))
-                break;
+            if (src >= nextAscii) {
+                if (simdEncodeAscii(cursor, nextAscii, src, end))
+                    break;
+                simdEncodeUtf8(cursor, nextAscii, src, end);
+                if (src == end)
+                    break;
+            }
 
             uc = *src++;
             res = QUtf8Functions::toUtf8<QUtf8BaseTraits>(uc, cursor, src, end);
@@ -526,6 +701,10 @@ QChar *QUtf8::convertToUnicode(QChar *buffer, const char *chars, int len) noexce
             if (simdDecodeAscii(dst, nextAscii, src, end))
                 break;
 
+            simdDecodeUtf8(dst, nextAscii, src, end);
+            if (src == end)
+                break;
+
             do {
                 uchar b = *src++;
                 int res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, src, end);
@@ -613,8 +792,15 @@ QString QUtf8::convertToUnicode(const char *chars, int len, QTextCodec::Converte
     const uchar *nextAscii = src;
     const uchar *start = src;
     while (res >= 0 && src < end) {
-        if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
-            break;
+        if (src >= nextAscii) {
+            if (simdDecodeAscii(dst, nextAscii, src, end))
+                break;
+            if (headerdone) {
+                simdDecodeUtf8(dst, nextAscii, src, end);
+                if (src == end)
+                    break;
+            }
+        }
 
         ch = *src++;
         res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end);
@@ -676,6 +862,16 @@ QUtf8::ValidUtf8Result QUtf8::isValidUtf8(const char *chars, qsizetype len)
         if (src == end)
             break;
 
+        if (end - src >= 32 && (*src & 0x80)) {
+            // simdFindNonAscii() stopped at a non-ASCII character; where it
+            // has no SIMD version, it returns src unchanged
+            isValidAscii = false;
+            if (!simdValidateUtf8(nextAscii, src, end))
+                return { false, false };
+            if (src == end)
+                break;
+        }
+
         do {
             uchar b = *src++;
             if ((b & 0x80) == 0)
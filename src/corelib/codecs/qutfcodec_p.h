@@ -300,7 +300,7 @@ struct QUtf8
         bool isValidUtf8;
         bool isValidAscii;
     };
-    static ValidUtf8Result isValidUtf8(const char *, qsizetype);
+    static Q_AUTOTEST_EXPORT ValidUtf8Result isValidUtf8(const char *, qsizetype);
     static int compareUtf8(const char *, qsizetype, const QChar *, int);
     static int compareUtf8(const char *, qsizetype, QLatin1String s);
 };
@@ -0,0 +1,552 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QUTFCODEC_SIMD_P_H
+#define QUTFCODEC_SIMD_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qutfcodec_p.h"
+
+#include <QtCore/private/qsimd_p.h>
+
+QT_BEGIN_NAMESPACE
+
+// The shuffle tables are computed by a C++14 constexpr function. Compilers
+// without relaxed constexpr use the scalar transcoder instead of building
+// the tables at run time, as QtCore may transcode during static
+// initialization.
+#if defined(__cpp_constexpr) && __cpp_constexpr-0 >= 201304
+#  if defined(Q_PROCESSOR_X86) && defined(QT_COMPILER_SUPPORTS_SSE4_1)
+#    define QT_UTF8_SIMD
+#  endif
+#endif
+
+#ifdef QT_UTF8_SIMD
+
+// Shuffle tables for the SIMD UTF-8 transcoders; see makeUtf8SimdTables()
+// in qutfcodec.cpp. An entry of 0xff in a shuffle produces a zero byte.
+struct QUtf8SimdTables
+{
+    // UTF-8 to UTF-16: indexed by which of the first 12 bytes of a block
+    // end a code point, the shuffle to use and how many bytes it decodes.
+    // Shuffles 0 to 63 place six code points of one or two bytes into
+    // 16-bit lanes; shuffles 64 to 144 place four code points of one to
+    // three bytes into 32-bit lanes. Anything else is DecodeOne.
+    enum { DecodeOne = 0xff };
+    uchar decodeIndex[4096][2];
+    uchar decodeShuffle[145][16];
+
+    // UTF-16 to UTF-8: packs eight one- or two-byte sequences stored in
+    // 16-bit lanes; bit n of the index is set if unit n is US-ASCII.
+    uchar encode2Shuffle[256][16];
+
+    // UTF-16 to UTF-8: packs four sequences of one to three bytes stored in
+    // 32-bit lanes; bit n of the index is set if unit n needs two bytes or
+    // more, bit n + 4 if it needs three.
+    uchar encode3Shuffle[256][16];
+    uchar encode3Length[256];
+};
+
+extern const QUtf8SimdTables qt_utf8SimdTables;
+
+// Entry points, one set per instruction set. Each of them starts at a code
+// point (or UTF-16 code unit) boundary and ignores what precedes it.
+//
+// The transcoders convert as much of [src, end) as they can and stop on
+// invalid input (UTF-8), a surrogate (UTF-16) or close to the end. They
+// return the position up to which the caller should convert with the
+// scalar code before calling them again; it is past src, unless src == end.
+// The output buffer needs room for the worst case: one UTF-16 code unit
+// per byte or three bytes per code unit, respectively.
+//
+// The validator returns false if [src, end) is not valid UTF-8. Otherwise,
+// it advances src to the start of a code point close to the end, which
+// the caller still needs to check.
+#if defined(Q_PROCESSOR_X86)
+const uchar *qt_utf8ToUtf16_sse4(ushort *&dst, const uchar *&src, const uchar *end) noexcept;
+const ushort *qt_utf16ToUtf8_sse4(uchar *&dst, const ushort *&src, const ushort *end) noexcept;
+bool qt_validateUtf8_sse4(const uchar *&src, const uchar *end) noexcept;
+#  if defined(QT_COMPILER_SUPPORTS_AVX2)
+const uchar *qt_utf8ToUtf16_avx2(ushort *&dst, const uchar *&src, const uchar *end) noexcept;
+const ushort *qt_utf16ToUtf8_avx2(uchar *&dst, const ushort *&src, const ushort *end) noexcept;
+bool qt_validateUtf8_avx2(const uchar *&src, const uchar *end) noexcept;
+#  endif
+#endif
+
+namespace QtPrivate {
+
+// The drivers below are shared by all instruction sets. The Simd type
+// provides:
+//
+//  Checker         validates CheckSize bytes at a time, following the
+//                  "lookup" algorithm by John Keiser and Daniel Lemire
+//                  (Validating UTF-8 In Less Than One Instruction Per Byte)
+//  decodeAscii()   widens 16 bytes if they are all US-ASCII
+//  decodeStep()    decodes the complete code points in the first 12 of 16
+//                  valid bytes, at least two of them
+//  encodeStep()    encodes up to EncodeSize code units, unless there is a
+//                  surrogate among them; needs 16 code units of input
+
+template <typename Simd>
+const uchar *utf8ToUtf16Simd(ushort *&dst, const uchar *&src, const uchar *end) noexcept
+{
+    typename Simd::Checker checker;
+    const uchar *checked = src;     // [src, checked) is valid
+    while (end - src >= 16) {
+        if (Simd::decodeAscii(dst, src))
+            continue;
+
+        if (checked < src) {
+            // skipped over US-ASCII: start afresh
+            checked = src;
+            checker.reset();
+        }
+
+        // decodeStep() looks at 13 bytes to find where code points end
+        while (checked - src < 13) {
+            if (end - checked < Simd::CheckSize)
+                return end;
+            if (!checker.check(checked))
+                return checked + Simd::CheckSize;
+            checked += Simd::CheckSize;
+        }
+        Simd::decodeStep(dst, src);
+    }
+    return end;
+}
+
+template <typename Simd>
+const ushort *utf16ToUtf8Simd(uchar *&dst, const ushort *&src, const ushort *end) noexcept
+{
+    while (end - src >= 16) {
+        if (!Simd::encodeStep(dst, src))
+            return src + Simd::EncodeSize;
+    }
+    return end;
+}
+
+template <typename Simd>
+bool validateUtf8Simd(const uchar *&src, const uchar *end) noexcept
+{
+    typename Simd::Checker checker;
+    const uchar *begin = src;
+    for ( ; end - src >= Simd::CheckSize; src += Simd::CheckSize) {
+        if (!checker.check(src))
+            return false;
+    }
+
+    // back up to the start of the last code point, which may be incomplete
+    for (int i = 0; i < 3 && src > begin && QUtf8Functions::isContinuationByte(src[-1]); ++i)
+        --src;
+    if (src > begin && src[-1] >= 0xc0)
+        --src;
+    return true;
+}
+
+// Decodes one code point that decodeStep() cannot handle.
+static inline void decodeOne(ushort *&dst, const uchar *&src) noexcept
+{
+    const uchar b = *src++;
+    QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, src, src + 3);
+}
+
+} // namespace QtPrivate
+
+// The implementations for each instruction set are in an unnamed namespace,
+// so that code compiled for AVX2 is never shared with the SSE4.1 one.
+namespace {
+
+#if defined(__SSE4_1__)
+struct Utf8Sse4
+{
+    enum { CheckSize = 16, EncodeSize = 8 };
+
+    class Checker
+    {
+    public:
+        Checker() noexcept { reset(); }
+        void reset() noexcept { previous = _mm_setzero_si128(); }
+
+        bool check(const uchar *ptr) noexcept
+        {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+            const __m128i prev1 = _mm_alignr_epi8(input, previous, 15);
+            const __m128i prev2 = _mm_alignr_epi8(input, previous, 14);
+            const __m128i prev3 = _mm_alignr_epi8(input, previous, 13);
+            previous = input;
+
+            const __m128i nibble = _mm_set1_epi8(0x0f);
+            const __m128i byte1High = _mm_shuffle_epi8(byte1HighTable(),
+                                                       _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+            const __m128i byte1Low = _mm_shuffle_epi8(byte1LowTable(), _mm_and_si128(prev1, nibble));
+            const __m128i byte2High = _mm_shuffle_epi8(byte2HighTable(),
+                                                       _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+            const __m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+            // the third and fourth bytes of a sequence must be continuations
+            const __m128i isThird = _mm_subs_epu8(prev2, _mm_set1_epi8(char(0xe0 - 0x80)));
+            const __m128i isFourth = _mm_subs_epu8(prev3, _mm_set1_epi8(char(0xf0 - 0x80)));
+            const __m128i must23 = _mm_and_si128(_mm_or_si128(isThird, isFourth),
+                                                 _mm_set1_epi8(char(0x80)));
+            const __m128i error = _mm_xor_si128(must23, special);
+            return _mm_testz_si128(error, error);
+        }
+
+    private:
+        __m128i previous;
+    };
+
+    // the error classes of the lookup algorithm
+    enum : uchar {
+        TooShort = 1 << 0,      // 11______ 0_______ or 11______ 11______
+        TooLong = 1 << 1,       // 0_______ 10______
+        Overlong3 = 1 << 2,     // 11100000 100_____
+        TooLarge = 1 << 3,      // 11110100 1001____ and up
+        Surrogate = 1 << 4,     // 11101101 101_____
+        Overlong2 = 1 << 5,     // 1100000_ 10______
+        TooLarge1000 = 1 << 6,  // 11110101 1000____ and up
+        Overlong4 = 1 << 6,     // 11110000 1000____
+        TwoConts = 1 << 7,      // 10______ 10______
+        Carry = TooShort | TooLong | TwoConts
+    };
+
+    static __m128i byte1HighTable() noexcept
+    {
+        return _mm_setr_epi8(
+                    // 0_______ ________
+                    TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong, TooLong,
+                    // 10______ ________
+                    char(TwoConts), char(TwoConts), char(TwoConts), char(TwoConts),
+                    // 1100____ ________
+                    TooShort | Overlong2,
+                    // 1101____ ________
+                    TooShort,
+                    // 1110____ ________
+                    TooShort | Overlong3 | Surrogate,
+                    // 1111____ ________
+                    TooShort | TooLarge | TooLarge1000 | Overlong4);
+    }
+
+    static __m128i byte1LowTable() noexcept
+    {
+        return _mm_setr_epi8(
+                    // ____0000 ________
+                    char(Carry | Overlong3 | Overlong2 | Overlong4),
+                    // ____0001 ________
+                    char(Carry | Overlong2),
+                    // ____001_ ________
+                    char(Carry), char(Carry),
+                    // ____0100 ________
+                    char(Carry | TooLarge),
+                    // ____0101 ________ and up
+                    char(Carry | TooLarge | TooLarge1000), char(Carry | TooLarge | TooLarge1000),
+                    char(Carry | TooLarge | TooLarge1000), char(Carry | TooLarge | TooLarge1000),
+                    char(Carry | TooLarge | TooLarge1000), char(Carry | TooLarge | TooLarge1000),
+                    char(Carry | TooLarge | TooLarge1000), char(Carry | TooLarge | TooLarge1000),
+                    // ____1101 ________
+                    char(Carry | TooLarge | TooLarge1000 | Surrogate),
+                    char(Carry | TooLarge | TooLarge1000), char(Carry | TooLarge | TooLarge1000));
+    }
+
+    static __m128i byte2HighTable() noexcept
+    {
+        return _mm_setr_epi8(
+                    // ________ 0_______
+                    TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort, TooShort,
+                    // ________ 1000____
+                    char(TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge1000 | Overlong4),
+                    // ________ 1001____
+                    char(TooLong | Overlong2 | TwoConts | Overlong3 | TooLarge),
+                    // ________ 101_____
+                    char(TooLong | Overlong2 | TwoConts | Surrogate | TooLarge),
+                    char(TooLong | Overlong2 | TwoConts | Surrogate | TooLarge),
+                    // ________ 11______
+                    TooShort, TooShort, TooShort, TooShort);
+    }
+
+    static bool decodeAscii(ushort *&dst, const uchar *&src) noexcept
+    {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        if (_mm_movemask_epi8(data))
+            return false;
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_unpacklo_epi8(data, _mm_setzero_si128()));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst) + 1, _mm_unpackhi_epi8(data, _mm_setzero_si128()));
+        src += 16;
+        dst += 16;
+        return true;
+    }
+
+    static void decodeStep(ushort *&dst, const uchar *&src) noexcept
+    {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+        // bit n is set if byte n + 1 is not a continuation byte, i.e. if byte
+        // n ends a code point
+        const __m128i notContinuation = _mm_cmpgt_epi8(data, _mm_set1_epi8(char(0xbf)));
+        const uint ends = (uint(_mm_movemask_epi8(notContinuation)) >> 1) & 0xfff;
+
+        const uchar *index = qt_utf8SimdTables.decodeIndex[ends];
+        if (index[0] < 64) {
+            // six code points of one or two bytes: [last, first or 0]
+            const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                                                        qt_utf8SimdTables.decodeShuffle[index[0]]));
+            const __m128i lanes = _mm_shuffle_epi8(data, shuffle);
+            const __m128i low = _mm_and_si128(lanes, _mm_set1_epi16(0x7f));
+            const __m128i high = _mm_and_si128(lanes, _mm_set1_epi16(0x1f00));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_or_si128(low, _mm_srli_epi16(high, 2)));
+            dst += 6;
+            src += index[1];
+        } else if (index[0] != QUtf8SimdTables::DecodeOne) {
+            // four code points of one to three bytes: [last, middle or 0, first or 0, 0]
+            const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                                                        qt_utf8SimdTables.decodeShuffle[index[0]]));
+            const __m128i lanes = _mm_shuffle_epi8(data, shuffle);
+            const __m128i low = _mm_and_si128(lanes, _mm_set1_epi32(0x7f));
+            const __m128i middle = _mm_and_si128(lanes, _mm_set1_epi32(0x3f00));
+            const __m128i high = _mm_and_si128(lanes, _mm_set1_epi32(0x0f0000));
+            const __m128i utf32 = _mm_or_si128(_mm_or_si128(low, _mm_srli_epi32(middle, 2)),
+                                               _mm_srli_epi32(high, 4));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_packus_epi32(utf32, utf32));
+            dst += 4;
+            src += index[1];
+        } else {
+            QtPrivate::decodeOne(dst, src);
+        }
+    }
+
+    static bool isSurrogateFree(__m128i data) noexcept
+    {
+        const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xf800))),
+                                                   _mm_set1_epi16(short(0xd800)));
+        return _mm_testz_si128(surrogates, surrogates);
+    }
+
+    // encodes four code units of up to three bytes, zero-extended to 32 bits
+    static void encode3(uchar *&dst, __m128i utf32) noexcept
+    {
+        const __m128i contMask = _mm_set1_epi32(0x3f);
+        const __m128i cont = _mm_set1_epi32(0x80);
+        const __m128i last = _mm_or_si128(_mm_and_si128(utf32, contMask), cont);
+        const __m128i middle = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(utf32, 6), contMask), cont);
+        const __m128i one = utf32;
+        const __m128i two = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(utf32, 6), _mm_set1_epi32(0xc0)),
+                                         _mm_slli_epi32(last, 8));
+        const __m128i three = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(utf32, 12), _mm_set1_epi32(0xe0)),
+                                           _mm_or_si128(_mm_slli_epi32(middle, 8), _mm_slli_epi32(last, 16)));
+        const __m128i atLeast2 = _mm_cmpgt_epi32(utf32, _mm_set1_epi32(0x7f));
+        const __m128i atLeast3 = _mm_cmpgt_epi32(utf32, _mm_set1_epi32(0x7ff));
+        const __m128i lanes = _mm_blendv_epi8(_mm_blendv_epi8(one, two, atLeast2), three, atLeast3);
+
+        const uint index = uint(_mm_movemask_ps(_mm_castsi128_ps(atLeast2)))
+                | uint(_mm_movemask_ps(_mm_castsi128_ps(atLeast3))) << 4;
+        const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                                                    qt_utf8SimdTables.encode3Shuffle[index]));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(lanes, shuffle));
+        dst += qt_utf8SimdTables.encode3Length[index];
+    }
+
+    static bool encodeStep(uchar *&dst, const ushort *&src) noexcept
+    {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+        const __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xff80))),
+                                              _mm_setzero_si128());
+        if (_mm_movemask_epi8(ascii) == 0xffff) {
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_packus_epi16(data, data));
+            dst += 8;
+        } else if (_mm_testz_si128(data, _mm_set1_epi16(short(0xf800)))) {
+            // one or two bytes each: [first, last]
+            const __m128i first = _mm_or_si128(_mm_srli_epi16(data, 6), _mm_set1_epi16(0xc0));
+            const __m128i last = _mm_or_si128(_mm_and_si128(data, _mm_set1_epi16(0x3f)), _mm_set1_epi16(0x80));
+            const __m128i two = _mm_or_si128(first, _mm_slli_epi16(last, 8));
+            const __m128i lanes = _mm_blendv_epi8(two, data, ascii);
+
+            const uint index = uint(_mm_movemask_epi8(_mm_packs_epi16(ascii, ascii))) & 0xff;
+            const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                                                        qt_utf8SimdTables.encode2Shuffle[index]));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(lanes, shuffle));
+            dst += 16 - qPopulationCount(index);
+        } else {
+            if (!isSurrogateFree(data))
+                return false;
+            encode3(dst, _mm_cvtepu16_epi32(data));
+            encode3(dst, _mm_cvtepu16_epi32(_mm_srli_si128(data, 8)));
+        }
+        src += 8;
+        return true;
+    }
+};
+#endif // __SSE4_1__
+
+#if defined(__AVX2__)
+struct Utf8Avx2 : Utf8Sse4
+{
+    enum { CheckSize = 32, EncodeSize = 16 };
+
+    class Checker
+    {
+    public:
+        Checker() noexcept { reset(); }
+        void reset() noexcept { previous = _mm256_setzero_si256(); }
+
+        bool check(const uchar *ptr) noexcept
+        {
+            const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+            // the last 16 bytes of previous followed by the first 16 of input
+            const __m256i shifted = _mm256_permute2x128_si256(previous, input, 0x21);
+            const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+            const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+            const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+            previous = input;
+
+            const __m256i nibble = _mm256_set1_epi8(0x0f);
+            const __m256i byte1High = _mm256_shuffle_epi8(broadcast(byte1HighTable()),
+                                                          _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+            const __m256i byte1Low = _mm256_shuffle_epi8(broadcast(byte1LowTable()),
+                                                         _mm256_and_si256(prev1, nibble));
+            const __m256i byte2High = _mm256_shuffle_epi8(broadcast(byte2HighTable()),
+                                                          _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+            const __m256i special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+            const __m256i isThird = _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xe0 - 0x80)));
+            const __m256i isFourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xf0 - 0x80)));
+            const __m256i must23 = _mm256_and_si256(_mm256_or_si256(isThird, isFourth),
+                                                    _mm256_set1_epi8(char(0x80)));
+            const __m256i error = _mm256_xor_si256(must23, special);
+            return _mm256_testz_si256(error, error);
+        }
+
+    private:
+        static __m256i broadcast(__m128i table) noexcept
+        { return _mm256_broadcastsi128_si256(table); }
+
+        __m256i previous;
+    };
+
+    static void store2(uchar *&dst, __m128i lanes, uint index) noexcept
+    {
+        const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                                                    qt_utf8SimdTables.encode2Shuffle[index]));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(lanes, shuffle));
+        dst += 16 - qPopulationCount(index);
+    }
+
+    static void store3(uchar *&dst, __m128i lanes, uint index) noexcept
+    {
+        const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+                                                    qt_utf8SimdTables.encode3Shuffle[index]));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(lanes, shuffle));
+        dst += qt_utf8SimdTables.encode3Length[index];
+    }
+
+    // encodes eight code units of up to three bytes
+    static void encode3(uchar *&dst, __m128i utf16) noexcept
+    {
+        const __m256i utf32 = _mm256_cvtepu16_epi32(utf16);
+        const __m256i contMask = _mm256_set1_epi32(0x3f);
+        const __m256i cont = _mm256_set1_epi32(0x80);
+        const __m256i last = _mm256_or_si256(_mm256_and_si256(utf32, contMask), cont);
+        const __m256i middle = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(utf32, 6), contMask), cont);
+        const __m256i two = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(utf32, 6), _mm256_set1_epi32(0xc0)),
+                                            _mm256_slli_epi32(last, 8));
+        const __m256i three = _mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(utf32, 12), _mm256_set1_epi32(0xe0)),
+                                              _mm256_or_si256(_mm256_slli_epi32(middle, 8), _mm256_slli_epi32(last, 16)));
+        const __m256i atLeast2 = _mm256_cmpgt_epi32(utf32, _mm256_set1_epi32(0x7f));
+        const __m256i atLeast3 = _mm256_cmpgt_epi32(utf32, _mm256_set1_epi32(0x7ff));
+        const __m256i lanes = _mm256_blendv_epi8(_mm256_blendv_epi8(utf32, two, atLeast2), three, atLeast3);
+
+        const uint mask2 = uint(_mm256_movemask_ps(_mm256_castsi256_ps(atLeast2)));
+        const uint mask3 = uint(_mm256_movemask_ps(_mm256_castsi256_ps(atLeast3)));
+        store3(dst, _mm256_castsi256_si128(lanes), (mask2 & 0xf) | (mask3 & 0xf) << 4);
+        store3(dst, _mm256_extracti128_si256(lanes, 1), mask2 >> 4 | (mask3 >> 4) << 4);
+    }
+
+    static bool encodeStep(uchar *&dst, const ushort *&src) noexcept
+    {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+        const __m256i ascii = _mm256_cmpeq_epi16(_mm256_and_si256(data, _mm256_set1_epi16(short(0xff80))),
+                                                 _mm256_setzero_si256());
+        const uint asciiMask = uint(_mm256_movemask_epi8(ascii));
+        if (asciiMask == 0xffffffffU) {
+            const __m128i packed = _mm_packus_epi16(_mm256_castsi256_si128(data),
+                                                    _mm256_extracti128_si256(data, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), packed);
+            dst += 16;
+        } else if (_mm256_testz_si256(data, _mm256_set1_epi16(short(0xf800)))) {
+            const __m256i first = _mm256_or_si256(_mm256_srli_epi16(data, 6), _mm256_set1_epi16(0xc0));
+            const __m256i last = _mm256_or_si256(_mm256_and_si256(data, _mm256_set1_epi16(0x3f)),
+                                                 _mm256_set1_epi16(0x80));
+            const __m256i two = _mm256_or_si256(first, _mm256_slli_epi16(last, 8));
+            const __m256i lanes = _mm256_blendv_epi8(two, data, ascii);
+
+            // one bit per code unit: bits 0-7 and 16-23
+            const uint index = uint(_mm256_movemask_epi8(_mm256_packs_epi16(ascii, ascii)));
+            store2(dst, _mm256_castsi256_si128(lanes), index & 0xff);
+            store2(dst, _mm256_extracti128_si256(lanes, 1), (index >> 16) & 0xff);
+        } else {
+            // only eight code units, as they may need 24 bytes
+            const __m128i half = _mm256_castsi256_si128(data);
+            if (!isSurrogateFree(half))
+                return false;
+            encode3(dst, half);
+            src += 8;
+            return true;
+        }
+        src += 16;
+        return true;
+    }
+};
+#endif // __AVX2__
+
+} // unnamed namespace
+
+#endif // QT_UTF8_SIMD
+
+QT_END_NAMESPACE
+
+#endif // QUTFCODEC_SIMD_P_H
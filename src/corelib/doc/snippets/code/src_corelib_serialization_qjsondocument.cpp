@@ -63,3 +63,14 @@
 //! [1]
     {"Array":[true,999,"string"],"Key":"Value","null":null}
 //! [1]
+
+//! [2]
+    QFile file("config.json");
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    const uchar *text = file.map(0, file.size());
+    const QJsonDocument doc = QJsonDocument::fromJsonLazily(
+            QByteArray::fromRawData(reinterpret_cast<const char *>(text), int(file.size())));
+    const QString host = doc["host"].toString();
+    const int port = doc["port"].toInt();
+//! [2]
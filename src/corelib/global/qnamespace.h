@@ -1327,7 +1327,8 @@ public:
         DirectConnection,
         QueuedConnection,
         BlockingQueuedConnection,
-        UniqueConnection =  0x80
+        UniqueConnection =  0x80,
+        BatchedConnection = 0x100
     };
 
     enum ShortcutContext {
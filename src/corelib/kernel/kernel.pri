@@ -8,6 +8,8 @@ HEADERS += \
         kernel/qdeadlinetimer_p.h \
         kernel/qelapsedtimer.h \
         kernel/qeventloop.h \
+        kernel/qeventloopstatistics.h \
+        kernel/qeventloopstatistics_p.h \
         kernel/qpointer.h \
         kernel/qcorecmdlineargs_p.h \
         kernel/qcoreapplication.h \
@@ -33,6 +35,7 @@ HEADERS += \
         kernel/qmetaobject_moc_p.h \
         kernel/qmetaobjectbuilder_p.h \
         kernel/qobject_p.h \
+        kernel/qobjectpool_p.h \
         kernel/qcoreglobaldata_p.h \
         kernel/qsharedmemory.h \
         kernel/qsharedmemory_p.h \
@@ -52,6 +55,7 @@ SOURCES += \
         kernel/qdeadlinetimer.cpp \
         kernel/qelapsedtimer.cpp \
         kernel/qeventloop.cpp \
+        kernel/qeventloopstatistics.cpp \
         kernel/qcoreapplication.cpp \
         kernel/qcoreevent.cpp \
         kernel/qmetaobject.cpp \
@@ -60,6 +64,7 @@ SOURCES += \
         kernel/qmimedata.cpp \
         kernel/qobject.cpp \
         kernel/qobjectcleanuphandler.cpp \
+        kernel/qobjectpool.cpp \
         kernel/qsignalmapper.cpp \
         kernel/qsocketnotifier.cpp \
         kernel/qtimer.cpp \
@@ -159,6 +164,20 @@ unix|integrity {
 
     qtConfig(poll_select): SOURCES += kernel/qpoll.cpp
 
+    qtConfig(epoll) {
+        SOURCES += \
+            kernel/qeventdispatcher_epoll.cpp
+        HEADERS += \
+            kernel/qeventdispatcher_epoll_p.h
+    }
+
+    qtConfig(io_uring) {
+        SOURCES += \
+            kernel/qeventdispatcher_iouring.cpp
+        HEADERS += \
+            kernel/qeventdispatcher_iouring_p.h
+    }
+
     qtConfig(glib) {
         SOURCES += \
             kernel/qeventdispatcher_glib.cpp
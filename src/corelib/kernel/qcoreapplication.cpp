@@ -45,6 +45,7 @@
 #include "qabstracteventdispatcher.h"
 #include "qcoreevent.h"
 #include "qeventloop.h"
+#include "qeventloopstatistics_p.h"
 #endif
 #include "qmetaobject.h"
 #include "qcorecmdlineargs_p.h"
@@ -369,6 +370,8 @@ bool QCoreApplicationPrivate::is_app_closing = false;
 Q_CORE_EXPORT uint qGlobalPostedEventsCount()
 {
     QThreadData *currentThreadData = QThreadData::current();
+    const auto locker = qt_scoped_lock(currentThreadData->postEventList.mutex);
+    currentThreadData->postEventList.mergeIncoming();
     return currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset;
 }
 
@@ -525,6 +528,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(threadData->postEventList.mutex);
+        threadData->postEventList.mergeIncoming();
         for (int i = 0; i < threadData->postEventList.size(); ++i) {
             const QPostEvent &pe = threadData->postEventList.at(i);
             if (pe.event) {
@@ -856,6 +860,9 @@ void QCoreApplicationPrivate::init()
 #endif
 
 #ifndef QT_NO_QOBJECT
+    if (qEnvironmentVariableIntValue("QT_EVENT_LOOP_STATISTICS") > 0)
+        QEventLoopStatistics::setEnabled(true);
+
     // use the event dispatcher created by the app programmer (if any)
     Q_ASSERT(!eventDispatcher);
     eventDispatcher = threadData->eventDispatcher.loadRelaxed();
@@ -1235,6 +1242,7 @@ bool QCoreApplicationPrivate::notify_helper(QObject *receiver, QEvent * event)
     bool consumed = false;
     bool filtered = false;
     Q_TRACE_EXIT(QCoreApplication_notify_exit, consumed, filtered);
+    QEventTiming timing(receiver, event);
 
     // send to all application event filters (only does anything in the main thread)
     if (QCoreApplication::self
@@ -1544,6 +1552,28 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    // Queued slot invocations with the default priority are never
+    // compressed, so they can skip the mutex: they go to a lock-free stack
+    // that is merged into the sorted list whenever the mutex is taken.
+    // Other events of type MetaCall may lack the fields the stack needs.
+    QPostEventList &postEventList = data->postEventList;
+    if (event->m_metaCallEvent && priority == Qt::NormalEventPriority
+        && postEventList.beginIncoming()) {
+        if (data == *pdata) {
+            Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+            event->posted = true;
+            postEventList.pushIncoming(receiver, static_cast<QAbstractMetaCallEvent *>(event));
+            postEventList.endIncoming();
+
+            QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+            if (dispatcher)
+                dispatcher->wakeUp();
+            return;
+        }
+        // the receiver has been moved to another thread, follow it below
+        postEventList.endIncoming();
+    }
+
     // lock the post event mutex
     data->postEventList.mutex.lock();
 
@@ -1563,6 +1593,9 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
 
     QMutexUnlocker locker(&data->postEventList.mutex);
 
+    // keep the order with events that took the lock-free path
+    data->postEventList.mergeIncoming();
+
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
         && self && self->compressEvent(event, receiver, &data->postEventList)) {
@@ -1708,6 +1741,13 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    data->postEventList.mergeIncoming();
+
+    if (Q_UNLIKELY(QEventLoopStatisticsData::enabled.loadRelaxed()) && !receiver && !event_type) {
+        const int depth = data->postEventList.size() - data->postEventList.startOffset;
+        QEventLoopStatisticsData::get(data)->queueDepth.record(quint64(depth));
+        Q_TRACE(QEventLoopStatistics_queueDepth, depth);
+    }
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1862,6 +1902,7 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 {
     QThreadData *data = receiver ? receiver->d_func()->threadData : QThreadData::current();
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    data->postEventList.mergeIncoming();
 
     // the QObject destructor calls this function directly.  this can
     // happen while the event loop is in the middle of posting events,
@@ -1925,6 +1966,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->postEventList.mergeIncoming();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
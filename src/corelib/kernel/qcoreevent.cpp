@@ -295,7 +295,7 @@ QT_BEGIN_NAMESPACE
     Contructs an event object of type \a type.
 */
 QEvent::QEvent(Type type)
-    : d(0), t(type), posted(false), spont(false), m_accept(true)
+    : d(0), t(type), posted(false), spont(false), m_accept(true), m_metaCallEvent(false)
 {
     Q_TRACE(QEvent_ctor, this, t);
 }
@@ -309,7 +309,7 @@ QEvent::QEvent(Type type)
  */
 QEvent::QEvent(const QEvent &other)
     : d(other.d), t(other.t), posted(other.posted), spont(other.spont),
-      m_accept(other.m_accept)
+      m_accept(other.m_accept), m_metaCallEvent(false)
 {
     Q_TRACE(QEvent_ctor, this, t);
     // if QEventPrivate becomes available, make sure to implement a
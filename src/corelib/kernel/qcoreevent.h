@@ -317,11 +317,13 @@ private:
     ushort posted : 1;
     ushort spont : 1;
     ushort m_accept : 1;
-    ushort reserved : 13;
+    ushort m_metaCallEvent : 1; // a QAbstractMetaCallEvent, not only of type MetaCall
+    ushort reserved : 12;
 
     friend class QCoreApplication;
     friend class QCoreApplicationPrivate;
     friend class QThreadData;
+    friend class QAbstractMetaCallEvent;
     friend class QApplication;
     friend class QShortcutMap;
     friend class QGraphicsView;
@@ -0,0 +1,328 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplatformdefs.h"
+
+#include "qcoreapplication.h"
+#include "qsocketnotifier.h"
+#include "qthread.h"
+
+#include "qeventdispatcher_epoll_p.h"
+#include <private/qthread_p.h>
+#include <private/qcoreapplication_p.h>
+#include <private/qeventloopstatistics_p.h>
+#include <private/qcore_unix_p.h>
+
+#include <errno.h>
+#include <stdio.h>
+
+#include <limits>
+
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+QT_BEGIN_NAMESPACE
+
+// The socket notifier sets are kept in terms of poll(2) flags by the UNIX
+// dispatcher; on Linux the epoll(7) event bits have the same values, which
+// lets us feed epoll_wait() results straight into markPendingSocketNotifiers().
+Q_STATIC_ASSERT(EPOLLIN == POLLIN);
+Q_STATIC_ASSERT(EPOLLOUT == POLLOUT);
+Q_STATIC_ASSERT(EPOLLPRI == POLLPRI);
+Q_STATIC_ASSERT(EPOLLERR == POLLERR);
+Q_STATIC_ASSERT(EPOLLHUP == POLLHUP);
+
+enum { MaxEpollEvents = 256 };
+
+static inline int timespecToMsecs(const timespec &ts)
+{
+    // round up, so that we never wake up before the timer is due
+    const qint64 msecs = qint64(ts.tv_sec) * 1000 + (ts.tv_nsec + 999999) / 1000000;
+    return int(qMin(msecs, qint64(std::numeric_limits<int>::max())));
+}
+
+QEventDispatcherEpollPrivate::QEventDispatcherEpollPrivate()
+    : epollFd(-1), timerFd(-1), timerArmed(false)
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1) {
+        qErrnoWarning("QEventDispatcherEpoll: Unable to create epoll instance, falling back to poll()");
+        return;
+    }
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = threadPipe.fds[0];
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, ev.data.fd, &ev) == -1) {
+        qErrnoWarning("QEventDispatcherEpoll: Unable to watch the thread pipe, falling back to poll()");
+        qt_safe_close(epollFd);
+        epollFd = -1;
+        return;
+    }
+
+    // Without a timerfd we still work, with millisecond timeout precision
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerFd != -1) {
+        ev.data.fd = timerFd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &ev) == -1) {
+            qt_safe_close(timerFd);
+            timerFd = -1;
+        }
+    }
+}
+
+QEventDispatcherEpollPrivate::~QEventDispatcherEpollPrivate()
+{
+    if (timerFd >= 0)
+        qt_safe_close(timerFd);
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+}
+
+/*!
+    \internal
+
+    Synchronizes the epoll set with the notifiers registered for \a fd.
+    \a added tells whether a notifier was just registered (as opposed to
+    unregistered), which determines the operation we try first.
+
+    Returns \c false, with errno set, if the kernel refused to watch \a fd
+    for the events the notifiers want, e.g. because it refers to a regular
+    file or has been closed.
+*/
+bool QEventDispatcherEpollPrivate::updateSocketNotifier(int fd, bool added)
+{
+    epoll_event ev = {};
+    ev.data.fd = fd;
+
+    auto it = socketNotifiers.constFind(fd);
+    if (it == socketNotifiers.cend()) {
+        // the kernel already dropped the descriptor if it has been closed,
+        // and never took it if it cannot be watched
+        if (epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, &ev) == -1 && errno != ENOENT && errno != EBADF
+                && errno != EPERM)
+            qErrnoWarning("QEventDispatcherEpoll: Unable to stop watching socket %d", fd);
+        return true;
+    }
+
+    const QSocketNotifierSetUNIX &sn_set = it.value();
+    const int registered = (sn_set.notifiers[0] != nullptr) + (sn_set.notifiers[1] != nullptr)
+            + (sn_set.notifiers[2] != nullptr);
+    ev.events = sn_set.events();
+
+    if (added && registered == 1) {
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == 0)
+            return true;
+        if (errno != EEXIST)
+            return false;
+        // a stale registration for a duplicate of fd, update it
+    }
+
+    if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) == 0)
+        return true;
+    return errno == ENOENT && epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == 0;
+}
+
+bool QEventDispatcherEpollPrivate::armTimer(const timespec &tm)
+{
+    if (timerFd < 0)
+        return false;
+
+    itimerspec spec = {};
+    spec.it_value = tm;
+    if (timerfd_settime(timerFd, 0, &spec, nullptr) == -1)
+        return false;
+    timerArmed = true;
+    return true;
+}
+
+void QEventDispatcherEpollPrivate::disarmTimer()
+{
+    if (!timerArmed)
+        return;
+
+    itimerspec spec = {};
+    timerfd_settime(timerFd, 0, &spec, nullptr);
+    timerArmed = false;
+}
+
+/*!
+    \class QEventDispatcherEpoll
+    \inmodule QtCore
+    \internal
+
+    \brief The QEventDispatcherEpoll class is an epoll(7) based event
+    dispatcher for Linux.
+
+    Unlike QEventDispatcherUNIX, which hands the complete set of socket
+    notifiers to poll(2) on every loop iteration, this dispatcher keeps the
+    descriptors registered with the kernel and only updates the set when
+    notifiers are enabled or disabled. The deadline of the next timer is
+    tracked by a timerfd, so PreciseTimer keeps its sub-millisecond
+    resolution.
+
+    The dispatcher is opt-in: it is used for all threads when the
+    \c QT_EVENT_DISPATCHER_EPOLL environment variable is set to a positive
+    value, or it can be installed explicitly with
+    QCoreApplication::setEventDispatcher() and QThread::setEventDispatcher().
+    If the kernel refuses to create an epoll instance, it behaves exactly
+    like QEventDispatcherUNIX.
+*/
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QObject *parent)
+    : QEventDispatcherUNIX(*new QEventDispatcherEpollPrivate, parent)
+{ }
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QEventDispatcherEpollPrivate &dd, QObject *parent)
+    : QEventDispatcherUNIX(dd, parent)
+{ }
+
+QEventDispatcherEpoll::~QEventDispatcherEpoll()
+{ }
+
+void QEventDispatcherEpoll::registerSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_D(QEventDispatcherEpoll);
+    QEventDispatcherUNIX::registerSocketNotifier(notifier);
+    if (d->isValid() && !d->updateSocketNotifier(notifier->socket(), true)) {
+        // the notifier would never fire, so do what the poll() based
+        // dispatcher does for an invalid socket
+        qErrnoWarning("QSocketNotifier: Unable to watch socket %d, disabling...",
+                      notifier->socket());
+        notifier->setEnabled(false);
+    }
+}
+
+void QEventDispatcherEpoll::unregisterSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_D(QEventDispatcherEpoll);
+    QEventDispatcherUNIX::unregisterSocketNotifier(notifier);
+    if (d->isValid() && !d->updateSocketNotifier(notifier->socket(), false))
+        qErrnoWarning("QEventDispatcherEpoll: Unable to watch socket %d", notifier->socket());
+}
+
+bool QEventDispatcherEpoll::processEvents(QEventLoop::ProcessEventsFlags flags)
+{
+    Q_D(QEventDispatcherEpoll);
+
+    // The epoll set cannot be filtered per iteration; excluding the socket
+    // notifiers leaves only the thread pipe to wait for, which is what the
+    // poll(2) implementation does best.
+    if (!d->isValid() || (flags & QEventLoop::ExcludeSocketNotifiers))
+        return QEventDispatcherUNIX::processEvents(flags);
+
+    d->interrupt.storeRelaxed(0);
+    QEventLoopIterationTiming timing(d->threadData);
+
+    // we are awake, broadcast it
+    emit awake();
+    QCoreApplicationPrivate::sendPostedEvents(0, 0, d->threadData);
+
+    const bool include_timers = (flags & QEventLoop::X11ExcludeTimers) == 0;
+    const bool wait_for_events = flags & QEventLoop::WaitForMoreEvents;
+
+    const bool canWait = (d->threadData->canWaitLocked()
+                          && !d->interrupt.loadRelaxed()
+                          && wait_for_events);
+
+    if (canWait)
+        emit aboutToBlock();
+
+    if (d->interrupt.loadRelaxed())
+        return false;
+
+    int timeout = -1;
+    timespec wait_tm = { 0, 0 };
+
+    if (!canWait) {
+        timeout = 0;
+    } else if (include_timers && d->timerList.timerWait(wait_tm)) {
+        if ((wait_tm.tv_sec == 0 && wait_tm.tv_nsec == 0) || !d->armTimer(wait_tm))
+            timeout = timespecToMsecs(wait_tm);
+    } else {
+        d->disarmTimer();
+    }
+
+    epoll_event events[MaxEpollEvents];
+    int nfds;
+    // the deadline lives in the timerfd, so restarting with the same timeout is fine
+    timing.aboutToWait();
+    EINTR_LOOP(nfds, epoll_wait(d->epollFd, events, MaxEpollEvents, timeout));
+    timing.awake();
+
+    int nevents = 0;
+
+    if (nfds == -1) {
+        perror("epoll_wait");
+    } else if (nfds > 0) {
+        d->pollfds.clear();
+
+        for (int i = 0; i < nfds; ++i) {
+            const epoll_event &ev = events[i];
+            const int fd = ev.data.fd;
+
+            if (fd == d->timerFd) {
+                quint64 expirations;
+                while (QT_READ(fd, &expirations, sizeof(expirations)) == -1 && errno == EINTR) {}
+                d->timerArmed = false;
+                continue;
+            }
+
+            pollfd pfd = qt_make_pollfd(fd, 0);
+            pfd.revents = short(ev.events);
+
+            if (fd == d->threadPipe.fds[0])
+                nevents += d->threadPipe.check(pfd);
+            else if (d->socketNotifiers.contains(fd))
+                d->pollfds.append(pfd);
+        }
+
+        nevents += d->activateSocketNotifiers();
+    }
+
+    if (include_timers)
+        nevents += d->activateTimers();
+
+    // return true if we handled events, false otherwise
+    return (nevents > 0);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qeventdispatcher_epoll_p.cpp"
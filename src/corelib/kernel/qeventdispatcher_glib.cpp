@@ -40,6 +40,7 @@
 #include "qeventdispatcher_glib_p.h"
 #include "qeventdispatcher_unix_p.h"
 
+#include <private/qeventloopstatistics_p.h>
 #include <private/qthread_p.h>
 
 #include "qcoreapplication.h"
@@ -144,10 +145,8 @@ static gboolean timerSourceCheckHelper(GTimerSource *src)
         || (src->processEventsFlags & QEventLoop::X11ExcludeTimers))
         return false;
 
-    if (src->timerList.updateCurrentTime() < src->timerList.constFirst()->timeout)
-        return false;
-
-    return true;
+    timespec tv = { 0l, 0l };
+    return src->timerList.timerWait(tv) && tv.tv_sec == 0 && tv.tv_nsec == 0;
 }
 
 static gboolean timerSourcePrepare(GSource *source, gint *timeout)
@@ -349,6 +348,29 @@ QEventDispatcherGlibPrivate::QEventDispatcherGlibPrivate(GMainContext *context)
     g_source_attach(&idleTimerSource->source, mainContext);
 }
 
+// While processEvents() times an iteration, it replaces the poll function of
+// the main context with timedPoll(), so that the time spent waiting for
+// events is left out.
+struct GTimedPoll
+{
+    QEventLoopIterationTiming *timing;
+    GPollFunc poll;
+};
+
+static thread_local GTimedPoll *currentTimedPoll = nullptr;
+
+static gint timedPoll(GPollFD *fds, guint nfds, gint timeout)
+{
+    GTimedPoll *timed = currentTimedPoll;
+    if (!timed)
+        return g_poll(fds, nfds, timeout);
+
+    timed->timing->aboutToWait();
+    const gint result = timed->poll(fds, nfds, timeout);
+    timed->timing->awake();
+    return result;
+}
+
 void QEventDispatcherGlibPrivate::runTimersOnceWithNormalPriority()
 {
     timerSource->runWithIdlePriority = false;
@@ -368,7 +390,6 @@ QEventDispatcherGlib::~QEventDispatcherGlib()
     Q_D(QEventDispatcherGlib);
 
     // destroy all timer sources
-    qDeleteAll(d->timerSource->timerList);
     d->timerSource->timerList.~QTimerInfoList();
     g_source_destroy(&d->timerSource->source);
     g_source_unref(&d->timerSource->source);
@@ -411,6 +432,19 @@ bool QEventDispatcherGlib::processEvents(QEventLoop::ProcessEventsFlags flags)
     else
         emit awake();
 
+    QEventLoopIterationTiming timing(d->threadData);
+    GTimedPoll timed = { &timing, nullptr };
+    GTimedPoll *const outerTimed = currentTimedPoll;
+    GPollFunc previousPoll = nullptr;
+    if (timing.isActive()) {
+        previousPoll = g_main_context_get_poll_func(d->mainContext);
+        timed.poll = previousPoll;
+        if (previousPoll == timedPoll) // nested iteration
+            timed.poll = outerTimed ? outerTimed->poll : g_poll;
+        currentTimedPoll = &timed;
+        g_main_context_set_poll_func(d->mainContext, timedPoll);
+    }
+
     // tell postEventSourcePrepare() and timerSource about any new flags
     QEventLoop::ProcessEventsFlags savedFlags = d->timerSource->processEventsFlags;
     d->timerSource->processEventsFlags = flags;
@@ -424,6 +458,11 @@ bool QEventDispatcherGlib::processEvents(QEventLoop::ProcessEventsFlags flags)
     while (!result && canWait)
         result = g_main_context_iteration(d->mainContext, canWait);
 
+    if (timing.isActive()) {
+        g_main_context_set_poll_func(d->mainContext, previousPoll);
+        currentTimedPoll = outerTimed;
+    }
+
     d->timerSource->processEventsFlags = savedFlags;
 
     if (canWait)
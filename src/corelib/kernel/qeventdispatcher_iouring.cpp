@@ -0,0 +1,746 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplatformdefs.h"
+
+#include "qcoreapplication.h"
+#include "qsocketnotifier.h"
+#include "qthread.h"
+
+#include "qeventdispatcher_iouring_p.h"
+#include <private/qthread_p.h>
+#include <private/qcoreapplication_p.h>
+#include <private/qeventloopstatistics_p.h>
+#include <private/qcore_unix_p.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+
+QT_BEGIN_NAMESPACE
+
+enum {
+    RingEntries = 256,
+    ReadAheadChunkSize = 16384
+};
+
+enum : quint32 {
+    // generations reserved for the read-ahead requests, see submitRead()
+    ReadGeneration = 0,
+    ReadPollGeneration = 1,
+    FirstPollGeneration = 2
+};
+
+// user_data of the POLL_REMOVE requests, whose completions we don't care about
+static const quint64 RemoveRequestTag = ~Q_UINT64_C(0);
+
+static inline int qt_io_uring_setup(unsigned entries, io_uring_params *params)
+{
+    return int(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static inline int qt_io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return int(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+static inline int qt_io_uring_register(int fd, unsigned opcode, void *arg, unsigned count)
+{
+    return int(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+static inline quint64 pollUserData(int fd, quint32 generation)
+{
+    return (quint64(generation) << 32) | quint32(fd);
+}
+
+template <typename T> static inline T *ringPointer(void *ring, quint32 offset)
+{
+    return reinterpret_cast<T *>(static_cast<char *>(ring) + offset);
+}
+
+QEventDispatcherIoUringPrivate::QEventDispatcherIoUringPrivate()
+    : ringFd(-1), timerFd(-1), timerArmed(false), timerDeadline{0, 0},
+      sqHead(nullptr), sqTail(nullptr), sqArray(nullptr), sqes(nullptr),
+      sqMask(0), sqEntries(0), sqLocalTail(0),
+      cqHead(nullptr), cqTail(nullptr), cqOverflow(nullptr), cqes(nullptr),
+      cqMask(0), lastOverflow(0),
+      sqRing(MAP_FAILED), sqRingSize(0), cqRing(MAP_FAILED), cqRingSize(0), sqesSize(0),
+      nextGeneration(0), readAheadSupported(false)
+{
+    // QTimerInfoList works with the monotonic clock on Linux
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerFd == -1 || !setupRing(RingEntries))
+        return;
+
+    // the internal descriptors are polled just like the socket notifiers
+    pendingUpdates.insert(threadPipe.fds[0]);
+    pendingUpdates.insert(timerFd);
+}
+
+QEventDispatcherIoUringPrivate::~QEventDispatcherIoUringPrivate()
+{
+    // the kernel must be done with the read buffers before they go away
+    if (isValid()) {
+        const QList<int> readFds = readRequests.keys();
+        for (int fd : readFds)
+            cancelRead(fd);
+    }
+    releaseRing();
+    if (timerFd >= 0)
+        qt_safe_close(timerFd);
+}
+
+bool QEventDispatcherIoUringPrivate::setupRing(unsigned entries)
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    ringFd = qt_io_uring_setup(entries, &params);
+    if (ringFd == -1) {
+        // ENOSYS on old kernels, EPERM when disabled by policy
+        return false;
+    }
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ringFd, IORING_OFF_SQ_RING);
+    cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ringFd, IORING_OFF_CQ_RING);
+    void *sqesMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ringFd, IORING_OFF_SQES);
+    if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqesMap == MAP_FAILED) {
+        qErrnoWarning("QEventDispatcherIoUring: Unable to map the io_uring queues, falling back to poll()");
+        if (sqesMap != MAP_FAILED)
+            munmap(sqesMap, sqesSize);
+        releaseRing();
+        return false;
+    }
+
+    sqHead = ringPointer<QBasicAtomicInteger<unsigned>>(sqRing, params.sq_off.head);
+    sqTail = ringPointer<QBasicAtomicInteger<unsigned>>(sqRing, params.sq_off.tail);
+    sqMask = *ringPointer<unsigned>(sqRing, params.sq_off.ring_mask);
+    sqEntries = *ringPointer<unsigned>(sqRing, params.sq_off.ring_entries);
+    sqArray = ringPointer<unsigned>(sqRing, params.sq_off.array);
+    sqes = static_cast<io_uring_sqe *>(sqesMap);
+    sqLocalTail = sqTail->loadRelaxed();
+
+    cqHead = ringPointer<QBasicAtomicInteger<unsigned>>(cqRing, params.cq_off.head);
+    cqTail = ringPointer<QBasicAtomicInteger<unsigned>>(cqRing, params.cq_off.tail);
+    cqOverflow = ringPointer<QBasicAtomicInteger<unsigned>>(cqRing, params.cq_off.overflow);
+    cqMask = *ringPointer<unsigned>(cqRing, params.cq_off.ring_mask);
+    cqes = ringPointer<io_uring_cqe>(cqRing, params.cq_off.cqes);
+    lastOverflow = cqOverflow->loadRelaxed();
+
+    readAheadSupported = probeReadAhead(params);
+    return true;
+}
+
+/*!
+    \internal
+
+    Returns \c true if the kernel supports everything that read-ahead
+    needs: IORING_OP_RECV, linked requests, and a completion queue that
+    never drops completions, which would lose data.
+*/
+bool QEventDispatcherIoUringPrivate::probeReadAhead(const io_uring_params &params)
+{
+    if (!(params.features & IORING_FEAT_NODROP))
+        return false;
+
+    // kernels without IORING_REGISTER_PROBE lack IORING_OP_RECV as well
+    const unsigned opCount = 256;
+    QByteArray storage(int(sizeof(io_uring_probe) + opCount * sizeof(io_uring_probe_op)), '\0');
+    io_uring_probe *probe = reinterpret_cast<io_uring_probe *>(storage.data());
+    if (qt_io_uring_register(ringFd, IORING_REGISTER_PROBE, probe, opCount) == -1)
+        return false;
+
+    const auto supported = [probe](unsigned op) {
+        return op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+    };
+    return supported(IORING_OP_POLL_ADD) && supported(IORING_OP_POLL_REMOVE)
+            && supported(IORING_OP_RECV);
+}
+
+void QEventDispatcherIoUringPrivate::releaseRing()
+{
+    if (sqes)
+        munmap(sqes, sqesSize);
+    if (cqRing != MAP_FAILED)
+        munmap(cqRing, cqRingSize);
+    if (sqRing != MAP_FAILED)
+        munmap(sqRing, sqRingSize);
+    if (ringFd >= 0)
+        qt_safe_close(ringFd);
+
+    sqes = nullptr;
+    cqRing = sqRing = MAP_FAILED;
+    ringFd = -1;
+}
+
+/*!
+    \internal
+
+    Returns a cleared submission queue entry, or \nullptr if the queue is
+    full even after handing the pending entries to the kernel. The entry is
+    made visible to the kernel by the next call to enter().
+*/
+io_uring_sqe *QEventDispatcherIoUringPrivate::nextSqe()
+{
+    if (sqLocalTail - sqHead->loadAcquire() >= sqEntries) {
+        enter(0);
+        if (sqLocalTail - sqHead->loadAcquire() >= sqEntries)
+            return nullptr;
+    }
+
+    const unsigned index = sqLocalTail & sqMask;
+    io_uring_sqe *sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqArray[index] = index;
+    ++sqLocalTail;
+    return sqe;
+}
+
+/*!
+    \internal
+
+    Submits all prepared entries and, if \a minComplete is not zero, waits
+    until that many completions are available.
+*/
+void QEventDispatcherIoUringPrivate::enter(unsigned minComplete)
+{
+    sqTail->storeRelease(sqLocalTail);
+
+    const unsigned flags = minComplete ? IORING_ENTER_GETEVENTS : 0;
+    forever {
+        const unsigned toSubmit = sqLocalTail - sqHead->loadAcquire();
+        if (qt_io_uring_enter(ringFd, toSubmit, minComplete, flags) >= 0)
+            return;
+
+        // the deadline lives in the timerfd, so restarting is fine
+        if (errno == EINTR)
+            continue;
+
+        // EBUSY and EAGAIN: the completion queue needs reaping first
+        if (errno != EBUSY && errno != EAGAIN)
+            perror("io_uring_enter");
+        return;
+    }
+}
+
+short QEventDispatcherIoUringPrivate::wantedEvents(int fd) const
+{
+    if (fd == threadPipe.fds[0] || fd == timerFd)
+        return POLLIN;
+
+    short events = socketNotifiers.value(fd).events();
+    // with read-ahead, the poll linked to the read waits for the data
+    if (readRequests.contains(fd))
+        events &= ~POLLIN;
+    return events;
+}
+
+bool QEventDispatcherIoUringPrivate::readNotifierEnabled(int fd, const ReadRequest &request) const
+{
+    const auto it = socketNotifiers.constFind(fd);
+    return it != socketNotifiers.cend() && it->notifiers[QSocketNotifier::Read] == request.notifier;
+}
+
+/*!
+    \internal
+
+    Queues a read of up to ReadAheadChunkSize bytes from \a fd. A read of a
+    non-blocking socket fails with EAGAIN instead of waiting for data, so it
+    is linked to a poll that waits for the socket to become readable. Both
+    requests use reserved generations: there is at most one read in flight
+    per descriptor, and it is never abandoned, see cancelRead().
+*/
+bool QEventDispatcherIoUringPrivate::submitRead(int fd, ReadRequest &request)
+{
+    // the two requests must be queued together
+    if (sqLocalTail - sqHead->loadAcquire() + 2 > sqEntries) {
+        enter(0);
+        if (sqLocalTail - sqHead->loadAcquire() + 2 > sqEntries)
+            return false;
+    }
+
+    if (request.buffer.size() != ReadAheadChunkSize)
+        request.buffer = QByteArray(ReadAheadChunkSize, Qt::Uninitialized);
+
+    io_uring_sqe *sqe = nextSqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->flags = IOSQE_IO_LINK;
+    sqe->fd = fd;
+    sqe->poll_events = POLLIN;
+    sqe->user_data = pollUserData(fd, ReadPollGeneration);
+
+    sqe = nextSqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->addr = quint64(quintptr(request.buffer.data()));
+    sqe->len = quint32(request.buffer.size());
+    sqe->user_data = pollUserData(fd, ReadGeneration);
+
+    request.armed = true;
+    return true;
+}
+
+/*!
+    \internal
+
+    Polls in io_uring are one-shot: every descriptor whose notifiers changed
+    or whose poll completed in the previous iteration gets a new request.
+    An outstanding request is cancelled first, because the descriptor may
+    have been closed and reused in the meantime.
+*/
+void QEventDispatcherIoUringPrivate::submitPendingUpdates()
+{
+    auto it = pendingUpdates.begin();
+    while (it != pendingUpdates.end()) {
+        const int fd = *it;
+        PollRequest &request = pollRequests[fd];
+
+        if (request.armed) {
+            io_uring_sqe *sqe = nextSqe();
+            if (!sqe)
+                return;
+            sqe->opcode = IORING_OP_POLL_REMOVE;
+            sqe->fd = -1;
+            sqe->addr = pollUserData(fd, request.generation);
+            sqe->user_data = RemoveRequestTag;
+            request.armed = false;
+        }
+
+        const short events = wantedEvents(fd);
+        if (events) {
+            io_uring_sqe *sqe = nextSqe();
+            if (!sqe)
+                return;
+            if (++nextGeneration < FirstPollGeneration)
+                nextGeneration = FirstPollGeneration;
+            request.generation = nextGeneration;
+            request.armed = true;
+            sqe->opcode = IORING_OP_POLL_ADD;
+            sqe->fd = fd;
+            sqe->poll_events = quint16(events);
+            sqe->user_data = pollUserData(fd, request.generation);
+        } else {
+            pollRequests.remove(fd);
+        }
+
+        // read-ahead: data that is still waiting for the notifier is
+        // reported again before anything more is read
+        auto read = readRequests.find(fd);
+        if (read != readRequests.end() && !read->armed && readNotifierEnabled(fd, *read)) {
+            if (!read->readAhead->isEmpty())
+                readyReads.append(fd);
+            else if (!submitRead(fd, *read))
+                return;
+        }
+
+        it = pendingUpdates.erase(it);
+    }
+}
+
+/*!
+    \internal
+
+    Consumes the completion queue: the thread pipe and the timerfd are
+    handled directly, socket events are collected into pollfds for
+    markPendingSocketNotifiers(). Returns the number of wake ups handled.
+*/
+int QEventDispatcherIoUringPrivate::reapCompletions()
+{
+    int nevents = 0;
+    pollfds.clear();
+
+    unsigned head = cqHead->loadRelaxed();
+    const unsigned tail = cqTail->loadAcquire();
+
+    for ( ; head != tail; ++head) {
+        const io_uring_cqe &cqe = cqes[head & cqMask];
+        const quint64 userData = cqe.user_data;
+        const int result = cqe.res;
+
+        if (userData == RemoveRequestTag)
+            continue;
+
+        const int fd = int(quint32(userData));
+        const quint32 generation = quint32(userData >> 32);
+        if (generation < FirstPollGeneration) {
+            readCompleted(fd, generation, result);
+            continue;
+        }
+
+        auto it = pollRequests.find(fd);
+
+        // ignore completions of cancelled or superseded requests
+        if (it == pollRequests.end() || !it->armed || it->generation != generation)
+            continue;
+
+        it->armed = false;
+        pendingUpdates.insert(fd);
+
+        if (result == -ECANCELED)
+            continue;
+
+        pollfd pfd = qt_make_pollfd(fd, 0);
+        pfd.revents = result < 0 ? short(POLLNVAL) : short(result);
+
+        if (fd == threadPipe.fds[0]) {
+            // the wake up may already have been consumed by a poll() based
+            // iteration (see ExcludeSocketNotifiers)
+            if (threadPipe.wakeUps.loadAcquire())
+                nevents += threadPipe.check(pfd);
+        } else if (fd == timerFd) {
+            quint64 expirations;
+            while (QT_READ(timerFd, &expirations, sizeof(expirations)) == -1 && errno == EINTR) {}
+            timerArmed = false;
+        } else if (socketNotifiers.contains(fd)) {
+            pollfds.append(pfd);
+        }
+    }
+
+    cqHead->storeRelease(head);
+
+    // completions were dropped: we can't tell which requests are still
+    // armed, so start over with all of them
+    const unsigned overflow = cqOverflow->loadRelaxed();
+    if (Q_UNLIKELY(overflow != lastOverflow)) {
+        lastOverflow = overflow;
+        for (auto it = pollRequests.cbegin(); it != pollRequests.cend(); ++it)
+            pendingUpdates.insert(it.key());
+    }
+
+    return nevents;
+}
+
+/*!
+    \internal
+
+    Handles the completion of the read-ahead requests of \a fd: the data,
+    the end of the stream or the error goes to the read-ahead buffer, and
+    the read notifier is activated if it is enabled.
+*/
+void QEventDispatcherIoUringPrivate::readCompleted(int fd, quint32 generation, int result)
+{
+    auto it = readRequests.find(fd);
+    if (it == readRequests.end() || !it->armed)
+        return;
+
+    if (generation == ReadPollGeneration) {
+        // the linked read is cancelled when the poll fails, remember why
+        if (result < 0 && result != -ECANCELED)
+            it->pollError = -result;
+        return;
+    }
+
+    it->armed = false;
+    QIoUringReadAhead *readAhead = it->readAhead;
+    if (result > 0) {
+        if (result < ReadAheadChunkSize / 4) {
+            // copy small reads, and keep the buffer for the next one
+            readAhead->buffer.append(it->buffer.constData(), result);
+        } else {
+            it->buffer.resize(result);
+            readAhead->buffer.append(it->buffer);
+            it->buffer = QByteArray();
+        }
+    } else if (result == 0) {
+        readAhead->endOfFile = true;
+    } else if (result == -ECANCELED) {
+        readAhead->error = it->pollError;
+    } else if (result != -EAGAIN) {
+        readAhead->error = -result;
+    }
+    it->pollError = 0;
+
+    pendingUpdates.insert(fd);
+    if (!readAhead->isEmpty() && readNotifierEnabled(fd, *it)) {
+        pollfd pfd = qt_make_pollfd(fd, 0);
+        pfd.revents = POLLIN;
+        pollfds.append(pfd);
+    }
+}
+
+/*!
+    \internal
+
+    Cancels the read in flight on \a fd, if any, and waits for its
+    completion: the kernel may still write to the buffer until then, and
+    whatever it read before the cancellation took effect must not be lost.
+*/
+void QEventDispatcherIoUringPrivate::cancelRead(int fd)
+{
+    bool cancelQueued = false;
+    while (readRequests.value(fd).armed) {
+        if (!cancelQueued) {
+            // removing the poll cancels the read linked to it
+            if (io_uring_sqe *sqe = nextSqe()) {
+                sqe->opcode = IORING_OP_POLL_REMOVE;
+                sqe->fd = -1;
+                sqe->addr = pollUserData(fd, ReadPollGeneration);
+                sqe->user_data = RemoveRequestTag;
+                cancelQueued = true;
+            }
+        }
+        enter(cancelQueued ? 1 : 0);
+        reapCompletions();
+    }
+}
+
+bool QEventDispatcherIoUringPrivate::armTimer(const timespec &deadline)
+{
+    if (timerArmed && timerDeadline == deadline)
+        return true;
+
+    itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value = deadline;
+    if (timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) == -1) {
+        perror("timerfd_settime");
+        return false;
+    }
+
+    timerArmed = true;
+    timerDeadline = deadline;
+    return true;
+}
+
+void QEventDispatcherIoUringPrivate::disarmTimer()
+{
+    if (!timerArmed)
+        return;
+
+    itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+    timerfd_settime(timerFd, 0, &spec, nullptr);
+    timerArmed = false;
+}
+
+/*!
+    \class QEventDispatcherIoUring
+    \inmodule QtCore
+    \internal
+
+    \brief The QEventDispatcherIoUring class is an experimental event
+    dispatcher based on the Linux io_uring interface.
+
+    Socket notifiers, the thread pipe and a timerfd carrying the next timer
+    deadline are watched with one-shot poll requests. All the requests that
+    need to be (re)armed during a loop iteration are queued in the shared
+    submission ring and handed to the kernel with the same io_uring_enter()
+    call that waits for completions, so an iteration costs a single system
+    call regardless of how many notifiers are registered or fired.
+
+    The owner of a read notifier, such as the native socket engine, can
+    also let the dispatcher read the data, see registerReadAhead(). The
+    reads are then submitted in the same batch as the polls, and the data
+    is ready in memory when the notifier is activated.
+
+    The dispatcher is opt-in: it is used when the
+    \c QT_EVENT_DISPATCHER_IO_URING environment variable is set to a positive
+    value, or it can be installed with setEventDispatcher(). When the kernel
+    does not provide io_uring, it behaves exactly like QEventDispatcherUNIX.
+*/
+
+QEventDispatcherIoUring::QEventDispatcherIoUring(QObject *parent)
+    : QEventDispatcherUNIX(*new QEventDispatcherIoUringPrivate, parent)
+{ }
+
+QEventDispatcherIoUring::QEventDispatcherIoUring(QEventDispatcherIoUringPrivate &dd, QObject *parent)
+    : QEventDispatcherUNIX(dd, parent)
+{ }
+
+QEventDispatcherIoUring::~QEventDispatcherIoUring()
+{ }
+
+void QEventDispatcherIoUring::registerSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_D(QEventDispatcherIoUring);
+    QEventDispatcherUNIX::registerSocketNotifier(notifier);
+    if (d->isValid())
+        d->pendingUpdates.insert(notifier->socket());
+}
+
+void QEventDispatcherIoUring::unregisterSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_D(QEventDispatcherIoUring);
+    QEventDispatcherUNIX::unregisterSocketNotifier(notifier);
+    if (d->isValid())
+        d->pendingUpdates.insert(notifier->socket());
+}
+
+/*!
+    \internal
+
+    Makes the dispatcher read the socket of the read \a notifier into
+    \a readAhead, instead of only reporting that it is readable. While the
+    notifier is enabled, a read is submitted together with the other
+    requests of the loop iteration, and the notifier is activated once
+    data, the end of the stream or an error has been stored in
+    \a readAhead. At most one chunk is read ahead while the notifier is
+    disabled.
+
+    The socket must not be read directly, nor closed, until
+    unregisterReadAhead() has been called, and \a readAhead must stay valid
+    until then. Returns \c false if read-ahead is not available, for
+    instance because the kernel is too old.
+*/
+bool QEventDispatcherIoUring::registerReadAhead(QSocketNotifier *notifier, QIoUringReadAhead *readAhead)
+{
+    Q_D(QEventDispatcherIoUring);
+    Q_ASSERT(notifier && readAhead);
+    Q_ASSERT(notifier->type() == QSocketNotifier::Read);
+
+    if (!d->isValid() || !d->readAheadSupported || notifier->thread() != thread())
+        return false;
+
+    const int fd = int(notifier->socket());
+    if (d->readRequests.contains(fd))
+        return false;
+
+    QEventDispatcherIoUringPrivate::ReadRequest &request = d->readRequests[fd];
+    request.notifier = notifier;
+    request.readAhead = readAhead;
+    d->pendingUpdates.insert(fd);
+    return true;
+}
+
+/*!
+    \internal
+
+    Stops reading ahead for \a notifier. A read that is in flight is
+    cancelled and waited for, so any data it returned is in the
+    read-ahead buffer when this function returns.
+*/
+void QEventDispatcherIoUring::unregisterReadAhead(QSocketNotifier *notifier)
+{
+    Q_D(QEventDispatcherIoUring);
+    const int fd = int(notifier->socket());
+    const auto it = d->readRequests.constFind(fd);
+    if (it == d->readRequests.cend() || it->notifier != notifier)
+        return;
+
+    d->cancelRead(fd);
+    d->readRequests.remove(fd);
+    d->readyReads.removeAll(fd);
+    d->pendingUpdates.insert(fd);
+}
+
+bool QEventDispatcherIoUring::processEvents(QEventLoop::ProcessEventsFlags flags)
+{
+    Q_D(QEventDispatcherIoUring);
+
+    // the poll requests cannot be filtered per iteration, see QEventDispatcherEpoll
+    if (!d->isValid() || (flags & QEventLoop::ExcludeSocketNotifiers))
+        return QEventDispatcherUNIX::processEvents(flags);
+
+    d->interrupt.storeRelaxed(0);
+    QEventLoopIterationTiming timing(d->threadData);
+
+    // we are awake, broadcast it
+    emit awake();
+    QCoreApplicationPrivate::sendPostedEvents(0, 0, d->threadData);
+
+    const bool include_timers = (flags & QEventLoop::X11ExcludeTimers) == 0;
+    const bool wait_for_events = flags & QEventLoop::WaitForMoreEvents;
+
+    const bool canWait = (d->threadData->canWaitLocked()
+                          && !d->interrupt.loadRelaxed()
+                          && wait_for_events);
+
+    if (canWait)
+        emit aboutToBlock();
+
+    if (d->interrupt.loadRelaxed())
+        return false;
+
+    bool wait = canWait;
+    timespec wait_tm = { 0, 0 };
+
+    if (canWait) {
+        if (include_timers && d->timerList.timerWait(wait_tm)) {
+            // timerWait() left the current time in the timer list
+            if ((wait_tm.tv_sec == 0 && wait_tm.tv_nsec == 0)
+                    || !d->armTimer(d->timerList.currentTime + wait_tm)) {
+                wait = false;
+            }
+        } else {
+            d->disarmTimer();
+        }
+    }
+
+    // a single system call submits all the requests and waits
+    d->submitPendingUpdates();
+    if (!d->readyReads.isEmpty())
+        wait = false;
+    if (wait || d->sqLocalTail != d->sqHead->loadRelaxed()) {
+        timing.aboutToWait();
+        d->enter(wait ? 1 : 0);
+        timing.awake();
+    }
+
+    int nevents = d->reapCompletions();
+    for (int fd : qAsConst(d->readyReads)) {
+        pollfd pfd = qt_make_pollfd(fd, 0);
+        pfd.revents = POLLIN;
+        d->pollfds.append(pfd);
+    }
+    d->readyReads.clear();
+    nevents += d->activateSocketNotifiers();
+
+    if (include_timers)
+        nevents += d->activateTimers();
+
+    // return true if we handled events, false otherwise
+    return (nevents > 0);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qeventdispatcher_iouring_p.cpp"
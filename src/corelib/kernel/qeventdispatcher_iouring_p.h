@@ -0,0 +1,196 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QEVENTDISPATCHER_IOURING_P_H
+#define QEVENTDISPATCHER_IOURING_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "private/qeventdispatcher_unix_p.h"
+#include "private/qringbuffer_p.h"
+#include "QtCore/qhash.h"
+#include "QtCore/qset.h"
+
+#include <errno.h>
+
+QT_REQUIRE_CONFIG(io_uring);
+
+struct io_uring_params;
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+QT_BEGIN_NAMESPACE
+
+class QEventDispatcherIoUringPrivate;
+
+// Data that the dispatcher has read from a socket on behalf of its owner,
+// see QEventDispatcherIoUring::registerReadAhead().
+struct QIoUringReadAhead
+{
+    QRingBuffer buffer;
+    int error = 0;          // errno of a failed read, reported after the data
+    bool endOfFile = false;
+
+    bool isEmpty() const noexcept { return buffer.isEmpty() && !error && !endOfFile; }
+
+    // same results as read(2) on a non-blocking socket
+    qint64 read(char *data, qint64 maxSize)
+    {
+        if (!buffer.isEmpty())
+            return buffer.read(data, maxSize);
+        if (endOfFile)
+            return 0;
+        errno = error ? error : EAGAIN;
+        return -1;
+    }
+};
+
+class Q_CORE_EXPORT QEventDispatcherIoUring : public QEventDispatcherUNIX
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QEventDispatcherIoUring)
+
+public:
+    explicit QEventDispatcherIoUring(QObject *parent = nullptr);
+    ~QEventDispatcherIoUring();
+
+    bool processEvents(QEventLoop::ProcessEventsFlags flags) override;
+
+    void registerSocketNotifier(QSocketNotifier *notifier) override;
+    void unregisterSocketNotifier(QSocketNotifier *notifier) override;
+
+    bool registerReadAhead(QSocketNotifier *notifier, QIoUringReadAhead *readAhead);
+    void unregisterReadAhead(QSocketNotifier *notifier);
+
+protected:
+    QEventDispatcherIoUring(QEventDispatcherIoUringPrivate &dd, QObject *parent = nullptr);
+};
+
+class Q_CORE_EXPORT QEventDispatcherIoUringPrivate : public QEventDispatcherUNIXPrivate
+{
+    Q_DECLARE_PUBLIC(QEventDispatcherIoUring)
+
+public:
+    QEventDispatcherIoUringPrivate();
+    ~QEventDispatcherIoUringPrivate();
+
+    struct PollRequest
+    {
+        quint32 generation = 0;
+        bool armed = false;
+    };
+
+    struct ReadRequest
+    {
+        QSocketNotifier *notifier = nullptr;
+        QIoUringReadAhead *readAhead = nullptr;
+        QByteArray buffer;      // target of the read in flight
+        int pollError = 0;
+        bool armed = false;
+    };
+
+    bool isValid() const noexcept { return ringFd >= 0; }
+
+    bool setupRing(unsigned entries);
+    void releaseRing();
+    io_uring_sqe *nextSqe();
+    void enter(unsigned minComplete);
+
+    bool probeReadAhead(const io_uring_params &params);
+    short wantedEvents(int fd) const;
+    bool readNotifierEnabled(int fd, const ReadRequest &request) const;
+    bool submitRead(int fd, ReadRequest &request);
+    void submitPendingUpdates();
+    int reapCompletions();
+    void readCompleted(int fd, quint32 generation, int result);
+    void cancelRead(int fd);
+
+    bool armTimer(const timespec &deadline);
+    void disarmTimer();
+
+    int ringFd;
+    int timerFd;
+    bool timerArmed;
+    timespec timerDeadline;
+
+    // submission queue, shared with the kernel
+    QBasicAtomicInteger<unsigned> *sqHead;
+    QBasicAtomicInteger<unsigned> *sqTail;
+    unsigned *sqArray;
+    io_uring_sqe *sqes;
+    unsigned sqMask;
+    unsigned sqEntries;
+    unsigned sqLocalTail;
+
+    // completion queue, shared with the kernel
+    QBasicAtomicInteger<unsigned> *cqHead;
+    QBasicAtomicInteger<unsigned> *cqTail;
+    QBasicAtomicInteger<unsigned> *cqOverflow;
+    io_uring_cqe *cqes;
+    unsigned cqMask;
+    unsigned lastOverflow;
+
+    void *sqRing;
+    size_t sqRingSize;
+    void *cqRing;
+    size_t cqRingSize;
+    size_t sqesSize;
+
+    quint32 nextGeneration;
+    QHash<int, PollRequest> pollRequests;
+    QSet<int> pendingUpdates;
+
+    // read-ahead, see registerReadAhead()
+    bool readAheadSupported;
+    QHash<int, ReadRequest> readRequests;
+    QVector<int> readyReads;
+};
+
+QT_END_NAMESPACE
+
+#endif // QEVENTDISPATCHER_IOURING_P_H
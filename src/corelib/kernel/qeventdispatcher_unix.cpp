@@ -49,6 +49,7 @@
 #include "qeventdispatcher_unix_p.h"
 #include <private/qthread_p.h>
 #include <private/qcoreapplication_p.h>
+#include <private/qeventloopstatistics_p.h>
 #include <private/qcore_unix_p.h>
 
 #include <errno.h>
@@ -228,12 +229,6 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
 }
 
-QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
-{
-    // cleanup timers
-    qDeleteAll(timerList);
-}
-
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
 {
     Q_ASSERT(notifier);
@@ -460,6 +455,7 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
 {
     Q_D(QEventDispatcherUNIX);
     d->interrupt.storeRelaxed(0);
+    QEventLoopIterationTiming timing(d->threadData);
 
     // we are awake, broadcast it
     emit awake();
@@ -497,7 +493,11 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
 
     int nevents = 0;
 
-    switch (qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm)) {
+    timing.aboutToWait();
+    const int pollResult = qt_safe_poll(d->pollfds.data(), d->pollfds.size(), tm);
+    timing.awake();
+
+    switch (pollResult) {
     case -1:
         perror("qt_safe_poll");
         break;
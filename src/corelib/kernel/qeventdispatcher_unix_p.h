@@ -108,8 +108,8 @@ public:
     bool processEvents(QEventLoop::ProcessEventsFlags flags) override;
     bool hasPendingEvents() override;
 
-    void registerSocketNotifier(QSocketNotifier *notifier) final;
-    void unregisterSocketNotifier(QSocketNotifier *notifier) final;
+    void registerSocketNotifier(QSocketNotifier *notifier) override;
+    void unregisterSocketNotifier(QSocketNotifier *notifier) override;
 
     void registerTimer(int timerId, int interval, Qt::TimerType timerType, QObject *object) final;
     bool unregisterTimer(int timerId) final;
@@ -132,7 +132,6 @@ class Q_CORE_EXPORT QEventDispatcherUNIXPrivate : public QAbstractEventDispatche
 
 public:
     QEventDispatcherUNIXPrivate();
-    ~QEventDispatcherUNIXPrivate();
 
     int activateTimers();
 
@@ -0,0 +1,113 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QEVENTLOOPSTATISTICS_H
+#define QEVENTLOOPSTATISTICS_H
+
+#include <QtCore/qshareddata.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+class QThread;
+struct QMetaObject;
+
+class QEventLoopStatisticsPrivate;
+class Q_CORE_EXPORT QEventLoopStatistics
+{
+public:
+    class Histogram
+    {
+    public:
+        enum { BucketCount = 40 };
+
+        quint64 count() const noexcept { return m_count; }
+        quint64 sum() const noexcept { return m_sum; }
+        quint64 maximum() const noexcept { return m_maximum; }
+        quint64 bucket(int i) const noexcept { return m_buckets[i]; }
+
+        static quint64 bucketUpperBound(int i) noexcept
+        { return i == BucketCount - 1 ? ~quint64(0) : quint64(1) << i; }
+
+    private:
+        friend class QEventLoopHistogram;
+
+        quint64 m_count = 0;
+        quint64 m_sum = 0;
+        quint64 m_maximum = 0;
+        quint64 m_buckets[BucketCount] = {};
+    };
+
+    QEventLoopStatistics();
+    QEventLoopStatistics(const QEventLoopStatistics &other);
+    ~QEventLoopStatistics();
+
+    QEventLoopStatistics &operator=(const QEventLoopStatistics &other);
+    QEventLoopStatistics &operator=(QEventLoopStatistics &&other) noexcept { swap(other); return *this; }
+
+    void swap(QEventLoopStatistics &other) noexcept
+    { qSwap(d, other.d); }
+
+    static void setEnabled(bool enable);
+    static bool isEnabled();
+
+    static void setSampleInterval(int interval);
+    static int sampleInterval();
+
+    static QEventLoopStatistics forThread(QThread *thread = nullptr);
+    static void reset(QThread *thread = nullptr);
+
+    Histogram iterationTime() const;
+    Histogram queueDepth() const;
+
+    QVector<int> eventTypes() const;
+    Histogram eventTime(int type) const;
+
+    QVector<const QMetaObject *> receiverClasses() const;
+    Histogram receiverTime(const QMetaObject *metaObject) const;
+
+private:
+    QSharedDataPointer<QEventLoopStatisticsPrivate> d;
+};
+
+Q_DECLARE_SHARED(QEventLoopStatistics)
+
+QT_END_NAMESPACE
+
+#endif // QEVENTLOOPSTATISTICS_H
@@ -0,0 +1,287 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QEVENTLOOPSTATISTICS_P_H
+#define QEVENTLOOPSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qeventloopstatistics.h"
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/private/qglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QEvent;
+class QObject;
+class QThreadData;
+
+// A histogram that only its thread records into. The counters are atomic so
+// that other threads can take snapshots of it.
+class QEventLoopHistogram
+{
+public:
+    // Records value as if it had been seen weight times.
+    void record(quint64 value, quint32 weight = 1)
+    {
+        int i = 0;
+        if (value)
+            i = qMin(64 - int(qCountLeadingZeroBits(value)), int(QEventLoopStatistics::Histogram::BucketCount) - 1);
+        add(buckets[i], weight);
+        add(count, weight);
+        add(sum, value * weight);
+        if (value > maximum.loadRelaxed())
+            maximum.storeRelaxed(value);
+    }
+
+    QEventLoopStatistics::Histogram snapshot() const;
+    void reset();
+
+private:
+#ifdef Q_ATOMIC_INT64_IS_SUPPORTED
+    typedef QAtomicInteger<quint64> Counter;
+#else
+    typedef QAtomicInteger<quintptr> Counter; // sums and maxima may wrap
+#endif
+
+    static void add(Counter &counter, quint64 value)
+    { counter.storeRelaxed(counter.loadRelaxed() + value); }
+
+    Counter count;
+    Counter sum;
+    Counter maximum;
+    Counter buckets[QEventLoopStatistics::Histogram::BucketCount];
+};
+
+// The histograms of one thread by event type or receiver class. The thread
+// finds them through a small direct-mapped cache; the mutex only protects
+// the map against snapshots taken by other threads.
+template <typename Key>
+class QEventLoopHistogramMap
+{
+public:
+    ~QEventLoopHistogramMap() { qDeleteAll(map); }
+
+    QEventLoopHistogram *find(Key key)
+    {
+        Entry &entry = cache[quintptr(key) % CacheSize];
+        if (Q_LIKELY(entry.histogram && entry.key == key))
+            return entry.histogram;
+
+        const QMutexLocker locker(&mutex);
+        QEventLoopHistogram *&histogram = map[key];
+        if (!histogram)
+            histogram = new QEventLoopHistogram;
+        entry.key = key;
+        entry.histogram = histogram;
+        return histogram;
+    }
+
+    QHash<Key, QEventLoopStatistics::Histogram> snapshot() const
+    {
+        QHash<Key, QEventLoopStatistics::Histogram> result;
+        const QMutexLocker locker(&mutex);
+        for (auto it = map.cbegin(); it != map.cend(); ++it)
+            result.insert(it.key(), it.value()->snapshot());
+        return result;
+    }
+
+    void reset()
+    {
+        const QMutexLocker locker(&mutex);
+        for (QEventLoopHistogram *histogram : qAsConst(map))
+            histogram->reset();
+    }
+
+private:
+    enum { CacheSize = 61 };
+    struct Entry {
+        Key key;
+        QEventLoopHistogram *histogram = nullptr;
+    };
+
+    Entry cache[CacheSize];
+    mutable QBasicMutex mutex;
+    QHash<Key, QEventLoopHistogram *> map;
+};
+
+// Picks which events or iterations of one thread are timed: one in
+// sampleInterval on average, at random distances so that events that
+// alternate regularly are all sampled. Only its thread uses it.
+class QEventLoopSampler
+{
+public:
+    // Returns 0 if the next event is not to be timed, otherwise the number
+    // of events it stands for.
+    quint32 next(int interval)
+    {
+        if (Q_LIKELY(--countdown))
+            return 0;
+        const quint32 result = weight;
+        if (interval > 1) {
+            // xorshift32
+            random ^= random << 13;
+            random ^= random >> 17;
+            random ^= random << 5;
+            weight = 1 + random % quint32(2 * interval - 1);
+        } else {
+            weight = 1;
+        }
+        countdown = weight;
+        return result;
+    }
+
+private:
+    quint32 countdown = 1;
+    quint32 weight = 1;
+    quint32 random = 2463534242u;
+};
+
+class Q_CORE_EXPORT QEventLoopStatisticsData
+{
+public:
+    enum { DefaultSampleInterval = 16 };
+
+    static QBasicAtomicInt enabled;
+    static QBasicAtomicInt sampleInterval;
+
+    static QEventLoopStatisticsData *get(QThreadData *data);
+
+    quint32 sampleEvent() { return eventSampler.next(sampleInterval.loadRelaxed()); }
+    quint32 sampleIteration() { return iterationSampler.next(sampleInterval.loadRelaxed()); }
+
+    QEventLoopSampler eventSampler;
+    QEventLoopSampler iterationSampler;
+    QEventLoopHistogram iterationTime;
+    QEventLoopHistogram queueDepth;
+    QEventLoopHistogramMap<int> eventTimes;
+    QEventLoopHistogramMap<const QMetaObject *> receiverTimes;
+};
+
+// Times the delivery of one event, if the statistics are enabled.
+class QEventTiming
+{
+    Q_DISABLE_COPY_MOVE(QEventTiming)
+public:
+    QEventTiming(QObject *receiver, QEvent *event)
+        : statistics(nullptr)
+    {
+        if (Q_UNLIKELY(QEventLoopStatisticsData::enabled.loadRelaxed()))
+            start(receiver, event);
+    }
+    ~QEventTiming()
+    {
+        if (Q_UNLIKELY(statistics))
+            finish();
+    }
+
+private:
+    Q_CORE_EXPORT void start(QObject *receiver, QEvent *event);
+    Q_CORE_EXPORT void finish();
+
+    QEventLoopStatisticsData *statistics;
+    const QMetaObject *metaObject;
+    int type;
+    quint32 weight;
+    QElapsedTimer timer;
+};
+
+// Times one iteration of an event dispatcher, without the time spent
+// waiting for events, if the statistics are enabled and the iteration is
+// sampled.
+class QEventLoopIterationTiming
+{
+    Q_DISABLE_COPY_MOVE(QEventLoopIterationTiming)
+public:
+    explicit QEventLoopIterationTiming(QThreadData *data)
+        : statistics(nullptr), weight(0), busy(0)
+    {
+        if (Q_UNLIKELY(QEventLoopStatisticsData::enabled.loadRelaxed())) {
+            QEventLoopStatisticsData *candidate = QEventLoopStatisticsData::get(data);
+            weight = candidate->sampleIteration();
+            if (weight) {
+                statistics = candidate;
+                timer.start();
+            }
+        }
+    }
+    ~QEventLoopIterationTiming()
+    {
+        if (Q_UNLIKELY(statistics))
+            finish();
+    }
+
+    bool isActive() const { return statistics != nullptr; }
+
+    void aboutToWait()
+    {
+        if (Q_UNLIKELY(statistics))
+            busy += timer.nsecsElapsed();
+    }
+    void awake()
+    {
+        if (Q_UNLIKELY(statistics))
+            timer.start();
+    }
+
+private:
+    Q_CORE_EXPORT void finish();
+
+    QEventLoopStatisticsData *statistics;
+    quint32 weight;
+    qint64 busy;
+    QElapsedTimer timer;
+};
+
+QT_END_NAMESPACE
+
+#endif // QEVENTLOOPSTATISTICS_P_H
@@ -42,7 +42,7 @@
 #include "qobjectdefs.h"
 #include "qdatetime.h"
 #include "qbytearray.h"
-#include "qreadwritelock.h"
+#include "qmutex.h"
 #include "qstring.h"
 #include "qstringlist.h"
 #include "qvector.h"
@@ -322,6 +322,7 @@ struct DefinedTypesFilter {
     \value MovableType An instance of a type having this attribute can be safely moved by memcpy.
     \omitvalue SharedPointerToQObject
     \value IsEnumeration This type is an enumeration
+    \value IsUnsignedEnumeration If the type is an enumeration, its underlying type is unsigned (since Qt 6.0)
     \value PointerToQObject This type is a pointer to a derived of QObject
     \omitvalue WeakPointerToQObject
     \omitvalue TrackingPointerToQObject
@@ -539,47 +540,220 @@ public:
     int alias;
 };
 
+// The custom types are looked up from every thread that uses QVariant or
+// queued connections, but they are rarely registered. They are kept in an
+// append-only array of immutable entries, so that lookups need no lock: an
+// entry is never modified once published, a modified copy replaces it.
+// Replaced entries are freed with the registry, because a reader may still
+// be using them; this also keeps the result of QMetaType::typeName() valid.
+//
+// The array grows in chunks of doubling size that never move. Writers must
+// hold the mutex.
+class QCustomTypeRegistry
+{
+    Q_DISABLE_COPY_MOVE(QCustomTypeRegistry)
+public:
+    QCustomTypeRegistry() = default;
+    ~QCustomTypeRegistry()
+    {
+        for (int i = 0, n = size.loadRelaxed(); i < n; ++i)
+            delete slot(i).loadRelaxed();
+        qDeleteAll(retired);
+        for (Slot *chunk : chunks)
+            delete [] chunk;
+    }
+
+    int count() const { return size.loadAcquire(); }
+    const QCustomTypeInfo *at(int index) const { return slot(index).loadAcquire(); }
+
+    const QCustomTypeInfo *find(int type) const
+    {
+        if (Q_UNLIKELY(type < QMetaType::User || type - QMetaType::User >= count()))
+            return nullptr;
+        return at(type - QMetaType::User);
+    }
+
+    void append(const QCustomTypeInfo &info)
+    {
+        const int index = size.loadRelaxed();
+        uint offset;
+        const int chunk = chunkOf(index, &offset);
+        if (!chunks[chunk])
+            chunks[chunk] = new Slot[1u << (chunk + FirstChunkBits)];
+        chunks[chunk][offset].storeRelaxed(new QCustomTypeInfo(info));
+        size.storeRelease(index + 1);
+    }
+
+    void replace(int index, const QCustomTypeInfo &info)
+    {
+        Slot &s = slot(index);
+        retired.append(s.loadRelaxed());
+        s.storeRelease(new QCustomTypeInfo(info));
+    }
+
+    QBasicMutex mutex;
+
+private:
+    typedef QAtomicPointer<const QCustomTypeInfo> Slot;
+    enum { FirstChunkBits = 6, ChunkCount = 32 - FirstChunkBits };
+
+    // chunk k holds 2^(k + FirstChunkBits) entries
+    static int chunkOf(uint index, uint *offset)
+    {
+        const uint n = index + (1u << FirstChunkBits);
+        const int bit = 31 - qCountLeadingZeroBits(n);
+        *offset = n - (1u << bit);
+        return bit - FirstChunkBits;
+    }
+
+    Slot &slot(uint index) const
+    {
+        uint offset;
+        const int chunk = chunkOf(index, &offset);
+        return chunks[chunk][offset];
+    }
+
+    Slot *chunks[ChunkCount] = {};
+    QAtomicInt size;
+    QVector<const QCustomTypeInfo *> retired;
+};
+
+// The converter, comparator and debug stream functions are looked up
+// without locking as well. They live in an open-addressing hash table whose
+// entries, once published, always keep their key; unregistering a function
+// only clears its slot. A table that gets half full is replaced by one of
+// twice the size, and the old table is kept until the registry is
+// destroyed, for the readers that may still be probing it.
 template<typename T, typename Key>
 class QMetaTypeFunctionRegistry
 {
+    struct Slot
+    {
+        Key key;
+        QAtomicInt used;
+        QAtomicPointer<const T> function;
+    };
+
+    struct Table
+    {
+        explicit Table(int capacity)
+            : entries(new Slot[capacity]), capacity(capacity), used(0)
+        {}
+        ~Table() { delete [] entries; }
+
+        const T *lookup(const Key &k) const
+        {
+            const uint mask = uint(capacity - 1);
+            for (uint i = qHash(k) & mask; ; i = (i + 1) & mask) {
+                const Slot &s = entries[i];
+                if (!s.used.loadAcquire())
+                    return nullptr;
+                if (s.key == k)
+                    return s.function.loadAcquire();
+            }
+        }
+
+        // Returns the slot of \a k, or the free slot where it would go.
+        // Only writers may call this.
+        Slot *probe(const Key &k) const
+        {
+            const uint mask = uint(capacity - 1);
+            for (uint i = qHash(k) & mask; ; i = (i + 1) & mask) {
+                Slot &s = entries[i];
+                if (!s.used.loadRelaxed() || s.key == k)
+                    return &s;
+            }
+        }
+
+        Slot *entries;
+        int capacity; // a power of two
+        int used;
+    };
+
 public:
+    QMetaTypeFunctionRegistry() = default;
     ~QMetaTypeFunctionRegistry()
     {
-        const QWriteLocker locker(&lock);
-        map.clear();
+        delete table.loadRelaxed();
+        qDeleteAll(retired);
     }
 
     bool contains(Key k) const
     {
-        const QReadLocker locker(&lock);
-        return map.contains(k);
+        return function(k) != nullptr;
     }
 
     bool insertIfNotContains(Key k, const T *f)
     {
-        const QWriteLocker locker(&lock);
-        const T* &fun = map[k];
-        if (fun)
-            return false;
-        fun = f;
+        const QMutexLocker locker(&mutex);
+        Table *t = table.loadRelaxed();
+        Slot *s = t ? t->probe(k) : nullptr;
+        if (s && s->used.loadRelaxed()) {
+            if (s->function.loadRelaxed())
+                return false;
+            s->function.storeRelease(f);
+            return true;
+        }
+        if (!t || 2 * (t->used + 1) > t->capacity) {
+            t = grow(t);
+            s = t->probe(k);
+        }
+        s->key = k;
+        s->function.storeRelaxed(f);
+        s->used.storeRelease(1);
+        ++t->used;
         return true;
     }
 
     const T *function(Key k) const
     {
-        const QReadLocker locker(&lock);
-        return map.value(k, nullptr);
+        const Table *t = table.loadAcquire();
+        return t ? t->lookup(k) : nullptr;
     }
 
     void remove(int from, int to)
     {
         const Key k(from, to);
-        const QWriteLocker locker(&lock);
-        map.remove(k);
+        const QMutexLocker locker(&mutex);
+        if (Table *t = table.loadRelaxed())
+            clear(t, k);
+        for (Table *t : qAsConst(retired))
+            clear(t, k);
     }
+
 private:
-    mutable QReadWriteLock lock;
-    QHash<Key, const T *> map;
+    static void clear(Table *t, const Key &k)
+    {
+        Slot *s = t->probe(k);
+        if (s->used.loadRelaxed())
+            s->function.storeRelease(nullptr);
+    }
+
+    // Copies the registered functions into a new, larger table and
+    // publishes it. Called with the mutex held.
+    Table *grow(Table *old)
+    {
+        Table *t = new Table(old ? 2 * old->capacity : 16);
+        if (old) {
+            for (int i = 0; i < old->capacity; ++i) {
+                const Slot &from = old->entries[i];
+                if (!from.used.loadRelaxed() || !from.function.loadRelaxed())
+                    continue;
+                Slot *to = t->probe(from.key);
+                to->key = from.key;
+                to->function.storeRelaxed(from.function.loadRelaxed());
+                to->used.storeRelaxed(1);
+                ++t->used;
+            }
+            retired.append(old);
+        }
+        table.storeRelease(t);
+        return t;
+    }
+
+    QBasicMutex mutex;
+    QAtomicPointer<Table> table;
+    QVector<Table *> retired;
 };
 
 typedef QMetaTypeFunctionRegistry<QtPrivate::AbstractConverterFunction,QPair<int,int> >
@@ -591,9 +765,7 @@ QMetaTypeDebugStreamRegistry;
 
 Q_STATIC_ASSERT(std::is_pod<QMetaTypeInterface>::value);
 
-Q_DECLARE_TYPEINFO(QCustomTypeInfo, Q_MOVABLE_TYPE);
-Q_GLOBAL_STATIC(QVector<QCustomTypeInfo>, customTypes)
-Q_GLOBAL_STATIC(QReadWriteLock, customTypesLock)
+Q_GLOBAL_STATIC(QCustomTypeRegistry, customTypes)
 Q_GLOBAL_STATIC(QMetaTypeConverterRegistry, customTypesConversionRegistry)
 Q_GLOBAL_STATIC(QMetaTypeComparatorRegistry, customTypesComparatorRegistry)
 Q_GLOBAL_STATIC(QMetaTypeDebugStreamRegistry, customTypesDebugStreamRegistry)
@@ -836,13 +1008,16 @@ void QMetaType::registerStreamOperators(int idx, SaveOperator saveOp,
 {
     if (idx < User)
         return; //builtin types should not be registered;
-    QVector<QCustomTypeInfo> *ct = customTypes();
+    QCustomTypeRegistry *ct = customTypes();
     if (!ct)
         return;
-    QWriteLocker locker(customTypesLock());
-    QCustomTypeInfo &inf = (*ct)[idx - User];
+    const QMutexLocker locker(&ct->mutex);
+    const QCustomTypeInfo *old = ct->find(idx);
+    Q_ASSERT(old);
+    QCustomTypeInfo inf = *old;
     inf.saveOp = saveOp;
     inf.loadOp = loadOp;
+    ct->replace(idx - User, inf);
 }
 #endif // QT_NO_DATASTREAM
 
@@ -941,11 +1116,9 @@ const char *QMetaType::typeName(int typeId)
         return nullptr; // It can happen when someone cast int to QVariant::Type, we should not crash...
     }
 
-    const QVector<QCustomTypeInfo> * const ct = customTypes();
-    QReadLocker locker(customTypesLock());
-    return ct && uint(ct->count()) > type - QMetaType::User && !ct->at(type - QMetaType::User).typeName.isEmpty()
-            ? ct->at(type - QMetaType::User).typeName.constData()
-            : nullptr;
+    const QCustomTypeRegistry * const ct = customTypes();
+    const QCustomTypeInfo *info = ct ? ct->find(typeId) : nullptr;
+    return info && !info->typeName.isEmpty() ? info->typeName.constData() : nullptr;
 
 #undef QT_METATYPE_TYPEID_TYPENAME_CONVERTER
 }
@@ -965,20 +1138,20 @@ static inline int qMetaTypeStaticType(const char *typeName, int length)
 
 /*
     Similar to QMetaType::type(), but only looks in the custom set of
-    types, and doesn't lock the mutex.
+    types. This doesn't need the registry's mutex.
     The extra \a firstInvalidIndex parameter is an easy way to avoid
     iterating over customTypes() a second time in registerNormalizedType().
 */
-static int qMetaTypeCustomType_unlocked(const char *typeName, int length, int *firstInvalidIndex = nullptr)
+static int qMetaTypeCustomType(const char *typeName, int length, int *firstInvalidIndex = nullptr)
 {
-    const QVector<QCustomTypeInfo> * const ct = customTypes();
+    const QCustomTypeRegistry * const ct = customTypes();
     if (!ct)
         return QMetaType::UnknownType;
 
     if (firstInvalidIndex)
         *firstInvalidIndex = -1;
-    for (int v = 0; v < ct->count(); ++v) {
-        const QCustomTypeInfo &customInfo = ct->at(v);
+    for (int v = 0, count = ct->count(); v < count; ++v) {
+        const QCustomTypeInfo &customInfo = *ct->at(v);
         if ((length == customInfo.typeName.size())
             && !memcmp(typeName, customInfo.typeName.constData(), length)) {
             if (customInfo.alias >= 0)
@@ -1018,21 +1191,26 @@ int QMetaType::registerType(const char *typeName, Deleter deleter,
  */
 bool QMetaType::unregisterType(int type)
 {
-    QWriteLocker locker(customTypesLock());
-    QVector<QCustomTypeInfo> *ct = customTypes();
+    QCustomTypeRegistry *ct = customTypes();
+    const QMutexLocker locker(&ct->mutex);
 
     // check if user type
-    if ((type < User) || ((type - User) >= ct->size()))
+    const QCustomTypeInfo *info = ct->find(type);
+    if (!info)
         return false;
 
     // only types without Q_DECLARE_METATYPE can be unregistered
-    if (ct->data()[type - User].flags & WasDeclaredAsMetaType)
+    if (info->flags & WasDeclaredAsMetaType)
         return false;
 
     // invalidate type and all its alias entries
-    for (int v = 0; v < ct->count(); ++v) {
-        if (((v + User) == type) || (ct->at(v).alias == type))
-            ct->data()[v].typeName.clear();
+    for (int v = 0, count = ct->count(); v < count; ++v) {
+        const QCustomTypeInfo *entry = ct->at(v);
+        if (((v + User) == type) || (entry->alias == type)) {
+            QCustomTypeInfo inf = *entry;
+            inf.typeName.clear();
+            ct->replace(v, inf);
+        }
     }
     return true;
 }
@@ -1094,7 +1272,7 @@ static int registerNormalizedType(const NS(QByteArray) &normalizedTypeName,
                                   QMetaType::TypedConstructor typedConstructor,
                                   int size, QMetaType::TypeFlags flags, const QMetaObject *metaObject)
 {
-    QVector<QCustomTypeInfo> *ct = customTypes();
+    QCustomTypeRegistry *ct = customTypes();
     if (!ct || normalizedTypeName.isEmpty() || (!destructor && !typedDestructor) || (!constructor && !typedConstructor))
         return -1;
 
@@ -1104,11 +1282,11 @@ static int registerNormalizedType(const NS(QByteArray) &normalizedTypeName,
     int previousSize = 0;
     QMetaType::TypeFlags::Int previousFlags = 0;
     if (idx == QMetaType::UnknownType) {
-        QWriteLocker locker(customTypesLock());
+        const QMutexLocker locker(&ct->mutex);
         int posInVector = -1;
-        idx = qMetaTypeCustomType_unlocked(normalizedTypeName.constData(),
-                                           normalizedTypeName.size(),
-                                           &posInVector);
+        idx = qMetaTypeCustomType(normalizedTypeName.constData(),
+                                  normalizedTypeName.size(),
+                                  &posInVector);
         if (idx == QMetaType::UnknownType) {
             QCustomTypeInfo inf;
             inf.typeName = normalizedTypeName;
@@ -1125,27 +1303,29 @@ static int registerNormalizedType(const NS(QByteArray) &normalizedTypeName,
             inf.flags = flags;
             inf.metaObject = metaObject;
             if (posInVector == -1) {
-                idx = ct->size() + QMetaType::User;
+                idx = ct->count() + QMetaType::User;
                 ct->append(inf);
             } else {
                 idx = posInVector + QMetaType::User;
-                ct->data()[posInVector] = inf;
+                ct->replace(posInVector, inf);
             }
             return idx;
         }
 
         if (idx >= QMetaType::User) {
-            previousSize = ct->at(idx - QMetaType::User).size;
-            previousFlags = ct->at(idx - QMetaType::User).flags;
+            const QCustomTypeInfo *previous = ct->at(idx - QMetaType::User);
+            previousSize = previous->size;
+            previousFlags = previous->flags;
 
             // Set new/additional flags in case of old library/app.
             // Ensures that older code works in conjunction with new Qt releases
             // requiring the new flags.
             if (flags != previousFlags) {
-                QCustomTypeInfo &inf = ct->data()[idx - QMetaType::User];
+                QCustomTypeInfo inf = *previous;
                 inf.flags |= flags;
                 if (metaObject)
                     inf.metaObject = metaObject;
+                ct->replace(idx - QMetaType::User, inf);
             }
         }
     }
@@ -1163,7 +1343,8 @@ static int registerNormalizedType(const NS(QByteArray) &normalizedTypeName,
     }
 
     // these flags cannot change in a binary compatible way:
-    const int binaryCompatibilityFlag = QMetaType::PointerToQObject | QMetaType::IsEnumeration | QMetaType::SharedPointerToQObject
+    const int binaryCompatibilityFlag = QMetaType::PointerToQObject | QMetaType::IsEnumeration
+                                                | QMetaType::IsUnsignedEnumeration | QMetaType::SharedPointerToQObject
                                                 | QMetaType::WeakPointerToQObject | QMetaType::TrackingPointerToQObject;
     if (Q_UNLIKELY((previousFlags ^ flags) & binaryCompatibilityFlag)) {
 
@@ -1264,7 +1445,7 @@ int QMetaType::registerTypedef(const char* typeName, int aliasId)
 */
 int QMetaType::registerNormalizedTypedef(const NS(QByteArray) &normalizedTypeName, int aliasId)
 {
-    QVector<QCustomTypeInfo> *ct = customTypes();
+    QCustomTypeRegistry *ct = customTypes();
     if (!ct || normalizedTypeName.isEmpty())
         return -1;
 
@@ -1272,11 +1453,11 @@ int QMetaType::registerNormalizedTypedef(const NS(QByteArray) &normalizedTypeNam
                                   normalizedTypeName.size());
 
     if (idx == UnknownType) {
-        QWriteLocker locker(customTypesLock());
+        const QMutexLocker locker(&ct->mutex);
         int posInVector = -1;
-        idx = qMetaTypeCustomType_unlocked(normalizedTypeName.constData(),
-                                               normalizedTypeName.size(),
-                                               &posInVector);
+        idx = qMetaTypeCustomType(normalizedTypeName.constData(),
+                                  normalizedTypeName.size(),
+                                  &posInVector);
 
         if (idx == UnknownType) {
             QCustomTypeInfo inf;
@@ -1285,7 +1466,7 @@ int QMetaType::registerNormalizedTypedef(const NS(QByteArray) &normalizedTypeNam
             if (posInVector == -1)
                 ct->append(inf);
             else
-                ct->data()[posInVector] = inf;
+                ct->replace(posInVector, inf);
             return aliasId;
         }
     }
@@ -1315,9 +1496,9 @@ bool QMetaType::isRegistered(int type)
         return true;
     }
 
-    QReadLocker locker(customTypesLock());
-    const QVector<QCustomTypeInfo> * const ct = customTypes();
-    return ((type >= User) && (ct && ct->count() > type - User) && !ct->at(type - User).typeName.isEmpty());
+    const QCustomTypeRegistry * const ct = customTypes();
+    const QCustomTypeInfo *info = ct ? ct->find(type) : nullptr;
+    return info && !info->typeName.isEmpty();
 }
 
 template <bool tryNormalizedType>
@@ -1327,16 +1508,15 @@ static inline int qMetaTypeTypeImpl(const char *typeName, int length)
         return QMetaType::UnknownType;
     int type = qMetaTypeStaticType(typeName, length);
     if (type == QMetaType::UnknownType) {
-        QReadLocker locker(customTypesLock());
-        type = qMetaTypeCustomType_unlocked(typeName, length);
+        type = qMetaTypeCustomType(typeName, length);
 #ifndef QT_NO_QOBJECT
         if ((type == QMetaType::UnknownType) && tryNormalizedType) {
             const NS(QByteArray) normalizedTypeName = QMetaObject::normalizedType(typeName);
             type = qMetaTypeStaticType(normalizedTypeName.constData(),
                                        normalizedTypeName.size());
             if (type == QMetaType::UnknownType) {
-                type = qMetaTypeCustomType_unlocked(normalizedTypeName.constData(),
-                                                    normalizedTypeName.size());
+                type = qMetaTypeCustomType(normalizedTypeName.constData(),
+                                           normalizedTypeName.size());
             }
         }
 #endif
@@ -1484,14 +1664,9 @@ public:
     }
     bool delegate(const QMetaTypeSwitcher::NotBuiltinType *data)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        if (!ct)
-            return false;
-        QMetaType::SaveOperator saveOp = nullptr;
-        {
-            QReadLocker locker(customTypesLock());
-            saveOp = ct->at(m_type - QMetaType::User).saveOp;
-        }
+        const QCustomTypeRegistry * const ct = customTypes();
+        const QCustomTypeInfo *info = ct ? ct->find(m_type) : nullptr;
+        const QMetaType::SaveOperator saveOp = info ? info->saveOp : nullptr;
         if (!saveOp)
             return false;
         saveOp(stream, data);
@@ -1535,14 +1710,9 @@ public:
     }
     bool delegate(const QMetaTypeSwitcher::NotBuiltinType *data)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        if (!ct)
-            return false;
-        QMetaType::LoadOperator loadOp = nullptr;
-        {
-            QReadLocker locker(customTypesLock());
-            loadOp = ct->at(m_type - QMetaType::User).loadOp;
-        }
+        const QCustomTypeRegistry * const ct = customTypes();
+        const QCustomTypeInfo *info = ct ? ct->find(m_type) : nullptr;
+        const QMetaType::LoadOperator loadOp = info ? info->loadOp : nullptr;
         if (!loadOp)
             return false;
         loadOp(stream, const_cast<QMetaTypeSwitcher::NotBuiltinType*>(data));
@@ -1666,14 +1836,13 @@ private:
     {
         QMetaType::Constructor ctor;
         QMetaType::TypedConstructor tctor;
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
         {
-            QReadLocker locker(customTypesLock());
-            if (Q_UNLIKELY(type < QMetaType::User || !ct || ct->count() <= type - QMetaType::User))
+            const QCustomTypeRegistry * const ct = customTypes();
+            const QCustomTypeInfo *typeInfo = ct ? ct->find(type) : nullptr;
+            if (Q_UNLIKELY(!typeInfo))
                 return nullptr;
-            const auto &typeInfo = ct->at(type - QMetaType::User);
-            ctor = typeInfo.constructor;
-            tctor = typeInfo.typedConstructor;
+            ctor = typeInfo->constructor;
+            tctor = typeInfo->typedConstructor;
         }
         Q_ASSERT_X((ctor || tctor) , "void *QMetaType::construct(int type, void *where, const void *copy)", "The type was not properly registered");
         if (Q_UNLIKELY(tctor))
@@ -1764,14 +1933,13 @@ private:
     {
         QMetaType::Destructor dtor;
         QMetaType::TypedDestructor tdtor;
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
         {
-            QReadLocker locker(customTypesLock());
-            if (Q_UNLIKELY(type < QMetaType::User || !ct || ct->count() <= type - QMetaType::User))
+            const QCustomTypeRegistry * const ct = customTypes();
+            const QCustomTypeInfo *typeInfo = ct ? ct->find(type) : nullptr;
+            if (Q_UNLIKELY(!typeInfo))
                 return;
-            const auto &typeInfo = ct->at(type - QMetaType::User);
-            dtor = typeInfo.destructor;
-            tdtor = typeInfo.typedDestructor;
+            dtor = typeInfo->destructor;
+            tdtor = typeInfo->typedDestructor;
         }
         Q_ASSERT_X((dtor || tdtor), "void QMetaType::destruct(int type, void *where)", "The type was not properly registered");
         if (Q_UNLIKELY(tdtor))
@@ -1836,11 +2004,11 @@ public:
 private:
     static int customTypeSizeOf(const int type)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        QReadLocker locker(customTypesLock());
-        if (Q_UNLIKELY(type < QMetaType::User || !ct || ct->count() <= type - QMetaType::User))
+        const QCustomTypeRegistry * const ct = customTypes();
+        const QCustomTypeInfo *typeInfo = ct ? ct->find(type) : nullptr;
+        if (Q_UNLIKELY(!typeInfo))
             return 0;
-        return ct->at(type - QMetaType::User).size;
+        return typeInfo->size;
     }
 
     const int m_type;
@@ -1904,13 +2072,11 @@ private:
     const int m_type;
     static quint32 customTypeFlags(const int type)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        if (Q_UNLIKELY(!ct || type < QMetaType::User))
-            return 0;
-        QReadLocker locker(customTypesLock());
-        if (Q_UNLIKELY(ct->count() <= type - QMetaType::User))
+        const QCustomTypeRegistry * const ct = customTypes();
+        const QCustomTypeInfo *typeInfo = ct ? ct->find(type) : nullptr;
+        if (Q_UNLIKELY(!typeInfo))
             return 0;
-        return ct->at(type - QMetaType::User).flags;
+        return typeInfo->flags;
     }
 };
 }  // namespace
@@ -1968,13 +2134,11 @@ private:
     const int m_type;
     static const QMetaObject *customMetaObject(const int type)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
-        if (Q_UNLIKELY(!ct || type < QMetaType::User))
-            return nullptr;
-        QReadLocker locker(customTypesLock());
-        if (Q_UNLIKELY(ct->count() <= type - QMetaType::User))
+        const QCustomTypeRegistry * const ct = customTypes();
+        const QCustomTypeInfo *typeInfo = ct ? ct->find(type) : nullptr;
+        if (Q_UNLIKELY(!typeInfo))
             return nullptr;
-        return ct->at(type - QMetaType::User).metaObject;
+        return typeInfo->metaObject;
     }
 };
 }  // namespace
@@ -2172,12 +2336,11 @@ public:
 private:
     void customTypeInfo(const uint type)
     {
-        const QVector<QCustomTypeInfo> * const ct = customTypes();
+        const QCustomTypeRegistry * const ct = customTypes();
         if (Q_UNLIKELY(!ct))
             return;
-        QReadLocker locker(customTypesLock());
-        if (Q_LIKELY(uint(ct->count()) > type - QMetaType::User))
-            info = ct->at(type - QMetaType::User);
+        if (const QCustomTypeInfo *typeInfo = ct->find(type))
+            info = *typeInfo;
     }
 
     const uint m_type;
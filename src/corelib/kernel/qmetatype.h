@@ -493,7 +493,8 @@ public:
         TrackingPointerToQObject = 0x80,
         WasDeclaredAsMetaType = 0x100,
         IsGadget = 0x200,
-        PointerToGadget = 0x400
+        PointerToGadget = 0x400,
+        IsUnsignedEnumeration = 0x800
     };
     Q_DECLARE_FLAGS(TypeFlags, TypeFlag)
 
@@ -1468,6 +1469,11 @@ namespace QtPrivate
     };
     template<> struct IsQEnumHelper<void> { enum { Value = false }; };
 
+    template<typename T, bool = std::is_enum<T>::value>
+    struct IsUnsignedEnum : std::false_type {};
+    template<typename T>
+    struct IsUnsignedEnum<T, true> : std::is_unsigned<typename std::underlying_type<T>::type> {};
+
     template<typename T, typename Enable = void>
     struct MetaObjectForType
     {
@@ -1702,6 +1708,7 @@ namespace QtPrivate {
                      | (IsWeakPointerToTypeDerivedFromQObject<T>::Value ? QMetaType::WeakPointerToQObject : 0)
                      | (IsTrackingPointerToTypeDerivedFromQObject<T>::Value ? QMetaType::TrackingPointerToQObject : 0)
                      | (std::is_enum<T>::value ? QMetaType::IsEnumeration : 0)
+                     | (IsUnsignedEnum<T>::value ? QMetaType::IsUnsignedEnumeration : 0)
                      | (IsGadgetHelper<T>::IsGadgetOrDerivedFrom ? QMetaType::IsGadget : 0)
                      | (IsPointerToGadgetHelper<T>::IsGadgetOrDerivedFrom ? QMetaType::PointerToGadget : 0)
              };
@@ -64,6 +64,7 @@
 #include <qsemaphore.h>
 #endif
 #include <qsharedpointer.h>
+#include <qpointer.h>
 
 #include <private/qorderedmutexlocker_p.h>
 #include <private/qhooks_p.h>
@@ -225,7 +226,7 @@ QObjectPrivate::~QObjectPrivate()
         }
     }
 
-    if (postedEvents)
+    if (postedEvents || threadData->postEventList.hasIncomingEvents())
         QCoreApplication::removePostedEvents(q_ptr, 0);
 
     threadData->deref();
@@ -620,6 +621,175 @@ void QMetaCallEvent::placeMetaCall(QObject *object)
     }
 }
 
+QMetaCallBatch::QMetaCallBatch(const int *argumentTypes)
+    : types(argumentTypes)
+{
+    constexpr uint align = alignof(std::max_align_t);
+    while (types[nargs]) {
+        offsets.append(recordSize);
+        recordSize += (uint(QMetaType::sizeOf(types[nargs])) + align - 1) & ~(align - 1);
+        ++nargs;
+    }
+    if (recordSize)
+        recordsPerBlock = qMax(1, int((QMetaCallStoragePool::BlockSize - sizeof(Block)) / recordSize));
+}
+
+/*!
+    \internal
+
+    Copies the arguments of one emission into a new record. Records that
+    do not fit a pool block get a block of their own from the heap.
+ */
+void QMetaCallBatch::append(QMetaCallStoragePool *pool, void **argv)
+{
+    if (recordSize) {
+        const int index = pending.count % recordsPerBlock;
+        if (index == 0) {
+            const size_t size = sizeof(Block) + size_t(recordsPerBlock) * recordSize;
+            const bool pooled = size <= size_t(QMetaCallStoragePool::BlockSize);
+            Block *block = new (pooled ? pool->allocate() : ::operator new(size)) Block{nullptr, pooled};
+            if (pending.last)
+                pending.last->next = block;
+            else
+                pending.first = block;
+            pending.last = block;
+        }
+        char *data = record(pending.last, index);
+        for (int n = 0; n < nargs; ++n)
+            QMetaType::construct(types[n], data + offsets[n], argv[n + 1]);
+    }
+    ++pending.count;
+}
+
+/*!
+    \internal
+
+    Destroys the arguments of the records starting at \a from and returns
+    all blocks of \a records to \a pool.
+ */
+void QMetaCallBatch::destroy(Records &records, int from, QMetaCallStoragePool *pool) const
+{
+    int i = 0;
+    Block *block = records.first;
+    while (block) {
+        const int count = qMin(recordsPerBlock, records.count - i);
+        for (int index = 0; index < count; ++index, ++i) {
+            if (i < from)
+                continue;
+            char *data = record(block, index);
+            for (int n = 0; n < nargs; ++n)
+                QMetaType::destruct(types[n], data + offsets[n]);
+        }
+        Block *next = block->next;
+        if (block->pooled)
+            pool->release(block);
+        else
+            ::operator delete(block);
+        block = next;
+    }
+    records = Records();
+}
+
+/*!
+    \internal
+
+    Creates the event that delivers the batch of \a c. The event becomes the
+    batch's open event: emissions append to it until it is delivered.
+ */
+QMetaCallBatchEvent::QMetaCallBatchEvent(QObjectPrivate::Connection *c,
+                                         const QObject *sender, int signalId)
+    : QAbstractMetaCallEvent(sender, signalId),
+      connection_(c),
+      threadData_(c->receiverThreadData.loadRelaxed()),
+      slotObj_(c->isSlotObject ? c->slotObj : nullptr)
+{
+    connection_->ref();
+    threadData_->ref();
+    if (slotObj_)
+        slotObj_->ref();
+}
+
+/*!
+    \internal
+ */
+QMetaCallBatchEvent::~QMetaCallBatchEvent()
+{
+    close();
+    connection_->batch->destroy(records_, delivered_, storagePool());
+    if (slotObj_)
+        slotObj_->destroyIfLastRef();
+    threadData_->deref();
+    connection_->deref();
+}
+
+QMetaCallStoragePool *QMetaCallBatchEvent::storagePool() const
+{
+    return &threadData_->metaCallStoragePool;
+}
+
+/*!
+    \internal
+
+    Takes over the records of the batch. Later emissions start a new batch.
+ */
+void QMetaCallBatchEvent::close()
+{
+    if (closed_)
+        return;
+    closed_ = true;
+    QMetaCallBatch *batch = connection_->batch;
+    QBasicMutexLocker locker(&batch->mutex);
+    Q_ASSERT(batch->open == this);
+    batch->open = nullptr;
+    records_ = std::exchange(batch->pending, QMetaCallBatch::Records());
+}
+
+/*!
+    \internal
+ */
+void QMetaCallBatchEvent::placeMetaCall(QObject *object)
+{
+    close();
+
+    const QMetaCallBatch *batch = connection_->batch;
+    QVarLengthArray<void *, 8> args(batch->nargs + 1);
+    args[0] = nullptr; // return value
+
+    // a slot that deletes the receiver discards the remaining calls
+    QPointer<QObject> guard(object);
+    QMetaCallBatch::Block *block = records_.first;
+    int index = 0;
+    while (delivered_ < records_.count) {
+        char *data = nullptr;
+        if (batch->recordSize) {
+            if (index == batch->recordsPerBlock) {
+                block = block->next;
+                index = 0;
+            }
+            data = batch->record(block, index++);
+            for (int n = 0; n < batch->nargs; ++n)
+                args[n + 1] = data + batch->offsets[n];
+        }
+
+        if (slotObj_) {
+            slotObj_->call(object, args.data());
+        } else if (connection_->callFunction
+                   && connection_->method_offset <= object->metaObject()->methodOffset()) {
+            connection_->callFunction(object, QMetaObject::InvokeMetaMethod,
+                                      connection_->method_relative, args.data());
+        } else {
+            QMetaObject::metacall(object, QMetaObject::InvokeMetaMethod,
+                                  connection_->method(), args.data());
+        }
+
+        for (int n = 0; n < batch->nargs; ++n)
+            QMetaType::destruct(batch->types[n], data + batch->offsets[n]);
+        ++delivered_;
+        if (guard.isNull())
+            return;
+    }
+}
+
 /*!
     \class QSignalBlocker
     \brief Exception-safe wrapper around QObject::blockSignals().
@@ -1093,6 +1263,10 @@ QObjectPrivate::Connection::~Connection()
     }
     if (isSlotObject)
         slotObj->destroyIfLastRef();
+    if (batch) {
+        Q_ASSERT(!batch->open);
+        delete batch;
+    }
 }
 
 
@@ -1570,9 +1744,16 @@ void QObject::moveToThread(QThread *targetThread)
     // keep currentData alive (since we've got it locked)
     currentData->ref();
 
+    // postEvent() may have picked currentData before the move; send it to
+    // the mutex we hold, and take along what it pushed lock-free so far
+    currentData->postEventList.closeIncoming();
+    currentData->postEventList.mergeIncoming();
+
     // move the object
     d_func()->setThreadData_helper(currentData, targetData);
 
+    currentData->postEventList.reopenIncoming();
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -2866,7 +3047,7 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const char *sign
     }
 
     int *types = 0;
-    if ((type == Qt::QueuedConnection)
+    if (((type & ~Qt::BatchedConnection) == Qt::QueuedConnection)
             && !(types = queuedConnectionTypes(signalTypes.constData(), signalTypes.size()))) {
         return QMetaObject::Connection(0);
     }
@@ -2947,7 +3128,7 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const QMetaMetho
     }
 
     int *types = 0;
-    if ((type == Qt::QueuedConnection)
+    if (((type & ~Qt::BatchedConnection) == Qt::QueuedConnection)
             && !(types = queuedConnectionTypes(signal.parameterTypes())))
         return QMetaObject::Connection(0);
 
@@ -3385,6 +3566,9 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     Q_ASSERT(!rmeta || QMetaObjectPrivate::get(rmeta)->revision >= 6);
     QObjectPrivate::StaticMetaCallFunction callFunction = rmeta ? rmeta->d.static_metacall : nullptr;
 
+    const bool batched = type & Qt::BatchedConnection;
+    type &= ~Qt::BatchedConnection;
+
     QOrderedMutexLocker locker(signalSlotLock(sender),
                                signalSlotLock(receiver));
 
@@ -3414,6 +3598,7 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->method_relative = method_index;
     c->method_offset = method_offset;
     c->connectionType = type;
+    c->isBatched = batched;
     c->isSlotObject = false;
     c->argumentTypes.storeRelaxed(types);
     c->callFunction = callFunction;
@@ -3649,6 +3834,53 @@ void QMetaObject::connectSlotsByName(QObject *o)
     }
 }
 
+/*!
+    \internal
+
+    Queued activation of a Qt::BatchedConnection: appends the arguments to
+    the batch whose event is still waiting in the receiver's queue, or posts
+    a new event if there is none.
+*/
+static void batched_activate(QObject *sender, int signal, QObjectPrivate::Connection *c,
+                             const int *argumentTypes, void **argv)
+{
+    QBasicMutexLocker locker(signalSlotLock(c->receiver.loadRelaxed()));
+    if (!c->receiver.loadRelaxed()) {
+        // the connection has been disconnected before we got the lock
+        return;
+    }
+    if (!c->batch)
+        c->batch = new QMetaCallBatch(argumentTypes);
+    QMetaCallBatch *batch = c->batch;
+
+    // The event closes the batch under its mutex before delivering it, so
+    // an open event cannot go away while we hold the mutex. Copy the
+    // arguments without holding signalSlotLock, like queued_activate does.
+    batch->mutex.lock();
+    if (QMetaCallBatchEvent *ev = batch->open) {
+        locker.unlock();
+        batch->append(ev->storagePool(), argv);
+        batch->mutex.unlock();
+        return;
+    }
+
+    QMetaCallBatchEvent *ev = new QMetaCallBatchEvent(c, sender, signal);
+    batch->open = ev;
+    locker.unlock();
+    batch->append(ev->storagePool(), argv);
+    batch->mutex.unlock();
+
+    locker.relock();
+    if (!c->receiver.loadRelaxed()) {
+        // the connection has been disconnected while we were unlocked
+        locker.unlock();
+        delete ev;
+        return;
+    }
+
+    QCoreApplication::postEvent(c->receiver.loadRelaxed(), ev);
+}
+
 /*!
     \internal
 
@@ -3670,6 +3902,10 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
     }
     if (argumentTypes == &DIRECT_CONNECTION_ONLY) // cannot activate
         return;
+    if (c->isBatched) {
+        batched_activate(sender, signal, c, argumentTypes, argv);
+        return;
+    }
     int nargs = 1; // include return type
     while (argumentTypes[nargs-1])
         ++nargs;
@@ -4913,6 +5149,9 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     QObject *s = const_cast<QObject *>(sender);
     QObject *r = const_cast<QObject *>(receiver);
 
+    const bool batched = type & Qt::BatchedConnection;
+    type = static_cast<Qt::ConnectionType>(type & ~Qt::BatchedConnection);
+
     QOrderedMutexLocker locker(signalSlotLock(sender),
                                signalSlotLock(receiver));
 
@@ -4941,6 +5180,7 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     c->receiver.storeRelaxed(r);
     c->slotObj = slotObj;
     c->connectionType = type;
+    c->isBatched = batched;
     c->isSlotObject = true;
     if (types) {
         c->argumentTypes.storeRelaxed(types);
@@ -252,7 +252,8 @@ public:
                           "Return type of the slot is not compatible with the return type of the signal.");
 
         const int *types = nullptr;
-        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection)
+        const int queueType = type & ~Qt::BatchedConnection;
+        if (queueType == Qt::QueuedConnection || queueType == Qt::BlockingQueuedConnection)
             types = QtPrivate::ConnectionTypes<typename SignalType::Arguments>::types();
 
         return connectImpl(sender, reinterpret_cast<void **>(&signal),
@@ -292,7 +293,8 @@ public:
                           "Return type of the slot is not compatible with the return type of the signal.");
 
         const int *types = nullptr;
-        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection)
+        const int queueType = type & ~Qt::BatchedConnection;
+        if (queueType == Qt::QueuedConnection || queueType == Qt::BlockingQueuedConnection)
             types = QtPrivate::ConnectionTypes<typename SignalType::Arguments>::types();
 
         return connectImpl(sender, reinterpret_cast<void **>(&signal), context, nullptr,
@@ -331,7 +333,8 @@ public:
                           "No Q_OBJECT in the class with the signal");
 
         const int *types = nullptr;
-        if (type == Qt::QueuedConnection || type == Qt::BlockingQueuedConnection)
+        const int queueType = type & ~Qt::BatchedConnection;
+        if (queueType == Qt::QueuedConnection || queueType == Qt::BlockingQueuedConnection)
             types = QtPrivate::ConnectionTypes<typename SignalType::Arguments>::types();
 
         return connectImpl(sender, reinterpret_cast<void **>(&signal), context, nullptr,
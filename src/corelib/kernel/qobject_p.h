@@ -61,12 +61,19 @@
 #include "QtCore/qvector.h"
 #include "QtCore/qvariant.h"
 #include "QtCore/qreadwritelock.h"
+#include "QtCore/qmutex.h"
+#include "QtCore/qvarlengtharray.h"
+#include "QtCore/private/qobjectpool_p.h"
+
+#include <cstddef>
 
 QT_BEGIN_NAMESPACE
 
 class QVariant;
 class QThreadData;
 class QObjectConnectionListVector;
+class QMetaCallStoragePool;
+struct QMetaCallBatch;
 namespace QtSharedPointer { struct ExternalRefCountData; }
 
 /* for Qt Test */
@@ -101,6 +108,8 @@ class Q_CORE_EXPORT QObjectPrivate : public QObjectData
     Q_DECLARE_PUBLIC(QObject)
 
 public:
+    Q_OBJECT_POOL_ALLOCATED
+
     struct ExtraData
     {
         ExtraData() {}
@@ -157,7 +166,9 @@ public:
         ushort connectionType : 3; // 0 == auto, 1 == direct, 2 == queued, 4 == blocking
         ushort isSlotObject : 1;
         ushort ownArgumentTypes : 1;
-        Connection() : ref_(2), ownArgumentTypes(true) {
+        ushort isBatched : 1; // Qt::BatchedConnection
+        QMetaCallBatch *batch = nullptr; // created on the first batched emission
+        Connection() : ref_(2), ownArgumentTypes(true), isBatched(false) {
             //ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
         }
         ~Connection();
@@ -245,6 +256,8 @@ public:
         linked list.
     */
     struct ConnectionData {
+        Q_OBJECT_POOL_ALLOCATED
+
         // the id below is used to avoid activating new connections. When the object gets
         // deleted it's set to 0, so that signal emission stops
         QAtomicInteger<uint> currentConnectionId;
@@ -478,7 +491,10 @@ public:
 #if QT_CONFIG(thread)
         , semaphore_(semaphore)
 #endif
-    { Q_UNUSED(semaphore); }
+    {
+        Q_UNUSED(semaphore);
+        m_metaCallEvent = true;
+    }
     ~QAbstractMetaCallEvent();
 
     virtual void placeMetaCall(QObject *object) = 0;
@@ -487,16 +503,23 @@ public:
     inline int signalId() const { return signalId_; }
 
 private:
+    friend class QPostEventList;
+
     int signalId_;
     const QObject *sender_;
 #if QT_CONFIG(thread)
     QSemaphore *semaphore_;
 #endif
+    // set while the event waits in QPostEventList's lock-free stack
+    QObject *postedReceiver_ = nullptr;
+    QAbstractMetaCallEvent *postedNext_ = nullptr;
 };
 
 class Q_CORE_EXPORT QMetaCallEvent : public QAbstractMetaCallEvent
 {
 public:
+    Q_OBJECT_POOL_ALLOCATED
+
     // blocking queued with semaphore - args always owned by caller
     QMetaCallEvent(ushort method_offset, ushort method_relative,
                    QObjectPrivate::StaticMetaCallFunction callFunction,
@@ -540,6 +563,64 @@ private:
     char prealloc_[3*(sizeof(void*) + sizeof(int))];
 };
 
+class QMetaCallBatchEvent;
+
+// The invocations of a Qt::BatchedConnection that were emitted while its
+// QMetaCallBatchEvent waits in the receiver's queue. The arguments of each
+// invocation are copied into a fixed-size record; the records are carved out
+// of blocks taken from the QMetaCallStoragePool of the receiver's thread.
+struct QMetaCallBatch
+{
+    struct alignas(std::max_align_t) Block {
+        Block *next;
+        bool pooled;
+    };
+    struct Records {
+        Block *first = nullptr;
+        Block *last = nullptr;
+        int count = 0;
+    };
+
+    explicit QMetaCallBatch(const int *argumentTypes);
+
+    void append(QMetaCallStoragePool *pool, void **argv);
+    char *record(Block *block, int index) const
+    { return reinterpret_cast<char *>(block + 1) + index * recordSize; }
+    void destroy(Records &records, int from, QMetaCallStoragePool *pool) const;
+
+    // mutex protects open and pending; lock it after signalSlotLock(receiver)
+    QBasicMutex mutex;
+    QMetaCallBatchEvent *open = nullptr;
+    Records pending;
+
+    const int *types; // zero-terminated, without the return type
+    int nargs = 0;
+    uint recordSize = 0;
+    int recordsPerBlock = 0;
+    QVarLengthArray<uint, 4> offsets;
+};
+
+class QMetaCallBatchEvent : public QAbstractMetaCallEvent
+{
+public:
+    // must be called with signalSlotLock(receiver) held
+    QMetaCallBatchEvent(QObjectPrivate::Connection *c, const QObject *sender, int signalId);
+    ~QMetaCallBatchEvent() override;
+
+    QMetaCallStoragePool *storagePool() const;
+    void placeMetaCall(QObject *object) override;
+
+private:
+    void close();
+
+    QObjectPrivate::Connection *connection_;
+    QThreadData *threadData_;
+    QtPrivate::QSlotObjectBase *slotObj_;
+    QMetaCallBatch::Records records_;
+    int delivered_ = 0;
+    bool closed_ = false;
+};
+
 class QBoolBlocker
 {
     Q_DISABLE_COPY_MOVE(QBoolBlocker)
@@ -0,0 +1,285 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qobjectpool_p.h"
+
+#include <QtCore/private/qfreelist_p.h>
+#include <QtCore/qobjectdefs.h>
+
+#include <array>
+#include <cstddef>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// The block sizes, chosen to fit the private classes as measured on 64-bit
+// Linux: ConnectionData (40), QObjectPrivate (88), QAbstractEventDispatcher-
+// Private (96), QMetaCallEvent and QEventLoopPrivate (104 to 128),
+// QThreadPrivate and QAbstractItemModelPrivate (136 to 144), QIODevice-
+// Private and QThreadPoolPrivate (152 to 192), QFilePrivate, QNative-
+// SocketEnginePrivate and QVariantAnimationPrivate (200 to 256),
+// QAbstractSocketPrivate and QNetworkReplyPrivate (272 to 384), and
+// QNetworkReplyHttpImplPrivate (608). Anything larger uses the heap.
+constexpr int SizeClasses[] = { 48, 96, 128, 144, 192, 256, 384, 640 };
+
+enum {
+    SizeClassCount = int(sizeof(SizeClasses) / sizeof(SizeClasses[0])),
+    MaxPooledSize = SizeClasses[SizeClassCount - 1],
+    Granularity = 16, // all sizes are multiples of it
+    CacheSize = 32 // blocks cached per size class and thread
+};
+
+constexpr int smallestSizeClass(int size, int sizeClass = 0)
+{
+    return SizeClasses[sizeClass] < size ? smallestSizeClass(size, sizeClass + 1) : sizeClass;
+}
+
+// Maps a size, rounded up to Granularity, to the smallest class that fits.
+struct SizeClassTable
+{
+    quint8 index[MaxPooledSize / Granularity + 1];
+};
+
+template <int... I>
+constexpr SizeClassTable makeSizeClassTable(QtPrivate::IndexesList<I...>)
+{
+    return {{ quint8(smallestSizeClass(I * Granularity))... }};
+}
+
+constexpr SizeClassTable sizeClassTable =
+        makeSizeClassTable(QtPrivate::makeIndexSequence<MaxPooledSize / Granularity + 1>());
+
+static inline int sizeClassOf(std::size_t size)
+{
+    return sizeClassTable.index[(size + Granularity - 1) / Granularity];
+}
+
+struct FreeListConstants : QFreeListDefaultConstants
+{
+    enum { BlockCount = 12 };
+    static const int Sizes[BlockCount];
+};
+
+// 256 elements in the first block, doubling up to about a million
+const int FreeListConstants::Sizes[FreeListConstants::BlockCount] = {
+    256 << 0, 256 << 1, 256 << 2, 256 << 3, 256 << 4, 256 << 5,
+    256 << 6, 256 << 7, 256 << 8, 256 << 9, 256 << 10, 256 << 11
+};
+
+enum { Capacity = 256 * ((1 << FreeListConstants::BlockCount) - 1) };
+
+template <int SizeClass>
+struct alignas(std::max_align_t) Block
+{
+    char data[SizeClasses[SizeClass]];
+};
+
+template <int SizeClass>
+struct Pool
+{
+    QFreeList<Block<SizeClass>, FreeListConstants> freeList;
+    QAtomicInt taken; // blocks handed out of freeList
+
+    // returns -1 once all blocks are in use
+    int take()
+    {
+        if (taken.fetchAndAddRelaxed(1) >= int(Capacity)) {
+            taken.deref();
+            return -1;
+        }
+        return freeList.next();
+    }
+
+    void give(int id)
+    {
+        freeList.release(id);
+        taken.deref();
+    }
+};
+
+// Never destroyed, so that objects in global statics can still be freed
+// after it would have been.
+template <int SizeClass>
+static Pool<SizeClass> &pool()
+{
+    static Pool<SizeClass> *p = new Pool<SizeClass>;
+    return *p;
+}
+
+// Trivially destructible, so that it stays usable while the thread's other
+// thread_local objects are being destroyed.
+struct ThreadCache
+{
+    int ids[SizeClassCount][CacheSize];
+    int counts[SizeClassCount];
+    bool registered;
+    bool finished;
+};
+
+thread_local ThreadCache threadCache;
+
+template <int SizeClass>
+static void flush(ThreadCache &cache)
+{
+    if (!cache.counts[SizeClass])
+        return;
+    Pool<SizeClass> &p = pool<SizeClass>();
+    while (cache.counts[SizeClass])
+        p.give(cache.ids[SizeClass][--cache.counts[SizeClass]]);
+}
+
+template <int... SizeClass>
+static void flushAll(ThreadCache &cache, QtPrivate::IndexesList<SizeClass...>)
+{
+    int dummy[] = { (flush<SizeClass>(cache), 0)... };
+    Q_UNUSED(dummy);
+}
+
+// Returns the cached blocks to the free lists when the thread exits.
+struct ThreadCacheCleanup
+{
+    ~ThreadCacheCleanup()
+    {
+        ThreadCache &cache = threadCache;
+        cache.finished = true;
+        flushAll(cache, QtPrivate::makeIndexSequence<SizeClassCount>());
+    }
+    void ensureRegistered() { threadCache.registered = true; }
+};
+
+thread_local ThreadCacheCleanup threadCacheCleanup;
+
+static bool poolEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QT_OBJECT_POOL") > 0;
+    return enabled;
+}
+
+template <int SizeClass>
+static void *allocateBlock()
+{
+    Pool<SizeClass> &p = pool<SizeClass>();
+    ThreadCache &cache = threadCache;
+    int id;
+    if (cache.counts[SizeClass]) {
+        id = cache.ids[SizeClass][--cache.counts[SizeClass]];
+    } else {
+        id = p.take();
+        if (id < 0)
+            return ::operator new(sizeof(Block<SizeClass>));
+    }
+    return &p.freeList[id];
+}
+
+template <int SizeClass>
+static void freeBlock(void *ptr)
+{
+    Pool<SizeClass> &p = pool<SizeClass>();
+    const int id = p.freeList.indexOf(ptr);
+    if (id < 0) {
+        // allocated while the free list was exhausted
+        ::operator delete(ptr);
+        return;
+    }
+
+    ThreadCache &cache = threadCache;
+    if (cache.finished || cache.counts[SizeClass] == CacheSize) {
+        p.give(id);
+        return;
+    }
+    if (Q_UNLIKELY(!cache.registered))
+        threadCacheCleanup.ensureRegistered();
+    cache.ids[SizeClass][cache.counts[SizeClass]++] = id;
+}
+
+struct SizeClassFunctions
+{
+    void *(*allocate)();
+    void (*free)(void *);
+};
+
+template <int... SizeClass>
+constexpr std::array<SizeClassFunctions, SizeClassCount>
+makeSizeClassFunctions(QtPrivate::IndexesList<SizeClass...>)
+{
+    return {{ { allocateBlock<SizeClass>, freeBlock<SizeClass> }... }};
+}
+
+constexpr std::array<SizeClassFunctions, SizeClassCount> sizeClassFunctions =
+        makeSizeClassFunctions(QtPrivate::makeIndexSequence<SizeClassCount>());
+
+static inline bool isPooled(std::size_t size)
+{
+    return size && size <= std::size_t(MaxPooledSize) && poolEnabled();
+}
+
+} // unnamed namespace
+
+/*!
+    \internal
+
+    Returns memory for an object of \a size bytes, from the pool if it is
+    enabled and \a size is small enough.
+*/
+void *QObjectPool::allocate(std::size_t size)
+{
+    if (!isPooled(size))
+        return ::operator new(size);
+    return sizeClassFunctions[sizeClassOf(size)].allocate();
+}
+
+/*!
+    \internal
+
+    Releases the memory at \a ptr, which was returned by allocate() for the
+    same \a size.
+*/
+void QObjectPool::free(void *ptr, std::size_t size) noexcept
+{
+    if (!ptr)
+        return;
+    if (!isPooled(size)) {
+        ::operator delete(ptr);
+        return;
+    }
+    sizeClassFunctions[sizeClassOf(size)].free(ptr);
+}
+
+QT_END_NAMESPACE
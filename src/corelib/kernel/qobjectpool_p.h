@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QOBJECTPOOL_P_H
+#define QOBJECTPOOL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+
+#include <new>
+
+QT_BEGIN_NAMESPACE
+
+// Recycles the memory of small objects that QtCore creates and destroys at
+// a high rate: QObjectPrivate, QObjectPrivate::ConnectionData and
+// QMetaCallEvent. Blocks come from one QFreeList per size class, so that any
+// thread can free a block that another thread allocated. Every thread keeps
+// a small cache of free blocks in front of the free lists. The memory of the
+// free lists is never returned to the system.
+//
+// The pool is off by default; set QT_OBJECT_POOL=1 to enable it.
+class Q_CORE_EXPORT QObjectPool
+{
+public:
+    static void *allocate(std::size_t size);
+    static void free(void *ptr, std::size_t size) noexcept;
+};
+
+#define Q_OBJECT_POOL_ALLOCATED \
+    static void *operator new(std::size_t size) \
+    { return QObjectPool::allocate(size); } \
+    static void *operator new(std::size_t, void *where) noexcept \
+    { return where; } \
+    static void operator delete(void *ptr, std::size_t size) noexcept \
+    { QObjectPool::free(ptr, size); } \
+    static void operator delete(void *, void *) noexcept \
+    {}
+
+QT_END_NAMESPACE
+
+#endif // QOBJECTPOOL_P_H
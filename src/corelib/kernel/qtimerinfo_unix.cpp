@@ -84,6 +84,14 @@ QTimerInfoList::QTimerInfoList()
 #endif
 
     firstTimerInfo = 0;
+    std::fill_n(occupied, int(WheelLevels), 0);
+    wheelTime = 0;
+    firstFarTimerCache = nullptr;
+}
+
+QTimerInfoList::~QTimerInfoList()
+{
+    qDeleteAll(timers);
 }
 
 timespec QTimerInfoList::updateCurrentTime()
@@ -150,10 +158,16 @@ bool QTimerInfoList::timeChanged(timespec *delta)
 */
 void QTimerInfoList::timerRepair(const timespec &diff)
 {
-    // repair all timers
-    for (int i = 0; i < size(); ++i) {
-        QTimerInfo *t = at(i);
+    // repair all timers, their buckets are wrong now
+    if (!buckets)
+        return;
+    std::fill_n(buckets.get(), int(BucketCount), Bucket{nullptr, nullptr});
+    std::fill_n(occupied, int(WheelLevels), 0);
+    wheelTime = qint64(currentTime.tv_sec) * 1000 + currentTime.tv_nsec / (1000 * 1000);
+    firstFarTimerCache = nullptr;
+    for (QTimerInfo *t : qAsConst(timers)) {
         t->timeout = t->timeout + diff;
+        timerInsert(t);
     }
 }
 
@@ -174,18 +188,201 @@ void QTimerInfoList::repairTimersIfNeeded()
 
 #endif
 
+static inline qint64 timespecToTick(const timespec &t)
+{
+    return qint64(t.tv_sec) * 1000 + t.tv_nsec / (1000 * 1000);
+}
+
 /*
-  insert timer info into list
+  insert timer info into the wheel
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
+    const qint64 tick = timespecToTick(ti->timeout);
+    int level = 0;
+    if (tick < wheelTime) {
+        ti->bucket = DueBucket;
+    } else {
+        // the level is given by the highest 64-block that differs from the current time
+        const quint64 diff = quint64(tick ^ wheelTime);
+        if (diff >= WheelSize)
+            level = qMin((63 - int(qCountLeadingZeroBits(diff))) / WheelBits, WheelLevels - 1);
+        const int slot = int(tick >> (level * WheelBits)) & (WheelSize - 1);
+        ti->bucket = level * WheelSize + slot;
+        occupied[level] |= Q_UINT64_C(1) << slot;
+    }
+
+    Bucket &b = buckets[ti->bucket];
+    QTimerInfo *after = b.last;
+    if (level == 0) {
+        // keep the timers of the same tick sorted, after those with the same timeout
+        while (after && ti->timeout < after->timeout)
+            after = after->prev;
+    } else if (firstFarTimerCache && firstFarTimerCache->bucket == ti->bucket
+               && ti->timeout < firstFarTimerCache->timeout) {
+        firstFarTimerCache = ti;
+    }
+    ti->prev = after;
+    ti->next = after ? after->next : b.first;
+    if (ti->next)
+        ti->next->prev = ti;
+    else
+        b.last = ti;
+    if (after)
+        after->next = ti;
+    else
+        b.first = ti;
+}
+
+/*
+  remove timer info from the wheel
+*/
+void QTimerInfoList::timerRemove(QTimerInfo *ti)
+{
+    Bucket &b = buckets[ti->bucket];
+    if (ti->prev)
+        ti->prev->next = ti->next;
+    else
+        b.first = ti->next;
+    if (ti->next)
+        ti->next->prev = ti->prev;
+    else
+        b.last = ti->prev;
+    if (!b.first && ti->bucket != DueBucket)
+        occupied[ti->bucket / WheelSize] &= ~(Q_UINT64_C(1) << (ti->bucket % WheelSize));
+    if (ti == firstFarTimerCache)
+        firstFarTimerCache = nullptr;
+}
+
+/*
+  move the wheel forward to the given time: the timers of the ticks before
+  it end up in the due bucket, and the timers of the block it falls in are
+  moved down to level 0
+*/
+void QTimerInfoList::advanceWheel(const timespec &time)
+{
+    const qint64 tick = timespecToTick(time);
+    Bucket &due = buckets[DueBucket];
+    while (wheelTime < tick) {
+        const qint64 blockEnd = wheelTime | (WheelSize - 1);
+        quint64 expired = occupied[0];
+        if (tick <= blockEnd)
+            expired &= (Q_UINT64_C(1) << (tick & (WheelSize - 1))) - 1;
+        occupied[0] &= ~expired;
+        while (expired) {
+            // splice the bucket onto the due bucket, it is sorted already
+            const int slot = int(qCountTrailingZeroBits(expired));
+            expired &= expired - 1;
+            Bucket &b = buckets[slot];
+            for (QTimerInfo *t = b.first; t; t = t->next)
+                t->bucket = DueBucket;
+            b.first->prev = due.last;
+            if (due.last)
+                due.last->next = b.first;
+            else
+                due.first = b.first;
+            due.last = b.last;
+            b.first = b.last = nullptr;
+        }
+        if (tick <= blockEnd)
             break;
+
+        // find the first block with timers on the higher levels, the lower
+        // levels start before the higher ones
+        int level = 1;
+        while (level < WheelLevels && !occupied[level])
+            ++level;
+        if (level == WheelLevels)
+            break;
+        const int shift = level * WheelBits;
+        const int slot = int(qCountTrailingZeroBits(occupied[level]));
+        const qint64 blockStart = (wheelTime >> (shift + WheelBits) << (shift + WheelBits))
+                | (qint64(slot) << shift);
+        if (blockStart > tick)
+            break;
+
+        // cascade its timers down
+        wheelTime = blockStart;
+        Bucket &b = buckets[level * WheelSize + slot];
+        QTimerInfo *t = b.first;
+        b.first = b.last = nullptr;
+        occupied[level] &= ~(Q_UINT64_C(1) << slot);
+        if (firstFarTimerCache && firstFarTimerCache->bucket == level * WheelSize + slot)
+            firstFarTimerCache = nullptr;
+        while (t) {
+            QTimerInfo *next = t->next;
+            timerInsert(t);
+            t = next;
+        }
     }
-    insert(index+1, ti);
+    wheelTime = qMax(wheelTime, tick);
+}
+
+/*
+  returns the first timer of the due bucket and level 0, in timeout order
+*/
+QTimerInfo *QTimerInfoList::firstNearTimer() const
+{
+    if (!buckets)
+        return nullptr;
+    if (buckets[DueBucket].first)
+        return buckets[DueBucket].first;
+    if (occupied[0])
+        return buckets[qCountTrailingZeroBits(occupied[0])].first;
+    return nullptr;
+}
+
+QTimerInfo *QTimerInfoList::nextNearTimer(const QTimerInfo *t) const
+{
+    if (t->next)
+        return t->next;
+    quint64 later = occupied[0];
+    if (t->bucket != DueBucket)
+        later &= ~((Q_UINT64_C(2) << t->bucket) - 1);
+    if (later)
+        return buckets[qCountTrailingZeroBits(later)].first;
+    return nullptr;
+}
+
+/*
+  returns the earliest timer above level 0, optionally only among those
+  not being activated
+*/
+QTimerInfo *QTimerInfoList::firstFarTimer(bool waitingOnly)
+{
+    // the first bucket holds the earliest timer, the lower levels start
+    // before the higher ones
+    int level = 1;
+    while (level < WheelLevels && !occupied[level])
+        ++level;
+    if (level == WheelLevels)
+        return nullptr;
+
+    const int firstBucket = level * WheelSize + int(qCountTrailingZeroBits(occupied[level]));
+    if (!firstFarTimerCache || firstFarTimerCache->bucket != firstBucket) {
+        firstFarTimerCache = buckets[firstBucket].first;
+        for (QTimerInfo *t = firstFarTimerCache->next; t; t = t->next) {
+            if (t->timeout < firstFarTimerCache->timeout)
+                firstFarTimerCache = t;
+        }
+    }
+    if (!waitingOnly || !firstFarTimerCache->activateRef)
+        return firstFarTimerCache;
+
+    // rare: we are inside the activation of that timer, look further
+    for (; level < WheelLevels; ++level) {
+        for (quint64 bits = occupied[level]; bits; bits &= bits - 1) {
+            const int bucket = level * WheelSize + int(qCountTrailingZeroBits(bits));
+            QTimerInfo *first = nullptr;
+            for (QTimerInfo *t = buckets[bucket].first; t; t = t->next) {
+                if (!t->activateRef && (!first || t->timeout < first->timeout))
+                    first = t;
+            }
+            if (first)
+                return first;
+        }
+    }
+    return nullptr;
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -387,15 +584,16 @@ bool QTimerInfoList::timerWait(timespec &tm)
 {
     timespec currentTime = updateCurrentTime();
     repairTimersIfNeeded();
+    if (isEmpty())
+        return false;
+    advanceWheel(currentTime);
 
     // Find first waiting timer not already active
-    QTimerInfo *t = 0;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
-            break;
-        }
-    }
+    QTimerInfo *t = firstNearTimer();
+    while (t && t->activateRef)
+        t = nextNearTimer(t);
+    if (!t)
+        t = firstFarTimer(true);
 
     if (!t)
       return false;
@@ -423,16 +621,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timers.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -453,6 +648,10 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
     t->activateRef = 0;
 
     timespec expected = updateCurrentTime() + interval;
+    if (!buckets)
+        buckets.reset(new Bucket[BucketCount]());
+    if (isEmpty())
+        wheelTime = timespecToTick(currentTime);
 
     switch (timerType) {
     case Qt::PreciseTimer:
@@ -494,6 +693,7 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
     }
 
     timerInsert(t);
+    timers.insert(timerId, t);
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -508,39 +708,37 @@ void QTimerInfoList::registerTimer(int timerId, int interval, Qt::TimerType time
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
     // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = 0;
-            if (t->activateRef)
-                *(t->activateRef) = 0;
-            delete t;
-            return true;
-        }
+    QTimerInfo *t = timers.take(timerId);
+    if (!t) {
+        // id not found
+        return false;
     }
-    // id not found
-    return false;
+    timerRemove(t);
+    if (t == firstTimerInfo)
+        firstTimerInfo = 0;
+    if (t->activateRef)
+        *(t->activateRef) = 0;
+    delete t;
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
+    for (auto it = timers.begin(); it != timers.end(); ) {
+        QTimerInfo *t = it.value();
         if (t->obj == object) {
             // object found
-            removeAt(i);
+            it = timers.erase(it);
+            timerRemove(t);
             if (t == firstTimerInfo)
                 firstTimerInfo = 0;
             if (t->activateRef)
                 *(t->activateRef) = 0;
             delete t;
-            // move back one so that we don't skip the new current item
-            --i;
+        } else {
+            ++it;
         }
     }
     return true;
@@ -549,8 +747,7 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (int i = 0; i < count(); ++i) {
-        const QTimerInfo * const t = at(i);
+    for (const QTimerInfo * const t : timers) {
         if (t->obj == object) {
             list << QAbstractEventDispatcher::TimerInfo(t->id,
                                                         (t->timerType == Qt::VeryCoarseTimer
@@ -576,22 +773,19 @@ int QTimerInfoList::activateTimers()
     timespec currentTime = updateCurrentTime();
     // qDebug() << "Thread" << QThread::currentThreadId() << "woken up at" << currentTime;
     repairTimersIfNeeded();
+    advanceWheel(currentTime);
 
-
-    // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
+    // Find out how many timer have expired, they are all in the near buckets
+    for (QTimerInfo *t = firstNearTimer(); t; t = nextNearTimer(t)) {
+        if (currentTime < t->timeout)
             break;
         maxCount++;
     }
 
     //fire the timers.
     while (maxCount--) {
-        if (isEmpty())
-            break;
-
-        QTimerInfo *currentTimerInfo = constFirst();
-        if (currentTime < currentTimerInfo->timeout)
+        QTimerInfo *currentTimerInfo = firstNearTimer();
+        if (!currentTimerInfo || currentTime < currentTimerInfo->timeout)
             break; // no timer has expired
 
         if (!firstTimerInfo) {
@@ -604,8 +798,8 @@ int QTimerInfoList::activateTimers()
             firstTimerInfo = currentTimerInfo;
         }
 
-        // remove from list
-        removeFirst();
+        // remove from wheel
+        timerRemove(currentTimerInfo);
 
 #ifdef QTIMERINFO_DEBUG
         float diff;
@@ -56,6 +56,9 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
+
+#include <memory>
 
 #include <sys/time.h> // struct timeval
 
@@ -69,6 +72,9 @@ struct QTimerInfo {
     timespec timeout;  // - when to actually fire
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
+    QTimerInfo *prev; // - neighbours in the timer wheel bucket
+    QTimerInfo *next;
+    int bucket;       // - index of that bucket
 
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
@@ -77,7 +83,7 @@ struct QTimerInfo {
 #endif
 };
 
-class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
+class Q_CORE_EXPORT QTimerInfoList
 {
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
     timespec previousTime;
@@ -92,8 +98,39 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     // state variables used by activateTimers()
     QTimerInfo *firstTimerInfo;
 
+    // The timers live in a hierarchical timer wheel of millisecond ticks.
+    // Level 0 has one bucket per tick of the current 64 ms block, level n
+    // one bucket per 64^n ms block of the current 64^(n+1) ms block. Timers
+    // move down a level when their block becomes the current one, so
+    // inserting and removing a timer is O(1) amortized. Only level 0 and
+    // the due bucket, which holds timers of past ticks, are sorted.
+    enum {
+        WheelBits = 6,
+        WheelSize = 1 << WheelBits,
+        WheelLevels = 7,
+        DueBucket = WheelLevels * WheelSize,
+        BucketCount
+    };
+    struct Bucket {
+        QTimerInfo *first;
+        QTimerInfo *last;
+    };
+    std::unique_ptr<Bucket[]> buckets;
+    quint64 occupied[WheelLevels];
+    qint64 wheelTime;
+    QHash<int, QTimerInfo *> timers;
+    // earliest timer of the first bucket above level 0, see firstFarTimer()
+    QTimerInfo *firstFarTimerCache;
+
+    void timerRemove(QTimerInfo *);
+    void advanceWheel(const timespec &);
+    QTimerInfo *firstNearTimer() const;
+    QTimerInfo *nextNearTimer(const QTimerInfo *) const;
+    QTimerInfo *firstFarTimer(bool waitingOnly);
+
 public:
     QTimerInfoList();
+    ~QTimerInfoList();
 
     timespec currentTime;
     timespec updateCurrentTime();
@@ -112,6 +149,9 @@ public:
     QList<QAbstractEventDispatcher::TimerInfo> registeredTimers(QObject *object) const;
 
     int activateTimers();
+
+    bool isEmpty() const { return timers.isEmpty(); }
+    int size() const { return timers.size(); }
 };
 
 QT_END_NAMESPACE
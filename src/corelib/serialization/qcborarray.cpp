@@ -143,6 +143,7 @@ QCborArray::QCborArray(const QCborArray &other) noexcept
  */
 QCborArray::~QCborArray()
 {
+    QCborContainerPrivate::replace(d, nullptr);
 }
 
 /*!
@@ -151,7 +152,7 @@ QCborArray::~QCborArray()
  */
 QCborArray &QCborArray::operator=(const QCborArray &other) noexcept
 {
-    d = other.d;
+    QCborContainerPrivate::replace(d, other.d.data());
     return *this;
 }
 
@@ -193,7 +194,7 @@ qsizetype QCborArray::size() const noexcept
  */
 void QCborArray::clear()
 {
-    d.reset();
+    QCborContainerPrivate::replace(d, nullptr);
 }
 
 /*!
@@ -327,7 +328,8 @@ void QCborArray::insert(qsizetype i, const QCborValue &value)
         i = size();
         detach(i + 1);
     } else {
-        d = QCborContainerPrivate::grow(d.data(), i); // detaches
+        // detaches
+        QCborContainerPrivate::replace(d, QCborContainerPrivate::grow(d.data(), i));
     }
     d->insertAt(i, value);
 }
@@ -339,7 +341,8 @@ void QCborArray::insert(qsizetype i, QCborValue &&value)
         i = size();
         detach(i + 1);
     } else {
-        d = QCborContainerPrivate::grow(d.data(), i); // detaches
+        // detaches
+        QCborContainerPrivate::replace(d, QCborContainerPrivate::grow(d.data(), i));
     }
     d->insertAt(i, value, QCborContainerPrivate::MoveContainer);
     QCborContainerPrivate::resetValue(value);
@@ -702,7 +705,8 @@ bool QCborArray::contains(const QCborValue &value) const
 
 void QCborArray::detach(qsizetype reserved)
 {
-    d = QCborContainerPrivate::detach(d.data(), reserved ? reserved : size());
+    QCborContainerPrivate::replace(d, QCborContainerPrivate::detach(d.data(),
+                                                                    reserved ? reserved : size()));
 }
 
 /*!
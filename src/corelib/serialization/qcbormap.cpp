@@ -233,6 +233,7 @@ QCborMap::QCborMap(const QCborMap &other) noexcept
  */
 QCborMap::~QCborMap()
 {
+    QCborContainerPrivate::replace(d, nullptr);
 }
 
 /*!
@@ -241,7 +242,7 @@ QCborMap::~QCborMap()
  */
 QCborMap &QCborMap::operator=(const QCborMap &other) noexcept
 {
-    d = other.d;
+    QCborContainerPrivate::replace(d, other.d.data());
     return *this;
 }
 
@@ -290,7 +291,7 @@ qsizetype QCborMap::size() const noexcept
  */
 void QCborMap::clear()
 {
-    d.reset();
+    QCborContainerPrivate::replace(d, nullptr);
 }
 
 /*!
@@ -1229,7 +1230,8 @@ QCborValue QCborMap::extract(iterator it)
 
 void QCborMap::detach(qsizetype reserved)
 {
-    d = QCborContainerPrivate::detach(d.data(), reserved ? reserved : size() * 2);
+    QCborContainerPrivate::replace(d, QCborContainerPrivate::detach(d.data(),
+                                                                    reserved ? reserved : size() * 2));
 }
 
 /*!
@@ -49,6 +49,7 @@
 
 #include <qendian.h>
 #include <qlocale.h>
+#include <qvarlengtharray.h>
 #include <private/qnumeric_p.h>
 #include <private/qsimd_p.h>
 
@@ -293,6 +294,28 @@ QT_BEGIN_NAMESPACE
     \sa toDiagnosticNotation()
  */
 
+/*!
+    \enum QCborValue::DecodingOption
+    \since 6.0
+
+    This enum is used in the options argument to fromCbor(), modifying how
+    the decoded value is stored.
+
+    \value NoDecodingOption (Default) Allocates each map and array separately.
+    \value UseArena         Stores all maps and arrays of the decoded value in a
+                            few large blocks of memory, which are released
+                            together when the last of them is destroyed.
+
+    Decoding a large document with \c UseArena needs far fewer memory
+    allocations, and destroying it is faster. A map or array stored in the
+    arena is copied to its own memory the first time it is modified, so
+    \c UseArena is best suited for documents that are mostly read. The arena is
+    kept until every map and array in it has been destroyed, even if only a
+    small part of the document is still referenced.
+
+    \sa fromCbor()
+ */
+
 /*!
     \enum QCborValue::Type
 
@@ -815,10 +838,133 @@ static inline int typeOrder(Element e1, Element e2)
     return comparable(e1) - comparable(e2);
 }
 
+/*
+    QCborArena is a monotonic allocator for the containers of a whole decoded
+    CBOR document (see QCborValue::UseArena). Each container is stored in one
+    piece, followed by its element array and its byte data. Those arrays have
+    static QArrayData headers, so QVector and QByteArray never free them and
+    detach to the heap on the first modification.
+
+    The arena counts the containers it holds and releases all of its blocks
+    when the last one is deleted. Containers in an arena have the inArena flag
+    set and are preceded by a pointer to their arena, which
+    QCborContainerPrivate::deref() uses to release them instead of deleting
+    them. Containers allocated on the heap carry no such prefix.
+*/
+class QCborArena
+{
+    struct Block
+    {
+        Block *next;
+        qsizetype size;
+        qsizetype used;
+
+        char *begin() { return reinterpret_cast<char *>(this + 1); }
+    };
+
+    QAtomicInt live = 1;       // the decoder holds the first reference
+    Block *blocks = nullptr;
+    qsizetype nextBlockSize;
+
+public:
+    enum : size_t {
+        Alignment = qMax(alignof(Element), alignof(QCborContainerPrivate)),
+        PrefixSize = qMax(sizeof(QCborArena *), Alignment),
+        MinimumBlockSize = 4096 - sizeof(Block)
+    };
+
+    explicit QCborArena(qsizetype sizeHint)
+        : nextBlockSize(qMax(qsizetype(MinimumBlockSize), sizeHint))
+    {}
+    ~QCborArena()
+    {
+        while (blocks) {
+            Block *next = blocks->next;
+            ::free(blocks);
+            blocks = next;
+        }
+    }
+
+    void deref() { if (!live.deref()) delete this; }
+
+    static QCborArena *arenaOf(const QCborContainerPrivate *d)
+    {
+        Q_ASSERT(d->inArena);
+        auto prefix = reinterpret_cast<const char *>(d) - PrefixSize;
+        return *reinterpret_cast<QCborArena *const *>(prefix);
+    }
+
+    char *allocate(qsizetype size)
+    {
+        size = (size + Alignment - 1) & ~qsizetype(Alignment - 1);
+        if (!blocks || blocks->size - blocks->used < size) {
+            const qsizetype blockSize = qMax(nextBlockSize, size);
+            Block *b = static_cast<Block *>(::malloc(sizeof(Block) + blockSize));
+            Q_CHECK_PTR(b);
+            b->next = blocks;
+            b->size = blockSize;
+            b->used = 0;
+            blocks = b;
+            nextBlockSize = 2 * blockSize;
+        }
+        char *ptr = blocks->begin() + blocks->used;
+        blocks->used += size;
+        return ptr;
+    }
+
+    // Copies the decoded elements and byte data of \a scratch into a new
+    // container in the arena and takes over its references to the nested
+    // containers. The returned container has a reference count of 1.
+    QCborContainerPrivate *copyContainer(QCborContainerPrivate *scratch)
+    {
+        const qsizetype count = scratch->elements.size();
+        const qsizetype bytes = scratch->data.size();
+        auto aligned = [](qsizetype n) { return (n + Alignment - 1) & ~qsizetype(Alignment - 1); };
+        const qsizetype elementsOffset = aligned(PrefixSize + sizeof(QCborContainerPrivate));
+        const qsizetype dataOffset = aligned(elementsOffset + sizeof(QArrayData) + count * sizeof(Element));
+        const qsizetype size = dataOffset + (bytes ? sizeof(QArrayData) + bytes + 1 : 0);
+
+        char *ptr = allocate(size);
+        *reinterpret_cast<QCborArena **>(ptr) = this;
+        live.ref();
+
+        auto d = new (ptr + PrefixSize) QCborContainerPrivate;
+        d->ref.storeRelaxed(1);
+        d->inArena = true;
+        d->usedData = scratch->usedData;
+        if (count) {
+            auto header = new (ptr + elementsOffset) QArrayData{
+                    Q_REFCOUNT_INITIALIZE_STATIC, int(count), uint(count), 0, sizeof(QArrayData) };
+            memcpy(header->data(), scratch->elements.constData(), count * sizeof(Element));
+            d->elements = QVector<Element>(QArrayDataPointerRef<Element>{
+                    static_cast<QTypedArrayData<Element> *>(header) });
+        }
+        if (bytes) {
+            auto header = new (ptr + dataOffset) QArrayData{
+                    Q_REFCOUNT_INITIALIZE_STATIC, int(bytes), uint(bytes + 1), 0, sizeof(QArrayData) };
+            memcpy(header->data(), scratch->data.constData(), bytes + 1);
+            d->data = QByteArray(QByteArrayDataPtr{ header });
+        }
+
+        // the nested containers now belong to d
+        scratch->elements.clear();
+        scratch->data.resize(0);
+        scratch->usedData = 0;
+        return d;
+    }
+};
+
+void QCborContainerPrivate::destroyInArena()
+{
+    QCborArena *arena = QCborArena::arenaOf(this);
+    this->~QCborContainerPrivate();
+    arena->deref();
+}
+
 QCborContainerPrivate::~QCborContainerPrivate()
 {
     // delete our elements
-    for (Element &e : elements) {
+    for (const Element &e : qAsConst(elements)) {
         if (e.flags & Element::IsContainer)
             e.container->deref();
     }
@@ -840,6 +986,14 @@ QCborContainerPrivate *QCborContainerPrivate::clone(QCborContainerPrivate *d, qs
         d = new QCborContainerPrivate;
     } else {
         d = new QCborContainerPrivate(*d);
+        if (d->inArena) {
+            d->inArena = false;
+            // the copy does not keep the arena alive, so it must not share its memory
+            if (!d->elements.isEmpty())
+                d->elements.detach();
+            if (!d->data.isEmpty())
+                d->data.detach();
+        }
         if (reserved >= 0) {
             d->elements.reserve(reserved);
             d->compact(reserved);
@@ -943,7 +1097,7 @@ QCborValue QCborContainerPrivate::extractAt_complex(Element e)
     auto b = byteData(e);
     auto container = new QCborContainerPrivate;
 
-    if (b->len + qsizetype(sizeof(*b)) < data.size() / 4) {
+    if (b->len + qsizetype(sizeof(*b)) < data.size() / 4 || inArena) {
         // make a shallow copy of the byte data
         container->appendByteData(b->byte(), b->len, e.type, e.flags);
         usedData -= b->len + qsizetype(sizeof(*b));
@@ -1638,6 +1792,77 @@ void QCborContainerPrivate::decodeFromCbor(QCborStreamReader &reader)
     if (reader.lastError() == QCborError::NoError)
         reader.leaveContainer();
 }
+
+namespace {
+// Decodes the containers of one document into a QCborArena. The elements and
+// byte data of each container are decoded into a scratch container for its
+// nesting level first and copied into the arena when the container is
+// complete, so the scratch buffers are reused by all containers of a level.
+struct QCborArenaDecoder
+{
+    QCborArena *arena;
+    QVarLengthArray<QCborContainerPrivate *, 16> scratch;
+
+    explicit QCborArenaDecoder(qsizetype sizeHint)
+        : arena(new QCborArena(sizeHint))
+    {}
+    ~QCborArenaDecoder()
+    {
+        for (QCborContainerPrivate *d : qAsConst(scratch))
+            d->deref();
+        arena->deref();
+    }
+
+    QCborContainerPrivate *decodeContainer(QCborStreamReader &reader, int level);
+};
+} // unnamed namespace
+
+// Same as QCborContainerPrivate::decodeFromCbor(), but for nested arrays and
+// maps. Tags, and the containers inside them, are still allocated separately.
+QCborContainerPrivate *QCborArenaDecoder::decodeContainer(QCborStreamReader &reader, int level)
+{
+    if (level == scratch.size()) {
+        auto d = new QCborContainerPrivate;
+        d->ref.storeRelaxed(1);
+        scratch.append(d);
+    }
+    QCborContainerPrivate *d = scratch.at(level);
+
+    int mapShift = reader.isMap() ? 1 : 0;
+    if (reader.isLengthKnown()) {
+        quint64 len = reader.length();
+        len = qMin(len, quint64(1024 * 1024 - 1));
+        d->elements.reserve(qsizetype(len) << mapShift);
+    }
+
+    reader.enterContainer();
+    if (reader.lastError() == QCborError::NoError) {
+        while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+            if (reader.isArray() || reader.isMap()) {
+                QCborValue::Type type = reader.isArray() ? QCborValue::Array : QCborValue::Map;
+                d->elements.append(Element(decodeContainer(reader, level + 1), type));
+            } else {
+                d->decodeValueFromCbor(reader);
+            }
+        }
+
+        if (reader.lastError() == QCborError::NoError)
+            reader.leaveContainer();
+    }
+
+    return arena->copyContainer(d);
+}
+
+static QCborValue arenaValueFromCbor(QCborStreamReader &reader, qsizetype sizeHint)
+{
+    if (reader.lastError() != QCborError::NoError || !(reader.isArray() || reader.isMap()))
+        return QCborValue::fromCbor(reader);
+
+    QCborValue::Type type = reader.isArray() ? QCborValue::Array : QCborValue::Map;
+    QCborArenaDecoder decoder(sizeHint);
+    return QCborContainerPrivate::makeValue(type, -1, decoder.decodeContainer(reader, 0),
+                                            QCborContainerPrivate::MoveContainer);
+}
 #endif // QT_CONFIG(cborstream)
 
 /*!
@@ -2443,6 +2668,45 @@ QCborValue QCborValue::fromCbor(const QByteArray &ba, QCborParserError *error)
     return result;
 }
 
+/*!
+    \since 6.0
+    \overload
+
+    Decodes one item from the CBOR stream found in \a reader, using the
+    options specified in \a opts, and returns the equivalent representation.
+
+    \sa DecodingOption
+ */
+QCborValue QCborValue::fromCbor(QCborStreamReader &reader, DecodingOptions opts)
+{
+    if (opts & UseArena)
+        return arenaValueFromCbor(reader, 0);
+    return fromCbor(reader);
+}
+
+/*!
+    \since 6.0
+    \overload
+
+    Decodes one item from the CBOR stream found in the byte array \a ba, using
+    the options specified in \a opts, and returns the equivalent
+    representation. The error state, if any, is stored in the object pointed
+    to by \a error, as described for fromCbor(const QByteArray &, QCborParserError *).
+
+    \sa DecodingOption
+ */
+QCborValue QCborValue::fromCbor(const QByteArray &ba, QCborParserError *error, DecodingOptions opts)
+{
+    QCborStreamReader reader(ba);
+    QCborValue result = (opts & UseArena) ? arenaValueFromCbor(reader, 2 * qsizetype(ba.size()))
+                                          : fromCbor(reader);
+    if (error) {
+        error->error = reader.lastError();
+        error->offset = reader.currentOffset();
+    }
+    return result;
+}
+
 /*!
     \fn QCborValue QCborValue::fromCbor(const char *data, qsizetype len, QCborParserError *error)
     \fn QCborValue QCborValue::fromCbor(const quint8 *data, qsizetype len, QCborParserError *error)
@@ -102,6 +102,12 @@ public:
     };
     Q_DECLARE_FLAGS(DiagnosticNotationOptions, DiagnosticNotationOption)
 
+    enum DecodingOption {
+        NoDecodingOption    = 0x00,
+        UseArena            = 0x01
+    };
+    Q_DECLARE_FLAGS(DecodingOptions, DecodingOption)
+
     // different from QCborStreamReader::Type because we have more types
     enum Type : int {
         Integer         = 0x00,
@@ -292,6 +298,8 @@ public:
     { return fromCbor(QByteArray(data, int(len)), error); }
     static QCborValue fromCbor(const quint8 *data, qsizetype len, QCborParserError *error = nullptr)
     { return fromCbor(QByteArray(reinterpret_cast<const char *>(data), int(len)), error); }
+    static QCborValue fromCbor(QCborStreamReader &reader, DecodingOptions opts);
+    static QCborValue fromCbor(const QByteArray &ba, QCborParserError *error, DecodingOptions opts);
     QByteArray toCbor(EncodingOptions opt = NoTransformation);
     void toCbor(QCborStreamWriter &writer, EncodingOptions opt = NoTransformation);
 #endif
@@ -128,11 +128,36 @@ class QCborContainerPrivate : public QSharedData
 public:
     enum ContainerDisposition { CopyContainer, MoveContainer };
 
+    // set for the containers decoded with QCborValue::UseArena, which live in
+    // a QCborArena and must be released with deref()
+    bool inArena = false;
     QByteArray::size_type usedData = 0;
     QByteArray data;
     QVector<QtCbor::Element> elements;
 
-    void deref() { if (!ref.deref()) delete this; }
+    void deref()
+    {
+        if (!ref.deref()) {
+            if (Q_LIKELY(!inArena))
+                delete this;
+            else
+                destroyInArena();
+        }
+    }
+    void destroyInArena();
+
+    // Makes d point to x. QCborArray and QCborMap use this instead of
+    // assigning to d or resetting it, so that the previous container is
+    // released with deref(): QExplicitlySharedDataPointer would delete it.
+    static void replace(QExplicitlySharedDataPointer<QCborContainerPrivate> &d,
+                        QCborContainerPrivate *x)
+    {
+        QCborContainerPrivate *old = d.take();
+        d = x;
+        if (old)
+            old->deref();
+    }
+
     void compact(qsizetype reserved);
     static QCborContainerPrivate *clone(QCborContainerPrivate *d, qsizetype reserved = -1);
     static QCborContainerPrivate *detach(QCborContainerPrivate *d, qsizetype reserved);
@@ -0,0 +1,899 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qgadgetserializer.h"
+
+#include <qjsonarray.h>
+#include <qjsonobject.h>
+#include <qjsonstream.h>
+#include <qjsonvalue.h>
+#include <qmetaobject.h>
+#include <qstringlist.h>
+#include <qvariant.h>
+#include <qvector.h>
+
+#include <private/qnumeric_p.h>
+
+#if QT_CONFIG(cborstream)
+#include <qcborstream.h>
+#include <qcborvalue.h>
+#endif
+
+#include <cstddef>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QGadgetSerializer
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.0
+
+    \brief The QGadgetSerializer class writes the properties of Q_GADGET
+    types to CBOR and JSON streams and reads them back.
+
+    Converting a gadget with QMetaProperty::readOnGadget() produces one
+    QVariant for each property, which then has to be converted to a
+    QJsonValue or QCborValue before it can be written. QGadgetSerializer
+    instead examines the properties of a gadget type once, when it is
+    constructed, and picks a specialized encoder and decoder for each of
+    them. It then reads and writes the properties through the code that moc
+    generated for the gadget, and appends the values directly to a
+    QCborStreamWriter or QJsonStreamWriter, without any intermediate
+    QVariant or document.
+
+    A gadget is written as a map (CBOR) or object (JSON) with one member
+    for each readable property, named like the property. The property
+    types are written as follows:
+
+    \table
+    \header \li Property type \li CBOR \li JSON
+    \row \li \c bool \li Boolean \li Boolean
+    \row \li Integer and enumeration types \li Integer \li Number
+    \row \li \c float, \c double \li Floating point \li Number
+    \row \li QString \li Text string \li String
+    \row \li QByteArray \li Byte string \li String, encoded in base64url
+    \row \li QStringList \li Array of text strings \li Array of strings
+    \row \li Q_GADGET types \li Map \li Object
+    \row \li Other types \li As QCborValue::fromVariant() \li As QJsonValue::fromVariant()
+    \endtable
+
+    Enumerations are encoded with the size and signedness of their
+    underlying type, which the meta-type system records when they are
+    registered with qRegisterMetaType(). Like QMetaProperty::read(), the
+    serializer handles enumerations that were not registered yet when it
+    was created as \c int.
+
+    Reading a map or object writes each writable property whose name
+    appears in it. Members without a matching property, and members whose
+    type does not match the property, are skipped. Properties that do not
+    appear keep their values.
+
+    Usually, the serializer for a type is obtained with forType(), which
+    creates it the first time it is needed. The toCbor(), fromCbor(),
+    toJson() and fromJson() functions use that serializer:
+
+    \snippet code/src_corelib_serialization_qgadgetserializer.cpp 0
+
+    \sa QJsonStreamWriter, QCborStreamWriter, QMetaProperty
+*/
+
+/*!
+    \fn template <typename T> const QGadgetSerializer &QGadgetSerializer::forType()
+
+    Returns the serializer for the Q_GADGET type \c T. It is created on the
+    first call and shared by all later calls.
+*/
+
+/*!
+    \fn template <typename T> void QGadgetSerializer::toJson(QJsonStreamWriter &writer, const T &gadget)
+
+    Writes the properties of \a gadget to \a writer as a JSON object.
+
+    \sa fromJson(), write()
+*/
+
+/*!
+    \fn template <typename T> bool QGadgetSerializer::fromJson(QJsonStreamReader &reader, T &gadget)
+
+    Reads the object that is the current token of \a reader into the
+    properties of \a gadget. Returns \c true on success.
+
+    \sa toJson(), read()
+*/
+
+/*!
+    \fn template <typename T> void QGadgetSerializer::toCbor(QCborStreamWriter &writer, const T &gadget)
+
+    Writes the properties of \a gadget to \a writer as a CBOR map.
+
+    \sa fromCbor(), write()
+*/
+
+/*!
+    \fn template <typename T> bool QGadgetSerializer::fromCbor(QCborStreamReader &reader, T &gadget)
+
+    Reads the map that \a reader is positioned on into the properties of
+    \a gadget. Returns \c true on success.
+
+    \sa toCbor(), read()
+*/
+
+namespace {
+
+// A gadget property, with the encoder chosen for its type
+struct Property
+{
+    enum Kind : quint8 {
+        Bool,
+        Int8, Int16, Int32, Int64,
+        UInt8, UInt16, UInt32, UInt64,
+        Float, Double,
+        String, ByteArray, StringList,
+        Gadget,
+        Variant             // anything else goes through QVariant
+    };
+
+    typedef void (*StaticMetacall)(QObject *, QMetaObject::Call, int, void **);
+
+    QLatin1String name;
+    StaticMetacall metacall;
+    int index;              // relative to the class that declares the property
+    int typeId;
+    Kind kind;
+    bool readable;
+    bool writable;
+    const QGadgetSerializerPrivate *gadget;     // for Kind Gadget
+    QMetaProperty property;             // for Kind Variant
+
+    // Reads the property into \a value, which must be of the property's type
+    void read(const void *object, void *value) const
+    {
+        int status = -1;
+        void *argv[] = { value, nullptr, &status };
+        metacall(reinterpret_cast<QObject *>(const_cast<void *>(object)),
+                 QMetaObject::ReadProperty, index, argv);
+    }
+
+    void write(void *object, const void *value) const
+    {
+        int status = -1;
+        int flags = 0;
+        void *argv[] = { const_cast<void *>(value), nullptr, &status, &flags };
+        metacall(reinterpret_cast<QObject *>(object), QMetaObject::WriteProperty, index, argv);
+    }
+
+    qint64 readInteger(const void *object) const
+    {
+        switch (kind) {
+        case Int8: { qint8 v = 0; read(object, &v); return v; }
+        case Int16: { qint16 v = 0; read(object, &v); return v; }
+        case Int32: { qint32 v = 0; read(object, &v); return v; }
+        case UInt8: { quint8 v = 0; read(object, &v); return v; }
+        case UInt16: { quint16 v = 0; read(object, &v); return v; }
+        case UInt32: { quint32 v = 0; read(object, &v); return v; }
+        default: break;
+        }
+        qint64 v = 0;
+        read(object, &v);
+        return v;
+    }
+
+    void writeInteger(void *object, qint64 value) const
+    {
+        switch (kind) {
+        case Int8: { qint8 v = qint8(value); return write(object, &v); }
+        case Int16: { qint16 v = qint16(value); return write(object, &v); }
+        case Int32: { qint32 v = qint32(value); return write(object, &v); }
+        case UInt8: { quint8 v = quint8(value); return write(object, &v); }
+        case UInt16: { quint16 v = quint16(value); return write(object, &v); }
+        case UInt32: { quint32 v = quint32(value); return write(object, &v); }
+        default: break;
+        }
+        write(object, &value);
+    }
+};
+
+// A default-constructed value of a gadget type, kept on the stack if it is
+// small enough
+class GadgetValue
+{
+    Q_DISABLE_COPY(GadgetValue)
+    alignas(std::max_align_t) char buffer[128];
+    void *ptr;
+    int typeId;
+
+public:
+    explicit GadgetValue(int typeId)
+        : typeId(typeId)
+    {
+        if (size_t(QMetaType::sizeOf(typeId)) <= sizeof(buffer))
+            ptr = QMetaType::construct(typeId, buffer, nullptr);
+        else
+            ptr = QMetaType::create(typeId);
+    }
+    ~GadgetValue()
+    {
+        if (ptr == buffer)
+            QMetaType::destruct(typeId, ptr);
+        else
+            QMetaType::destroy(typeId, ptr);
+    }
+    void *data() const { return ptr; }
+};
+
+} // unnamed namespace
+
+static Property::Kind integerKind(int size, bool isSigned)
+{
+    switch (size) {
+    case 1:
+        return isSigned ? Property::Int8 : Property::UInt8;
+    case 2:
+        return isSigned ? Property::Int16 : Property::UInt16;
+    case 8:
+        return isSigned ? Property::Int64 : Property::UInt64;
+    }
+    return isSigned ? Property::Int32 : Property::UInt32;
+}
+
+static Property::Kind propertyKind(const QMetaProperty &property, int typeId)
+{
+    if (property.isEnumType()) {
+        // the size of enumerations that are not registered with the meta-type
+        // system is unknown, so they go through QVariant like
+        // QMetaProperty::read(), whose storage is large enough for any of them
+        const QMetaType::TypeFlags flags = QMetaType::typeFlags(typeId);
+        if (!(flags & QMetaType::IsEnumeration))
+            return Property::Variant;
+        return integerKind(QMetaType::sizeOf(typeId), !(flags & QMetaType::IsUnsignedEnumeration));
+    }
+
+    switch (typeId) {
+    case QMetaType::Bool:
+        return Property::Bool;
+    case QMetaType::Char:
+    case QMetaType::SChar:
+        return Property::Int8;
+    case QMetaType::UChar:
+        return Property::UInt8;
+    case QMetaType::Short:
+        return Property::Int16;
+    case QMetaType::UShort:
+        return Property::UInt16;
+    case QMetaType::Int:
+        return Property::Int32;
+    case QMetaType::UInt:
+        return Property::UInt32;
+    case QMetaType::Long:
+        return integerKind(sizeof(long), true);
+    case QMetaType::ULong:
+        return integerKind(sizeof(ulong), false);
+    case QMetaType::LongLong:
+        return Property::Int64;
+    case QMetaType::ULongLong:
+        return Property::UInt64;
+    case QMetaType::Float:
+        return Property::Float;
+    case QMetaType::Double:
+        return Property::Double;
+    case QMetaType::QString:
+        return Property::String;
+    case QMetaType::QByteArray:
+        return Property::ByteArray;
+    case QMetaType::QStringList:
+        return Property::StringList;
+    }
+
+    if ((QMetaType::typeFlags(typeId) & QMetaType::IsGadget) && QMetaType::metaObjectForType(typeId))
+        return Property::Gadget;
+    return Property::Variant;
+}
+
+// Adaptors for the differences between the CBOR and JSON writers
+static void startMap(QJsonStreamWriter &writer, qsizetype) { writer.startObject(); }
+static void endMap(QJsonStreamWriter &writer) { writer.endObject(); }
+static void startArray(QJsonStreamWriter &writer, qsizetype) { writer.startArray(); }
+static void endArray(QJsonStreamWriter &writer) { writer.endArray(); }
+
+static void appendBytes(QJsonStreamWriter &writer, const QByteArray &ba)
+{
+    const QByteArray encoded = ba.toBase64(QByteArray::Base64UrlEncoding
+                                           | QByteArray::OmitTrailingEquals);
+    writer.append(QLatin1String(encoded));
+}
+
+static void appendVariant(QJsonStreamWriter &writer, const QVariant &variant)
+{
+    writer.append(QJsonValue::fromVariant(variant));
+}
+
+#if QT_CONFIG(cborstream)
+static void startMap(QCborStreamWriter &writer, qsizetype count) { writer.startMap(count); }
+static void endMap(QCborStreamWriter &writer) { writer.endMap(); }
+static void startArray(QCborStreamWriter &writer, qsizetype count) { writer.startArray(count); }
+static void endArray(QCborStreamWriter &writer) { writer.endArray(); }
+static void appendBytes(QCborStreamWriter &writer, const QByteArray &ba) { writer.append(ba); }
+
+static void appendVariant(QCborStreamWriter &writer, const QVariant &variant)
+{
+    QCborValue::fromVariant(variant).toCbor(writer);
+}
+#endif
+
+class QGadgetSerializerPrivate
+{
+public:
+    ~QGadgetSerializerPrivate() { qDeleteAll(nested); }
+
+    template <typename Writer> void write(Writer &writer, const void *gadget) const;
+    bool read(QJsonStreamReader &reader, void *gadget) const;
+    bool readValue(QJsonStreamReader &reader, const Property &p, void *gadget) const;
+#if QT_CONFIG(cborstream)
+    bool read(QCborStreamReader &reader, void *gadget) const;
+    bool readValue(QCborStreamReader &reader, const Property &p, void *gadget) const;
+#endif
+
+    const QMetaObject *metaObject;
+    QVector<Property> properties;
+    QVector<QGadgetSerializer *> nested;
+    qsizetype readableCount = 0;
+};
+
+// Returns the property called \a name. The members of a map are usually in
+// the order of the properties, so the search starts after the previous match.
+template <typename String>
+static const Property *findProperty(const QVector<Property> &properties, String name, int &hint)
+{
+    const int count = properties.size();
+    for (int i = 0; i < count; ++i) {
+        const int index = (hint + i) % count;
+        if (properties.at(index).name == name) {
+            hint = index + 1;
+            return &properties.at(index);
+        }
+    }
+    return nullptr;
+}
+
+template <typename Writer>
+void QGadgetSerializerPrivate::write(Writer &writer, const void *gadget) const
+{
+    startMap(writer, readableCount);
+    for (const Property &p : properties) {
+        if (!p.readable)
+            continue;
+        writer.append(p.name);
+        switch (p.kind) {
+        case Property::Bool: {
+            bool b = false;
+            p.read(gadget, &b);
+            writer.append(b);
+            break;
+        }
+        case Property::Int8:
+        case Property::Int16:
+        case Property::Int32:
+        case Property::Int64:
+            writer.append(p.readInteger(gadget));
+            break;
+        case Property::UInt8:
+        case Property::UInt16:
+        case Property::UInt32:
+        case Property::UInt64:
+            writer.append(quint64(p.readInteger(gadget)));
+            break;
+        case Property::Float: {
+            float f = 0;
+            p.read(gadget, &f);
+            writer.append(f);
+            break;
+        }
+        case Property::Double: {
+            double d = 0;
+            p.read(gadget, &d);
+            writer.append(d);
+            break;
+        }
+        case Property::String: {
+            QString s;
+            p.read(gadget, &s);
+            writer.append(QStringView(s));
+            break;
+        }
+        case Property::ByteArray: {
+            QByteArray ba;
+            p.read(gadget, &ba);
+            appendBytes(writer, ba);
+            break;
+        }
+        case Property::StringList: {
+            QStringList list;
+            p.read(gadget, &list);
+            startArray(writer, list.size());
+            for (const QString &s : qAsConst(list))
+                writer.append(QStringView(s));
+            endArray(writer);
+            break;
+        }
+        case Property::Gadget: {
+            GadgetValue value(p.typeId);
+            p.read(gadget, value.data());
+            p.gadget->write(writer, value.data());
+            break;
+        }
+        case Property::Variant:
+            appendVariant(writer, p.property.readOnGadget(gadget));
+            break;
+        }
+    }
+    endMap(writer);
+}
+
+static QJsonValue readJsonValue(QJsonStreamReader &reader)
+{
+    if (reader.isStartArray()) {
+        QJsonArray array;
+        while (reader.readNext() != QJsonStreamReader::EndArray && !reader.hasError())
+            array.append(readJsonValue(reader));
+        return array;
+    }
+    if (reader.isStartObject()) {
+        QJsonObject object;
+        while (reader.readNext() != QJsonStreamReader::EndObject && !reader.hasError()) {
+            const QString name = reader.name().toString();
+            object.insert(name, readJsonValue(reader));
+        }
+        return object;
+    }
+    return reader.value();
+}
+
+// Returns the number that is the current token of \a reader as an integer,
+// keeping all digits if it is one. Unsigned properties also accept the numbers
+// between 2^63 and 2^64, which are returned with the same bits.
+static qint64 integerFromJson(const QJsonStreamReader &reader, bool isUnsigned)
+{
+    // out of range numbers saturate
+    const double d = reader.toDouble();
+    if (isUnsigned && d > 0) {
+        quint64 u;
+        convertDoubleTo(d, &u);
+        return qint64(reader.toUnsignedInteger(u));
+    }
+    qint64 i;
+    convertDoubleTo(d, &i);
+    return reader.toInteger(i);
+}
+
+bool QGadgetSerializerPrivate::read(QJsonStreamReader &reader, void *gadget) const
+{
+    if (!reader.isStartObject())
+        return false;
+
+    int hint = 0;
+    while (reader.readNext() != QJsonStreamReader::EndObject) {
+        if (reader.hasError() || reader.tokenType() == QJsonStreamReader::EndDocument)
+            return false;
+
+        const Property *p = findProperty(properties, reader.name(), hint);
+        if (p && p->writable ? !readValue(reader, *p, gadget) : !reader.skipCurrentValue())
+            return false;
+    }
+    return true;
+}
+
+bool QGadgetSerializerPrivate::readValue(QJsonStreamReader &reader, const Property &p,
+                                         void *gadget) const
+{
+    switch (p.kind) {
+    case Property::Bool:
+        if (reader.isBool()) {
+            const bool b = reader.toBool();
+            p.write(gadget, &b);
+            return true;
+        }
+        break;
+    case Property::Int8:
+    case Property::Int16:
+    case Property::Int32:
+    case Property::Int64:
+    case Property::UInt8:
+    case Property::UInt16:
+    case Property::UInt32:
+    case Property::UInt64:
+        if (reader.isNumber()) {
+            p.writeInteger(gadget, integerFromJson(reader, p.kind >= Property::UInt8));
+            return true;
+        }
+        break;
+    case Property::Float:
+        if (reader.isNumber()) {
+            const float f = float(reader.toDouble());
+            p.write(gadget, &f);
+            return true;
+        }
+        break;
+    case Property::Double:
+        if (reader.isNumber()) {
+            const double d = reader.toDouble();
+            p.write(gadget, &d);
+            return true;
+        }
+        break;
+    case Property::String:
+        if (reader.isString()) {
+            const QString s = reader.text().toString();
+            p.write(gadget, &s);
+            return true;
+        }
+        break;
+    case Property::ByteArray:
+        if (reader.isString()) {
+            const QByteArray ba = QByteArray::fromBase64(reader.text().toLatin1(),
+                                                         QByteArray::Base64UrlEncoding);
+            p.write(gadget, &ba);
+            return true;
+        }
+        break;
+    case Property::StringList:
+        if (reader.isStartArray()) {
+            QStringList list;
+            while (reader.readNext() != QJsonStreamReader::EndArray) {
+                if (reader.isString())
+                    list.append(reader.text().toString());
+                else if (reader.hasError() || !reader.skipCurrentValue())
+                    return false;
+            }
+            p.write(gadget, &list);
+            return true;
+        }
+        break;
+    case Property::Gadget:
+        if (reader.isStartObject()) {
+            GadgetValue value(p.typeId);
+            p.read(gadget, value.data());
+            if (!p.gadget->read(reader, value.data()))
+                return false;
+            p.write(gadget, value.data());
+            return true;
+        }
+        break;
+    case Property::Variant: {
+        QVariant variant = readJsonValue(reader).toVariant();
+        if (reader.hasError())
+            return false;
+        if (variant.convert(p.typeId))
+            p.property.writeOnGadget(gadget, variant);
+        return true;
+    }
+    }
+
+    // the value does not match the property's type
+    return reader.skipCurrentValue();
+}
+
+#if QT_CONFIG(cborstream)
+// Reads a string into \a result, which is not modified if an error occurs
+static bool readCborString(QCborStreamReader &reader, QString *result)
+{
+    QString s;
+    auto r = reader.readString();
+    while (r.status == QCborStreamReader::Ok) {
+        s += r.data;
+        r = reader.readString();
+    }
+    if (r.status == QCborStreamReader::Error)
+        return false;
+    *result = s;
+    return true;
+}
+
+static bool readCborByteArray(QCborStreamReader &reader, QByteArray *result)
+{
+    QByteArray ba;
+    auto r = reader.readByteArray();
+    while (r.status == QCborStreamReader::Ok) {
+        ba += r.data;
+        r = reader.readByteArray();
+    }
+    if (r.status == QCborStreamReader::Error)
+        return false;
+    *result = ba;
+    return true;
+}
+
+// Reads a map key into \a buffer without allocating memory. Returns the
+// length of the key, or -1 if it is not a string or does not fit.
+static qsizetype readCborKey(QCborStreamReader &reader, char *buffer, qsizetype size)
+{
+    if (!reader.isString()) {
+        reader.next();
+        return -1;
+    }
+
+    qsizetype len = 0;
+    for (;;) {
+        const qsizetype offset = qMin(len, size);
+        len += qMax(reader.currentStringChunkSize(), qsizetype(0));
+        auto r = reader.readStringChunk(buffer + offset, size - offset);
+        if (r.status == QCborStreamReader::EndOfString)
+            return len <= size ? len : -1;
+        if (r.status == QCborStreamReader::Error)
+            return -1;
+    }
+}
+
+bool QGadgetSerializerPrivate::read(QCborStreamReader &reader, void *gadget) const
+{
+    if (!reader.isMap() || !reader.enterContainer())
+        return false;
+
+    int hint = 0;
+    char key[256];
+    while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+        const qsizetype len = readCborKey(reader, key, sizeof(key));
+        if (reader.lastError() != QCborError::NoError)
+            return false;
+
+        const Property *p = len < 0 ? nullptr : findProperty(properties, QLatin1String(key, len), hint);
+        if (p && p->writable ? !readValue(reader, *p, gadget) : !reader.next())
+            return false;
+    }
+    return reader.lastError() == QCborError::NoError && reader.leaveContainer();
+}
+
+bool QGadgetSerializerPrivate::readValue(QCborStreamReader &reader, const Property &p,
+                                         void *gadget) const
+{
+    switch (p.kind) {
+    case Property::Bool:
+        if (reader.isBool()) {
+            const bool b = reader.toBool();
+            p.write(gadget, &b);
+            return reader.next();
+        }
+        break;
+    case Property::Int8:
+    case Property::Int16:
+    case Property::Int32:
+    case Property::Int64:
+    case Property::UInt8:
+    case Property::UInt16:
+    case Property::UInt32:
+    case Property::UInt64:
+        if (reader.isUnsignedInteger()) {
+            p.writeInteger(gadget, qint64(reader.toUnsignedInteger()));
+            return reader.next();
+        }
+        if (reader.isNegativeInteger()) {
+            p.writeInteger(gadget, reader.toInteger());
+            return reader.next();
+        }
+        break;
+    case Property::Float:
+    case Property::Double: {
+        double d;
+        if (reader.isDouble())
+            d = reader.toDouble();
+        else if (reader.isFloat())
+            d = reader.toFloat();
+        else if (reader.isFloat16())
+            d = reader.toFloat16();
+        else if (reader.isInteger())
+            d = double(qint64(reader.toInteger()));
+        else
+            break;
+        if (p.kind == Property::Float) {
+            const float f = float(d);
+            p.write(gadget, &f);
+        } else {
+            p.write(gadget, &d);
+        }
+        return reader.next();
+    }
+    case Property::String:
+        if (reader.isString()) {
+            QString s;
+            if (!readCborString(reader, &s))
+                return false;
+            p.write(gadget, &s);
+            return true;
+        }
+        break;
+    case Property::ByteArray:
+        if (reader.isByteArray()) {
+            QByteArray ba;
+            if (!readCborByteArray(reader, &ba))
+                return false;
+            p.write(gadget, &ba);
+            return true;
+        }
+        break;
+    case Property::StringList:
+        if (reader.isArray() && reader.enterContainer()) {
+            QStringList list;
+            while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+                QString s;
+                if (!reader.isString())
+                    reader.next();
+                else if (readCborString(reader, &s))
+                    list.append(s);
+            }
+            if (reader.lastError() != QCborError::NoError || !reader.leaveContainer())
+                return false;
+            p.write(gadget, &list);
+            return true;
+        }
+        break;
+    case Property::Gadget:
+        if (reader.isMap()) {
+            GadgetValue value(p.typeId);
+            p.read(gadget, value.data());
+            if (!p.gadget->read(reader, value.data()))
+                return false;
+            p.write(gadget, value.data());
+            return true;
+        }
+        break;
+    case Property::Variant: {
+        QVariant variant = QCborValue::fromCbor(reader).toVariant();
+        if (reader.lastError() != QCborError::NoError)
+            return false;
+        if (variant.convert(p.typeId))
+            p.property.writeOnGadget(gadget, variant);
+        return true;
+    }
+    }
+
+    // the value does not match the property's type
+    return reader.next();
+}
+#endif // QT_CONFIG(cborstream)
+
+/*!
+    Constructs a serializer for the gadget type described by \a metaObject,
+    which must be the \c staticMetaObject of a Q_GADGET type.
+
+    Properties whose type is not registered with QMetaType are ignored.
+
+    \sa forType()
+*/
+QGadgetSerializer::QGadgetSerializer(const QMetaObject *metaObject)
+    : d(new QGadgetSerializerPrivate)
+{
+    d->metaObject = metaObject;
+    const int count = metaObject->propertyCount();
+    d->properties.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QMetaProperty property = metaObject->property(i);
+        const QMetaObject *enclosing = property.enclosingMetaObject();
+        const int typeId = property.userType();
+        if (!enclosing->d.static_metacall || typeId == QMetaType::UnknownType)
+            continue;
+
+        Property p;
+        p.name = QLatin1String(property.name());
+        p.metacall = enclosing->d.static_metacall;
+        p.index = property.relativePropertyIndex();
+        p.typeId = typeId;
+        p.kind = propertyKind(property, typeId);
+        p.readable = property.isReadable();
+        p.writable = property.isWritable();
+        p.gadget = nullptr;
+        p.property = property;
+        if (p.kind == Property::Gadget) {
+            auto nested = new QGadgetSerializer(QMetaType::metaObjectForType(typeId));
+            d->nested.append(nested);
+            p.gadget = nested->d.data();
+        }
+        if (p.readable)
+            ++d->readableCount;
+        d->properties.append(p);
+    }
+}
+
+/*!
+    Destroys the serializer.
+*/
+QGadgetSerializer::~QGadgetSerializer()
+{
+}
+
+/*!
+    Returns the meta-object of the gadget type that this serializer handles.
+*/
+const QMetaObject *QGadgetSerializer::metaObject() const
+{
+    return d->metaObject;
+}
+
+/*!
+    Writes the properties of \a gadget to \a writer as a JSON object.
+    \a gadget must point to an object of the type that this serializer was
+    created for.
+*/
+void QGadgetSerializer::write(QJsonStreamWriter &writer, const void *gadget) const
+{
+    d->write(writer, gadget);
+}
+
+/*!
+    Reads the JSON object that is the current token of \a reader into the
+    properties of \a gadget, which must point to an object of the type that
+    this serializer was created for. After this function returns, the
+    current token is the end of the object.
+
+    Returns \c true on success, and \c false if the current token is not the
+    start of an object or an error occurred. In that case, some of the
+    properties may already have been written.
+*/
+bool QGadgetSerializer::read(QJsonStreamReader &reader, void *gadget) const
+{
+    return d->read(reader, gadget);
+}
+
+#if QT_CONFIG(cborstream)
+/*!
+    \overload
+
+    Writes the properties of \a gadget to \a writer as a CBOR map.
+*/
+void QGadgetSerializer::write(QCborStreamWriter &writer, const void *gadget) const
+{
+    d->write(writer, gadget);
+}
+
+/*!
+    \overload
+
+    Reads the CBOR map that \a reader is positioned on into the properties of
+    \a gadget, and advances \a reader past the map.
+
+    Returns \c true on success, and \c false if \a reader is not positioned
+    on a map or an error occurred.
+*/
+bool QGadgetSerializer::read(QCborStreamReader &reader, void *gadget) const
+{
+    return d->read(reader, gadget);
+}
+#endif
+
+QT_END_NAMESPACE
@@ -0,0 +1,95 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QGADGETSERIALIZER_H
+#define QGADGETSERIALIZER_H
+
+#include <QtCore/qmetatype.h>
+#include <QtCore/qscopedpointer.h>
+
+QT_BEGIN_NAMESPACE
+
+class QCborStreamReader;
+class QCborStreamWriter;
+class QJsonStreamReader;
+class QJsonStreamWriter;
+
+class QGadgetSerializerPrivate;
+class Q_CORE_EXPORT QGadgetSerializer
+{
+public:
+    explicit QGadgetSerializer(const QMetaObject *metaObject);
+    ~QGadgetSerializer();
+    Q_DISABLE_COPY(QGadgetSerializer)
+
+    const QMetaObject *metaObject() const;
+
+    void write(QJsonStreamWriter &writer, const void *gadget) const;
+    bool read(QJsonStreamReader &reader, void *gadget) const;
+#if QT_CONFIG(cborstream)
+    void write(QCborStreamWriter &writer, const void *gadget) const;
+    bool read(QCborStreamReader &reader, void *gadget) const;
+#endif
+
+    template <typename T> static const QGadgetSerializer &forType()
+    {
+        static_assert(QtPrivate::IsGadgetHelper<T>::IsGadgetOrDerivedFrom,
+                      "QGadgetSerializer can only be used with Q_GADGET types");
+        static const QGadgetSerializer serializer(&T::staticMetaObject);
+        return serializer;
+    }
+
+    template <typename T> static void toJson(QJsonStreamWriter &writer, const T &gadget)
+    { forType<T>().write(writer, &gadget); }
+    template <typename T> static bool fromJson(QJsonStreamReader &reader, T &gadget)
+    { return forType<T>().read(reader, &gadget); }
+#if QT_CONFIG(cborstream)
+    template <typename T> static void toCbor(QCborStreamWriter &writer, const T &gadget)
+    { forType<T>().write(writer, &gadget); }
+    template <typename T> static bool fromCbor(QCborStreamReader &reader, T &gadget)
+    { return forType<T>().read(reader, &gadget); }
+#endif
+
+private:
+    QScopedPointer<QGadgetSerializerPrivate> d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QGADGETSERIALIZER_H
@@ -58,6 +58,9 @@
 #include <qjsonarray.h>
 #include <qatomic.h>
 #include <qstring.h>
+#include <qvector.h>
+#include <qflathash.h>
+#include <qscopedpointer.h>
 #include <qendian.h>
 #include <qnumeric.h>
 
@@ -703,6 +706,52 @@ inline Base *Value::base(const Base *b) const
     return reinterpret_cast<Base *>(data(b));
 }
 
+// The text of a document created with QJsonDocument::fromJsonLazily().
+// Creating it checks the structure of the text and records where the
+// top-level values are. The values are parsed on first access and kept;
+// anything that needs the whole document parses all of it once.
+class LazyJson
+{
+public:
+    LazyJson(const QByteArray &json, int offset);
+    ~LazyJson();
+
+    QJsonParseError buildIndex();
+
+    bool isObject() const { return json.at(offset) == '{'; }
+    bool isParsed() const { return parsed.loadAcquire() != nullptr; }
+    Data *data();
+
+    QJsonValue value(QStringView key);
+    QJsonValue value(QLatin1String key);
+    QJsonValue value(int i);
+
+private:
+    struct Member {
+        int keyBegin;       // of the quotes around the key
+        int keyEnd;
+        int valueBegin;
+        int valueEnd;       // trailing whitespace is included for scalars
+        bool plainKey;      // only ASCII characters and no escape sequences
+        bool plainValue;
+    };
+
+    template <typename String> QJsonValue lookup(String key);
+    QJsonValue memberValue(int i);
+    QJsonValue parseValue(const Member &member) const;
+
+    QByteArray json;
+    int offset;                     // of the opening bracket
+    QAtomicPointer<Data> parsed;
+
+    // written by buildIndex() only
+    QVector<Member> members;
+    QFlatHash<QString, int> keys;   // to the last member with each key
+    QScopedArrayPointer<QAtomicPointer<QJsonValue>> values;
+
+    Q_DISABLE_COPY_MOVE(LazyJson)
+};
+
 class Data {
 public:
     enum Validation {
@@ -719,13 +768,18 @@ public:
     };
     uint compactionCounter : 31;
     uint ownsData : 1;
+    LazyJson *lazy;
 
     inline Data(char *raw, int a)
-        : alloc(a), rawData(raw), compactionCounter(0), ownsData(true)
+        : alloc(a), rawData(raw), compactionCounter(0), ownsData(true), lazy(nullptr)
+    {
+    }
+    inline explicit Data(LazyJson *l)
+        : alloc(0), rawData(nullptr), compactionCounter(0), ownsData(false), lazy(l)
     {
     }
     inline Data(int reserved, QJsonValue::Type valueType)
-        : rawData(nullptr), compactionCounter(0), ownsData(true)
+        : rawData(nullptr), compactionCounter(0), ownsData(true), lazy(nullptr)
     {
         Q_ASSERT(valueType == QJsonValue::Array || valueType == QJsonValue::Object);
 
@@ -741,7 +795,7 @@ public:
         b->length = 0;
     }
     inline ~Data()
-    { if (ownsData) free(rawData); }
+    { if (ownsData) free(rawData); delete lazy; }
 
     uint offsetOf(const void *ptr) const { return (uint)(((char *)ptr - rawData)); }
 
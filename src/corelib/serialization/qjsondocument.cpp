@@ -51,6 +51,13 @@
 
 QT_BEGIN_NAMESPACE
 
+// Returns the binary data of the document \a d, parsing the text first if
+// the document was created with fromJsonLazily().
+static inline QJsonPrivate::Data *resolved(QJsonPrivate::Data *d)
+{
+    return (d && d->lazy) ? d->lazy->data() : d;
+}
+
 /*! \class QJsonDocument
     \inmodule QtCore
     \ingroup json
@@ -77,6 +84,9 @@ QT_BEGIN_NAMESPACE
     A document can also be created from a stored binary representation using fromBinaryData() or
     fromRawData().
 
+    When only a few values of a large document are needed, fromJsonLazily()
+    creates a document that parses the parts of the text that are accessed.
+
     \sa {JSON Support in Qt}, {JSON Save Game Example}
 */
 
@@ -234,6 +244,7 @@ QJsonDocument QJsonDocument::fromRawData(const char *data, int size, DataValidat
  */
 const char *QJsonDocument::rawData(int *size) const
 {
+    QJsonPrivate::Data *d = resolved(this->d);
     if (!d) {
         *size = 0;
         return nullptr;
@@ -322,6 +333,7 @@ QJsonDocument QJsonDocument::fromVariant(const QVariant &variant)
  */
 QVariant QJsonDocument::toVariant() const
 {
+    QJsonPrivate::Data *d = resolved(this->d);
     if (!d)
         return QVariant();
 
@@ -367,6 +379,7 @@ QByteArray QJsonDocument::toJson() const
 QByteArray QJsonDocument::toJson(JsonFormat format) const
 {
     QByteArray json;
+    QJsonPrivate::Data *d = resolved(this->d);
     if (!d)
         return json;
 
@@ -395,6 +408,67 @@ QJsonDocument QJsonDocument::fromJson(const QByteArray &json, QJsonParseError *e
     return parser.parse(error);
 }
 
+/*!
+    \since 6.0
+
+    Creates a QJsonDocument from the UTF-8 encoded JSON document \a json
+    without parsing it.
+
+    The document keeps a shallow copy of \a json. This function scans the
+    text once, to check its structure and to find the top-level values.
+    Looking up a value with operator[]() only parses that value, the first
+    time it is looked up. This makes it cheap to read a few keys from a
+    large document. The document does not copy the text, so \a json can
+    be created with QByteArray::fromRawData() from a memory-mapped file:
+
+    \snippet code/src_corelib_serialization_qjsondocument.cpp 2
+
+    The mapping then has to stay valid as long as the document, or a copy
+    of it, exists.
+
+    Functions that need the whole document, such as object(), array(),
+    toJson() and operator==(), parse all of the text the first time they
+    are called. The returned QJsonObject and QJsonArray can be modified
+    like any other; the changes do not affect this document until they
+    are set with setObject() or setArray().
+
+    If \a json is not a valid JSON object or array, this function returns
+    a null document and sets \a error, like fromJson() does. The scan
+    checks every number and literal, and the strings that contain escape
+    sequences or non-ASCII characters, so looking up a value later cannot
+    fail. The offset and the kind of error reported may differ from those
+    reported by fromJson() for the same text.
+
+    \sa fromJson(), operator[]()
+ */
+QJsonDocument QJsonDocument::fromJsonLazily(const QByteArray &json, QJsonParseError *error)
+{
+    // skip the byte order mark and whitespace, like the parser does
+    int offset = json.startsWith("\xef\xbb\xbf") ? 3 : 0;
+    while (offset < json.size() && (json.at(offset) == ' ' || json.at(offset) == '\t'
+                                    || json.at(offset) == '\n' || json.at(offset) == '\r')) {
+        ++offset;
+    }
+
+    if (offset == json.size() || (json.at(offset) != '{' && json.at(offset) != '[')) {
+        if (error) {
+            error->offset = offset == json.size() ? offset : offset + 1;
+            error->error = QJsonParseError::IllegalValue;
+        }
+        return QJsonDocument();
+    }
+
+    QJsonPrivate::LazyJson *lazy = new QJsonPrivate::LazyJson(json, offset);
+    const QJsonParseError result = lazy->buildIndex();
+    if (error)
+        *error = result;
+    if (result.error != QJsonParseError::NoError) {
+        delete lazy;
+        return QJsonDocument();
+    }
+    return QJsonDocument(new QJsonPrivate::Data(lazy));
+}
+
 /*!
     Returns \c true if the document doesn't contain any data.
  */
@@ -420,6 +494,7 @@ bool QJsonDocument::isEmpty() const
  */
 QByteArray QJsonDocument::toBinaryData() const
 {
+    QJsonPrivate::Data *d = resolved(this->d);
     if (!d || !d->rawData)
         return QByteArray();
 
@@ -435,6 +510,8 @@ bool QJsonDocument::isArray() const
 {
     if (!d)
         return false;
+    if (d->lazy)
+        return !d->lazy->isObject();
 
     QJsonPrivate::Header *h = (QJsonPrivate::Header *)d->rawData;
     return h->root()->isArray();
@@ -449,6 +526,8 @@ bool QJsonDocument::isObject() const
 {
     if (!d)
         return false;
+    if (d->lazy)
+        return d->lazy->isObject();
 
     QJsonPrivate::Header *h = (QJsonPrivate::Header *)d->rawData;
     return h->root()->isObject();
@@ -464,7 +543,7 @@ bool QJsonDocument::isObject() const
  */
 QJsonObject QJsonDocument::object() const
 {
-    if (d) {
+    if (QJsonPrivate::Data *d = resolved(this->d)) {
         QJsonPrivate::Base *b = d->header->root();
         if (b->isObject())
             return QJsonObject(d, static_cast<QJsonPrivate::Object *>(b));
@@ -482,7 +561,7 @@ QJsonObject QJsonDocument::object() const
  */
 QJsonArray QJsonDocument::array() const
 {
-    if (d) {
+    if (QJsonPrivate::Data *d = resolved(this->d)) {
         QJsonPrivate::Base *b = d->header->root();
         if (b->isArray())
             return QJsonArray(d, static_cast<QJsonPrivate::Array *>(b));
@@ -571,6 +650,8 @@ const QJsonValue QJsonDocument::operator[](QStringView key) const
 {
     if (!isObject())
         return QJsonValue(QJsonValue::Undefined);
+    if (d->lazy && !d->lazy->isParsed())
+        return d->lazy->value(key);
 
     return object().value(key);
 }
@@ -583,6 +664,8 @@ const QJsonValue QJsonDocument::operator[](QLatin1String key) const
 {
     if (!isObject())
         return QJsonValue(QJsonValue::Undefined);
+    if (d->lazy && !d->lazy->isParsed())
+        return d->lazy->value(key);
 
     return object().value(key);
 }
@@ -603,6 +686,8 @@ const QJsonValue QJsonDocument::operator[](int i) const
 {
     if (!isArray())
         return QJsonValue(QJsonValue::Undefined);
+    if (d->lazy && !d->lazy->isParsed())
+        return d->lazy->value(i);
 
     return array().at(i);
 }
@@ -618,15 +703,18 @@ bool QJsonDocument::operator==(const QJsonDocument &other) const
     if (!d || !other.d)
         return false;
 
-    if (d->header->root()->isArray() != other.d->header->root()->isArray())
+    QJsonPrivate::Data *d = resolved(this->d);
+    QJsonPrivate::Data *otherData = resolved(other.d);
+
+    if (d->header->root()->isArray() != otherData->header->root()->isArray())
         return false;
 
     if (d->header->root()->isObject())
         return QJsonObject(d, static_cast<QJsonPrivate::Object *>(d->header->root()))
-                == QJsonObject(other.d, static_cast<QJsonPrivate::Object *>(other.d->header->root()));
+                == QJsonObject(otherData, static_cast<QJsonPrivate::Object *>(otherData->header->root()));
     else
         return QJsonArray(d, static_cast<QJsonPrivate::Array *>(d->header->root()))
-                == QJsonArray(other.d, static_cast<QJsonPrivate::Array *>(other.d->header->root()));
+                == QJsonArray(otherData, static_cast<QJsonPrivate::Array *>(otherData->header->root()));
 }
 
 /*!
@@ -658,10 +746,11 @@ QDebug operator<<(QDebug dbg, const QJsonDocument &o)
         return dbg;
     }
     QByteArray json;
-    if (o.d->header->root()->isArray())
-        QJsonPrivate::Writer::arrayToJson(static_cast<QJsonPrivate::Array *>(o.d->header->root()), json, 0, true);
+    QJsonPrivate::Data *d = resolved(o.d);
+    if (d->header->root()->isArray())
+        QJsonPrivate::Writer::arrayToJson(static_cast<QJsonPrivate::Array *>(d->header->root()), json, 0, true);
     else
-        QJsonPrivate::Writer::objectToJson(static_cast<QJsonPrivate::Object *>(o.d->header->root()), json, 0, true);
+        QJsonPrivate::Writer::objectToJson(static_cast<QJsonPrivate::Object *>(d->header->root()), json, 0, true);
     dbg.nospace() << "QJsonDocument("
                   << json.constData() // print as utf-8 string without extra quotation marks
                   << ')';
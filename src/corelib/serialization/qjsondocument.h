@@ -48,6 +48,7 @@ class QDebug;
 
 namespace QJsonPrivate {
     class Parser;
+    class LazyJson;
 }
 
 struct Q_CORE_EXPORT QJsonParseError
@@ -130,6 +131,7 @@ public:
     };
 
     static QJsonDocument fromJson(const QByteArray &json, QJsonParseError *error = nullptr);
+    static QJsonDocument fromJsonLazily(const QByteArray &json, QJsonParseError *error = nullptr);
 
 #if !defined(QT_JSON_READONLY) || defined(Q_CLANG_QDOC)
     QByteArray toJson() const; //### Merge in Qt6
@@ -162,6 +164,7 @@ private:
     friend class QJsonValue;
     friend class QJsonPrivate::Data;
     friend class QJsonPrivate::Parser;
+    friend class QJsonPrivate::LazyJson;
     friend Q_CORE_EXPORT QDebug operator<<(QDebug, const QJsonDocument &);
 
     QJsonDocument(QJsonPrivate::Data *data);
@@ -43,7 +43,9 @@
 #endif
 #include <qdebug.h>
 #include "qjsonparser_p.h"
+#include "qjsonparser_simd_p.h"
 #include "qjson_p.h"
+#include "private/qlocale_tools_p.h"
 #include "private/qutfcodec_p.h"
 
 //#define PARSER_DEBUG
@@ -197,6 +199,109 @@ QString QJsonParseError::errorString() const
 
 using namespace QJsonPrivate;
 
+static uint *indexInput(StructuralIndexState &state, const char *from, const char *to, uint pos,
+                        uint *out) noexcept
+{
+#ifdef QT_JSON_INDEX_AVX2
+    if (qCpuHasFeature(AVX2))
+        return qt_jsonIndexBlocks_avx2(state, from, to, pos, out);
+#endif
+#if defined(__SSE2__)
+    return indexBlocks<JsonClassifierSse2>(state, from, to, pos, out);
+#else
+    return indexBlocks<JsonClassifierGeneric>(state, from, to, pos, out);
+#endif
+}
+
+void StructuralIndex::reset(const char *begin, const char *end)
+{
+    state = StructuralIndexState();
+    state.base = begin;
+    next = begin;
+    inputEnd = end;
+    entries.resize(int(qMin<qsizetype>(end - begin + 64, BytesPerFill)));
+    count = 0;
+}
+
+/*
+    Replaces the entries with those of the next part of the input. Returns
+    false if all of the input has been indexed already.
+*/
+bool StructuralIndex::fill()
+{
+    if (next == inputEnd)
+        return false;
+
+    const qsizetype size = qMin<qsizetype>(inputEnd - next, BytesPerFill);
+    const char *blocksEnd = next + (size & ~qsizetype(63));
+    uint pos = uint(next - state.base);
+    uint *out = indexInput(state, next, blocksEnd, pos, entries.data());
+    pos += uint(blocksEnd - next);
+    next = blocksEnd;
+
+    if (size & 63) {
+        // pad the last block with whitespace
+        char block[64];
+        memset(block, ' ', sizeof(block));
+        memcpy(block, next, size_t(size & 63));
+        out = indexInput(state, block, block + sizeof(block), pos, out);
+        next = inputEnd;
+    }
+    count = int(out - entries.constData());
+    return true;
+}
+
+static IndexedBlock *maskInput(StructuralIndexState &state, const char *from, const char *to,
+                               IndexedBlock *out) noexcept
+{
+#ifdef QT_JSON_INDEX_AVX2
+    if (qCpuHasFeature(AVX2))
+        return qt_jsonMaskBlocks_avx2(state, from, to, out);
+#endif
+#if defined(__SSE2__)
+    return maskBlocks<JsonClassifierSse2>(state, from, to, out);
+#else
+    return maskBlocks<JsonClassifierGeneric>(state, from, to, out);
+#endif
+}
+
+void BlockIndex::reset(const char *begin, const char *end)
+{
+    state = StructuralIndexState();
+    state.base = begin;
+    next = begin;
+    inputEnd = end;
+    first = 0;
+    count = 0;
+}
+
+/*
+    Replaces the blocks with the next part of the input. Returns false if
+    all of the input has been indexed already.
+*/
+bool BlockIndex::fill()
+{
+    if (next == inputEnd)
+        return false;
+
+    const qsizetype size = qMin<qsizetype>(inputEnd - next, StructuralIndex::BytesPerFill);
+    const char *blocksEnd = next + (size & ~qsizetype(63));
+    IndexedBlock *out = maskInput(state, next, blocksEnd, blocks);
+    next = blocksEnd;
+
+    if (size & 63) {
+        // pad the last block with whitespace
+        char block[64];
+        memset(block, ' ', sizeof(block));
+        memcpy(block, next, size_t(size & 63));
+        out = maskInput(state, block, block + sizeof(block), out);
+        next = inputEnd;
+    }
+    first += count;
+    count = out - blocks;
+    return true;
+}
+
 Parser::Parser(const char *json, int length)
     : head(json), json(json), data(nullptr)
     , dataLength(0), current(0), nestingLevel(0)
@@ -258,21 +363,94 @@ void Parser::eatBOM()
         json += 3;
 }
 
+static inline bool isSpace(char c)
+{
+    return c == Space || c == Tab || c == LineFeed || c == Return;
+}
+
 bool Parser::eatSpace()
 {
-    while (json < end) {
-        if (*json > Space)
-            break;
-        if (*json != Space &&
-            *json != Tab &&
-            *json != LineFeed &&
-            *json != Return)
-            break;
-        ++json;
+    if (!useIndex) {
+        while (json < end && isSpace(*json))
+            ++json;
+        return (json < end);
     }
+    // a single space, as after a separator, is not worth a lookup
+    if (json < end && isSpace(*json))
+        ++json;
+    // longer runs of whitespace are skipped a block at a time
+    if (json < end && isSpace(*json))
+        json = skipIndexedSpace(json);
     return (json < end);
 }
 
+/*
+    Starts using the block index once the strings of at least
+    LongStringLength bytes make up a quarter of the input parsed so far.
+    Called after a string of \a length bytes, when json is just past its
+    closing quote and therefore outside of any string, which is where the
+    index can start.
+*/
+void Parser::countString(qsizetype length)
+{
+    if (useIndex || length < LongStringLength)
+        return;
+    longStringBytes += length;
+    if (4 * longStringBytes >= json - head) {
+        useIndex = true;
+        blockIndex.reset(json, end);
+    }
+}
+
+/*
+    Returns the first character at or after \a from that is not
+    whitespace, or the end of the input if there is none.
+*/
+const char *Parser::skipIndexedSpace(const char *from)
+{
+    const qsizetype offset = from - blockIndex.base();
+    qsizetype n = offset / 64;
+    // count the bytes before from as whitespace
+    quint64 space = (Q_UINT64_C(1) << (offset % 64)) - 1;
+    while (const IndexedBlock *block = blockIndex.block(n)) {
+        space |= block->whitespace;
+        if (~space)
+            return qMin(blockIndex.base() + n * 64 + qCountTrailingZeroBits(~space), end);
+        space = 0;
+        ++n;
+    }
+    return end;
+}
+
+/*
+    Returns the closing quote of the string whose contents start at json,
+    if the string contains nothing but ASCII characters and no escape
+    sequences. Otherwise returns \nullptr.
+*/
+const char *Parser::plainStringEnd()
+{
+    if (!useIndex)
+        return nullptr;
+    const qsizetype offset = json - 1 - blockIndex.base();
+    qsizetype n = offset / 64;
+    const IndexedBlock *block = blockIndex.block(n);
+    if (!block || !((block->openQuote >> (offset % 64)) & 1))
+        return nullptr;
+
+    // the bytes after the opening quote
+    quint64 after = ~Q_UINT64_C(0) << (offset % 64) << 1;
+    do {
+        const quint64 stop = (block->closeQuote | block->nonPlain) & after;
+        if (stop) {
+            if (!(block->closeQuote & stop & (0 - stop)))
+                return nullptr;
+            return blockIndex.base() + n * 64 + qCountTrailingZeroBits(stop);
+        }
+        after = ~Q_UINT64_C(0);
+    } while ((block = blockIndex.block(++n)));
+    return nullptr;
+}
+
 char Parser::nextToken()
 {
     if (!eatSpace())
@@ -778,26 +956,32 @@ bool Parser::parseNumber(QJsonPrivate::Value *val, int baseOffset)
         return false;
     }
 
-    QByteArray number(start, json - start);
-    DEBUG << "numberstring" << number;
+    DEBUG << "numberstring" << QByteArray(start, json - start);
 
     if (isInt) {
-        bool ok;
-        int n = number.toInt(&ok);
-        if (ok && n < (1<<25) && n > -(1<<25)) {
-            val->int_value = n;
-            val->latinOrIntValue = true;
-            END;
-            return true;
+        // the digits have been checked above, and 8 of them cannot overflow
+        const bool negative = *start == '-';
+        const char *digits = start + (negative ? 1 : 0);
+        if (digits != json && json - digits <= 8) {
+            int n = 0;
+            for (const char *c = digits; c != json; ++c)
+                n = n * 10 + (*c - '0');
+            if (n < (1<<25)) {
+                val->int_value = negative ? -n : n;
+                val->latinOrIntValue = true;
+                END;
+                return true;
+            }
         }
     }
 
     bool ok;
+    int processed;
     union {
         quint64 ui;
         double d;
     };
-    d = number.toDouble(&ok);
+    d = qt_asciiToDouble(start, int(json - start), ok, processed);
 
     if (!ok) {
         lastError = QJsonParseError::IllegalNumber;
@@ -841,80 +1025,6 @@ bool Parser::parseNumber(QJsonPrivate::Value *val, int baseOffset)
 
         unescaped = %x20-21 / %x23-5B / %x5D-10FFFF
  */
-static inline bool addHexDigit(char digit, uint *result)
-{
-    *result <<= 4;
-    if (digit >= '0' && digit <= '9')
-        *result |= (digit - '0');
-    else if (digit >= 'a' && digit <= 'f')
-        *result |= (digit - 'a') + 10;
-    else if (digit >= 'A' && digit <= 'F')
-        *result |= (digit - 'A') + 10;
-    else
-        return false;
-    return true;
-}
-
-static inline bool scanEscapeSequence(const char *&json, const char *end, uint *ch)
-{
-    ++json;
-    if (json >= end)
-        return false;
-
-    DEBUG << "scan escape" << (char)*json;
-    uint escaped = *json++;
-    switch (escaped) {
-    case '"':
-        *ch = '"'; break;
-    case '\\':
-        *ch = '\\'; break;
-    case '/':
-        *ch = '/'; break;
-    case 'b':
-        *ch = 0x8; break;
-    case 'f':
-        *ch = 0xc; break;
-    case 'n':
-        *ch = 0xa; break;
-    case 'r':
-        *ch = 0xd; break;
-    case 't':
-        *ch = 0x9; break;
-    case 'u': {
-        *ch = 0;
-        if (json > end - 4)
-            return false;
-        for (int i = 0; i < 4; ++i) {
-            if (!addHexDigit(*json, ch))
-                return false;
-            ++json;
-        }
-        return true;
-    }
-    default:
-        // this is not as strict as one could be, but allows for more Json files
-        // to be parsed correctly.
-        *ch = escaped;
-        return true;
-    }
-    return true;
-}
-
-static inline bool scanUtf8Char(const char *&json, const char *end, uint *result)
-{
-    const uchar *&src = reinterpret_cast<const uchar *&>(json);
-    const uchar *uend = reinterpret_cast<const uchar *>(end);
-    uchar b = *src++;
-    int res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, result, src, uend);
-    if (res < 0) {
-        // decoding error, backtrack the character we read above
-        --json;
-        return false;
-    }
-
-    return true;
-}
-
 bool Parser::parseString(bool *latin1)
 {
     *latin1 = true;
@@ -929,6 +1039,16 @@ bool Parser::parseString(bool *latin1)
         return false;
 
     BEGIN << "parse string stringPos=" << stringPos << json;
+    const char *plainEnd = plainStringEnd();
+    if (plainEnd && plainEnd - json < 0x8000) {
+        // nothing to decode
+        const int length = int(plainEnd - json);
+        int pos = reserveSpace(length);
+        if (pos < 0)
+            return false;
+        memcpy(data + pos, json, size_t(length));
+        json = plainEnd;
+    }
     while (json < end) {
         uint ch = 0;
         if (*json == '"')
@@ -964,6 +1084,7 @@ bool Parser::parseString(bool *latin1)
 
     // no unicode string, we are done
     if (*latin1) {
+        countString(json - 1 - start);
         // write string length
         *(QJsonPrivate::qle_ushort *)(data + stringPos) = ushort(current - outStart - sizeof(ushort));
         int pos = reserveSpace((4 - current) & 3);
@@ -1016,6 +1137,8 @@ bool Parser::parseString(bool *latin1)
         return false;
     }
 
+    countString(json - 1 - start);
+
     // write string length
     *(QJsonPrivate::qle_int *)(data + stringPos) = (current - outStart - sizeof(int))/2;
     int pos = reserveSpace((4 - current) & 3);
@@ -1027,4 +1150,382 @@ bool Parser::parseString(bool *latin1)
     return true;
 }
 
+LazyJson::LazyJson(const QByteArray &json, int offset)
+    : json(json), offset(offset)
+{
+}
+
+LazyJson::~LazyJson()
+{
+    Data *d = parsed.loadRelaxed();
+    if (d && !d->ref.deref())
+        delete d;
+    for (int i = 0; values && i < members.size(); ++i)
+        delete values[i].loadRelaxed();
+}
+
+/*
+    Returns the binary representation of the whole document, parsing it
+    the first time. buildIndex() has validated the text, so this only
+    fails, with an empty object or array, if the document is too large for
+    the binary format.
+*/
+Data *LazyJson::data()
+{
+    Data *d = parsed.loadAcquire();
+    if (d)
+        return d;
+
+    const QJsonDocument doc = Parser(json.constData(), json.size()).parse(nullptr);
+    if (doc.d)
+        d = doc.d;
+    else
+        d = new Data(0, isObject() ? QJsonValue::Object : QJsonValue::Array);
+    d->ref.ref();
+
+    Data *other;
+    if (!parsed.testAndSetOrdered(nullptr, d, other)) {
+        // another thread was faster
+        if (!d->ref.deref())
+            delete d;
+        return other;
+    }
+    return d;
+}
+
+// Decodes the contents of a string, without the quotes.
+static bool decodeString(const char *text, const char *end, QString *result,
+                         QJsonParseError::ParseError *error)
+{
+    result->resize(int(end - text)); // no more UTF-16 code units than bytes
+    ushort *out = reinterpret_cast<ushort *>(result->data());
+    ushort *const outStart = out;
+    while (text < end) {
+        uint ch = 0;
+        if (*text == '\\') {
+            if (!scanEscapeSequence(text, end, &ch)) {
+                *error = QJsonParseError::IllegalEscapeSequence;
+                return false;
+            }
+        } else if (!scanUtf8Char(text, end, &ch)) {
+            *error = QJsonParseError::IllegalUTF8String;
+            return false;
+        }
+        if (QChar::requiresSurrogates(ch)) {
+            *out++ = QChar::highSurrogate(ch);
+            *out++ = QChar::lowSurrogate(ch);
+        } else {
+            *out++ = ushort(ch);
+        }
+    }
+    result->truncate(int(out - outStart));
+    return true;
+}
+
+// Checks the contents of a string, without the quotes, like
+// decodeString() does.
+static bool validateString(const char *text, const char *end, QJsonParseError::ParseError *error)
+{
+    while (text < end) {
+        uint ch = 0;
+        if (*text == '\\') {
+            if (!scanEscapeSequence(text, end, &ch)) {
+                *error = QJsonParseError::IllegalEscapeSequence;
+                return false;
+            }
+        } else if (!scanUtf8Char(text, end, &ch)) {
+            *error = QJsonParseError::IllegalUTF8String;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Parses a number or literal that has no whitespace around it, accepting
+// what Parser::parseValue() accepts.
+static QJsonValue parseScalar(const char *text, const char *end)
+{
+    const auto isLiteral = [=](const char *literal) {
+        return size_t(end - text) == strlen(literal)
+                && memcmp(text, literal, size_t(end - text)) == 0;
+    };
+    switch (*text) {
+    case 't':
+        return isLiteral("true") ? QJsonValue(true) : QJsonValue(QJsonValue::Undefined);
+    case 'f':
+        return isLiteral("false") ? QJsonValue(false) : QJsonValue(QJsonValue::Undefined);
+    case 'n':
+        return isLiteral("null") ? QJsonValue(QJsonValue::Null) : QJsonValue(QJsonValue::Undefined);
+    default:
+        break;
+    }
+
+    const char *p = text;
+    if (p < end && *p == '-')
+        ++p;
+    if (p < end && *p == '0') {
+        ++p;
+    } else {
+        while (p < end && *p >= '0' && *p <= '9')
+            ++p;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && *p >= '0' && *p <= '9')
+            ++p;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        if (p < end && (*p == '-' || *p == '+'))
+            ++p;
+        while (p < end && *p >= '0' && *p <= '9')
+            ++p;
+    }
+    if (p != end)
+        return QJsonValue(QJsonValue::Undefined);
+
+    bool ok;
+    int processed;
+    const double d = qt_asciiToDouble(text, int(end - text), ok, processed);
+    return ok ? QJsonValue(d) : QJsonValue(QJsonValue::Undefined);
+}
+
+/*
+    Walks the structural index of the text once. Checks that the text is a
+    valid document, and records where the top-level keys and values are.
+    Strings that the index marks as plain need no checking; the others,
+    and all numbers and literals, are checked as they are reached, so that
+    parsing any part of the document later cannot fail.
+*/
+QJsonParseError LazyJson::buildIndex()
+{
+    enum {
+        Value, ValueOrEnd,      // in an array, after '[' or ','
+        Key, KeyOrEnd,          // in an object, after '{' or ','
+        KeyEnd, StringEnd,      // the next entry is the closing quote
+        NameSeparator,
+        SeparatorOrEnd          // after a value
+    } expected = Value;
+    QVarLengthArray<char, 64> containers;
+    bool finished = false;
+    Member member = {};
+    const char *stringBegin = nullptr;  // of the string being scanned
+    const char *scalar = nullptr;       // number or literal that has not been checked
+
+    const char *begin = json.constData();
+    const auto fail = [](int pos, QJsonParseError::ParseError code) {
+        return QJsonParseError{ pos, code };
+    };
+
+    StructuralIndex structure;
+    structure.reset(begin + offset, begin + json.size());
+    while (structure.fill()) {
+        for (const uint *it = structure.begin(); it != structure.end(); ++it) {
+            const char *position = structure.position(*it);
+            const int pos = int(position - begin);
+            const char c = *position;
+            const bool plain = !(*it & StructuralIndex::NeedsDecoding);
+            const bool topLevel = containers.size() == 1;
+
+            if (finished)
+                return fail(pos, QJsonParseError::GarbageAtEnd);
+
+            if (scalar) {
+                // it ends where the next token starts
+                const char *scalarEnd = position;
+                while (isSpace(scalarEnd[-1]))
+                    --scalarEnd;
+                if (parseScalar(scalar, scalarEnd).isUndefined()) {
+                    const bool literal = *scalar == 't' || *scalar == 'f' || *scalar == 'n';
+                    return fail(int(scalar - begin), literal ? QJsonParseError::IllegalValue
+                                                             : QJsonParseError::IllegalNumber);
+                }
+                scalar = nullptr;
+            }
+
+            switch (expected) {
+            case KeyEnd:
+            case StringEnd: {
+                QJsonParseError::ParseError code;
+                if (!plain && !validateString(stringBegin + 1, position, &code))
+                    return fail(int(stringBegin - begin), code);
+                if (topLevel && expected == KeyEnd) {
+                    member.keyEnd = pos + 1;
+                    member.plainKey = plain;
+                } else if (topLevel) {
+                    member.valueEnd = pos + 1;
+                    member.plainValue = plain;
+                }
+                expected = expected == KeyEnd ? NameSeparator : SeparatorOrEnd;
+                continue;
+            }
+            case Key:
+            case KeyOrEnd:
+                if (c == '"') {
+                    if (topLevel)
+                        member.keyBegin = pos;
+                    stringBegin = position;
+                    expected = KeyEnd;
+                    continue;
+                }
+                if (c != '}')
+                    return fail(pos, QJsonParseError::UnterminatedObject);
+                if (expected == Key)
+                    return fail(pos, QJsonParseError::MissingObject);
+                break;
+            case NameSeparator:
+                if (c != ':')
+                    return fail(pos, QJsonParseError::MissingNameSeparator);
+                expected = Value;
+                continue;
+            case Value:
+            case ValueOrEnd:
+                if (c == ']' && expected == ValueOrEnd)
+                    break;
+                if (c == ',' || c == ':' || c == '}' || c == ']')
+                    return fail(pos, QJsonParseError::IllegalValue);
+                if (topLevel)
+                    member.valueBegin = pos;
+                if (c == '"') {
+                    stringBegin = position;
+                    expected = StringEnd;
+                } else if (c == '{' || c == '[') {
+                    if (containers.size() >= nestingLimit)
+                        return fail(pos, QJsonParseError::DeepNesting);
+                    containers.append(c);
+                    expected = c == '{' ? KeyOrEnd : ValueOrEnd;
+                } else if (c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n') {
+                    scalar = position;
+                    expected = SeparatorOrEnd;
+                } else {
+                    return fail(pos, QJsonParseError::IllegalValue);
+                }
+                continue;
+            case SeparatorOrEnd:
+                if (topLevel && (c == ',' || c == '}' || c == ']')) {
+                    if (!member.valueEnd)
+                        member.valueEnd = pos;
+                    members.append(member);
+                    member = Member();
+                }
+                if (c == ',') {
+                    expected = containers.last() == '{' ? Key : Value;
+                    continue;
+                }
+                if (c != (containers.last() == '{' ? '}' : ']')) {
+                    return fail(pos, containers.last() == '{' ? QJsonParseError::UnterminatedObject
+                                                              : QJsonParseError::UnterminatedArray);
+                }
+                break;
+            }
+
+            // c closes the innermost container
+            containers.removeLast();
+            expected = SeparatorOrEnd;
+            finished = containers.isEmpty();
+            if (containers.size() == 1)
+                member.valueEnd = pos + 1;
+        }
+    }
+
+    if (!containers.isEmpty()) {
+        const QJsonParseError::ParseError code
+                = (expected == KeyEnd || expected == StringEnd) ? QJsonParseError::UnterminatedString
+                : containers.last() == '{' ? QJsonParseError::UnterminatedObject
+                : QJsonParseError::UnterminatedArray;
+        return fail(json.size(), code);
+    }
+
+    if (isObject()) {
+        keys.reserve(members.size());
+        for (int i = 0; i < members.size(); ++i) {
+            const Member &m = members.at(i);
+            const char *key = begin + m.keyBegin + 1;
+            const char *keyEnd = begin + m.keyEnd - 1;
+            QString name;
+            QJsonParseError::ParseError code;
+            if (m.plainKey)
+                name = QString::fromLatin1(key, int(keyEnd - key));
+            else if (!decodeString(key, keyEnd, &name, &code))
+                return fail(m.keyBegin, code);
+            // the last of several equal keys wins, as in the parser
+            keys.insert(std::move(name), i);
+        }
+    }
+    values.reset(new QAtomicPointer<QJsonValue>[members.size()]);
+    return fail(0, QJsonParseError::NoError);
+}
+
+QJsonValue LazyJson::parseValue(const Member &member) const
+{
+    const char *text = json.constData() + member.valueBegin;
+    const char *end = json.constData() + member.valueEnd;
+
+    switch (*text) {
+    case '"': {
+        if (member.plainValue) // nothing but ASCII between the quotes
+            return QJsonValue(QString::fromLatin1(text + 1, int(end - text) - 2));
+        QString string;
+        QJsonParseError::ParseError error;
+        if (!decodeString(text + 1, end - 1, &string, &error))
+            return QJsonValue(QJsonValue::Undefined);
+        return QJsonValue(string);
+    }
+    case '{':
+    case '[': {
+        QJsonParseError error;
+        const QJsonDocument doc = Parser(text, int(end - text)).parse(&error);
+        if (error.error != QJsonParseError::NoError)
+            return QJsonValue(QJsonValue::Undefined);
+        return doc.isObject() ? QJsonValue(doc.object()) : QJsonValue(doc.array());
+    }
+    default:
+        while (end > text && isSpace(end[-1]))
+            --end;
+        return parseScalar(text, end);
+    }
+}
+
+// Returns the value of member i, parsing it the first time.
+QJsonValue LazyJson::memberValue(int i)
+{
+    if (const QJsonValue *v = values[i].loadAcquire())
+        return *v;
+
+    QJsonValue *v = new QJsonValue(parseValue(members.at(i)));
+    QJsonValue *other;
+    if (!values[i].testAndSetOrdered(nullptr, v, other)) {
+        // another thread was faster
+        delete v;
+        return *other;
+    }
+    return *v;
+}
+
+template <typename String>
+QJsonValue LazyJson::lookup(String key)
+{
+    if (!isObject())
+        return QJsonValue(QJsonValue::Undefined);
+    const int i = keys.value(key, -1);
+    return i < 0 ? QJsonValue(QJsonValue::Undefined) : memberValue(i);
+}
+
+QJsonValue LazyJson::value(QStringView key)
+{
+    return lookup(key);
+}
+
+QJsonValue LazyJson::value(QLatin1String key)
+{
+    return lookup(key);
+}
+
+QJsonValue LazyJson::value(int i)
+{
+    if (isObject() || i < 0 || i >= members.size())
+        return QJsonValue(QJsonValue::Undefined);
+    return memberValue(i);
+}
+
 QT_END_NAMESPACE
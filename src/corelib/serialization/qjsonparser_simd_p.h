@@ -0,0 +1,274 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QJSONPARSER_SIMD_P_H
+#define QJSONPARSER_SIMD_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qjsonparser_p.h"
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/private/qnumeric_p.h>
+#include <QtCore/private/qsimd_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QJsonPrivate {
+
+// Bit n of each mask describes byte n of a 64-byte block.
+struct BlockMasks
+{
+    quint64 quote;
+    quint64 backslash;
+    quint64 structural;     // { } [ ] : ,
+    quint64 whitespace;     // space, tab, line feed, carriage return
+    quint64 nonAscii;
+};
+
+struct JsonClassifierGeneric
+{
+    static BlockMasks classify(const char *block) noexcept
+    {
+        BlockMasks m = {};
+        for (int i = 0; i < 64; ++i) {
+            const quint64 bit = Q_UINT64_C(1) << i;
+            switch (block[i]) {
+            case '"':
+                m.quote |= bit;
+                break;
+            case '\\':
+                m.backslash |= bit;
+                break;
+            case '{': case '}': case '[': case ']': case ':': case ',':
+                m.structural |= bit;
+                break;
+            case ' ': case '\t': case '\n': case '\r':
+                m.whitespace |= bit;
+                break;
+            default:
+                if (uchar(block[i]) >= 0x80)
+                    m.nonAscii |= bit;
+                break;
+            }
+        }
+        return m;
+    }
+};
+
+#ifdef __SSE2__
+struct JsonClassifierSse2
+{
+    static BlockMasks classify(const char *block) noexcept
+    {
+        BlockMasks m = {};
+        for (int i = 0; i < 4; ++i) {
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+            const auto is = [c](char ch) { return _mm_cmpeq_epi8(c, _mm_set1_epi8(ch)); };
+            const auto bits = [](__m128i v) { return quint64(uint(_mm_movemask_epi8(v))); };
+
+            // ORing 0x20 maps [ to { and ] to }
+            const __m128i folded = _mm_or_si128(c, _mm_set1_epi8(0x20));
+            const __m128i brackets = _mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')),
+                                                  _mm_cmpeq_epi8(folded, _mm_set1_epi8('}')));
+            const __m128i structural = _mm_or_si128(brackets, _mm_or_si128(is(':'), is(',')));
+            const __m128i whitespace = _mm_or_si128(_mm_or_si128(is(' '), is('\t')),
+                                                    _mm_or_si128(is('\n'), is('\r')));
+            const int shift = 16 * i;
+            m.quote |= bits(is('"')) << shift;
+            m.backslash |= bits(is('\\')) << shift;
+            m.structural |= bits(structural) << shift;
+            m.whitespace |= bits(whitespace) << shift;
+            m.nonAscii |= bits(c) << shift;
+        }
+        return m;
+    }
+};
+#endif // __SSE2__
+
+#ifdef __AVX2__
+struct JsonClassifierAvx2
+{
+    static BlockMasks classify(const char *block) noexcept
+    {
+        BlockMasks m = {};
+        for (int i = 0; i < 2; ++i) {
+            const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32 * i));
+            const auto is = [c](char ch) { return _mm256_cmpeq_epi8(c, _mm256_set1_epi8(ch)); };
+            const auto bits = [](__m256i v) { return quint64(uint(_mm256_movemask_epi8(v))); };
+
+            // ORing 0x20 maps [ to { and ] to }
+            const __m256i folded = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+            const __m256i brackets = _mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')),
+                                                     _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}')));
+            const __m256i structural = _mm256_or_si256(brackets, _mm256_or_si256(is(':'), is(',')));
+            const __m256i whitespace = _mm256_or_si256(_mm256_or_si256(is(' '), is('\t')),
+                                                       _mm256_or_si256(is('\n'), is('\r')));
+            const int shift = 32 * i;
+            m.quote |= bits(is('"')) << shift;
+            m.backslash |= bits(is('\\')) << shift;
+            m.structural |= bits(structural) << shift;
+            m.whitespace |= bits(whitespace) << shift;
+            m.nonAscii |= bits(c) << shift;
+        }
+        return m;
+    }
+};
+#endif // __AVX2__
+
+// Sets each bit to the XOR of itself and all bits below it, which turns
+// the quote positions into a mask of the bytes inside strings.
+inline quint64 prefixXor(quint64 x) noexcept
+{
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// Finds the quotes of a block that are not escaped, and returns them.
+// Sets inString to the mask of the opening quotes and the contents of
+// strings, which does not include the closing quotes.
+inline quint64 unescapedQuotes(StructuralIndexState &state, const BlockMasks &m,
+                               quint64 *inString) noexcept
+{
+    const quint64 evenBits = Q_UINT64_C(0x5555555555555555);
+
+    // A character is escaped if it follows an odd number of
+    // backslashes. Runs of backslashes that start on an odd bit carry
+    // into the bit after their end when added to an odd-bit mask.
+    const quint64 backslash = m.backslash & ~state.prevEscaped;
+    const quint64 followsEscape = (backslash << 1) | state.prevEscaped;
+    const quint64 oddStarts = backslash & ~evenBits & ~followsEscape;
+    quint64 sequencesOnEven;
+    state.prevEscaped = add_overflow(oddStarts, backslash, &sequencesOnEven);
+    const quint64 escaped = (evenBits ^ (sequencesOnEven << 1)) & followsEscape;
+
+    const quint64 quote = m.quote & ~escaped;
+    *inString = prefixXor(quote) ^ state.prevInString;
+    state.prevInString = quint64(qint64(*inString) >> 63);
+    return quote;
+}
+
+// Indexes the 64-byte blocks in [from, to); from is at position pos.
+// Writes at most one entry per byte to out, and returns the new end.
+template <typename Classifier>
+uint *indexBlocks(StructuralIndexState &state, const char *from, const char *to, uint pos,
+                  uint *out) noexcept
+{
+    for (const char *block = from; block != to; block += 64, pos += 64) {
+        const BlockMasks m = Classifier::classify(block);
+        quint64 inString;
+        const quint64 quote = unescapedQuotes(state, m, &inString);
+
+        const quint64 structural = m.structural & ~inString;
+        const quint64 scalar = ~(m.structural | m.whitespace | quote | inString);
+        const quint64 scalarStart = scalar & ~((scalar << 1) | state.prevScalar);
+        state.prevScalar = scalar >> 63;
+        const quint64 nonPlain = m.backslash | m.nonAscii;
+
+        quint64 tokens = structural | quote | scalarStart;
+        while (tokens) {
+            const uint bit = qCountTrailingZeroBits(tokens);
+            const quint64 mask = Q_UINT64_C(1) << bit;
+            tokens &= tokens - 1;
+            uint entry = pos + bit;
+            if (quote & mask) {
+                if (inString & mask) {
+                    state.lastOpenQuote = entry;
+                } else {
+                    const quint64 before = nonPlain & (mask - 1);
+                    const qint64 lastNonPlain = before
+                            ? qint64(pos + 63 - qCountLeadingZeroBits(before))
+                            : state.lastNonPlain;
+                    if (lastNonPlain > state.lastOpenQuote)
+                        entry |= StructuralIndex::NeedsDecoding;
+                }
+            }
+            *out++ = entry;
+        }
+        if (nonPlain)
+            state.lastNonPlain = pos + 63 - qCountLeadingZeroBits(nonPlain);
+    }
+    return out;
+}
+
+// Computes the masks of the 64-byte blocks in [from, to) for BlockIndex.
+// Writes one entry per block to out, and returns the new end.
+template <typename Classifier>
+IndexedBlock *maskBlocks(StructuralIndexState &state, const char *from, const char *to,
+                         IndexedBlock *out) noexcept
+{
+    for (const char *block = from; block != to; block += 64, ++out) {
+        const BlockMasks m = Classifier::classify(block);
+        quint64 inString;
+        const quint64 quote = unescapedQuotes(state, m, &inString);
+        out->whitespace = m.whitespace;
+        out->openQuote = quote & inString;
+        out->closeQuote = quote & ~inString;
+        out->nonPlain = m.backslash | m.nonAscii;
+    }
+    return out;
+}
+
+#if defined(QT_COMPILER_SUPPORTS_AVX2) && !defined(QT_BOOTSTRAPPED)
+#  define QT_JSON_INDEX_AVX2
+uint *qt_jsonIndexBlocks_avx2(StructuralIndexState &state, const char *from, const char *to,
+                              uint pos, uint *out) noexcept;
+IndexedBlock *qt_jsonMaskBlocks_avx2(StructuralIndexState &state, const char *from, const char *to,
+                                     IndexedBlock *out) noexcept;
+#endif
+
+} // namespace QJsonPrivate
+
+QT_END_NAMESPACE
+
+#endif // QJSONPARSER_SIMD_P_H
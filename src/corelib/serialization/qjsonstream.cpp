@@ -0,0 +1,1516 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qjsonstream.h"
+
+#include <qcoreapplication.h>
+#include <qdebug.h>
+#include <qiodevice.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonobject.h>
+#include <qvarlengtharray.h>
+
+#include <private/qjsonparser_p.h>
+#include <private/qjsonwriter_p.h>
+#include <private/qlocale_tools_p.h>
+#include <private/qnumeric_p.h>
+#include <private/qutfcodec_p.h>
+
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+void qt_from_latin1(ushort *dst, const char *str, size_t size) noexcept;
+
+namespace {
+
+// the same limit as the JSON parser's
+enum { NestingLimit = 1024 };
+
+enum ContainerState : quint8 {
+    ArrayStart,         // after '[', before the first element
+    ArrayValue,         // after an element
+    ObjectStart,        // after '{', before the first member
+    ObjectKey,          // after a name, before its value (writer only)
+    ObjectValue         // after a member
+};
+
+inline bool isJsonSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+} // unnamed namespace
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.0
+
+    \brief The QJsonStreamReader class is a fast parser for reading JSON text
+    incrementally, one token at a time.
+
+    QJsonDocument::fromJson() parses a complete document into memory before
+    any of it can be used. QJsonStreamReader instead provides a pull API
+    similar to that of QXmlStreamReader and QCborStreamReader: the
+    application calls readNext() to advance to the next token, and inspects
+    it with tokenType() and the accessor functions. Only the token being
+    read is kept in memory, so documents of any size can be processed with
+    a small, constant amount of memory.
+
+    The reader operates either on a QIODevice, set with setDevice(), or on
+    data handed to it with addData(). In both cases the input does not need
+    to be available all at once. When the reader runs out of input in the
+    middle of a value, readNext() returns \l Invalid and error() reports
+    PrematureEndOfDocumentError. Once more data has arrived, either from the
+    device or through addData(), calling readNext() again continues where
+    reading stopped. This makes it possible to parse data as it comes in
+    from a network connection.
+
+    The input can contain any number of JSON values. Strings, numbers and
+    literals at the top level must be separated from the next value by
+    whitespace, while arrays and objects can directly follow each other.
+    In particular, the reader can process JSON Lines, where
+    each line contains one value. When all of the available input has been
+    read, and it ended between two values, readNext() returns
+    \l EndDocument. That token does not end the reading; if more data
+    arrives later, readNext() continues with the next value.
+
+    \snippet code/src_corelib_serialization_qjsonstream.cpp 0
+
+    Inside an object, each member is reported as a single token for its
+    value, and name() returns the member's name. For strings, text()
+    contains the decoded string; toDouble(), toInteger() and toBool()
+    return the value of numbers and booleans. The views returned by name()
+    and text() are only valid until the next call to readNext().
+
+    Numbers are only complete once the character after them has been read.
+    A number that is the last thing in the input is therefore only reported
+    once the input is known to end. That is the case after finishData() has
+    been called, for a device that is not sequential and has been read to
+    the end, and for a device that has been closed or whose read() has
+    returned -1, like a socket that has been disconnected. A sequential
+    device that merely has no data available at the moment, like a
+    QTcpSocket that is still connected, cannot tell whether more input will
+    follow; call finishData() when the protocol says that the input has
+    ended. When reading JSON Lines, the line break after the last value
+    serves the same purpose.
+
+    \sa QJsonStreamWriter, QJsonDocument, QXmlStreamReader, QCborStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum specifies the type of token the reader just read.
+
+    \value NoToken      The reader has not yet read anything.
+    \value Invalid      An error has occurred, reported in error() and
+                        errorString().
+    \value EndDocument  All of the available input has been read, and it
+                        ended between two top-level values.
+    \value StartArray   The reader reports the start of an array. The
+                        elements follow, and then an EndArray token.
+    \value EndArray     The reader reports the end of an array.
+    \value StartObject  The reader reports the start of an object. The
+                        members follow, and then an EndObject token.
+    \value EndObject    The reader reports the end of an object.
+    \value String       The reader reports a string, see text().
+    \value Number       The reader reports a number, see toDouble(),
+                        toInteger() and toUnsignedInteger().
+    \value Bool         The reader reports \c true or \c false, see toBool().
+    \value Null         The reader reports \c null.
+*/
+
+/*!
+    \enum QJsonStreamReader::Error
+
+    This enum specifies the different error cases.
+
+    \value NoError      No error has occurred.
+    \value CustomError  A custom error has been raised with raiseError().
+    \value NotWellFormedError The input is not valid JSON. errorString()
+                        describes the problem.
+    \value PrematureEndOfDocumentError The input ended in the middle of a
+                        value. Reading can continue once more data is
+                        available.
+*/
+
+class QJsonStreamReaderPrivate
+{
+public:
+    // parseToken() results that are not tokens
+    enum { NeedMoreData = -1, EndOfInput = -2 };
+
+    QJsonStreamReaderPrivate() { containers.reserve(32); }
+
+    void clear()
+    {
+        device = nullptr;
+        buffer.clear();
+        position = 0;
+        bufferOffset = 0;
+        containers.clear();
+        type = QJsonStreamReader::NoToken;
+        error = QJsonStreamReader::NoError;
+        errorString.clear();
+        nameSize = 0;
+        textSize = 0;
+        inputFinished = false;
+        deviceEnded = false;
+        needSeparator = false;
+        stringStart = -1;
+    }
+
+    bool inputComplete() const
+    {
+        if (inputFinished)
+            return true;
+        if (!device)
+            return false;
+        if (!device->isOpen() || deviceEnded)
+            return true;
+        return !device->isSequential() && device->atEnd();
+    }
+
+    bool fetchData();
+    void compact();
+    int parseToken();
+    int parseValue(const char *p, const char *end, bool member);
+    int parseMember(const char *p, const char *end);
+    int parseString(const char *&p, const char *end, QString &target, qsizetype &size);
+    int parseNumber(const char *p, const char *end);
+    int finishToken(const char *p, QJsonStreamReader::TokenType token);
+    int notWellFormed(const char *p, QJsonParseError::ParseError code);
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qsizetype position = 0;     // of the next character to read, in buffer
+    qint64 bufferOffset = 0;    // of buffer[0] in the input
+
+    bool inputFinished = false;
+    bool deviceEnded = false;   // read() returned -1, no more data will come
+    bool needSeparator = false; // a top-level scalar needs whitespace after it
+
+    // Where the scan of an incomplete string stopped, so that it can
+    // continue there once more data has arrived. Offsets are in the input.
+    qint64 stringStart = -1;    // of the opening quote
+    qint64 stringScanned = 0;
+    bool stringSimple = true;
+
+    QVarLengthArray<ContainerState, 32> containers;
+    QJsonStreamReader::TokenType type = QJsonStreamReader::NoToken;
+    QJsonStreamReader::Error error = QJsonStreamReader::NoError;
+    QString errorString;
+
+    // buffers for name() and text(), reused for each token
+    QString nameBuffer;
+    qsizetype nameSize = 0;
+    QString textBuffer;
+    qsizetype textSize = 0;
+
+    double number = 0;
+    quint64 integer = 0;            // the magnitude, if isInteger
+    bool isInteger = false;
+    bool isNegative = false;
+    bool boolean = false;
+};
+
+bool QJsonStreamReaderPrivate::fetchData()
+{
+    if (!device || !device->isOpen())
+        return false;
+    enum { ChunkSize = 64 * 1024 };
+    compact();
+    const int oldSize = buffer.size();
+    buffer.resize(oldSize + ChunkSize);
+    const qint64 bytesRead = device->read(buffer.data() + oldSize, ChunkSize);
+    buffer.resize(oldSize + int(qMax(bytesRead, qint64(0))));
+    if (bytesRead < 0 && !deviceEnded) {
+        // the input is complete now, which can finish a number at its end
+        deviceEnded = true;
+        return true;
+    }
+    return bytesRead > 0;
+}
+
+// Drops the data that has been read. What remains is the start of the
+// next token, if any.
+void QJsonStreamReaderPrivate::compact()
+{
+    if (!position)
+        return;
+    buffer.remove(0, int(position));
+    bufferOffset += position;
+    position = 0;
+}
+
+int QJsonStreamReaderPrivate::notWellFormed(const char *p, QJsonParseError::ParseError code)
+{
+    // characterOffset() reports where the error is; QJsonParseError only
+    // provides the message, as its int offset would not do for large input
+    position = p - buffer.constData();
+    const QJsonParseError parseError = { 0, code };
+    error = QJsonStreamReader::NotWellFormedError;
+    errorString = parseError.errorString();
+    return QJsonStreamReader::Invalid;
+}
+
+// Commits the token that ends at p.
+int QJsonStreamReaderPrivate::finishToken(const char *p, QJsonStreamReader::TokenType token)
+{
+    position = p - buffer.constData();
+    needSeparator = containers.isEmpty() && token != QJsonStreamReader::EndArray
+            && token != QJsonStreamReader::EndObject;
+    return token;
+}
+
+int QJsonStreamReaderPrivate::parseToken()
+{
+    const char *begin = buffer.constData();
+    const char *p = begin + position;
+    const char *end = begin + buffer.size();
+
+    if (bufferOffset + position == 0) {
+        // skip a UTF-8 byte order mark
+        static const char bom[] = "\xef\xbb\xbf";
+        const qsizetype available = qMin<qsizetype>(end - p, 3);
+        if (available && memcmp(p, bom, size_t(available)) == 0) {
+            if (available < 3)
+                return NeedMoreData;
+            p += 3;
+        }
+    }
+
+    while (p != end && isJsonSpace(*p))
+        ++p;
+    // whitespace can be committed without a token
+    if (p != begin + position)
+        needSeparator = false;
+    position = p - begin;
+
+    if (containers.isEmpty()) {
+        if (p == end)
+            return EndOfInput;
+        // arrays and objects end with a bracket, other values with whitespace
+        if (needSeparator)
+            return notWellFormed(p, QJsonParseError::GarbageAtEnd);
+        return parseValue(p, end, false);
+    }
+    if (p == end)
+        return NeedMoreData;
+
+    switch (containers.last()) {
+    case ArrayStart:
+    case ArrayValue:
+        if (*p == ']') {
+            containers.removeLast();
+            nameSize = 0;
+            return finishToken(p + 1, QJsonStreamReader::EndArray);
+        }
+        if (containers.last() == ArrayValue) {
+            if (*p != ',')
+                return notWellFormed(p, QJsonParseError::UnterminatedArray);
+            ++p;
+            while (p != end && isJsonSpace(*p))
+                ++p;
+            if (p == end)
+                return NeedMoreData;
+            if (*p == ']')
+                return notWellFormed(p, QJsonParseError::MissingObject);
+        }
+        return parseValue(p, end, false);
+
+    case ObjectStart:
+    case ObjectValue:
+        if (*p == '}') {
+            containers.removeLast();
+            nameSize = 0;
+            return finishToken(p + 1, QJsonStreamReader::EndObject);
+        }
+        if (containers.last() == ObjectValue) {
+            if (*p != ',')
+                return notWellFormed(p, QJsonParseError::UnterminatedObject);
+            ++p;
+            while (p != end && isJsonSpace(*p))
+                ++p;
+            if (p == end)
+                return NeedMoreData;
+            if (*p == '}')
+                return notWellFormed(p, QJsonParseError::MissingObject);
+        }
+        return parseMember(p, end);
+
+    case ObjectKey:
+        break;
+    }
+    Q_UNREACHABLE();
+    return QJsonStreamReader::Invalid;
+}
+
+/*
+    member = string name-separator value
+*/
+int QJsonStreamReaderPrivate::parseMember(const char *p, const char *end)
+{
+    if (*p != '"')
+        return notWellFormed(p, QJsonParseError::UnterminatedObject);
+    const int result = parseString(p, end, nameBuffer, nameSize);
+    if (result != QJsonStreamReader::String)
+        return result;
+
+    while (p != end && isJsonSpace(*p))
+        ++p;
+    if (p == end)
+        return NeedMoreData;
+    if (*p != ':')
+        return notWellFormed(p, QJsonParseError::MissingNameSeparator);
+    ++p;
+    while (p != end && isJsonSpace(*p))
+        ++p;
+    if (p == end)
+        return NeedMoreData;
+    return parseValue(p, end, true);
+}
+
+/*
+    value = false / null / true / object / array / number / string
+*/
+int QJsonStreamReaderPrivate::parseValue(const char *p, const char *end, bool member)
+{
+    Q_ASSERT(p != end);
+    if (!member)
+        nameSize = 0;
+
+    // Called once the whole token is available, to update the state of
+    // the enclosing container.
+    const auto startValue = [this] {
+        if (!containers.isEmpty()) {
+            ContainerState &state = containers.last();
+            state = (state == ArrayStart || state == ArrayValue) ? ArrayValue : ObjectValue;
+        }
+    };
+
+    switch (*p) {
+    case '[':
+    case '{':
+        if (containers.size() >= NestingLimit)
+            return notWellFormed(p, QJsonParseError::DeepNesting);
+        startValue();
+        containers.append(*p == '[' ? ArrayStart : ObjectStart);
+        return finishToken(p + 1, *p == '[' ? QJsonStreamReader::StartArray
+                                           : QJsonStreamReader::StartObject);
+
+    case '"': {
+        const int result = parseString(p, end, textBuffer, textSize);
+        if (result != QJsonStreamReader::String)
+            return result;
+        startValue();
+        return finishToken(p, QJsonStreamReader::String);
+    }
+
+    case 't':
+    case 'f':
+    case 'n': {
+        const char *literal = *p == 't' ? "true" : *p == 'f' ? "false" : "null";
+        const qsizetype length = qsizetype(strlen(literal));
+        const qsizetype available = qMin(length, qsizetype(end - p));
+        if (memcmp(p, literal, size_t(available)) != 0)
+            return notWellFormed(p, QJsonParseError::IllegalValue);
+        if (available < length)
+            return NeedMoreData;
+        startValue();
+        boolean = *p == 't';
+        return finishToken(p + length, *p == 'n' ? QJsonStreamReader::Null
+                                                 : QJsonStreamReader::Bool);
+    }
+
+    default:
+        if (*p == '-' || (*p >= '0' && *p <= '9')) {
+            const int result = parseNumber(p, end);
+            if (result == QJsonStreamReader::Number)
+                startValue();
+            return result;
+        }
+        return notWellFormed(p, QJsonParseError::IllegalValue);
+    }
+}
+
+/*
+    string = quotation-mark *char quotation-mark
+
+    Decodes the string that starts at p into target, and moves p behind its
+    closing quote.
+*/
+int QJsonStreamReaderPrivate::parseString(const char *&p, const char *end, QString &target,
+                                          qsizetype &size)
+{
+    Q_ASSERT(*p == '"');
+    const char *start = p + 1;
+    const char *const begin = buffer.constData();
+    const qint64 quoteOffset = bufferOffset + (p - begin);
+
+    // Find the end first, so that incomplete strings are not decoded. If
+    // this string was incomplete before, continue where that scan stopped.
+    bool simple = true;
+    const char *q = start;
+    if (stringStart == quoteOffset) {
+        simple = stringSimple;
+        q = begin + (stringScanned - bufferOffset);
+    }
+    const auto needMoreData = [&] {
+        stringStart = quoteOffset;
+        stringScanned = bufferOffset + (q - begin);
+        stringSimple = simple;
+        return NeedMoreData;
+    };
+    for (;;) {
+        if (q == end)
+            return needMoreData();
+        const uchar c = uchar(*q);
+        if (c == '"')
+            break;
+        if (c == '\\') {
+            // an incomplete escape sequence is scanned again
+            if (end - q < 2 || (q[1] == 'u' && end - q < 6))
+                return needMoreData();
+            simple = false;
+            q += 2;
+        } else {
+            if (c >= 0x80)
+                simple = false;
+            ++q;
+        }
+    }
+    if (stringStart == quoteOffset)
+        stringStart = -1;
+
+    // no more UTF-16 code units than UTF-8 code units
+    if (target.size() < q - start)
+        target.resize(int(q - start));
+    ushort *out = reinterpret_cast<ushort *>(target.data());
+
+    if (simple) {
+        qt_from_latin1(out, start, size_t(q - start));
+        size = q - start;
+    } else {
+        ushort *const outStart = out;
+        const char *s = start;
+        while (s != q) {
+            uint ch = 0;
+            if (*s == '\\') {
+                if (!QJsonPrivate::scanEscapeSequence(s, q, &ch))
+                    return notWellFormed(s, QJsonParseError::IllegalEscapeSequence);
+                *out++ = ushort(ch);
+            } else if (uchar(*s) < 0x80) {
+                *out++ = uchar(*s++);
+            } else {
+                if (!QJsonPrivate::scanUtf8Char(s, q, &ch))
+                    return notWellFormed(s, QJsonParseError::IllegalUTF8String);
+                if (QChar::requiresSurrogates(ch)) {
+                    *out++ = QChar::highSurrogate(ch);
+                    *out++ = QChar::lowSurrogate(ch);
+                } else {
+                    *out++ = ushort(ch);
+                }
+            }
+        }
+        size = out - outStart;
+    }
+
+    p = q + 1;
+    return QJsonStreamReader::String;
+}
+
+/*
+    number = [ minus ] int [ frac ] [ exp ]
+
+    Accepts the same numbers as QJsonDocument::fromJson().
+*/
+int QJsonStreamReaderPrivate::parseNumber(const char *p, const char *end)
+{
+    const char *start = p;
+    bool integral = true;
+    const auto atEnd = [&] {
+        return p == end;
+    };
+
+    if (*p == '-')
+        ++p;
+    if (!atEnd() && *p == '0') {
+        ++p;
+    } else {
+        while (!atEnd() && *p >= '0' && *p <= '9')
+            ++p;
+    }
+    if (!atEnd() && *p == '.') {
+        integral = false;
+        ++p;
+        while (!atEnd() && *p >= '0' && *p <= '9')
+            ++p;
+    }
+    if (!atEnd() && (*p == 'e' || *p == 'E')) {
+        integral = false;
+        ++p;
+        if (!atEnd() && (*p == '-' || *p == '+'))
+            ++p;
+        while (!atEnd() && *p >= '0' && *p <= '9')
+            ++p;
+    }
+    // The number might continue in data that has not arrived yet
+    if (atEnd() && !inputComplete())
+        return NeedMoreData;
+
+    bool ok = false;
+    int processed = 0;
+    number = qt_asciiToDouble(start, int(p - start), ok, processed);
+    if (!ok)
+        return notWellFormed(start, QJsonParseError::IllegalNumber);
+
+    // keep integers exact beyond 2^53
+    isInteger = false;
+    if (integral) {
+        isNegative = *start == '-';
+        integer = 0;
+        isInteger = true;
+        for (const char *c = start + (isNegative ? 1 : 0); c != p; ++c) {
+            if (mul_overflow(integer, quint64(10), &integer)
+                    || add_overflow(integer, quint64(*c - '0'), &integer)) {
+                isInteger = false;
+                break;
+            }
+        }
+    }
+    return finishToken(p, QJsonStreamReader::Number);
+}
+
+/*!
+    Constructs a stream reader without input. Use setDevice() or addData()
+    to provide the input.
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate)
+{
+}
+
+/*!
+    Constructs a stream reader that reads from \a device.
+
+    \sa setDevice()
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : QJsonStreamReader()
+{
+    setDevice(device);
+}
+
+/*!
+    Constructs a stream reader that reads \a data. More data can be added
+    with addData().
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : QJsonStreamReader()
+{
+    addData(data);
+}
+
+/*!
+    Destroys the stream reader.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+    Sets the current device to \a device, and resets the reader to its
+    initial state.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    d->clear();
+    d->device = device;
+}
+
+/*!
+    Returns the current device, or \nullptr if there is none.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+    Adds \a data to the input of the reader. The reader must not have a
+    device.
+
+    If readNext() stopped with PrematureEndOfDocumentError or returned
+    EndDocument, the next call of readNext() continues with the new data.
+
+    \sa readNext(), clear()
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with device()");
+        return;
+    }
+    if (d->position == d->buffer.size() && d->buffer.isEmpty()) {
+        d->buffer = data;
+        return;
+    }
+    d->compact();
+    d->buffer += data;
+}
+
+/*!
+    \overload
+
+    Adds the \a len bytes at \a data to the input of the reader.
+*/
+void QJsonStreamReader::addData(const char *data, qsizetype len)
+{
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with device()");
+        return;
+    }
+    d->compact();
+    d->buffer.append(data, int(len));
+}
+
+/*!
+    Tells the reader that the input ends after the data that has been added
+    or that the device() has provided so far.
+
+    Until then, the reader cannot know whether a number at the end of the
+    input is complete, and readNext() reports PrematureEndOfDocumentError for
+    it. After this call, readNext() reports the number, and the input that
+    remains is treated as the end of the document.
+
+    \sa addData(), clear()
+*/
+void QJsonStreamReader::finishData()
+{
+    d->inputFinished = true;
+}
+
+/*!
+    Removes any device() or data from the reader, and resets it to its
+    initial state.
+
+    \sa addData(), setDevice()
+*/
+void QJsonStreamReader::clear()
+{
+    d->clear();
+}
+
+/*!
+    Returns \c true if the reader has read all of the available input, or
+    if an error has occurred. Otherwise returns \c false.
+
+    If both atEnd() and hasError() return \c true, and error() is
+    PrematureEndOfDocumentError, the input is valid so far but ends in the
+    middle of a value. Reading can continue when more data is available.
+
+    \sa readNext(), hasError()
+*/
+bool QJsonStreamReader::atEnd() const
+{
+    return d->type == EndDocument || d->error != NoError;
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    If error() is PrematureEndOfDocumentError, the reader tries to read
+    the token that was incomplete again, with the data that has arrived
+    since. For other errors, the reader does not continue and returns
+    \l Invalid.
+
+    \sa tokenType(), atEnd()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    if (d->error != NoError) {
+        if (d->error != PrematureEndOfDocumentError)
+            return d->type = Invalid;
+        d->error = NoError;
+        d->errorString.clear();
+    }
+
+    for (;;) {
+        const int result = d->parseToken();
+        if (result == Invalid)
+            d->nameSize = 0;
+        if (result >= 0)
+            return d->type = TokenType(result);
+        if (d->fetchData())
+            continue;
+        if (result == QJsonStreamReaderPrivate::EndOfInput)
+            return d->type = EndDocument;
+        d->nameSize = 0;
+        d->error = PrematureEndOfDocumentError;
+        d->errorString = QCoreApplication::translate("QJsonStreamReader",
+                                                     "Premature end of document.");
+        return d->type = Invalid;
+    }
+}
+
+/*!
+    If the current token is StartArray or StartObject, reads up to and
+    including the matching EndArray or EndObject token. Returns \c true on
+    success, and \c false if an error occurred or the input ended first.
+    For other tokens, does nothing and returns \c true.
+*/
+bool QJsonStreamReader::skipCurrentValue()
+{
+    if (d->type != StartArray && d->type != StartObject)
+        return true;
+    const int depth = d->containers.size() - 1;
+    for (;;) {
+        switch (readNext()) {
+        case EndArray:
+        case EndObject:
+            if (d->containers.size() == depth)
+                return true;
+            break;
+        case Invalid:
+        case EndDocument:
+            return false;
+        default:
+            break;
+        }
+    }
+}
+
+/*!
+    Returns the type of the current token.
+
+    \sa readNext(), tokenString()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+{
+    return d->type;
+}
+
+/*!
+    Returns the name of the current token type, for example "StartObject".
+
+    \sa tokenType()
+*/
+QString QJsonStreamReader::tokenString() const
+{
+    static const char names[][12] = {
+        "NoToken", "Invalid", "EndDocument", "StartArray", "EndArray", "StartObject",
+        "EndObject", "String", "Number", "Bool", "Null"
+    };
+    return QLatin1String(names[d->type]);
+}
+
+/*!
+    Returns the number of arrays and objects that enclose the next token.
+    After a StartArray or StartObject token, that includes the new array
+    or object; after an EndArray or EndObject token, it does not.
+*/
+int QJsonStreamReader::depth() const
+{
+    return d->containers.size();
+}
+
+/*!
+    Returns the number of bytes of input that have been read, up to the
+    end of the current token. If the input is not well-formed, returns the
+    offset of the error instead.
+*/
+qint64 QJsonStreamReader::characterOffset() const
+{
+    return d->bufferOffset + d->position;
+}
+
+/*!
+    Returns the name of the object member that the current token is the
+    value of. For values that are not members of an object, and for the
+    EndArray and EndObject tokens, returns an empty view.
+
+    The view is only valid until the next call to readNext().
+
+    \sa text()
+*/
+QStringView QJsonStreamReader::name() const
+{
+    return QStringView(d->nameBuffer.constData(), d->nameSize);
+}
+
+/*!
+    Returns the decoded string if the current token is a \l String.
+    Otherwise returns an empty view.
+
+    The view is only valid until the next call to readNext().
+
+    \sa name(), value()
+*/
+QStringView QJsonStreamReader::text() const
+{
+    if (d->type != String)
+        return QStringView();
+    return QStringView(d->textBuffer.constData(), d->textSize);
+}
+
+/*!
+    Returns the value of the current token if it is a \l Bool, and \c false
+    otherwise.
+*/
+bool QJsonStreamReader::toBool() const
+{
+    return d->type == Bool && d->boolean;
+}
+
+/*!
+    Returns the value of the current token if it is a \l Number, and 0
+    otherwise.
+
+    \sa toInteger()
+*/
+double QJsonStreamReader::toDouble() const
+{
+    return d->type == Number ? d->number : 0;
+}
+
+/*!
+    Returns the value of the current token if it is a \l Number with an
+    integral value that a qint64 can hold. Otherwise returns
+    \a defaultValue.
+
+    Integers written without a fraction or exponent are read exactly, even
+    if a double cannot represent them.
+
+    \sa toUnsignedInteger(), toDouble()
+*/
+qint64 QJsonStreamReader::toInteger(qint64 defaultValue) const
+{
+    if (d->type != Number)
+        return defaultValue;
+    if (d->isInteger) {
+        const quint64 max = quint64(std::numeric_limits<qint64>::max());
+        if (d->isNegative && d->integer <= max + 1)
+            return qint64(0 - d->integer);
+        if (!d->isNegative && d->integer <= max)
+            return qint64(d->integer);
+        return defaultValue;
+    }
+    qint64 i;
+    if (convertDoubleTo(d->number, &i))
+        return i;
+    return defaultValue;
+}
+
+/*!
+    Returns the value of the current token if it is a \l Number with a
+    non-negative integral value that a quint64 can hold. Otherwise returns
+    \a defaultValue.
+
+    Like toInteger(), this function reads integers written without a
+    fraction or exponent exactly, including those between 2\sup{63} and
+    2\sup{64}.
+
+    \sa toInteger(), toDouble()
+*/
+quint64 QJsonStreamReader::toUnsignedInteger(quint64 defaultValue) const
+{
+    if (d->type != Number)
+        return defaultValue;
+    if (d->isInteger)
+        return d->isNegative && d->integer ? defaultValue : d->integer;
+    quint64 u;
+    if (d->number >= 0 && convertDoubleTo(d->number, &u))
+        return u;
+    return defaultValue;
+}
+
+/*!
+    Returns the current token as a QJsonValue if it is a \l String,
+    \l Number, \l Bool or \l Null. Otherwise returns an undefined value.
+*/
+QJsonValue QJsonStreamReader::value() const
+{
+    switch (d->type) {
+    case String:
+        return QJsonValue(text().toString());
+    case Number:
+        return QJsonValue(d->number);
+    case Bool:
+        return QJsonValue(d->boolean);
+    case Null:
+        return QJsonValue(QJsonValue::Null);
+    default:
+        return QJsonValue(QJsonValue::Undefined);
+    }
+}
+
+/*!
+    Raises a custom error with the given \a message. The reader returns
+    \l Invalid from then on, until clear() is called.
+
+    \sa error(), errorString()
+*/
+void QJsonStreamReader::raiseError(const QString &message)
+{
+    d->error = CustomError;
+    d->errorString = message;
+    d->type = Invalid;
+}
+
+/*!
+    Returns the message of the error that occurred, or an empty string if
+    there is none.
+
+    \sa error(), raiseError()
+*/
+QString QJsonStreamReader::errorString() const
+{
+    return d->errorString;
+}
+
+/*!
+    Returns the type of the error that occurred, or NoError.
+
+    \sa errorString(), hasError()
+*/
+QJsonStreamReader::Error QJsonStreamReader::error() const
+{
+    return d->error;
+}
+
+/*!
+    \fn bool QJsonStreamReader::hasError() const
+
+    Returns \c true if an error has occurred, otherwise \c false.
+
+    \sa error(), errorString()
+*/
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.0
+
+    \brief The QJsonStreamWriter class writes JSON text to a QByteArray or
+    QIODevice, one value at a time.
+
+    QJsonDocument::toJson() needs the complete document in memory before it
+    can write it. QJsonStreamWriter writes each value as soon as it is
+    appended, similar to QCborStreamWriter. Arrays and objects are started
+    with startArray() and startObject() and must be terminated by the
+    corresponding endArray() and endObject() calls.
+
+    Inside an object, the member names and values are appended in turn:
+    a string that is appended where a name is expected becomes the name of
+    the next member.
+
+    \snippet code/src_corelib_serialization_qjsonstream.cpp 1
+
+    Each complete top-level value is followed by a line break, so writing
+    several values produces JSON Lines. When writing to a device, the
+    writer collects the text in a buffer, and writes it to the device at
+    the end of each top-level value, whenever the buffer grows large, and
+    when flush() is called or the writer is destroyed.
+
+    Numbers are written like QJsonDocument::toJson() does. Infinities and
+    NaN have no representation in JSON and are written as \c null.
+
+    \sa QJsonStreamReader, QJsonDocument, QCborStreamWriter
+*/
+
+class QJsonStreamWriterPrivate
+{
+public:
+    enum { FlushThreshold = 16 * 1024 };
+
+    QByteArray &output() { return device ? buffer : *data; }
+    bool startValue();
+    void finishValue();
+    void newLine(int depth);
+    void writeString(QStringView str);
+    void writeString(QLatin1String str);
+    template <typename String> void appendString(String str);
+    void writeInteger(quint64 value, bool negative);
+
+    QIODevice *device = nullptr;
+    QByteArray *data = nullptr;
+    QByteArray buffer;
+    QVarLengthArray<ContainerState, 32> containers;
+    bool autoFormatting = false;
+};
+
+// Writes what goes between the previous value and the next one. Returns
+// false if a member name is expected instead.
+bool QJsonStreamWriterPrivate::startValue()
+{
+    if (containers.isEmpty())
+        return true;
+    ContainerState &state = containers.last();
+    switch (state) {
+    case ArrayValue:
+        output() += ',';
+        Q_FALLTHROUGH();
+    case ArrayStart:
+        state = ArrayValue;
+        newLine(containers.size());
+        return true;
+    case ObjectKey:
+        state = ObjectValue;
+        return true;
+    case ObjectStart:
+    case ObjectValue:
+        break;
+    }
+    qWarning("QJsonStreamWriter: an object member needs a name first");
+    return false;
+}
+
+void QJsonStreamWriterPrivate::finishValue()
+{
+    if (containers.isEmpty()) {
+        output() += '\n';
+        if (device) {
+            device->write(buffer.constData(), buffer.size());
+            buffer.resize(0);
+        }
+    } else if (device && buffer.size() >= FlushThreshold) {
+        device->write(buffer.constData(), buffer.size());
+        buffer.resize(0);
+    }
+}
+
+void QJsonStreamWriterPrivate::newLine(int depth)
+{
+    if (!autoFormatting)
+        return;
+    QByteArray &out = output();
+    out += '\n';
+    out.append(4 * depth, ' ');
+}
+
+static inline char hexDigit(uint u)
+{
+    return char(u < 0xa ? '0' + u : 'a' + u - 0xa);
+}
+
+void QJsonStreamWriterPrivate::writeString(QStringView str)
+{
+    QByteArray &out = output();
+    out += '"';
+    QJsonPrivate::Writer::appendEscapedString(out, str);
+    out += '"';
+}
+
+void QJsonStreamWriterPrivate::writeString(QLatin1String str)
+{
+    QByteArray &out = output();
+    int pos = out.size();
+    // at most six characters for each one, plus the quotes
+    out.resize(pos + 6 * str.size() + 2);
+    char *cursor = out.data() + pos;
+    *cursor++ = '"';
+    for (const char c : str) {
+        const uchar u = uchar(c);
+        if (u >= 0x80) {
+            *cursor++ = char(0xc0 | (u >> 6));
+            *cursor++ = char(0x80 | (u & 0x3f));
+        } else if (u < 0x20 || u == '"' || u == '\\') {
+            *cursor++ = '\\';
+            switch (u) {
+            case '"':  *cursor++ = '"'; break;
+            case '\\': *cursor++ = '\\'; break;
+            case 0x8:  *cursor++ = 'b'; break;
+            case 0xc:  *cursor++ = 'f'; break;
+            case 0xa:  *cursor++ = 'n'; break;
+            case 0xd:  *cursor++ = 'r'; break;
+            case 0x9:  *cursor++ = 't'; break;
+            default:
+                *cursor++ = 'u';
+                *cursor++ = '0';
+                *cursor++ = '0';
+                *cursor++ = hexDigit(u >> 4);
+                *cursor++ = hexDigit(u & 0xf);
+            }
+        } else {
+            *cursor++ = c;
+        }
+    }
+    *cursor++ = '"';
+    out.resize(int(cursor - out.constData()));
+}
+
+template <typename String> void QJsonStreamWriterPrivate::appendString(String str)
+{
+    if (!containers.isEmpty()
+            && (containers.last() == ObjectStart || containers.last() == ObjectValue)) {
+        // the name of the next member
+        if (containers.last() == ObjectValue)
+            output() += ',';
+        newLine(containers.size());
+        writeString(str);
+        output() += autoFormatting ? ": " : ":";
+        containers.last() = ObjectKey;
+        return;
+    }
+    if (!startValue())
+        return;
+    writeString(str);
+    finishValue();
+}
+
+void QJsonStreamWriterPrivate::writeInteger(quint64 value, bool negative)
+{
+    char digits[24];
+    char *p = digits + sizeof(digits);
+    do {
+        *--p = char('0' + value % 10);
+        value /= 10;
+    } while (value);
+    if (negative)
+        *--p = '-';
+    output().append(p, int(digits + sizeof(digits) - p));
+}
+
+/*!
+    Constructs a stream writer that writes to \a device. The device must be
+    open for writing.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : d(new QJsonStreamWriterPrivate)
+{
+    d->buffer.reserve(QJsonStreamWriterPrivate::FlushThreshold + 1024);
+    d->device = device;
+}
+
+/*!
+    Constructs a stream writer that appends to \a data.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *data)
+    : d(new QJsonStreamWriterPrivate)
+{
+    d->data = data;
+}
+
+/*!
+    Destroys the stream writer, and writes any buffered text to the device.
+    Arrays and objects that have not been ended are left incomplete.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+    flush();
+}
+
+/*!
+    Writes any buffered text to the current device, and replaces the
+    device with \a device.
+
+    \sa device()
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    flush();
+    d->device = device;
+    d->data = nullptr;
+}
+
+/*!
+    Returns the device the writer writes to, or \nullptr if it writes to a
+    QByteArray.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    return d->device;
+}
+
+/*!
+    Enables indentation if \a enable is \c true. The writer then puts each
+    array element and object member on its own line, indented by four
+    spaces for each level, as QJsonDocument::Indented does.
+
+    \sa autoFormatting()
+*/
+void QJsonStreamWriter::setAutoFormatting(bool enable)
+{
+    d->autoFormatting = enable;
+}
+
+/*!
+    Returns \c true if the writer indents its output.
+
+    \sa setAutoFormatting()
+*/
+bool QJsonStreamWriter::autoFormatting() const
+{
+    return d->autoFormatting;
+}
+
+/*!
+    Appends the string \a str. Inside an object, where a member name is
+    expected, \a str becomes the name of the next member.
+*/
+void QJsonStreamWriter::append(QStringView str)
+{
+    d->appendString(str);
+}
+
+/*!
+    \overload
+*/
+void QJsonStreamWriter::append(QLatin1String str)
+{
+    d->appendString(str);
+}
+
+/*!
+    Appends the integer \a i. Unlike QJsonValue, the writer does not
+    convert it to a double first, so all of its digits are kept.
+*/
+void QJsonStreamWriter::append(qint64 i)
+{
+    if (!d->startValue())
+        return;
+    d->writeInteger(i < 0 ? 0 - quint64(i) : quint64(i), i < 0);
+    d->finishValue();
+}
+
+/*!
+    \overload
+*/
+void QJsonStreamWriter::append(quint64 u)
+{
+    if (!d->startValue())
+        return;
+    d->writeInteger(u, false);
+    d->finishValue();
+}
+
+/*!
+    Appends the number \a n, with as many digits as needed to read back the
+    same value. Infinities and NaN are written as \c null.
+*/
+void QJsonStreamWriter::append(double n)
+{
+    if (!d->startValue())
+        return;
+    QByteArray &out = d->output();
+    if (qIsFinite(n)) {
+        quint64 absInt;
+        const QLocaleData::DoubleForm form = convertDoubleTo(std::abs(n), &absInt)
+                ? QLocaleData::DFDecimal : QLocaleData::DFSignificantDigits;
+        char buf[CLocaleDoubleBufferSize];
+        const int length = qt_doubleToCLocaleAscii(n, form, QLocale::FloatingPointShortest, -1,
+                                                   QLocaleData::ZeroPadExponent, buf);
+        Q_ASSERT(length > 0);
+        out.append(buf, length);
+    } else {
+        out += "null";
+    }
+    d->finishValue();
+}
+
+/*!
+    Appends \c true or \c false, depending on \a b.
+*/
+void QJsonStreamWriter::append(bool b)
+{
+    if (!d->startValue())
+        return;
+    d->output() += b ? "true" : "false";
+    d->finishValue();
+}
+
+/*!
+    \fn void QJsonStreamWriter::append(std::nullptr_t)
+    \overload
+
+    Appends \c null.
+*/
+
+/*!
+    Appends \c null.
+*/
+void QJsonStreamWriter::appendNull()
+{
+    if (!d->startValue())
+        return;
+    d->output() += "null";
+    d->finishValue();
+}
+
+/*!
+    Appends \a value, including all elements of arrays and all members of
+    objects. Undefined values are written as \c null.
+*/
+void QJsonStreamWriter::append(const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::Bool:
+        append(value.toBool());
+        break;
+    case QJsonValue::Double:
+        append(value.toDouble());
+        break;
+    case QJsonValue::String:
+        append(value.toString());
+        break;
+    case QJsonValue::Array: {
+        startArray();
+        const QJsonArray array = value.toArray();
+        for (const QJsonValue &element : array)
+            append(element);
+        endArray();
+        break;
+    }
+    case QJsonValue::Object: {
+        startObject();
+        const QJsonObject object = value.toObject();
+        for (auto it = object.constBegin(), end = object.constEnd(); it != end; ++it) {
+            append(it.key());
+            append(it.value());
+        }
+        endObject();
+        break;
+    }
+    case QJsonValue::Null:
+    case QJsonValue::Undefined:
+        appendNull();
+        break;
+    }
+}
+
+/*!
+    Starts an array. Append its elements, then call endArray().
+*/
+void QJsonStreamWriter::startArray()
+{
+    if (!d->startValue())
+        return;
+    d->output() += '[';
+    d->containers.append(ArrayStart);
+}
+
+/*!
+    Ends the array started last. Returns \c false if the innermost open
+    container is not an array, and \c true otherwise.
+*/
+bool QJsonStreamWriter::endArray()
+{
+    if (d->containers.isEmpty()
+            || (d->containers.last() != ArrayStart && d->containers.last() != ArrayValue)) {
+        qWarning("QJsonStreamWriter: endArray() without an array");
+        return false;
+    }
+    const bool empty = d->containers.last() == ArrayStart;
+    d->containers.removeLast();
+    if (!empty)
+        d->newLine(d->containers.size());
+    d->output() += ']';
+    d->finishValue();
+    return true;
+}
+
+/*!
+    Starts an object. Append the name and the value of each member in turn,
+    then call endObject().
+*/
+void QJsonStreamWriter::startObject()
+{
+    if (!d->startValue())
+        return;
+    d->output() += '{';
+    d->containers.append(ObjectStart);
+}
+
+/*!
+    Ends the object started last. Returns \c false if the innermost open
+    container is not an object, or if the last member has a name but no
+    value; that member is then given the value \c null. Otherwise returns
+    \c true.
+*/
+bool QJsonStreamWriter::endObject()
+{
+    if (d->containers.isEmpty() || d->containers.last() == ArrayStart
+            || d->containers.last() == ArrayValue) {
+        qWarning("QJsonStreamWriter: endObject() without an object");
+        return false;
+    }
+    bool complete = true;
+    if (d->containers.last() == ObjectKey) {
+        d->output() += "null";
+        complete = false;
+    }
+    const bool empty = d->containers.last() == ObjectStart;
+    d->containers.removeLast();
+    if (!empty)
+        d->newLine(d->containers.size());
+    d->output() += '}';
+    d->finishValue();
+    return complete;
+}
+
+/*!
+    Writes any buffered text to the device. This is only needed to write
+    a value that is not complete yet; complete top-level values are written
+    immediately.
+*/
+void QJsonStreamWriter::flush()
+{
+    if (d->device && !d->buffer.isEmpty()) {
+        d->device->write(d->buffer.constData(), d->buffer.size());
+        d->buffer.resize(0);
+    }
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qjsonstream.cpp"
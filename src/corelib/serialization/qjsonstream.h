@@ -0,0 +1,184 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QJSONSTREAM_H
+#define QJSONSTREAM_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qjsonvalue.h>
+#include <QtCore/qobjectdefs.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringview.h>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+class QJsonStreamReaderPrivate;
+class Q_CORE_EXPORT QJsonStreamReader
+{
+    Q_GADGET
+public:
+    enum TokenType {
+        NoToken = 0,
+        Invalid,
+        EndDocument,
+        StartArray,
+        EndArray,
+        StartObject,
+        EndObject,
+        String,
+        Number,
+        Bool,
+        Null
+    };
+    Q_ENUM(TokenType)
+
+    enum Error {
+        NoError,
+        CustomError,
+        NotWellFormedError,
+        PrematureEndOfDocumentError
+    };
+    Q_ENUM(Error)
+
+    QJsonStreamReader();
+    explicit QJsonStreamReader(QIODevice *device);
+    explicit QJsonStreamReader(const QByteArray &data);
+    ~QJsonStreamReader();
+    Q_DISABLE_COPY(QJsonStreamReader)
+
+    void setDevice(QIODevice *device);
+    QIODevice *device() const;
+    void addData(const QByteArray &data);
+    void addData(const char *data, qsizetype len);
+    void finishData();
+    void clear();
+
+    bool atEnd() const;
+    TokenType readNext();
+    bool skipCurrentValue();
+
+    TokenType tokenType() const;
+    QString tokenString() const;
+
+    inline bool isEndDocument() const { return tokenType() == EndDocument; }
+    inline bool isStartArray() const { return tokenType() == StartArray; }
+    inline bool isEndArray() const { return tokenType() == EndArray; }
+    inline bool isStartObject() const { return tokenType() == StartObject; }
+    inline bool isEndObject() const { return tokenType() == EndObject; }
+    inline bool isString() const { return tokenType() == String; }
+    inline bool isNumber() const { return tokenType() == Number; }
+    inline bool isBool() const { return tokenType() == Bool; }
+    inline bool isNull() const { return tokenType() == Null; }
+
+    int depth() const;
+    qint64 characterOffset() const;
+
+    QStringView name() const;
+    QStringView text() const;
+    bool toBool() const;
+    double toDouble() const;
+    qint64 toInteger(qint64 defaultValue = 0) const;
+    quint64 toUnsignedInteger(quint64 defaultValue = 0) const;
+    QJsonValue value() const;
+
+    void raiseError(const QString &message = QString());
+    QString errorString() const;
+    Error error() const;
+
+    inline bool hasError() const
+    {
+        return error() != NoError;
+    }
+
+private:
+    QScopedPointer<QJsonStreamReaderPrivate> d;
+};
+
+class QJsonStreamWriterPrivate;
+class Q_CORE_EXPORT QJsonStreamWriter
+{
+public:
+    explicit QJsonStreamWriter(QIODevice *device);
+    explicit QJsonStreamWriter(QByteArray *data);
+    ~QJsonStreamWriter();
+    Q_DISABLE_COPY(QJsonStreamWriter)
+
+    void setDevice(QIODevice *device);
+    QIODevice *device() const;
+
+    void setAutoFormatting(bool enable);
+    bool autoFormatting() const;
+
+    void append(QStringView str);
+    void append(QLatin1String str);
+    void append(qint64 i);
+    void append(quint64 u);
+    void append(double n);
+    void append(bool b);
+    void append(std::nullptr_t) { appendNull(); }
+    void append(const QJsonValue &value);
+    void appendNull();
+
+#ifndef Q_QDOC
+    // overloads to make normal code not complain
+    void append(const QString &str) { append(QStringView(str)); }
+    void append(int i)      { append(qint64(i)); }
+    void append(uint u)     { append(quint64(u)); }
+#ifndef QT_NO_CAST_FROM_ASCII
+    QT_ASCII_CAST_WARN void append(const char *str) { append(QString::fromUtf8(str)); }
+#endif
+#endif
+
+    void startArray();
+    bool endArray();
+    void startObject();
+    bool endObject();
+
+    void flush();
+
+private:
+    QScopedPointer<QJsonStreamWriterPrivate> d;
+};
+
+QT_END_NAMESPACE
+
+#endif // QJSONSTREAM_H
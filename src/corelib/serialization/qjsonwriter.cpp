@@ -57,14 +57,15 @@ static inline uchar hexdig(uint u)
     return (u < 0xa ? '0' + u : 'a' + u - 0xa);
 }
 
-static QByteArray escapedString(const QString &s)
+void Writer::appendEscapedString(QByteArray &ba, QStringView s)
 {
-    QByteArray ba(s.length(), Qt::Uninitialized);
+    const int start = ba.size();
+    ba.resize(start + int(s.size()) + 6);
 
-    uchar *cursor = reinterpret_cast<uchar *>(const_cast<char *>(ba.constData()));
-    const uchar *ba_end = cursor + ba.length();
-    const ushort *src = reinterpret_cast<const ushort *>(s.constBegin());
-    const ushort *const end = reinterpret_cast<const ushort *>(s.constEnd());
+    uchar *cursor = reinterpret_cast<uchar *>(ba.data()) + start;
+    const uchar *ba_end = reinterpret_cast<const uchar *>(ba.constData()) + ba.length();
+    const ushort *src = reinterpret_cast<const ushort *>(s.data());
+    const ushort *const end = src + s.size();
 
     while (src != end) {
         if (cursor >= ba_end - 6) {
@@ -123,7 +124,6 @@ static QByteArray escapedString(const QString &s)
     }
 
     ba.resize(cursor - (const uchar *)ba.constData());
-    return ba;
 }
 
 static void valueToJson(const QJsonPrivate::Base *b, const QJsonPrivate::Value &v, QByteArray &json, int indent, bool compact)
@@ -146,7 +146,7 @@ static void valueToJson(const QJsonPrivate::Base *b, const QJsonPrivate::Value &
     }
     case QJsonValue::String:
         json += '"';
-        json += escapedString(v.toString(b));
+        Writer::appendEscapedString(json, v.toString(b));
         json += '"';
         break;
     case QJsonValue::Array:
@@ -202,7 +202,7 @@ static void objectContentToJson(const QJsonPrivate::Object *o, QByteArray &json,
         QJsonPrivate::Entry *e = o->entryAt(i);
         json += indentString;
         json += '"';
-        json += escapedString(e->key());
+        Writer::appendEscapedString(json, e->key());
         json += compact ? "\":" : "\": ";
         valueToJson(o, e->value, json, indent, compact);
 
@@ -2066,7 +2066,10 @@ bool QTextStreamPrivate::getReal(double *f)
         return true;
     }
     bool ok;
-    *f = locale.toDouble(QString::fromLatin1(buf), &ok);
+    if (locale == QLocale::c()) // buf already holds the number in the C locale
+        *f = QLocaleData::bytearrayToDouble(buf, &ok);
+    else
+        *f = locale.toDouble(QString::fromLatin1(buf), &ok);
     return ok;
 }
 
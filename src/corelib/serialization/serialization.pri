@@ -8,13 +8,16 @@ HEADERS += \
     serialization/qcborvalue_p.h \
     serialization/qdatastream.h \
     serialization/qdatastream_p.h \
+    serialization/qgadgetserializer.h \
     serialization/qjson_p.h \
     serialization/qjsondocument.h \
     serialization/qjsonobject.h \
     serialization/qjsonvalue.h \
     serialization/qjsonarray.h \
+    serialization/qjsonstream.h \
     serialization/qjsonwriter_p.h \
     serialization/qjsonparser_p.h \
+    serialization/qjsonparser_simd_p.h \
     serialization/qtextstream.h \
     serialization/qtextstream_p.h \
     serialization/qxmlstream.h \
@@ -25,18 +28,22 @@ SOURCES += \
     serialization/qcbordiagnostic.cpp \
     serialization/qcborvalue.cpp \
     serialization/qdatastream.cpp \
+    serialization/qgadgetserializer.cpp \
     serialization/qjson.cpp \
     serialization/qjsoncbor.cpp \
     serialization/qjsondocument.cpp \
     serialization/qjsonobject.cpp \
     serialization/qjsonarray.cpp \
     serialization/qjsonvalue.cpp \
+    serialization/qjsonstream.cpp \
     serialization/qjsonwriter.cpp \
     serialization/qjsonparser.cpp \
     serialization/qtextstream.cpp \
     serialization/qxmlstream.cpp \
     serialization/qxmlutils.cpp
 
+AVX2_SOURCES += serialization/qjsonparser_avx2.cpp
+
 qtConfig(cborstream): {
     SOURCES += \
         serialization/qcborstream.cpp
@@ -0,0 +1,426 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QAHOCORASICK_P_H
+#define QAHOCORASICK_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qvector.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+// An Aho-Corasick automaton over code units of type Char, which finds all
+// occurrences of a set of patterns in one pass over a text.
+//
+// The goto and failure functions are merged into a complete transition
+// table. To keep it small, the table is indexed by character classes: every
+// character that occurs in a pattern has its own class, and all other
+// characters share class 0, which leads back to the root. If a fold
+// function is given, patterns and text are compared after folding.
+template <typename Char>
+class QAhoCorasick
+{
+public:
+    typedef Char (*Fold)(Char);
+
+    QAhoCorasick() { build(QVector<QVector<Char>>(), nullptr); }
+
+    // Empty patterns never match.
+    void build(const QVector<QVector<Char>> &patterns, Fold fold)
+    {
+        foldChar = fold;
+        lengths.clear();
+        lengths.reserve(patterns.size());
+        QVector<QVector<Char>> folded = patterns;
+        qsizetype totalLength = 0;
+        for (QVector<Char> &chars : folded) {
+            if (foldChar)
+                std::transform(chars.begin(), chars.end(), chars.begin(), foldChar);
+            totalLength += chars.size();
+            lengths.append(chars.size());
+        }
+        maxLength = lengths.isEmpty() ? 0 : *std::max_element(lengths.cbegin(), lengths.cend());
+
+        buildClasses(folded);
+
+        // There are at most totalLength + 1 states. If their table would be
+        // too large, keep only the edges of the trie and follow the failure
+        // links while scanning.
+        sparse = totalLength + 1 > MaxTableSize / classCount;
+        if (sparse)
+            buildSparse(folded);
+        else
+            buildTable(folded, totalLength);
+    }
+
+    // Calls onMatch(position, pattern) for every occurrence in text at or
+    // after from, in the order in which the occurrences end, the longer
+    // patterns first. Stops when onMatch returns false.
+    template <typename OnMatch>
+    void scan(const Char *text, qsizetype length, qsizetype from, OnMatch onMatch) const
+    {
+        if (sparse)
+            scanWith(text, length, from, onMatch,
+                     [this](int state, int c) { return sparseNext(state, c); });
+        else
+            scanWith(text, length, from, onMatch,
+                     [this](int state, int c) { return tableNext(state, c); });
+    }
+
+    // Returns the position of the leftmost occurrence at or after from, or
+    // -1. If several patterns occur there, *pattern receives the longest of
+    // them, and the one with the lowest index of identical ones.
+    qsizetype indexIn(const Char *text, qsizetype length, qsizetype from, int *pattern) const
+    {
+        if (sparse) {
+            return indexInWith(text, length, from, pattern,
+                               [this](int state, int c) { return sparseNext(state, c); });
+        }
+        return indexInWith(text, length, from, pattern,
+                           [this](int state, int c) { return tableNext(state, c); });
+    }
+
+    qsizetype patternLength(int pattern) const { return lengths.at(pattern); }
+
+private:
+    // the largest transition table, in entries, before the sparse layout is used
+    enum : qsizetype { MaxTableSize = 1 << 20 };
+
+    struct Edge
+    {
+        int charClass;
+        int next;
+    };
+    static bool lessClass(const Edge &edge, int charClass) { return edge.charClass < charClass; }
+
+    void buildTable(const QVector<QVector<Char>> &folded, qsizetype totalLength)
+    {
+        edgeBegin.clear();
+        edges.clear();
+        failure.clear();
+
+        // the trie, with -1 for missing edges
+        transitions.fill(-1, classCount);
+        outputs.fill(-1, 1);
+        nextSame.fill(-1, folded.size());
+        transitions.reserve(int((totalLength + 1) * classCount));
+        for (int i = 0; i < folded.size(); ++i) {
+            if (folded.at(i).isEmpty())
+                continue;
+            int state = 0;
+            for (Char c : folded.at(i)) {
+                const int next = transitions.at(state * classCount + classOf(c));
+                if (next >= 0) {
+                    state = next;
+                    continue;
+                }
+                const int added = outputs.size();
+                transitions[state * classCount + classOf(c)] = added;
+                transitions.resize(transitions.size() + classCount);
+                std::fill(transitions.end() - classCount, transitions.end(), -1);
+                outputs.append(-1);
+                state = added;
+            }
+            addOutput(state, i);
+        }
+
+        // breadth first, so that the failure state of every state is
+        // complete before the state itself
+        const int stateCount = outputs.size();
+        QVector<int> failureOf(stateCount, 0);
+        reports.fill(-1, stateCount);
+        nextReports.fill(-1, stateCount);
+        QVector<int> queue;
+        queue.reserve(stateCount);
+        int *row = transitions.data();
+        for (int c = 0; c < classCount; ++c) {
+            if (row[c] < 0) {
+                row[c] = 0;
+            } else {
+                queue.append(row[c]);
+                reports[row[c]] = outputs.at(row[c]) >= 0 ? row[c] : -1;
+            }
+        }
+        for (int head = 0; head < queue.size(); ++head) {
+            const int state = queue.at(head);
+            const int *failureRow = transitions.constData() + failureOf.at(state) * classCount;
+            row = transitions.data() + state * classCount;
+            for (int c = 0; c < classCount; ++c) {
+                const int next = row[c];
+                if (next < 0) {
+                    row[c] = failureRow[c];
+                    continue;
+                }
+                failureOf[next] = failureRow[c];
+                nextReports[next] = reports.at(failureOf.at(next));
+                reports[next] = outputs.at(next) >= 0 ? next : nextReports.at(next);
+                queue.append(next);
+            }
+        }
+        transitions.squeeze();
+    }
+
+    // The edges of state s are edges[edgeBegin[s]] to edges[edgeBegin[s + 1]],
+    // sorted by class.
+    void buildSparse(const QVector<QVector<Char>> &folded)
+    {
+        transitions.clear();
+
+        QVector<QVector<Edge>> children(1);
+        outputs.fill(-1, 1);
+        nextSame.fill(-1, folded.size());
+        for (int i = 0; i < folded.size(); ++i) {
+            if (folded.at(i).isEmpty())
+                continue;
+            int state = 0;
+            for (Char c : folded.at(i)) {
+                const int charClass = classOf(c);
+                QVector<Edge> &stateEdges = children[state];
+                const auto it = std::lower_bound(stateEdges.begin(), stateEdges.end(), charClass,
+                                                 lessClass);
+                if (it != stateEdges.end() && it->charClass == charClass) {
+                    state = it->next;
+                    continue;
+                }
+                const int added = outputs.size();
+                stateEdges.insert(it, Edge{ charClass, added });
+                children.append(QVector<Edge>());
+                outputs.append(-1);
+                state = added;
+            }
+            addOutput(state, i);
+        }
+
+        const int stateCount = outputs.size();
+        edgeBegin.resize(stateCount + 1);
+        edges.clear();
+        edges.reserve(stateCount - 1);
+        for (int state = 0; state < stateCount; ++state) {
+            edgeBegin[state] = edges.size();
+            edges += children.at(state);
+        }
+        edgeBegin[stateCount] = edges.size();
+        children = QVector<QVector<Edge>>();
+
+        // breadth first, as in buildTable()
+        failure.fill(0, stateCount);
+        reports.fill(-1, stateCount);
+        nextReports.fill(-1, stateCount);
+        QVector<int> queue;
+        queue.reserve(stateCount);
+        for (int e = edgeBegin.at(0); e < edgeBegin.at(1); ++e) {
+            const int next = edges.at(e).next;
+            queue.append(next);
+            reports[next] = outputs.at(next) >= 0 ? next : -1;
+        }
+        for (int head = 0; head < queue.size(); ++head) {
+            const int state = queue.at(head);
+            for (int e = edgeBegin.at(state); e < edgeBegin.at(state + 1); ++e) {
+                const int next = edges.at(e).next;
+                failure[next] = sparseNext(failure.at(state), edges.at(e).charClass);
+                nextReports[next] = reports.at(failure.at(next));
+                reports[next] = outputs.at(next) >= 0 ? next : nextReports.at(next);
+                queue.append(next);
+            }
+        }
+    }
+
+    // keeps identical patterns in order of their index
+    void addOutput(int state, int pattern)
+    {
+        int *slot = &outputs[state];
+        while (*slot >= 0)
+            slot = &nextSame[*slot];
+        *slot = pattern;
+    }
+
+    int tableNext(int state, int charClass) const
+    {
+        return transitions.constData()[state * classCount + charClass];
+    }
+
+    int sparseNext(int state, int charClass) const
+    {
+        if (charClass == 0)
+            return 0;
+        const Edge *begin = edges.constData();
+        for (;;) {
+            const Edge *first = begin + edgeBegin.at(state);
+            const Edge *last = begin + edgeBegin.at(state + 1);
+            const Edge *it = std::lower_bound(first, last, charClass, lessClass);
+            if (it != last && it->charClass == charClass)
+                return it->next;
+            if (state == 0)
+                return 0;
+            state = failure.at(state);
+        }
+    }
+
+    template <typename OnMatch, typename Next>
+    void scanWith(const Char *text, qsizetype length, qsizetype from, OnMatch onMatch,
+                  Next next) const
+    {
+        const int *stateReports = reports.constData();
+        int state = 0;
+        for (qsizetype i = from; i < length; ++i) {
+            state = next(state, classOfText(text[i]));
+            for (int s = stateReports[state]; Q_UNLIKELY(s >= 0); s = nextReports.at(s)) {
+                for (int pattern = outputs.at(s); pattern >= 0; pattern = nextSame.at(pattern)) {
+                    if (!onMatch(i + 1 - lengths.at(pattern), pattern))
+                        return;
+                }
+            }
+        }
+    }
+
+    template <typename Next>
+    qsizetype indexInWith(const Char *text, qsizetype length, qsizetype from, int *pattern,
+                          Next next) const
+    {
+        qsizetype best = -1;
+        int bestPattern = -1;
+        qsizetype end = length;
+        int state = 0;
+        for (qsizetype i = from; i < end; ++i) {
+            state = next(state, classOfText(text[i]));
+            for (int s = reports.at(state); Q_UNLIKELY(s >= 0); s = nextReports.at(s)) {
+                const int p = outputs.at(s);
+                const qsizetype position = i + 1 - lengths.at(p);
+                if (best < 0 || position < best
+                        || (position == best && lengths.at(p) > lengths.at(bestPattern))) {
+                    best = position;
+                    bestPattern = p;
+                    // occurrences that end at best + maxLength or later start after best
+                    end = qMin(length, best + maxLength);
+                }
+            }
+        }
+        if (pattern)
+            *pattern = bestPattern;
+        return best;
+    }
+
+    Char foldIfNeeded(Char c) const { return foldChar ? foldChar(c) : c; }
+
+    void buildClasses(const QVector<QVector<Char>> &folded)
+    {
+        QVector<Char> symbols;
+        for (const QVector<Char> &chars : folded)
+            symbols += chars;
+        std::sort(symbols.begin(), symbols.end());
+        symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+        classCount = int(symbols.size()) + 1;
+
+        auto symbolClass = [&symbols](Char c) {
+            const auto it = std::lower_bound(symbols.cbegin(), symbols.cend(), c);
+            return it != symbols.cend() && *it == c ? int(it - symbols.cbegin()) + 1 : 0;
+        };
+        for (int c = 0; c < 256; ++c)
+            lowClasses[c] = symbolClass(foldIfNeeded(Char(c)));
+        highSymbols.clear();
+        highClasses.clear();
+        for (Char c : qAsConst(symbols)) {
+            if (uint(c) >= 256) {
+                highSymbols.append(c);
+                highClasses.append(symbolClass(c));
+            }
+        }
+    }
+
+    // For pattern characters, which are folded already. Folding is
+    // idempotent, so lowClasses holds their classes below 256 too.
+    int classOf(Char c) const
+    {
+        return uint(c) < 256 ? lowClasses[uint(c)] : highClassOf(c);
+    }
+
+    int highClassOf(Char c) const
+    {
+        const auto it = std::lower_bound(highSymbols.cbegin(), highSymbols.cend(), c);
+        if (it == highSymbols.cend() || *it != c)
+            return 0;
+        return highClasses.at(int(it - highSymbols.cbegin()));
+    }
+
+    int classOfText(Char c) const
+    {
+        if (uint(c) < 256)
+            return lowClasses[uint(c)];
+        if (highSymbols.isEmpty() && !foldChar)
+            return 0;
+        c = foldIfNeeded(c);
+        if (uint(c) < 256)
+            return lowClasses[uint(c)];
+        return highClassOf(c);
+    }
+
+    Fold foldChar = nullptr;
+    int classCount = 1;
+    bool sparse = false;
+    int lowClasses[256] = {};
+    QVector<Char> highSymbols;
+    QVector<int> highClasses;
+    QVector<int> transitions;   // classCount entries per state, unless sparse
+    QVector<int> edgeBegin;     // the trie, if sparse
+    QVector<Edge> edges;
+    QVector<int> failure;
+    QVector<int> outputs;       // first pattern that ends in a state, or -1
+    QVector<int> nextSame;      // next pattern identical to a pattern, or -1
+    QVector<int> reports;       // the state or nearest failure state with an output
+    QVector<int> nextReports;   // reports of the failure state
+    QVector<qsizetype> lengths;
+    qsizetype maxLength = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QAHOCORASICK_P_H
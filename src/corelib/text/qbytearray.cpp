@@ -4323,7 +4323,14 @@ QByteArray &QByteArray::setNum(double n, char f, int prec)
             break;
     }
 
-    *this = QLocaleData::c()->doubleToString(n, prec, form, -1, flags).toLatin1();
+    char buff[CLocaleDoubleBufferSize];
+    const int length = qt_doubleToCLocaleAscii(n, form, prec, -1, flags, buff);
+    if (length < 0) {
+        *this = QLocaleData::c()->doubleToString(n, prec, form, -1, flags).toLatin1();
+    } else {
+        clear();
+        append(buff, length);
+    }
     return *this;
 }
 
@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qbytearraymatcher.h"
+#include "qstringsearch_p.h"
 
 #include <limits.h>
 
@@ -200,6 +201,11 @@ int QByteArrayMatcher::indexIn(const QByteArray &ba, int from) const
 {
     if (from < 0)
         from = 0;
+#ifdef QT_STRING_SEARCH_SIMD
+    if (p.l >= 2 && from + int(p.l) <= ba.size())
+        return int(QtPrivate::findByteArraySimd(ba.constData(), ba.size(), from,
+                                                reinterpret_cast<const char *>(p.p), p.l));
+#endif
     return bm_find(reinterpret_cast<const uchar *>(ba.constData()), ba.size(), from,
                    p.p, p.l, p.q_skiptable);
 }
@@ -215,6 +221,11 @@ int QByteArrayMatcher::indexIn(const char *str, int len, int from) const
 {
     if (from < 0)
         from = 0;
+#ifdef QT_STRING_SEARCH_SIMD
+    if (p.l >= 2 && from + int(p.l) <= len)
+        return int(QtPrivate::findByteArraySimd(str, len, from,
+                                                reinterpret_cast<const char *>(p.p), p.l));
+#endif
     return bm_find(reinterpret_cast<const uchar *>(str), len, from,
                    p.p, p.l, p.q_skiptable);
 }
@@ -245,6 +256,7 @@ static int findChar(const char *str, int len, char ch, int from)
     return -1;
 }
 
+#ifndef QT_STRING_SEARCH_SIMD
 /*!
     \internal
  */
@@ -264,6 +276,7 @@ static int qFindByteArrayBoyerMoore(
     if (sl_minus_1 < sizeof(uint) * CHAR_BIT) \
         hashHaystack -= uint(a) << sl_minus_1; \
     hashHaystack <<= 1
+#endif // QT_STRING_SEARCH_SIMD
 
 /*!
     \internal
@@ -286,6 +299,9 @@ int qFindByteArray(
     if (sl == 1)
         return findChar(haystack0, haystackLen, needle[0], from);
 
+#ifdef QT_STRING_SEARCH_SIMD
+    return int(QtPrivate::findByteArraySimd(haystack0, haystackLen, from, needle, needleLen));
+#else
     /*
       We use the Boyer-Moore algorithm in cases where the overhead
       for the skip table should pay off, otherwise we use a simple
@@ -321,6 +337,7 @@ int qFindByteArray(
         ++haystack;
     }
     return -1;
+#endif
 }
 
 /*!
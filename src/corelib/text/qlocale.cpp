@@ -3478,6 +3478,15 @@ QString QLocaleData::doubleToString(const QChar _zero, const QChar plus, const Q
                                     double d, int precision, DoubleForm form, int width,
                                     unsigned flags)
 {
+    if (_zero == QLatin1Char('0') && plus == QLatin1Char('+') && minus == QLatin1Char('-')
+            && exponential == QLatin1Char('e') && decimal == QLatin1Char('.')) {
+        // The C locale, or one that formats like it: write the text directly
+        char buf[CLocaleDoubleBufferSize];
+        const int length = qt_doubleToCLocaleAscii(d, form, precision, width, flags, buf);
+        if (length >= 0)
+            return QString::fromLatin1(buf, length);
+    }
+
     if (precision != QLocale::FloatingPointShortest && precision < 0)
         precision = 6;
     if (width < 0)
@@ -4006,6 +4015,24 @@ bool QLocaleData::validateChars(QStringView str, NumberMode numMode, QByteArray
 double QLocaleData::stringToDouble(QStringView str, bool *ok,
                                    QLocale::NumberOptions number_options) const
 {
+    // Plain ASCII numbers mean the same in all locales that use '.' as the
+    // decimal point. Read the common ones without converting them first.
+    if (m_decimal == u'.' && !(number_options & (QLocale::RejectLeadingZeroInExponent
+                                                 | QLocale::RejectTrailingZeroesAfterDot))) {
+        const char16_t *begin = str.utf16();
+        const char16_t *end = begin + str.size();
+        while (begin != end && *begin < 128 && ascii_isspace(uchar(*begin)))
+            ++begin;
+        while (begin != end && end[-1] < 128 && ascii_isspace(uchar(end[-1])))
+            --end;
+        double d;
+        if (qt_parseCLocaleDouble(begin, end, &d)) {
+            if (ok != nullptr)
+                *ok = true;
+            return d;
+        }
+    }
+
     CharBuff buff;
     if (!numberToCLocale(str, number_options, &buff)) {
         if (ok != nullptr)
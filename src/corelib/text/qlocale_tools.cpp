@@ -41,6 +41,7 @@
 #include "qlocale_tools_p.h"
 #include "qdoublescanprint_p.h"
 #include "qlocale_p.h"
+#include "qlocale_powers_p.h"
 #include "qstring.h"
 
 #include <private/qnumeric_p.h>
@@ -51,6 +52,7 @@
 #include <limits.h>
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #if defined(Q_OS_LINUX) && !defined(__UCLIBC__)
@@ -277,6 +279,404 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, cha
         --length;
 }
 
+namespace {
+
+// The ASCII counterparts of decimalForm() and exponentForm(), for the C
+// locale. They write the result to out and return its length.
+
+static int asciiDecimalForm(char *out, const char *digits, int length, int decpt,
+                            int precision, PrecisionMode pm, bool alwaysShowDecpt)
+{
+    // leading and trailing zeroes around the digits, to reach the decimal point
+    const int leading = decpt < 0 ? -decpt : 0;
+    int total = leading + qMax(length, decpt);
+    if (decpt < 0)
+        decpt = 0;
+    if (pm == PMDecimalDigits)
+        total = qMax(total, decpt + precision);
+    else if (pm == PMSignificantDigits)
+        total = qMax(total, precision);
+
+    const auto digitAt = [=](int i) {
+        i -= leading;
+        return i >= 0 && i < length ? digits[i] : '0';
+    };
+
+    char *p = out;
+    if (decpt == 0)
+        *p++ = '0';
+    for (int i = 0; i < decpt; ++i)
+        *p++ = digitAt(i);
+    if (alwaysShowDecpt || decpt < total)
+        *p++ = '.';
+    for (int i = decpt; i < total; ++i)
+        *p++ = digitAt(i);
+    return int(p - out);
+}
+
+static int asciiExponentForm(char *out, const char *digits, int length, int decpt,
+                             int precision, PrecisionMode pm, bool alwaysShowDecpt,
+                             bool leadingZeroInExponent)
+{
+    int total = length;
+    if (pm == PMDecimalDigits)
+        total = qMax(total, precision + 1);
+    else if (pm == PMSignificantDigits)
+        total = qMax(total, precision);
+
+    char *p = out;
+    *p++ = digits[0];
+    if (alwaysShowDecpt || total > 1)
+        *p++ = '.';
+    for (int i = 1; i < total; ++i)
+        *p++ = i < length ? digits[i] : '0';
+
+    const int exp = decpt - 1;
+    *p++ = 'e';
+    *p++ = exp < 0 ? '-' : '+';
+    char expDigits[8];
+    char *e = expDigits + sizeof(expDigits);
+    for (uint n = exp < 0 ? uint(-exp) : uint(exp); n; n /= 10)
+        *--e = char('0' + n % 10);
+    while (expDigits + sizeof(expDigits) - e < (leadingZeroInExponent ? 2 : 1))
+        *--e = '0';
+    while (e != expDigits + sizeof(expDigits))
+        *p++ = *e++;
+    return int(p - out);
+}
+
+} // unnamed namespace
+
+/*!
+    \internal
+
+    Formats \a d like QLocaleData::doubleToString() does in the C locale,
+    with the same \a form, \a precision, \a width and \a flags, but writes
+    the result to \a buf as Latin-1 instead of building it up in a QString.
+    \a buf must have room for CLocaleDoubleBufferSize characters.
+
+    Returns the length of the result, or -1 if \a precision or \a width are
+    too large, or \a flags ask for thousands separators; the caller should
+    then use doubleToString().
+*/
+int qt_doubleToCLocaleAscii(double d, QLocaleData::DoubleForm form, int precision, int width,
+                            unsigned flags, char *buf)
+{
+    if (precision != QLocale::FloatingPointShortest && precision < 0)
+        precision = 6;
+    if (width < 0)
+        width = 0;
+    // This keeps the result below CLocaleDoubleBufferSize: the integer part
+    // of the largest double, the leading zeroes of the smallest one, its
+    // digits and the exponent take less than 700 characters.
+    if (precision > 99 || width > 99 || (flags & QLocaleData::ThousandsGroup))
+        return -1;
+
+    // the same buffer size as in doubleToString()
+    int digitsSize = 1;
+    if (precision == QLocale::FloatingPointShortest)
+        digitsSize += QLocaleData::DoubleMaxSignificant;
+    else if (form == QLocaleData::DFDecimal)
+        digitsSize += ((d > (1 << 19) || d < -(1 << 19)) ? QLocaleData::DoubleMaxDigitsBeforeDecimal : 6)
+                + precision;
+    else
+        digitsSize += qMax(2, precision) + 1;
+
+    char digits[QLocaleData::DoubleMaxDigitsBeforeDecimal + 128];
+    Q_ASSERT(digitsSize <= int(sizeof(digits)));
+    bool negative = false;
+    int length;
+    int decpt;
+    qt_doubleToAscii(d, form, precision, digits, digitsSize, negative, length, decpt);
+
+    char body[CLocaleDoubleBufferSize];
+    int bodyLength;
+    int padding = 0;
+    if (qt_is_inf(d) || qt_is_nan(d)) {
+        memcpy(body, digits, size_t(length));
+        bodyLength = length;
+    } else {
+        const bool alwaysShowDecpt = flags & QLocaleData::ForcePoint;
+        switch (form) {
+        case QLocaleData::DFExponent:
+            bodyLength = asciiExponentForm(body, digits, length, decpt, precision, PMDecimalDigits,
+                                           alwaysShowDecpt, flags & QLocaleData::ZeroPadExponent);
+            break;
+        case QLocaleData::DFDecimal:
+            bodyLength = asciiDecimalForm(body, digits, length, decpt, precision, PMDecimalDigits,
+                                          alwaysShowDecpt);
+            break;
+        case QLocaleData::DFSignificantDigits:
+        default: {
+            const PrecisionMode mode = (flags & QLocaleData::AddTrailingZeroes)
+                    ? PMSignificantDigits : PMChopTrailingZeros;
+
+            int cutoff = precision < 0 ? 6 : precision;
+            // Find out which representation is shorter
+            if (precision == QLocale::FloatingPointShortest && decpt > 0) {
+                cutoff = length + 4; // 'e', '+'/'-', one digit exponent
+                if (decpt <= 10)
+                    ++cutoff;
+                else
+                    cutoff += decpt > 100 ? 2 : 1;
+                if (!alwaysShowDecpt && length > decpt)
+                    ++cutoff; // decpt shown in exponent form, but not in decimal form
+            }
+
+            if (decpt != length && (decpt <= -4 || decpt > cutoff)) {
+                bodyLength = asciiExponentForm(body, digits, length, decpt, precision, mode,
+                                               alwaysShowDecpt,
+                                               flags & QLocaleData::ZeroPadExponent);
+            } else {
+                bodyLength = asciiDecimalForm(body, digits, length, decpt, precision, mode,
+                                              alwaysShowDecpt);
+            }
+            break;
+        }
+        }
+
+        if (isZero(d))
+            negative = false;
+
+        if (flags & QLocaleData::ZeroPadded && !(flags & QLocaleData::LeftAdjusted)) {
+            padding = width - bodyLength;
+            // leave space for the sign
+            if (negative
+                    || flags & QLocaleData::AlwaysShowSign
+                    || flags & QLocaleData::BlankBeforePositive)
+                --padding;
+            padding = qMax(padding, 0);
+        }
+    }
+
+    char *p = buf;
+    if (negative)
+        *p++ = '-';
+    else if (flags & QLocaleData::AlwaysShowSign)
+        *p++ = '+';
+    else if (flags & QLocaleData::BlankBeforePositive)
+        *p++ = ' ';
+    memset(p, '0', size_t(padding));
+    p += padding;
+    memcpy(p, body, size_t(bodyLength));
+    p += bodyLength;
+
+    if (flags & QLocaleData::CapitalEorX) {
+        for (char *c = buf; c != p; ++c) {
+            if (*c >= 'a' && *c <= 'z')
+                *c -= 'a' - 'A';
+        }
+    }
+    return int(p - buf);
+}
+
+namespace {
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+// Clinger's fast path: if both the decimal mantissa and the power of ten
+// are exactly representable as doubles, one multiplication or division is
+// correctly rounded. That only holds when the arithmetic is done in double
+// precision, and not in the extended precision of an x87 FPU.
+#  define QT_CLINGER_FAST_PATH
+static const double exactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#endif
+
+// Returns the high 64 bits of the product of a and b, and stores the low
+// 64 bits in *low.
+static inline quint64 multiplyFull(quint64 a, quint64 b, quint64 *low) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    *low = quint64(product);
+    return quint64(product >> 64);
+#elif defined(Q_CC_MSVC) && defined(Q_PROCESSOR_X86_64)
+    quint64 high;
+    *low = _umul128(a, b, &high);
+    return high;
+#else
+    const quint64 aLow = a & 0xffffffffU, aHigh = a >> 32;
+    const quint64 bLow = b & 0xffffffffU, bHigh = b >> 32;
+    const quint64 ll = aLow * bLow;
+    const quint64 lh = aLow * bHigh;
+    const quint64 hl = aHigh * bLow;
+    const quint64 hh = aHigh * bHigh;
+    const quint64 middle = (ll >> 32) + (lh & 0xffffffffU) + (hl & 0xffffffffU);
+    *low = (middle << 32) | (ll & 0xffffffffU);
+    return hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+#endif
+}
+
+// The algorithm by Eisel and Lemire: computes the double nearest to
+// w * 10^q from a 128-bit approximation of the power of ten. Returns false
+// in the rare cases where the approximation is not precise enough to
+// decide the rounding, and for subnormal and infinite results, which are
+// left to the general algorithm.
+static bool eiselLemire(quint64 w, int q, bool negative, double *result) noexcept
+{
+    Q_ASSERT(w);
+    if (q < QtPrivate::SmallestPowerOfFive || q > QtPrivate::LargestPowerOfFive)
+        return false;
+
+    const int leadingZeroes = int(qCountLeadingZeroBits(w));
+    w <<= leadingZeroes;
+
+    // The 55 most significant bits of the product decide the result. If the
+    // bits below them are all set, the lower half of the power of five
+    // might carry into them.
+    const quint64 *power = QtPrivate::powersOfFive128[q - QtPrivate::SmallestPowerOfFive];
+    quint64 low;
+    quint64 high = multiplyFull(w, power[0], &low);
+    if ((high & 0x1ff) == 0x1ff) {
+        quint64 secondLow;
+        const quint64 secondHigh = multiplyFull(w, power[1], &secondLow);
+        low += secondHigh;
+        if (secondHigh > low)
+            ++high;
+    }
+    if (low == ~quint64(0) && (q < -27 || q > 55))
+        return false;
+
+    const int upperBit = int(high >> 63);
+    quint64 mantissa = high >> (upperBit + 9);
+    // floor(log2(10^q)) + 63, plus the exponent bias
+    int exponent = (((152170 + 65536) * q) >> 16) + 63 + upperBit - leadingZeroes + 1023;
+    if (exponent <= 0)
+        return false;
+
+    // Exactly halfway between two doubles: round to even
+    if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1
+            && (mantissa << (upperBit + 9)) == high) {
+        mantissa &= ~quint64(1);
+    }
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (quint64(2) << 52)) {
+        mantissa = quint64(1) << 52;
+        ++exponent;
+    }
+    mantissa &= ~(quint64(1) << 52);
+    if (exponent >= 0x7ff)
+        return false;
+
+    const quint64 bits = mantissa | quint64(exponent) << 52 | quint64(negative) << 63;
+    memcpy(result, &bits, sizeof(bits));
+    return true;
+}
+
+template <typename Char>
+static inline bool isAsciiDigit(Char c) noexcept
+{
+    return uint(c - '0') < 10;
+}
+
+// Parses numbers like "-12.5e3": an optional sign, decimal digits with an
+// optional decimal point, and an optional exponent, with nothing before
+// or after them. Returns false for anything else, or if the value cannot
+// be determined quickly, so that the general algorithm can take over.
+template <typename Char>
+static bool parseDecimal(const Char *p, const Char *end, double *result) noexcept
+{
+    if (p == end)
+        return false;
+    const bool negative = *p == '-';
+    if (*p == '-' || *p == '+')
+        ++p;
+
+    // up to 19 significant digits fit into 64 bits
+    quint64 mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool sawDigit = false;
+    for (; p != end && isAsciiDigit(*p); ++p) {
+        sawDigit = true;
+        if (mantissa || *p != '0') {
+            if (++significantDigits > 19)
+                return false;
+            mantissa = mantissa * 10 + uint(*p - '0');
+        }
+    }
+    if (p != end && *p == '.') {
+        for (++p; p != end && isAsciiDigit(*p); ++p) {
+            sawDigit = true;
+            if (mantissa || *p != '0') {
+                if (++significantDigits > 19)
+                    return false;
+                mantissa = mantissa * 10 + uint(*p - '0');
+            }
+            --exponent;
+        }
+    }
+    if (!sawDigit)
+        return false;
+
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p != end && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        if (p == end || !isAsciiDigit(*p))
+            return false;
+        int value = 0;
+        for (; p != end && isAsciiDigit(*p); ++p) {
+            if (value < 100000)
+                value = value * 10 + int(*p - '0');
+        }
+        exponent += negativeExponent ? -value : value;
+    }
+    if (p != end)
+        return false;
+
+    if (!mantissa) {
+        *result = negative ? -0.0 : 0.0;
+        return true;
+    }
+#ifdef QT_CLINGER_FAST_PATH
+    if (mantissa <= (quint64(1) << 53) && exponent >= -22 && exponent <= 22) {
+        double d = double(mantissa);
+        if (exponent < 0)
+            d /= exactPowersOfTen[-exponent];
+        else
+            d *= exactPowersOfTen[exponent];
+        *result = negative ? -d : d;
+        return true;
+    }
+#endif
+    return eiselLemire(mantissa, exponent, negative, result);
+}
+
+} // unnamed namespace
+
+/*!
+    \internal
+
+    Converts the decimal number in [\a begin, \a end) to a double without
+    going through the general algorithm, and returns \c true if that is
+    possible. This is the case for the numbers that plain text formats like
+    CSV and JSON usually contain: an optional sign, up to 19 significant
+    digits with an optional decimal point, and an optional exponent, with
+    no surrounding whitespace, and a result that is neither subnormal nor
+    out of range. Returns \c false otherwise; the caller should then use
+    qt_asciiToDouble(), which also detects the errors.
+*/
+bool qt_parseCLocaleDouble(const char *begin, const char *end, double *d) noexcept
+{
+    return parseDecimal(begin, end, d);
+}
+
+/*!
+    \internal
+    \overload
+*/
+bool qt_parseCLocaleDouble(const char16_t *begin, const char16_t *end, double *d) noexcept
+{
+    return parseDecimal(begin, end, d);
+}
+
 double qt_asciiToDouble(const char *num, int numLen, bool &ok, int &processed,
                         StrayCharacterMode strayCharMode)
 {
@@ -288,6 +688,22 @@ double qt_asciiToDouble(const char *num, int numLen, bool &ok, int &processed,
 
     ok = true;
 
+    if (strayCharMode != TrailingJunkAllowed) {
+        const char *begin = num;
+        const char *end = num + numLen;
+        if (strayCharMode == WhitespacesAllowed) {
+            while (begin != end && ascii_isspace(*begin))
+                ++begin;
+            while (begin != end && ascii_isspace(end[-1]))
+                --end;
+        }
+        double d;
+        if (qt_parseCLocaleDouble(begin, end, &d)) {
+            processed = numLen;
+            return d;
+        }
+    }
+
     // We have to catch NaN before because we need NaN as marker for "garbage" in the
     // libdouble-conversion case and, in contrast to libdouble-conversion or sscanf, we don't allow
     // "-nan" or "+nan"
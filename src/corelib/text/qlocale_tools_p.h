@@ -67,6 +67,13 @@ double qt_asciiToDouble(const char *num, int numLen, bool &ok, int &processed,
 void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, char *buf, int bufSize,
                       bool &sign, int &length, int &decpt);
 
+// The C locale fast paths, see qlocale_tools.cpp
+enum { CLocaleDoubleBufferSize = 1024 };
+bool qt_parseCLocaleDouble(const char *begin, const char *end, double *d) noexcept;
+bool qt_parseCLocaleDouble(const char16_t *begin, const char16_t *end, double *d) noexcept;
+int qt_doubleToCLocaleAscii(double d, QLocaleData::DoubleForm form, int precision, int width,
+                            unsigned flags, char *buf);
+
 QString qulltoa(qulonglong l, int base, const QChar _zero);
 Q_CORE_EXPORT QString qdtoa(qreal d, int *decpt, int *sign);
 
@@ -0,0 +1,284 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmultibytearraymatcher.h"
+#include "qahocorasick_p.h"
+
+QT_BEGIN_NAMESPACE
+
+class QMultiByteArrayMatcherPrivate : public QSharedData
+{
+public:
+    QMultiByteArrayMatcherPrivate(const QByteArrayList &patterns, Qt::CaseSensitivity cs)
+        : patterns(patterns), cs(cs)
+    {
+        QVector<QVector<uchar>> bytes;
+        bytes.reserve(patterns.size());
+        for (const QByteArray &pattern : patterns) {
+            const uchar *data = reinterpret_cast<const uchar *>(pattern.constData());
+            bytes.append(QVector<uchar>(data, data + pattern.size()));
+        }
+        automaton.build(bytes, cs == Qt::CaseSensitive ? nullptr : foldCase);
+    }
+
+    // the same folding as qstrnicmp()
+    static uchar foldCase(uchar c)
+    {
+        if ((c >= 'A' && c <= 'Z') || (c >= 0xc0 && c <= 0xde && c != 0xd7))
+            return c + 0x20;
+        return c;
+    }
+
+    QByteArrayList patterns;
+    Qt::CaseSensitivity cs;
+    QAhoCorasick<uchar> automaton;
+};
+
+/*!
+    \class QMultiByteArrayMatcher
+    \inmodule QtCore
+    \since 6.0
+    \brief The QMultiByteArrayMatcher class holds a set of byte arrays
+    that can be searched for at the same time in a byte array.
+
+    \ingroup tools
+    \ingroup string-processing
+
+    Searching a text for each of many patterns with QByteArrayMatcher
+    takes one pass over the text per pattern. QMultiByteArrayMatcher
+    compiles all of its patterns into one automaton (the Aho-Corasick
+    algorithm), and finds the occurrences of all of them in a single
+    pass, whatever the number of patterns.
+
+    Create the QMultiByteArrayMatcher with the list of byte arrays you
+    want to search for. Then call matches() to get all their
+    occurrences in a byte array, or indexIn() to find the first one.
+
+    Case insensitive matchers treat the bytes as Latin-1 and ignore the
+    case of Latin-1 letters, like qstrnicmp(). Empty patterns never
+    match.
+
+    Compiling the patterns takes time and memory proportional to their
+    total length times the number of distinct characters in them, so
+    keep a matcher around rather than creating it for each search.
+
+    \sa QByteArrayMatcher, QMultiStringMatcher
+*/
+
+/*!
+    \class QMultiByteArrayMatcher::Match
+    \inmodule QtCore
+    \brief An occurrence of a pattern of a QMultiByteArrayMatcher.
+
+    \variable QMultiByteArrayMatcher::Match::position
+    \brief The position in the byte array at which the occurrence starts.
+
+    \variable QMultiByteArrayMatcher::Match::length
+    \brief The length of the occurrence.
+
+    \variable QMultiByteArrayMatcher::Match::pattern
+    \brief The index of the pattern in patterns().
+*/
+
+/*!
+    Constructs a matcher without patterns, which won't match anything.
+    Call setPatterns() to give it patterns to match.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher()
+    : d(new QMultiByteArrayMatcherPrivate(QByteArrayList(), Qt::CaseSensitive))
+{
+}
+
+/*!
+    Constructs a matcher that will search for \a patterns, with case
+    sensitivity \a cs.
+
+    Call matches() or indexIn() to perform a search.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QByteArrayList &patterns, Qt::CaseSensitivity cs)
+    : d(new QMultiByteArrayMatcherPrivate(patterns, cs))
+{
+}
+
+/*!
+    Copies the \a other matcher to this matcher.
+*/
+QMultiByteArrayMatcher::QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Destroys the matcher.
+*/
+QMultiByteArrayMatcher::~QMultiByteArrayMatcher()
+{
+}
+
+/*!
+    Assigns the \a other matcher to this matcher.
+*/
+QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(const QMultiByteArrayMatcher &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QMultiByteArrayMatcher &QMultiByteArrayMatcher::operator=(QMultiByteArrayMatcher &&other)
+
+    Move-assigns \a other to this matcher.
+*/
+
+/*!
+    \fn void QMultiByteArrayMatcher::swap(QMultiByteArrayMatcher &other)
+
+    Swaps the matcher \a other with this matcher. This operation is
+    very fast and never fails.
+*/
+
+/*!
+    Sets the byte arrays to search for to \a patterns.
+
+    \sa patterns(), setCaseSensitivity()
+*/
+void QMultiByteArrayMatcher::setPatterns(const QByteArrayList &patterns)
+{
+    d = new QMultiByteArrayMatcherPrivate(patterns, d->cs);
+}
+
+/*!
+    Returns the byte arrays that this matcher searches for.
+
+    \sa setPatterns()
+*/
+QByteArrayList QMultiByteArrayMatcher::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Sets the case sensitivity to \a cs.
+
+    \sa caseSensitivity()
+*/
+void QMultiByteArrayMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (cs != d->cs)
+        d = new QMultiByteArrayMatcherPrivate(d->patterns, cs);
+}
+
+/*!
+    Returns the case sensitivity setting for this matcher.
+
+    \sa setCaseSensitivity()
+*/
+Qt::CaseSensitivity QMultiByteArrayMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Searches the byte array \a ba from byte position \a from (default
+    0, i.e. from the first byte) for the patterns(). Returns the
+    position of the leftmost occurrence of any of them, or -1 if none
+    was found.
+
+    If \a pattern is not \nullptr, it receives the index of the
+    pattern that occurs there, or -1. If several patterns occur at the
+    same position, this is the longest one.
+
+    \sa matches()
+*/
+qsizetype QMultiByteArrayMatcher::indexIn(const QByteArray &ba, qsizetype from, int *pattern) const
+{
+    return indexIn(ba.constData(), ba.size(), from, pattern);
+}
+
+/*!
+    \overload
+
+    Searches the char string \a str, which has length \a len.
+*/
+qsizetype QMultiByteArrayMatcher::indexIn(const char *str, qsizetype len, qsizetype from,
+                                          int *pattern) const
+{
+    if (from < 0)
+        from = 0;
+    return d->automaton.indexIn(reinterpret_cast<const uchar *>(str), len, from, pattern);
+}
+
+/*!
+    Returns all occurrences of the patterns() in the byte array \a ba
+    from byte position \a from (default 0, i.e. from the first byte)
+    on, including overlapping ones.
+
+    The occurrences are sorted by the position where they end; of the
+    occurrences that end at the same position, the longer ones come
+    first.
+
+    \sa indexIn()
+*/
+QVector<QMultiByteArrayMatcher::Match> QMultiByteArrayMatcher::matches(const QByteArray &ba,
+                                                                       qsizetype from) const
+{
+    return matches(ba.constData(), ba.size(), from);
+}
+
+/*!
+    \overload
+
+    Searches the char string \a str, which has length \a len.
+*/
+QVector<QMultiByteArrayMatcher::Match> QMultiByteArrayMatcher::matches(const char *str, qsizetype len,
+                                                                       qsizetype from) const
+{
+    if (from < 0)
+        from = 0;
+    QVector<Match> result;
+    const QAhoCorasick<uchar> &automaton = d->automaton;
+    automaton.scan(reinterpret_cast<const uchar *>(str), len, from,
+                   [&](qsizetype position, int pattern) {
+        result.append({ position, automaton.patternLength(pattern), pattern });
+        return true;
+    });
+    return result;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,94 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QMULTIBYTEARRAYMATCHER_H
+#define QMULTIBYTEARRAYMATCHER_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearraylist.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+
+class QMultiByteArrayMatcherPrivate;
+
+class Q_CORE_EXPORT QMultiByteArrayMatcher
+{
+public:
+    struct Match
+    {
+        qsizetype position;
+        qsizetype length;
+        int pattern;
+    };
+
+    QMultiByteArrayMatcher();
+    explicit QMultiByteArrayMatcher(const QByteArrayList &patterns,
+                                    Qt::CaseSensitivity cs = Qt::CaseSensitive);
+    QMultiByteArrayMatcher(const QMultiByteArrayMatcher &other);
+    ~QMultiByteArrayMatcher();
+
+    QMultiByteArrayMatcher &operator=(const QMultiByteArrayMatcher &other);
+    QMultiByteArrayMatcher &operator=(QMultiByteArrayMatcher &&other) noexcept
+    { d.swap(other.d); return *this; }
+
+    void swap(QMultiByteArrayMatcher &other) noexcept { d.swap(other.d); }
+
+    void setPatterns(const QByteArrayList &patterns);
+    QByteArrayList patterns() const;
+    void setCaseSensitivity(Qt::CaseSensitivity cs);
+    Qt::CaseSensitivity caseSensitivity() const;
+
+    qsizetype indexIn(const QByteArray &ba, qsizetype from = 0, int *pattern = nullptr) const;
+    qsizetype indexIn(const char *str, qsizetype len, qsizetype from = 0, int *pattern = nullptr) const;
+    QVector<Match> matches(const QByteArray &ba, qsizetype from = 0) const;
+    QVector<Match> matches(const char *str, qsizetype len, qsizetype from = 0) const;
+
+private:
+    QExplicitlySharedDataPointer<QMultiByteArrayMatcherPrivate> d;
+};
+
+Q_DECLARE_SHARED(QMultiByteArrayMatcher)
+Q_DECLARE_TYPEINFO(QMultiByteArrayMatcher::Match, Q_PRIMITIVE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // QMULTIBYTEARRAYMATCHER_H
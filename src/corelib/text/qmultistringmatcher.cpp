@@ -0,0 +1,254 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qmultistringmatcher.h"
+#include "qahocorasick_p.h"
+
+QT_BEGIN_NAMESPACE
+
+class QMultiStringMatcherPrivate : public QSharedData
+{
+public:
+    QMultiStringMatcherPrivate(const QStringList &patterns, Qt::CaseSensitivity cs)
+        : patterns(patterns), cs(cs)
+    {
+        QVector<QVector<ushort>> units;
+        units.reserve(patterns.size());
+        for (const QString &pattern : patterns)
+            units.append(QVector<ushort>(pattern.utf16(), pattern.utf16() + pattern.size()));
+        automaton.build(units, cs == Qt::CaseSensitive ? nullptr : foldCase);
+    }
+
+    static ushort foldCase(ushort c) { return ushort(QChar::toCaseFolded(uint(c))); }
+
+    QStringList patterns;
+    Qt::CaseSensitivity cs;
+    QAhoCorasick<ushort> automaton;
+};
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \since 6.0
+    \brief The QMultiStringMatcher class holds a set of strings that
+    can be searched for at the same time in a Unicode string.
+
+    \ingroup tools
+    \ingroup string-processing
+
+    Searching a text for each of many patterns with QStringMatcher
+    takes one pass over the text per pattern. QMultiStringMatcher
+    compiles all of its patterns into one automaton (the Aho-Corasick
+    algorithm), and finds the occurrences of all of them in a single
+    pass, whatever the number of patterns.
+
+    Create the QMultiStringMatcher with the list of strings you want to
+    search for. Then call matches() to get all their occurrences in a
+    string, or indexIn() to find the first one.
+
+    Case insensitive matchers compare the case folded forms of
+    characters in the Basic Multilingual Plane, one UTF-16 code unit
+    at a time. Empty patterns never match.
+
+    Compiling the patterns takes time and memory proportional to their
+    total length times the number of distinct characters in them, so
+    keep a matcher around rather than creating it for each search.
+
+    \sa QStringMatcher, QMultiByteArrayMatcher
+*/
+
+/*!
+    \class QMultiStringMatcher::Match
+    \inmodule QtCore
+    \brief An occurrence of a pattern of a QMultiStringMatcher.
+
+    \variable QMultiStringMatcher::Match::position
+    \brief The position in the string at which the occurrence starts.
+
+    \variable QMultiStringMatcher::Match::length
+    \brief The length of the occurrence.
+
+    \variable QMultiStringMatcher::Match::pattern
+    \brief The index of the pattern in patterns().
+*/
+
+/*!
+    Constructs a matcher without patterns, which won't match anything.
+    Call setPatterns() to give it patterns to match.
+*/
+QMultiStringMatcher::QMultiStringMatcher()
+    : d(new QMultiStringMatcherPrivate(QStringList(), Qt::CaseSensitive))
+{
+}
+
+/*!
+    Constructs a matcher that will search for \a patterns, with case
+    sensitivity \a cs.
+
+    Call matches() or indexIn() to perform a search.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QStringList &patterns, Qt::CaseSensitivity cs)
+    : d(new QMultiStringMatcherPrivate(patterns, cs))
+{
+}
+
+/*!
+    Copies the \a other matcher to this matcher.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other)
+    : d(other.d)
+{
+}
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher()
+{
+}
+
+/*!
+    Assigns the \a other matcher to this matcher.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other)
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other)
+
+    Move-assigns \a other to this matcher.
+*/
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+
+    Swaps the matcher \a other with this matcher. This operation is
+    very fast and never fails.
+*/
+
+/*!
+    Sets the strings to search for to \a patterns.
+
+    \sa patterns(), setCaseSensitivity()
+*/
+void QMultiStringMatcher::setPatterns(const QStringList &patterns)
+{
+    d = new QMultiStringMatcherPrivate(patterns, d->cs);
+}
+
+/*!
+    Returns the strings that this matcher searches for.
+
+    \sa setPatterns()
+*/
+QStringList QMultiStringMatcher::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Sets the case sensitivity to \a cs.
+
+    \sa caseSensitivity()
+*/
+void QMultiStringMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (cs != d->cs)
+        d = new QMultiStringMatcherPrivate(d->patterns, cs);
+}
+
+/*!
+    Returns the case sensitivity setting for this matcher.
+
+    \sa setCaseSensitivity()
+*/
+Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Searches the string \a str from character position \a from
+    (default 0, i.e. from the first character) for the patterns().
+    Returns the position of the leftmost occurrence of any of them, or
+    -1 if none was found.
+
+    If \a pattern is not \nullptr, it receives the index of the
+    pattern that occurs there, or -1. If several patterns occur at the
+    same position, this is the longest one.
+
+    \sa matches()
+*/
+qsizetype QMultiStringMatcher::indexIn(QStringView str, qsizetype from, int *pattern) const
+{
+    if (from < 0)
+        from = 0;
+    return d->automaton.indexIn(reinterpret_cast<const ushort *>(str.data()), str.size(),
+                                from, pattern);
+}
+
+/*!
+    Returns all occurrences of the patterns() in the string \a str
+    from character position \a from (default 0, i.e. from the first
+    character) on, including overlapping ones.
+
+    The occurrences are sorted by the position where they end; of the
+    occurrences that end at the same position, the longer ones come
+    first.
+
+    \sa indexIn()
+*/
+QVector<QMultiStringMatcher::Match> QMultiStringMatcher::matches(QStringView str, qsizetype from) const
+{
+    if (from < 0)
+        from = 0;
+    QVector<Match> result;
+    const QAhoCorasick<ushort> &automaton = d->automaton;
+    automaton.scan(reinterpret_cast<const ushort *>(str.data()), str.size(), from,
+                   [&](qsizetype position, int pattern) {
+        result.append({ position, automaton.patternLength(pattern), pattern });
+        return true;
+    });
+    return result;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QMULTISTRINGMATCHER_H
+#define QMULTISTRINGMATCHER_H
+
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qstringview.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+
+class QMultiStringMatcherPrivate;
+
+class Q_CORE_EXPORT QMultiStringMatcher
+{
+public:
+    struct Match
+    {
+        qsizetype position;
+        qsizetype length;
+        int pattern;
+    };
+
+    QMultiStringMatcher();
+    explicit QMultiStringMatcher(const QStringList &patterns,
+                                 Qt::CaseSensitivity cs = Qt::CaseSensitive);
+    QMultiStringMatcher(const QMultiStringMatcher &other);
+    ~QMultiStringMatcher();
+
+    QMultiStringMatcher &operator=(const QMultiStringMatcher &other);
+    QMultiStringMatcher &operator=(QMultiStringMatcher &&other) noexcept
+    { d.swap(other.d); return *this; }
+
+    void swap(QMultiStringMatcher &other) noexcept { d.swap(other.d); }
+
+    void setPatterns(const QStringList &patterns);
+    QStringList patterns() const;
+    void setCaseSensitivity(Qt::CaseSensitivity cs);
+    Qt::CaseSensitivity caseSensitivity() const;
+
+    qsizetype indexIn(QStringView str, qsizetype from = 0, int *pattern = nullptr) const;
+    QVector<Match> matches(QStringView str, qsizetype from = 0) const;
+
+private:
+    QExplicitlySharedDataPointer<QMultiStringMatcherPrivate> d;
+};
+
+Q_DECLARE_SHARED(QMultiStringMatcher)
+Q_DECLARE_TYPEINFO(QMultiStringMatcher::Match, Q_PRIMITIVE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // QMULTISTRINGMATCHER_H
@@ -40,7 +40,9 @@
 ****************************************************************************/
 
 #include "qregularexpression.h"
+#include "qregularexpression_p.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qmutex.h>
@@ -51,6 +53,7 @@
 #include <QtCore/qglobal.h>
 #include <QtCore/qatomic.h>
 #include <QtCore/qdatastream.h>
+#include <QtCore/private/qlocking_p.h>
 
 #define PCRE2_CODE_UNIT_WIDTH 16
 
@@ -808,6 +811,33 @@ static int convertToPcreOptions(QRegularExpression::MatchOptions matchOptions)
     return options;
 }
 
+/*
+    A pattern compiled (and JIT-compiled, if enabled) by PCRE2. It does not
+    change after the construction, so that all the QRegularExpressionPrivate
+    objects with the same pattern and pattern options, in any thread, can
+    share it; see compiledPatternFor().
+*/
+struct QRegularExpressionCompiledPattern : QSharedData
+{
+    QRegularExpressionCompiledPattern(const QString &pattern,
+                                      QRegularExpression::PatternOptions patternOptions);
+    ~QRegularExpressionCompiledPattern();
+
+    void getPatternInfo();
+    void optimizePattern();
+    int cost() const;
+
+    pcre2_code_16 *code;
+    int errorCode;
+    int errorOffset;
+    int capturingCount;
+    bool usingCrLfNewlines;
+    bool usingJOption;
+
+private:
+    Q_DISABLE_COPY(QRegularExpressionCompiledPattern)
+};
+
 struct QRegularExpressionPrivate : QSharedData
 {
     QRegularExpressionPrivate();
@@ -816,8 +846,6 @@ struct QRegularExpressionPrivate : QSharedData
 
     void cleanCompiledPattern();
     void compilePattern();
-    void getPatternInfo();
-    void optimizePattern();
 
     enum CheckSubjectStringOption {
         CheckSubjectString,
@@ -844,9 +872,11 @@ struct QRegularExpressionPrivate : QSharedData
     // (right after a detach happened).
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The compiled pattern is shared with the other QRegularExpressionPrivate
+    // objects using the same pattern and options; when the private is copied
+    // (i.e. a detach happened) it is reset. The members after compiledPattern
+    // are copied from it.
+    QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern> compiled;
     pcre2_code_16 *compiledPattern;
     int errorCode;
     int errorOffset;
@@ -915,6 +945,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate()
       patternOptions(0),
       pattern(),
       mutex(),
+      compiled(),
       compiledPattern(nullptr),
       errorCode(0),
       errorOffset(-1),
@@ -936,16 +967,17 @@ QRegularExpressionPrivate::~QRegularExpressionPrivate()
     \internal
 
     Copies the private, which means copying only the pattern and the pattern
-    options. The compiledPattern pointer is NOT copied (we
-    do not own it any more), and in general all the members set when
-    compiling a pattern are set to default values. isDirty is set back to true
-    so that the pattern has to be recompiled again.
+    options. The compiled pattern is NOT copied, and in general all the
+    members set when compiling a pattern are set to default values. isDirty
+    is set back to true so that the pattern has to be compiled (or looked up
+    in the cache) again.
 */
 QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPrivate &other)
     : QSharedData(other),
       patternOptions(other.patternOptions),
       pattern(other.pattern),
       mutex(),
+      compiled(),
       compiledPattern(nullptr),
       errorCode(0),
       errorOffset(-1),
@@ -960,7 +992,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    compiled.reset();
     compiledPattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
@@ -971,28 +1003,27 @@ void QRegularExpressionPrivate::cleanCompiledPattern()
 /*!
     \internal
 */
-void QRegularExpressionPrivate::compilePattern()
+QRegularExpressionCompiledPattern::QRegularExpressionCompiledPattern(const QString &pattern,
+                                                                     QRegularExpression::PatternOptions patternOptions)
+    : code(nullptr),
+      errorCode(0),
+      errorOffset(-1),
+      capturingCount(0),
+      usingCrLfNewlines(false),
+      usingJOption(false)
 {
-    const QMutexLocker lock(&mutex);
-
-    if (!isDirty)
-        return;
-
-    isDirty = false;
-    cleanCompiledPattern();
-
     int options = convertToPcreOptions(patternOptions);
     options |= PCRE2_UTF;
 
     PCRE2_SIZE patternErrorOffset;
-    compiledPattern = pcre2_compile_16(pattern.utf16(),
-                                       pattern.length(),
-                                       options,
-                                       &errorCode,
-                                       &patternErrorOffset,
-                                       NULL);
-
-    if (!compiledPattern) {
+    code = pcre2_compile_16(pattern.utf16(),
+                            pattern.length(),
+                            options,
+                            &errorCode,
+                            &patternErrorOffset,
+                            NULL);
+
+    if (!code) {
         errorOffset = static_cast<int>(patternErrorOffset);
         return;
     } else {
@@ -1007,15 +1038,23 @@ void QRegularExpressionPrivate::compilePattern()
 /*!
     \internal
 */
-void QRegularExpressionPrivate::getPatternInfo()
+QRegularExpressionCompiledPattern::~QRegularExpressionCompiledPattern()
 {
-    Q_ASSERT(compiledPattern);
+    pcre2_code_free_16(code);
+}
+
+/*!
+    \internal
+*/
+void QRegularExpressionCompiledPattern::getPatternInfo()
+{
+    Q_ASSERT(code);
 
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_CAPTURECOUNT, &capturingCount);
+    pcre2_pattern_info_16(code, PCRE2_INFO_CAPTURECOUNT, &capturingCount);
 
     // detect the settings for the newline
     unsigned int patternNewlineSetting;
-    if (pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
+    if (pcre2_pattern_info_16(code, PCRE2_INFO_NEWLINE, &patternNewlineSetting) != 0) {
         // no option was specified in the regexp, grab PCRE build defaults
         pcre2_config_16(PCRE2_CONFIG_NEWLINE, &patternNewlineSetting);
     }
@@ -1025,13 +1064,173 @@ void QRegularExpressionPrivate::getPatternInfo()
             (patternNewlineSetting == PCRE2_NEWLINE_ANYCRLF);
 
     unsigned int hasJOptionChanged;
-    pcre2_pattern_info_16(compiledPattern, PCRE2_INFO_JCHANGED, &hasJOptionChanged);
-    if (Q_UNLIKELY(hasJOptionChanged)) {
+    pcre2_pattern_info_16(code, PCRE2_INFO_JCHANGED, &hasJOptionChanged);
+    usingJOption = hasJOptionChanged;
+}
+
+/*!
+    \internal
+
+    Returns the memory used by the compiled pattern and its JIT code, in
+    bytes, as the cost of the pattern in the cache.
+*/
+int QRegularExpressionCompiledPattern::cost() const
+{
+    size_t size = sizeof(*this);
+    if (code) {
+        size_t infoSize = 0;
+        if (pcre2_pattern_info_16(code, PCRE2_INFO_SIZE, &infoSize) == 0)
+            size += infoSize;
+        infoSize = 0;
+        if (pcre2_pattern_info_16(code, PCRE2_INFO_JITSIZE, &infoSize) == 0)
+            size += infoSize;
+    }
+    return int(qMin(size, size_t(std::numeric_limits<int>::max())));
+}
+
+/*
+    The process-wide cache of compiled patterns. It keeps the most recently
+    used patterns alive up to a total cost (see
+    QRegularExpressionCompiledPattern::cost()); the patterns that are in use
+    stay alive anyway, as every QRegularExpressionPrivate holds a reference.
+*/
+struct QRegularExpressionCacheKey
+{
+    QString pattern;
+    QRegularExpression::PatternOptions patternOptions;
+};
+
+static bool operator==(const QRegularExpressionCacheKey &key1, const QRegularExpressionCacheKey &key2)
+{
+    return key1.pattern == key2.pattern && key1.patternOptions == key2.patternOptions;
+}
+
+static uint qHash(const QRegularExpressionCacheKey &key, uint seed = 0) noexcept
+{
+    QtPrivate::QHashCombine hash;
+    seed = hash(seed, key.pattern);
+    seed = hash(seed, int(key.patternOptions));
+    return seed;
+}
+
+typedef QExplicitlySharedDataPointer<QRegularExpressionCompiledPattern> QRegularExpressionCompiledPatternPointer;
+
+struct QRegularExpressionCacheData
+{
+    enum { DefaultMaxCost = 4 * 1024 * 1024 };
+
+    QCache<QRegularExpressionCacheKey, QRegularExpressionCompiledPatternPointer> patterns { DefaultMaxCost };
+    quint64 hits = 0;
+    quint64 misses = 0;
+};
+Q_GLOBAL_STATIC(QRegularExpressionCacheData, regularExpressionCache)
+static QBasicMutex regularExpressionCacheMutex;
+
+/*!
+    \internal
+
+    Returns the compiled form of \a pattern with \a patternOptions, from
+    the cache if possible.
+*/
+static QRegularExpressionCompiledPatternPointer compiledPatternFor(const QString &pattern,
+                                                                  QRegularExpression::PatternOptions patternOptions)
+{
+    QRegularExpressionCacheKey key = { pattern, patternOptions };
+    {
+        const auto locker = qt_scoped_lock(regularExpressionCacheMutex);
+        if (QRegularExpressionCacheData *c = regularExpressionCache()) {
+            if (QRegularExpressionCompiledPatternPointer *cached = c->patterns.object(key)) {
+                ++c->hits;
+                return *cached;
+            }
+            ++c->misses;
+        }
+    }
+
+    // compile without holding the lock; if another thread compiles the same
+    // pattern meanwhile, the last one to finish replaces the other in the cache
+    QRegularExpressionCompiledPatternPointer compiled(new QRegularExpressionCompiledPattern(pattern, patternOptions));
+
+    const auto locker = qt_scoped_lock(regularExpressionCacheMutex);
+    if (QRegularExpressionCacheData *c = regularExpressionCache())
+        c->patterns.insert(std::move(key), new QRegularExpressionCompiledPatternPointer(compiled), compiled->cost());
+    return compiled;
+}
+
+/*!
+    \internal
+*/
+void QRegularExpressionPrivate::compilePattern()
+{
+    const QMutexLocker lock(&mutex);
+
+    if (!isDirty)
+        return;
+
+    isDirty = false;
+    cleanCompiledPattern();
+
+    compiled = compiledPatternFor(pattern, patternOptions);
+    compiledPattern = compiled->code;
+    errorCode = compiled->errorCode;
+    errorOffset = compiled->errorOffset;
+    capturingCount = compiled->capturingCount;
+    usingCrLfNewlines = compiled->usingCrLfNewlines;
+
+    if (Q_UNLIKELY(compiled->usingJOption)) {
         qWarning("QRegularExpressionPrivate::getPatternInfo(): the pattern '%ls'\n    is using the (?J) option; duplicate capturing group names are not supported by Qt",
                  qUtf16Printable(pattern));
     }
 }
 
+/*!
+    \internal
+
+    Returns the number of lookups of compiled patterns in the cache that
+    were hits and misses, and the number and total cost of the cached
+    patterns.
+*/
+QRegularExpressionCache::Statistics QRegularExpressionCache::statistics()
+{
+    Statistics result = { 0, 0, 0, 0, 0 };
+    const auto locker = qt_scoped_lock(regularExpressionCacheMutex);
+    if (QRegularExpressionCacheData *c = regularExpressionCache()) {
+        result.hits = c->hits;
+        result.misses = c->misses;
+        result.count = c->patterns.count();
+        result.totalCost = c->patterns.totalCost();
+        result.maxCost = c->patterns.maxCost();
+    }
+    return result;
+}
+
+/*!
+    \internal
+
+    Sets the maximum total cost of the cached patterns, in bytes, to \a maxCost.
+    0 disables the cache.
+*/
+void QRegularExpressionCache::setMaxCost(int maxCost)
+{
+    const auto locker = qt_scoped_lock(regularExpressionCacheMutex);
+    if (QRegularExpressionCacheData *c = regularExpressionCache())
+        c->patterns.setMaxCost(maxCost);
+}
+
+/*!
+    \internal
+
+    Removes all the patterns from the cache and resets the counters.
+*/
+void QRegularExpressionCache::clear()
+{
+    const auto locker = qt_scoped_lock(regularExpressionCacheMutex);
+    if (QRegularExpressionCacheData *c = regularExpressionCache()) {
+        c->patterns.clear();
+        c->hits = 0;
+        c->misses = 0;
+    }
+}
 
 /*
     Simple "smartpointer" wrapper around a pcre2_jit_stack_16, to be used with
@@ -1101,19 +1300,19 @@ static bool isJitEnabled()
     The purpose of the function is to call pcre2_jit_compile_16, which
     JIT-compiles the pattern.
 
-    It gets called when a pattern is recompiled by us (in compilePattern()),
-    under mutex protection.
+    It gets called when a pattern is compiled by us (in the constructor of
+    QRegularExpressionCompiledPattern), before the pattern is shared.
 */
-void QRegularExpressionPrivate::optimizePattern()
+void QRegularExpressionCompiledPattern::optimizePattern()
 {
-    Q_ASSERT(compiledPattern);
+    Q_ASSERT(code);
 
     static const bool enableJit = isJitEnabled();
 
     if (!enableJit)
         return;
 
-    pcre2_jit_compile_16(compiledPattern, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
+    pcre2_jit_compile_16(code, PCRE2_JIT_COMPLETE | PCRE2_JIT_PARTIAL_SOFT | PCRE2_JIT_PARTIAL_HARD);
 }
 
 /*!
@@ -1746,6 +1945,11 @@ QRegularExpressionMatchIterator QRegularExpression::globalMatch(const QStringRef
     Compiles the pattern immediately, including JIT compiling it (if
     the JIT is enabled) for optimization.
 
+    Compiled patterns are cached process-wide: QRegularExpression objects
+    created with the same pattern and pattern options, in any thread, share
+    a single compiled pattern, and reuse it from the cache when they are
+    created again later.
+
     \sa isValid(), {Debugging Code that Uses QRegularExpression}
 */
 void QRegularExpression::optimize() const
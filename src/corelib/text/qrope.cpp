@@ -0,0 +1,948 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qrope.h"
+
+#include <string.h>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The text of a QRope is held in a height-balanced binary tree. Leaves
+    refer to a slice of a QString; inner nodes stand for the concatenation
+    of their children and cache its length. Nodes are never modified once
+    they are created, so copies of a rope share all of their nodes, and an
+    edit only creates the nodes on the paths to the positions it changes.
+*/
+struct QRopeNode : public QSharedData
+{
+    QExplicitlySharedDataPointer<QRopeNode> left;
+    QExplicitlySharedDataPointer<QRopeNode> right;
+    QString text;           // leaves only
+    qsizetype offset = 0;   // leaves only: the start of the slice in text
+    qsizetype length = 0;
+    qsizetype leaves = 1;
+    int height = 0;         // 0 for leaves
+
+    bool isLeaf() const noexcept { return height == 0; }
+    QStringView chunk() const noexcept { return QStringView(text.constData() + offset, length); }
+};
+
+namespace {
+
+typedef QExplicitlySharedDataPointer<QRopeNode> NodePtr;
+
+// Leaves up to this size are copied and merged with their neighbors
+// instead of sharing the data they were made from. This keeps many small
+// edits from fragmenting the tree, and keeps a small slice from holding
+// on to a large buffer.
+enum { SmallChunk = 512 };
+
+static NodePtr sliceLeaf(const QString &text, qsizetype offset, qsizetype length)
+{
+    Q_ASSERT(length > 0);
+    NodePtr node(new QRopeNode);
+    if (length <= SmallChunk && length < text.size()) {
+        node->text = QString(text.constData() + offset, int(length));
+    } else {
+        node->text = text;
+        node->offset = offset;
+    }
+    node->length = length;
+    return node;
+}
+
+static NodePtr copyLeaf(QStringView a, QStringView b = QStringView(), QStringView c = QStringView())
+{
+    const qsizetype length = a.size() + b.size() + c.size();
+    Q_ASSERT(length > 0);
+    NodePtr node(new QRopeNode);
+    node->text = QString(int(length), Qt::Uninitialized);
+    QChar *out = node->text.data();
+    for (QStringView part : { a, b, c }) {
+        if (!part.isEmpty())
+            memcpy(out, part.data(), size_t(part.size()) * sizeof(QChar));
+        out += part.size();
+    }
+    node->length = length;
+    return node;
+}
+
+static NodePtr makeNode(const NodePtr &left, const NodePtr &right)
+{
+    NodePtr node(new QRopeNode);
+    node->left = left;
+    node->right = right;
+    node->length = left->length + right->length;
+    node->leaves = left->leaves + right->leaves;
+    node->height = qMax(left->height, right->height) + 1;
+    return node;
+}
+
+// Concatenates two trees whose heights differ by at most one.
+static NodePtr concat(const NodePtr &left, const NodePtr &right)
+{
+    if (left->isLeaf() && right->isLeaf() && left->length + right->length <= SmallChunk)
+        return copyLeaf(left->chunk(), right->chunk());
+    return makeNode(left, right);
+}
+
+static NodePtr rotateLeft(const NodePtr &node)
+{
+    return makeNode(makeNode(node->left, node->right->left), node->right->right);
+}
+
+static NodePtr rotateRight(const NodePtr &node)
+{
+    return makeNode(node->left->left, makeNode(node->left->right, node->right));
+}
+
+// The join operation of AVL trees, without the middle key: concatenates
+// two trees of any height in time proportional to the difference of their
+// heights, by attaching the lower one to the spine of the higher one.
+static NodePtr joinRight(const NodePtr &tree, const NodePtr &right)
+{
+    const NodePtr &l = tree->left;
+    const NodePtr &c = tree->right;
+    if (c->height <= right->height + 1) {
+        const NodePtr joined = concat(c, right);
+        if (joined->height <= l->height + 1)
+            return makeNode(l, joined);
+        return rotateLeft(makeNode(l, rotateRight(joined)));
+    }
+    const NodePtr joined = joinRight(c, right);
+    if (joined->height <= l->height + 1)
+        return makeNode(l, joined);
+    return rotateLeft(makeNode(l, joined));
+}
+
+static NodePtr joinLeft(const NodePtr &left, const NodePtr &tree)
+{
+    const NodePtr &c = tree->left;
+    const NodePtr &r = tree->right;
+    if (c->height <= left->height + 1) {
+        const NodePtr joined = concat(left, c);
+        if (joined->height <= r->height + 1)
+            return makeNode(joined, r);
+        return rotateRight(makeNode(rotateLeft(joined), r));
+    }
+    const NodePtr joined = joinLeft(left, c);
+    if (joined->height <= r->height + 1)
+        return makeNode(joined, r);
+    return rotateRight(makeNode(joined, r));
+}
+
+static NodePtr join(const NodePtr &left, const NodePtr &right)
+{
+    if (!left)
+        return right;
+    if (!right)
+        return left;
+    if (left->height > right->height + 1)
+        return joinRight(left, right);
+    if (right->height > left->height + 1)
+        return joinLeft(left, right);
+    return concat(left, right);
+}
+
+// Splits a tree into the first pos characters and the rest.
+static std::pair<NodePtr, NodePtr> split(const NodePtr &tree, qsizetype pos)
+{
+    if (!tree || pos <= 0)
+        return { NodePtr(), tree };
+    if (pos >= tree->length)
+        return { tree, NodePtr() };
+    if (tree->isLeaf()) {
+        return { sliceLeaf(tree->text, tree->offset, pos),
+                 sliceLeaf(tree->text, tree->offset + pos, tree->length - pos) };
+    }
+    const qsizetype leftLength = tree->left->length;
+    if (pos <= leftLength) {
+        const auto parts = split(tree->left, pos);
+        return { parts.first, join(parts.second, tree->right) };
+    }
+    const auto parts = split(tree->right, pos - leftLength);
+    return { join(tree->left, parts.first), parts.second };
+}
+
+// Replaces the len characters at pos with middle.
+static NodePtr replaceRange(const NodePtr &tree, qsizetype pos, qsizetype len,
+                            const NodePtr &middle)
+{
+    const auto head = split(tree, pos);
+    const auto tail = split(head.second, len);
+    return join(join(head.first, middle), tail.second);
+}
+
+// The fast path for small edits: replaces the len characters at pos with
+// after inside a single small leaf, copying only the nodes on the path to
+// it. The shape of the tree does not change. Returns null if the edit
+// spans several leaves, or would make the leaf empty or too large.
+static NodePtr editLeaf(const NodePtr &tree, qsizetype pos, qsizetype len, QStringView after)
+{
+    if (tree->isLeaf()) {
+        const qsizetype newLength = tree->length - len + after.size();
+        if (pos + len > tree->length || newLength <= 0 || newLength > SmallChunk)
+            return NodePtr();
+        const QStringView chunk = tree->chunk();
+        return copyLeaf(chunk.left(pos), after, chunk.mid(pos + len));
+    }
+    const qsizetype leftLength = tree->left->length;
+    if (pos + len <= leftLength) {
+        if (const NodePtr left = editLeaf(tree->left, pos, len, after))
+            return makeNode(left, tree->right);
+    }
+    if (pos >= leftLength) {
+        if (const NodePtr right = editLeaf(tree->right, pos - leftLength, len, after))
+            return makeNode(tree->left, right);
+    }
+    return NodePtr();
+}
+
+} // unnamed namespace
+
+/*!
+    \class QRope
+    \inmodule QtCore
+    \since 6.0
+    \brief The QRope class provides a string that can be edited in
+    logarithmic time.
+
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+
+    \reentrant
+
+    Inserting into or removing from the middle of a QString moves all the
+    characters after the edit, and modifying a QString that is shared
+    copies all of it. For large texts that are edited many times, like the
+    contents of a text editor or a log buffer, this makes each edit cost
+    time proportional to the size of the text.
+
+    QRope stores its text as a sequence of immutable chunks, held in a
+    balanced tree. insert(), remove(), replace(), mid(), left() and
+    right() take time proportional to the logarithm of the number of
+    chunks, independently of the size of the text, and so does accessing a
+    character with at(). Copying a QRope is a constant time operation;
+    copies share all of their chunks, and editing one of them only creates
+    the tree nodes on the paths to the edited positions.
+
+    Constructing a QRope from a QString, or inserting a QString into it,
+    does not copy the characters: the QRope shares the data of the QString,
+    and later edits refer to slices of it. Small strings are copied
+    instead, and merged with neighboring chunks, so that many small edits,
+    like typing, do not fragment the text.
+
+    Code that processes the text of a QRope should iterate over its chunks,
+    which are available as QStringViews:
+
+    \snippet code/src_corelib_text_qrope.cpp 0
+
+    toString() converts the whole text to a QString, which takes time
+    proportional to its size. The text of a QRope must not be longer than
+    the maximum size of a QString for that.
+
+    \sa QString, QStringView
+*/
+
+/*!
+    \class QRope::const_chunk_iterator
+    \inmodule QtCore
+    \since 6.0
+    \brief The QRope::const_chunk_iterator class iterates over the chunks
+    of a QRope.
+
+    Dereferencing the iterator yields the current chunk as a QStringView.
+    Chunks are never empty. The iterator is invalidated when the QRope
+    that it iterates over is modified or destroyed.
+
+    \sa QRope::chunkBegin(), QRope::chunks()
+*/
+
+/*!
+    \fn QRope::const_chunk_iterator::const_chunk_iterator()
+
+    Constructs an iterator that is equal to QRope::chunkEnd().
+*/
+
+/*!
+    \fn QStringView QRope::const_chunk_iterator::operator*() const
+
+    Returns the current chunk.
+*/
+
+/*!
+    \fn const QStringView *QRope::const_chunk_iterator::operator->() const
+
+    Returns a pointer to the current chunk.
+*/
+
+/*!
+    \fn QRope::const_chunk_iterator QRope::const_chunk_iterator::operator++(int)
+    \overload
+
+    Advances the iterator to the next chunk and returns an iterator to the
+    previous one.
+*/
+
+/*!
+    \fn bool QRope::const_chunk_iterator::operator==(const const_chunk_iterator &lhs, const const_chunk_iterator &rhs)
+
+    Returns \c true if \a lhs and \a rhs point to the same chunk.
+*/
+
+/*!
+    \fn bool QRope::const_chunk_iterator::operator!=(const const_chunk_iterator &lhs, const const_chunk_iterator &rhs)
+
+    Returns \c true if \a lhs and \a rhs point to different chunks.
+*/
+
+QRope::const_chunk_iterator::const_chunk_iterator(const QRopeNode *root)
+    : leaf(nullptr)
+{
+    if (root)
+        descend(root);
+}
+
+void QRope::const_chunk_iterator::descend(const QRopeNode *node)
+{
+    while (!node->isLeaf()) {
+        pending.append(node->right.data());
+        node = node->left.data();
+    }
+    leaf = node;
+    chunk = node->chunk();
+}
+
+/*!
+    Advances the iterator to the next chunk and returns a reference to
+    it.
+*/
+QRope::const_chunk_iterator &QRope::const_chunk_iterator::operator++()
+{
+    Q_ASSERT(leaf);
+    if (pending.isEmpty()) {
+        leaf = nullptr;
+        chunk = QStringView();
+    } else {
+        const QRopeNode *next = pending.last();
+        pending.removeLast();
+        descend(next);
+    }
+    return *this;
+}
+
+/*!
+    \class QRope::ChunkRange
+    \inmodule QtCore
+    \since 6.0
+    \brief The QRope::ChunkRange class makes the chunks of a QRope
+    available to range-based for loops.
+
+    \sa QRope::chunks()
+*/
+
+/*!
+    \fn QRope::const_chunk_iterator QRope::ChunkRange::begin() const
+
+    Returns an iterator to the first chunk.
+*/
+
+/*!
+    \fn QRope::const_chunk_iterator QRope::ChunkRange::end() const
+
+    Returns an iterator past the last chunk.
+*/
+
+/*!
+    Constructs an empty rope.
+*/
+QRope::QRope() noexcept
+{
+}
+
+/*!
+    Constructs a rope that holds a copy of the characters of \a str.
+*/
+QRope::QRope(QStringView str)
+    : d(str.isEmpty() ? NodePtr() : copyLeaf(str))
+{
+}
+
+/*!
+    Constructs a rope with the text of \a str. The rope shares the data of
+    \a str instead of copying it.
+*/
+QRope::QRope(const QString &str)
+    : d(str.isEmpty() ? NodePtr() : sliceLeaf(str, 0, str.size()))
+{
+}
+
+QRope::QRope(QExplicitlySharedDataPointer<QRopeNode> &&root) noexcept
+    : d(std::move(root))
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+
+    This operation takes constant time, because QRope is implicitly
+    shared.
+*/
+QRope::QRope(const QRope &other) noexcept
+    : d(other.d)
+{
+}
+
+/*!
+    Move-constructs a QRope instance, making it point at the same object
+    that \a other was pointing to.
+*/
+QRope::QRope(QRope &&other) noexcept
+    : d(std::move(other.d))
+{
+}
+
+/*!
+    Destroys the rope.
+*/
+QRope::~QRope()
+{
+}
+
+/*!
+    Assigns \a other to this rope and returns a reference to this rope.
+*/
+QRope &QRope::operator=(const QRope &other) noexcept
+{
+    d = other.d;
+    return *this;
+}
+
+/*!
+    \fn QRope &QRope::operator=(QRope &&other)
+
+    Move-assigns \a other to this QRope instance.
+*/
+
+/*!
+    \fn void QRope::swap(QRope &other)
+
+    Swaps rope \a other with this rope. This operation is very fast and
+    never fails.
+*/
+
+/*!
+    Returns the number of characters in the rope.
+
+    \sa isEmpty()
+*/
+qsizetype QRope::size() const noexcept
+{
+    return d ? d->length : 0;
+}
+
+/*!
+    \fn qsizetype QRope::length() const
+
+    Same as size().
+*/
+
+/*!
+    \fn bool QRope::isEmpty() const
+
+    Returns \c true if the rope has no characters; otherwise returns
+    \c false.
+*/
+
+/*!
+    Returns the number of chunks that the text of the rope is stored in.
+
+    \sa chunks()
+*/
+qsizetype QRope::chunkCount() const noexcept
+{
+    return d ? d->leaves : 0;
+}
+
+/*!
+    Returns the character at position \a i in the rope. \a i must be a
+    valid index position in the rope (i.e., 0 <= \a i < size()).
+
+    This operation takes time proportional to the logarithm of the number
+    of chunks.
+
+    \sa chunkAt()
+*/
+QChar QRope::at(qsizetype i) const
+{
+    qsizetype start;
+    return chunkAt(i, &start).at(i - start);
+}
+
+/*!
+    \fn QChar QRope::operator[](qsizetype i) const
+
+    Same as at(\a i).
+*/
+
+/*!
+    \fn QChar QRope::front() const
+
+    Returns the first character in the rope. Same as \c{at(0)}.
+
+    The rope must not be empty.
+*/
+
+/*!
+    \fn QChar QRope::back() const
+
+    Returns the last character in the rope. Same as \c{at(size() - 1)}.
+
+    The rope must not be empty.
+*/
+
+/*!
+    Returns the chunk that contains the character at position \a i. If
+    \a chunkStart is not \nullptr, the position of the first character of
+    the chunk is stored in *\a{chunkStart}. \a i must be a valid index
+    position in the rope (i.e., 0 <= \a i < size()).
+
+    Code that scans the text from a given position can use this function
+    to find where to start, and then continue with the following chunks.
+*/
+QStringView QRope::chunkAt(qsizetype i, qsizetype *chunkStart) const
+{
+    Q_ASSERT_X(i >= 0 && i < size(), "QRope::chunkAt", "index out of range");
+    const QRopeNode *node = d.data();
+    qsizetype start = 0;
+    while (!node->isLeaf()) {
+        const qsizetype leftLength = node->left->length;
+        if (i - start < leftLength) {
+            node = node->left.data();
+        } else {
+            start += leftLength;
+            node = node->right.data();
+        }
+    }
+    if (chunkStart)
+        *chunkStart = start;
+    return node->chunk();
+}
+
+/*!
+    Inserts a copy of \a str at index position \a i and returns a
+    reference to this rope. \a i must be a valid position in the rope
+    (i.e., 0 <= \a i <= size()).
+
+    \sa append(), prepend(), replace(), remove()
+*/
+QRope &QRope::insert(qsizetype i, QStringView str)
+{
+    return replace(i, 0, str);
+}
+
+/*!
+    \overload
+
+    Unless \a str is small, the rope shares its data instead of copying
+    it.
+*/
+QRope &QRope::insert(qsizetype i, const QString &str)
+{
+    return replace(i, 0, str);
+}
+
+/*!
+    \overload
+
+    Inserts the text of \a rope at index position \a i. The rope shares
+    the chunks of \a rope instead of copying them.
+*/
+QRope &QRope::insert(qsizetype i, const QRope &rope)
+{
+    Q_ASSERT_X(i >= 0 && i <= size(), "QRope::insert", "index out of range");
+    d = replaceRange(d, i, 0, rope.d);
+    return *this;
+}
+
+/*!
+    \fn QRope &QRope::append(QStringView str)
+
+    Appends \a str to the end of this rope. Same as \c{insert(size(), str)}.
+*/
+
+/*!
+    \fn QRope &QRope::append(const QString &str)
+    \overload
+*/
+
+/*!
+    \fn QRope &QRope::append(const QRope &rope)
+    \overload
+*/
+
+/*!
+    \fn QRope &QRope::prepend(QStringView str)
+
+    Prepends \a str to the beginning of this rope. Same as
+    \c{insert(0, str)}.
+*/
+
+/*!
+    \fn QRope &QRope::prepend(const QString &str)
+    \overload
+*/
+
+/*!
+    \fn QRope &QRope::prepend(const QRope &rope)
+    \overload
+*/
+
+/*!
+    \fn QRope &QRope::operator+=(QStringView str)
+
+    Same as append(\a str).
+*/
+
+/*!
+    \fn QRope &QRope::operator+=(const QString &str)
+    \overload
+*/
+
+/*!
+    \fn QRope &QRope::operator+=(const QRope &rope)
+    \overload
+*/
+
+/*!
+    Removes \a len characters from the rope, starting at index position
+    \a i, and returns a reference to the rope.
+
+    If \a i is negative, it counts from the end of the rope. If \a i is
+    outside of the rope, nothing happens. If \a i is valid, but \a i +
+    \a len is larger than the size of the rope, the rope is truncated at
+    position \a i.
+
+    \sa insert(), replace()
+*/
+QRope &QRope::remove(qsizetype i, qsizetype len)
+{
+    const qsizetype length = size();
+    if (i < 0)
+        i += length;
+    if (i < 0 || i >= length || len <= 0)
+        return *this;
+    len = qMin(len, length - i);
+    if (const NodePtr edited = editLeaf(d, i, len, QStringView()))
+        d = edited;
+    else
+        d = replaceRange(d, i, len, NodePtr());
+    return *this;
+}
+
+/*!
+    Replaces \a len characters beginning at index position \a i with a
+    copy of \a after and returns a reference to this rope. \a i must be a
+    valid position in the rope (i.e., 0 <= \a i <= size()). If \a i +
+    \a len is larger than the size of the rope, all characters from \a i
+    on are replaced.
+
+    \sa insert(), remove()
+*/
+QRope &QRope::replace(qsizetype i, qsizetype len, QStringView after)
+{
+    Q_ASSERT_X(i >= 0 && i <= size(), "QRope::replace", "index out of range");
+    len = qBound(qsizetype(0), len, size() - i);
+    if (!len && after.isEmpty())
+        return *this;
+    if (after.size() <= SmallChunk && d) {
+        if (const NodePtr edited = editLeaf(d, i, len, after)) {
+            d = edited;
+            return *this;
+        }
+    }
+    d = replaceRange(d, i, len, after.isEmpty() ? NodePtr() : copyLeaf(after));
+    return *this;
+}
+
+/*!
+    \overload
+
+    Unless \a after is small, the rope shares its data instead of copying
+    it.
+*/
+QRope &QRope::replace(qsizetype i, qsizetype len, const QString &after)
+{
+    if (after.size() <= SmallChunk)
+        return replace(i, len, QStringView(after));
+    Q_ASSERT_X(i >= 0 && i <= size(), "QRope::replace", "index out of range");
+    len = qBound(qsizetype(0), len, size() - i);
+    d = replaceRange(d, i, len, sliceLeaf(after, 0, after.size()));
+    return *this;
+}
+
+/*!
+    Truncates the rope at index position \a pos.
+
+    If \a pos is beyond the end of the rope, nothing happens.
+
+    \sa chop(), remove()
+*/
+void QRope::truncate(qsizetype pos)
+{
+    if (pos < size())
+        d = split(d, pos).first;
+}
+
+/*!
+    Removes \a n characters from the end of the rope.
+
+    If \a n is greater than or equal to size(), the result is an empty
+    rope; if \a n is negative, it is equivalent to passing zero.
+
+    \sa truncate(), remove()
+*/
+void QRope::chop(qsizetype n)
+{
+    if (n > 0)
+        truncate(size() - n);
+}
+
+/*!
+    Clears the contents of the rope and makes it empty.
+*/
+void QRope::clear() noexcept
+{
+    d.reset();
+}
+
+/*!
+    Returns a rope that contains \a n characters of this rope, starting at
+    the specified \a pos index position.
+
+    Returns an empty rope if \a pos exceeds the length of the rope. If
+    there are less than \a n characters available in the rope starting at
+    the given \a pos, or if \a n is -1 (default), the function returns all
+    characters that are available from the specified \a pos.
+
+    The returned rope shares the chunks of this rope.
+
+    \sa left(), right()
+*/
+QRope QRope::mid(qsizetype pos, qsizetype n) const
+{
+    const qsizetype length = size();
+    if (pos > length)
+        return QRope();
+    if (pos < 0) {
+        if (n < 0 || n + pos >= length)
+            return *this;
+        if (n + pos <= 0)
+            return QRope();
+        n += pos;
+        pos = 0;
+    } else if (n < 0 || n > length - pos) {
+        n = length - pos;
+    }
+    if (pos == 0 && n == length)
+        return *this;
+    if (n == 0)
+        return QRope();
+    return QRope(split(split(d, pos).second, n).first);
+}
+
+/*!
+    Returns a rope that contains the \a n leftmost characters of this
+    rope.
+
+    The entire rope is returned if \a n is greater than or equal to
+    size(), or less than zero.
+
+    \sa mid(), right()
+*/
+QRope QRope::left(qsizetype n) const
+{
+    if (n < 0 || n >= size())
+        return *this;
+    return QRope(split(d, n).first);
+}
+
+/*!
+    Returns a rope that contains the \a n rightmost characters of this
+    rope.
+
+    The entire rope is returned if \a n is greater than or equal to
+    size(), or less than zero.
+
+    \sa mid(), left()
+*/
+QRope QRope::right(qsizetype n) const
+{
+    if (n < 0 || n >= size())
+        return *this;
+    return QRope(split(d, size() - n).second);
+}
+
+/*!
+    Returns the text of the rope as a QString.
+
+    If the rope consists of a single chunk that covers a whole QString,
+    that QString is returned without copying it.
+*/
+QString QRope::toString() const
+{
+    if (!d)
+        return QString();
+    if (d->isLeaf() && d->offset == 0 && d->length == d->text.size())
+        return d->text;
+    QString result(int(d->length), Qt::Uninitialized);
+    QChar *out = result.data();
+    for (QStringView chunk : chunks()) {
+        memcpy(out, chunk.data(), size_t(chunk.size()) * sizeof(QChar));
+        out += chunk.size();
+    }
+    return result;
+}
+
+/*!
+    Returns an iterator to the first chunk of the rope.
+
+    \sa chunkEnd(), chunks()
+*/
+QRope::const_chunk_iterator QRope::chunkBegin() const
+{
+    return const_chunk_iterator(d.data());
+}
+
+/*!
+    \fn QRope::const_chunk_iterator QRope::chunkEnd() const
+
+    Returns an iterator past the last chunk of the rope.
+
+    \sa chunkBegin(), chunks()
+*/
+
+/*!
+    \fn QRope::ChunkRange QRope::chunks() const
+
+    Returns an object that makes the chunks of the rope available to
+    range-based for loops. The chunks are returned as QStringViews, in
+    order.
+
+    \sa chunkBegin(), chunkCount()
+*/
+
+bool QRope::equal(const QRope &lhs, const QRope &rhs) noexcept
+{
+    if (lhs.d == rhs.d)
+        return true;
+    if (lhs.size() != rhs.size())
+        return false;
+    const_chunk_iterator a = lhs.chunkBegin();
+    const_chunk_iterator b = rhs.chunkBegin();
+    const const_chunk_iterator end;
+    QStringView x;
+    QStringView y;
+    for (;;) {
+        if (x.isEmpty()) {
+            if (a == end)
+                return true;
+            x = *a++;
+        }
+        if (y.isEmpty())
+            y = *b++;
+        const qsizetype n = qMin(x.size(), y.size());
+        if (memcmp(x.data(), y.data(), size_t(n) * sizeof(QChar)) != 0)
+            return false;
+        x = x.mid(n);
+        y = y.mid(n);
+    }
+}
+
+bool QRope::equal(const QRope &lhs, QStringView rhs) noexcept
+{
+    if (lhs.size() != rhs.size())
+        return false;
+    for (QStringView chunk : lhs.chunks()) {
+        if (memcmp(chunk.data(), rhs.data(), size_t(chunk.size()) * sizeof(QChar)) != 0)
+            return false;
+        rhs = rhs.mid(chunk.size());
+    }
+    return true;
+}
+
+/*!
+    \fn bool QRope::operator==(const QRope &lhs, const QRope &rhs)
+
+    Returns \c true if rope \a lhs has the same text as rope \a rhs;
+    otherwise returns \c false. The chunks that the texts are split into
+    do not matter.
+*/
+
+/*!
+    \fn bool QRope::operator!=(const QRope &lhs, const QRope &rhs)
+
+    Returns \c true if rope \a lhs does not have the same text as rope
+    \a rhs; otherwise returns \c false.
+*/
+
+/*!
+    \fn bool QRope::operator==(const QRope &lhs, QStringView rhs)
+    \overload
+*/
+
+/*!
+    \fn bool QRope::operator!=(const QRope &lhs, QStringView rhs)
+    \overload
+*/
+
+/*!
+    \fn bool QRope::operator==(QStringView lhs, const QRope &rhs)
+    \overload
+*/
+
+/*!
+    \fn bool QRope::operator!=(QStringView lhs, const QRope &rhs)
+    \overload
+*/
+
+QT_END_NAMESPACE
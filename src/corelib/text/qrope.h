@@ -0,0 +1,178 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QROPE_H
+#define QROPE_H
+
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringview.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+struct QRopeNode;
+
+class Q_CORE_EXPORT QRope
+{
+public:
+    class Q_CORE_EXPORT const_chunk_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef QStringView value_type;
+        typedef const QStringView *pointer;
+        typedef QStringView reference;
+
+        const_chunk_iterator() noexcept : leaf(nullptr) {}
+
+        QStringView operator*() const noexcept { return chunk; }
+        const QStringView *operator->() const noexcept { return &chunk; }
+
+        const_chunk_iterator &operator++();
+        const_chunk_iterator operator++(int)
+        { const_chunk_iterator it = *this; ++*this; return it; }
+
+        friend bool operator==(const const_chunk_iterator &lhs, const const_chunk_iterator &rhs) noexcept
+        { return lhs.leaf == rhs.leaf; }
+        friend bool operator!=(const const_chunk_iterator &lhs, const const_chunk_iterator &rhs) noexcept
+        { return lhs.leaf != rhs.leaf; }
+
+    private:
+        friend class QRope;
+        explicit const_chunk_iterator(const QRopeNode *root);
+        void descend(const QRopeNode *node);
+
+        QVarLengthArray<const QRopeNode *, 48> pending;
+        const QRopeNode *leaf;
+        QStringView chunk;
+    };
+
+    class ChunkRange
+    {
+    public:
+        const_chunk_iterator begin() const { return rope->chunkBegin(); }
+        const_chunk_iterator end() const noexcept { return rope->chunkEnd(); }
+
+    private:
+        friend class QRope;
+        explicit ChunkRange(const QRope *r) noexcept : rope(r) {}
+        const QRope *rope;
+    };
+
+    QRope() noexcept;
+    explicit QRope(QStringView str);
+    explicit QRope(const QString &str);
+    QRope(const QRope &other) noexcept;
+    QRope(QRope &&other) noexcept;
+    ~QRope();
+    QRope &operator=(const QRope &other) noexcept;
+    QRope &operator=(QRope &&other) noexcept { swap(other); return *this; }
+    void swap(QRope &other) noexcept { d.swap(other.d); }
+
+    qsizetype size() const noexcept;
+    qsizetype length() const noexcept { return size(); }
+    bool isEmpty() const noexcept { return !size(); }
+    qsizetype chunkCount() const noexcept;
+
+    QChar at(qsizetype i) const;
+    QChar operator[](qsizetype i) const { return at(i); }
+    QChar front() const { return at(0); }
+    QChar back() const { return at(size() - 1); }
+    QStringView chunkAt(qsizetype i, qsizetype *chunkStart = nullptr) const;
+
+    QRope &insert(qsizetype i, QStringView str);
+    QRope &insert(qsizetype i, const QString &str);
+    QRope &insert(qsizetype i, const QRope &rope);
+    QRope &append(QStringView str) { return insert(size(), str); }
+    QRope &append(const QString &str) { return insert(size(), str); }
+    QRope &append(const QRope &rope) { return insert(size(), rope); }
+    QRope &prepend(QStringView str) { return insert(0, str); }
+    QRope &prepend(const QString &str) { return insert(0, str); }
+    QRope &prepend(const QRope &rope) { return insert(0, rope); }
+    QRope &remove(qsizetype i, qsizetype len);
+    QRope &replace(qsizetype i, qsizetype len, QStringView after);
+    QRope &replace(qsizetype i, qsizetype len, const QString &after);
+    void truncate(qsizetype pos);
+    void chop(qsizetype n);
+    void clear() noexcept;
+
+    QRope &operator+=(QStringView str) { return append(str); }
+    QRope &operator+=(const QString &str) { return append(str); }
+    QRope &operator+=(const QRope &rope) { return append(rope); }
+
+    Q_REQUIRED_RESULT QRope mid(qsizetype pos, qsizetype n = -1) const;
+    Q_REQUIRED_RESULT QRope left(qsizetype n) const;
+    Q_REQUIRED_RESULT QRope right(qsizetype n) const;
+
+    QString toString() const;
+
+    const_chunk_iterator chunkBegin() const;
+    const_chunk_iterator chunkEnd() const noexcept { return const_chunk_iterator(); }
+    ChunkRange chunks() const noexcept { return ChunkRange(this); }
+
+    friend bool operator==(const QRope &lhs, const QRope &rhs) noexcept
+    { return equal(lhs, rhs); }
+    friend bool operator!=(const QRope &lhs, const QRope &rhs) noexcept
+    { return !equal(lhs, rhs); }
+    friend bool operator==(const QRope &lhs, QStringView rhs) noexcept
+    { return equal(lhs, rhs); }
+    friend bool operator!=(const QRope &lhs, QStringView rhs) noexcept
+    { return !equal(lhs, rhs); }
+    friend bool operator==(QStringView lhs, const QRope &rhs) noexcept
+    { return equal(rhs, lhs); }
+    friend bool operator!=(QStringView lhs, const QRope &rhs) noexcept
+    { return !equal(rhs, lhs); }
+
+private:
+    explicit QRope(QExplicitlySharedDataPointer<QRopeNode> &&root) noexcept;
+    static bool equal(const QRope &lhs, const QRope &rhs) noexcept;
+    static bool equal(const QRope &lhs, QStringView rhs) noexcept;
+
+    QExplicitlySharedDataPointer<QRopeNode> d;
+};
+
+Q_DECLARE_SHARED(QRope)
+
+QT_END_NAMESPACE
+
+#endif // QROPE_H
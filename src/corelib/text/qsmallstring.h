@@ -0,0 +1,459 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSMALLSTRING_H
+#define QSMALLSTRING_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhashfunctions.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringview.h>
+
+#include <limits>
+#include <new>
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+inline QString makeSmallStringLarge(const char16_t *data, qsizetype size)
+{
+    Q_ASSERT(size <= qsizetype(std::numeric_limits<int>::max()));
+    return QString(reinterpret_cast<const QChar *>(data), int(size));
+}
+
+inline QByteArray makeSmallStringLarge(const char *data, qsizetype size)
+{
+    Q_ASSERT(size <= qsizetype(std::numeric_limits<int>::max()));
+    return QByteArray(data, int(size));
+}
+
+inline const char16_t *smallStringLargeData(const QString &str) noexcept
+{ return reinterpret_cast<const char16_t *>(str.constData()); }
+
+inline const char *smallStringLargeData(const QByteArray &str) noexcept
+{ return str.constData(); }
+
+// The storage of QSmallString and QSmallByteArray, three pointers in size.
+// Strings of up to InlineCapacity units are kept inline, null-terminated,
+// with their size in tag. Longer ones are kept in a String that lives in
+// the same bytes, with tag set to Large. String must be relocatable.
+template <typename String, typename Char, typename Tag>
+class QSmallStringStorage
+{
+public:
+    enum { InlineCapacity = int((3 * sizeof(void *) - sizeof(Tag)) / sizeof(Char)) - 1 };
+
+    QSmallStringStorage() noexcept : tag(0) { chars[0] = Char(); }
+    QSmallStringStorage(const Char *data, qsizetype size)
+    {
+        Q_ASSERT(size >= 0);
+        if (size <= InlineCapacity)
+            initInline(data, size);
+        else
+            initLarge(makeSmallStringLarge(data, size));
+    }
+    QSmallStringStorage(const String &str)
+    {
+        if (str.size() <= InlineCapacity)
+            initInline(smallStringLargeData(str), str.size());
+        else
+            initLarge(str);
+    }
+    QSmallStringStorage(String &&str)
+    {
+        if (str.size() <= InlineCapacity)
+            initInline(smallStringLargeData(str), str.size());
+        else
+            initLarge(std::move(str));
+    }
+    QSmallStringStorage(const QSmallStringStorage &other)
+    {
+        if (other.isLarge())
+            initLarge(other.large());
+        else
+            memcpy(static_cast<void *>(this), &other, sizeof(*this));
+    }
+    QSmallStringStorage(QSmallStringStorage &&other) noexcept
+    {
+        // moving the bytes of a relocatable String moves the String
+        memcpy(static_cast<void *>(this), &other, sizeof(*this));
+        other.tag = 0;
+        other.chars[0] = Char();
+    }
+    ~QSmallStringStorage()
+    {
+        if (isLarge())
+            large().~String();
+    }
+
+    QSmallStringStorage &operator=(const QSmallStringStorage &other)
+    {
+        QSmallStringStorage copy(other);
+        swap(copy);
+        return *this;
+    }
+    QSmallStringStorage &operator=(QSmallStringStorage &&other) noexcept
+    {
+        QSmallStringStorage moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    void swap(QSmallStringStorage &other) noexcept
+    {
+        char bytes[sizeof(QSmallStringStorage)];
+        memcpy(bytes, static_cast<void *>(this), sizeof(bytes));
+        memcpy(static_cast<void *>(this), &other, sizeof(bytes));
+        memcpy(static_cast<void *>(&other), bytes, sizeof(bytes));
+    }
+
+    bool isLarge() const noexcept { return tag == Large; }
+    qsizetype size() const noexcept { return isLarge() ? qsizetype(large().size()) : qsizetype(tag); }
+    const Char *data() const noexcept { return isLarge() ? smallStringLargeData(large()) : chars; }
+
+    String toString() const
+    {
+        if (isLarge())
+            return large();
+        return tag ? makeSmallStringLarge(chars, tag) : String();
+    }
+
+    // Makes room for size units and returns where to write them.
+    Char *initInline(qsizetype size) noexcept
+    {
+        Q_ASSERT(size >= 0 && size <= InlineCapacity);
+        tag = Tag(size);
+        chars[size] = Char();
+        return chars;
+    }
+
+private:
+    enum : Tag { Large = Tag(~Tag(0)) };
+
+    void initInline(const Char *data, qsizetype size) noexcept
+    {
+        if (size)
+            memcpy(chars, data, size_t(size) * sizeof(Char));
+        initInline(size);
+    }
+    template <typename S>
+    void initLarge(S &&str)
+    {
+        new (chars) String(std::forward<S>(str));
+        tag = Large;
+    }
+
+    // chars provides the storage for the String that initLarge() creates.
+    // A union would not do: it would be padded to the alignment of String
+    // before tag, making the storage larger than three pointers.
+    String &large() noexcept { return *launder(reinterpret_cast<String *>(chars)); }
+    const String &large() const noexcept
+    { return *launder(reinterpret_cast<const String *>(chars)); }
+
+    template <typename T>
+    static T *launder(T *p) noexcept
+    {
+#if defined(__cpp_lib_launder) && __cpp_lib_launder >= 201606
+        return std::launder(p);
+#else
+        return p;
+#endif
+    }
+
+    alignas(String) Char chars[InlineCapacity + 1];
+    Tag tag;
+
+    Q_STATIC_ASSERT(sizeof(String) <= sizeof(chars));
+};
+
+} // namespace QtPrivate
+
+class QSmallString
+{
+    typedef QtPrivate::QSmallStringStorage<QString, char16_t, ushort> Storage;
+
+public:
+    typedef QChar value_type;
+    typedef qsizetype size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const QChar &const_reference;
+    typedef const_reference reference;
+    typedef const QChar *const_pointer;
+    typedef const_pointer pointer;
+    typedef const_pointer const_iterator;
+    typedef const_iterator iterator;
+
+    enum { InlineCapacity = Storage::InlineCapacity };
+
+    QSmallString() noexcept {}
+    QSmallString(const QString &str) : d(str) {}
+    QSmallString(QString &&str) : d(std::move(str)) {}
+    QSmallString(const QChar *unicode, qsizetype size)
+        : d(reinterpret_cast<const char16_t *>(unicode), size) {}
+    explicit QSmallString(QStringView str)
+        : d(reinterpret_cast<const char16_t *>(str.utf16()), str.size()) {}
+    inline QSmallString(QLatin1String str);
+
+    QSmallString &operator=(const QString &str) { d = Storage(str); return *this; }
+    QSmallString &operator=(QString &&str) { d = Storage(std::move(str)); return *this; }
+    QSmallString &operator=(QLatin1String str) { return *this = QSmallString(str); }
+
+    void swap(QSmallString &other) noexcept { d.swap(other.d); }
+
+    qsizetype size() const noexcept { return d.size(); }
+    qsizetype length() const noexcept { return d.size(); }
+    bool isEmpty() const noexcept { return !size(); }
+    bool isInline() const noexcept { return !d.isLarge(); }
+    void clear() noexcept { d = Storage(); }
+
+    const QChar *constData() const noexcept { return reinterpret_cast<const QChar *>(d.data()); }
+    const QChar *data() const noexcept { return constData(); }
+    const QChar *unicode() const noexcept { return constData(); }
+    const ushort *utf16() const noexcept { return reinterpret_cast<const ushort *>(d.data()); }
+
+    QChar at(qsizetype i) const { Q_ASSERT(size_t(i) < size_t(size())); return constData()[i]; }
+    QChar operator[](qsizetype i) const { return at(i); }
+    QChar front() const { return at(0); }
+    QChar back() const { return at(size() - 1); }
+
+    const_iterator begin() const noexcept { return constData(); }
+    const_iterator end() const noexcept { return constData() + size(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_iterator constBegin() const noexcept { return begin(); }
+    const_iterator constEnd() const noexcept { return end(); }
+
+    operator QStringView() const noexcept { return QStringView(constData(), size()); }
+    operator QString() const { return toString(); }
+    QString toString() const { return d.toString(); }
+
+    QByteArray toLatin1() const { return QStringView(*this).toLatin1(); }
+    QByteArray toUtf8() const { return QStringView(*this).toUtf8(); }
+
+    friend uint qHash(const QSmallString &key, uint seed = 0) noexcept
+    { return qHash(QStringView(key), seed); }
+
+    friend bool operator==(const QSmallString &lhs, const QSmallString &rhs) noexcept
+    { return lhs.size() == rhs.size() && QtPrivate::compareStrings(lhs, rhs) == 0; }
+    friend bool operator!=(const QSmallString &lhs, const QSmallString &rhs) noexcept { return !(lhs == rhs); }
+    friend bool operator< (const QSmallString &lhs, const QSmallString &rhs) noexcept { return QtPrivate::compareStrings(lhs, rhs) <  0; }
+    friend bool operator<=(const QSmallString &lhs, const QSmallString &rhs) noexcept { return QtPrivate::compareStrings(lhs, rhs) <= 0; }
+    friend bool operator> (const QSmallString &lhs, const QSmallString &rhs) noexcept { return QtPrivate::compareStrings(lhs, rhs) >  0; }
+    friend bool operator>=(const QSmallString &lhs, const QSmallString &rhs) noexcept { return QtPrivate::compareStrings(lhs, rhs) >= 0; }
+
+    friend bool operator==(const QSmallString &lhs, QStringView rhs) noexcept
+    { return lhs.size() == rhs.size() && QtPrivate::compareStrings(lhs, rhs) == 0; }
+    friend bool operator!=(const QSmallString &lhs, QStringView rhs) noexcept { return !(lhs == rhs); }
+    friend bool operator< (const QSmallString &lhs, QStringView rhs) noexcept { return QtPrivate::compareStrings(lhs, rhs) <  0; }
+    friend bool operator<=(const QSmallString &lhs, QStringView rhs) noexcept { return QtPrivate::compareStrings(lhs, rhs) <= 0; }
+    friend bool operator> (const QSmallString &lhs, QStringView rhs) noexcept { return QtPrivate::compareStrings(lhs, rhs) >  0; }
+    friend bool operator>=(const QSmallString &lhs, QStringView rhs) noexcept { return QtPrivate::compareStrings(lhs, rhs) >= 0; }
+
+    friend bool operator==(QStringView lhs, const QSmallString &rhs) noexcept { return rhs == lhs; }
+    friend bool operator!=(QStringView lhs, const QSmallString &rhs) noexcept { return rhs != lhs; }
+    friend bool operator< (QStringView lhs, const QSmallString &rhs) noexcept { return rhs >  lhs; }
+    friend bool operator<=(QStringView lhs, const QSmallString &rhs) noexcept { return rhs >= lhs; }
+    friend bool operator> (QStringView lhs, const QSmallString &rhs) noexcept { return rhs <  lhs; }
+    friend bool operator>=(QStringView lhs, const QSmallString &rhs) noexcept { return rhs <= lhs; }
+
+    friend bool operator==(const QSmallString &lhs, const QString &rhs) noexcept { return lhs == QStringView(rhs); }
+    friend bool operator!=(const QSmallString &lhs, const QString &rhs) noexcept { return lhs != QStringView(rhs); }
+    friend bool operator< (const QSmallString &lhs, const QString &rhs) noexcept { return lhs <  QStringView(rhs); }
+    friend bool operator<=(const QSmallString &lhs, const QString &rhs) noexcept { return lhs <= QStringView(rhs); }
+    friend bool operator> (const QSmallString &lhs, const QString &rhs) noexcept { return lhs >  QStringView(rhs); }
+    friend bool operator>=(const QSmallString &lhs, const QString &rhs) noexcept { return lhs >= QStringView(rhs); }
+
+    friend bool operator==(const QString &lhs, const QSmallString &rhs) noexcept { return rhs == QStringView(lhs); }
+    friend bool operator!=(const QString &lhs, const QSmallString &rhs) noexcept { return rhs != QStringView(lhs); }
+    friend bool operator< (const QString &lhs, const QSmallString &rhs) noexcept { return rhs >  QStringView(lhs); }
+    friend bool operator<=(const QString &lhs, const QSmallString &rhs) noexcept { return rhs >= QStringView(lhs); }
+    friend bool operator> (const QString &lhs, const QSmallString &rhs) noexcept { return rhs <  QStringView(lhs); }
+    friend bool operator>=(const QString &lhs, const QSmallString &rhs) noexcept { return rhs <= QStringView(lhs); }
+
+    friend bool operator==(const QSmallString &lhs, QLatin1String rhs) noexcept
+    { return lhs.size() == rhs.size() && QtPrivate::compareStrings(lhs, rhs) == 0; }
+    friend bool operator!=(const QSmallString &lhs, QLatin1String rhs) noexcept { return !(lhs == rhs); }
+    friend bool operator< (const QSmallString &lhs, QLatin1String rhs) noexcept { return QtPrivate::compareStrings(lhs, rhs) <  0; }
+    friend bool operator<=(const QSmallString &lhs, QLatin1String rhs) noexcept { return QtPrivate::compareStrings(lhs, rhs) <= 0; }
+    friend bool operator> (const QSmallString &lhs, QLatin1String rhs) noexcept { return QtPrivate::compareStrings(lhs, rhs) >  0; }
+    friend bool operator>=(const QSmallString &lhs, QLatin1String rhs) noexcept { return QtPrivate::compareStrings(lhs, rhs) >= 0; }
+
+    friend bool operator==(QLatin1String lhs, const QSmallString &rhs) noexcept { return rhs == lhs; }
+    friend bool operator!=(QLatin1String lhs, const QSmallString &rhs) noexcept { return rhs != lhs; }
+    friend bool operator< (QLatin1String lhs, const QSmallString &rhs) noexcept { return rhs >  lhs; }
+    friend bool operator<=(QLatin1String lhs, const QSmallString &rhs) noexcept { return rhs >= lhs; }
+    friend bool operator> (QLatin1String lhs, const QSmallString &rhs) noexcept { return rhs <  lhs; }
+    friend bool operator>=(QLatin1String lhs, const QSmallString &rhs) noexcept { return rhs <= lhs; }
+
+private:
+    Storage d;
+};
+
+Q_DECLARE_SHARED(QSmallString)
+Q_STATIC_ASSERT(sizeof(QSmallString) == 3 * sizeof(void *));
+
+inline QSmallString::QSmallString(QLatin1String str)
+{
+    if (str.size() > InlineCapacity) {
+        d = Storage(QString(str));
+        return;
+    }
+    char16_t *dst = d.initInline(str.size());
+    for (qsizetype i = 0; i < str.size(); ++i)
+        dst[i] = uchar(str.data()[i]);
+}
+
+class QSmallByteArray
+{
+    typedef QtPrivate::QSmallStringStorage<QByteArray, char, uchar> Storage;
+
+public:
+    typedef char value_type;
+    typedef qsizetype size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const char &const_reference;
+    typedef const_reference reference;
+    typedef const char *const_pointer;
+    typedef const_pointer pointer;
+    typedef const_pointer const_iterator;
+    typedef const_iterator iterator;
+
+    enum { InlineCapacity = Storage::InlineCapacity };
+
+    QSmallByteArray() noexcept {}
+    QSmallByteArray(const QByteArray &ba) : d(ba) {}
+    QSmallByteArray(QByteArray &&ba) : d(std::move(ba)) {}
+    QSmallByteArray(const char *data, qsizetype size = -1)
+        : d(data, size < 0 ? (data ? qsizetype(strlen(data)) : 0) : size) {}
+
+    QSmallByteArray &operator=(const QByteArray &ba) { d = Storage(ba); return *this; }
+    QSmallByteArray &operator=(QByteArray &&ba) { d = Storage(std::move(ba)); return *this; }
+    QSmallByteArray &operator=(const char *str) { return *this = QSmallByteArray(str); }
+
+    void swap(QSmallByteArray &other) noexcept { d.swap(other.d); }
+
+    qsizetype size() const noexcept { return d.size(); }
+    qsizetype length() const noexcept { return d.size(); }
+    bool isEmpty() const noexcept { return !size(); }
+    bool isInline() const noexcept { return !d.isLarge(); }
+    void clear() noexcept { d = Storage(); }
+
+    const char *constData() const noexcept { return d.data(); }
+    const char *data() const noexcept { return d.data(); }
+
+    char at(qsizetype i) const { Q_ASSERT(size_t(i) < size_t(size())); return constData()[i]; }
+    char operator[](qsizetype i) const { return at(i); }
+    char front() const { return at(0); }
+    char back() const { return at(size() - 1); }
+
+    const_iterator begin() const noexcept { return constData(); }
+    const_iterator end() const noexcept { return constData() + size(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const_iterator constBegin() const noexcept { return begin(); }
+    const_iterator constEnd() const noexcept { return end(); }
+
+    operator QByteArray() const { return toByteArray(); }
+    QByteArray toByteArray() const { return d.toString(); }
+
+    friend uint qHash(const QSmallByteArray &key, uint seed = 0) noexcept
+    { return qHashBits(key.constData(), size_t(key.size()), seed); }
+
+    friend bool operator==(const QSmallByteArray &lhs, const QSmallByteArray &rhs) noexcept
+    { return equal(lhs, rhs.constData(), rhs.size()); }
+    friend bool operator!=(const QSmallByteArray &lhs, const QSmallByteArray &rhs) noexcept { return !(lhs == rhs); }
+    friend bool operator< (const QSmallByteArray &lhs, const QSmallByteArray &rhs) noexcept { return compare(lhs, rhs.constData(), rhs.size()) <  0; }
+    friend bool operator<=(const QSmallByteArray &lhs, const QSmallByteArray &rhs) noexcept { return compare(lhs, rhs.constData(), rhs.size()) <= 0; }
+    friend bool operator> (const QSmallByteArray &lhs, const QSmallByteArray &rhs) noexcept { return compare(lhs, rhs.constData(), rhs.size()) >  0; }
+    friend bool operator>=(const QSmallByteArray &lhs, const QSmallByteArray &rhs) noexcept { return compare(lhs, rhs.constData(), rhs.size()) >= 0; }
+
+    friend bool operator==(const QSmallByteArray &lhs, const QByteArray &rhs) noexcept
+    { return equal(lhs, rhs.constData(), rhs.size()); }
+    friend bool operator!=(const QSmallByteArray &lhs, const QByteArray &rhs) noexcept { return !(lhs == rhs); }
+    friend bool operator< (const QSmallByteArray &lhs, const QByteArray &rhs) noexcept { return compare(lhs, rhs.constData(), rhs.size()) <  0; }
+    friend bool operator<=(const QSmallByteArray &lhs, const QByteArray &rhs) noexcept { return compare(lhs, rhs.constData(), rhs.size()) <= 0; }
+    friend bool operator> (const QSmallByteArray &lhs, const QByteArray &rhs) noexcept { return compare(lhs, rhs.constData(), rhs.size()) >  0; }
+    friend bool operator>=(const QSmallByteArray &lhs, const QByteArray &rhs) noexcept { return compare(lhs, rhs.constData(), rhs.size()) >= 0; }
+
+    friend bool operator==(const QByteArray &lhs, const QSmallByteArray &rhs) noexcept { return rhs == lhs; }
+    friend bool operator!=(const QByteArray &lhs, const QSmallByteArray &rhs) noexcept { return rhs != lhs; }
+    friend bool operator< (const QByteArray &lhs, const QSmallByteArray &rhs) noexcept { return rhs >  lhs; }
+    friend bool operator<=(const QByteArray &lhs, const QSmallByteArray &rhs) noexcept { return rhs >= lhs; }
+    friend bool operator> (const QByteArray &lhs, const QSmallByteArray &rhs) noexcept { return rhs <  lhs; }
+    friend bool operator>=(const QByteArray &lhs, const QSmallByteArray &rhs) noexcept { return rhs <= lhs; }
+
+    friend bool operator==(const QSmallByteArray &lhs, const char *rhs) noexcept
+    { return equal(lhs, rhs, qsizetype(qstrlen(rhs))); }
+    friend bool operator!=(const QSmallByteArray &lhs, const char *rhs) noexcept { return !(lhs == rhs); }
+    friend bool operator< (const QSmallByteArray &lhs, const char *rhs) noexcept { return compare(lhs, rhs, qsizetype(qstrlen(rhs))) <  0; }
+    friend bool operator<=(const QSmallByteArray &lhs, const char *rhs) noexcept { return compare(lhs, rhs, qsizetype(qstrlen(rhs))) <= 0; }
+    friend bool operator> (const QSmallByteArray &lhs, const char *rhs) noexcept { return compare(lhs, rhs, qsizetype(qstrlen(rhs))) >  0; }
+    friend bool operator>=(const QSmallByteArray &lhs, const char *rhs) noexcept { return compare(lhs, rhs, qsizetype(qstrlen(rhs))) >= 0; }
+
+    friend bool operator==(const char *lhs, const QSmallByteArray &rhs) noexcept { return rhs == lhs; }
+    friend bool operator!=(const char *lhs, const QSmallByteArray &rhs) noexcept { return rhs != lhs; }
+    friend bool operator< (const char *lhs, const QSmallByteArray &rhs) noexcept { return rhs >  lhs; }
+    friend bool operator<=(const char *lhs, const QSmallByteArray &rhs) noexcept { return rhs >= lhs; }
+    friend bool operator> (const char *lhs, const QSmallByteArray &rhs) noexcept { return rhs <  lhs; }
+    friend bool operator>=(const char *lhs, const QSmallByteArray &rhs) noexcept { return rhs <= lhs; }
+
+private:
+    static int compare(const char *lhs, qsizetype lhsSize,
+                       const char *rhs, qsizetype rhsSize) noexcept
+    {
+        const qsizetype size = qMin(lhsSize, rhsSize);
+        const int r = size ? memcmp(lhs, rhs, size_t(size)) : 0;
+        return r ? r : lhsSize == rhsSize ? 0 : lhsSize < rhsSize ? -1 : 1;
+    }
+    static int compare(const QSmallByteArray &lhs, const char *rhs, qsizetype rhsSize) noexcept
+    { return compare(lhs.constData(), lhs.size(), rhs, rhsSize); }
+    static bool equal(const QSmallByteArray &lhs, const char *rhs, qsizetype rhsSize) noexcept
+    { return lhs.size() == rhsSize && (!rhsSize || memcmp(lhs.constData(), rhs, size_t(rhsSize)) == 0); }
+
+    Storage d;
+};
+
+Q_DECLARE_SHARED(QSmallByteArray)
+Q_STATIC_ASSERT(sizeof(QSmallByteArray) == 3 * sizeof(void *));
+
+QT_END_NAMESPACE
+
+#endif // QSMALLSTRING_H
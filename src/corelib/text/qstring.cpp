@@ -78,6 +78,7 @@
 
 #include "qchar.cpp"
 #include "qstringmatcher.cpp"
+#include "qstringsearch_p.h"
 #include "qstringiterator_p.h"
 #include "qstringalgorithms_p.h"
 #include "qthreadstorage.h"
@@ -11929,6 +11930,11 @@ qsizetype QtPrivate::findString(QStringView haystack0, qsizetype from, QStringVi
     if (sl == 1)
         return qFindChar(haystack0, needle0[0], from, cs);
 
+#ifdef QT_STRING_SEARCH_SIMD
+    if (QtPrivate::canFindStringSimd(needle0, cs))
+        return QtPrivate::findStringSimd(haystack0, from, needle0, cs);
+#endif
+
     /*
         We use the Boyer-Moore algorithm in cases where the overhead
         for the skip table should pay off, otherwise we use a simple
@@ -12104,6 +12110,19 @@ qsizetype QtPrivate::findString(QLatin1String haystack, qsizetype from, QLatin1S
     if (haystack.size() < needle.size())
         return -1;
 
+#ifdef QT_STRING_SEARCH_SIMD
+    // Latin-1 needs no conversion: the case folding of qstrnicmp() agrees
+    // with foldCase() for Latin-1 characters.
+    if (needle.size() >= 2) {
+        if (from < 0)
+            from += haystack.size();
+        if (from < 0 || from + needle.size() > haystack.size())
+            return -1;
+        return QtPrivate::findByteArraySimd(haystack.data(), haystack.size(), from,
+                                            needle.data(), needle.size(), cs);
+    }
+#endif
+
     QVarLengthArray<ushort> h(haystack.size());
     qt_from_latin1(h.data(), haystack.latin1(), haystack.size());
     QVarLengthArray<ushort> n(needle.size());
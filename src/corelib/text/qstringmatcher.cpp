@@ -39,6 +39,7 @@
 ****************************************************************************/
 
 #include "qstringmatcher.h"
+#include "qstringsearch_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -316,6 +317,11 @@ qsizetype QStringMatcher::indexIn(QStringView str, qsizetype from) const
 {
     if (from < 0)
         from = 0;
+#ifdef QT_STRING_SEARCH_SIMD
+    const QStringView pattern(p.uc, p.len);
+    if (from + p.len <= str.size() && QtPrivate::canFindStringSimd(pattern, q_cs))
+        return QtPrivate::findStringSimd(str, from, pattern, q_cs);
+#endif
     return bm_find((const ushort *)str.data(), str.size(), from,
                    (const ushort *)p.uc, p.len,
                    p.q_skiptable, q_cs);
@@ -337,10 +343,14 @@ qsizetype qFindStringBoyerMoore(
     QStringView haystack, qsizetype haystackOffset,
     QStringView needle, Qt::CaseSensitivity cs)
 {
-    uchar skiptable[256];
-    bm_init_skiptable((const ushort *)needle.data(), needle.size(), skiptable, cs);
     if (haystackOffset < 0)
         haystackOffset = 0;
+#ifdef QT_STRING_SEARCH_SIMD
+    if (haystackOffset + needle.size() <= haystack.size() && QtPrivate::canFindStringSimd(needle, cs))
+        return QtPrivate::findStringSimd(haystack, haystackOffset, needle, cs);
+#endif
+    uchar skiptable[256];
+    bm_init_skiptable((const ushort *)needle.data(), needle.size(), skiptable, cs);
     return bm_find((const ushort *)haystack.data(), haystack.size(), haystackOffset,
                    (const ushort *)needle.data(), needle.size(), skiptable, cs);
 }
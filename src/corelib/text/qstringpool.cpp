@@ -0,0 +1,513 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qstringpool.h"
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qvector.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+enum { ShardCount = 16 };
+
+// Hashes the values of the code units, so that a Latin-1 string hashes the
+// same as its UTF-16 conversion. The last steps mix the high bits into the
+// low ones, which select the shard.
+template <typename Char>
+static uint hashUnits(const Char *p, qsizetype size, uint seed) noexcept
+{
+    uint h = seed;
+    for (qsizetype i = 0; i < size; ++i)
+        h = 31 * h + uint(p[i]);
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    return h;
+}
+
+static inline bool equalUnits(const QString &str, const char16_t *p, qsizetype size) noexcept
+{
+    return str.size() == size && memcmp(str.constData(), p, size_t(size) * sizeof(char16_t)) == 0;
+}
+
+static inline bool equalUnits(const QString &str, const uchar *p, qsizetype size) noexcept
+{
+    return str.size() == size
+            && QtPrivate::compareStrings(str, QLatin1String(reinterpret_cast<const char *>(p), int(size))) == 0;
+}
+
+static inline bool equalUnits(const QByteArray &ba, const uchar *p, qsizetype size) noexcept
+{
+    return ba.size() == size && memcmp(ba.constData(), p, size_t(size)) == 0;
+}
+
+static inline void assignUnits(QString &str, const char16_t *p, qsizetype size)
+{
+    str = QString(reinterpret_cast<const QChar *>(p), int(size));
+}
+
+static inline void assignUnits(QString &str, const uchar *p, qsizetype size)
+{
+    str = QString::fromLatin1(reinterpret_cast<const char *>(p), int(size));
+}
+
+static inline void assignUnits(QByteArray &ba, const uchar *p, qsizetype size)
+{
+    ba = QByteArray(reinterpret_cast<const char *>(p), int(size));
+}
+
+// A set of strings, split into shards that each have their own lock and
+// open-addressing table, so that threads interning different strings
+// rarely wait for each other. A null String marks an empty slot.
+template <typename String>
+class InternPool
+{
+    struct Slot
+    {
+        uint hash;
+        String str;
+    };
+
+    struct Shard
+    {
+        QMutex mutex;
+        QVector<Slot> slots; // empty, or a power of two in size
+        qsizetype count = 0;
+    };
+
+public:
+    explicit InternPool(qsizetype maxSize)
+        : seed(uint(qGlobalQHashSeed())), max(maxSize < 0 ? -1 : maxSize)
+    {}
+
+    template <typename Char>
+    String intern(const Char *data, qsizetype size, const String *original = nullptr)
+    {
+        String str;
+        if (size) {
+            const uint h = hashUnits(data, size, seed);
+            Shard &shard = shards[h % ShardCount];
+            QMutexLocker locker(&shard.mutex);
+            if (shard.count) {
+                const Slot &slot = shard.slots.at(findSlot(shard.slots, h, data, size));
+                if (!slot.str.isNull())
+                    return slot.str;
+            }
+
+            if (original)
+                str = *original;
+            else
+                assignUnits(str, data, size);
+            if (reserve())
+                insert(shard, h, str);
+        } else if (original) {
+            str = *original;
+        } else {
+            assignUnits(str, data, size);
+        }
+        return str;
+    }
+
+    template <typename Char>
+    bool contains(const Char *data, qsizetype size) const
+    {
+        if (!size)
+            return false;
+        const uint h = hashUnits(data, size, seed);
+        Shard &shard = shards[h % ShardCount];
+        QMutexLocker locker(&shard.mutex);
+        return shard.count && !shard.slots.at(findSlot(shard.slots, h, data, size)).str.isNull();
+    }
+
+    qsizetype size() const { return total.loadRelaxed(); }
+    qsizetype maxSize() const { return max.loadRelaxed(); }
+    void setMaxSize(qsizetype maxSize) { max.storeRelaxed(maxSize < 0 ? -1 : maxSize); }
+
+    void clear()
+    {
+        for (Shard &shard : shards) {
+            QMutexLocker locker(&shard.mutex);
+            total.fetchAndSubRelaxed(shard.count);
+            shard.slots.clear();
+            shard.count = 0;
+        }
+    }
+
+private:
+    template <typename Char>
+    static int findSlot(const QVector<Slot> &slots, uint h, const Char *data, qsizetype size)
+    {
+        const int mask = slots.size() - 1;
+        for (int i = int(h / ShardCount) & mask; ; i = (i + 1) & mask) {
+            const Slot &slot = slots.at(i);
+            if (slot.str.isNull() || (slot.hash == h && equalUnits(slot.str, data, size)))
+                return i;
+        }
+    }
+
+    static int findEmptySlot(const QVector<Slot> &slots, uint h)
+    {
+        const int mask = slots.size() - 1;
+        int i = int(h / ShardCount) & mask;
+        while (!slots.at(i).str.isNull())
+            i = (i + 1) & mask;
+        return i;
+    }
+
+    // Counts a new string against the maximum size. Returns false if there
+    // is no room for it.
+    bool reserve()
+    {
+        const qsizetype limit = max.loadRelaxed();
+        if (total.fetchAndAddRelaxed(1) >= limit && limit >= 0) {
+            total.deref();
+            return false;
+        }
+        return true;
+    }
+
+    static void insert(Shard &shard, uint h, const String &str)
+    {
+        // keep the table at most half full
+        if (2 * (shard.count + 1) > shard.slots.size()) {
+            QVector<Slot> slots(qMax(16, 2 * shard.slots.size()));
+            for (Slot &slot : shard.slots) {
+                if (!slot.str.isNull()) {
+                    Slot &to = slots[findEmptySlot(slots, slot.hash)];
+                    to.hash = slot.hash;
+                    to.str.swap(slot.str);
+                }
+            }
+            shard.slots.swap(slots);
+        }
+
+        Slot &slot = shard.slots[findEmptySlot(shard.slots, h)];
+        slot.hash = h;
+        slot.str = str;
+        ++shard.count;
+    }
+
+    mutable Shard shards[ShardCount];
+    const uint seed;
+    QAtomicInteger<qsizetype> total;
+    QAtomicInteger<qsizetype> max;
+};
+
+} // unnamed namespace
+
+class QStringPoolPrivate : public InternPool<QString>
+{
+public:
+    using InternPool<QString>::InternPool;
+};
+
+class QByteArrayPoolPrivate : public InternPool<QByteArray>
+{
+public:
+    using InternPool<QByteArray>::InternPool;
+};
+
+/*!
+    \class QStringPool
+    \inmodule QtCore
+    \since 6.0
+    \brief The QStringPool class makes equal strings share their data.
+
+    \ingroup tools
+    \ingroup string-processing
+    \threadsafe
+
+    Parsers often produce the same short strings over and over again, like
+    the keys of JSON objects or the names of XML elements. Each of these
+    strings is a separate allocation when it is converted to a QString.
+    Interning them through a QStringPool makes all the equal strings share
+    one copy of the data.
+
+    intern() returns the pooled string that is equal to its argument,
+    adding a copy of the argument to the pool first if there is none. As
+    QString is implicitly shared, the returned string and the pooled one
+    share their data; copying them only increments an atomic reference
+    count. The pooled data is never modified: changing the returned
+    QString detaches it from the pool, as with any other copy.
+
+    Lookups are done with the characters that are passed in, so interning
+    a QStringView, a QLatin1String, or a QStringRef such as those returned
+    by QXmlStreamReader does not allocate when the string is in the pool
+    already:
+
+    \snippet code/src_corelib_text_qstringpool.cpp 0
+
+    A QStringPool can be used from several threads at the same time. The
+    strings are distributed over several independently locked tables, so
+    that threads seldom wait for each other.
+
+    The pool keeps its strings until it is cleared or destroyed. To bound
+    its memory use when the input is not trusted, give it a maximum size:
+    once the pool holds that many strings, intern() returns copies of the
+    strings that are not in the pool yet without adding them. Empty
+    strings are never added to the pool.
+
+    \sa QByteArrayPool
+*/
+
+/*!
+    Constructs an empty pool that holds at most \a maxSize strings. A
+    negative \a maxSize means there is no limit.
+*/
+QStringPool::QStringPool(qsizetype maxSize)
+    : d(new QStringPoolPrivate(maxSize))
+{
+}
+
+/*!
+    Destroys the pool. The strings returned by intern() stay valid.
+*/
+QStringPool::~QStringPool()
+{
+    delete d;
+}
+
+/*!
+    Returns the string in the pool that is equal to \a str. If there is
+    none, a copy of \a str is added to the pool and returned, unless the
+    pool is full.
+*/
+QString QStringPool::intern(QStringView str)
+{
+    return d->intern(reinterpret_cast<const char16_t *>(str.utf16()), str.size());
+}
+
+/*!
+    \overload
+
+    Looks up the Latin-1 string \a str without converting it to UTF-16
+    first.
+*/
+QString QStringPool::intern(QLatin1String str)
+{
+    return d->intern(reinterpret_cast<const uchar *>(str.data()), str.size());
+}
+
+/*!
+    \overload
+
+    If \a str is not in the pool yet, \a str itself is added to it, so
+    that no data needs to be copied.
+*/
+QString QStringPool::intern(const QString &str)
+{
+    return d->intern(reinterpret_cast<const char16_t *>(str.utf16()), str.size(), &str);
+}
+
+/*!
+    Returns \c true if a string equal to \a str is in the pool; otherwise
+    returns \c false.
+*/
+bool QStringPool::contains(QStringView str) const
+{
+    return d->contains(reinterpret_cast<const char16_t *>(str.utf16()), str.size());
+}
+
+/*!
+    \overload
+*/
+bool QStringPool::contains(QLatin1String str) const
+{
+    return d->contains(reinterpret_cast<const uchar *>(str.data()), str.size());
+}
+
+/*!
+    Returns the number of strings in the pool.
+*/
+qsizetype QStringPool::size() const
+{
+    return d->size();
+}
+
+/*!
+    Returns the maximum number of strings in the pool, or -1 if there is
+    no limit.
+
+    \sa setMaxSize()
+*/
+qsizetype QStringPool::maxSize() const
+{
+    return d->maxSize();
+}
+
+/*!
+    Sets the maximum number of strings in the pool to \a maxSize; a
+    negative value means there is no limit. Lowering the maximum does not
+    remove strings from the pool, but no more strings are added until
+    the pool is smaller than the new maximum.
+
+    \sa maxSize(), clear()
+*/
+void QStringPool::setMaxSize(qsizetype maxSize)
+{
+    d->setMaxSize(maxSize);
+}
+
+/*!
+    Removes all strings from the pool. The strings returned by intern()
+    stay valid.
+*/
+void QStringPool::clear()
+{
+    d->clear();
+}
+
+/*!
+    \class QByteArrayPool
+    \inmodule QtCore
+    \since 6.0
+    \brief The QByteArrayPool class makes equal byte arrays share their
+    data.
+
+    \ingroup tools
+    \ingroup string-processing
+    \threadsafe
+
+    QByteArrayPool is the QByteArray counterpart of QStringPool. It is
+    useful for protocol elements that repeat across messages, like the
+    names of HTTP header fields. Interning a range of bytes that is in the
+    pool already does not allocate.
+
+    \sa QStringPool
+*/
+
+/*!
+    Constructs an empty pool that holds at most \a maxSize byte arrays. A
+    negative \a maxSize means there is no limit.
+*/
+QByteArrayPool::QByteArrayPool(qsizetype maxSize)
+    : d(new QByteArrayPoolPrivate(maxSize))
+{
+}
+
+/*!
+    Destroys the pool. The byte arrays returned by intern() stay valid.
+*/
+QByteArrayPool::~QByteArrayPool()
+{
+    delete d;
+}
+
+/*!
+    Returns the byte array in the pool that is equal to the first \a size
+    bytes at \a data. If there is none, a copy of the bytes is added to
+    the pool and returned, unless the pool is full.
+*/
+QByteArray QByteArrayPool::intern(const char *data, qsizetype size)
+{
+    return d->intern(reinterpret_cast<const uchar *>(data), size);
+}
+
+/*!
+    \overload
+
+    If \a ba is not in the pool yet, \a ba itself is added to it, so that
+    no data needs to be copied.
+*/
+QByteArray QByteArrayPool::intern(const QByteArray &ba)
+{
+    return d->intern(reinterpret_cast<const uchar *>(ba.constData()), ba.size(), &ba);
+}
+
+/*!
+    Returns \c true if a byte array equal to the first \a size bytes at
+    \a data is in the pool; otherwise returns \c false.
+*/
+bool QByteArrayPool::contains(const char *data, qsizetype size) const
+{
+    return d->contains(reinterpret_cast<const uchar *>(data), size);
+}
+
+/*!
+    \fn bool QByteArrayPool::contains(const QByteArray &ba) const
+    \overload
+*/
+
+/*!
+    Returns the number of byte arrays in the pool.
+*/
+qsizetype QByteArrayPool::size() const
+{
+    return d->size();
+}
+
+/*!
+    Returns the maximum number of byte arrays in the pool, or -1 if there
+    is no limit.
+
+    \sa setMaxSize()
+*/
+qsizetype QByteArrayPool::maxSize() const
+{
+    return d->maxSize();
+}
+
+/*!
+    Sets the maximum number of byte arrays in the pool to \a maxSize; a
+    negative value means there is no limit. Lowering the maximum does not
+    remove byte arrays from the pool.
+
+    \sa maxSize(), clear()
+*/
+void QByteArrayPool::setMaxSize(qsizetype maxSize)
+{
+    d->setMaxSize(maxSize);
+}
+
+/*!
+    Removes all byte arrays from the pool. The byte arrays returned by
+    intern() stay valid.
+*/
+void QByteArrayPool::clear()
+{
+    d->clear();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,212 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qstringsearch_p.h"
+
+#include <private/qsimd_p.h>
+
+#include <algorithm>
+
+#ifdef QT_STRING_SEARCH_SIMD
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+struct Sse2Traits16
+{
+    enum { Lanes = 8, LaneShift = 1 };  // _mm_movemask_epi8() sets two bits per lane
+
+    struct Masks
+    {
+        explicit Masks(const QtPrivate::StringSearchFilter<ushort> &f)
+            : first1(_mm_set1_epi16(short(f.first1))), first2(_mm_set1_epi16(short(f.first2))),
+              last1(_mm_set1_epi16(short(f.last1))), last2(_mm_set1_epi16(short(f.last2)))
+        {}
+        __m128i first1, first2, last1, last2;
+    };
+
+    static uint candidates(const ushort *first, const ushort *last, const Masks &m) noexcept
+    {
+        const __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+        const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(last));
+        const __m128i matches = _mm_and_si128(
+                    _mm_or_si128(_mm_cmpeq_epi16(f, m.first1), _mm_cmpeq_epi16(f, m.first2)),
+                    _mm_or_si128(_mm_cmpeq_epi16(l, m.last1), _mm_cmpeq_epi16(l, m.last2)));
+        return uint(_mm_movemask_epi8(matches)) & 0x5555U;
+    }
+};
+
+struct Sse2Traits8
+{
+    enum { Lanes = 16, LaneShift = 0 };
+
+    struct Masks
+    {
+        explicit Masks(const QtPrivate::StringSearchFilter<uchar> &f)
+            : first1(_mm_set1_epi8(char(f.first1))), first2(_mm_set1_epi8(char(f.first2))),
+              last1(_mm_set1_epi8(char(f.last1))), last2(_mm_set1_epi8(char(f.last2)))
+        {}
+        __m128i first1, first2, last1, last2;
+    };
+
+    static uint candidates(const uchar *first, const uchar *last, const Masks &m) noexcept
+    {
+        const __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+        const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i *>(last));
+        const __m128i matches = _mm_and_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(f, m.first1), _mm_cmpeq_epi8(f, m.first2)),
+                    _mm_or_si128(_mm_cmpeq_epi8(l, m.last1), _mm_cmpeq_epi8(l, m.last2)));
+        return uint(_mm_movemask_epi8(matches));
+    }
+};
+
+typedef Sse2Traits16 Traits16;
+typedef Sse2Traits8 Traits8;
+
+// Returns whether c can be matched with a plain comparison against c and
+// c's other case. Besides the ASCII letters, foldCase() maps U+212A KELVIN
+// SIGN to 'k' and U+017F LATIN SMALL LETTER LONG S to 's'; 'i' is left out
+// as well, for U+0130 and U+0131.
+static inline bool isFilterableCaseInsensitive(ushort c) noexcept
+{
+    if (c >= 0x80)
+        return false;
+    const ushort lower = c | 0x20;
+    return lower != 'i' && lower != 'k' && lower != 's';
+}
+
+static inline ushort otherCase(ushort c) noexcept
+{
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+        return c ^ 0x20;
+    return c;
+}
+
+// The other case of a Latin-1 letter, as folded by qstrnicmp()
+static inline uchar latin1OtherCase(uchar c) noexcept
+{
+    if ((c >= 'A' && c <= 'Z') || (c >= 0xc0 && c <= 0xde && c != 0xd7))
+        return c + 0x20;
+    if ((c >= 'a' && c <= 'z') || (c >= 0xe0 && c <= 0xfe && c != 0xf7))
+        return c - 0x20;
+    return c;
+}
+
+static QtPrivate::StringSearchFilter<ushort> stringFilter(QStringView needle, Qt::CaseSensitivity cs) noexcept
+{
+    const ushort *n = reinterpret_cast<const ushort *>(needle.data());
+    qsizetype first = 0;
+    qsizetype last = needle.size() - 1;
+    if (cs == Qt::CaseSensitive)
+        return { first, last, n[first], n[first], n[last], n[last] };
+
+    while (!isFilterableCaseInsensitive(n[first]))
+        ++first;
+    while (!isFilterableCaseInsensitive(n[last]))
+        --last;
+    return { first, last, n[first], otherCase(n[first]), n[last], otherCase(n[last]) };
+}
+
+static QtPrivate::StringSearchFilter<uchar> byteArrayFilter(const uchar *needle, qsizetype needleLen,
+                                                            Qt::CaseSensitivity cs) noexcept
+{
+    const uchar first = needle[0];
+    const uchar last = needle[needleLen - 1];
+    if (cs == Qt::CaseSensitive)
+        return { 0, needleLen - 1, first, first, last, last };
+    return { 0, needleLen - 1, first, latin1OtherCase(first), last, latin1OtherCase(last) };
+}
+
+} // unnamed namespace
+
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+qsizetype qt_findString_avx2(QStringView haystack, qsizetype from, QStringView needle,
+                             const QtPrivate::StringSearchFilter<ushort> &filter,
+                             Qt::CaseSensitivity cs) noexcept;
+qsizetype qt_findByteArray_avx2(const uchar *haystack, qsizetype haystackLen, qsizetype from,
+                                const uchar *needle, qsizetype needleLen,
+                                const QtPrivate::StringSearchFilter<uchar> &filter,
+                                Qt::CaseSensitivity cs) noexcept;
+#endif
+
+bool QtPrivate::canFindStringSimd(QStringView needle, Qt::CaseSensitivity cs) noexcept
+{
+    if (needle.size() < 2)
+        return false;
+    if (cs == Qt::CaseSensitive)
+        return true;
+    const ushort *n = reinterpret_cast<const ushort *>(needle.data());
+    return std::any_of(n, n + needle.size(), isFilterableCaseInsensitive);
+}
+
+qsizetype QtPrivate::findStringSimd(QStringView haystack, qsizetype from, QStringView needle,
+                                    Qt::CaseSensitivity cs) noexcept
+{
+    Q_ASSERT(canFindStringSimd(needle, cs));
+    Q_ASSERT(from >= 0 && from + needle.size() <= haystack.size());
+
+    const StringSearchFilter<ushort> filter = stringFilter(needle, cs);
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+    if (qCpuHasFeature(AVX2))
+        return qt_findString_avx2(haystack, from, needle, filter, cs);
+#endif
+    return findStringWithFilter<Traits16>(haystack, from, needle, filter, cs);
+}
+
+qsizetype QtPrivate::findByteArraySimd(const char *haystack, qsizetype haystackLen, qsizetype from,
+                                       const char *needle, qsizetype needleLen,
+                                       Qt::CaseSensitivity cs) noexcept
+{
+    Q_ASSERT(needleLen >= 2);
+    Q_ASSERT(from >= 0 && from + needleLen <= haystackLen);
+
+    const uchar *h = reinterpret_cast<const uchar *>(haystack);
+    const uchar *n = reinterpret_cast<const uchar *>(needle);
+    const StringSearchFilter<uchar> filter = byteArrayFilter(n, needleLen, cs);
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+    if (qCpuHasFeature(AVX2))
+        return qt_findByteArray_avx2(h, haystackLen, from, n, needleLen, filter, cs);
+#endif
+    return findByteArrayWithFilter<Traits8>(h, haystackLen, from, n, needleLen, filter, cs);
+}
+
+QT_END_NAMESPACE
+
+#endif // QT_STRING_SEARCH_SIMD
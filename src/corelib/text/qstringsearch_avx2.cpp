@@ -0,0 +1,118 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qstringsearch_p.h"
+
+#include <private/qsimd_p.h>
+
+#if defined(QT_COMPILER_SUPPORTS_AVX2) && defined(QT_STRING_SEARCH_SIMD)
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+struct Avx2Traits16
+{
+    enum { Lanes = 16, LaneShift = 1 };  // _mm256_movemask_epi8() sets two bits per lane
+
+    struct Masks
+    {
+        explicit Masks(const QtPrivate::StringSearchFilter<ushort> &f)
+            : first1(_mm256_set1_epi16(short(f.first1))), first2(_mm256_set1_epi16(short(f.first2))),
+              last1(_mm256_set1_epi16(short(f.last1))), last2(_mm256_set1_epi16(short(f.last2)))
+        {}
+        __m256i first1, first2, last1, last2;
+    };
+
+    static uint candidates(const ushort *first, const ushort *last, const Masks &m) noexcept
+    {
+        const __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+        const __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(last));
+        const __m256i matches = _mm256_and_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi16(f, m.first1), _mm256_cmpeq_epi16(f, m.first2)),
+                    _mm256_or_si256(_mm256_cmpeq_epi16(l, m.last1), _mm256_cmpeq_epi16(l, m.last2)));
+        return uint(_mm256_movemask_epi8(matches)) & 0x55555555U;
+    }
+};
+
+struct Avx2Traits8
+{
+    enum { Lanes = 32, LaneShift = 0 };
+
+    struct Masks
+    {
+        explicit Masks(const QtPrivate::StringSearchFilter<uchar> &f)
+            : first1(_mm256_set1_epi8(char(f.first1))), first2(_mm256_set1_epi8(char(f.first2))),
+              last1(_mm256_set1_epi8(char(f.last1))), last2(_mm256_set1_epi8(char(f.last2)))
+        {}
+        __m256i first1, first2, last1, last2;
+    };
+
+    static uint candidates(const uchar *first, const uchar *last, const Masks &m) noexcept
+    {
+        const __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+        const __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(last));
+        const __m256i matches = _mm256_and_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(f, m.first1), _mm256_cmpeq_epi8(f, m.first2)),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(l, m.last1), _mm256_cmpeq_epi8(l, m.last2)));
+        return uint(_mm256_movemask_epi8(matches));
+    }
+};
+
+} // unnamed namespace
+
+qsizetype qt_findString_avx2(QStringView haystack, qsizetype from, QStringView needle,
+                             const QtPrivate::StringSearchFilter<ushort> &filter,
+                             Qt::CaseSensitivity cs) noexcept
+{
+    return QtPrivate::findStringWithFilter<Avx2Traits16>(haystack, from, needle, filter, cs);
+}
+
+qsizetype qt_findByteArray_avx2(const uchar *haystack, qsizetype haystackLen, qsizetype from,
+                                const uchar *needle, qsizetype needleLen,
+                                const QtPrivate::StringSearchFilter<uchar> &filter,
+                                Qt::CaseSensitivity cs) noexcept
+{
+    return QtPrivate::findByteArrayWithFilter<Avx2Traits8>(haystack, haystackLen, from,
+                                                          needle, needleLen, filter, cs);
+}
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,172 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSTRINGSEARCH_P_H
+#define QSTRINGSEARCH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qstringview.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+#if defined(__SSE2__)
+#  define QT_STRING_SEARCH_SIMD
+#endif
+
+#ifdef QT_STRING_SEARCH_SIMD
+namespace QtPrivate {
+
+// Substring search with a SIMD filter on two characters of the needle,
+// usually its first and last one: only the positions where both of them
+// match are compared in full. The functions below require
+// 0 <= from, from + needle length <= haystack length and a needle of at
+// least two characters.
+
+// Returns whether findStringSimd() can search for \a needle. Case
+// insensitive searches need an ASCII character in \a needle to filter on.
+Q_CORE_EXPORT bool canFindStringSimd(QStringView needle, Qt::CaseSensitivity cs) noexcept;
+Q_CORE_EXPORT qsizetype findStringSimd(QStringView haystack, qsizetype from, QStringView needle,
+                                       Qt::CaseSensitivity cs) noexcept;
+
+// Case insensitive searches fold the case of Latin-1 letters, like qstrnicmp().
+Q_CORE_EXPORT qsizetype findByteArraySimd(const char *haystack, qsizetype haystackLen, qsizetype from,
+                                          const char *needle, qsizetype needleLen,
+                                          Qt::CaseSensitivity cs = Qt::CaseSensitive) noexcept;
+
+// The characters to filter on, in both cases
+template <typename Char>
+struct StringSearchFilter
+{
+    qsizetype first;
+    qsizetype last;
+    Char first1, first2;
+    Char last1, last2;
+
+    bool matches(const Char *candidate) const noexcept
+    {
+        const Char f = candidate[first];
+        const Char l = candidate[last];
+        return (f == first1 || f == first2) && (l == last1 || l == last2);
+    }
+};
+
+// Traits::candidates(a, b, masks) returns a mask with bit
+// (lane << Traits::LaneShift) set for each of the Traits::Lanes lanes where
+// a matches the first character of the filter and b the last one.
+template <typename Traits, typename Char, typename Verify>
+qsizetype findWithFilter(const Char *haystack, qsizetype haystackLen, qsizetype from,
+                         qsizetype needleLen, const StringSearchFilter<Char> &filter,
+                         Verify verify) noexcept
+{
+    const qsizetype lastCandidate = haystackLen - needleLen;
+    const typename Traits::Masks masks(filter);
+    qsizetype pos = from;
+    for ( ; pos + Traits::Lanes - 1 <= lastCandidate; pos += Traits::Lanes) {
+        const Char *p = haystack + pos;
+        uint mask = Traits::candidates(p + filter.first, p + filter.last, masks);
+        while (mask) {
+            const qsizetype candidate = pos + (qCountTrailingZeroBits(mask) >> Traits::LaneShift);
+            if (verify(candidate))
+                return candidate;
+            mask &= mask - 1;
+        }
+    }
+    for ( ; pos <= lastCandidate; ++pos) {
+        if (filter.matches(haystack + pos) && verify(pos))
+            return pos;
+    }
+    return -1;
+}
+
+template <typename Traits>
+qsizetype findStringWithFilter(QStringView haystack, qsizetype from, QStringView needle,
+                               const StringSearchFilter<ushort> &filter,
+                               Qt::CaseSensitivity cs) noexcept
+{
+    const ushort *h = reinterpret_cast<const ushort *>(haystack.data());
+    const qsizetype nl = needle.size();
+    if (cs == Qt::CaseSensitive) {
+        const ushort *n = reinterpret_cast<const ushort *>(needle.data());
+        return findWithFilter<Traits>(h, haystack.size(), from, nl, filter, [=](qsizetype pos) {
+            return memcmp(h + pos, n, nl * sizeof(ushort)) == 0;
+        });
+    }
+    return findWithFilter<Traits>(h, haystack.size(), from, nl, filter, [=](qsizetype pos) {
+        return compareStrings(QStringView(h + pos, nl), needle, Qt::CaseInsensitive) == 0;
+    });
+}
+
+template <typename Traits>
+qsizetype findByteArrayWithFilter(const uchar *haystack, qsizetype haystackLen, qsizetype from,
+                                  const uchar *needle, qsizetype needleLen,
+                                  const StringSearchFilter<uchar> &filter,
+                                  Qt::CaseSensitivity cs) noexcept
+{
+    if (cs == Qt::CaseSensitive) {
+        return findWithFilter<Traits>(haystack, haystackLen, from, needleLen, filter, [=](qsizetype pos) {
+            return memcmp(haystack + pos, needle, needleLen) == 0;
+        });
+    }
+    return findWithFilter<Traits>(haystack, haystackLen, from, needleLen, filter, [=](qsizetype pos) {
+        return qstrnicmp(reinterpret_cast<const char *>(haystack + pos), needleLen,
+                         reinterpret_cast<const char *>(needle), needleLen) == 0;
+    });
+}
+
+} // namespace QtPrivate
+#endif // QT_STRING_SEARCH_SIMD
+
+QT_END_NAMESPACE
+
+#endif // QSTRINGSEARCH_P_H
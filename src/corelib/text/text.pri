@@ -1,6 +1,7 @@
 # Qt text / string / character / unicode / byte array module
 
 HEADERS +=  \
+        text/qahocorasick_p.h \
         text/qbytearray.h \
         text/qbytearray_p.h \
         text/qbytearraylist.h \
@@ -13,8 +14,13 @@ HEADERS +=  \
         text/qlocale.h \
         text/qlocale_p.h \
         text/qlocale_tools_p.h \
+        text/qlocale_powers_p.h \
         text/qlocale_data_p.h \
+        text/qmultibytearraymatcher.h \
+        text/qmultistringmatcher.h \
         text/qregexp.h \
+        text/qrope.h \
+        text/qsmallstring.h \
         text/qstring.h \
         text/qstringalgorithms.h \
         text/qstringalgorithms_p.h \
@@ -23,6 +29,8 @@ HEADERS +=  \
         text/qstringlist.h \
         text/qstringliteral.h \
         text/qstringmatcher.h \
+        text/qstringpool.h \
+        text/qstringsearch_p.h \
         text/qstringview.h \
         text/qtextboundaryfinder.h \
         text/qunicodetables_p.h \
@@ -36,15 +44,22 @@ SOURCES += \
         text/qcollator.cpp \
         text/qlocale.cpp \
         text/qlocale_tools.cpp \
+        text/qmultibytearraymatcher.cpp \
+        text/qmultistringmatcher.cpp \
         text/qregexp.cpp \
+        text/qrope.cpp \
         text/qstring.cpp \
         text/qstringbuilder.cpp \
         text/qstringlist.cpp \
+        text/qstringpool.cpp \
+        text/qstringsearch.cpp \
         text/qstringview.cpp \
         text/qtextboundaryfinder.cpp \
         text/qunicodetools.cpp \
         text/qvsnprintf.cpp
 
+AVX2_SOURCES += text/qstringsearch_avx2.cpp
+
 NO_PCH_SOURCES += text/qstring_compat.cpp
 false: SOURCES += $$NO_PCH_SOURCES # Hack for QtCreator
 
@@ -77,7 +92,8 @@ qtConfig(regularexpression) {
     QMAKE_USE_PRIVATE += pcre2
 
     HEADERS += \
-        text/qregularexpression.h
+        text/qregularexpression.h \
+        text/qregularexpression_p.h
     SOURCES += text/qregularexpression.cpp
 }
 
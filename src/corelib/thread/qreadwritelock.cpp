@@ -47,6 +47,8 @@
 #include "qwaitcondition.h"
 #include "qreadwritelock_p.h"
 #include "qelapsedtimer.h"
+#include "qdeadlinetimer.h"
+#include "qfutex_p.h"
 #include "private/qfreelist_p.h"
 #include "private/qlocking_p.h"
 
@@ -62,6 +64,23 @@ QT_BEGIN_NAMESPACE
  *    are waiting, and the lock is not recursive.
  *  - when d_ptr == 0x2: We are locked for write and nobody is waiting. (no contention)
  *  - In any other case, d_ptr points to an actual QReadWriteLockPrivate.
+ *
+ * On systems with futexes, the states above are not used. Instead, the word
+ * of d_ptr holds, as an integer (see qt_futexState()):
+ *  - when it has FutexRecursive set: the lock is recursive, and the word without that bit
+ *    points to its QReadWriteLockPrivate, which handles all the locking.
+ *  - otherwise, the whole state of the lock, in the low 31 bits:
+ *      FutexLockedForWrite   locked for write
+ *      FutexWriterWaiting    a writer waits, so new readers must wait too
+ *      FutexReaderWaiting    a reader waits for the writers to be done
+ *      FutexReaderMask       the number of readers, in units of FutexReader
+ *    so a non-recursive lock never needs a QReadWriteLockPrivate.
+ *
+ * A reader locks with a single fetch-and-add of FutexReader. If that reveals
+ * a writer, the reader subtracts it again and waits. Unlocking for read is a
+ * single fetch-and-sub; the last reader out wakes the waiting writers.
+ * Unlocking for write clears the waiting bits and wakes everybody who waited,
+ * and those threads set the bits again if they have to wait some more.
  */
 
 namespace {
@@ -74,6 +93,129 @@ const auto dummyLockedForRead = reinterpret_cast<QReadWriteLockPrivate *>(quintp
 const auto dummyLockedForWrite = reinterpret_cast<QReadWriteLockPrivate *>(quintptr(StateLockedForWrite));
 inline bool isUncontendedLocked(const QReadWriteLockPrivate *d)
 { return quintptr(d) & StateMask; }
+
+enum : quintptr {
+    FutexRecursive = 0x1,
+    FutexLockedForWrite = 0x2,
+    FutexWriterWaiting = 0x4,
+    FutexReaderWaiting = 0x8,
+    FutexWaitingMask = FutexWriterWaiting | FutexReaderWaiting,
+    FutexReader = 0x10,
+    FutexReaderMask = 0x7ffffff0
+};
+
+inline QReadWriteLockPrivate *futexRecursivePrivate(quintptr v)
+{ return reinterpret_cast<QReadWriteLockPrivate *>(v & ~quintptr(FutexRecursive)); }
+
+// Returns false if the deadline expired.
+bool futexWait(QBasicAtomicInteger<quintptr> &u, quintptr expectedValue, QDeadlineTimer deadline)
+{
+    if (deadline.isForever()) {
+        QtFutex::futexWait(u, expectedValue);
+        return true;
+    }
+    const qint64 remainingTime = deadline.remainingTimeNSecs();
+    return remainingTime > 0 && QtFutex::futexWait(u, expectedValue, remainingTime);
+}
+
+// Clears the waiting bits and wakes all the threads that set them.
+void futexWakeWaiters(QBasicAtomicInteger<quintptr> &u)
+{
+    quintptr v = u.loadRelaxed();
+    while (v & FutexWaitingMask) {
+        if (u.testAndSetRelaxed(v, v & ~quintptr(FutexWaitingMask), v)) {
+            QtFutex::futexWakeAll(u);
+            return;
+        }
+    }
+}
+
+void futexReleaseReader(QBasicAtomicInteger<quintptr> &u)
+{
+    const quintptr v = u.fetchAndSubRelease(FutexReader);
+    Q_ASSERT_X(v & FutexReaderMask, "QReadWriteLock::unlock()", "Cannot unlock an unlocked lock");
+
+    // the last reader out lets the waiting writers in
+    if ((v & FutexReaderMask) == FutexReader && (v & FutexWriterWaiting))
+        QtFutex::futexWakeAll(u);
+}
+
+bool futexLockForRead(QBasicAtomicInteger<quintptr> &u, int timeout)
+{
+    quintptr v = u.fetchAndAddAcquire(FutexReader);
+    Q_ASSERT_X((v & FutexReaderMask) != FutexReaderMask, "QReadWriteLock::tryLockForRead()",
+               "Overflow in lock counter");
+    if (Q_LIKELY(!(v & (FutexLockedForWrite | FutexWriterWaiting))))
+        return true;
+
+    // a writer has or wants the lock, so back off
+    futexReleaseReader(u);
+    if (timeout == 0)
+        return false;
+
+    const QDeadlineTimer deadline(timeout);
+    v = u.loadRelaxed();
+    forever {
+        if (!(v & (FutexLockedForWrite | FutexWriterWaiting))) {
+            if (u.testAndSetAcquire(v, v + FutexReader, v))
+                return true;
+            continue;
+        }
+
+        if (!(v & FutexReaderWaiting)) {
+            if (!u.testAndSetRelaxed(v, v | FutexReaderWaiting, v))
+                continue;
+            v |= FutexReaderWaiting;
+        }
+        if (!futexWait(u, v, deadline))
+            return false;
+        v = u.loadRelaxed();
+    }
+}
+
+bool futexLockForWrite(QBasicAtomicInteger<quintptr> &u, int timeout)
+{
+    quintptr v = 0;
+    if (Q_LIKELY(u.testAndSetAcquire(0, FutexLockedForWrite, v)))
+        return true;
+
+    const QDeadlineTimer deadline(timeout);
+    forever {
+        if (!(v & (FutexLockedForWrite | FutexReaderMask))) {
+            if (u.testAndSetAcquire(v, v | FutexLockedForWrite, v))
+                return true;
+            continue;
+        }
+        if (timeout == 0)
+            return false;
+
+        if (!(v & FutexWriterWaiting)) {
+            if (!u.testAndSetRelaxed(v, v | FutexWriterWaiting, v))
+                continue;
+            v |= FutexWriterWaiting;
+        }
+        if (!futexWait(u, v, deadline)) {
+            // the readers we kept out may have nobody left to wake them
+            futexWakeWaiters(u);
+            return false;
+        }
+        v = u.loadRelaxed();
+    }
+}
+
+void futexUnlock(QBasicAtomicInteger<quintptr> &u, quintptr v)
+{
+    if (!(v & FutexLockedForWrite)) {
+        futexReleaseReader(u);
+        return;
+    }
+
+    // readers backing off may change the count while we unlock
+    while (!u.testAndSetRelease(v, v & ~quintptr(FutexLockedForWrite | FutexWaitingMask), v))
+        ;
+    if (v & FutexWaitingMask)
+        QtFutex::futexWakeAll(u);
+}
 }
 
 /*! \class QReadWriteLock
@@ -145,6 +287,8 @@ QReadWriteLock::QReadWriteLock(RecursionMode recursionMode)
     : d_ptr(recursionMode == Recursive ? new QReadWriteLockPrivate(true) : nullptr)
 {
     Q_ASSERT_X(!(quintptr(d_ptr.loadRelaxed()) & StateMask), "QReadWriteLock::QReadWriteLock", "bad d_ptr alignment");
+    if (QtFutex::futexAvailable() && recursionMode == Recursive)
+        qt_futexState(d_ptr).fetchAndOrRelaxed(FutexRecursive);
 }
 
 /*!
@@ -155,6 +299,15 @@ QReadWriteLock::QReadWriteLock(RecursionMode recursionMode)
 */
 QReadWriteLock::~QReadWriteLock()
 {
+    if (QtFutex::futexAvailable()) {
+        const quintptr v = qt_futexState(d_ptr).loadRelaxed();
+        if (v & FutexRecursive)
+            delete futexRecursivePrivate(v);
+        else if (v & (FutexLockedForWrite | FutexReaderMask))
+            qWarning("QReadWriteLock: destroying locked QReadWriteLock");
+        return;
+    }
+
     auto d = d_ptr.loadRelaxed();
     if (isUncontendedLocked(d)) {
         qWarning("QReadWriteLock: destroying locked QReadWriteLock");
@@ -174,6 +327,15 @@ QReadWriteLock::~QReadWriteLock()
 */
 void QReadWriteLock::lockForRead()
 {
+    if (QtFutex::futexAvailable()) {
+        const quintptr v = qt_futexState(d_ptr).loadRelaxed();
+        if (Q_UNLIKELY(v & FutexRecursive))
+            futexRecursivePrivate(v)->recursiveLockForRead(-1);
+        else
+            futexLockForRead(qt_futexState(d_ptr), -1);
+        return;
+    }
+
     if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead))
         return;
     tryLockForRead(-1);
@@ -221,6 +383,13 @@ bool QReadWriteLock::tryLockForRead()
 */
 bool QReadWriteLock::tryLockForRead(int timeout)
 {
+    if (QtFutex::futexAvailable()) {
+        const quintptr v = qt_futexState(d_ptr).loadRelaxed();
+        if (Q_UNLIKELY(v & FutexRecursive))
+            return futexRecursivePrivate(v)->recursiveLockForRead(timeout);
+        return futexLockForRead(qt_futexState(d_ptr), timeout);
+    }
+
     // Fast case: non contended:
     QReadWriteLockPrivate *d;
     if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForRead, d))
@@ -335,6 +504,13 @@ bool QReadWriteLock::tryLockForWrite()
 */
 bool QReadWriteLock::tryLockForWrite(int timeout)
 {
+    if (QtFutex::futexAvailable()) {
+        const quintptr v = qt_futexState(d_ptr).loadRelaxed();
+        if (Q_UNLIKELY(v & FutexRecursive))
+            return futexRecursivePrivate(v)->recursiveLockForWrite(timeout);
+        return futexLockForWrite(qt_futexState(d_ptr), timeout);
+    }
+
     // Fast case: non contended:
     QReadWriteLockPrivate *d;
     if (d_ptr.testAndSetAcquire(nullptr, dummyLockedForWrite, d))
@@ -392,6 +568,15 @@ bool QReadWriteLock::tryLockForWrite(int timeout)
 */
 void QReadWriteLock::unlock()
 {
+    if (QtFutex::futexAvailable()) {
+        const quintptr v = qt_futexState(d_ptr).loadRelaxed();
+        if (Q_UNLIKELY(v & FutexRecursive))
+            futexRecursivePrivate(v)->recursiveUnlock();
+        else
+            futexUnlock(qt_futexState(d_ptr), v);
+        return;
+    }
+
     QReadWriteLockPrivate *d = d_ptr.loadAcquire();
     while (true) {
         Q_ASSERT_X(d, "QReadWriteLock::unlock()", "Cannot unlock an unlocked lock");
@@ -445,10 +630,23 @@ void QReadWriteLock::unlock()
 /*! \internal  Helper for QWaitCondition::wait */
 QReadWriteLock::StateForWaitCondition QReadWriteLock::stateForWaitCondition() const
 {
-    QReadWriteLockPrivate *d = d_ptr.loadRelaxed();
-    switch (quintptr(d) & StateMask) {
-    case StateLockedForRead: return LockedForRead;
-    case StateLockedForWrite: return LockedForWrite;
+    QReadWriteLockPrivate *d;
+    if (QtFutex::futexAvailable()) {
+        auto &state = qt_futexState(const_cast<QAtomicPointer<QReadWriteLockPrivate> &>(d_ptr));
+        const quintptr v = state.loadRelaxed();
+        if (v & FutexRecursive) {
+            d = futexRecursivePrivate(v);
+        } else {
+            if (v & FutexLockedForWrite)
+                return LockedForWrite;
+            return (v & FutexReaderMask) ? LockedForRead : Unlocked;
+        }
+    } else {
+        d = d_ptr.loadRelaxed();
+        switch (quintptr(d) & StateMask) {
+        case StateLockedForRead: return LockedForRead;
+        case StateLockedForWrite: return LockedForWrite;
+        }
     }
 
     if (!d)
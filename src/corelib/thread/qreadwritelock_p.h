@@ -53,6 +53,7 @@
 //
 
 #include <QtCore/private/qglobal_p.h>
+#include <QtCore/qatomic.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qwaitcondition.h>
 
@@ -95,6 +96,18 @@ public:
     void recursiveUnlock();
 };
 
+// On systems with futexes, a non-recursive QReadWriteLock keeps its whole
+// state in the word of its d_ptr instead of pointing to a
+// QReadWriteLockPrivate (see qreadwritelock.cpp). Such a lock only ever
+// accesses that word through the integer returned here.
+inline QBasicAtomicInteger<quintptr> &
+qt_futexState(QAtomicPointer<QReadWriteLockPrivate> &d_ptr) noexcept
+{
+    Q_STATIC_ASSERT(sizeof(QBasicAtomicInteger<quintptr>)
+                    == sizeof(QAtomicPointer<QReadWriteLockPrivate>));
+    return *reinterpret_cast<QBasicAtomicInteger<quintptr> *>(&d_ptr);
+}
+
 QT_END_NAMESPACE
 
 #endif // QREADWRITELOCK_P_H
@@ -48,6 +48,7 @@
 
 #include "qthread_p.h"
 #include "private/qcoreapplication_p.h"
+#include "private/qeventloopstatistics_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -57,7 +58,7 @@ QT_BEGIN_NAMESPACE
 
 QThreadData::QThreadData(int initialRefCount)
     : _ref(initialRefCount), loopLevel(0), scopeLevel(0),
-      eventDispatcher(0),
+      eventDispatcher(0), loopStatistics(nullptr),
       quitNow(false), canWait(true), isAdopted(false), requiresCoreApplication(true)
 {
     // fprintf(stderr, "QThreadData %p created\n", this);
@@ -89,6 +90,7 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
+    postEventList.mergeIncoming();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -98,6 +100,8 @@ QThreadData::~QThreadData()
         }
     }
 
+    delete loopStatistics.loadAcquire();
+
     // fprintf(stderr, "QThreadData %p destroyed\n", this);
 }
 
@@ -117,6 +121,46 @@ void QThreadData::deref()
 #endif
 }
 
+/*
+  QMetaCallStoragePool
+*/
+
+QMetaCallStoragePool::~QMetaCallStoragePool()
+{
+    while (FreeBlock *block = freeList) {
+        freeList = block->next;
+        ::operator delete(block);
+    }
+}
+
+void *QMetaCallStoragePool::allocate()
+{
+    {
+        QMutexLocker locker(&mutex);
+        if (FreeBlock *block = freeList) {
+            freeList = block->next;
+            --cachedBlocks;
+            return block;
+        }
+    }
+    return ::operator new(BlockSize);
+}
+
+void QMetaCallStoragePool::release(void *block)
+{
+    {
+        QMutexLocker locker(&mutex);
+        if (cachedBlocks < MaxCachedBlocks) {
+            FreeBlock *freeBlock = static_cast<FreeBlock *>(block);
+            freeBlock->next = freeList;
+            freeList = freeBlock;
+            ++cachedBlocks;
+            return;
+        }
+    }
+    ::operator delete(block);
+}
+
 QAbstractEventDispatcher *QThreadData::createEventDispatcher()
 {
     QAbstractEventDispatcher *ed = QThreadPrivate::createEventDispatcher(this);
@@ -58,6 +58,7 @@
 #include "QtCore/qmutex.h"
 #include "QtCore/qstack.h"
 #if QT_CONFIG(thread)
+#include "QtCore/qsemaphore.h"
 #include "QtCore/qwaitcondition.h"
 #endif
 #include "QtCore/qmap.h"
@@ -81,6 +82,7 @@ QT_BEGIN_NAMESPACE
 
 class QAbstractEventDispatcher;
 class QEventLoop;
+class QEventLoopStatisticsData;
 
 class QPostEvent
 {
@@ -117,10 +119,103 @@ public:
 
     QMutex mutex;
 
+    // Meta-call events posted with pushIncoming() wait here, newest first,
+    // linked through the event itself, until someone holding the mutex
+    // calls mergeIncoming().
+    QAtomicPointer<QAbstractMetaCallEvent> incoming;
+    // number of threads inside QCoreApplication::postEvent()'s lock-free
+    // path, or'ed with IncomingClosed while QObject::moveToThread() runs
+    QAtomicInt incomingPosters;
+    enum { IncomingClosed = 0x40000000 };
+#if QT_CONFIG(thread)
+    // released by the last poster to leave once the path is closed
+    QSemaphore incomingDrained;
+#endif
+
     inline QPostEventList()
         : QVector<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0)
     { }
 
+    bool hasIncomingEvents() const
+    {
+        return incoming.loadAcquire() != nullptr;
+    }
+
+    void pushIncoming(QObject *receiver, QAbstractMetaCallEvent *event)
+    {
+        event->postedReceiver_ = receiver;
+        // don't let testAndSet write to the event: once published, it
+        // belongs to whoever merges it
+        QAbstractMetaCallEvent *head = incoming.loadRelaxed();
+        do {
+            event->postedNext_ = head;
+        } while (!incoming.testAndSetRelease(head, event, head));
+    }
+
+    // moves the incoming events into the sorted list, the mutex must be held
+    bool mergeIncoming()
+    {
+        if (!hasIncomingEvents())
+            return false;
+        QAbstractMetaCallEvent *event = incoming.fetchAndStoreAcquire(nullptr);
+
+        // restore the posting order
+        QAbstractMetaCallEvent *first = nullptr;
+        while (event) {
+            QAbstractMetaCallEvent *next = event->postedNext_;
+            event->postedNext_ = first;
+            first = event;
+            event = next;
+        }
+
+        while (first) {
+            QAbstractMetaCallEvent *next = first->postedNext_;
+            first->postedNext_ = nullptr;
+            addEvent(QPostEvent(first->postedReceiver_, first, Qt::NormalEventPriority));
+            ++QObjectPrivate::get(first->postedReceiver_)->postedEvents;
+            first = next;
+        }
+        return true;
+    }
+
+    // Enters the lock-free path. Returns false if closeIncoming() was
+    // called, in which case the poster has to take the mutex instead.
+    bool beginIncoming()
+    {
+        int state = incomingPosters.loadRelaxed();
+        do {
+            if (state & IncomingClosed)
+                return false;
+        } while (!incomingPosters.testAndSetOrdered(state, state + 1, state));
+        return true;
+    }
+
+    void endIncoming()
+    {
+        if (incomingPosters.fetchAndSubOrdered(1) == IncomingClosed + 1) {
+#if QT_CONFIG(thread)
+            incomingDrained.release();
+#endif
+        }
+    }
+
+    // Turns new posters away to the mutex, which the caller must hold, and
+    // waits for the ones already on the lock-free path. Posters are never
+    // blocked there, so this does not depend on posting ever stopping.
+    void closeIncoming()
+    {
+        if (incomingPosters.fetchAndOrOrdered(IncomingClosed) != 0) {
+#if QT_CONFIG(thread)
+            incomingDrained.acquire();
+#endif
+        }
+    }
+
+    void reopenIncoming()
+    {
+        incomingPosters.storeRelease(0);
+    }
+
     void addEvent(const QPostEvent &ev) {
         int priority = ev.priority;
         if (isEmpty() ||
@@ -239,6 +334,32 @@ public:
 
 #endif // QT_CONFIG(thread)
 
+// Fixed-size blocks that hold the arguments of batched queued meta-calls
+// (see QMetaCallBatch). Emitting threads take blocks from the pool of the
+// receiver's thread; the blocks come back when the event is destroyed after
+// delivery, so a steady stream of emissions stops allocating.
+class QMetaCallStoragePool
+{
+    Q_DISABLE_COPY_MOVE(QMetaCallStoragePool)
+public:
+    enum { BlockSize = 4096, MaxCachedBlocks = 32 };
+
+    QMetaCallStoragePool() = default;
+    ~QMetaCallStoragePool();
+
+    void *allocate();
+    void release(void *block);
+
+private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    QBasicMutex mutex;
+    FreeBlock *freeList = nullptr;
+    int cachedBlocks = 0;
+};
+
 class QThreadData
 {
 public:
@@ -270,7 +391,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.hasIncomingEvents();
     }
 
     // This class provides per-thread (by way of being a QThreadData
@@ -307,6 +428,8 @@ public:
     QAtomicPointer<QAbstractEventDispatcher> eventDispatcher;
     QVector<void *> tls;
     FlaggedDebugSignatures flaggedSignatures;
+    QMetaCallStoragePool metaCallStoragePool;
+    QAtomicPointer<QEventLoopStatisticsData> loopStatistics;
 
     bool quitNow;
     bool canWait;
@@ -54,6 +54,12 @@
 #endif
 
 #include <private/qeventdispatcher_unix_p.h>
+#if QT_CONFIG(epoll)
+#  include <private/qeventdispatcher_epoll_p.h>
+#endif
+#if QT_CONFIG(io_uring)
+#  include <private/qeventdispatcher_iouring_p.h>
+#endif
 
 #include "qthreadstorage.h"
 
@@ -256,6 +262,14 @@ typedef void*(*QtThreadCallback)(void*);
 QAbstractEventDispatcher *QThreadPrivate::createEventDispatcher(QThreadData *data)
 {
     Q_UNUSED(data);
+#if QT_CONFIG(io_uring)
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_IO_URING") > 0)
+        return new QEventDispatcherIoUring;
+#endif
+#if QT_CONFIG(epoll)
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") > 0)
+        return new QEventDispatcherEpoll;
+#endif
 #if defined(Q_OS_DARWIN)
     bool ok = false;
     int value = qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_CORE_FOUNDATION", &ok);
@@ -56,12 +56,31 @@ public:
     QThreadPoolThread(QThreadPoolPrivate *manager);
     void run() override;
     void registerThreadInactive();
+    void acceptWork();
+
+    quint32 nextRandom()
+    {
+        // xorshift32, good enough to spread the steal attempts
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+        return randomState;
+    }
 
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // work-stealing mode: the owner pushes and pops at the back, thieves
+    // and retireLocalQueue() take from the front
+    QMutex localMutex;
+    QList<QRunnable *> localQueue;
+    bool acceptsWork = false;
+    quint32 randomState;
 };
 
+static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+
 /*
     QThreadPool private class.
 */
@@ -71,7 +90,8 @@ public:
     \internal
 */
 QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
-    :manager(manager), runnable(nullptr)
+    :manager(manager), runnable(nullptr),
+     randomState(quint32(quintptr(this) >> 4) | 1)
 {
     setStackSize(manager->stackSize);
 }
@@ -81,8 +101,11 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+    currentPoolThread = this;
+
     QMutexLocker locker(&manager->mutex);
     for(;;) {
+        acceptWork();
         QRunnable *r = runnable;
         runnable = nullptr;
 
@@ -106,16 +129,35 @@ void QThreadPoolThread::run()
                     throw;
                 }
 #endif
-                locker.relock();
-
-                if (autoDelete && !--r->ref)
+                if (autoDelete && !r->ref.deref())
                     delete r;
+
+                // In work-stealing mode, keep going without the pool lock
+                // as long as there is local work and nothing with a higher
+                // priority is waiting in the global queue.
+                if (manager->workStealing.loadRelaxed()
+                        && manager->queuedPriority.loadAcquire() < 0
+                        && (r = manager->takeLocalWork(this))) {
+                    continue;
+                }
+
+                locker.relock();
             }
 
             // if too many threads are active, expire this thread
             if (manager->tooManyThreadsActive())
                 break;
 
+            // local work has the default priority 0, so it comes before
+            // any lower-priority tasks in the global queue
+            if (manager->workStealing.loadRelaxed() && manager->queuedPriority.loadRelaxed() < 0) {
+                r = manager->takeLocalWork(this);
+                if (!r)
+                    r = manager->stealWork(this);
+                if (r)
+                    continue;
+            }
+
             if (manager->queue.isEmpty()) {
                 r = nullptr;
                 break;
@@ -128,18 +170,32 @@ void QThreadPoolThread::run()
                 manager->queue.removeFirst();
                 delete page;
             }
+            manager->updateHints();
         } while (true);
 
+        // hand any work that is still queued locally over to the others
+        if (manager->retireLocalQueue(this) && !manager->tooManyThreadsActive())
+            continue;
+
         // if too many threads are active, expire this thread
         bool expired = manager->tooManyThreadsActive();
         if (!expired) {
             manager->waitingThreads.enqueue(this);
             registerThreadInactive();
+            manager->updateHints();
+            // a thief may have been needed just before we became idle
+            if (manager->workStealing.loadRelaxed() && manager->hasLocalWork()) {
+                manager->waitingThreads.removeOne(this);
+                ++manager->activeThreads;
+                manager->updateHints();
+                continue;
+            }
             // wait for work, exiting after the expiry timeout is reached
             runnableReady.wait(locker.mutex(), manager->expiryTimeout);
             ++manager->activeThreads;
             if (manager->waitingThreads.removeOne(this))
                 expired = true;
+            manager->updateHints();
             if (!manager->allThreads.contains(this)) {
                 registerThreadInactive();
                 break;
@@ -148,11 +204,18 @@ void QThreadPoolThread::run()
         if (expired) {
             manager->expiredThreads.enqueue(this);
             registerThreadInactive();
+            manager->updateHints();
             break;
         }
     }
 }
 
+void QThreadPoolThread::acceptWork()
+{
+    QMutexLocker localLocker(&localMutex);
+    acceptsWork = true;
+}
+
 void QThreadPoolThread::registerThreadInactive()
 {
     if (--manager->activeThreads == 0)
@@ -164,7 +227,9 @@ void QThreadPoolThread::registerThreadInactive()
     \internal
 */
 QThreadPoolPrivate:: QThreadPoolPrivate()
-{ }
+{
+    spareThreads.storeRelaxed(maxThreadCount);
+}
 
 bool QThreadPoolPrivate::tryStart(QRunnable *task)
 {
@@ -183,6 +248,7 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
         // recycle an available thread
         enqueueTask(task);
         waitingThreads.takeFirst()->runnableReady.wakeOne();
+        updateHints();
         return true;
     }
 
@@ -194,9 +260,10 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
         ++activeThreads;
 
         if (task->autoDelete())
-            ++task->ref;
+            task->ref.ref();
         thread->runnable = task;
         thread->start();
+        updateHints();
         return true;
     }
 
@@ -214,8 +281,18 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
 {
     Q_ASSERT(runnable != nullptr);
     if (runnable->autoDelete())
-        ++runnable->ref;
+        runnable->ref.ref();
+
+    insertIntoQueue(runnable, priority);
+}
+
+/*!
+    \internal
 
+    Adds \a runnable to the global queue without taking a reference.
+*/
+void QThreadPoolPrivate::insertIntoQueue(QRunnable *runnable, int priority)
+{
     for (QueuePage *page : qAsConst(queue)) {
         if (page->priority() == priority && !page->isFull()) {
             page->push(runnable);
@@ -224,6 +301,7 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
     }
     auto it = std::upper_bound(queue.constBegin(), queue.constEnd(), priority, comparePriority);
     queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
+    updateHints();
 }
 
 int QThreadPoolPrivate::activeThreadCount() const
@@ -249,6 +327,7 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
             delete page;
         }
     }
+    updateHints();
 }
 
 bool QThreadPoolPrivate::tooManyThreadsActive() const
@@ -262,17 +341,19 @@ bool QThreadPoolPrivate::tooManyThreadsActive() const
 */
 void QThreadPoolPrivate::startThread(QRunnable *runnable)
 {
-    Q_ASSERT(runnable != nullptr);
     QScopedPointer <QThreadPoolThread> thread(new QThreadPoolThread(this));
     thread->setObjectName(QLatin1String("Thread (pooled)"));
     Q_ASSERT(!allThreads.contains(thread.data())); // if this assert hits, we have an ABA problem (deleted threads don't get removed here)
     allThreads.insert(thread.data());
     ++activeThreads;
 
-    if (runnable->autoDelete())
-        ++runnable->ref;
+    stealTargets.append(thread.data());
+
+    if (runnable && runnable->autoDelete())
+        runnable->ref.ref();
     thread->runnable = runnable;
     thread.take()->start();
+    updateHints();
 }
 
 /*!
@@ -287,6 +368,10 @@ void QThreadPoolPrivate::reset()
     allThreadsCopy.swap(allThreads);
     expiredThreads.clear();
     waitingThreads.clear();
+
+    stealTargets.clear();
+    injectIndex = 0;
+    updateHints();
     mutex.unlock();
 
     for (QThreadPoolThread *thread: qAsConst(allThreadsCopy)) {
@@ -334,12 +419,25 @@ void QThreadPoolPrivate::clear()
     for (QueuePage *page : qAsConst(queue)) {
         while (!page->isFinished()) {
             QRunnable *r = page->pop();
-            if (r && r->autoDelete() && !--r->ref)
+            if (r && r->autoDelete() && !r->ref.deref())
                 delete r;
         }
     }
     qDeleteAll(queue);
     queue.clear();
+
+    for (QThreadPoolThread *thread : qAsConst(stealTargets)) {
+        QList<QRunnable *> pending;
+        {
+            QMutexLocker localLocker(&thread->localMutex);
+            pending.swap(thread->localQueue);
+        }
+        for (QRunnable *r : qAsConst(pending)) {
+            if (r->autoDelete() && !r->ref.deref())
+                delete r;
+        }
+    }
+    updateHints();
 }
 
 /*!
@@ -374,8 +472,18 @@ bool QThreadPool::tryTake(QRunnable *runnable)
                     d->queue.removeOne(page);
                     delete page;
                 }
+                d->updateHints();
                 if (runnable->autoDelete())
-                    --runnable->ref; // undo ++ref in start()
+                    runnable->ref.deref(); // undo ref() in start()
+                return true;
+            }
+        }
+
+        for (QThreadPoolThread *thread : qAsConst(d->stealTargets)) {
+            QMutexLocker localLocker(&thread->localMutex);
+            if (thread->localQueue.removeOne(runnable)) {
+                if (runnable->autoDelete())
+                    runnable->ref.deref(); // undo ref() in start()
                 return true;
             }
         }
@@ -395,7 +503,7 @@ void QThreadPoolPrivate::stealAndRunRunnable(QRunnable *runnable)
     Q_Q(QThreadPool);
     if (!q->tryTake(runnable))
         return;
-    const bool del = runnable->autoDelete() && !runnable->ref; // tryTake already deref'ed
+    const bool del = runnable->autoDelete() && !runnable->ref.loadRelaxed(); // tryTake already deref'ed
 
     runnable->run();
 
@@ -404,6 +512,175 @@ void QThreadPoolPrivate::stealAndRunRunnable(QRunnable *runnable)
     }
 }
 
+/*!
+    \internal
+
+    Refreshes the hints that let the work-stealing code avoid the pool
+    mutex. Must be called with the mutex held, whenever the queue or the
+    thread counts change.
+*/
+void QThreadPoolPrivate::updateHints()
+{
+    queuedPriority.storeRelease(queue.isEmpty() ? int(EmptyQueuePriority)
+                                                : queue.first()->priority());
+    spareThreads.storeRelease(maxThreadCount - activeThreadCount());
+}
+
+/*!
+    \internal
+
+    Queues \a runnable at the back of the calling worker's own queue,
+    without taking the pool mutex. A worker cannot be deleted while it
+    runs, so this is safe without the pool mutex.
+
+    Returns \c false if the caller is not a worker of this pool.
+*/
+bool QThreadPoolPrivate::tryPushLocal(QRunnable *runnable)
+{
+    QThreadPoolThread *self = currentPoolThread;
+    if (!self || self->manager != this)
+        return false;
+
+    if (runnable->autoDelete())
+        runnable->ref.ref();
+    {
+        QMutexLocker localLocker(&self->localMutex);
+        self->localQueue.append(runnable);
+    }
+
+    if (spareThreads.loadAcquire() > 0)
+        wakeThief();
+    return true;
+}
+
+/*!
+    \internal
+
+    Hands \a runnable, queued from outside the pool while all threads are
+    busy, to the front of a busy worker's own queue so that idle workers
+    can steal it. Must be called with the pool mutex held.
+
+    Returns \c false if no worker accepts work.
+*/
+bool QThreadPoolPrivate::injectIntoBusyThread(QRunnable *runnable)
+{
+    const int count = stealTargets.size();
+    for (int i = 0; i < count; ++i) {
+        QThreadPoolThread *thread = stealTargets.at((injectIndex + i) % count);
+        QMutexLocker localLocker(&thread->localMutex);
+        if (thread->acceptsWork) {
+            if (runnable->autoDelete())
+                runnable->ref.ref();
+            thread->localQueue.prepend(runnable);
+            injectIndex = (injectIndex + i + 1) % count;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+    \internal
+
+    Wakes up or starts a thread that will look for work to steal.
+*/
+void QThreadPoolPrivate::wakeThief()
+{
+    QMutexLocker locker(&mutex);
+    if (activeThreadCount() >= maxThreadCount && !allThreads.isEmpty())
+        return;
+
+    if (!waitingThreads.isEmpty()) {
+        waitingThreads.takeFirst()->runnableReady.wakeOne();
+    } else if (!expiredThreads.isEmpty()) {
+        QThreadPoolThread *thread = expiredThreads.dequeue();
+        Q_ASSERT(thread->runnable == nullptr);
+        ++activeThreads;
+        thread->start();
+    } else {
+        startThread();
+    }
+    updateHints();
+}
+
+/*!
+    \internal
+
+    Returns the most recently queued runnable of \a thread's own queue, or
+    \nullptr if it is empty. Must be called from \a thread itself; the pool
+    mutex may or may not be held.
+*/
+QRunnable *QThreadPoolPrivate::takeLocalWork(QThreadPoolThread *thread)
+{
+    QMutexLocker localLocker(&thread->localMutex);
+    if (!thread->localQueue.isEmpty())
+        return thread->localQueue.takeLast();
+    return nullptr;
+}
+
+/*!
+    \internal
+
+    Takes the oldest runnable from the queue of another worker, starting
+    with a random victim. Must be called with the pool mutex held, which
+    keeps reset() from deleting the victims.
+*/
+QRunnable *QThreadPoolPrivate::stealWork(QThreadPoolThread *thief)
+{
+    const int count = stealTargets.size();
+    if (count == 0)
+        return nullptr;
+
+    const uint first = thief->nextRandom() % uint(count);
+    for (int i = 0; i < count; ++i) {
+        QThreadPoolThread *victim = stealTargets.at((first + i) % count);
+        if (victim == thief)
+            continue;
+        QMutexLocker localLocker(&victim->localMutex);
+        if (!victim->localQueue.isEmpty())
+            return victim->localQueue.takeFirst();
+    }
+    return nullptr;
+}
+
+/*!
+    \internal
+
+    Returns \c true if any worker has runnables in its own queue. Must be
+    called with the pool mutex held.
+*/
+bool QThreadPoolPrivate::hasLocalWork() const
+{
+    for (QThreadPoolThread *thread : stealTargets) {
+        QMutexLocker localLocker(&thread->localMutex);
+        if (!thread->localQueue.isEmpty())
+            return true;
+    }
+    return false;
+}
+
+/*!
+    \internal
+
+    Stops \a thread from accepting injected work and moves whatever is left
+    in its own queue to the global queue. Must be called with the pool mutex
+    held, before the thread goes idle or expires. Returns \c true if any
+    runnable was moved.
+*/
+bool QThreadPoolPrivate::retireLocalQueue(QThreadPoolThread *thread)
+{
+    QList<QRunnable *> pending;
+    {
+        QMutexLocker localLocker(&thread->localMutex);
+        thread->acceptsWork = false;
+        pending.swap(thread->localQueue);
+    }
+
+    for (QRunnable *r : qAsConst(pending))
+        insertIntoQueue(r, 0);
+    return !pending.isEmpty();
+}
+
 /*!
     \class QThreadPool
     \inmodule QtCore
@@ -502,12 +779,18 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (priority == 0 && d->workStealing.loadRelaxed() && d->tryPushLocal(runnable))
+        return;
+
     QMutexLocker locker(&d->mutex);
     if (!d->tryStart(runnable)) {
+        if (priority == 0 && d->workStealing.loadRelaxed() && d->injectIntoBusyThread(runnable))
+            return;
         d->enqueueTask(runnable, priority);
 
         if (!d->waitingThreads.isEmpty())
             d->waitingThreads.takeFirst()->runnableReady.wakeOne();
+        d->updateHints();
     }
 }
 
@@ -633,6 +916,7 @@ void QThreadPool::reserveThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     ++d->reservedThreads;
+    d->updateHints();
 }
 
 /*! \property QThreadPool::stackSize
@@ -661,6 +945,43 @@ uint QThreadPool::stackSize() const
     return d->stackSize;
 }
 
+/*! \property QThreadPool::workStealingEnabled
+    \since 6.0
+
+    This property holds whether the thread pool schedules runnables with
+    per-thread queues and work stealing.
+
+    By default, all runnables go through a single queue that is shared by
+    the worker threads. This keeps the execution order close to the
+    submission order, but the queue becomes a point of contention when
+    many short runnables are started, for instance by runnables that split
+    their work into smaller runnables.
+
+    When work stealing is enabled, a runnable with the default priority 0
+    that is started from one of the pool's own threads is put into that
+    thread's local queue. The thread runs its local runnables newest first,
+    and idle threads take the oldest runnables from the queues of other,
+    randomly chosen threads. Runnables started from other threads are
+    handed to busy workers directly once all threads are in use. Runnables
+    with a non-zero priority always go through the shared queue and are
+    preferred over local runnables when their priority is higher, so
+    priorities are still honored, but runnables with the same priority may
+    run in a different order than they were started in.
+
+    The default value is \c false.
+*/
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    d->workStealing.storeRelaxed(enabled);
+}
+
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.loadRelaxed();
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
@@ -721,7 +1042,7 @@ void QThreadPool::clear()
 */
 void QThreadPool::cancel(QRunnable *runnable)
 {
-    if (tryTake(runnable) && runnable->autoDelete() && !runnable->ref) // tryTake already deref'ed
+    if (tryTake(runnable) && runnable->autoDelete() && !runnable->ref.loadRelaxed()) // tryTake already deref'ed
         delete runnable;
 }
 #endif
@@ -59,6 +59,7 @@ class Q_CORE_EXPORT QThreadPool : public QObject
     Q_PROPERTY(int maxThreadCount READ maxThreadCount WRITE setMaxThreadCount)
     Q_PROPERTY(int activeThreadCount READ activeThreadCount)
     Q_PROPERTY(uint stackSize READ stackSize WRITE setStackSize)
+    Q_PROPERTY(bool workStealingEnabled READ isWorkStealingEnabled WRITE setWorkStealingEnabled)
     friend class QFutureInterfaceBase;
 
 public:
@@ -81,6 +82,9 @@ public:
     void setStackSize(uint stackSize);
     uint stackSize() const;
 
+    void setWorkStealingEnabled(bool enabled);
+    bool isWorkStealingEnabled() const;
+
     void reserveThread();
     void releaseThread();
 
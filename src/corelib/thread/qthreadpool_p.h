@@ -59,6 +59,8 @@
 #include "QtCore/qqueue.h"
 #include "private/qobject_p.h"
 
+#include <limits>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
@@ -157,6 +159,7 @@ public:
 
     bool tryStart(QRunnable *task);
     void enqueueTask(QRunnable *task, int priority = 0);
+    void insertIntoQueue(QRunnable *task, int priority);
     int activeThreadCount() const;
 
     void tryToStartMoreThreads();
@@ -170,11 +173,31 @@ public:
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    // work-stealing mode, see QThreadPool::setWorkStealingEnabled()
+    enum {
+        EmptyQueuePriority = std::numeric_limits<int>::min()
+    };
+
+    bool tryPushLocal(QRunnable *runnable);
+    bool injectIntoBusyThread(QRunnable *runnable);
+    QRunnable *takeLocalWork(QThreadPoolThread *thread);
+    QRunnable *stealWork(QThreadPoolThread *thief);
+    bool hasLocalWork() const;
+    bool retireLocalQueue(QThreadPoolThread *thread);
+    void wakeThief();
+    void updateHints();
+
+    QAtomicInt workStealing;
+    QAtomicInt queuedPriority = int(EmptyQueuePriority); // priority of queue.first()
+    QAtomicInt spareThreads; // maxThreadCount - activeThreadCount()
+
     mutable QMutex mutex;
     QSet<QThreadPoolThread *> allThreads;
     QQueue<QThreadPoolThread *> waitingThreads;
     QQueue<QThreadPoolThread *> expiredThreads;
     QVector<QueuePage*> queue;
+    QVector<QThreadPoolThread *> stealTargets; // threads with a local queue
+    int injectIndex = 0;
     QWaitCondition noActiveThreads;
 
     int expiryTimeout = 30000;
@@ -46,6 +46,8 @@ QT_BEGIN_NAMESPACE
 
 
 template <class Key, class T> class QCache;
+template <class Key, class T> class QFlatHash;
+template <class T> class QFlatSet;
 template <class Key, class T> class QHash;
 #ifndef QT_NO_LINKED_LIST
 template <class T> class QLinkedList;
@@ -0,0 +1,856 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFLATHASH_H
+#define QFLATHASH_H
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qrefcount.h>
+#include <QtCore/qcontainertools_impl.h>
+
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <string.h>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QFlatHashPrivate {
+
+// Control bytes: a full slot holds the top 7 bits of its hash, so it is
+// never negative.
+enum : signed char {
+    Empty = -128,
+    Deleted = -2
+};
+
+enum { GroupSize = 16 };
+
+// The control bytes of GroupSize consecutive slots. The match functions
+// return one bit per slot.
+struct Group
+{
+#if defined(__SSE2__)
+    explicit Group(const signed char *pos) noexcept
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+    uint match(signed char h2) const noexcept
+    { return uint(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)))); }
+    uint matchEmpty() const noexcept
+    { return match(Empty); }
+    uint matchEmptyOrDeleted() const noexcept
+    { return uint(_mm_movemask_epi8(ctrl)); }
+
+    __m128i ctrl;
+#else
+    explicit Group(const signed char *pos) noexcept
+        : ctrl(pos) {}
+
+    uint match(signed char h2) const noexcept
+    {
+        uint mask = 0;
+        for (int i = 0; i < GroupSize; ++i)
+            mask |= uint(ctrl[i] == h2) << i;
+        return mask;
+    }
+    uint matchEmpty() const noexcept
+    { return match(Empty); }
+    uint matchEmptyOrDeleted() const noexcept
+    {
+        uint mask = 0;
+        for (int i = 0; i < GroupSize; ++i)
+            mask |= uint(ctrl[i] < 0) << i;
+        return mask;
+    }
+
+    const signed char *ctrl;
+#endif
+};
+
+// qHash() of integers is close to the identity, so spread its bits before
+// taking the slot from the low bits and the control byte from the high ones.
+Q_DECL_CONST_FUNCTION inline uint mix(uint h) noexcept
+{
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+}
+
+Q_DECL_CONST_FUNCTION inline signed char h2(uint h) noexcept
+{
+    return static_cast<signed char>(h >> 25);
+}
+
+// Describes the types, besides Key itself, that a QFlatHash<Key, T> can be
+// searched with. They must hash and compare like the equivalent Key.
+template <typename Key, typename K>
+struct Lookup
+{
+    enum { Enabled = false };
+};
+
+template <typename Key>
+struct Lookup<Key, Key>
+{
+    enum { Enabled = true };
+    static uint hash(const Key &key, uint seed) { return qHash(key, seed); }
+    static bool equals(const Key &key, const Key &other) { return key == other; }
+};
+
+template <>
+struct Lookup<QString, QStringView>
+{
+    enum { Enabled = true };
+    static uint hash(QStringView key, uint seed) noexcept { return qHash(key, seed); }
+    static bool equals(const QString &key, QStringView other) noexcept
+    { return QStringView(key) == other; }
+};
+
+template <>
+struct Lookup<QString, QLatin1String>
+{
+    enum { Enabled = true };
+    static uint hash(QLatin1String key, uint seed) noexcept
+    { return QtPrivate::qHashLatin1AsUtf16(key, seed); }
+    static bool equals(const QString &key, QLatin1String other) noexcept
+    { return key == other; }
+};
+
+template <>
+struct Lookup<QByteArray, QLatin1String>
+{
+    enum { Enabled = true };
+    static uint hash(QLatin1String key, uint seed) noexcept { return qHash(key, seed); }
+    static bool equals(const QByteArray &key, QLatin1String other) noexcept
+    { return QLatin1String(key) == other; }
+};
+
+template <typename Key, typename K>
+using IfLookupKey = typename std::enable_if<Lookup<Key, K>::Enabled && !std::is_same<Key, K>::value, bool>::type;
+
+} // namespace QFlatHashPrivate
+
+template <class Key, class T>
+struct QFlatHashNode
+{
+    Key key;
+    T value;
+
+    template <typename K, typename V>
+    QFlatHashNode(K &&key0, V &&value0)
+        : key(std::forward<K>(key0)), value(std::forward<V>(value0)) {}
+};
+
+// Specialize for QHashDummyValue in order to save some memory
+template <class Key>
+struct QFlatHashNode<Key, QHashDummyValue>
+{
+    union {
+        Key key;
+        QHashDummyValue value;
+    };
+
+    template <typename K>
+    QFlatHashNode(K &&key0, QHashDummyValue)
+        : key(std::forward<K>(key0)) {}
+    QFlatHashNode(const QFlatHashNode &other)
+        : key(other.key) {}
+    QFlatHashNode(QFlatHashNode &&other)
+        : key(std::move(other.key)) {}
+    ~QFlatHashNode() { key.~Key(); }
+};
+
+template <class Node>
+struct QFlatHashData
+{
+    QtPrivate::RefCount ref;
+    qsizetype size;
+    qsizetype capacity;         // a power of two, at least GroupSize
+    qsizetype growthLeft;       // empty slots that can still be filled
+    uint seed;
+    signed char *ctrl;
+    Node *nodes;
+
+    Q_STATIC_ASSERT_X(alignof(Node) <= alignof(std::max_align_t),
+                      "QFlatHash does not support over-aligned types");
+
+    static qsizetype maxSize(qsizetype capacity) noexcept
+    { return capacity - capacity / 8; }
+
+    static QFlatHashData *allocate(qsizetype capacity, uint seed)
+    {
+        const size_t ctrlOffset = sizeof(QFlatHashData);
+        const size_t nodesOffset = (ctrlOffset + size_t(capacity) + alignof(Node) - 1)
+                & ~size_t(alignof(Node) - 1);
+        char *block = static_cast<char *>(::operator new(nodesOffset + size_t(capacity) * sizeof(Node)));
+        QFlatHashData *d = reinterpret_cast<QFlatHashData *>(block);
+        d->ref.initializeOwned();
+        d->size = 0;
+        d->capacity = capacity;
+        d->growthLeft = maxSize(capacity);
+        d->seed = seed;
+        d->ctrl = reinterpret_cast<signed char *>(block + ctrlOffset);
+        d->nodes = reinterpret_cast<Node *>(block + nodesOffset);
+        memset(d->ctrl, QFlatHashPrivate::Empty, size_t(capacity));
+        return d;
+    }
+
+    // destroys the nodes too
+    static void free(QFlatHashData *d) noexcept
+    {
+        if (std::is_trivially_destructible<Node>::value || !d->size) {
+            ::operator delete(d);
+            return;
+        }
+        for (qsizetype i = 0; i < d->capacity; ++i) {
+            if (d->ctrl[i] >= 0)
+                d->nodes[i].~Node();
+        }
+        ::operator delete(d);
+    }
+
+    // the first free slot in the probe sequence of hash h
+    qsizetype findFree(uint h) const noexcept
+    {
+        using namespace QFlatHashPrivate;
+        const qsizetype groupMask = capacity / GroupSize - 1;
+        qsizetype group = qsizetype(h) & groupMask;
+        for (qsizetype step = 1; ; ++step) {
+            const uint free = Group(ctrl + group * GroupSize).matchEmptyOrDeleted();
+            if (free)
+                return group * GroupSize + qCountTrailingZeroBits(free);
+            group = (group + step) & groupMask;
+        }
+    }
+
+    // the first full slot at or after i, or capacity
+    qsizetype nextFull(qsizetype i) const noexcept
+    {
+        using namespace QFlatHashPrivate;
+        while (i < capacity) {
+            const qsizetype group = i & ~qsizetype(GroupSize - 1);
+            const uint full = ~Group(ctrl + group).matchEmptyOrDeleted() & (0xffffU << (i - group)) & 0xffffU;
+            if (full)
+                return group + qCountTrailingZeroBits(full);
+            i = group + GroupSize;
+        }
+        return capacity;
+    }
+
+    void setFull(qsizetype i, uint h) noexcept
+    {
+        if (ctrl[i] == QFlatHashPrivate::Empty)
+            --growthLeft;
+        ctrl[i] = QFlatHashPrivate::h2(h);
+        ++size;
+    }
+
+    void erase(qsizetype i) noexcept
+    {
+        using namespace QFlatHashPrivate;
+        nodes[i].~Node();
+        --size;
+
+        // Lookups stop at the first group that has an empty slot, so none
+        // of them needs this slot to stay occupied if its group has one.
+        const qsizetype group = i & ~qsizetype(GroupSize - 1);
+        if (Group(ctrl + group).matchEmpty()) {
+            ctrl[i] = Empty;
+            ++growthLeft;
+        } else {
+            ctrl[i] = Deleted;
+        }
+    }
+};
+
+template <class Key, class T>
+class QFlatHash
+{
+    typedef QFlatHashNode<Key, T> Node;
+    typedef QFlatHashData<Node> Data;
+
+    Data *d = nullptr;
+
+public:
+    QFlatHash() noexcept = default;
+    QFlatHash(std::initializer_list<std::pair<Key, T> > list)
+    {
+        reserve(qsizetype(list.size()));
+        for (auto it = list.begin(); it != list.end(); ++it)
+            insert(it->first, it->second);
+    }
+    QFlatHash(const QFlatHash &other) noexcept : d(other.d) { if (d) d->ref.ref(); }
+    QFlatHash(QFlatHash &&other) noexcept : d(other.d) { other.d = nullptr; }
+    ~QFlatHash() { if (d && !d->ref.deref()) Data::free(d); }
+
+    QFlatHash &operator=(const QFlatHash &other)
+    { QFlatHash copy(other); swap(copy); return *this; }
+    QFlatHash &operator=(QFlatHash &&other) noexcept
+    { QFlatHash moved(std::move(other)); swap(moved); return *this; }
+#ifdef Q_QDOC
+    template <typename InputIterator>
+    QFlatHash(InputIterator f, InputIterator l);
+#else
+    template <typename InputIterator, QtPrivate::IfAssociativeIteratorHasKeyAndValue<InputIterator> = true>
+    QFlatHash(InputIterator f, InputIterator l)
+    {
+        QtPrivate::reserveIfForwardIterator(this, f, l);
+        for (; f != l; ++f)
+            insert(f.key(), f.value());
+    }
+
+    template <typename InputIterator, QtPrivate::IfAssociativeIteratorHasFirstAndSecond<InputIterator> = true>
+    QFlatHash(InputIterator f, InputIterator l)
+    {
+        QtPrivate::reserveIfForwardIterator(this, f, l);
+        for (; f != l; ++f)
+            insert(f->first, f->second);
+    }
+#endif
+    void swap(QFlatHash &other) noexcept { qSwap(d, other.d); }
+
+    bool operator==(const QFlatHash &other) const;
+    bool operator!=(const QFlatHash &other) const { return !(*this == other); }
+
+    qsizetype size() const noexcept { return d ? d->size : 0; }
+    qsizetype count() const noexcept { return size(); }
+    bool isEmpty() const noexcept { return !size(); }
+
+    qsizetype capacity() const noexcept { return d ? Data::maxSize(d->capacity) : 0; }
+    void reserve(qsizetype size);
+    void squeeze();
+
+    void detach() { if (d && d->ref.isShared()) detach_helper(); }
+    bool isDetached() const noexcept { return !d || !d->ref.isShared(); }
+    bool isSharedWith(const QFlatHash &other) const noexcept { return d == other.d; }
+
+    void clear() { QFlatHash().swap(*this); }
+
+    bool remove(const Key &key);
+    T take(const Key &key);
+
+    bool contains(const Key &key) const { return findIndex(key) >= 0; }
+    T value(const Key &key, const T &defaultValue = T()) const;
+    T &operator[](const Key &key);
+    const T operator[](const Key &key) const { return value(key); }
+
+    template <typename K, QFlatHashPrivate::IfLookupKey<Key, K> = true>
+    bool contains(const K &key) const { return findIndex(key) >= 0; }
+    template <typename K, QFlatHashPrivate::IfLookupKey<Key, K> = true>
+    T value(const K &key, const T &defaultValue = T()) const
+    {
+        const qsizetype i = findIndex(key);
+        return i < 0 ? defaultValue : d->nodes[i].value;
+    }
+
+    QList<Key> keys() const;
+    QList<T> values() const;
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class const_iterator;
+        friend class QFlatHash<Key, T>;
+        Data *d = nullptr;
+        qsizetype i = 0;
+
+        iterator(Data *data, qsizetype index) noexcept : d(data), i(index) {}
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        constexpr iterator() noexcept = default;
+
+        const Key &key() const noexcept { return d->nodes[i].key; }
+        T &value() const noexcept { return d->nodes[i].value; }
+        T &operator*() const noexcept { return value(); }
+        T *operator->() const noexcept { return &value(); }
+        bool operator==(const iterator &o) const noexcept { return i == o.i && d == o.d; }
+        bool operator!=(const iterator &o) const noexcept { return !(*this == o); }
+
+        iterator &operator++() noexcept { i = d->nextFull(i + 1); return *this; }
+        iterator operator++(int) noexcept { iterator r = *this; ++*this; return r; }
+
+        bool operator==(const const_iterator &o) const noexcept { return i == o.i && d == o.d; }
+        bool operator!=(const const_iterator &o) const noexcept { return !(*this == o); }
+    };
+    friend class iterator;
+
+    class const_iterator
+    {
+        friend class iterator;
+        friend class QFlatHash<Key, T>;
+        const Data *d = nullptr;
+        qsizetype i = 0;
+
+        const_iterator(const Data *data, qsizetype index) noexcept : d(data), i(index) {}
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        constexpr const_iterator() noexcept = default;
+        const_iterator(const iterator &o) noexcept : d(o.d), i(o.i) {}
+
+        const Key &key() const noexcept { return d->nodes[i].key; }
+        const T &value() const noexcept { return d->nodes[i].value; }
+        const T &operator*() const noexcept { return value(); }
+        const T *operator->() const noexcept { return &value(); }
+        bool operator==(const const_iterator &o) const noexcept { return i == o.i && d == o.d; }
+        bool operator!=(const const_iterator &o) const noexcept { return !(*this == o); }
+
+        const_iterator &operator++() noexcept { i = d->nextFull(i + 1); return *this; }
+        const_iterator operator++(int) noexcept { const_iterator r = *this; ++*this; return r; }
+    };
+    friend class const_iterator;
+
+    class key_iterator
+    {
+        const_iterator i;
+
+    public:
+        typedef typename const_iterator::iterator_category iterator_category;
+        typedef typename const_iterator::difference_type difference_type;
+        typedef Key value_type;
+        typedef const Key *pointer;
+        typedef const Key &reference;
+
+        key_iterator() = default;
+        explicit key_iterator(const_iterator o) : i(o) { }
+
+        const Key &operator*() const { return i.key(); }
+        const Key *operator->() const { return &i.key(); }
+        bool operator==(key_iterator o) const { return i == o.i; }
+        bool operator!=(key_iterator o) const { return i != o.i; }
+
+        inline key_iterator &operator++() { ++i; return *this; }
+        inline key_iterator operator++(int) { return key_iterator(i++);}
+        const_iterator base() const { return i; }
+    };
+
+    // STL style
+    iterator begin() { detach(); return d ? iterator(d, d->nextFull(0)) : iterator(); }
+    const_iterator begin() const noexcept { return constBegin(); }
+    const_iterator cbegin() const noexcept { return constBegin(); }
+    const_iterator constBegin() const noexcept
+    { return d ? const_iterator(d, d->nextFull(0)) : const_iterator(); }
+    iterator end() { detach(); return d ? iterator(d, d->capacity) : iterator(); }
+    const_iterator end() const noexcept { return constEnd(); }
+    const_iterator cend() const noexcept { return constEnd(); }
+    const_iterator constEnd() const noexcept
+    { return d ? const_iterator(d, d->capacity) : const_iterator(); }
+    key_iterator keyBegin() const noexcept { return key_iterator(begin()); }
+    key_iterator keyEnd() const noexcept { return key_iterator(end()); }
+
+    iterator erase(const_iterator it);
+    iterator erase(iterator it) { return erase(const_iterator(it)); }
+
+    iterator find(const Key &key);
+    const_iterator find(const Key &key) const { return constFind(key); }
+    const_iterator constFind(const Key &key) const;
+    template <typename K, QFlatHashPrivate::IfLookupKey<Key, K> = true>
+    iterator find(const K &key)
+    {
+        detach();
+        const qsizetype i = findIndex(key);
+        return i < 0 ? end() : iterator(d, i);
+    }
+    template <typename K, QFlatHashPrivate::IfLookupKey<Key, K> = true>
+    const_iterator find(const K &key) const { return constFind(key); }
+    template <typename K, QFlatHashPrivate::IfLookupKey<Key, K> = true>
+    const_iterator constFind(const K &key) const
+    {
+        const qsizetype i = findIndex(key);
+        return i < 0 ? constEnd() : const_iterator(d, i);
+    }
+
+    iterator insert(const Key &key, const T &value) { return emplace(key, value); }
+    iterator insert(Key &&key, T &&value) { return emplace(std::move(key), std::move(value)); }
+    void insert(const QFlatHash &other);
+
+    // STL compatibility
+    typedef T mapped_type;
+    typedef Key key_type;
+    typedef qptrdiff difference_type;
+    typedef qsizetype size_type;
+
+    bool empty() const noexcept { return isEmpty(); }
+
+private:
+    template <typename K>
+    qsizetype findIndex(const K &key) const;
+    template <typename K>
+    qsizetype findIndex(const K &key, uint h) const;
+    template <typename K, typename V>
+    iterator emplace(K &&key, V &&value);
+    template <typename K, typename V>
+    qsizetype insertNew(uint h, K &&key, V &&value);
+    template <typename K, typename V>
+    qsizetype growAndInsert(uint h, K &&key, V &&value);
+    void rehash(qsizetype capacity);
+    void detach_helper();
+
+    // the hash of a key that may be inserted, for findIndex() and insertNew()
+    uint hashForInsert(const Key &key) const
+    { return QFlatHashPrivate::mix(qHash(key, d ? d->seed : uint(qGlobalQHashSeed()))); }
+
+    static qsizetype capacityFor(qsizetype size) noexcept
+    {
+        qsizetype capacity = QFlatHashPrivate::GroupSize;
+        while (Data::maxSize(capacity) < size)
+            capacity *= 2;
+        return capacity;
+    }
+};
+
+template <class Key, class T>
+template <typename K>
+Q_INLINE_TEMPLATE qsizetype QFlatHash<Key, T>::findIndex(const K &key) const
+{
+    using namespace QFlatHashPrivate;
+    if (!d || !d->size)
+        return -1;
+    return findIndex(key, mix(Lookup<Key, K>::hash(key, d->seed)));
+}
+
+// Finds key, whose mixed hash is h.
+template <class Key, class T>
+template <typename K>
+Q_INLINE_TEMPLATE qsizetype QFlatHash<Key, T>::findIndex(const K &key, uint h) const
+{
+    using namespace QFlatHashPrivate;
+    if (!d || !d->size)
+        return -1;
+
+    typedef Lookup<Key, K> L;
+    const signed char tag = h2(h);
+    const qsizetype groupMask = d->capacity / GroupSize - 1;
+    qsizetype group = qsizetype(h) & groupMask;
+    for (qsizetype step = 1; ; ++step) {
+        const Group g(d->ctrl + group * GroupSize);
+        for (uint match = g.match(tag); match; match &= match - 1) {
+            const qsizetype i = group * GroupSize + qCountTrailingZeroBits(match);
+            if (Q_LIKELY(L::equals(d->nodes[i].key, key)))
+                return i;
+        }
+        if (Q_LIKELY(g.matchEmpty()))
+            return -1;
+        group = (group + step) & groupMask;
+    }
+}
+
+template <class Key, class T>
+template <typename K, typename V>
+Q_INLINE_TEMPLATE typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::emplace(K &&key, V &&value)
+{
+    detach();
+    const uint h = hashForInsert(key);
+    const qsizetype i = findIndex(key, h);
+    if (i >= 0) {
+        d->nodes[i].value = std::forward<V>(value);
+        return iterator(d, i);
+    }
+    return iterator(d, insertNew(h, std::forward<K>(key), std::forward<V>(value)));
+}
+
+// Inserts a key that is not in the detached hash yet, and whose mixed hash
+// is h.
+template <class Key, class T>
+template <typename K, typename V>
+Q_INLINE_TEMPLATE qsizetype QFlatHash<Key, T>::insertNew(uint h, K &&key, V &&value)
+{
+    const qsizetype i = d ? d->findFree(h) : -1;
+    if (i < 0 || (!d->growthLeft && d->ctrl[i] == QFlatHashPrivate::Empty))
+        return growAndInsert(h, std::forward<K>(key), std::forward<V>(value));
+
+    new (d->nodes + i) Node(std::forward<K>(key), std::forward<V>(value));
+    d->setFull(i, h);
+    return i;
+}
+
+// Inserts the new node in a bigger table before moving the existing ones,
+// which key and value may refer to.
+template <class Key, class T>
+template <typename K, typename V>
+Q_OUTOFLINE_TEMPLATE qsizetype QFlatHash<Key, T>::growAndInsert(uint h, K &&key, V &&value)
+{
+    const qsizetype size = d ? d->size : 0;
+    Data *x = Data::allocate(capacityFor(qMax(size + 1, 2 * size)),
+                             d ? d->seed : uint(qGlobalQHashSeed()));
+    const qsizetype i = x->findFree(h);
+    QT_TRY {
+        new (x->nodes + i) Node(std::forward<K>(key), std::forward<V>(value));
+    } QT_CATCH(...) {
+        Data::free(x);
+        QT_RETHROW;
+    }
+    x->setFull(i, h);
+
+    if (d) {
+        for (qsizetype j = 0; j < d->capacity; ++j) {
+            if (d->ctrl[j] < 0)
+                continue;
+            Node &n = d->nodes[j];
+            const uint hj = QFlatHashPrivate::mix(qHash(n.key, x->seed));
+            const qsizetype k = x->findFree(hj);
+            new (x->nodes + k) Node(std::move(n));
+            x->setFull(k, hj);
+        }
+        Data::free(d);
+    }
+    d = x;
+    return i;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::rehash(qsizetype capacity)
+{
+    Data *x = Data::allocate(capacity, d->seed);
+    const bool shared = d->ref.isShared();
+    QT_TRY {
+        for (qsizetype j = 0; j < d->capacity; ++j) {
+            if (d->ctrl[j] < 0)
+                continue;
+            Node &n = d->nodes[j];
+            const uint h = QFlatHashPrivate::mix(qHash(n.key, x->seed));
+            const qsizetype k = x->findFree(h);
+            if (shared)
+                new (x->nodes + k) Node(n);
+            else
+                new (x->nodes + k) Node(std::move(n));
+            x->setFull(k, h);
+        }
+    } QT_CATCH(...) {
+        Data::free(x);
+        QT_RETHROW;
+    }
+    if (!d->ref.deref())
+        Data::free(d);
+    d = x;
+}
+
+// Copies the table as is, so the copy needs no hashing.
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE void QFlatHash<Key, T>::detach_helper()
+{
+    Data *x = Data::allocate(d->capacity, d->seed);
+    memcpy(x->ctrl, d->ctrl, size_t(d->capacity));
+    qsizetype j = 0;
+    QT_TRY {
+        for (; j < d->capacity; ++j) {
+            if (d->ctrl[j] >= 0)
+                new (x->nodes + j) Node(d->nodes[j]);
+        }
+    } QT_CATCH(...) {
+        while (j--) {
+            if (x->ctrl[j] >= 0)
+                x->nodes[j].~Node();
+        }
+        ::operator delete(x);
+        QT_RETHROW;
+    }
+    x->size = d->size;
+    x->growthLeft = d->growthLeft;
+    if (!d->ref.deref())
+        Data::free(d);
+    d = x;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE bool QFlatHash<Key, T>::operator==(const QFlatHash &other) const
+{
+    if (d == other.d)
+        return true;
+    if (size() != other.size())
+        return false;
+    for (const_iterator it = constBegin(), e = constEnd(); it != e; ++it) {
+        const qsizetype i = other.findIndex(it.key());
+        if (i < 0 || !(other.d->nodes[i].value == it.value()))
+            return false;
+    }
+    return true;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE void QFlatHash<Key, T>::reserve(qsizetype size)
+{
+    const qsizetype capacity = capacityFor(qMax(size, this->size()));
+    if (!d)
+        d = Data::allocate(capacity, uint(qGlobalQHashSeed()));
+    else if (capacity > d->capacity)
+        rehash(capacity);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE void QFlatHash<Key, T>::squeeze()
+{
+    if (!d)
+        return;
+    if (!d->size)
+        clear();
+    else if (capacityFor(d->size) < d->capacity)
+        rehash(capacityFor(d->size));
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE bool QFlatHash<Key, T>::remove(const Key &key)
+{
+    const qsizetype i = findIndex(key);
+    if (i < 0)
+        return false;
+    detach(); // the copy keeps every node in its slot
+    d->erase(i);
+    return true;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE T QFlatHash<Key, T>::take(const Key &key)
+{
+    const qsizetype i = findIndex(key);
+    if (i < 0)
+        return T();
+    detach();
+    T t = std::move(d->nodes[i].value);
+    d->erase(i);
+    return t;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE T QFlatHash<Key, T>::value(const Key &key, const T &defaultValue) const
+{
+    const qsizetype i = findIndex(key);
+    return i < 0 ? defaultValue : d->nodes[i].value;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE T &QFlatHash<Key, T>::operator[](const Key &key)
+{
+    detach();
+    const uint h = hashForInsert(key);
+    const qsizetype i = findIndex(key, h);
+    if (i >= 0)
+        return d->nodes[i].value;
+    // insertNew() may allocate or regrow d, so read it only afterwards
+    const qsizetype n = insertNew(h, key, T());
+    return d->nodes[n].value;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<Key> QFlatHash<Key, T>::keys() const
+{
+    QList<Key> res;
+    res.reserve(int(size()));
+    for (const_iterator it = constBegin(), e = constEnd(); it != e; ++it)
+        res.append(it.key());
+    return res;
+}
+
+template <class Key, class T>
+Q_OUTOFLINE_TEMPLATE QList<T> QFlatHash<Key, T>::values() const
+{
+    QList<T> res;
+    res.reserve(int(size()));
+    for (const_iterator it = constBegin(), e = constEnd(); it != e; ++it)
+        res.append(it.value());
+    return res;
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::erase(const_iterator it)
+{
+    if (it == constEnd())
+        return end();
+
+    // the copy keeps every node in its slot
+    const qsizetype i = it.i;
+    detach();
+    d->erase(i);
+    return iterator(d, d->nextFull(i + 1));
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatHash<Key, T>::iterator QFlatHash<Key, T>::find(const Key &key)
+{
+    detach();
+    const qsizetype i = findIndex(key);
+    return i < 0 ? end() : iterator(d, i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE typename QFlatHash<Key, T>::const_iterator QFlatHash<Key, T>::constFind(const Key &key) const
+{
+    const qsizetype i = findIndex(key);
+    return i < 0 ? constEnd() : const_iterator(d, i);
+}
+
+template <class Key, class T>
+Q_INLINE_TEMPLATE void QFlatHash<Key, T>::insert(const QFlatHash &other)
+{
+    if (d == other.d)
+        return;
+    reserve(size() + other.size());
+    for (const_iterator it = other.constBegin(), e = other.constEnd(); it != e; ++it)
+        insert(it.key(), it.value());
+}
+
+template <class Key, class T>
+inline void swap(QFlatHash<Key, T> &value1, QFlatHash<Key, T> &value2) noexcept
+{ value1.swap(value2); }
+
+QT_END_NAMESPACE
+
+#endif // QFLATHASH_H
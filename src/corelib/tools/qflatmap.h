@@ -0,0 +1,565 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFLATMAP_H
+#define QFLATMAP_H
+
+#include <QtCore/qcontainertools_impl.h>
+#include <QtCore/qiterator.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qvector.h>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+
+QT_BEGIN_NAMESPACE
+
+template <class Key, class T, class Compare = std::less<Key> >
+class QFlatMap
+{
+    QVector<Key> k;
+    QVector<T> v;
+
+public:
+    QFlatMap() noexcept {}
+    QFlatMap(std::initializer_list<std::pair<Key, T> > list)
+    {
+        k.reserve(int(list.size()));
+        v.reserve(int(list.size()));
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            k.append(it->first);
+            v.append(it->second);
+        }
+        makeSortedUnique();
+    }
+    QFlatMap(QVector<Key> keys, QVector<T> values)
+        : k(std::move(keys)), v(std::move(values))
+    {
+        Q_ASSERT(k.size() == v.size());
+        makeSortedUnique();
+    }
+    explicit QFlatMap(const QMap<Key, T> &map)
+    {
+        k.reserve(map.size());
+        v.reserve(map.size());
+        for (auto it = map.cbegin(), end = map.cend(); it != end; ++it) {
+            k.append(it.key());
+            v.append(it.value());
+        }
+        makeSortedUnique();
+    }
+#ifdef Q_QDOC
+    template <typename InputIterator>
+    QFlatMap(InputIterator f, InputIterator l);
+#else
+    template <typename InputIterator, QtPrivate::IfAssociativeIteratorHasKeyAndValue<InputIterator> = true>
+    QFlatMap(InputIterator f, InputIterator l)
+    {
+        QtPrivate::reserveIfForwardIterator(this, f, l);
+        for (; f != l; ++f) {
+            k.append(f.key());
+            v.append(f.value());
+        }
+        makeSortedUnique();
+    }
+
+    template <typename InputIterator, QtPrivate::IfAssociativeIteratorHasFirstAndSecond<InputIterator> = true>
+    QFlatMap(InputIterator f, InputIterator l)
+    {
+        QtPrivate::reserveIfForwardIterator(this, f, l);
+        for (; f != l; ++f) {
+            k.append(f->first);
+            v.append(f->second);
+        }
+        makeSortedUnique();
+    }
+#endif
+
+    // compiler-generated copy/move ctor/assignment operators are fine!
+    // compiler-generated destructor is fine!
+
+    void swap(QFlatMap &other) noexcept
+    {
+        k.swap(other.k);
+        v.swap(other.v);
+    }
+
+    bool operator==(const QFlatMap &other) const { return k == other.k && v == other.v; }
+    bool operator!=(const QFlatMap &other) const { return !(*this == other); }
+
+    qsizetype size() const noexcept { return k.size(); }
+    qsizetype count() const noexcept { return k.size(); }
+    bool isEmpty() const noexcept { return k.isEmpty(); }
+
+    qsizetype capacity() const { return k.capacity(); }
+    void reserve(qsizetype size) { k.reserve(int(size)); v.reserve(int(size)); }
+    void squeeze() { k.squeeze(); v.squeeze(); }
+
+    void detach() { k.detach(); v.detach(); }
+    bool isDetached() const { return k.isDetached() && v.isDetached(); }
+    bool isSharedWith(const QFlatMap &other) const
+    { return k.isSharedWith(other.k) && v.isSharedWith(other.v); }
+
+    void clear() { QFlatMap().swap(*this); }
+
+    int remove(const Key &key);
+    T take(const Key &key);
+
+    bool contains(const Key &key) const { return indexOf(key) >= 0; }
+    const Key key(const T &value, const Key &defaultKey = Key()) const;
+    const T value(const Key &key, const T &defaultValue = T()) const;
+    T &operator[](const Key &key);
+    const T operator[](const Key &key) const { return value(key); }
+
+    QList<Key> keys() const;
+    QList<Key> keys(const T &value) const;
+    QList<T> values() const;
+    int count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+    const Key &firstKey() const { Q_ASSERT(!isEmpty()); return k.first(); }
+    const Key &lastKey() const { Q_ASSERT(!isEmpty()); return k.last(); }
+
+    T &first() { Q_ASSERT(!isEmpty()); return v.first(); }
+    const T &first() const { Q_ASSERT(!isEmpty()); return v.first(); }
+    T &last() { Q_ASSERT(!isEmpty()); return v.last(); }
+    const T &last() const { Q_ASSERT(!isEmpty()); return v.last(); }
+
+    // The keys and values, in ascending key order.
+    const QVector<Key> &keyVector() const noexcept { return k; }
+    const QVector<T> &valueVector() const noexcept { return v; }
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class const_iterator;
+        friend class QFlatMap;
+        const Key *ki = nullptr;
+        T *vi = nullptr;
+
+        iterator(const Key *key, T *value) noexcept : ki(key), vi(value) {}
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef T *pointer;
+        typedef T &reference;
+
+        constexpr iterator() noexcept = default;
+
+        const Key &key() const noexcept { return *ki; }
+        T &value() const noexcept { return *vi; }
+        T &operator*() const noexcept { return *vi; }
+        T *operator->() const noexcept { return vi; }
+        bool operator==(const iterator &o) const noexcept { return ki == o.ki; }
+        bool operator!=(const iterator &o) const noexcept { return ki != o.ki; }
+        bool operator<(const iterator &o) const noexcept { return ki < o.ki; }
+
+        iterator &operator++() noexcept { ++ki; ++vi; return *this; }
+        iterator operator++(int) noexcept { iterator r = *this; ++*this; return r; }
+        iterator &operator--() noexcept { --ki; --vi; return *this; }
+        iterator operator--(int) noexcept { iterator r = *this; --*this; return r; }
+        iterator &operator+=(difference_type j) noexcept { ki += j; vi += j; return *this; }
+        iterator &operator-=(difference_type j) noexcept { ki -= j; vi -= j; return *this; }
+        iterator operator+(difference_type j) const noexcept { iterator r = *this; return r += j; }
+        iterator operator-(difference_type j) const noexcept { iterator r = *this; return r -= j; }
+        difference_type operator-(const iterator &o) const noexcept { return ki - o.ki; }
+
+        bool operator==(const const_iterator &o) const noexcept { return ki == o.ki; }
+        bool operator!=(const const_iterator &o) const noexcept { return ki != o.ki; }
+    };
+    friend class iterator;
+
+    class const_iterator
+    {
+        friend class iterator;
+        friend class QFlatMap;
+        const Key *ki = nullptr;
+        const T *vi = nullptr;
+
+        const_iterator(const Key *key, const T *value) noexcept : ki(key), vi(value) {}
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        constexpr const_iterator() noexcept = default;
+        const_iterator(const iterator &o) noexcept : ki(o.ki), vi(o.vi) {}
+
+        const Key &key() const noexcept { return *ki; }
+        const T &value() const noexcept { return *vi; }
+        const T &operator*() const noexcept { return *vi; }
+        const T *operator->() const noexcept { return vi; }
+        bool operator==(const const_iterator &o) const noexcept { return ki == o.ki; }
+        bool operator!=(const const_iterator &o) const noexcept { return ki != o.ki; }
+        bool operator<(const const_iterator &o) const noexcept { return ki < o.ki; }
+
+        const_iterator &operator++() noexcept { ++ki; ++vi; return *this; }
+        const_iterator operator++(int) noexcept { const_iterator r = *this; ++*this; return r; }
+        const_iterator &operator--() noexcept { --ki; --vi; return *this; }
+        const_iterator operator--(int) noexcept { const_iterator r = *this; --*this; return r; }
+        const_iterator &operator+=(difference_type j) noexcept { ki += j; vi += j; return *this; }
+        const_iterator &operator-=(difference_type j) noexcept { ki -= j; vi -= j; return *this; }
+        const_iterator operator+(difference_type j) const noexcept { const_iterator r = *this; return r += j; }
+        const_iterator operator-(difference_type j) const noexcept { const_iterator r = *this; return r -= j; }
+        difference_type operator-(const const_iterator &o) const noexcept { return ki - o.ki; }
+    };
+    friend class const_iterator;
+
+    class key_iterator
+    {
+        const_iterator i;
+
+    public:
+        typedef typename const_iterator::iterator_category iterator_category;
+        typedef typename const_iterator::difference_type difference_type;
+        typedef Key value_type;
+        typedef const Key *pointer;
+        typedef const Key &reference;
+
+        key_iterator() = default;
+        explicit key_iterator(const_iterator o) : i(o) { }
+
+        const Key &operator*() const { return i.key(); }
+        const Key *operator->() const { return &i.key(); }
+        bool operator==(key_iterator o) const { return i == o.i; }
+        bool operator!=(key_iterator o) const { return i != o.i; }
+
+        inline key_iterator &operator++() { ++i; return *this; }
+        inline key_iterator operator++(int) { return key_iterator(i++);}
+        inline key_iterator &operator--() { --i; return *this; }
+        inline key_iterator operator--(int) { return key_iterator(i--); }
+        const_iterator base() const { return i; }
+    };
+
+    typedef QKeyValueIterator<const Key&, const T&, const_iterator> const_key_value_iterator;
+    typedef QKeyValueIterator<const Key&, T&, iterator> key_value_iterator;
+
+    // STL style
+    iterator begin() { return iterator(k.constData(), v.data()); }
+    const_iterator begin() const noexcept { return constBegin(); }
+    const_iterator cbegin() const noexcept { return constBegin(); }
+    const_iterator constBegin() const noexcept { return const_iterator(k.constData(), v.constData()); }
+    iterator end() { return begin() + size(); }
+    const_iterator end() const noexcept { return constEnd(); }
+    const_iterator cend() const noexcept { return constEnd(); }
+    const_iterator constEnd() const noexcept { return constBegin() + size(); }
+    key_iterator keyBegin() const { return key_iterator(begin()); }
+    key_iterator keyEnd() const { return key_iterator(end()); }
+    key_value_iterator keyValueBegin() { return key_value_iterator(begin()); }
+    key_value_iterator keyValueEnd() { return key_value_iterator(end()); }
+    const_key_value_iterator keyValueBegin() const { return const_key_value_iterator(begin()); }
+    const_key_value_iterator constKeyValueBegin() const { return const_key_value_iterator(begin()); }
+    const_key_value_iterator keyValueEnd() const { return const_key_value_iterator(end()); }
+    const_key_value_iterator constKeyValueEnd() const { return const_key_value_iterator(end()); }
+
+    iterator erase(const_iterator it) { return erase(iterator(it.ki, const_cast<T *>(it.vi))); }
+    iterator erase(iterator it);
+
+    iterator find(const Key &key);
+    const_iterator find(const Key &key) const { return constFind(key); }
+    const_iterator constFind(const Key &key) const;
+    iterator lowerBound(const Key &key) { return begin() + lowerBoundIndex(key); }
+    const_iterator lowerBound(const Key &key) const { return constBegin() + lowerBoundIndex(key); }
+    iterator upperBound(const Key &key);
+    const_iterator upperBound(const Key &key) const;
+    iterator insert(const Key &key, const T &value);
+    void insert(const QFlatMap &map);
+
+    QMap<Key, T> toMap() const;
+
+    // STL compatibility
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef qptrdiff difference_type;
+    typedef qsizetype size_type;
+    bool empty() const noexcept { return isEmpty(); }
+
+private:
+    static bool lessThan(const Key &lhs, const Key &rhs) { return Compare()(lhs, rhs); }
+    qsizetype lowerBoundIndex(const Key &key) const;
+    qsizetype indexOf(const Key &key) const
+    {
+        const qsizetype i = lowerBoundIndex(key);
+        return i < size() && !lessThan(key, k.at(int(i))) ? i : -1;
+    }
+    void makeSortedUnique();
+};
+
+// A binary search whose loop has no data-dependent branch: the compiler
+// turns the comparison into a conditional move, so the CPU does not
+// mispredict half of the steps, and the loop runs a fixed number of times
+// for a given size.
+template <class Key, class T, class Compare>
+Q_INLINE_TEMPLATE qsizetype QFlatMap<Key, T, Compare>::lowerBoundIndex(const Key &key) const
+{
+    const Key *first = k.constData();
+    const Key *base = first;
+    qsizetype n = size();
+    if (!n)
+        return 0;
+    while (n > 1) {
+        const qsizetype half = n / 2;
+        base = lessThan(base[half], key) ? base + half : base;
+        n -= half;
+    }
+    return (base - first) + lessThan(*base, key);
+}
+
+// Sorts the keys, together with their values, and drops all but the last
+// of the items that have equal keys, the way repeated QMap::insert() would.
+template <class Key, class T, class Compare>
+Q_OUTOFLINE_TEMPLATE void QFlatMap<Key, T, Compare>::makeSortedUnique()
+{
+    const int n = k.size();
+    bool sortedUnique = true;
+    for (int i = 1; i < n && sortedUnique; ++i)
+        sortedUnique = lessThan(k.at(i - 1), k.at(i));
+    if (sortedUnique)
+        return;
+
+    QVector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    const Key *keys = k.constData();
+    std::stable_sort(order.begin(), order.end(), [keys](int lhs, int rhs) {
+        return lessThan(keys[lhs], keys[rhs]);
+    });
+
+    QVector<Key> sortedKeys;
+    QVector<T> sortedValues;
+    sortedKeys.reserve(n);
+    sortedValues.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        const int j = order.at(i);
+        if (i + 1 < n && !lessThan(keys[j], keys[order.at(i + 1)]))
+            continue;
+        sortedKeys.append(keys[j]);
+        sortedValues.append(v.at(j));
+    }
+    k.swap(sortedKeys);
+    v.swap(sortedValues);
+}
+
+template <class Key, class T, class Compare>
+Q_INLINE_TEMPLATE int QFlatMap<Key, T, Compare>::remove(const Key &key)
+{
+    const qsizetype i = indexOf(key);
+    if (i < 0)
+        return 0;
+    k.remove(int(i));
+    v.remove(int(i));
+    return 1;
+}
+
+template <class Key, class T, class Compare>
+Q_INLINE_TEMPLATE T QFlatMap<Key, T, Compare>::take(const Key &key)
+{
+    const qsizetype i = indexOf(key);
+    if (i < 0)
+        return T();
+    k.remove(int(i));
+    return v.takeAt(int(i));
+}
+
+template <class Key, class T, class Compare>
+Q_INLINE_TEMPLATE const Key QFlatMap<Key, T, Compare>::key(const T &value, const Key &defaultKey) const
+{
+    const int i = v.indexOf(value);
+    return i < 0 ? defaultKey : k.at(i);
+}
+
+template <class Key, class T, class Compare>
+Q_INLINE_TEMPLATE const T QFlatMap<Key, T, Compare>::value(const Key &key, const T &defaultValue) const
+{
+    const qsizetype i = indexOf(key);
+    return i < 0 ? defaultValue : v.at(int(i));
+}
+
+template <class Key, class T, class Compare>
+Q_INLINE_TEMPLATE T &QFlatMap<Key, T, Compare>::operator[](const Key &key)
+{
+    const qsizetype i = lowerBoundIndex(key);
+    if (i == size() || lessThan(key, k.at(int(i)))) {
+        k.insert(int(i), key);
+        v.insert(int(i), T());
+    }
+    return v[int(i)];
+}
+
+template <class Key, class T, class Compare>
+Q_OUTOFLINE_TEMPLATE QList<Key> QFlatMap<Key, T, Compare>::keys() const
+{
+    QList<Key> res;
+    res.reserve(k.size());
+    for (const Key &key : k)
+        res.append(key);
+    return res;
+}
+
+template <class Key, class T, class Compare>
+Q_OUTOFLINE_TEMPLATE QList<Key> QFlatMap<Key, T, Compare>::keys(const T &value) const
+{
+    QList<Key> res;
+    for (int i = 0, n = v.size(); i < n; ++i) {
+        if (v.at(i) == value)
+            res.append(k.at(i));
+    }
+    return res;
+}
+
+template <class Key, class T, class Compare>
+Q_OUTOFLINE_TEMPLATE QList<T> QFlatMap<Key, T, Compare>::values() const
+{
+    QList<T> res;
+    res.reserve(v.size());
+    for (const T &value : v)
+        res.append(value);
+    return res;
+}
+
+template <class Key, class T, class Compare>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T, Compare>::iterator QFlatMap<Key, T, Compare>::erase(iterator it)
+{
+    const int i = int(it.ki - k.constData());
+    if (i == k.size())
+        return it;
+    k.remove(i);
+    v.remove(i);
+    return begin() + i;
+}
+
+template <class Key, class T, class Compare>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T, Compare>::iterator QFlatMap<Key, T, Compare>::find(const Key &key)
+{
+    const qsizetype i = indexOf(key);
+    return i < 0 ? end() : begin() + i;
+}
+
+template <class Key, class T, class Compare>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T, Compare>::const_iterator QFlatMap<Key, T, Compare>::constFind(const Key &key) const
+{
+    const qsizetype i = indexOf(key);
+    return i < 0 ? constEnd() : constBegin() + i;
+}
+
+template <class Key, class T, class Compare>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T, Compare>::iterator QFlatMap<Key, T, Compare>::upperBound(const Key &key)
+{
+    const qsizetype i = indexOf(key);
+    return i < 0 ? lowerBound(key) : begin() + i + 1;
+}
+
+template <class Key, class T, class Compare>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T, Compare>::const_iterator QFlatMap<Key, T, Compare>::upperBound(const Key &key) const
+{
+    const qsizetype i = indexOf(key);
+    return i < 0 ? lowerBound(key) : constBegin() + i + 1;
+}
+
+template <class Key, class T, class Compare>
+Q_INLINE_TEMPLATE typename QFlatMap<Key, T, Compare>::iterator QFlatMap<Key, T, Compare>::insert(const Key &key, const T &value)
+{
+    const int i = int(lowerBoundIndex(key));
+    if (i < k.size() && !lessThan(key, k.at(i))) {
+        v[i] = value;
+    } else {
+        k.insert(i, key);
+        v.insert(i, value);
+    }
+    return begin() + i;
+}
+
+template <class Key, class T, class Compare>
+Q_OUTOFLINE_TEMPLATE void QFlatMap<Key, T, Compare>::insert(const QFlatMap &map)
+{
+    if (map.isEmpty() || isSharedWith(map))
+        return;
+    if (isEmpty()) {
+        *this = map;
+        return;
+    }
+
+    // merge the two sorted ranges, taking the values of map for equal keys
+    QVector<Key> mergedKeys;
+    QVector<T> mergedValues;
+    mergedKeys.reserve(k.size() + map.k.size());
+    mergedValues.reserve(k.size() + map.k.size());
+    int i = 0;
+    int j = 0;
+    while (i < k.size() || j < map.k.size()) {
+        if (j == map.k.size() || (i < k.size() && lessThan(k.at(i), map.k.at(j)))) {
+            mergedKeys.append(k.at(i));
+            mergedValues.append(v.at(i));
+            ++i;
+        } else {
+            if (i < k.size() && !lessThan(map.k.at(j), k.at(i)))
+                ++i;
+            mergedKeys.append(map.k.at(j));
+            mergedValues.append(map.v.at(j));
+            ++j;
+        }
+    }
+    k.swap(mergedKeys);
+    v.swap(mergedValues);
+}
+
+template <class Key, class T, class Compare>
+Q_OUTOFLINE_TEMPLATE QMap<Key, T> QFlatMap<Key, T, Compare>::toMap() const
+{
+    QMap<Key, T> map;
+    for (int i = 0, n = k.size(); i < n; ++i)
+        map.insert(map.constEnd(), k.at(i), v.at(i));
+    return map;
+}
+
+template <class Key, class T, class Compare>
+inline void swap(QFlatMap<Key, T, Compare> &value1, QFlatMap<Key, T, Compare> &value2) noexcept
+{ value1.swap(value2); }
+
+QT_END_NAMESPACE
+
+#endif // QFLATMAP_H
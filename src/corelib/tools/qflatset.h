@@ -0,0 +1,212 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QFLATSET_H
+#define QFLATSET_H
+
+#include <QtCore/qflathash.h>
+
+#include <initializer_list>
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+template <class T>
+class QFlatSet
+{
+    typedef QFlatHash<T, QHashDummyValue> Hash;
+
+public:
+    QFlatSet() noexcept {}
+    QFlatSet(std::initializer_list<T> list)
+        : QFlatSet(list.begin(), list.end()) {}
+    template <typename InputIterator, QtPrivate::IfIsInputIterator<InputIterator> = true>
+    QFlatSet(InputIterator first, InputIterator last)
+    {
+        QtPrivate::reserveIfForwardIterator(this, first, last);
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    // compiler-generated copy/move ctor/assignment operators are fine!
+    // compiler-generated destructor is fine!
+
+    void swap(QFlatSet<T> &other) noexcept { q_hash.swap(other.q_hash); }
+
+    bool operator==(const QFlatSet<T> &other) const { return q_hash == other.q_hash; }
+    bool operator!=(const QFlatSet<T> &other) const { return q_hash != other.q_hash; }
+
+    qsizetype size() const noexcept { return q_hash.size(); }
+    qsizetype count() const noexcept { return q_hash.size(); }
+    bool isEmpty() const noexcept { return q_hash.isEmpty(); }
+
+    qsizetype capacity() const noexcept { return q_hash.capacity(); }
+    void reserve(qsizetype size) { q_hash.reserve(size); }
+    void squeeze() { q_hash.squeeze(); }
+
+    void detach() { q_hash.detach(); }
+    bool isDetached() const noexcept { return q_hash.isDetached(); }
+
+    void clear() { q_hash.clear(); }
+
+    bool remove(const T &value) { return q_hash.remove(value); }
+
+    bool contains(const T &value) const { return q_hash.contains(value); }
+    template <typename K, QFlatHashPrivate::IfLookupKey<T, K> = true>
+    bool contains(const K &value) const { return q_hash.contains(value); }
+
+    class const_iterator
+    {
+        typename Hash::const_iterator i;
+        friend class QFlatSet<T>;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef qptrdiff difference_type;
+        typedef T value_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        const_iterator() = default;
+        const_iterator(typename Hash::const_iterator o) : i(o) {}
+
+        const T &operator*() const { return i.key(); }
+        const T *operator->() const { return &i.key(); }
+        bool operator==(const const_iterator &o) const { return i == o.i; }
+        bool operator!=(const const_iterator &o) const { return i != o.i; }
+        const_iterator &operator++() { ++i; return *this; }
+        const_iterator operator++(int) { const_iterator r = *this; ++i; return r; }
+    };
+    typedef const_iterator iterator;
+
+    // STL style
+    const_iterator begin() const noexcept { return q_hash.constBegin(); }
+    const_iterator cbegin() const noexcept { return q_hash.constBegin(); }
+    const_iterator constBegin() const noexcept { return q_hash.constBegin(); }
+    const_iterator end() const noexcept { return q_hash.constEnd(); }
+    const_iterator cend() const noexcept { return q_hash.constEnd(); }
+    const_iterator constEnd() const noexcept { return q_hash.constEnd(); }
+
+    const_iterator erase(const_iterator i) { return q_hash.erase(i.i); }
+
+    const_iterator find(const T &value) const { return q_hash.constFind(value); }
+    const_iterator constFind(const T &value) const { return q_hash.constFind(value); }
+    template <typename K, QFlatHashPrivate::IfLookupKey<T, K> = true>
+    const_iterator find(const K &value) const { return q_hash.constFind(value); }
+    template <typename K, QFlatHashPrivate::IfLookupKey<T, K> = true>
+    const_iterator constFind(const K &value) const { return q_hash.constFind(value); }
+
+    const_iterator insert(const T &value)
+    { return static_cast<typename Hash::const_iterator>(q_hash.insert(value, QHashDummyValue())); }
+    const_iterator insert(T &&value)
+    { return static_cast<typename Hash::const_iterator>(q_hash.insert(std::move(value), QHashDummyValue())); }
+
+    QFlatSet<T> &unite(const QFlatSet<T> &other);
+    QFlatSet<T> &intersect(const QFlatSet<T> &other);
+    QFlatSet<T> &subtract(const QFlatSet<T> &other);
+
+    QList<T> values() const { return q_hash.keys(); }
+
+    // STL compatibility
+    typedef T key_type;
+    typedef T value_type;
+    typedef value_type *pointer;
+    typedef const value_type *const_pointer;
+    typedef value_type &reference;
+    typedef const value_type &const_reference;
+    typedef qptrdiff difference_type;
+    typedef qsizetype size_type;
+
+    bool empty() const noexcept { return isEmpty(); }
+
+    // comfort
+    QFlatSet<T> &operator<<(const T &value) { insert(value); return *this; }
+    QFlatSet<T> &operator|=(const QFlatSet<T> &other) { unite(other); return *this; }
+    QFlatSet<T> &operator|=(const T &value) { insert(value); return *this; }
+    QFlatSet<T> &operator&=(const QFlatSet<T> &other) { intersect(other); return *this; }
+    QFlatSet<T> &operator&=(const T &value)
+        { QFlatSet<T> result; if (contains(value)) result.insert(value); return (*this = result); }
+    QFlatSet<T> &operator-=(const QFlatSet<T> &other) { subtract(other); return *this; }
+    QFlatSet<T> &operator-=(const T &value) { remove(value); return *this; }
+
+private:
+    Hash q_hash;
+};
+
+template <class T>
+Q_INLINE_TEMPLATE QFlatSet<T> &QFlatSet<T>::unite(const QFlatSet<T> &other)
+{
+    if (!q_hash.isSharedWith(other.q_hash)) {
+        q_hash.reserve(size() + other.size());
+        for (const T &e : other)
+            insert(e);
+    }
+    return *this;
+}
+
+template <class T>
+Q_INLINE_TEMPLATE QFlatSet<T> &QFlatSet<T>::intersect(const QFlatSet<T> &other)
+{
+    QFlatSet<T> result;
+    for (const T &e : *this) {
+        if (other.contains(e))
+            result.insert(e);
+    }
+    return (*this = std::move(result));
+}
+
+template <class T>
+Q_INLINE_TEMPLATE QFlatSet<T> &QFlatSet<T>::subtract(const QFlatSet<T> &other)
+{
+    if (q_hash.isSharedWith(other.q_hash)) {
+        clear();
+    } else {
+        for (const T &e : other)
+            remove(e);
+    }
+    return *this;
+}
+
+template <class T>
+inline void swap(QFlatSet<T> &value1, QFlatSet<T> &value2) noexcept
+{ value1.swap(value2); }
+
+QT_END_NAMESPACE
+
+#endif // QFLATSET_H
@@ -203,6 +203,12 @@ public:
     */
     inline int next();
     inline void release(int id);
+
+    /*
+        Return the id of the element whose payload is at \a payload, or -1
+        if \a payload is not in this free list.
+    */
+    inline int indexOf(const void *payload) const;
 };
 
 template <typename T, typename ConstantsType>
@@ -287,6 +293,23 @@ inline void QFreeList<T, ConstantsType>::release(int id)
     //        (newid & ~ConstantsType::IndexMask) >> 24);
 }
 
+template <typename T, typename ConstantsType>
+inline int QFreeList<T, ConstantsType>::indexOf(const void *payload) const
+{
+    const quintptr p = quintptr(payload);
+    int offset = 0;
+    for (int i = 0; i < ConstantsType::BlockCount; ++i) {
+        const int size = ConstantsType::Sizes[i];
+        const ElementType *v = _v[i].loadAcquire();
+        if (v && p >= quintptr(v) && p < quintptr(v + size)) {
+            Q_ASSERT((p - quintptr(v)) % sizeof(ElementType) == 0);
+            return offset + int((p - quintptr(v)) / sizeof(ElementType));
+        }
+        offset += size;
+    }
+    return -1;
+}
+
 QT_END_NAMESPACE
 
 #endif // QFREELIST_P_H
@@ -269,6 +269,38 @@ uint qHash(QLatin1String key, uint seed) noexcept
     return hash(reinterpret_cast<const uchar *>(key.data()), size_t(key.size()), seed);
 }
 
+/*!
+    \internal
+
+    Returns the hash value of \a key as if it were converted to a QString
+    first, using \a seed to seed the calculation. QFlatHash uses this to
+    look up QString keys by QLatin1String without converting them.
+*/
+uint QtPrivate::qHashLatin1AsUtf16(QLatin1String key, uint seed) noexcept
+{
+    const uchar *p = reinterpret_cast<const uchar *>(key.data());
+    const size_t len = size_t(key.size());
+    uint h = seed;
+
+    if (seed && hasFastCrc32()) {
+        // CRC32 is a function of the byte stream, so it can be fed in chunks
+        ushort buffer[64];
+        for (size_t i = 0; i < len; ) {
+            const size_t n = qMin(len - i, sizeof(buffer) / sizeof(buffer[0]));
+            for (size_t j = 0; j < n; ++j)
+                buffer[j] = p[i + j];
+            h = crc32(buffer, n, h);
+            i += n;
+        }
+        return h;
+    }
+
+    for (size_t i = 0; i < len; ++i)
+        h = 31 * h + p[i];
+
+    return h;
+}
+
 /*!
     \internal
 
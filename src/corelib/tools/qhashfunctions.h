@@ -105,6 +105,11 @@ Q_CORE_EXPORT Q_DECL_PURE_FUNCTION uint qHash(const QBitArray &key, uint seed =
 Q_CORE_EXPORT Q_DECL_PURE_FUNCTION uint qHash(QLatin1String key, uint seed = 0) noexcept;
 Q_CORE_EXPORT Q_DECL_PURE_FUNCTION uint qt_hash(QStringView key, uint chained = 0) noexcept;
 
+namespace QtPrivate {
+// hashes key like qHash() hashes the QString that holds the same characters
+Q_CORE_EXPORT Q_DECL_PURE_FUNCTION uint qHashLatin1AsUtf16(QLatin1String key, uint seed) noexcept;
+}
+
 Q_DECL_CONST_FUNCTION inline uint qHash(std::nullptr_t, uint seed = 0) noexcept
 {
     return qHash(reinterpret_cast<quintptr>(nullptr), seed);
@@ -13,6 +13,9 @@ HEADERS +=  \
         tools/qcontainertools_impl.h \
         tools/qcryptographichash.h \
         tools/qfreelist_p.h \
+        tools/qflathash.h \
+        tools/qflatmap.h \
+        tools/qflatset.h \
         tools/qhash.h \
         tools/qhashfunctions.h \
         tools/qiterator.h \
@@ -1149,7 +1149,8 @@ void QHttp2ProtocolHandler::updateStream(Stream &stream, const HPack::HttpHeader
             QByteArray binder(", ");
             if (name == "set-cookie")
                 binder = "\n";
-            httpReplyPrivate->fields.append(qMakePair(name, value.replace('\0', binder)));
+            httpReplyPrivate->fields.append(qMakePair(QHttpNetworkHeaderPrivate::internedFieldName(name),
+                                                      value.replace('\0', binder)));
         }
     }
 
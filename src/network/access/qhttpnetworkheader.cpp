@@ -39,10 +39,31 @@
 
 #include "qhttpnetworkheader_p.h"
 
+#include <QtCore/qstringpool.h>
+
 #include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
+// Field names repeat across replies, so replies can share their storage.
+// This is opt-in, with QT_HTTP_INTERN_FIELD_NAMES=1. The names come from the
+// network, so the pool is bounded, and it starts over once it is full
+// instead of keeping whatever names a peer sent first.
+enum { MaxInternedFieldNames = 1024, MaxInternedFieldNameSize = 64 };
+Q_GLOBAL_STATIC_WITH_ARGS(QByteArrayPool, fieldNamePool, (MaxInternedFieldNames))
+
+static QByteArrayPool *activeFieldNamePool()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QT_HTTP_INTERN_FIELD_NAMES") > 0;
+    if (!enabled)
+        return nullptr;
+
+    QByteArrayPool *pool = fieldNamePool();
+    if (pool && pool->size() >= MaxInternedFieldNames)
+        pool->clear(); // names handed out earlier stay valid
+    return pool;
+}
+
 QHttpNetworkHeaderPrivate::QHttpNetworkHeaderPrivate(const QUrl &newUrl)
     :url(newUrl)
 {
@@ -123,4 +144,22 @@ bool QHttpNetworkHeaderPrivate::operator==(const QHttpNetworkHeaderPrivate &othe
 }
 
 
+QByteArray QHttpNetworkHeaderPrivate::internedFieldName(const char *name, qsizetype size)
+{
+    if (size > MaxInternedFieldNameSize)
+        return QByteArray(name, int(size));
+    if (QByteArrayPool *pool = activeFieldNamePool())
+        return pool->intern(name, size);
+    return QByteArray(name, int(size));
+}
+
+QByteArray QHttpNetworkHeaderPrivate::internedFieldName(const QByteArray &name)
+{
+    if (name.size() > MaxInternedFieldNameSize)
+        return name;
+    if (QByteArrayPool *pool = activeFieldNamePool())
+        return pool->intern(name);
+    return name;
+}
+
 QT_END_NAMESPACE
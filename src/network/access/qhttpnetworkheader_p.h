@@ -95,6 +95,8 @@ public:
     void prependHeaderField(const QByteArray &name, const QByteArray &data);
     bool operator==(const QHttpNetworkHeaderPrivate &other) const;
 
+    static QByteArray internedFieldName(const char *name, qsizetype size);
+    static QByteArray internedFieldName(const QByteArray &name);
 };
 
 
@@ -40,6 +40,8 @@
 #include "qhttpnetworkreply_p.h"
 #include "qhttpnetworkconnection_p.h"
 
+#include <private/qstringalgorithms_p.h>
+
 #ifndef QT_NO_SSL
 #    include <QtNetwork/qsslkey.h>
 #    include <QtNetwork/qsslcipher.h>
@@ -616,7 +618,10 @@ void QHttpNetworkReplyPrivate::parseHeader(const QByteArray &header)
         int j = header.indexOf(':', i); // field-name
         if (j == -1)
             break;
-        const QByteArray field = header.mid(i, j - i).trimmed();
+        const char *nameBegin = header.constData() + i;
+        const char *nameEnd = header.constData() + j;
+        QStringAlgorithms<const QByteArray>::trimmed_helper_positions(nameBegin, nameEnd);
+        const QByteArray field = internedFieldName(nameBegin, nameEnd - nameBegin);
         j++;
         // any number of LWS is allowed before and after the value
         QByteArray value;
@@ -1256,19 +1256,26 @@ bool QAbstractSocketPrivate::readFromSocket()
                bytesToRead);
 #endif
 
-        // Read from the socket, store data in the read buffer.
-        char *ptr = buffer.reserve(bytesToRead);
-        qint64 readBytes = socketEngine->read(ptr, bytesToRead);
-        if (readBytes == -2) {
-            // No bytes currently available for reading.
-            buffer.chop(bytesToRead);
-            return true;
-        }
-        buffer.chop(bytesToRead - (readBytes < 0 ? qint64(0) : readBytes));
+        // Take over the data that the socket engine has read already, if
+        // any, without copying it. Otherwise read from the socket, store
+        // data in the read buffer.
+        const QByteArray chunk = socketEngine->readChunk(bytesToRead);
+        if (!chunk.isEmpty()) {
+            buffer.append(chunk);
+        } else {
+            char *ptr = buffer.reserve(bytesToRead);
+            qint64 readBytes = socketEngine->read(ptr, bytesToRead);
+            if (readBytes == -2) {
+                // No bytes currently available for reading.
+                buffer.chop(bytesToRead);
+                return true;
+            }
+            buffer.chop(bytesToRead - (readBytes < 0 ? qint64(0) : readBytes));
 #if defined(QABSTRACTSOCKET_DEBUG)
-        qDebug("QAbstractSocketPrivate::readFromSocket() got %lld bytes, buffer size = %lld",
-               readBytes, buffer.size());
+            qDebug("QAbstractSocketPrivate::readFromSocket() got %lld bytes, buffer size = %lld",
+                   readBytes, buffer.size());
 #endif
+        }
     } else {
         // Discard unwanted data if opened in WriteOnly mode
         QVarLengthArray<char, 4096> discardBuffer(bytesToRead);
@@ -149,6 +149,22 @@ void QAbstractSocketEngine::setError(QAbstractSocket::SocketError error, const Q
     d->socketErrorString = errorString;
 }
 
+/*!
+    \internal
+
+    Returns a block of at most \a maxlen bytes that the engine has already
+    read from the socket, so that it can be appended to the read buffer of
+    QAbstractSocket without copying. Returns an empty QByteArray if there
+    is no such block; read() must be used then.
+
+    The default implementation always returns an empty QByteArray.
+*/
+QByteArray QAbstractSocketEngine::readChunk(qint64 maxlen)
+{
+    Q_UNUSED(maxlen);
+    return QByteArray();
+}
+
 void QAbstractSocketEngine::setReceiver(QAbstractSocketEngineReceiver *receiver)
 {
     d_func()->receiver = receiver;
@@ -139,6 +139,7 @@ public:
     virtual qint64 bytesAvailable() const = 0;
 
     virtual qint64 read(char *data, qint64 maxlen) = 0;
+    virtual QByteArray readChunk(qint64 maxlen);
     virtual qint64 write(const char *data, qint64 len) = 0;
 
 #ifndef QT_NO_UDPSOCKET
@@ -194,6 +194,9 @@ QNativeSocketEnginePrivate::QNativeSocketEnginePrivate() :
     readNotifier(0),
     writeNotifier(0),
     exceptNotifier(0)
+#if QT_CONFIG(io_uring)
+    , readAheadDisabled(false)
+#endif
 {
 #if defined(Q_OS_WIN) && !defined(Q_OS_WINRT)
     QSysInfo::machineHostName();        // this initializes ws2_32.dll
@@ -207,6 +210,42 @@ QNativeSocketEnginePrivate::~QNativeSocketEnginePrivate()
 {
 }
 
+#if QT_CONFIG(io_uring)
+/*! \internal
+
+    Lets an io_uring event dispatcher read from the socket of a connected
+    TCP socket engine, see QEventDispatcherIoUring::registerReadAhead().
+    The data is then served from readAhead by nativeRead() and readChunk().
+*/
+void QNativeSocketEnginePrivate::startReadAhead()
+{
+    if (readAheadDispatcher || readAheadDisabled || !readNotifier
+            || socketType != QAbstractSocket::TcpSocket
+            || socketState != QAbstractSocket::ConnectedState) {
+        return;
+    }
+
+    auto dispatcher = qobject_cast<QEventDispatcherIoUring *>(threadData->eventDispatcher.loadRelaxed());
+    if (dispatcher && dispatcher->registerReadAhead(readNotifier, &readAhead))
+        readAheadDispatcher = dispatcher;
+}
+
+/*! \internal
+
+    Stops the read-ahead; the data that was read already stays in readAhead.
+    If \a disable is \c true, it is not started again, which is what the
+    blocking waitFor functions need: they poll the socket directly.
+*/
+void QNativeSocketEnginePrivate::stopReadAhead(bool disable)
+{
+    if (readAheadDispatcher)
+        readAheadDispatcher->unregisterReadAhead(readNotifier);
+    readAheadDispatcher = nullptr;
+    if (disable)
+        readAheadDisabled = true;
+}
+#endif
+
 /*! \internal
 
     Sets the error and error string if not set already. The only
@@ -958,6 +997,25 @@ qint64 QNativeSocketEngine::read(char *data, qint64 maxSize)
     return readBytes;
 }
 
+/*!
+    \reimp
+
+    Returns the next block of data that the io_uring event dispatcher has
+    read ahead, if it is not larger than \a maxSize.
+*/
+QByteArray QNativeSocketEngine::readChunk(qint64 maxSize)
+{
+#if QT_CONFIG(io_uring)
+    Q_D(QNativeSocketEngine);
+    const qint64 blockSize = d->readAhead.buffer.nextDataBlockSize();
+    if (blockSize > 0 && blockSize <= maxSize)
+        return d->readAhead.buffer.read();
+#else
+    Q_UNUSED(maxSize);
+#endif
+    return QByteArray();
+}
+
 /*!
     Closes the socket. In order to use the socket again, initialize()
     must be called.
@@ -965,6 +1023,10 @@ qint64 QNativeSocketEngine::read(char *data, qint64 maxSize)
 void QNativeSocketEngine::close()
 {
     Q_D(QNativeSocketEngine);
+#if QT_CONFIG(io_uring)
+    d->stopReadAhead();
+    d->readAhead = QIoUringReadAhead();
+#endif
     if (d->readNotifier)
         d->readNotifier->setEnabled(false);
     if (d->writeNotifier)
@@ -1014,7 +1076,7 @@ void QNativeSocketEngine::close()
 */
 bool QNativeSocketEngine::waitForRead(int msecs, bool *timedOut)
 {
-    Q_D(const QNativeSocketEngine);
+    Q_D(QNativeSocketEngine);
     Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::waitForRead(), false);
     Q_CHECK_NOT_STATE(QNativeSocketEngine::waitForRead(),
                       QAbstractSocket::UnconnectedState, false);
@@ -1022,6 +1084,12 @@ bool QNativeSocketEngine::waitForRead(int msecs, bool *timedOut)
     if (timedOut)
         *timedOut = false;
 
+#if QT_CONFIG(io_uring)
+    d->stopReadAhead(true);
+    if (!d->readAhead.isEmpty())
+        return true;
+#endif
+
     int ret = d->nativeSelect(msecs, true);
     if (ret == 0) {
         if (timedOut)
@@ -1117,6 +1185,19 @@ bool QNativeSocketEngine::waitForReadOrWrite(bool *readyToRead, bool *readyToWri
     Q_CHECK_NOT_STATE(QNativeSocketEngine::waitForReadOrWrite(),
                       QAbstractSocket::UnconnectedState, false);
 
+#if QT_CONFIG(io_uring)
+    if (checkRead) {
+        d->stopReadAhead(true);
+        if (!d->readAhead.isEmpty()) {
+            *readyToRead = true;
+            *readyToWrite = false;
+            if (timedOut)
+                *timedOut = false;
+            return true;
+        }
+    }
+#endif
+
     int ret = d->nativeSelect(msecs, checkRead, checkWrite, readyToRead, readyToWrite);
     // On Windows, the socket is in connected state if a call to
     // select(writable) is successful. In this case we should not
@@ -1277,6 +1358,22 @@ bool QReadNotifier::event(QEvent *e)
         engine->closeNotification();
         return true;
     }
+#if QT_CONFIG(io_uring)
+    else if (e->type() == QEvent::ThreadChange) {
+        // the read-ahead belongs to the dispatcher of the old thread;
+        // resume it in the new one, and report what was read already
+        auto d = static_cast<QNativeSocketEnginePrivate *>(QObjectPrivate::get(engine));
+        if (d->readAheadDispatcher) {
+            d->stopReadAhead();
+            QNativeSocketEngine *socketEngine = engine;
+            QMetaObject::invokeMethod(engine, [socketEngine, d]() {
+                d->startReadAhead();
+                if (!d->readAhead.isEmpty())
+                    socketEngine->readNotification();
+            }, Qt::QueuedConnection);
+        }
+    }
+#endif
     return QSocketNotifier::event(e);
 }
 
@@ -1345,6 +1442,10 @@ void QNativeSocketEngine::setReadNotificationEnabled(bool enable)
         d->readNotifier = new QReadNotifier(d->socketDescriptor, this);
         d->readNotifier->setEnabled(true);
     }
+#if QT_CONFIG(io_uring)
+    if (enable)
+        d->startReadAhead();
+#endif
 }
 
 bool QNativeSocketEngine::isWriteNotificationEnabled() const
@@ -56,6 +56,10 @@
 #include "QtNetwork/qhostaddress.h"
 #include "QtNetwork/qnetworkinterface.h"
 #include "private/qabstractsocketengine_p.h"
+#if QT_CONFIG(io_uring)
+#  include <QtCore/qpointer.h>
+#  include <QtCore/private/qeventdispatcher_iouring_p.h>
+#endif
 #ifndef Q_OS_WIN
 #  include "qplatformdefs.h"
 #  include <netinet/in.h>
@@ -145,6 +149,7 @@ public:
     qint64 bytesAvailable() const override;
 
     qint64 read(char *data, qint64 maxlen) override;
+    QByteArray readChunk(qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
 
 #ifndef QT_NO_UDPSOCKET
@@ -212,6 +217,16 @@ public:
 
     QSocketNotifier *readNotifier, *writeNotifier, *exceptNotifier;
 
+#if QT_CONFIG(io_uring)
+    void startReadAhead();
+    void stopReadAhead(bool disable = false);
+
+    // data read by an io_uring event dispatcher, see startReadAhead()
+    QIoUringReadAhead readAhead;
+    QPointer<QEventDispatcherIoUring> readAheadDispatcher;
+    bool readAheadDisabled;
+#endif
+
 #if defined(Q_OS_WIN)
     LPFN_WSASENDMSG sendmsg;
     LPFN_WSARECVMSG recvmsg;
@@ -836,6 +836,12 @@ bool QNativeSocketEnginePrivate::nativeSetMulticastInterface(const QNetworkInter
 
 qint64 QNativeSocketEnginePrivate::nativeBytesAvailable() const
 {
+#if QT_CONFIG(io_uring)
+    // the socket itself may hold more, but that is not ours to read yet
+    if (readAheadDispatcher || !readAhead.isEmpty())
+        return readAhead.buffer.size();
+#endif
+
     int nbytes = 0;
     // gives shorter than true amounts on Unix domain sockets.
     qint64 available = -1;
@@ -1374,6 +1380,13 @@ qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
     }
 
     ssize_t r = 0;
+#if QT_CONFIG(io_uring)
+    // while the event dispatcher reads ahead, reading the socket directly
+    // could reorder the data
+    if (readAheadDispatcher || !readAhead.isEmpty())
+        r = readAhead.read(data, maxSize);
+    else
+#endif
     r = qt_safe_read(socketDescriptor, data, maxSize);
 
     if (r < 0) {
@@ -84,6 +84,7 @@ SOURCES += \
            ../../corelib/text/qstringbuilder.cpp \
            ../../corelib/text/qstring_compat.cpp \
            ../../corelib/text/qstringlist.cpp \
+           ../../corelib/text/qstringsearch.cpp \
            ../../corelib/text/qstringview.cpp \
            ../../corelib/text/qvsnprintf.cpp \
            ../../corelib/time/qcalendar.cpp \
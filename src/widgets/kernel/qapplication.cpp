@@ -88,6 +88,7 @@
 
 #include <qthread.h>
 #include <private/qthread_p.h>
+#include <private/qeventloopstatistics_p.h>
 
 #include <private/qfont_p.h>
 
@@ -3660,6 +3661,7 @@ bool QApplicationPrivate::notify_helper(QObject *receiver, QEvent * e)
     bool consumed = false;
     bool filtered = false;
     Q_TRACE_EXIT(QApplication_notify_exit, consumed, filtered);
+    QEventTiming timing(receiver, e);
 
     // send to all application event filters
     if (threadRequiresCoreApplication()
@@ -31,6 +31,8 @@
 #include <qtextcodec.h>
 #include <QScopedPointer>
 
+#include <private/qutfcodec_p.h>
+
 static const char utf8bom[] = "\xEF\xBB\xBF";
 
 class tst_Utf8 : public QObject
@@ -53,6 +55,9 @@ private slots:
     void roundTrip_data();
     void roundTrip();
 
+    void longMixedScripts_data();
+    void longMixedScripts();
+
     void charByChar_data();
     void charByChar();
 
@@ -61,6 +66,9 @@ private slots:
 
     void nonCharacters_data();
     void nonCharacters();
+
+    void isValidUtf8_data();
+    void isValidUtf8();
 };
 
 void tst_Utf8::initTestCase()
@@ -168,6 +176,66 @@ void tst_Utf8::roundTrip()
     QCOMPARE(from8Bit(to8Bit(utf16)), utf16);
 }
 
+void tst_Utf8::longMixedScripts_data()
+{
+    QTest::addColumn<QByteArray>("utf8");
+    QTest::addColumn<QString>("utf16");
+
+    const char16_t latin1[] = { 'G', 'r', 0xfc, 0xdf, 'e', 0 };
+    const char16_t cyrillic[] = { 0x41f, 0x440, 0x438, 0x432, 0x435, 0x442, 0 };
+    const char16_t cjk[] = { 0x6f22, 0x5b57, 0x304b, 0x306a, 0 };
+    const char16_t emoji[] = { 0xd83d, 0xde00, 0xd83c, 0xdf0d, 0 };
+
+    QTest::newRow("latin1") << QByteArray("Gr\303\274\303\237e")
+                            << QString::fromUtf16(latin1);
+    QTest::newRow("cyrillic") << QByteArray("\320\237\321\200\320\270\320\262\320\265\321\202")
+                              << QString::fromUtf16(cyrillic);
+    QTest::newRow("cjk") << QByteArray("\346\274\242\345\255\227\343\201\213\343\201\252")
+                         << QString::fromUtf16(cjk);
+    QTest::newRow("emoji") << QByteArray("\360\237\230\200\360\237\214\215")
+                           << QString::fromUtf16(emoji);
+    QTest::newRow("mixed")
+            << QByteArray("Gr\303\274\303\237e \320\237\321\200\320\270\320\262\320\265\321\202 "
+                          "\346\274\242\345\255\227 \360\237\230\200")
+            << (QString::fromUtf16(latin1) + QLatin1Char(' ') + QString::fromUtf16(cyrillic)
+                + QLatin1Char(' ') + QString::fromUtf16(cjk, 2) + QLatin1Char(' ')
+                + QString::fromUtf16(emoji, 2));
+}
+
+void tst_Utf8::longMixedScripts()
+{
+    QFETCH(QByteArray, utf8);
+    QFETCH(QString, utf16);
+
+    // long enough to go through the vectorized code paths, with every
+    // alignment of the text relative to the start of the string
+    QByteArray longUtf8;
+    QString longUtf16;
+    for (int i = 0; i < 32; ++i) {
+        longUtf8 += utf8.repeated(i + 1) + QByteArray(i, 'x');
+        longUtf16 += utf16.repeated(i + 1) + QString(i, QLatin1Char('x'));
+    }
+
+    for (int start = 0; start < 32; ++start) {
+        const QByteArray prefix(start, '-');
+        const QString prefix16(start, QLatin1Char('-'));
+        QCOMPARE(to8Bit(prefix16 + longUtf16), prefix + longUtf8);
+        QCOMPARE(from8Bit(prefix + longUtf8), prefix16 + longUtf16);
+    }
+
+    // an invalid sequence anywhere in a long valid string must be found
+    QFETCH_GLOBAL(bool, useLocale);
+    if (useLocale)
+        return;
+    for (int pos = 0; pos < longUtf8.size(); pos += 7) {
+        QByteArray broken = longUtf8;
+        broken[pos] = char(0xff);
+        const QScopedPointer<QTextDecoder> decoder(codec->makeDecoder());
+        decoder->toUnicode(broken);
+        QVERIFY2(decoder->hasFailure(), QByteArray::number(pos));
+    }
+}
+
 void tst_Utf8::charByChar_data()
 {
     roundTrip_data();
@@ -273,5 +341,40 @@ void tst_Utf8::nonCharacters()
         qWarning("System codec reports failure when it shouldn't. Should report bug upstream.");
 }
 
+void tst_Utf8::isValidUtf8_data()
+{
+    QTest::addColumn<QByteArray>("utf8");
+    QTest::addColumn<bool>("isValidUtf8");
+    QTest::addColumn<bool>("isValidAscii");
+
+    QTest::newRow("empty") << QByteArray() << true << true;
+    QTest::newRow("ascii-short") << QByteArray("Hello") << true << true;
+    QTest::newRow("ascii-64") << QByteArray(64, 'a') << true << true;
+    QTest::newRow("ascii-1000") << QByteArray("0123456789").repeated(100) << true << true;
+    QTest::newRow("latin1-end") << (QByteArray(64, 'a') + "\303\274") << true << false;
+    QTest::newRow("latin1-start") << ("\303\274" + QByteArray(64, 'a')) << true << false;
+    QTest::newRow("cjk-long") << QByteArray("\346\274\242\345\255\227").repeated(20)
+                              << true << false;
+    QTest::newRow("invalid-end") << (QByteArray(64, 'a') + char(0xff)) << false << false;
+    QTest::newRow("invalid-middle") << (QByteArray(40, 'a') + "\303\274\377" + QByteArray(40, 'a'))
+                                    << false << false;
+}
+
+void tst_Utf8::isValidUtf8()
+{
+#ifdef QT_BUILD_INTERNAL
+    QFETCH(QByteArray, utf8);
+    QFETCH(bool, isValidUtf8);
+    QFETCH(bool, isValidAscii);
+
+    const QUtf8::ValidUtf8Result result = QUtf8::isValidUtf8(utf8.constData(), utf8.size());
+    QCOMPARE(result.isValidUtf8, isValidUtf8);
+    if (isValidUtf8)
+        QCOMPARE(result.isValidAscii, isValidAscii);
+#else
+    QSKIP("This test requires QT_BUILD_INTERNAL");
+#endif
+}
+
 QTEST_MAIN(tst_Utf8)
 #include "tst_utf8.moc"
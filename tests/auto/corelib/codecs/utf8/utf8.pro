@@ -1,4 +1,4 @@
 CONFIG += testcase
 TARGET = tst_utf8
-QT = core testlib
+QT = core-private testlib
 SOURCES  += tst_utf8.cpp utf8data.cpp
@@ -5,6 +5,7 @@ SUBDIRS=\
     qelapsedtimer \
     qeventdispatcher \
     qeventloop \
+    qeventloopstatistics \
     qmath \
     qmetaobject \
     qmetaobjectbuilder \
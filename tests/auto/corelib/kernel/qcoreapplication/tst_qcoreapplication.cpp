@@ -532,6 +532,233 @@ void tst_QCoreApplication::deliverInDefinedOrder()
     QObject::connect(&obj, SIGNAL(done()), &app, SLOT(quit()));
     app.exec();
 }
+
+class PlainMetaCallReceiver : public QObject
+{
+public:
+    int received = 0;
+
+    bool event(QEvent *event) override
+    {
+        if (event->type() == QEvent::MetaCall && !dynamic_cast<QAbstractMetaCallEvent *>(event)) {
+            ++received;
+            return true;
+        }
+        return QObject::event(event);
+    }
+};
+
+void tst_QCoreApplication::postPlainMetaCallEvent()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    const QPostEventList &postEventList = QThreadData::current()->postEventList;
+    PlainMetaCallReceiver receiver;
+
+    // a plain QEvent of type MetaCall lacks the fields of
+    // QAbstractMetaCallEvent that the lock-free path links through
+    for (int i = 0; i < 10; ++i)
+        QCoreApplication::postEvent(&receiver, new QEvent(QEvent::MetaCall));
+    QVERIFY(!postEventList.hasIncomingEvents());
+
+    // a queued call takes it
+    QMetaObject::invokeMethod(&receiver, "deleteLater", Qt::QueuedConnection);
+    QVERIFY(postEventList.hasIncomingEvents());
+    QCoreApplication::removePostedEvents(&receiver, QEvent::MetaCall);
+    QVERIFY(!postEventList.hasIncomingEvents());
+
+    for (int i = 0; i < 10; ++i)
+        QCoreApplication::postEvent(&receiver, new QEvent(QEvent::MetaCall));
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(receiver.received, 10);
+}
+
+class SequenceEvent : public QEvent
+{
+public:
+    SequenceEvent(int producer, int n)
+        : QEvent(QEvent::User), producer(producer), n(n)
+    { }
+    int producer;
+    int n;
+};
+
+class SequenceReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SequenceReceiver(int producers)
+        : next(producers, 0)
+    { }
+
+    QVector<int> next;
+    int received = 0;
+    int outOfOrder = 0;
+
+    bool event(QEvent *event) override
+    {
+        if (event->type() != QEvent::User)
+            return QObject::event(event);
+        const SequenceEvent *se = static_cast<SequenceEvent *>(event);
+        record(se->producer, se->n);
+        return true;
+    }
+
+public slots:
+    void record(int producer, int n)
+    {
+        if (next[producer] != n)
+            ++outOfOrder;
+        next[producer] = n + 1;
+        ++received;
+    }
+};
+
+class SequenceProducer : public QThread
+{
+public:
+    SequenceProducer(SequenceReceiver *receiver, int producer, int count)
+        : receiver(receiver), producer(producer), count(count)
+    { }
+
+protected:
+    void run() override
+    {
+        // mix queued calls, which skip the post-event mutex, with events
+        // that take it
+        for (int n = 0; n < count; ++n) {
+            if (n % 7 == 0) {
+                QCoreApplication::postEvent(receiver, new SequenceEvent(producer, n));
+            } else {
+                QMetaObject::invokeMethod(receiver, "record", Qt::QueuedConnection,
+                                          Q_ARG(int, producer), Q_ARG(int, n));
+            }
+        }
+    }
+
+private:
+    SequenceReceiver *receiver;
+    int producer;
+    int count;
+};
+
+void tst_QCoreApplication::queuedCallsFromManyThreads()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    const int producerCount = 4;
+    const int count = 5000;
+    SequenceReceiver receiver(producerCount);
+    QVector<SequenceProducer *> producers;
+    for (int i = 0; i < producerCount; ++i)
+        producers.append(new SequenceProducer(&receiver, i, count));
+    for (SequenceProducer *producer : qAsConst(producers))
+        producer->start();
+
+    QTRY_COMPARE(receiver.received, producerCount * count);
+    QCOMPARE(receiver.outOfOrder, 0);
+    for (SequenceProducer *producer : qAsConst(producers))
+        QVERIFY(producer->wait());
+    qDeleteAll(producers);
+}
+
+class CallCounter : public QObject
+{
+    Q_OBJECT
+
+public:
+    QAtomicInt calls;
+    QAtomicInt callsInWrongThread;
+    QAtomicInt pending;
+
+public slots:
+    void call()
+    {
+        if (QThread::currentThread() != thread())
+            callsInWrongThread.ref();
+        calls.ref();
+        pending.deref();
+    }
+};
+
+class CallProducer : public QThread
+{
+public:
+    explicit CallProducer(CallCounter *counter)
+        : counter(counter)
+    { }
+
+    QAtomicInt stop;
+    int posted = 0;
+
+protected:
+    void run() override
+    {
+        while (!stop.loadAcquire()) {
+            // keep the queue bounded, or the producers outrun the
+            // receiver's thread on a machine with few cores
+            if (counter->pending.loadRelaxed() > 1000) {
+                QThread::yieldCurrentThread();
+                continue;
+            }
+            counter->pending.ref();
+            QMetaObject::invokeMethod(counter, "call", Qt::QueuedConnection);
+            ++posted;
+        }
+    }
+
+private:
+    CallCounter *counter;
+};
+
+void tst_QCoreApplication::moveToThreadWhilePosting()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    QThread worker;
+    QObject workerContext;
+    workerContext.moveToThread(&worker);
+    worker.start();
+
+    // the producers never stop posting while the counter changes threads,
+    // so moveToThread() must not wait for posting to pause
+    CallCounter counter;
+    QVector<CallProducer *> producers;
+    for (int i = 0; i < 3; ++i)
+        producers.append(new CallProducer(&counter));
+    for (CallProducer *producer : qAsConst(producers))
+        producer->start();
+
+    QThread *mainThread = QThread::currentThread();
+    for (int i = 0; i < 50; ++i) {
+        QCoreApplication::processEvents();
+        counter.moveToThread(&worker);
+        QMetaObject::invokeMethod(&workerContext, [&]() {
+            counter.moveToThread(mainThread);
+        }, Qt::BlockingQueuedConnection);
+    }
+
+    int posted = 0;
+    for (CallProducer *producer : qAsConst(producers)) {
+        producer->stop.storeRelease(1);
+        QVERIFY(producer->wait());
+        posted += producer->posted;
+    }
+    qDeleteAll(producers);
+
+    QTRY_COMPARE(counter.calls.loadRelaxed(), posted);
+    QCOMPARE(counter.callsInWrongThread.loadRelaxed(), 0);
+
+    worker.quit();
+    QVERIFY(worker.wait());
+}
 #endif // QT_CONFIG(thread)
 
 void tst_QCoreApplication::applicationPid()
@@ -45,6 +45,9 @@ private slots:
     void removePostedEvents();
 #if QT_CONFIG(thread)
     void deliverInDefinedOrder();
+    void postPlainMetaCallEvent();
+    void queuedCallsFromManyThreads();
+    void moveToThreadWhilePosting();
 #endif
     void applicationPid();
     void globalPostedEventsCount();
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qeventloopstatistics
+QT = core testlib
+SOURCES = tst_qeventloopstatistics.cpp
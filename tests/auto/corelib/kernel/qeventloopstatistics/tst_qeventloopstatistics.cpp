@@ -0,0 +1,232 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/QAbstractEventDispatcher>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEventLoopStatistics>
+#include <QtCore/QThread>
+#include <QtTest/QtTest>
+
+static const QEvent::Type TestEventType = QEvent::Type(QEvent::User + 42);
+
+class Receiver : public QObject
+{
+    Q_OBJECT
+public:
+    int received = 0;
+
+protected:
+    bool event(QEvent *e) override
+    {
+        if (e->type() != TestEventType)
+            return QObject::event(e);
+        ++received;
+        return true;
+    }
+};
+
+class tst_QEventLoopStatistics : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void disabled();
+    void histogramBuckets();
+    void eventTimes();
+    void queueDepth();
+    void iterationTime();
+    void otherThread();
+    void reset();
+    void sampling();
+};
+
+void tst_QEventLoopStatistics::init()
+{
+    QEventLoopStatistics::reset();
+    QEventLoopStatistics::setSampleInterval(1);
+}
+
+void tst_QEventLoopStatistics::cleanup()
+{
+    QEventLoopStatistics::setEnabled(false);
+}
+
+void tst_QEventLoopStatistics::disabled()
+{
+    QVERIFY(!QEventLoopStatistics::isEnabled());
+
+    Receiver receiver;
+    QEvent event(TestEventType);
+    QCoreApplication::sendEvent(&receiver, &event);
+    QCOMPARE(receiver.received, 1);
+
+    const QEventLoopStatistics statistics = QEventLoopStatistics::forThread();
+    QCOMPARE(statistics.eventTime(TestEventType).count(), quint64(0));
+    QCOMPARE(statistics.receiverTime(&Receiver::staticMetaObject).count(), quint64(0));
+}
+
+void tst_QEventLoopStatistics::histogramBuckets()
+{
+    using Histogram = QEventLoopStatistics::Histogram;
+    QCOMPARE(Histogram::bucketUpperBound(0), quint64(1));
+    QCOMPARE(Histogram::bucketUpperBound(1), quint64(2));
+    QCOMPARE(Histogram::bucketUpperBound(10), quint64(1024));
+    QCOMPARE(Histogram::bucketUpperBound(Histogram::BucketCount - 1), ~quint64(0));
+
+    const Histogram empty;
+    QCOMPARE(empty.count(), quint64(0));
+    QCOMPARE(empty.sum(), quint64(0));
+    QCOMPARE(empty.maximum(), quint64(0));
+    for (int i = 0; i < Histogram::BucketCount; ++i)
+        QCOMPARE(empty.bucket(i), quint64(0));
+}
+
+void tst_QEventLoopStatistics::eventTimes()
+{
+    QEventLoopStatistics::setEnabled(true);
+    QVERIFY(QEventLoopStatistics::isEnabled());
+
+    Receiver receiver;
+    QEvent event(TestEventType);
+    for (int i = 0; i < 10; ++i)
+        QCoreApplication::sendEvent(&receiver, &event);
+    QCOMPARE(receiver.received, 10);
+
+    const QEventLoopStatistics statistics = QEventLoopStatistics::forThread();
+    QVERIFY(statistics.eventTypes().contains(TestEventType));
+    QVERIFY(statistics.receiverClasses().contains(&Receiver::staticMetaObject));
+
+    const QEventLoopStatistics::Histogram times = statistics.eventTime(TestEventType);
+    QCOMPARE(times.count(), quint64(10));
+    QVERIFY(times.maximum() <= times.sum());
+    quint64 bucketed = 0;
+    for (int i = 0; i < QEventLoopStatistics::Histogram::BucketCount; ++i)
+        bucketed += times.bucket(i);
+    QCOMPARE(bucketed, times.count());
+
+    QCOMPARE(statistics.receiverTime(&Receiver::staticMetaObject).count(), quint64(10));
+}
+
+void tst_QEventLoopStatistics::queueDepth()
+{
+    QEventLoopStatistics::setEnabled(true);
+
+    Receiver receiver;
+    for (int i = 0; i < 5; ++i)
+        QCoreApplication::postEvent(&receiver, new QEvent(TestEventType));
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(receiver.received, 5);
+
+    const QEventLoopStatistics::Histogram depth = QEventLoopStatistics::forThread().queueDepth();
+    QVERIFY(depth.count() >= 1);
+    QVERIFY(depth.maximum() >= 5);
+}
+
+void tst_QEventLoopStatistics::iterationTime()
+{
+    if (!QAbstractEventDispatcher::instance()->inherits("QEventDispatcherUNIX"))
+        QSKIP("Only the Unix event dispatchers time the event loop iterations");
+
+    QEventLoopStatistics::setEnabled(true);
+    for (int i = 0; i < 3; ++i)
+        QCoreApplication::processEvents();
+
+    const QEventLoopStatistics::Histogram iterations = QEventLoopStatistics::forThread().iterationTime();
+    QCOMPARE(iterations.count(), quint64(3));
+}
+
+void tst_QEventLoopStatistics::otherThread()
+{
+    QEventLoopStatistics::setEnabled(true);
+
+    QThread thread;
+    Receiver receiver;
+    receiver.moveToThread(&thread);
+    thread.start();
+
+    for (int i = 0; i < 3; ++i)
+        QCoreApplication::postEvent(&receiver, new QEvent(TestEventType));
+    QTRY_COMPARE(QEventLoopStatistics::forThread(&thread).eventTime(TestEventType).count(),
+                 quint64(3));
+
+    // the events were not delivered in this thread
+    QCOMPARE(QEventLoopStatistics::forThread().eventTime(TestEventType).count(), quint64(0));
+
+    thread.quit();
+    QVERIFY(thread.wait());
+}
+
+void tst_QEventLoopStatistics::reset()
+{
+    QEventLoopStatistics::setEnabled(true);
+
+    Receiver receiver;
+    QEvent event(TestEventType);
+    QCoreApplication::sendEvent(&receiver, &event);
+    QCOMPARE(QEventLoopStatistics::forThread().eventTime(TestEventType).count(), quint64(1));
+
+    // a snapshot is not affected by reset()
+    const QEventLoopStatistics before = QEventLoopStatistics::forThread();
+    QEventLoopStatistics::reset();
+    QCOMPARE(before.eventTime(TestEventType).count(), quint64(1));
+    QCOMPARE(QEventLoopStatistics::forThread().eventTime(TestEventType).count(), quint64(0));
+}
+
+void tst_QEventLoopStatistics::sampling()
+{
+    QEventLoopStatistics::setSampleInterval(0);
+    QCOMPARE(QEventLoopStatistics::sampleInterval(), 1);
+    QEventLoopStatistics::setSampleInterval(4);
+    QCOMPARE(QEventLoopStatistics::sampleInterval(), 4);
+    QEventLoopStatistics::setEnabled(true);
+
+    // two event types that alternate must both be sampled
+    static const QEvent::Type OtherEventType = QEvent::Type(TestEventType + 1);
+    Receiver receiver;
+    QEvent event(TestEventType);
+    QEvent other(OtherEventType);
+    for (int i = 0; i < 4000; ++i)
+        QCoreApplication::sendEvent(&receiver, (i % 2) ? &other : &event);
+    QCOMPARE(receiver.received, 2000);
+
+    // the counts are scaled up to estimate the number of events
+    const QEventLoopStatistics statistics = QEventLoopStatistics::forThread();
+    const quint64 count = statistics.eventTime(TestEventType).count();
+    const quint64 otherCount = statistics.eventTime(OtherEventType).count();
+    QVERIFY2(count > 1600 && count < 2400, QByteArray::number(count));
+    QVERIFY2(otherCount > 1600 && otherCount < 2400, QByteArray::number(otherCount));
+    QVERIFY(count + otherCount <= 4000);
+    QVERIFY(count + otherCount > 4000 - 8);
+    QCOMPARE(statistics.receiverTime(&Receiver::staticMetaObject).count(), count + otherCount);
+}
+
+QTEST_MAIN(tst_QEventLoopStatistics)
+#include "tst_qeventloopstatistics.moc"
@@ -89,6 +89,8 @@ private slots:
     void recursiveSignalEmission();
     void signalBlocking();
     void blockingQueuedConnection();
+    void batchedConnection();
+    void batchedConnectionCustomType();
     void childEvents();
     void installEventFilter();
     void deleteSelfInSlot();
@@ -3036,6 +3038,139 @@ void tst_QObject::blockingQueuedConnection()
     }
 }
 
+// declared, but only registered by the connection
+struct BatchPayload
+{
+    int value;
+};
+Q_DECLARE_METATYPE(BatchPayload)
+
+class BatchSender : public QObject
+{
+    Q_OBJECT
+signals:
+    void text(const QString &);
+    void payload(const BatchPayload &);
+};
+
+class BatchReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    QStringList received;
+    int events = 0;
+
+    bool event(QEvent *e) override
+    {
+        if (e->type() == QEvent::MetaCall)
+            ++events;
+        return QObject::event(e);
+    }
+
+public slots:
+    void text(const QString &value)
+    {
+        received << value;
+        if (value == QLatin1String("delete"))
+            delete this;
+    }
+};
+
+void tst_QObject::batchedConnection()
+{
+    const Qt::ConnectionType type = Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection);
+
+    {
+        // pending emissions are delivered by a single event, in order
+        BatchSender sender;
+        BatchReceiver receiver;
+        QVERIFY(connect(&sender, SIGNAL(text(QString)), &receiver, SLOT(text(QString)), type));
+        QStringList expected;
+        for (int i = 0; i < 1000; ++i) {
+            expected << QString::number(i);
+            emit sender.text(expected.last());
+        }
+        QVERIFY(receiver.received.isEmpty());
+        QCoreApplication::processEvents();
+        QCOMPARE(receiver.received, expected);
+        QCOMPARE(receiver.events, 1);
+
+        // emissions after the delivery start a new batch
+        emit sender.text(QStringLiteral("again"));
+        QCoreApplication::processEvents();
+        QCOMPARE(receiver.received.last(), QStringLiteral("again"));
+        QCOMPARE(receiver.events, 2);
+    }
+
+    {
+        // functor connections, and disconnecting with emissions pending
+        BatchSender sender;
+        BatchReceiver receiver;
+        QStringList received;
+        QMetaObject::Connection connection =
+                connect(&sender, &BatchSender::text, &receiver,
+                        [&received](const QString &value) { received << value; }, type);
+        QVERIFY(connection);
+        emit sender.text(QStringLiteral("a"));
+        emit sender.text(QStringLiteral("b"));
+        QCoreApplication::processEvents();
+        QCOMPARE(received, QStringList() << "a" << "b");
+
+        emit sender.text(QStringLiteral("c"));
+        QVERIFY(QObject::disconnect(connection));
+        emit sender.text(QStringLiteral("d"));
+        QCoreApplication::processEvents();
+        QCOMPARE(received, QStringList() << "a" << "b" << "c");
+    }
+
+    {
+        // a slot that deletes the receiver discards the rest of the batch
+        BatchSender sender;
+        QPointer<BatchReceiver> receiver = new BatchReceiver;
+        connect(&sender, &BatchSender::text, receiver.data(), &BatchReceiver::text, type);
+        emit sender.text(QStringLiteral("delete"));
+        emit sender.text(QStringLiteral("dropped"));
+        QCoreApplication::processEvents();
+        QVERIFY(receiver.isNull());
+    }
+
+    {
+        // emissions from another thread
+        BatchReceiver receiver;
+        BatchSender sender;
+        connect(&sender, &BatchSender::text, &receiver, &BatchReceiver::text, type);
+        QStringList expected;
+        for (int i = 0; i < 10000; ++i)
+            expected << QString::number(i);
+        QScopedPointer<QThread> thread(QThread::create([&]() {
+            for (const QString &value : qAsConst(expected))
+                emit sender.text(value);
+        }));
+        thread->start();
+        QTRY_COMPARE(receiver.received.size(), expected.size());
+        QVERIFY(thread->wait());
+        QCOMPARE(receiver.received, expected);
+    }
+}
+
+void tst_QObject::batchedConnectionCustomType()
+{
+    QCOMPARE(QMetaType::type("BatchPayload"), int(QMetaType::UnknownType));
+
+    BatchSender sender;
+    BatchReceiver receiver;
+    QList<int> received;
+    QVERIFY(connect(&sender, &BatchSender::payload, &receiver,
+                    [&received](const BatchPayload &payload) { received << payload.value; },
+                    Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection)));
+    QVERIFY(QMetaType::type("BatchPayload") != QMetaType::UnknownType);
+
+    emit sender.payload(BatchPayload{1});
+    emit sender.payload(BatchPayload{2});
+    QCoreApplication::processEvents();
+    QCOMPARE(received, QList<int>() << 1 << 2);
+}
+
 class EventSpy : public QObject
 {
     Q_OBJECT
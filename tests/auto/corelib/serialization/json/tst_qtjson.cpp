@@ -97,6 +97,9 @@ private Q_SLOTS:
     void toJsonLargeNumericValues();
     void fromJson();
     void fromJsonErrors();
+    void fromJsonLazily_data();
+    void fromJsonLazily();
+    void fromJsonLazilyInvalid();
     void fromBinary();
     void toAndFromBinary_data();
     void toAndFromBinary();
@@ -104,6 +107,8 @@ private Q_SLOTS:
     void parseNumbers();
     void parseStrings();
     void parseDuplicateKeys();
+    void parseLongInput_data();
+    void parseLongInput();
     void testParser();
 
     void compactArray();
@@ -1863,6 +1868,144 @@ void tst_QtJson::fromJsonErrors()
     }
 }
 
+void tst_QtJson::fromJsonLazily_data()
+{
+    QTest::addColumn<QString>("fileName");
+
+    QTest::newRow("array") << QStringLiteral("test.json");
+    QTest::newRow("object") << QStringLiteral("test3.json");
+    QTest::newRow("bom") << QStringLiteral("bom.json");
+}
+
+void tst_QtJson::fromJsonLazily()
+{
+    QFETCH(QString, fileName);
+
+    QFile file(testDataDir + QLatin1Char('/') + fileName);
+    QVERIFY(file.open(QFile::ReadOnly));
+    const QByteArray json = file.readAll();
+
+    const QJsonDocument expected = QJsonDocument::fromJson(json);
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJsonLazily(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QVERIFY(!doc.isNull());
+    QCOMPARE(doc.isObject(), expected.isObject());
+    QCOMPARE(doc.isArray(), expected.isArray());
+
+    // the values are parsed one at a time, until something needs all of them
+    const QJsonObject object = expected.object();
+    for (auto it = object.begin(); it != object.end(); ++it) {
+        QCOMPARE(doc[it.key()], it.value());
+        QCOMPARE(doc[QLatin1String(it.key().toLatin1())], it.value());
+    }
+    QCOMPARE(doc[QLatin1String("missing")], QJsonValue(QJsonValue::Undefined));
+    const QJsonArray array = expected.array();
+    for (int i = 0; i < array.size(); ++i)
+        QCOMPARE(doc[i], array.at(i));
+    QCOMPARE(doc[-1], QJsonValue(QJsonValue::Undefined));
+    QCOMPARE(doc[array.size()], QJsonValue(QJsonValue::Undefined));
+
+    QCOMPARE(doc, expected);
+    QCOMPARE(doc.toJson(), expected.toJson());
+    for (auto it = object.begin(); it != object.end(); ++it)
+        QCOMPARE(doc[it.key()], it.value());
+}
+
+void tst_QtJson::fromJsonLazilyInvalid()
+{
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJsonLazily("  42", &error);
+    QVERIFY(doc.isNull());
+    QCOMPARE(error.error, QJsonParseError::IllegalValue);
+    QCOMPARE(error.offset, 3);
+
+    doc = QJsonDocument::fromJsonLazily(" \n", &error);
+    QVERIFY(doc.isNull());
+    QCOMPARE(error.error, QJsonParseError::IllegalValue);
+
+    // the structure is checked up front
+    const struct {
+        const char *json;
+        QJsonParseError::ParseError error;
+    } structureErrors[] = {
+        { "{ \"a\": 1 ", QJsonParseError::UnterminatedObject },
+        { "[1, [2, 3]", QJsonParseError::UnterminatedArray },
+        { "[\"abc]", QJsonParseError::UnterminatedString },
+        { "[1, 2] x", QJsonParseError::GarbageAtEnd },
+        { "{\"a\" 1}", QJsonParseError::MissingNameSeparator },
+        { "{\"a\": 1,}", QJsonParseError::MissingObject },
+        { "[1,,2]", QJsonParseError::IllegalValue },
+        { "[1 2]", QJsonParseError::UnterminatedArray },
+        { "{\"a\": x}", QJsonParseError::IllegalValue },
+        { "{\"\\uzzzz\": 1}", QJsonParseError::IllegalEscapeSequence },
+    };
+    for (const auto &e : structureErrors) {
+        doc = QJsonDocument::fromJsonLazily(e.json, &error);
+        QVERIFY2(doc.isNull(), e.json);
+        QCOMPARE(error.error, e.error);
+    }
+
+    // keys that need decoding, and duplicate keys of which the last wins
+    doc = QJsonDocument::fromJsonLazily("{ \"a\\u00e9\": \"\\u00e9\", \"b\": 1, \"b\": 2 }");
+    QCOMPARE(doc[QString::fromUtf8("a\xc3\xa9")], QJsonValue(QString::fromUtf8("\xc3\xa9")));
+    QCOMPARE(doc[QLatin1String("b")], QJsonValue(2));
+
+    // scalars are parsed like the parser does, and kept
+    doc = QJsonDocument::fromJsonLazily("[ -1.5e2 , true,false,null, 0, \"\\u00e9\\n\", {\"x\": []} ]");
+    QVERIFY(!doc.isNull());
+    for (int pass = 0; pass < 2; ++pass) {
+        QCOMPARE(doc[0], QJsonValue(-150));
+        QCOMPARE(doc[1], QJsonValue(true));
+        QCOMPARE(doc[2], QJsonValue(false));
+        QCOMPARE(doc[3], QJsonValue(QJsonValue::Null));
+        QCOMPARE(doc[4], QJsonValue(0));
+        QCOMPARE(doc[5], QJsonValue(QString::fromUtf8("\xc3\xa9\n")));
+        QCOMPARE(doc[6], QJsonValue(QJsonObject{{QLatin1String("x"), QJsonArray()}}));
+    }
+    QVERIFY(!doc.isNull());
+
+    // numbers, literals and strings are checked up front too, at any depth
+    const struct {
+        const char *json;
+        QJsonParseError::ParseError error;
+        int offset;
+    } valueErrors[] = {
+        { "{ \"a\": [1, 2], \"b\": tru, \"c\": \"x\" }", QJsonParseError::IllegalValue, 20 },
+        { "{ \"d\": 01 }", QJsonParseError::IllegalNumber, 7 },
+        { "[1, [2, tru]]", QJsonParseError::IllegalValue, 8 },
+        { "[1, [2, 1e999]]", QJsonParseError::IllegalNumber, 8 },
+        { "[1, 2 , -]", QJsonParseError::IllegalNumber, 8 },
+        { "[{\"a\": \"\\u12g4\"}]", QJsonParseError::IllegalEscapeSequence, 7 },
+        { "[[\"\xff\"]]", QJsonParseError::IllegalUTF8String, 2 },
+    };
+    for (const auto &e : valueErrors) {
+        doc = QJsonDocument::fromJsonLazily(e.json, &error);
+        QVERIFY2(doc.isNull(), e.json);
+        QCOMPARE(error.error, e.error);
+        QCOMPARE(error.offset, e.offset);
+        QVERIFY(QJsonDocument::fromJson(e.json).isNull());
+    }
+
+    // a valid document stays valid whatever is looked up
+    doc = QJsonDocument::fromJsonLazily("{ \"a\": [1, 2], \"b\": true, \"c\": \"\\u00e9\" }");
+    QVERIFY(!doc.isNull());
+    QCOMPARE(doc[QLatin1String("b")], QJsonValue(true));
+    QCOMPARE(doc[QLatin1String("x")], QJsonValue(QJsonValue::Undefined));
+    QVERIFY(!doc.isNull());
+    QCOMPARE(doc.object().size(), 3);
+    QVERIFY(!doc.isNull());
+
+    // modifying the document replaces the text
+    doc = QJsonDocument::fromJsonLazily("{ \"a\": 1 }");
+    QJsonObject object = doc.object();
+    object.insert(QLatin1String("a"), 2);
+    QCOMPARE(doc[QLatin1String("a")], QJsonValue(1));
+    doc.setObject(object);
+    QCOMPARE(doc[QLatin1String("a")], QJsonValue(2));
+    QCOMPARE(doc.toJson(QJsonDocument::Compact), QByteArray("{\"a\":2}"));
+}
+
 void tst_QtJson::fromBinary()
 {
     QFile file(testDataDir + "/test.json");
@@ -2087,6 +2230,40 @@ void tst_QtJson::parseDuplicateKeys()
     QCOMPARE(it.value(), QJsonValue(false));
 }
 
+void tst_QtJson::parseLongInput_data()
+{
+    QTest::addColumn<int>("length");
+    QTest::addColumn<QString>("filler");
+
+    // the parser starts indexing the input after the first long string,
+    // and then indexes it 16 KiB at a time, so some of these strings and
+    // runs of whitespace cross from one part to the next
+    for (int length : { 63, 64, 65, 16 * 1024 - 9, 16 * 1024, 40000 }) {
+        QTest::addRow("ascii-%d", length) << length << QStringLiteral("x");
+        QTest::addRow("escaped-%d", length) << length << QStringLiteral("\"\\");
+        QTest::addRow("non-ascii-%d", length) << length << QString(QChar(0xe9));
+    }
+}
+
+void tst_QtJson::parseLongInput()
+{
+    QFETCH(int, length);
+    QFETCH(QString, filler);
+
+    QJsonArray array{ QStringLiteral("short"), QStringLiteral("strings") };
+    for (int i = 0; i < 3; ++i)
+        array.append(filler.repeated(length / filler.size()) + QString::number(i));
+    array.append(length);
+
+    QByteArray json = QJsonDocument(array).toJson(QJsonDocument::Compact);
+    json.replace(",", ",\n" + QByteArray(length, ' '));
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QCOMPARE(doc.array(), array);
+}
+
 void tst_QtJson::testParser()
 {
     QFile file(testDataDir + "/test.json");
@@ -3016,6 +3193,7 @@ void tst_QtJson::parseErrorOffset_data()
     QTest::newRow("Stray ,") << QByteArray("  ,  ") << 3;
     QTest::newRow("Stray [") << QByteArray("  [  ") << 5;
     QTest::newRow("Stray }") << QByteArray("  }  ") << 3;
+    QTest::newRow("Stray \" in array") << QByteArray("[ 1 \"  , 2 ]") << 7;
 }
 
 void tst_QtJson::parseErrorOffset()
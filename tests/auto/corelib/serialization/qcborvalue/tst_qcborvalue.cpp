@@ -99,6 +99,9 @@ private slots:
     void fromCborStreamReaderByteArray();
     void fromCborStreamReaderIODevice_data() { fromCbor_data(); }
     void fromCborStreamReaderIODevice();
+    void fromCborArena_data() { fromCbor_data(); }
+    void fromCborArena();
+    void arenaDetach();
     void validation_data();
     void validation();
     void toDiagnosticNotation_data();
@@ -1609,6 +1612,56 @@ void tst_QCborValue::fromCborStreamReaderIODevice()
     fromCbor_common(doCheck);
 }
 
+void tst_QCborValue::fromCborArena()
+{
+    auto doCheck = [](const QCborValue &v, const QByteArray &result) {
+        QCborParserError error;
+        QCborValue decoded = QCborValue::fromCbor(result, &error, QCborValue::UseArena);
+        QVERIFY2(error.error == QCborError(), qPrintable(error.errorString()));
+        QCOMPARE(error.offset, result.size());
+        QVERIFY(decoded == v);
+        QVERIFY(v == decoded);
+        QCOMPARE(decoded.toCbor(), QCborValue(v).toCbor());
+    };
+
+    fromCbor_common(doCheck);
+}
+
+void tst_QCborValue::arenaDetach()
+{
+    QCborMap original{{"name", "arena"},
+                      {"list", QCborArray{1, "two", QByteArray("three")}},
+                      {"nested", QCborMap{{1, QCborArray{2.5, true}}, {2, QCborMap{}}}}};
+    const QByteArray encoded = QCborValue(original).toCbor();
+
+    QCborValue decoded = QCborValue::fromCbor(encoded, nullptr, QCborValue::UseArena);
+    QCOMPARE(decoded, QCborValue(original));
+
+    // modifying a container stored in the arena copies it out
+    QCborMap map = decoded.toMap();
+    QCborArray list = map.value("list").toArray();
+    QCborMap nested = map.value("nested").toMap();
+    list.append(4);
+    list[1] = "deux";
+    map.insert(QLatin1String("extra"), QCborArray{list});
+    QCOMPARE(decoded, QCborValue(original));
+    QCOMPARE(list, QCborArray({1, "deux", QByteArray("three"), 4}));
+    QCOMPARE(map.value("extra").toArray().at(0).toArray(), list);
+
+    // the copies must outlive the decoded document
+    QCborValue copy = decoded;
+    QCborValue name = decoded.toMap().value("name");
+    decoded = QCborValue();
+    copy = QCborValue();
+    QCOMPARE(name.toString(), QString("arena"));
+    QCOMPARE(nested.value(1).toArray(), QCborArray({2.5, true}));
+    QVERIFY(nested.value(2).toMap().isEmpty());
+    map.remove(QLatin1String("name"));
+    QCOMPARE(map.value("nested").toMap(), nested);
+    QCOMPARE(map.take(QLatin1String("list")).toArray(), QCborArray({1, "two", QByteArray("three")}));
+    QCOMPARE(map.value("extra").toArray().at(0).toArray(), list);
+}
+
 void tst_QCborValue::validation_data()
 {
     addValidationColumns();
@@ -1634,6 +1687,8 @@ void tst_QCborValue::validation()
     QCborParserError error;
     QCborValue decoded = QCborValue::fromCbor(data, &error);
     QVERIFY(error.error != QCborError{});
+    decoded = QCborValue::fromCbor(data, &error, QCborValue::UseArena);
+    QVERIFY(error.error != QCborError{});
 
     if (data.startsWith('\x81')) {
         // decode without the array prefix
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qgadgetserializer
+QT = core testlib
+SOURCES = tst_qgadgetserializer.cpp
@@ -0,0 +1,448 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtCore/qgadgetserializer.h>
+#include <QtCore/qcborarray.h>
+#include <QtCore/qcborstream.h>
+#include <QtCore/qcborvalue.h>
+#include <QtCore/qcbormap.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qjsonstream.h>
+#include <QtTest>
+
+struct Inner
+{
+    Q_GADGET
+    Q_PROPERTY(double weight MEMBER weight)
+    Q_PROPERTY(QStringList tags MEMBER tags)
+public:
+    double weight = 0;
+    QStringList tags;
+
+    bool operator==(const Inner &other) const
+    { return weight == other.weight && tags == other.tags; }
+    bool operator!=(const Inner &other) const
+    { return !(*this == other); }
+};
+Q_DECLARE_METATYPE(Inner)
+
+struct Record
+{
+    Q_GADGET
+    Q_PROPERTY(bool enabled MEMBER enabled)
+    Q_PROPERTY(qint8 small MEMBER small)
+    Q_PROPERTY(int id MEMBER id)
+    Q_PROPERTY(quint64 big MEMBER big)
+    Q_PROPERTY(float ratio MEMBER ratio)
+    Q_PROPERTY(QString name READ name WRITE setName)
+    Q_PROPERTY(QByteArray payload MEMBER payload)
+    Q_PROPERTY(Level level MEMBER level)
+    Q_PROPERTY(Inner inner MEMBER inner)
+    Q_PROPERTY(QDate date MEMBER date)
+    Q_PROPERTY(int length READ length)
+public:
+    enum Level : quint8 { Low = 1, High = 200 };
+    Q_ENUM(Level)
+
+    QString name() const { return m_name; }
+    void setName(const QString &name) { m_name = name; }
+    int length() const { return m_name.size(); }
+
+    bool enabled = false;
+    qint8 small = 0;
+    int id = 0;
+    quint64 big = 0;
+    float ratio = 0;
+    QString m_name;
+    QByteArray payload;
+    Level level = Low;
+    Inner inner;
+    QDate date;
+
+    bool operator==(const Record &other) const
+    {
+        return enabled == other.enabled && small == other.small && id == other.id
+                && big == other.big && ratio == other.ratio && m_name == other.m_name
+                && payload == other.payload && level == other.level
+                && inner == other.inner && date == other.date;
+    }
+};
+
+// a gadget that derives from another one, and adds a property
+struct Labeled : Inner
+{
+    Q_GADGET
+    Q_PROPERTY(QString label MEMBER label)
+public:
+    QString label;
+};
+
+// enumerations whose signedness cannot be told from their enumerators
+struct Bits
+{
+    Q_GADGET
+    Q_PROPERTY(Mask mask MEMBER mask)
+    Q_PROPERTY(Offset offset MEMBER offset)
+public:
+    enum Mask : quint32 { NoBits = 0, AllBits = 0xffffffff };
+    Q_ENUM(Mask)
+    enum Offset : qint16 { Origin = 0, Limit = 1000 };
+    Q_ENUM(Offset)
+
+    Mask mask = NoBits;
+    Offset offset = Origin;
+};
+
+// an enumeration wider than int that is never registered with QMetaType,
+// between two members that must not be touched when it is accessed
+struct Wide
+{
+    Q_GADGET
+    Q_PROPERTY(Extent extent MEMBER extent)
+public:
+    enum Extent : qint64 { Empty = 0, Full = 0x7fffffff };
+    Q_ENUM(Extent)
+
+    qint64 before = -1;
+    Extent extent = Empty;
+    qint64 after = -1;
+};
+
+class tst_QGadgetSerializer : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void toJson();
+    void fromJson();
+    void fromJsonMismatches();
+    void toCbor();
+    void fromCbor();
+    void fromCborErrors();
+    void inheritance();
+    void enumSignedness();
+    void unregisteredWideEnum();
+    void largeUnsignedFromJson();
+    void matchesVariantPath();
+};
+
+static Record sampleRecord()
+{
+    Record r;
+    r.enabled = true;
+    r.small = -5;
+    r.id = 42;
+    r.big = Q_UINT64_C(18446744073709551615);
+    r.ratio = 0.5f;
+    r.setName(QStringLiteral("récord"));
+    r.payload = QByteArray("\x00\xff\x10", 3);
+    r.level = Record::High;
+    r.inner.weight = 2.25;
+    r.inner.tags = QStringList{QStringLiteral("a"), QStringLiteral("b")};
+    r.date = QDate(2020, 2, 29);
+    return r;
+}
+
+void tst_QGadgetSerializer::initTestCase()
+{
+    qRegisterMetaType<Inner>();
+    qRegisterMetaType<Bits::Mask>();
+    qRegisterMetaType<Bits::Offset>();
+}
+
+void tst_QGadgetSerializer::toJson()
+{
+    QByteArray json;
+    {
+        QJsonStreamWriter writer(&json);
+        QGadgetSerializer::toJson(writer, sampleRecord());
+    }
+
+    QJsonParseError error;
+    const QJsonObject object = QJsonDocument::fromJson(json, &error).object();
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QCOMPARE(object.keys().size(), 11);
+    QCOMPARE(object.value("enabled"), QJsonValue(true));
+    QCOMPARE(object.value("small"), QJsonValue(-5));
+    QCOMPARE(object.value("id"), QJsonValue(42));
+    QVERIFY(json.contains("\"big\":18446744073709551615"));
+    QCOMPARE(object.value("ratio"), QJsonValue(0.5));
+    QCOMPARE(object.value("name"), QJsonValue(QStringLiteral("récord")));
+    QCOMPARE(object.value("payload"), QJsonValue("AP8Q"));
+    QCOMPARE(object.value("level"), QJsonValue(200));
+    QCOMPARE(object.value("date"), QJsonValue("2020-02-29"));
+    QCOMPARE(object.value("length"), QJsonValue(6));
+
+    const QJsonObject inner = object.value("inner").toObject();
+    QCOMPARE(inner.value("weight"), QJsonValue(2.25));
+    QCOMPARE(inner.value("tags").toArray(), QJsonArray({"a", "b"}));
+}
+
+void tst_QGadgetSerializer::fromJson()
+{
+    const Record expected = sampleRecord();
+    QByteArray json;
+    {
+        QJsonStreamWriter writer(&json);
+        QGadgetSerializer::toJson(writer, expected);
+    }
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    Record r;
+    QVERIFY(QGadgetSerializer::fromJson(reader, r));
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.depth(), 0);
+    QVERIFY(r == expected);
+}
+
+void tst_QGadgetSerializer::fromJsonMismatches()
+{
+    Record r = sampleRecord();
+    QJsonStreamReader reader(QByteArray(
+            "{\"unknown\":[1,{\"id\":7}],\"id\":\"text\",\"length\":3,\"small\":12,"
+            "\"inner\":{\"weight\":1.5},\"name\":null,\"level\":1}\n"));
+    reader.readNext();
+    QVERIFY(QGadgetSerializer::fromJson(reader, r));
+
+    Record expected = sampleRecord();
+    expected.small = 12;
+    expected.inner.weight = 1.5;
+    expected.level = Record::Low;
+    QVERIFY(r == expected);
+
+    // errors
+    QJsonStreamReader truncated(QByteArray("{\"id\":1,\"inner\":{\"weight\":"));
+    truncated.readNext();
+    QVERIFY(!QGadgetSerializer::fromJson(truncated, r));
+
+    QJsonStreamReader array(QByteArray("[1]"));
+    array.readNext();
+    QVERIFY(!QGadgetSerializer::fromJson(array, r));
+}
+
+void tst_QGadgetSerializer::toCbor()
+{
+    QByteArray cbor;
+    QCborStreamWriter writer(&cbor);
+    QGadgetSerializer::toCbor(writer, sampleRecord());
+
+    QCborParserError error;
+    const QCborMap map = QCborValue::fromCbor(cbor, &error).toMap();
+    QCOMPARE(error.error, QCborError::NoError);
+    QCOMPARE(map.size(), 11);
+    QCOMPARE(map.value("enabled"), QCborValue(true));
+    QCOMPARE(map.value("small"), QCborValue(-5));
+    QCOMPARE(map.value("id"), QCborValue(42));
+    QCOMPARE(map.value("ratio"), QCborValue(0.5));
+    QCOMPARE(map.value("name"), QCborValue(QStringLiteral("récord")));
+    QCOMPARE(map.value("payload"), QCborValue(QByteArray("\x00\xff\x10", 3)));
+    QCOMPARE(map.value("level"), QCborValue(200));
+    QCOMPARE(map.value("date"), QCborValue("2020-02-29"));
+    QCOMPARE(map.value("length"), QCborValue(6));
+    QCOMPARE(map.value("inner").toMap().value("tags").toArray(),
+             QCborArray({QStringLiteral("a"), QStringLiteral("b")}));
+}
+
+void tst_QGadgetSerializer::fromCbor()
+{
+    const Record expected = sampleRecord();
+    QByteArray cbor;
+    QCborStreamWriter writer(&cbor);
+    QGadgetSerializer::toCbor(writer, expected);
+    writer.append(1);
+
+    QCborStreamReader reader(cbor);
+    Record r;
+    QVERIFY(QGadgetSerializer::fromCbor(reader, r));
+    QVERIFY(r == expected);
+
+    // the reader is positioned after the map, and did not consume the
+    // item that follows it
+    QCOMPARE(reader.currentOffset(), qint64(cbor.size() - 1));
+}
+
+void tst_QGadgetSerializer::fromCborErrors()
+{
+    Record r;
+    const QByteArray valid = QCborValue(QCborMap{{"id", 3}, {1, 2}, {"name", 4}}).toCbor();
+    QCborStreamReader reader(valid);
+    QVERIFY(QGadgetSerializer::fromCbor(reader, r));
+    QCOMPARE(r.id, 3);
+    QVERIFY(r.name().isEmpty());
+
+    QCborStreamReader truncated(valid.left(valid.size() - 1));
+    QVERIFY(!QGadgetSerializer::fromCbor(truncated, r));
+
+    QCborStreamReader notAMap(QCborValue(QCborArray{1}).toCbor());
+    QVERIFY(!QGadgetSerializer::fromCbor(notAMap, r));
+}
+
+void tst_QGadgetSerializer::inheritance()
+{
+    Labeled labeled;
+    labeled.weight = 3;
+    labeled.label = QStringLiteral("heavy");
+
+    QByteArray json;
+    {
+        QJsonStreamWriter writer(&json);
+        QGadgetSerializer::toJson(writer, labeled);
+    }
+    QCOMPARE(json, QByteArray("{\"weight\":3,\"tags\":[],\"label\":\"heavy\"}\n"));
+
+    QJsonStreamReader reader(json);
+    reader.readNext();
+    Labeled copy;
+    QVERIFY(QGadgetSerializer::fromJson(reader, copy));
+    QCOMPARE(copy.weight, 3.);
+    QCOMPARE(copy.label, labeled.label);
+}
+
+void tst_QGadgetSerializer::enumSignedness()
+{
+    Bits bits;
+    bits.mask = Bits::AllBits;
+    bits.offset = Bits::Offset(-3);
+
+    QByteArray json;
+    {
+        QJsonStreamWriter writer(&json);
+        QGadgetSerializer::toJson(writer, bits);
+    }
+    QVERIFY2(json.contains("\"mask\":4294967295"), json.constData());
+    QVERIFY2(json.contains("\"offset\":-3"), json.constData());
+
+    QByteArray cbor;
+    QCborStreamWriter writer(&cbor);
+    QGadgetSerializer::toCbor(writer, bits);
+    const QCborMap map = QCborValue::fromCbor(cbor).toMap();
+    QCOMPARE(map.value("mask"), QCborValue(Q_INT64_C(4294967295)));
+    QCOMPARE(map.value("offset"), QCborValue(-3));
+
+    QCborStreamReader reader(cbor);
+    Bits r;
+    QVERIFY(QGadgetSerializer::fromCbor(reader, r));
+    QCOMPARE(r.mask, Bits::AllBits);
+    QCOMPARE(r.offset, Bits::Offset(-3));
+
+    QJsonStreamReader jsonReader(json);
+    jsonReader.readNext();
+    r = Bits();
+    QVERIFY(QGadgetSerializer::fromJson(jsonReader, r));
+    QCOMPARE(r.mask, Bits::AllBits);
+    QCOMPARE(r.offset, Bits::Offset(-3));
+}
+
+void tst_QGadgetSerializer::unregisteredWideEnum()
+{
+    QCOMPARE(QMetaType::type("Wide::Extent"), int(QMetaType::UnknownType));
+
+    Wide wide;
+    wide.extent = Wide::Full;
+
+    QByteArray json;
+    {
+        QJsonStreamWriter writer(&json);
+        QGadgetSerializer::toJson(writer, wide);
+    }
+    QCOMPARE(json, QByteArray("{\"extent\":2147483647}\n"));
+
+    QJsonStreamReader jsonReader(json);
+    jsonReader.readNext();
+    Wide r;
+    QVERIFY(QGadgetSerializer::fromJson(jsonReader, r));
+    QCOMPARE(r.extent, Wide::Full);
+    QCOMPARE(r.before, Q_INT64_C(-1));
+    QCOMPARE(r.after, Q_INT64_C(-1));
+
+    QByteArray cbor;
+    QCborStreamWriter writer(&cbor);
+    QGadgetSerializer::toCbor(writer, wide);
+    QCOMPARE(QCborValue::fromCbor(cbor).toMap().value("extent"), QCborValue(0x7fffffff));
+
+    QCborStreamReader reader(cbor);
+    r = Wide();
+    QVERIFY(QGadgetSerializer::fromCbor(reader, r));
+    QCOMPARE(r.extent, Wide::Full);
+    QCOMPARE(r.before, Q_INT64_C(-1));
+    QCOMPARE(r.after, Q_INT64_C(-1));
+}
+
+// unsigned numbers above 2^63 keep all their digits
+void tst_QGadgetSerializer::largeUnsignedFromJson()
+{
+    Record r;
+    QJsonStreamReader reader(QByteArray("{\"big\":9223372036854775809}\n"));
+    reader.readNext();
+    QVERIFY(QGadgetSerializer::fromJson(reader, r));
+    QCOMPARE(r.big, Q_UINT64_C(9223372036854775809));
+
+    r.big = Q_UINT64_C(18446744073709551614);
+    QByteArray json;
+    {
+        QJsonStreamWriter writer(&json);
+        QGadgetSerializer::toJson(writer, r);
+    }
+    QJsonStreamReader roundTrip(json);
+    roundTrip.readNext();
+    Record copy;
+    QVERIFY(QGadgetSerializer::fromJson(roundTrip, copy));
+    QCOMPARE(copy.big, r.big);
+}
+
+// the result is the same as building a QJsonObject from QMetaProperty::readOnGadget()
+void tst_QGadgetSerializer::matchesVariantPath()
+{
+    Inner inner;
+    inner.weight = -0.125;
+    inner.tags = QStringList{QStringLiteral("x")};
+
+    QJsonObject object;
+    const QMetaObject &mo = Inner::staticMetaObject;
+    for (int i = 0; i < mo.propertyCount(); ++i) {
+        const QMetaProperty property = mo.property(i);
+        object.insert(QLatin1String(property.name()),
+                      QJsonValue::fromVariant(property.readOnGadget(&inner)));
+    }
+
+    QByteArray json;
+    {
+        QJsonStreamWriter writer(&json);
+        QGadgetSerializer::toJson(writer, inner);
+    }
+    QCOMPARE(QJsonDocument::fromJson(json).object(), object);
+}
+
+QTEST_MAIN(tst_QGadgetSerializer)
+#include "tst_qgadgetserializer.moc"
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qjsonstreamreader
+QT = core testlib
+SOURCES = tst_qjsonstreamreader.cpp
@@ -0,0 +1,572 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/qjsonstream.h>
+#include <QtCore/qbuffer.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtTest>
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void tokens_data();
+    void tokens();
+    void incremental_data() { tokens_data(); }
+    void incremental();
+    void device_data() { tokens_data(); }
+    void device();
+    void errors_data();
+    void errors();
+    void errorOffset();
+    void integers_data();
+    void integers();
+    void unsignedIntegers_data();
+    void unsignedIntegers();
+    void compareWithDocument_data();
+    void compareWithDocument();
+    void jsonLines();
+    void finishData();
+    void stringInChunks_data();
+    void stringInChunks();
+    void skipCurrentValue();
+    void deepNesting();
+    void customError();
+    void sequentialDevice();
+};
+
+// Describes the token the reader is at, for comparing token sequences.
+static QString describe(const QJsonStreamReader &reader)
+{
+    QString result;
+    if (!reader.name().isEmpty())
+        result = reader.name().toString() + QLatin1Char('=');
+    switch (reader.tokenType()) {
+    case QJsonStreamReader::StartArray:
+        return result + QLatin1Char('[');
+    case QJsonStreamReader::EndArray:
+        return result + QLatin1Char(']');
+    case QJsonStreamReader::StartObject:
+        return result + QLatin1Char('{');
+    case QJsonStreamReader::EndObject:
+        return result + QLatin1Char('}');
+    case QJsonStreamReader::String:
+        return result + QLatin1Char('"') + reader.text().toString() + QLatin1Char('"');
+    case QJsonStreamReader::Number:
+        return result + QString::number(reader.toDouble(), 'g', QLocale::FloatingPointShortest);
+    case QJsonStreamReader::Bool:
+        return result + QLatin1String(reader.toBool() ? "true" : "false");
+    case QJsonStreamReader::Null:
+        return result + QLatin1String("null");
+    default:
+        return result + reader.tokenString();
+    }
+}
+
+// Reads all tokens, and describes them separated by spaces.
+static QString readAll(QJsonStreamReader &reader)
+{
+    QStringList tokens;
+    while (reader.readNext() != QJsonStreamReader::EndDocument) {
+        if (reader.tokenType() == QJsonStreamReader::Invalid) {
+            tokens << reader.tokenString();
+            break;
+        }
+        tokens << describe(reader);
+    }
+    return tokens.join(QLatin1Char(' '));
+}
+
+void tst_QJsonStreamReader::tokens_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("empty") << QByteArray() << QString();
+    QTest::newRow("whitespace") << QByteArray(" \t\r\n") << QString();
+    QTest::newRow("emptyArray") << QByteArray("[]") << "[ ]";
+    QTest::newRow("emptyObject") << QByteArray(" { } ") << "{ }";
+    QTest::newRow("literals") << QByteArray("[true, false, null]") << "[ true false null ]";
+    QTest::newRow("numbers") << QByteArray("[0, -1, 2.5, 1e3, -1.5E-2, 0.1]")
+                             << "[ 0 -1 2.5 1000 -0.015 0.1 ]";
+    QTest::newRow("string") << QByteArray("[\"Hello\"]") << "[ \"Hello\" ]";
+    QTest::newRow("escapes") << QByteArray("[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\\u0041\"]")
+                             << "[ \"\"\\/\b\f\n\r\tA\" ]";
+    QTest::newRow("utf8") << QByteArray("[\"\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\"]")
+                          << QString::fromUtf8("[ \"\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\" ]");
+    QTest::newRow("surrogates") << QByteArray("[\"\\ud83d\\ude00\"]")
+                                << QString::fromUtf8("[ \"\xf0\x9f\x98\x80\" ]");
+    QTest::newRow("object") << QByteArray("{\"a\": 1, \"b\" : [2, {\"c\": null}], \"d\": {}}")
+                            << "{ a=1 b=[ 2 { c=null } ] d={ } }";
+    QTest::newRow("bom") << QByteArray("\xef\xbb\xbf[1]") << "[ 1 ]";
+    QTest::newRow("topLevelScalars") << QByteArray("\"x\" true 1\n") << "\"x\" true 1";
+    QTest::newRow("twoDocuments") << QByteArray("{}[]") << "{ } [ ]";
+}
+
+void tst_QJsonStreamReader::tokens()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QCOMPARE(readAll(reader), expected);
+    QVERIFY(reader.atEnd());
+    QVERIFY(!reader.hasError());
+    QCOMPARE(reader.depth(), 0);
+    QCOMPARE(reader.characterOffset(), qint64(json.size()));
+}
+
+void tst_QJsonStreamReader::incremental()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    // feed one byte at a time, and continue after each premature end
+    QJsonStreamReader reader;
+    QStringList tokens;
+    int fed = 0;
+    for (;;) {
+        const QJsonStreamReader::TokenType type = reader.readNext();
+        if (type == QJsonStreamReader::EndDocument
+                || reader.error() == QJsonStreamReader::PrematureEndOfDocumentError) {
+            QVERIFY(reader.atEnd());
+            if (fed == json.size())
+                break;
+            reader.addData(json.constData() + fed++, 1);
+            continue;
+        }
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+        tokens << describe(reader);
+    }
+    QCOMPARE(tokens.join(QLatin1Char(' ')), expected);
+}
+
+void tst_QJsonStreamReader::device()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    QCOMPARE(reader.device(), &buffer);
+    QCOMPARE(readAll(reader), expected);
+    QVERIFY(!reader.hasError());
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QString>("expected");
+    QTest::addColumn<QJsonStreamReader::Error>("error");
+
+    const auto notWellFormed = QJsonStreamReader::NotWellFormedError;
+    const auto premature = QJsonStreamReader::PrematureEndOfDocumentError;
+    QTest::newRow("unterminatedArray") << QByteArray("[1 ") << "[ 1 Invalid" << premature;
+    QTest::newRow("unterminatedString") << QByteArray("[\"abc") << "[ Invalid" << premature;
+    QTest::newRow("incompleteLiteral") << QByteArray("[nul") << "[ Invalid" << premature;
+    QTest::newRow("incompleteNumber") << QByteArray("[12") << "[ Invalid" << premature;
+    QTest::newRow("incompleteMember") << QByteArray("{\"a\":") << "{ Invalid" << premature;
+    QTest::newRow("missingComma") << QByteArray("[1 2]") << "[ 1 Invalid" << notWellFormed;
+    QTest::newRow("trailingComma") << QByteArray("[1,]") << "[ 1 Invalid" << notWellFormed;
+    QTest::newRow("trailingCommaObject") << QByteArray("{\"a\":1,}") << "{ a=1 Invalid"
+                                         << notWellFormed;
+    QTest::newRow("missingColon") << QByteArray("{\"a\" 1}") << "{ Invalid" << notWellFormed;
+    QTest::newRow("nonStringKey") << QByteArray("{1: 2}") << "{ Invalid" << notWellFormed;
+    QTest::newRow("badLiteral") << QByteArray("[tru]") << "[ Invalid" << notWellFormed;
+    QTest::newRow("badNumber") << QByteArray("[-]") << "[ Invalid" << notWellFormed;
+    QTest::newRow("badEscape") << QByteArray("[\"\\u12x4\"]") << "[ Invalid" << notWellFormed;
+    QTest::newRow("badUtf8") << QByteArray("[\"\xff\"]") << "[ Invalid" << notWellFormed;
+    QTest::newRow("mismatchedEnd") << QByteArray("[}") << "[ Invalid" << notWellFormed;
+    QTest::newRow("unexpectedEnd") << QByteArray("]") << "Invalid" << notWellFormed;
+    QTest::newRow("numberThenLiteral") << QByteArray("1true") << "1 Invalid" << notWellFormed;
+    QTest::newRow("leadingZero") << QByteArray("01") << "0 Invalid" << notWellFormed;
+    QTest::newRow("adjacentStrings") << QByteArray("\"a\"\"b\"") << "\"a\" Invalid"
+                                     << notWellFormed;
+    QTest::newRow("scalarThenArray") << QByteArray("null[]") << "null Invalid" << notWellFormed;
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+    QFETCH(QJsonStreamReader::Error, error);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(readAll(reader), expected);
+    QCOMPARE(reader.error(), error);
+    QVERIFY(reader.hasError());
+    QVERIFY(reader.atEnd());
+    QVERIFY(!reader.errorString().isEmpty());
+    QVERIFY(reader.name().isEmpty());
+
+    // reading on fails the same way, as no data has been added
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), error);
+}
+
+void tst_QJsonStreamReader::errorOffset()
+{
+    QJsonStreamReader reader(QByteArray("[1 2]"));
+    readAll(reader);
+    QCOMPARE(reader.error(), QJsonStreamReader::NotWellFormedError);
+    QCOMPARE(reader.characterOffset(), qint64(3));
+
+    reader.clear();
+    reader.addData(QByteArray("1 1true"));
+    readAll(reader);
+    QCOMPARE(reader.error(), QJsonStreamReader::NotWellFormedError);
+    QCOMPARE(reader.characterOffset(), qint64(3));
+}
+
+void tst_QJsonStreamReader::integers_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<qint64>("expected");
+
+    QTest::newRow("zero") << QByteArray("0") << Q_INT64_C(0);
+    QTest::newRow("negative") << QByteArray("-42") << Q_INT64_C(-42);
+    QTest::newRow("2^53+1") << QByteArray("9007199254740993") << Q_INT64_C(9007199254740993);
+    QTest::newRow("max") << QByteArray("9223372036854775807")
+                         << std::numeric_limits<qint64>::max();
+    QTest::newRow("min") << QByteArray("-9223372036854775808")
+                         << std::numeric_limits<qint64>::min();
+    QTest::newRow("overflow") << QByteArray("9223372036854775808") << Q_INT64_C(-1);
+    QTest::newRow("exponent") << QByteArray("1e3") << Q_INT64_C(1000);
+    QTest::newRow("fraction") << QByteArray("1.5") << Q_INT64_C(-1);
+}
+
+void tst_QJsonStreamReader::integers()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(qint64, expected);
+
+    QJsonStreamReader reader(json + '\n');
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(-1), expected);
+    QCOMPARE(reader.toDouble(), json.toDouble());
+}
+
+void tst_QJsonStreamReader::unsignedIntegers_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<quint64>("expected");
+
+    QTest::newRow("zero") << QByteArray("0") << Q_UINT64_C(0);
+    QTest::newRow("minus-zero") << QByteArray("-0") << Q_UINT64_C(0);
+    QTest::newRow("negative") << QByteArray("-42") << Q_UINT64_C(1);
+    QTest::newRow("2^63") << QByteArray("9223372036854775808") << Q_UINT64_C(9223372036854775808);
+    QTest::newRow("2^63+1") << QByteArray("9223372036854775809") << Q_UINT64_C(9223372036854775809);
+    QTest::newRow("max") << QByteArray("18446744073709551615")
+                         << std::numeric_limits<quint64>::max();
+    QTest::newRow("overflow") << QByteArray("18446744073709551616") << Q_UINT64_C(1);
+    QTest::newRow("exponent") << QByteArray("1e3") << Q_UINT64_C(1000);
+    QTest::newRow("negative-exponent") << QByteArray("-1e3") << Q_UINT64_C(1);
+    QTest::newRow("fraction") << QByteArray("1.5") << Q_UINT64_C(1);
+}
+
+void tst_QJsonStreamReader::unsignedIntegers()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(quint64, expected);
+
+    QJsonStreamReader reader(json + '\n');
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toUnsignedInteger(1), expected);
+}
+
+// Builds a QJsonValue from the tokens, starting at the current one.
+static QJsonValue readValue(QJsonStreamReader &reader)
+{
+    switch (reader.tokenType()) {
+    case QJsonStreamReader::StartArray: {
+        QJsonArray array;
+        while (reader.readNext() != QJsonStreamReader::EndArray && !reader.hasError())
+            array.append(readValue(reader));
+        return array;
+    }
+    case QJsonStreamReader::StartObject: {
+        QJsonObject object;
+        while (reader.readNext() != QJsonStreamReader::EndObject && !reader.hasError()) {
+            const QString name = reader.name().toString();
+            object.insert(name, readValue(reader));
+        }
+        return object;
+    }
+    default:
+        return reader.value();
+    }
+}
+
+void tst_QJsonStreamReader::compareWithDocument_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("object") << QByteArray("{\"a\": [1, 2.5, \"x\", true, null], \"b\": {\"c\": {}}}");
+    QTest::newRow("array") << QByteArray("[[], [[]], {\"\\u00e9\": \"\\n\"}, -0.001]");
+
+    QFile file(QFINDTESTDATA("../json/test.json"));
+    if (file.open(QIODevice::ReadOnly))
+        QTest::newRow("test.json") << file.readAll();
+}
+
+void tst_QJsonStreamReader::compareWithDocument()
+{
+    QFETCH(QByteArray, json);
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(json, &parseError);
+    QCOMPARE(parseError.error, QJsonParseError::NoError);
+
+    QJsonStreamReader reader(json);
+    reader.readNext();
+    const QJsonValue value = readValue(reader);
+    QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+    if (document.isArray())
+        QCOMPARE(value, QJsonValue(document.array()));
+    else
+        QCOMPARE(value, QJsonValue(document.object()));
+}
+
+void tst_QJsonStreamReader::jsonLines()
+{
+    QJsonStreamReader reader;
+    reader.addData(QByteArray("{\"id\": 1}\n{\"id\": 2}\n{\"id\""));
+
+    QVector<qint64> ids;
+    const auto readLines = [&] {
+        do {
+            if (reader.readNext() == QJsonStreamReader::Number && reader.name() == QLatin1String("id"))
+                ids << reader.toInteger();
+        } while (!reader.atEnd());
+    };
+    readLines();
+    QCOMPARE(ids, QVector<qint64>({ 1, 2 }));
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+
+    reader.addData(QByteArray(": 3}\n"));
+    readLines();
+    QCOMPARE(ids, QVector<qint64>({ 1, 2, 3 }));
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndDocument);
+    QVERIFY(!reader.hasError());
+
+    // EndDocument is not final either
+    reader.addData(QByteArray("{\"id\": 4}\n"));
+    readLines();
+    QCOMPARE(ids, QVector<qint64>({ 1, 2, 3, 4 }));
+
+    reader.clear();
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QCOMPARE(reader.characterOffset(), qint64(0));
+}
+
+void tst_QJsonStreamReader::finishData()
+{
+    QJsonStreamReader reader(QByteArray("42"));
+    // the number might continue
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+
+    reader.finishData();
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), Q_INT64_C(42));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+    QVERIFY(!reader.hasError());
+
+    QJsonStreamReader incomplete(QByteArray("[1"));
+    incomplete.finishData();
+    QCOMPARE(incomplete.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(incomplete.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(incomplete.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(incomplete.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+
+    incomplete.clear();
+    incomplete.addData(QByteArray("7"));
+    QCOMPARE(incomplete.readNext(), QJsonStreamReader::Invalid);
+}
+
+void tst_QJsonStreamReader::stringInChunks_data()
+{
+    QTest::addColumn<int>("chunkSize");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("5") << 5;
+    QTest::newRow("64") << 64;
+}
+
+void tst_QJsonStreamReader::stringInChunks()
+{
+    QFETCH(int, chunkSize);
+
+    // escapes and multi-byte characters end up split at every position
+    QByteArray json = "{\"key\": \"";
+    QString expected;
+    for (int i = 0; i < 200; ++i) {
+        json += "ab\\n\\u00e9\xe2\x82\xac";
+        expected += QString::fromUtf8("ab\n\xc3\xa9\xe2\x82\xac");
+    }
+    json += "\"}";
+
+    QJsonStreamReader reader;
+    int fed = 0;
+    QJsonStreamReader::TokenType type;
+    while ((type = reader.readNext()) != QJsonStreamReader::String) {
+        QVERIFY2(type == QJsonStreamReader::StartObject || type == QJsonStreamReader::EndDocument
+                 || reader.error() == QJsonStreamReader::PrematureEndOfDocumentError,
+                 qPrintable(reader.errorString()));
+        QVERIFY(fed < json.size());
+        const int size = qMin(chunkSize, json.size() - fed);
+        reader.addData(json.constData() + fed, size);
+        fed += size;
+    }
+    QCOMPARE(reader.name().toString(), QStringLiteral("key"));
+    QCOMPARE(reader.text().toString(), expected);
+}
+
+void tst_QJsonStreamReader::skipCurrentValue()
+{
+    QJsonStreamReader reader(QByteArray("{\"skip\": [1, {\"x\": [2]}], \"keep\": \"yes\"}"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.depth(), 1);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.name().toString(), QStringLiteral("skip"));
+    QCOMPARE(reader.depth(), 2);
+    QVERIFY(reader.skipCurrentValue());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.depth(), 1);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.name().toString(), QStringLiteral("keep"));
+    QCOMPARE(reader.text().toString(), QStringLiteral("yes"));
+    QVERIFY(reader.skipCurrentValue());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::String);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    QJsonStreamReader incomplete(QByteArray("[[1, 2"));
+    incomplete.readNext();
+    QVERIFY(!incomplete.skipCurrentValue());
+    QCOMPARE(incomplete.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+}
+
+void tst_QJsonStreamReader::deepNesting()
+{
+    QJsonStreamReader reader(QByteArray(2048, '['));
+    int depth = 0;
+    while (reader.readNext() == QJsonStreamReader::StartArray)
+        ++depth;
+    QCOMPARE(depth, 1024);
+    QCOMPARE(reader.error(), QJsonStreamReader::NotWellFormedError);
+}
+
+void tst_QJsonStreamReader::customError()
+{
+    QJsonStreamReader reader(QByteArray("[1, 2]"));
+    reader.readNext();
+    reader.raiseError(QStringLiteral("Unexpected array"));
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::CustomError);
+    QCOMPARE(reader.errorString(), QStringLiteral("Unexpected array"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+}
+
+// A device that only has the data that has been written to it so far.
+class Pipe : public QIODevice
+{
+public:
+    Pipe() { open(ReadWrite); }
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override { return data.size() + QIODevice::bytesAvailable(); }
+
+    QByteArray data;
+    bool writerClosed = false;
+
+protected:
+    qint64 readData(char *out, qint64 maxSize) override
+    {
+        if (writerClosed && data.isEmpty())
+            return -1;
+        const int size = int(qMin(maxSize, qint64(data.size())));
+        memcpy(out, data.constData(), size_t(size));
+        data.remove(0, size);
+        return size;
+    }
+    qint64 writeData(const char *in, qint64 size) override
+    {
+        data.append(in, int(size));
+        return size;
+    }
+};
+
+void tst_QJsonStreamReader::sequentialDevice()
+{
+    Pipe pipe;
+    QJsonStreamReader reader(&pipe);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    pipe.write("[\"first\", 4");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    // the number might continue
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+
+    pipe.write("2]\n");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), Q_INT64_C(42));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // a number at the very end is complete once no more data can come
+    pipe.write("17");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    pipe.writerClosed = true;
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), Q_INT64_C(17));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    Pipe closed;
+    QJsonStreamReader closedReader(&closed);
+    closed.write("[3.5");
+    QCOMPARE(closedReader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(closedReader.readNext(), QJsonStreamReader::Invalid);
+    closed.close();
+    QCOMPARE(closedReader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(closedReader.toDouble(), 3.5);
+    QCOMPARE(closedReader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(closedReader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+}
+
+QTEST_MAIN(tst_QJsonStreamReader)
+
+#include "tst_qjsonstreamreader.moc"
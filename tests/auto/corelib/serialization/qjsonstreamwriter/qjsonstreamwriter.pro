@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qjsonstreamwriter
+QT = core testlib
+SOURCES = tst_qjsonstreamwriter.cpp
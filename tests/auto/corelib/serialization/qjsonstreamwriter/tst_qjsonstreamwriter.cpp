@@ -0,0 +1,273 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/qjsonstream.h>
+#include <QtCore/qbuffer.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtTest>
+
+#include <cmath>
+
+class tst_QJsonStreamWriter : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void scalars_data();
+    void scalars();
+    void strings_data();
+    void strings();
+    void containers();
+    void autoFormatting();
+    void jsonValue_data();
+    void jsonValue();
+    void misuse();
+    void device();
+    void roundTrip();
+};
+
+void tst_QJsonStreamWriter::scalars_data()
+{
+    QTest::addColumn<QJsonValue>("value");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::newRow("true") << QJsonValue(true) << QByteArray("true");
+    QTest::newRow("false") << QJsonValue(false) << QByteArray("false");
+    QTest::newRow("null") << QJsonValue(QJsonValue::Null) << QByteArray("null");
+    QTest::newRow("undefined") << QJsonValue(QJsonValue::Undefined) << QByteArray("null");
+    QTest::newRow("zero") << QJsonValue(0.0) << QByteArray("0");
+    QTest::newRow("integral") << QJsonValue(-1024.0) << QByteArray("-1024");
+    QTest::newRow("fraction") << QJsonValue(0.1) << QByteArray("0.1");
+    QTest::newRow("large") << QJsonValue(1e300) << QByteArray("1e+300");
+    QTest::newRow("small") << QJsonValue(1.5e-7) << QByteArray("1.5e-07");
+    QTest::newRow("inf") << QJsonValue(qInf()) << QByteArray("null");
+    QTest::newRow("nan") << QJsonValue(qQNaN()) << QByteArray("null");
+    QTest::newRow("string") << QJsonValue(QStringLiteral("text")) << QByteArray("\"text\"");
+}
+
+void tst_QJsonStreamWriter::scalars()
+{
+    QFETCH(QJsonValue, value);
+    QFETCH(QByteArray, expected);
+
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.append(value);
+    QCOMPARE(output, expected + '\n');
+
+    // the same as QJsonDocument writes
+    if (value.isDouble()) {
+        const QByteArray json = QJsonDocument(QJsonArray({ value })).toJson(QJsonDocument::Compact);
+        QCOMPARE(json, '[' + expected + ']');
+    }
+}
+
+void tst_QJsonStreamWriter::strings_data()
+{
+    QTest::addColumn<QString>("string");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::newRow("empty") << QString() << QByteArray("\"\"");
+    QTest::newRow("quotes") << QStringLiteral("say \"hi\"\\") << QByteArray("\"say \\\"hi\\\"\\\\\"");
+    QTest::newRow("controls") << QStringLiteral("\b\f\n\r\t\x01")
+                              << QByteArray("\"\\b\\f\\n\\r\\t\\u0001\"");
+    QTest::newRow("slash") << QStringLiteral("a/b") << QByteArray("\"a/b\"");
+    QTest::newRow("latin1") << QString::fromUtf8("caf\xc3\xa9") << QByteArray("\"caf\xc3\xa9\"");
+    QTest::newRow("nonLatin1") << QString::fromUtf8("\xe2\x82\xac\xf0\x9f\x98\x80")
+                               << QByteArray("\"\xe2\x82\xac\xf0\x9f\x98\x80\"");
+}
+
+void tst_QJsonStreamWriter::strings()
+{
+    QFETCH(QString, string);
+    QFETCH(QByteArray, expected);
+
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.append(string);
+    QCOMPARE(output, expected + '\n');
+
+    const QByteArray latin1 = string.toLatin1();
+    if (QString::fromLatin1(latin1) == string) {
+        output.clear();
+        writer.append(QLatin1String(latin1));
+        QCOMPARE(output, expected + '\n');
+    }
+}
+
+void tst_QJsonStreamWriter::containers()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.startObject();
+    writer.append(QLatin1String("name"));
+    writer.append(QLatin1String("value"));
+    writer.append(QLatin1String("list"));
+    writer.startArray();
+    writer.append(1);
+    writer.append(std::numeric_limits<qint64>::min());
+    writer.append(std::numeric_limits<quint64>::max());
+    writer.append(nullptr);
+    writer.startArray();
+    QVERIFY(writer.endArray());
+    writer.startObject();
+    QVERIFY(writer.endObject());
+    QVERIFY(writer.endArray());
+    QVERIFY(writer.endObject());
+
+    QCOMPARE(output, QByteArray("{\"name\":\"value\",\"list\":[1,-9223372036854775808,"
+                                "18446744073709551615,null,[],{}]}\n"));
+}
+
+void tst_QJsonStreamWriter::autoFormatting()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    QVERIFY(!writer.autoFormatting());
+    writer.setAutoFormatting(true);
+    QVERIFY(writer.autoFormatting());
+
+    const QJsonObject object = QJsonDocument::fromJson(
+                "{\"a\": [1, true, \"x\"], \"b\": {\"c\": null}, \"d\": 2.5}").object();
+    writer.append(object);
+    QCOMPARE(output, QJsonDocument(object).toJson(QJsonDocument::Indented));
+
+    output.clear();
+    writer.startArray();
+    writer.startObject();
+    writer.endObject();
+    writer.endArray();
+    QCOMPARE(output, QByteArray("[\n    {}\n]\n"));
+}
+
+void tst_QJsonStreamWriter::jsonValue_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("object") << QByteArray("{\"a\":[1,2.5,\"x\",true,null],\"b\":{\"c\":{}}}");
+    QTest::newRow("array") << QByteArray("[[],[[]],{\"\\u00e9\":\"\\n\"},-0.001]");
+
+    QFile file(QFINDTESTDATA("../json/test.json"));
+    if (file.open(QIODevice::ReadOnly))
+        QTest::newRow("test.json") << file.readAll();
+}
+
+void tst_QJsonStreamWriter::jsonValue()
+{
+    QFETCH(QByteArray, json);
+
+    const QJsonDocument document = QJsonDocument::fromJson(json);
+    QVERIFY(!document.isNull());
+    const QJsonValue value = document.isArray() ? QJsonValue(document.array())
+                                                : QJsonValue(document.object());
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.append(value);
+    QCOMPARE(output, document.toJson(QJsonDocument::Compact) + '\n');
+}
+
+void tst_QJsonStreamWriter::misuse()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: endArray() without an array");
+    QVERIFY(!writer.endArray());
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: endObject() without an object");
+    QVERIFY(!writer.endObject());
+    QVERIFY(output.isEmpty());
+
+    writer.startObject();
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: an object member needs a name first");
+    writer.append(true);
+    QTest::ignoreMessage(QtWarningMsg, "QJsonStreamWriter: endArray() without an array");
+    QVERIFY(!writer.endArray());
+    writer.append(QLatin1String("key"));
+    // a name without a value
+    QVERIFY(!writer.endObject());
+    QCOMPARE(output, QByteArray("{\"key\":null}\n"));
+}
+
+void tst_QJsonStreamWriter::device()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    {
+        QJsonStreamWriter writer(&buffer);
+        QCOMPARE(writer.device(), &buffer);
+        writer.startArray();
+        writer.append(1);
+        // incomplete values are kept until they are complete, or flushed
+        QVERIFY(buffer.data().isEmpty());
+        writer.flush();
+        QCOMPARE(buffer.data(), QByteArray("[1"));
+        writer.endArray();
+        QCOMPARE(buffer.data(), QByteArray("[1]\n"));
+
+        writer.startObject();
+        writer.append(QLatin1String("open"));
+        writer.append(true);
+    }
+    // the destructor flushes, but does not complete the object
+    QCOMPARE(buffer.data(), QByteArray("[1]\n{\"open\":true"));
+
+    // values are written to the device as the buffer fills up
+    QBuffer large;
+    QVERIFY(large.open(QIODevice::WriteOnly));
+    QJsonStreamWriter writer(&large);
+    writer.startArray();
+    for (int i = 0; i < 10000; ++i)
+        writer.append(i);
+    QVERIFY(large.size() > 0);
+    writer.endArray();
+    QVERIFY(large.data().endsWith("9999]\n"));
+}
+
+void tst_QJsonStreamWriter::roundTrip()
+{
+    const double values[] = {
+        0.1, -1.5e-300, 123456789012345678.0, 5e-324, 1.7976931348623157e308, 1.0 / 3
+    };
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    for (double d : values)
+        writer.append(d);
+
+    QJsonStreamReader reader(output);
+    for (double d : values) {
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+        QCOMPARE(reader.toDouble(), d);
+    }
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+}
+
+QTEST_MAIN(tst_QJsonStreamWriter)
+
+#include "tst_qjsonstreamwriter.moc"
@@ -7,6 +7,9 @@ SUBDIRS = \
     qcborvalue_json \
     qdatastream \
     qdatastream_core_pixmap \
+    qgadgetserializer \
+    qjsonstreamreader \
+    qjsonstreamwriter \
     qtextstream \
     qxmlstream
 
@@ -43,6 +43,7 @@ class tst_QByteArrayMatcher : public QObject
 private slots:
     void interface();
     void indexIn();
+    void indexInBoundaries();
     void staticByteArrayMatcher();
 };
 
@@ -137,6 +138,34 @@ void tst_QByteArrayMatcher::indexIn()
     QCOMPARE(matcher.indexIn(haystack, 34), -1);
 }
 
+void tst_QByteArrayMatcher::indexInBoundaries()
+{
+    const QByteArray pattern("bab");
+    QByteArrayMatcher matcher(pattern);
+
+    // around the boundaries of the vectors compared at once
+    for (int pos = 0; pos <= 77; ++pos) {
+        QByteArray haystack(80, 'a');
+        haystack.replace(pos, pattern.size(), pattern);
+        QCOMPARE(matcher.indexIn(haystack), pos);
+        QCOMPARE(matcher.indexIn(haystack.constData(), haystack.size()), pos);
+        QCOMPARE(haystack.indexOf(pattern), pos);
+        QCOMPARE(matcher.indexIn(haystack, pos + 1), -1);
+        QCOMPARE(haystack.indexOf(pattern, pos + 1), -1);
+
+        // first and last byte match, the middle one does not
+        haystack[pos + 1] = 'c';
+        QCOMPARE(matcher.indexIn(haystack), -1);
+        QCOMPARE(haystack.indexOf(pattern), -1);
+    }
+
+    QByteArray haystack(1000, '\0');
+    haystack.append(pattern);
+    QCOMPARE(matcher.indexIn(haystack), 1000);
+    QCOMPARE(matcher.indexIn(haystack.constData(), 1002), -1);
+    QCOMPARE(haystack.indexOf(pattern), 1000);
+}
+
 void tst_QByteArrayMatcher::staticByteArrayMatcher()
 {
     {
@@ -90,6 +90,9 @@ private slots:
     void doubleToString();
     void strtod_data();
     void strtod();
+    void cLocaleDouble_data();
+    void cLocaleDouble();
+    void cLocaleDoubleRoundTrip();
     void long_long_conversion_data();
     void long_long_conversion();
     void long_long_conversion_extra();
@@ -1265,6 +1268,95 @@ void tst_QLocale::strtod()
     QCOMPARE(actualOk, ok);
 }
 
+void tst_QLocale::cLocaleDouble_data()
+{
+    QTest::addColumn<QString>("num_str");
+    QTest::addColumn<double>("num");
+    QTest::addColumn<bool>("ok");
+
+    // exact mantissa and power of ten
+    QTest::newRow("integer")  << QString("12345")  << 12345.0 << true;
+    QTest::newRow("negative") << QString("-0.25")  << -0.25   << true;
+    QTest::newRow("plus")     << QString("+1.5e3") << 1500.0  << true;
+    QTest::newRow("point")    << QString(".5")     << 0.5     << true;
+    QTest::newRow("1e22")     << QString("1e22")   << 1e22    << true;
+    QTest::newRow("1e-22")    << QString("1e-22")  << 1e-22   << true;
+
+    // up to 19 digits, inexact
+    QTest::newRow("1e23")       << QString("1e23")                    << 1e23                    << true;
+    QTest::newRow("0.1")        << QString("0.1")                     << 0.1                     << true;
+    QTest::newRow("pi")         << QString("3.141592653589793")       << 3.141592653589793       << true;
+    QTest::newRow("19 digits")  << QString("1234567890123456789")     << 1234567890123456789.0   << true;
+    QTest::newRow("max")        << QString("1.7976931348623157e308")  << 1.7976931348623157e308  << true;
+    QTest::newRow("min normal") << QString("2.2250738585072014e-308") << 2.2250738585072014e-308 << true;
+    QTest::newRow("halfway, down to even") << QString("9007199254740993") << 9007199254740992.0 << true;
+    QTest::newRow("halfway, up to even")   << QString("9007199254740995") << 9007199254740996.0 << true;
+
+    // left to the general algorithm
+    QTest::newRow("20 digits") << QString("12345678901234567890") << 12345678901234567890.0 << true;
+    QTest::newRow("zeroes")    << QString("0000000000000000000000001.5") << 1.5 << true;
+    QTest::newRow("denormal")  << QString("4.9e-324") << 4.9e-324 << true;
+    QTest::newRow("overflow")  << QString("1.8e308")  << qInf()   << false;
+    QTest::newRow("underflow") << QString("1e-400")   << 0.0      << false;
+
+    QTest::newRow("whitespace") << QString(" \t42.5\n") << 42.5 << true;
+
+    QTest::newRow("no exponent") << QString("1e")    << 0.0 << false;
+    QTest::newRow("no digits")   << QString(".")     << 0.0 << false;
+    QTest::newRow("two points")  << QString("1.2.3") << 0.0 << false;
+    QTest::newRow("comma")       << QString("1,5")   << 0.0 << false;
+}
+
+void tst_QLocale::cLocaleDouble()
+{
+    QFETCH(QString, num_str);
+    QFETCH(double, num);
+    QFETCH(bool, ok);
+
+    // the results have to be exact, and the same on all paths
+    bool actualOk = !ok;
+    QCOMPARE(qFloatDistance(num_str.toDouble(&actualOk), num), quint64(0));
+    QCOMPARE(actualOk, ok);
+
+    actualOk = !ok;
+    QCOMPARE(qFloatDistance(num_str.toLatin1().toDouble(&actualOk), num), quint64(0));
+    QCOMPARE(actualOk, ok);
+
+    actualOk = !ok;
+    QCOMPARE(qFloatDistance(QLocale::c().toDouble(num_str, &actualOk), num), quint64(0));
+    QCOMPARE(actualOk, ok);
+
+    // other locales with '.' as the decimal point share the fast path
+    actualOk = !ok;
+    const QLocale english(QLocale::English, QLocale::UnitedStates);
+    QCOMPARE(qFloatDistance(english.toDouble(num_str, &actualOk), num), quint64(0));
+    QCOMPARE(actualOk, ok);
+}
+
+void tst_QLocale::cLocaleDoubleRoundTrip()
+{
+    // QString and QByteArray format alike, and the shortest representation
+    // reads back as the same number
+    quint64 bits = Q_UINT64_C(0x0123456789abcdef);
+    for (int i = 0; i < 10000; ++i) {
+        bits = bits * Q_UINT64_C(6364136223846793005) + Q_UINT64_C(1442695040888963407);
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        if (!qIsFinite(d))
+            continue;
+
+        const QString shortest = QString::number(d, 'g', QLocale::FloatingPointShortest);
+        QCOMPARE(QByteArray::number(d, 'g', QLocale::FloatingPointShortest), shortest.toLatin1());
+        bool ok = false;
+        QCOMPARE(qFloatDistance(shortest.toDouble(&ok), d), quint64(0));
+        QVERIFY(ok);
+
+        QCOMPARE(QByteArray::number(d, 'e', 16), QString::number(d, 'e', 16).toLatin1());
+        QCOMPARE(QByteArray::number(d, 'f', 6), QString::number(d, 'f', 6).toLatin1());
+        QCOMPARE(QByteArray::number(d, 'G', 10), QString::number(d, 'G', 10).toLatin1());
+    }
+}
+
 void tst_QLocale::long_long_conversion_data()
 {
     QTest::addColumn<QString>("locale_name");
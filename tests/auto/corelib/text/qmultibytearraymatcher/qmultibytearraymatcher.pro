@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qmultibytearraymatcher
+QT = core testlib
+SOURCES = tst_qmultibytearraymatcher.cpp
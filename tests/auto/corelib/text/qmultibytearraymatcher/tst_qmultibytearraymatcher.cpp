@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qmultibytearraymatcher.h>
+
+Q_DECLARE_METATYPE(QMultiByteArrayMatcher::Match)
+typedef QVector<QMultiByteArrayMatcher::Match> Matches;
+
+static bool operator==(const QMultiByteArrayMatcher::Match &lhs, const QMultiByteArrayMatcher::Match &rhs)
+{
+    return lhs.position == rhs.position && lhs.length == rhs.length && lhs.pattern == rhs.pattern;
+}
+
+namespace QTest {
+template <>
+char *toString(const QMultiByteArrayMatcher::Match &match)
+{
+    return qstrdup(QByteArray::number(match.pattern) + '@' + QByteArray::number(match.position)
+                   + '+' + QByteArray::number(match.length));
+}
+}
+
+class tst_QMultiByteArrayMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty();
+    void matches();
+    void indexIn();
+    void caseSensitivity();
+    void binary();
+};
+
+void tst_QMultiByteArrayMatcher::empty()
+{
+    QMultiByteArrayMatcher matcher;
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+    QVERIFY(matcher.patterns().isEmpty());
+    QCOMPARE(matcher.indexIn(QByteArray("foo")), -1);
+    QVERIFY(matcher.matches(QByteArray("foo")).isEmpty());
+
+    matcher.setPatterns({ QByteArray(), "bar" });
+    QCOMPARE(matcher.indexIn(QByteArray("foo")), -1);
+    QCOMPARE(matcher.indexIn(nullptr, 0), -1);
+}
+
+void tst_QMultiByteArrayMatcher::matches()
+{
+    const QByteArrayList patterns = { "he", "she", "his", "hers" };
+    const QMultiByteArrayMatcher matcher(patterns);
+    QCOMPARE(matcher.patterns(), patterns);
+
+    const QByteArray haystack("ushers");
+    QCOMPARE(matcher.matches(haystack), (Matches{ { 1, 3, 1 }, { 2, 2, 0 }, { 2, 4, 3 } }));
+    QCOMPARE(matcher.matches(haystack, 2), (Matches{ { 2, 2, 0 }, { 2, 4, 3 } }));
+    QCOMPARE(matcher.matches(haystack.constData(), 4), (Matches{ { 1, 3, 1 }, { 2, 2, 0 } }));
+    QCOMPARE(matcher.matches(haystack, 3), Matches());
+}
+
+void tst_QMultiByteArrayMatcher::indexIn()
+{
+    const QMultiByteArrayMatcher matcher({ "bc", "abcd", "x" });
+    int pattern = -2;
+    QCOMPARE(matcher.indexIn(QByteArray("zabcdx"), 0, &pattern), 1);
+    QCOMPARE(pattern, 1);
+    QCOMPARE(matcher.indexIn(QByteArray("zabcdx"), 2, &pattern), 2);
+    QCOMPARE(pattern, 0);
+    QCOMPARE(matcher.indexIn(QByteArray("zabcdx"), 4, &pattern), 5);
+    QCOMPARE(pattern, 2);
+    QCOMPARE(matcher.indexIn(QByteArray("zabcdx"), 6, &pattern), -1);
+    QCOMPARE(pattern, -1);
+}
+
+void tst_QMultiByteArrayMatcher::caseSensitivity()
+{
+    QMultiByteArrayMatcher matcher({ "foo", "\xe9t\xe9", "a\xd7" });
+    const QByteArray haystack("FOO \xc9T\xc9 A\xf7 foo");
+    QCOMPARE(matcher.matches(haystack), (Matches{ { 11, 3, 0 } }));
+
+    matcher.setCaseSensitivity(Qt::CaseInsensitive);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+    // MULTIPLICATION SIGN and DIVISION SIGN are not a case pair
+    QCOMPARE(matcher.matches(haystack), (Matches{ { 0, 3, 0 }, { 4, 3, 1 }, { 11, 3, 0 } }));
+}
+
+void tst_QMultiByteArrayMatcher::binary()
+{
+    const QByteArray zero(1, '\0');
+    const QMultiByteArrayMatcher matcher({ zero + zero, "\xff" });
+    const QByteArray haystack = "a" + zero + zero + zero + "\xff";
+    QCOMPARE(matcher.matches(haystack), (Matches{ { 1, 2, 0 }, { 2, 2, 0 }, { 4, 1, 1 } }));
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiByteArrayMatcher)
+#include "tst_qmultibytearraymatcher.moc"
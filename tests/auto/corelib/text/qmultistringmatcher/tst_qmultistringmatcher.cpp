@@ -0,0 +1,241 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qmultistringmatcher.h>
+#include <qstringmatcher.h>
+
+Q_DECLARE_METATYPE(QMultiStringMatcher::Match)
+typedef QVector<QMultiStringMatcher::Match> Matches;
+
+static bool operator==(const QMultiStringMatcher::Match &lhs, const QMultiStringMatcher::Match &rhs)
+{
+    return lhs.position == rhs.position && lhs.length == rhs.length && lhs.pattern == rhs.pattern;
+}
+
+namespace QTest {
+template <>
+char *toString(const QMultiStringMatcher::Match &match)
+{
+    return qstrdup(QByteArray::number(match.pattern) + '@' + QByteArray::number(match.position)
+                   + '+' + QByteArray::number(match.length));
+}
+}
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty();
+    void matches_data();
+    void matches();
+    void indexIn_data();
+    void indexIn();
+    void caseSensitivity();
+    void compareWithStringMatcher();
+    void manyCharacters();
+    void copy();
+};
+
+void tst_QMultiStringMatcher::empty()
+{
+    QMultiStringMatcher matcher;
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+    QVERIFY(matcher.patterns().isEmpty());
+    QCOMPARE(matcher.indexIn(u"foo"), -1);
+    QVERIFY(matcher.matches(u"foo").isEmpty());
+
+    matcher.setPatterns({ QString(), QStringLiteral("bar") });
+    QCOMPARE(matcher.indexIn(u"foo"), -1);
+    QCOMPARE(matcher.indexIn(u""), -1);
+    QCOMPARE(matcher.indexIn(QStringView()), -1);
+}
+
+void tst_QMultiStringMatcher::matches_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<int>("from");
+    QTest::addColumn<Matches>("matches");
+
+    const QStringList classic = { "he", "she", "his", "hers" };
+    QTest::newRow("classic") << classic << QString("ushers") << 0
+                             << Matches{ { 1, 3, 1 }, { 2, 2, 0 }, { 2, 4, 3 } };
+    QTest::newRow("classic-from") << classic << QString("ushers") << 2
+                                  << Matches{ { 2, 2, 0 }, { 2, 4, 3 } };
+    QTest::newRow("classic-late-from") << classic << QString("ushers") << 3 << Matches();
+    QTest::newRow("overlapping") << QStringList{ "aa" } << QString("aaaa") << 0
+                                 << Matches{ { 0, 2, 0 }, { 1, 2, 0 }, { 2, 2, 0 } };
+    QTest::newRow("nested") << QStringList{ "b", "abc", "ab" } << QString("xabcx") << 0
+                            << Matches{ { 1, 2, 2 }, { 2, 1, 0 }, { 1, 3, 1 } };
+    QTest::newRow("duplicates") << QStringList{ "ab", "x", "ab" } << QString("abab") << 0
+                                << Matches{ { 0, 2, 0 }, { 0, 2, 2 }, { 2, 2, 0 }, { 2, 2, 2 } };
+    QTest::newRow("non-latin1") << QStringList{ QString::fromUtf8("\xe4\xb8\xad\xe6\x96\x87") }
+                                << QString::fromUtf8("x\xe4\xb8\xad\xe6\x96\x87\xe4\xb8\xad") << 0
+                                << Matches{ { 1, 2, 0 } };
+}
+
+void tst_QMultiStringMatcher::matches()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QString, haystack);
+    QFETCH(int, from);
+    QFETCH(Matches, matches);
+
+    const QMultiStringMatcher matcher(patterns);
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.matches(haystack, from), matches);
+}
+
+void tst_QMultiStringMatcher::indexIn_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<int>("from");
+    QTest::addColumn<int>("indexIn");
+    QTest::addColumn<int>("pattern");
+
+    const QStringList classic = { "he", "she", "his", "hers" };
+    QTest::newRow("classic") << classic << QString("ushers") << 0 << 1 << 1;
+    QTest::newRow("classic-from") << classic << QString("ushers") << 2 << 2 << 3;
+    QTest::newRow("none") << classic << QString("ushrs") << 0 << -1 << -1;
+    QTest::newRow("negative-from") << classic << QString("his") << -5 << 0 << 2;
+    // "abcd" starts first, but "bc" ends first
+    QTest::newRow("leftmost") << QStringList{ "bc", "abcd" } << QString("xabcd") << 0 << 1 << 1;
+    QTest::newRow("longest") << QStringList{ "ab", "abc", "a" } << QString("xabc") << 0 << 1 << 1;
+    QTest::newRow("duplicates") << QStringList{ "ab", "ab" } << QString("ab") << 0 << 0 << 0;
+}
+
+void tst_QMultiStringMatcher::indexIn()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(QString, haystack);
+    QFETCH(int, from);
+    QFETCH(int, indexIn);
+    QFETCH(int, pattern);
+
+    const QMultiStringMatcher matcher(patterns);
+    int found = -2;
+    QCOMPARE(matcher.indexIn(haystack, from, &found), indexIn);
+    QCOMPARE(found, pattern);
+    QCOMPARE(matcher.indexIn(haystack, from), indexIn);
+}
+
+void tst_QMultiStringMatcher::caseSensitivity()
+{
+    QMultiStringMatcher matcher({ "foo", QString::fromUtf8("\xc3\xa9t\xc3\xa9"), "kelvin" });
+    const QString haystack = QString::fromUtf8("FOO \xc3\x89T\xc3\x89 \xe2\x84\xaa" "ELVIN foo");
+    QCOMPARE(matcher.matches(haystack), (Matches{ { 15, 3, 0 } }));
+
+    matcher.setCaseSensitivity(Qt::CaseInsensitive);
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+    QCOMPARE(matcher.matches(haystack),
+             (Matches{ { 0, 3, 0 }, { 4, 3, 1 }, { 8, 6, 2 }, { 15, 3, 0 } }));
+
+    matcher.setPatterns({ "FOO" });
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+    QCOMPARE(matcher.indexIn(haystack, 1), 15);
+}
+
+void tst_QMultiStringMatcher::compareWithStringMatcher()
+{
+    const QString text = QString::fromLatin1(
+        "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor "
+        "incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud "
+        "exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat.");
+    const QStringList patterns = text.split(QLatin1Char(' '));
+
+    for (Qt::CaseSensitivity cs : { Qt::CaseSensitive, Qt::CaseInsensitive }) {
+        const QMultiStringMatcher matcher(patterns, cs);
+        const Matches matches = matcher.matches(text);
+        for (int i = 0; i < patterns.size(); ++i) {
+            const QStringMatcher single(patterns.at(i), cs);
+            qsizetype expected = single.indexIn(text);
+            for (const QMultiStringMatcher::Match &match : matches) {
+                if (match.pattern != i)
+                    continue;
+                QCOMPARE(match.position, expected);
+                QCOMPARE(match.length, patterns.at(i).size());
+                expected = single.indexIn(text, expected + 1);
+            }
+            QCOMPARE(expected, -1);
+        }
+    }
+}
+
+void tst_QMultiStringMatcher::manyCharacters()
+{
+    // enough states and characters for the automaton to keep only the edges
+    // of the trie instead of a transition table
+    const int count = 1200;
+    QString text;
+    for (int i = 0; i < count + 2; ++i)
+        text += QChar(0x4e00 + i);
+    QStringList patterns;
+    for (int i = 0; i < count; ++i)
+        patterns.append(text.mid(i, 3));
+    patterns.append(text.mid(1, 1));
+    text += QLatin1Char(' ') + text;
+
+    const QMultiStringMatcher matcher(patterns);
+    const Matches matches = matcher.matches(text);
+    QCOMPARE(matches.size(), 2 * (count + 1));
+    for (int i = 0; i < patterns.size(); ++i) {
+        const QStringMatcher single(patterns.at(i));
+        qsizetype expected = single.indexIn(text);
+        for (const QMultiStringMatcher::Match &match : matches) {
+            if (match.pattern != i)
+                continue;
+            QCOMPARE(match.position, expected);
+            QCOMPARE(match.length, patterns.at(i).size());
+            expected = single.indexIn(text, expected + 1);
+        }
+        QCOMPARE(expected, -1);
+    }
+
+    int pattern = -1;
+    QCOMPARE(matcher.indexIn(text, 1, &pattern), 1);
+    QCOMPARE(pattern, 1);
+    QCOMPARE(matcher.indexIn(text, count + 1), count + 3);
+}
+
+void tst_QMultiStringMatcher::copy()
+{
+    QMultiStringMatcher m1({ "d" });
+    QMultiStringMatcher m2 = m1;
+    m1.setPatterns({ "b" });
+    QCOMPARE(m1.indexIn(u"abcdef"), 1);
+    QCOMPARE(m2.indexIn(u"abcdef"), 3);
+
+    m2 = std::move(m1);
+    QCOMPARE(m2.indexIn(u"abcdef"), 1);
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiStringMatcher)
+#include "tst_qmultistringmatcher.moc"
@@ -37,6 +37,8 @@
 #include <qregularexpression.h>
 #include <qthread.h>
 
+#include <private/qregularexpression_p.h>
+
 Q_DECLARE_METATYPE(QRegularExpression::PatternOptions)
 Q_DECLARE_METATYPE(QRegularExpression::MatchType)
 Q_DECLARE_METATYPE(QRegularExpression::MatchOptions)
@@ -78,6 +80,7 @@ private slots:
     void QStringAndQStringRefEquivalence();
     void threadSafety_data();
     void threadSafety();
+    void compiledPatternCache();
 
     void wildcard_data();
     void wildcard();
@@ -2157,6 +2160,80 @@ void tst_QRegularExpression::threadSafety()
     }
 }
 
+void tst_QRegularExpression::compiledPatternCache()
+{
+    QRegularExpressionCache::clear();
+    const QRegularExpressionCache::Statistics defaults = QRegularExpressionCache::statistics();
+    QCOMPARE(defaults.hits, quint64(0));
+    QCOMPARE(defaults.misses, quint64(0));
+    QCOMPARE(defaults.count, 0);
+    QCOMPARE(defaults.totalCost, 0);
+
+    const QString pattern = QStringLiteral("(\\w+)@(\\w+)\\.com");
+    const QString subject = QStringLiteral("mail joe@example.com today");
+
+    {
+        QRegularExpression re1(pattern);
+        QVERIFY(re1.isValid());
+        QRegularExpressionCache::Statistics stats = QRegularExpressionCache::statistics();
+        QCOMPARE(stats.hits, quint64(0));
+        QCOMPARE(stats.misses, quint64(1));
+        QCOMPARE(stats.count, 1);
+        QVERIFY(stats.totalCost > 0);
+        QVERIFY(stats.totalCost <= stats.maxCost);
+
+        // same pattern and options: shared
+        QRegularExpression re2(pattern);
+        QCOMPARE(re2.match(subject).captured(2), QStringLiteral("example"));
+        stats = QRegularExpressionCache::statistics();
+        QCOMPARE(stats.hits, quint64(1));
+        QCOMPARE(stats.misses, quint64(1));
+        QCOMPARE(stats.count, 1);
+
+        // different options: compiled separately
+        QRegularExpression re3(pattern, QRegularExpression::CaseInsensitiveOption);
+        QCOMPARE(re3.match(subject.toUpper()).captured(1), QStringLiteral("JOE"));
+        stats = QRegularExpressionCache::statistics();
+        QCOMPARE(stats.hits, quint64(1));
+        QCOMPARE(stats.misses, quint64(2));
+        QCOMPARE(stats.count, 2);
+
+        // evicting the cache does not affect existing objects
+        QRegularExpressionCache::clear();
+        QCOMPARE(re1.match(subject).captured(1), QStringLiteral("joe"));
+        QCOMPARE(re3.captureCount(), 2);
+    }
+
+    // invalid patterns are cached too, error included
+    {
+        QRegularExpression invalid1(QStringLiteral("a(b"));
+        QRegularExpression invalid2(QStringLiteral("a(b"));
+        QVERIFY(!invalid1.isValid());
+        QVERIFY(!invalid2.isValid());
+        QCOMPARE(invalid2.errorString(), invalid1.errorString());
+        QCOMPARE(invalid2.patternErrorOffset(), invalid1.patternErrorOffset());
+        const QRegularExpressionCache::Statistics stats = QRegularExpressionCache::statistics();
+        QCOMPARE(stats.hits, quint64(1));
+        QCOMPARE(stats.misses, quint64(1));
+    }
+
+    // a cache without room keeps nothing, but matching still works
+    QRegularExpressionCache::clear();
+    QRegularExpressionCache::setMaxCost(0);
+    {
+        QRegularExpression re1(pattern);
+        QRegularExpression re2(pattern);
+        QVERIFY(re1.match(subject).hasMatch());
+        QVERIFY(re2.match(subject).hasMatch());
+        const QRegularExpressionCache::Statistics stats = QRegularExpressionCache::statistics();
+        QCOMPARE(stats.hits, quint64(0));
+        QCOMPARE(stats.misses, quint64(2));
+        QCOMPARE(stats.count, 0);
+    }
+    QRegularExpressionCache::setMaxCost(defaults.maxCost);
+    QCOMPARE(QRegularExpressionCache::statistics().maxCost, defaults.maxCost);
+}
+
 void tst_QRegularExpression::wildcard_data()
 {
     QTest::addColumn<QString>("pattern");
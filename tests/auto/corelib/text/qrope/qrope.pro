@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qrope
+QT = core testlib
+SOURCES = tst_qrope.cpp
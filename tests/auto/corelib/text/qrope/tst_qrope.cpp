@@ -0,0 +1,426 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qrope.h>
+
+#include <QRandomGenerator>
+
+class tst_QRope : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void construct();
+    void sharesString();
+    void insert();
+    void insertRope();
+    void remove_data();
+    void remove();
+    void replace();
+    void mid_data();
+    void mid();
+    void leftRight();
+    void truncateChop();
+    void at();
+    void chunks();
+    void compare();
+    void implicitSharing();
+    void smallEditsMerge();
+    void randomEdits();
+};
+
+static QString text(const QRope &rope)
+{
+    QString result;
+    for (QStringView chunk : rope.chunks())
+        result.append(chunk.data(), int(chunk.size()));
+    return result;
+}
+
+// A rope with the text of str in several chunks, none of them small.
+static QRope chunked(const QString &str, int chunkSize)
+{
+    QRope rope;
+    for (int i = 0; i < str.size(); i += chunkSize)
+        rope.append(QRope(str.mid(i, chunkSize)));
+    return rope;
+}
+
+static QString longText(int size)
+{
+    QString str;
+    str.reserve(size);
+    for (int i = 0; i < size; ++i)
+        str += QChar(u'a' + i % 26);
+    return str;
+}
+
+void tst_QRope::construct()
+{
+    const QRope empty;
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(empty.size(), qsizetype(0));
+    QCOMPARE(empty.chunkCount(), qsizetype(0));
+    QVERIFY(empty.chunkBegin() == empty.chunkEnd());
+    QVERIFY(empty.toString().isNull());
+    QVERIFY(QRope(QString()).isEmpty());
+    QVERIFY(QRope(QStringView()).isEmpty());
+
+    const QRope hello(QStringView(u"Hello"));
+    QCOMPARE(hello.size(), qsizetype(5));
+    QCOMPARE(hello.length(), qsizetype(5));
+    QCOMPARE(hello.chunkCount(), qsizetype(1));
+    QCOMPARE(hello.toString(), QStringLiteral("Hello"));
+    QCOMPARE(hello.front(), QChar(u'H'));
+    QCOMPARE(hello.back(), QChar(u'o'));
+}
+
+void tst_QRope::sharesString()
+{
+    const QString str = longText(100000);
+    const QRope rope(str);
+    QCOMPARE(rope.chunkBegin()->data(), str.constData());
+    QCOMPARE(rope.toString().constData(), str.constData());
+
+    // large slices keep sharing the data
+    const QRope tail = rope.mid(1000);
+    QCOMPARE(tail.chunkBegin()->data(), str.constData() + 1000);
+
+    // small slices don't hold on to it
+    const QRope word = rope.mid(1000, 10);
+    QVERIFY(word.chunkBegin()->data() != str.constData() + 1000);
+    QCOMPARE(word.toString(), str.mid(1000, 10));
+}
+
+void tst_QRope::insert()
+{
+    QRope rope;
+    rope.insert(0, QStringView(u"world"));
+    rope.prepend(QStringView(u"Hello "));
+    rope.append(QStringView(u"!"));
+    QCOMPARE(rope, QStringView(u"Hello world!"));
+    rope.insert(5, QStringLiteral(","));
+    QCOMPARE(rope, QStringView(u"Hello, world!"));
+    rope.insert(7, QStringView());
+    QCOMPARE(rope, QStringView(u"Hello, world!"));
+
+    const QString large = longText(5000);
+    rope.insert(7, large);
+    QCOMPARE(text(rope), QStringLiteral("Hello, ") + large + QStringLiteral("world!"));
+    rope += QStringLiteral("?");
+    QCOMPARE(rope.back(), QChar(u'?'));
+}
+
+void tst_QRope::insertRope()
+{
+    const QString str = longText(10000);
+    QRope rope = chunked(str, 1000);
+    QCOMPARE(rope.chunkCount(), qsizetype(10));
+
+    const QRope other = chunked(longText(3000), 1000);
+    rope.insert(4500, other);
+    QCOMPARE(text(rope), str.left(4500) + longText(3000) + str.mid(4500));
+
+    // inserting a rope into itself
+    QRope self = chunked(str, 1000);
+    self.insert(2000, self);
+    QCOMPARE(text(self), str.left(2000) + str + str.mid(2000));
+
+    QRope empty;
+    empty.append(other);
+    QCOMPARE(empty, other);
+    empty.append(QRope());
+    QCOMPARE(empty, other);
+}
+
+void tst_QRope::remove_data()
+{
+    QTest::addColumn<int>("pos");
+    QTest::addColumn<int>("len");
+
+    QTest::newRow("start") << 0 << 10;
+    QTest::newRow("middle") << 1500 << 3000;
+    QTest::newRow("inside-chunk") << 2100 << 50;
+    QTest::newRow("chunk-boundary") << 2000 << 1000;
+    QTest::newRow("to-end") << 9000 << 5000;
+    QTest::newRow("everything") << 0 << 10000;
+    QTest::newRow("negative-pos") << -10 << 5;
+    QTest::newRow("past-end") << 10000 << 5;
+    QTest::newRow("zero-length") << 100 << 0;
+    QTest::newRow("negative-length") << 100 << -1;
+}
+
+void tst_QRope::remove()
+{
+    QFETCH(int, pos);
+    QFETCH(int, len);
+
+    QString str = longText(10000);
+    QRope rope = chunked(str, 1000);
+    rope.remove(pos, len);
+    str.remove(pos, len);
+    QCOMPARE(text(rope), str);
+    QCOMPARE(rope.size(), qsizetype(str.size()));
+}
+
+void tst_QRope::replace()
+{
+    QString str = longText(10000);
+    QRope rope = chunked(str, 1000);
+
+    rope.replace(10, 5, QStringView(u"XYZ"));
+    str.replace(10, 5, QStringLiteral("XYZ"));
+    QCOMPARE(text(rope), str);
+
+    rope.replace(900, 300, QStringView(u"across"));
+    str.replace(900, 300, QStringLiteral("across"));
+    QCOMPARE(text(rope), str);
+
+    const QString large = QString(2000, QLatin1Char('L'));
+    rope.replace(5000, 10, large);
+    str.replace(5000, 10, large);
+    QCOMPARE(text(rope), str);
+
+    rope.replace(str.size() - 3, 100, QStringView(u"end"));
+    str.replace(str.size() - 3, 100, QStringLiteral("end"));
+    QCOMPARE(text(rope), str);
+
+    rope.replace(0, rope.size(), QStringView());
+    QVERIFY(rope.isEmpty());
+}
+
+void tst_QRope::mid_data()
+{
+    QTest::addColumn<int>("pos");
+    QTest::addColumn<int>("n");
+
+    QTest::newRow("all") << 0 << -1;
+    QTest::newRow("prefix") << 0 << 1234;
+    QTest::newRow("suffix") << 4321 << -1;
+    QTest::newRow("inside-chunk") << 1100 << 100;
+    QTest::newRow("across-chunks") << 1500 << 6000;
+    QTest::newRow("too-long") << 9000 << 5000;
+    QTest::newRow("empty") << 500 << 0;
+    QTest::newRow("at-end") << 10000 << 10;
+    QTest::newRow("past-end") << 10001 << 10;
+    QTest::newRow("negative-pos") << -100 << 200;
+    QTest::newRow("negative-all") << -100 << -1;
+}
+
+void tst_QRope::mid()
+{
+    QFETCH(int, pos);
+    QFETCH(int, n);
+
+    const QString str = longText(10000);
+    const QRope rope = chunked(str, 1000);
+    const QRope part = rope.mid(pos, n);
+    QCOMPARE(text(part), str.mid(pos, n));
+    QCOMPARE(part.size(), qsizetype(str.mid(pos, n).size()));
+}
+
+void tst_QRope::leftRight()
+{
+    const QString str = longText(10000);
+    const QRope rope = chunked(str, 1000);
+
+    for (int n : { -1, 0, 1, 999, 1000, 5555, 9999, 10000, 20000 }) {
+        QCOMPARE(text(rope.left(n)), str.left(n));
+        QCOMPARE(text(rope.right(n)), str.right(n));
+    }
+}
+
+void tst_QRope::truncateChop()
+{
+    QString str = longText(10000);
+    QRope rope = chunked(str, 1000);
+
+    rope.truncate(20000);
+    QCOMPARE(rope.size(), qsizetype(10000));
+    rope.truncate(7777);
+    str.truncate(7777);
+    QCOMPARE(text(rope), str);
+    rope.chop(-1);
+    QCOMPARE(text(rope), str);
+    rope.chop(2000);
+    str.chop(2000);
+    QCOMPARE(text(rope), str);
+    rope.chop(100000);
+    QVERIFY(rope.isEmpty());
+    rope.truncate(0);
+    QVERIFY(rope.isEmpty());
+
+    rope = chunked(longText(100), 10);
+    rope.clear();
+    QVERIFY(rope.isEmpty());
+    QCOMPARE(rope.chunkCount(), qsizetype(0));
+}
+
+void tst_QRope::at()
+{
+    const QString str = longText(10000);
+    const QRope rope = chunked(str, 1000);
+
+    for (int i = 0; i < str.size(); i += 37)
+        QCOMPARE(rope.at(i), str.at(i));
+    QCOMPARE(rope[9999], str.at(9999));
+
+    qsizetype start = -1;
+    const QStringView chunk = rope.chunkAt(2500, &start);
+    QCOMPARE(start, qsizetype(2000));
+    QCOMPARE(chunk.size(), qsizetype(1000));
+    QCOMPARE(chunk, QStringView(str).mid(2000, 1000));
+    QCOMPARE(rope.chunkAt(0), QStringView(str).left(1000));
+}
+
+void tst_QRope::chunks()
+{
+    const QString str = longText(10000);
+    const QRope rope = chunked(str, 1000);
+
+    int count = 0;
+    qsizetype pos = 0;
+    for (QRope::const_chunk_iterator it = rope.chunkBegin(); it != rope.chunkEnd(); ++it) {
+        QCOMPARE(it->size(), qsizetype(1000));
+        QCOMPARE(*it, QStringView(str).mid(pos, 1000));
+        pos += it->size();
+        ++count;
+    }
+    QCOMPARE(count, 10);
+    QCOMPARE(qsizetype(count), rope.chunkCount());
+    QCOMPARE(std::distance(rope.chunkBegin(), rope.chunkEnd()), qptrdiff(10));
+    QCOMPARE(rope.toString(), str);
+}
+
+void tst_QRope::compare()
+{
+    const QString str = longText(10000);
+    const QRope a = chunked(str, 1000);
+    const QRope b = chunked(str, 777);
+    QVERIFY(a == b);
+    QVERIFY(!(a != b));
+    QVERIFY(a == QStringView(str));
+    QVERIFY(QStringView(str) == b);
+    QVERIFY(a == str);
+
+    QRope c = b;
+    c.replace(5000, 1, QStringView(u"!"));
+    QVERIFY(a != c);
+    QVERIFY(c != QStringView(str));
+    QVERIFY(a != b.left(9999));
+    QVERIFY(QRope() == QStringView());
+    QVERIFY(QRope() == QRope());
+}
+
+void tst_QRope::implicitSharing()
+{
+    const QString str = longText(10000);
+    QRope rope = chunked(str, 1000);
+    const QRope copy = rope;
+
+    rope.insert(5000, QStringView(u"inserted"));
+    rope.remove(100, 2000);
+    rope.replace(0, 10, QStringView(u"replaced"));
+    QCOMPARE(text(copy), str);
+    QVERIFY(rope != copy);
+
+    QRope moved = std::move(rope);
+    QCOMPARE(moved.size(), qsizetype(10000 + 8 - 2000 - 10 + 8));
+    rope = copy;
+    QCOMPARE(rope, copy);
+    rope.swap(moved);
+    QCOMPARE(moved, copy);
+}
+
+void tst_QRope::smallEditsMerge()
+{
+    // typing one character at a time
+    QRope rope;
+    QString str;
+    for (int i = 0; i < 10000; ++i) {
+        const QChar ch(u'a' + i % 26);
+        rope.insert(rope.size() / 2, QStringView(&ch, 1));
+        str.insert(str.size() / 2, ch);
+    }
+    QCOMPARE(text(rope), str);
+    QVERIFY2(rope.chunkCount() < 100, QByteArray::number(qlonglong(rope.chunkCount())));
+
+    // deleting them again
+    while (!rope.isEmpty()) {
+        rope.remove(rope.size() / 3, 1);
+        str.remove(str.size() / 3, 1);
+    }
+    QVERIFY(str.isEmpty());
+}
+
+void tst_QRope::randomEdits()
+{
+    QRandomGenerator rng(20200401);
+    QString str = longText(100000);
+    QRope rope(str);
+
+    for (int i = 0; i < 3000; ++i) {
+        const int size = str.size();
+        const int pos = rng.bounded(size + 1);
+        switch (rng.bounded(4)) {
+        case 0: {
+            const QString inserted = longText(rng.bounded(1, 2000));
+            rope.insert(pos, inserted);
+            str.insert(pos, inserted);
+            break;
+        }
+        case 1: {
+            const int len = rng.bounded(200);
+            rope.remove(pos, len);
+            str.remove(pos, len);
+            break;
+        }
+        case 2: {
+            const int len = rng.bounded(50);
+            rope.replace(pos, len, QStringView(u"replacement"));
+            str.replace(pos, len, QStringLiteral("replacement"));
+            break;
+        }
+        case 3: {
+            const int len = rng.bounded(5000);
+            const QRope part = rope.mid(pos, len);
+            QCOMPARE(part.size(), qsizetype(str.mid(pos, len).size()));
+            rope.append(part);
+            str.append(str.mid(pos, len));
+            break;
+        }
+        }
+        QCOMPARE(rope.size(), qsizetype(str.size()));
+    }
+    QCOMPARE(rope.toString(), str);
+}
+
+QTEST_APPLESS_MAIN(tst_QRope)
+
+#include "tst_qrope.moc"
@@ -0,0 +1,412 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qsmallstring.h>
+
+#include <QHash>
+#include <QVector>
+
+#include <algorithm>
+
+class tst_QSmallString : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void construct_data();
+    void construct();
+    void latin1_data();
+    void latin1();
+    void sharesLargeStrings();
+    void copyAndMove();
+    void swapAndAssign();
+    void conversions();
+    void compare();
+    void hash();
+    void containers();
+
+    void byteArrayConstruct_data();
+    void byteArrayConstruct();
+    void byteArrayCopyAndMove();
+    void byteArrayCompare();
+    void byteArrayHash();
+};
+
+static QString makeString(int size)
+{
+    QString s;
+    for (int i = 0; i < size; ++i)
+        s += QChar(i % 2 ? 0x3b1 + i % 24 : 'a' + i % 26);
+    return s;
+}
+
+void tst_QSmallString::construct_data()
+{
+    QTest::addColumn<QString>("str");
+
+    QTest::newRow("null") << QString();
+    QTest::newRow("empty") << QString(QLatin1String(""));
+    QTest::newRow("one") << makeString(1);
+    QTest::newRow("inline-capacity") << makeString(QSmallString::InlineCapacity);
+    QTest::newRow("inline-capacity+1") << makeString(QSmallString::InlineCapacity + 1);
+    QTest::newRow("long") << makeString(1000);
+}
+
+void tst_QSmallString::construct()
+{
+    QFETCH(QString, str);
+    const bool inlined = str.size() <= QSmallString::InlineCapacity;
+
+    const QSmallString fromString(str);
+    const QSmallString fromView(QStringView{str});
+    const QSmallString fromChars(str.constData(), str.size());
+
+    for (const QSmallString &s : {fromString, fromView, fromChars}) {
+        QCOMPARE(s.size(), qsizetype(str.size()));
+        QCOMPARE(s.isEmpty(), str.isEmpty());
+        QCOMPARE(s.isInline(), inlined);
+        QCOMPARE(s.toString(), str);
+        QVERIFY(std::equal(s.begin(), s.end(), str.begin(), str.end()));
+        QCOMPARE(s.utf16()[s.size()], ushort(0));
+        if (!str.isEmpty()) {
+            QCOMPARE(s.front(), str.front());
+            QCOMPARE(s.back(), str.back());
+            QCOMPARE(s.at(s.size() / 2), str.at(str.size() / 2));
+        }
+    }
+
+    QSmallString cleared = fromString;
+    cleared.clear();
+    QVERIFY(cleared.isEmpty());
+    QVERIFY(cleared.isInline());
+    QCOMPARE(cleared.utf16()[0], ushort(0));
+}
+
+void tst_QSmallString::latin1_data()
+{
+    QTest::addColumn<QByteArray>("latin1");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("short") << QByteArray("caf\xe9");
+    QTest::newRow("inline-capacity") << QByteArray(QSmallString::InlineCapacity, '\xff');
+    QTest::newRow("long") << QByteArray("A rather long Latin-1 string: \xe0\xe9\xee\xf5\xfc");
+}
+
+void tst_QSmallString::latin1()
+{
+    QFETCH(QByteArray, latin1);
+    const QLatin1String view(latin1);
+
+    QSmallString s(view);
+    QCOMPARE(s.toString(), QString(view));
+    QCOMPARE(s.isInline(), latin1.size() <= QSmallString::InlineCapacity);
+    QCOMPARE(s.toLatin1(), latin1);
+    QCOMPARE(s.utf16()[s.size()], ushort(0));
+    QVERIFY(s == view);
+    QVERIFY(view == s);
+
+    s = QLatin1String("x");
+    QCOMPARE(s.toString(), QStringLiteral("x"));
+    s = view;
+    QCOMPARE(s.toString(), QString(view));
+}
+
+void tst_QSmallString::sharesLargeStrings()
+{
+    const QString large = makeString(100);
+    const QSmallString s(large);
+    QVERIFY(!s.isInline());
+    QCOMPARE(s.constData(), large.constData());
+    QCOMPARE(s.toString().constData(), large.constData());
+
+    const QString small = makeString(3);
+    const QSmallString t(small);
+    QVERIFY(t.isInline());
+    QVERIFY(t.constData() != small.constData());
+}
+
+void tst_QSmallString::copyAndMove()
+{
+    for (int size : {0, 5, int(QSmallString::InlineCapacity), 50}) {
+        const QString str = makeString(size);
+        QSmallString s(str);
+
+        QSmallString copy(s);
+        QCOMPARE(copy.toString(), str);
+        QCOMPARE(s.toString(), str);
+        if (!copy.isInline())
+            QCOMPARE(copy.constData(), s.constData());
+
+        QSmallString moved(std::move(copy));
+        QCOMPARE(moved.toString(), str);
+        QVERIFY(copy.isEmpty());
+        QVERIFY(copy.isInline());
+
+        QSmallString assigned;
+        assigned = moved;
+        QCOMPARE(assigned.toString(), str);
+        assigned = std::move(moved);
+        QCOMPARE(assigned.toString(), str);
+        QVERIFY(moved.isEmpty());
+
+    }
+}
+
+void tst_QSmallString::swapAndAssign()
+{
+    const QString shortString = makeString(4);
+    const QString longString = makeString(40);
+
+    QSmallString a(shortString);
+    QSmallString b(longString);
+    a.swap(b);
+    QCOMPARE(a.toString(), longString);
+    QCOMPARE(b.toString(), shortString);
+    qSwap(a, b);
+    QCOMPARE(a.toString(), shortString);
+    QCOMPARE(b.toString(), longString);
+
+    a = longString;
+    QVERIFY(!a.isInline());
+    QCOMPARE(a.toString(), longString);
+    a = shortString;
+    QVERIFY(a.isInline());
+    QCOMPARE(a.toString(), shortString);
+
+    QString temporary = longString;
+    b = std::move(temporary);
+    QCOMPARE(b.constData(), longString.constData());
+}
+
+static qsizetype viewSize(QStringView view)
+{
+    return view.size();
+}
+
+static QString identity(const QString &str)
+{
+    return str;
+}
+
+void tst_QSmallString::conversions()
+{
+    const QString str = makeString(7);
+    const QSmallString s = str;
+
+    QCOMPARE(viewSize(s), qsizetype(7));
+    QCOMPARE(identity(s), str);
+
+    const QStringView view = s;
+    QCOMPARE(view.data(), s.constData());
+    QCOMPARE(view, QStringView(str));
+
+    QString back = s;
+    QCOMPARE(back, str);
+    QCOMPARE(s.toUtf8(), str.toUtf8());
+
+    QString concatenated = QLatin1String("<") + QString(s) + QLatin1String(">");
+    QCOMPARE(concatenated, QLatin1String("<") + str + QLatin1String(">"));
+}
+
+void tst_QSmallString::compare()
+{
+    const QSmallString abc(QLatin1String("abc"));
+    const QSmallString abd(QLatin1String("abd"));
+    const QSmallString longer(QLatin1String("abc, but longer than any inline string"));
+
+    QVERIFY(abc == abc);
+    QVERIFY(abc != abd);
+    QVERIFY(abc < abd);
+    QVERIFY(abc <= abd);
+    QVERIFY(abd > abc);
+    QVERIFY(abd >= abc);
+    QVERIFY(abc < longer);
+    QVERIFY(longer > abc);
+    QVERIFY(QSmallString() < abc);
+
+    const QString abcString = QStringLiteral("abc");
+    QVERIFY(abc == abcString);
+    QVERIFY(abcString == abc);
+    QVERIFY(abd != abcString);
+    QVERIFY(abcString < abd);
+    QVERIFY(abd > abcString);
+
+    QVERIFY(abc == QStringView(u"abc"));
+    QVERIFY(QStringView(u"abd") == abd);
+    QVERIFY(abc < QStringView(u"b"));
+    QVERIFY(QStringView(u"b") > abc);
+
+    QVERIFY(abc == QLatin1String("abc"));
+    QVERIFY(QLatin1String("abc") != abd);
+    QVERIFY(abc <= QLatin1String("abc"));
+    QVERIFY(QLatin1String("abcd") > abc);
+
+    QVERIFY(longer == QSmallString(longer.toString()));
+}
+
+void tst_QSmallString::hash()
+{
+    for (int size : {0, 3, 30}) {
+        const QString str = makeString(size);
+        QCOMPARE(qHash(QSmallString(str)), qHash(str));
+        QCOMPARE(qHash(QSmallString(str), 42U), qHash(str, 42U));
+    }
+
+    QHash<QSmallString, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(QString::number(i), i);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.value(QString::number(i), -1), i);
+    QCOMPARE(hash.value(QStringLiteral("100"), -1), -1);
+}
+
+void tst_QSmallString::containers()
+{
+    // growing the vector relocates the strings
+    QVector<QSmallString> vector;
+    QStringList expected;
+    for (int i = 0; i < 200; ++i) {
+        const QString str = makeString(i % 20);
+        vector.append(str);
+        expected.append(str);
+    }
+    for (int i = 0; i < vector.size(); ++i)
+        QCOMPARE(vector.at(i).toString(), expected.at(i));
+
+    std::sort(vector.begin(), vector.end());
+    std::sort(expected.begin(), expected.end());
+    for (int i = 0; i < vector.size(); ++i)
+        QCOMPARE(vector.at(i).toString(), expected.at(i));
+}
+
+void tst_QSmallString::byteArrayConstruct_data()
+{
+    QTest::addColumn<QByteArray>("ba");
+
+    QTest::newRow("null") << QByteArray();
+    QTest::newRow("empty") << QByteArray("");
+    QTest::newRow("embedded-nul") << QByteArray("a\0b", 3);
+    QTest::newRow("inline-capacity") << QByteArray(QSmallByteArray::InlineCapacity, 'x');
+    QTest::newRow("inline-capacity+1") << QByteArray(QSmallByteArray::InlineCapacity + 1, 'y');
+    QTest::newRow("long") << QByteArray(1000, 'z');
+}
+
+void tst_QSmallString::byteArrayConstruct()
+{
+    QFETCH(QByteArray, ba);
+    const bool inlined = ba.size() <= QSmallByteArray::InlineCapacity;
+
+    const QSmallByteArray fromByteArray(ba);
+    const QSmallByteArray fromData(ba.constData(), ba.size());
+
+    for (const QSmallByteArray &s : {fromByteArray, fromData}) {
+        QCOMPARE(s.size(), qsizetype(ba.size()));
+        QCOMPARE(s.isInline(), inlined);
+        QCOMPARE(s.toByteArray(), ba);
+        QCOMPARE(s.constData()[s.size()], '\0');
+        QVERIFY(std::equal(s.begin(), s.end(), ba.begin(), ba.end()));
+    }
+
+    const QSmallByteArray fromCString("hello");
+    QCOMPARE(fromCString.size(), qsizetype(5));
+    QCOMPARE(fromCString.toByteArray(), QByteArray("hello"));
+    QVERIFY(QSmallByteArray(nullptr).isEmpty());
+
+    if (!inlined)
+        QCOMPARE(fromByteArray.constData(), ba.constData());
+}
+
+void tst_QSmallString::byteArrayCopyAndMove()
+{
+    for (int size : {0, 7, int(QSmallByteArray::InlineCapacity), 64}) {
+        const QByteArray ba(size, 'q');
+        QSmallByteArray s(ba);
+
+        QSmallByteArray copy(s);
+        QCOMPARE(copy.toByteArray(), ba);
+        QSmallByteArray moved(std::move(copy));
+        QCOMPARE(moved.toByteArray(), ba);
+        QVERIFY(copy.isEmpty());
+
+        QSmallByteArray other("other");
+        other.swap(moved);
+        QCOMPARE(other.toByteArray(), ba);
+        QCOMPARE(moved.toByteArray(), QByteArray("other"));
+
+        other = moved;
+        QCOMPARE(other.toByteArray(), QByteArray("other"));
+        other = ba;
+        QCOMPARE(QByteArray(other), ba);
+    }
+}
+
+void tst_QSmallString::byteArrayCompare()
+{
+    const QSmallByteArray abc("abc");
+    const QSmallByteArray abd("abd");
+    const QSmallByteArray withNul("abc\0", 4);
+
+    QVERIFY(abc == abc);
+    QVERIFY(abc != abd);
+    QVERIFY(abc < abd);
+    QVERIFY(abd >= abc);
+    QVERIFY(abc != withNul);
+    QVERIFY(abc < withNul);
+    QVERIFY(QSmallByteArray() < abc);
+    QVERIFY(QSmallByteArray("\xff") > abc);
+
+    QVERIFY(abc == QByteArray("abc"));
+    QVERIFY(QByteArray("abc") == abc);
+    QVERIFY(QByteArray("abd") > abc);
+    QVERIFY(abc <= QByteArray("abc"));
+
+    QVERIFY(abc == "abc");
+    QVERIFY("abd" == abd);
+    QVERIFY(abc < "abd");
+    QVERIFY("b" > abd);
+    QVERIFY(QSmallByteArray() == static_cast<const char *>(nullptr));
+}
+
+void tst_QSmallString::byteArrayHash()
+{
+    for (int size : {0, 3, 30}) {
+        const QByteArray ba(size, 'h');
+        QCOMPARE(qHash(QSmallByteArray(ba)), qHash(ba));
+        QCOMPARE(qHash(QSmallByteArray(ba), 7U), qHash(ba, 7U));
+    }
+
+    QHash<QSmallByteArray, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(QByteArray::number(i), i);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.value(QByteArray::number(i), -1), i);
+}
+
+QTEST_APPLESS_MAIN(tst_QSmallString)
+#include "tst_qsmallstring.moc"
@@ -38,6 +38,10 @@ private slots:
     void caseSensitivity();
     void indexIn_data();
     void indexIn();
+    void indexInLong_data();
+    void indexInLong();
+    void indexInLatin1_data();
+    void indexInLatin1();
     void setCaseSensitivity_data();
     void setCaseSensitivity();
     void assignOperator();
@@ -107,6 +111,88 @@ void tst_QStringMatcher::indexIn()
     QCOMPARE(matcherSV.indexIn(QStringView(haystack), from), indexIn);
 }
 
+void tst_QStringMatcher::indexInLong_data()
+{
+    QTest::addColumn<QString>("needle");
+    QTest::addColumn<QString>("haystack");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+    QTest::addColumn<int>("indexIn");
+
+    // around the boundaries of the vectors compared at once
+    for (int pos : {0, 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 100, 196, 197}) {
+        QString haystack(200, QLatin1Char('a'));
+        haystack.replace(pos, 3, QLatin1String("bab"));
+        QTest::addRow("boundary-%d", pos) << QString("bab") << haystack << Qt::CaseSensitive << pos;
+        QTest::addRow("boundary-ci-%d", pos) << QString("BaB") << haystack << Qt::CaseInsensitive << pos;
+    }
+
+    const QString x(100, QLatin1Char('x'));
+    QTest::newRow("first-and-last-only") << QString("abcd") << x + "abxd" + x + "abcd" << Qt::CaseSensitive << 204;
+    QTest::newRow("no-match") << QString("abcd") << x + "abc" << Qt::CaseSensitive << -1;
+    QTest::newRow("ci-ascii") << QString("hello") << x + "HeLLo" << Qt::CaseInsensitive << 100;
+    QTest::newRow("ci-sensitive") << QString("hello") << x + "HeLLo" << Qt::CaseSensitive << -1;
+    QTest::newRow("ci-non-ascii") << QString::fromUtf8("\xc3\xa9t\xc3\xa9") << x + QString::fromUtf8("\xc3\x89T\xc3\x89")
+                                  << Qt::CaseInsensitive << 100;
+    // U+212A KELVIN SIGN and U+017F LATIN SMALL LETTER LONG S fold to ASCII letters
+    QTest::newRow("ci-kelvin-haystack") << QString("kelvin") << x + QString::fromUtf8("\xe2\x84\xaa") + "elvin"
+                                        << Qt::CaseInsensitive << 100;
+    QTest::newRow("ci-kelvin-needle") << QString::fromUtf8("\xe2\x84\xaa") + "elvin" << x + "KELVIN"
+                                      << Qt::CaseInsensitive << 100;
+    QTest::newRow("ci-long-s") << QString("ss") << x + QString::fromUtf8("\xc5\xbf") + "S"
+                               << Qt::CaseInsensitive << 100;
+    QTest::newRow("ci-long-s-last") << QString("fuss") << x + "FUS" + QString::fromUtf8("\xc5\xbf")
+                                    << Qt::CaseInsensitive << 100;
+}
+
+void tst_QStringMatcher::indexInLong()
+{
+    QFETCH(QString, needle);
+    QFETCH(QString, haystack);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(int, indexIn);
+
+    QStringMatcher matcher(needle, cs);
+    QCOMPARE(matcher.indexIn(haystack), indexIn);
+    QCOMPARE(haystack.indexOf(needle, 0, cs), indexIn);
+    if (indexIn >= 0) {
+        QCOMPARE(matcher.indexIn(haystack, indexIn), indexIn);
+        QCOMPARE(matcher.indexIn(haystack, indexIn + 1), -1);
+        QCOMPARE(haystack.indexOf(needle, indexIn + 1, cs), -1);
+    }
+}
+
+void tst_QStringMatcher::indexInLatin1_data()
+{
+    QTest::addColumn<QByteArray>("needle");
+    QTest::addColumn<QByteArray>("haystack");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+    QTest::addColumn<int>("indexIn");
+
+    const QByteArray x(100, 'x');
+    QTest::newRow("ascii") << QByteArray("hello") << x + "hello" << Qt::CaseSensitive << 100;
+    QTest::newRow("ascii-ci") << QByteArray("hello") << x + "HeLLo" << Qt::CaseInsensitive << 100;
+    QTest::newRow("ascii-cs") << QByteArray("hello") << x + "HeLLo" << Qt::CaseSensitive << -1;
+    QTest::newRow("latin1-ci") << QByteArray("\xe9t\xe9") << x + "\xc9T\xc9" << Qt::CaseInsensitive << 100;
+    QTest::newRow("latin1-cs") << QByteArray("\xe9t\xe9") << x + "\xc9T\xc9" << Qt::CaseSensitive << -1;
+    // MULTIPLICATION SIGN and DIVISION SIGN are not a case pair
+    QTest::newRow("latin1-not-letters") << QByteArray("a\xd7") << x + "A\xf7" << Qt::CaseInsensitive << -1;
+    QTest::newRow("latin1-no-upper") << QByteArray("\xdf\xff") << x + "\xdf\xff" << Qt::CaseInsensitive << 100;
+}
+
+void tst_QStringMatcher::indexInLatin1()
+{
+    QFETCH(QByteArray, needle);
+    QFETCH(QByteArray, haystack);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(int, indexIn);
+
+    const QLatin1String n(needle);
+    const QLatin1String h(haystack);
+    QCOMPARE(h.indexOf(n, 0, cs), indexIn);
+    QCOMPARE(QString(h).indexOf(QString(n), 0, cs), indexIn);
+    QCOMPARE(QString(h).indexOf(n, 0, cs), indexIn);
+}
+
 void tst_QStringMatcher::setCaseSensitivity_data()
 {
     QTest::addColumn<QString>("needle");
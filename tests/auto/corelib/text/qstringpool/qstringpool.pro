@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qstringpool
+QT = core testlib
+SOURCES = tst_qstringpool.cpp
@@ -0,0 +1,257 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qstringpool.h>
+
+#include <QThread>
+#include <QVector>
+
+#include <memory>
+#include <vector>
+
+class tst_QStringPool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void intern();
+    void internLatin1();
+    void internKeepsOriginal();
+    void emptyStrings();
+    void detachFromPool();
+    void manyStrings();
+    void maxSize();
+    void clear();
+    void threads();
+
+    void byteArrayIntern();
+    void byteArrayMaxSize();
+};
+
+void tst_QStringPool::intern()
+{
+    QStringPool pool;
+    QCOMPARE(pool.size(), qsizetype(0));
+    QCOMPARE(pool.maxSize(), qsizetype(-1));
+    QVERIFY(!pool.contains(u"id"));
+
+    const QString first = pool.intern(QStringView(u"id"));
+    QCOMPARE(first, QStringLiteral("id"));
+    QCOMPARE(pool.size(), qsizetype(1));
+    QVERIFY(pool.contains(u"id"));
+
+    const QString text = QStringLiteral("{\"id\": 1}");
+    const QString second = pool.intern(QStringView(text).mid(2, 2));
+    QCOMPARE(second, first);
+    QCOMPARE(second.constData(), first.constData());
+    QCOMPARE(pool.size(), qsizetype(1));
+
+    const QString other = pool.intern(QStringView(u"name"));
+    QVERIFY(other.constData() != first.constData());
+    QCOMPARE(pool.size(), qsizetype(2));
+}
+
+void tst_QStringPool::internLatin1()
+{
+    QStringPool pool;
+    const QString fromUtf16 = pool.intern(QStringView(u"Content-Type"));
+    const QString fromLatin1 = pool.intern(QLatin1String("Content-Type"));
+    QCOMPARE(fromLatin1.constData(), fromUtf16.constData());
+    QVERIFY(pool.contains(QLatin1String("Content-Type")));
+
+    const QString accented = pool.intern(QLatin1String("caf\xe9"));
+    QCOMPARE(accented, QString(QLatin1String("caf\xe9")));
+    QCOMPARE(pool.intern(accented).constData(), accented.constData());
+    QVERIFY(!pool.contains(QLatin1String("cafe")));
+}
+
+void tst_QStringPool::internKeepsOriginal()
+{
+    QStringPool pool;
+    const QString original = QString::number(12345);
+    const QString interned = pool.intern(original);
+    QCOMPARE(interned.constData(), original.constData());
+
+    const QString copy = QString::number(12345);
+    QCOMPARE(pool.intern(copy).constData(), original.constData());
+}
+
+void tst_QStringPool::emptyStrings()
+{
+    QStringPool pool;
+    QVERIFY(pool.intern(QStringView()).isEmpty());
+    QVERIFY(pool.intern(QString()).isNull());
+    QVERIFY(pool.intern(QLatin1String("")).isEmpty());
+    QCOMPARE(pool.size(), qsizetype(0));
+    QVERIFY(!pool.contains(QStringView()));
+}
+
+void tst_QStringPool::detachFromPool()
+{
+    QStringPool pool;
+    QString str = pool.intern(QStringView(u"key"));
+    str[0] = QLatin1Char('K');
+    QCOMPARE(str, QStringLiteral("Key"));
+    QCOMPARE(pool.intern(QStringView(u"key")), QStringLiteral("key"));
+    QVERIFY(!pool.contains(u"Key"));
+}
+
+void tst_QStringPool::manyStrings()
+{
+    QStringPool pool;
+    QVector<QString> interned;
+    for (int i = 0; i < 10000; ++i)
+        interned.append(pool.intern(QString::number(i)));
+    QCOMPARE(pool.size(), qsizetype(10000));
+
+    for (int i = 0; i < 10000; ++i) {
+        const QString key = QString::number(i);
+        const QString again = pool.intern(QStringView(key));
+        QCOMPARE(again, key);
+        QCOMPARE(again.constData(), interned.at(i).constData());
+    }
+    QCOMPARE(pool.size(), qsizetype(10000));
+}
+
+void tst_QStringPool::maxSize()
+{
+    QStringPool pool(2);
+    QCOMPARE(pool.maxSize(), qsizetype(2));
+
+    const QString a = pool.intern(QStringView(u"a"));
+    const QString b = pool.intern(QStringView(u"b"));
+    const QString c = pool.intern(QStringView(u"c"));
+    QCOMPARE(c, QStringLiteral("c"));
+    QCOMPARE(pool.size(), qsizetype(2));
+    QVERIFY(!pool.contains(u"c"));
+    QVERIFY(pool.intern(QStringView(u"c")).constData() != c.constData());
+
+    // strings that are pooled already are still found
+    QCOMPARE(pool.intern(QStringView(u"a")).constData(), a.constData());
+
+    pool.setMaxSize(-1);
+    QCOMPARE(pool.maxSize(), qsizetype(-1));
+    pool.intern(QStringView(u"c"));
+    QVERIFY(pool.contains(u"c"));
+
+    pool.setMaxSize(1);
+    QCOMPARE(pool.size(), qsizetype(3));
+    pool.intern(QStringView(u"d"));
+    QCOMPARE(pool.size(), qsizetype(3));
+}
+
+void tst_QStringPool::clear()
+{
+    QStringPool pool;
+    const QString kept = pool.intern(QStringView(u"kept"));
+    pool.clear();
+    QCOMPARE(pool.size(), qsizetype(0));
+    QVERIFY(!pool.contains(u"kept"));
+    QCOMPARE(kept, QStringLiteral("kept"));
+
+    const QString again = pool.intern(QStringView(u"kept"));
+    QVERIFY(again.constData() != kept.constData());
+    QCOMPARE(pool.size(), qsizetype(1));
+}
+
+void tst_QStringPool::threads()
+{
+    enum { ThreadCount = 8, KeyCount = 500, Rounds = 20 };
+    QStringPool pool;
+    QVector<QVector<QString> > results(ThreadCount);
+
+    std::vector<std::unique_ptr<QThread> > threads;
+    for (int t = 0; t < ThreadCount; ++t) {
+        QVector<QString> *result = &results[t];
+        threads.emplace_back(QThread::create([&pool, result, t] {
+            result->resize(KeyCount);
+            for (int round = 0; round < Rounds; ++round) {
+                for (int i = 0; i < KeyCount; ++i) {
+                    // each thread walks the keys in a different order
+                    const int key = (i * 7 + t * 61) % KeyCount;
+                    const QString name = QLatin1String("key-") + QString::number(key);
+                    (*result)[key] = pool.intern(QStringView(name));
+                }
+            }
+        }));
+        threads.back()->start();
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+
+    QCOMPARE(pool.size(), qsizetype(KeyCount));
+    for (int i = 0; i < KeyCount; ++i) {
+        QCOMPARE(results.at(0).at(i), QLatin1String("key-") + QString::number(i));
+        for (int t = 1; t < ThreadCount; ++t)
+            QCOMPARE(results.at(t).at(i).constData(), results.at(0).at(i).constData());
+    }
+}
+
+void tst_QStringPool::byteArrayIntern()
+{
+    QByteArrayPool pool;
+    const QByteArray header("Content-Length: 12\r\nContent-Type: text/plain\r\n");
+
+    const QByteArray first = pool.intern(header.constData(), 14);
+    QCOMPARE(first, QByteArray("Content-Length"));
+    const QByteArray second = pool.intern(QByteArray("Content-Length"));
+    QCOMPARE(second.constData(), first.constData());
+    QVERIFY(pool.contains(QByteArray("Content-Length")));
+    QVERIFY(!pool.contains(QByteArray("Content-Type")));
+    QCOMPARE(pool.size(), qsizetype(1));
+
+    const QByteArray withNul("a\0b", 3);
+    QCOMPARE(pool.intern(withNul).constData(), withNul.constData());
+    QVERIFY(pool.contains("a\0b", 3));
+    QVERIFY(!pool.contains("a", 1));
+
+    QVERIFY(pool.intern(nullptr, 0).isEmpty());
+    QCOMPARE(pool.size(), qsizetype(2));
+
+    pool.clear();
+    QCOMPARE(pool.size(), qsizetype(0));
+    QCOMPARE(first, QByteArray("Content-Length"));
+}
+
+void tst_QStringPool::byteArrayMaxSize()
+{
+    QByteArrayPool pool(1);
+    pool.intern("one", 3);
+    const QByteArray two = pool.intern("two", 3);
+    QCOMPARE(two, QByteArray("two"));
+    QCOMPARE(pool.size(), qsizetype(1));
+    QVERIFY(!pool.contains("two", 3));
+
+    pool.setMaxSize(2);
+    pool.intern("two", 3);
+    QVERIFY(pool.contains("two", 3));
+}
+
+QTEST_APPLESS_MAIN(tst_QStringPool)
+#include "tst_qstringpool.moc"
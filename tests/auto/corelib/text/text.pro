@@ -9,8 +9,12 @@ SUBDIRS = \
     qcollator \
     qlatin1string \
     qlocale \
+    qmultibytearraymatcher \
+    qmultistringmatcher \
     qregexp \
     qregularexpression \
+    qrope \
+    qsmallstring \
     qstring \
     qstring_no_cast_from_bytearray \
     qstringapisymmetry \
@@ -18,6 +22,7 @@ SUBDIRS = \
     qstringiterator \
     qstringlist \
     qstringmatcher \
+    qstringpool \
     qstringref \
     qstringview \
     qtextboundaryfinder
@@ -88,6 +88,52 @@ private slots:
     void countingTest();
     void limitedReaders();
     void deleteOnUnlock();
+    void timedWriteLockWakesReaders();
+
+/*
+    A reader holds the lock, a writer waits for it with a timeout, and a
+    second reader queues behind the writer. When the writer gives up, the
+    second reader gets the lock, while the first one still holds it.
+*/
+void tst_QReadWriteLock::timedWriteLockWakesReaders()
+{
+    QReadWriteLock testLock;
+    testLock.lockForRead();
+
+    QAtomicInt writerResult(-1);
+    QScopedPointer<QThread> writer(QThread::create([&] {
+        writerResult.storeRelaxed(testLock.tryLockForWrite(1000));
+    }));
+    writer->start();
+
+    // a waiting writer makes new readers wait as well
+    const auto readersWait = [&testLock] {
+        if (!testLock.tryLockForRead())
+            return true;
+        testLock.unlock();
+        return false;
+    };
+    QTRY_VERIFY(readersWait());
+
+    QAtomicInt readerLocked(0);
+    QScopedPointer<QThread> reader(QThread::create([&] {
+        testLock.lockForRead();
+        readerLocked.storeRelaxed(1);
+        testLock.unlock();
+    }));
+    reader->start();
+    QThread::msleep(100);
+    QCOMPARE(readerLocked.loadRelaxed(), 0);
+
+    QVERIFY(writer->wait());
+    QCOMPARE(writerResult.loadRelaxed(), 0);
+    QVERIFY(reader->wait(5000));
+    QCOMPARE(readerLocked.loadRelaxed(), 1);
+
+    testLock.unlock();
+    QVERIFY(testLock.tryLockForWrite());
+    testLock.unlock();
+}
 
 /*
     Performance tests
@@ -98,6 +144,7 @@ private slots:
     // recursive locking tests
     void recursiveReadLock();
     void recursiveWriteLock();
+    void recursionMode();
 };
 
 void tst_QReadWriteLock::constructDestruct()
@@ -1107,6 +1154,61 @@ void tst_QReadWriteLock::recursiveWriteLock()
     QVERIFY(thread.wait());
 }
 
+// The recursion mode is recorded next to the state of the lock, so check
+// that each kind of lock behaves according to its own mode.
+void tst_QReadWriteLock::recursionMode()
+{
+    QReadWriteLock plain;
+    QVERIFY(plain.tryLockForWrite());
+    QVERIFY(!plain.tryLockForWrite());
+    QVERIFY(!plain.tryLockForRead());
+    plain.unlock();
+    QVERIFY(plain.tryLockForRead());
+    QVERIFY(plain.tryLockForRead());
+    QVERIFY(!plain.tryLockForWrite());
+    plain.unlock();
+    plain.unlock();
+    QVERIFY(plain.tryLockForWrite());
+    plain.unlock();
+
+    QReadWriteLock recursive(QReadWriteLock::Recursive);
+    QVERIFY(recursive.tryLockForWrite());
+    QVERIFY(recursive.tryLockForWrite(10));
+
+    QAtomicInt otherResult(-1);
+    const auto tryFromOtherThread = [&](bool write) {
+        QScopedPointer<QThread> thread(QThread::create([&] {
+            const bool locked = write ? recursive.tryLockForWrite(10) : recursive.tryLockForRead(10);
+            if (locked)
+                recursive.unlock();
+            otherResult.storeRelaxed(locked);
+        }));
+        thread->start();
+        thread->wait();
+        return otherResult.loadRelaxed() == 1;
+    };
+    QVERIFY(!tryFromOtherThread(true));
+    QVERIFY(!tryFromOtherThread(false));
+
+    // QWaitCondition can only release a lock that is locked once
+    QWaitCondition cond;
+    QTest::ignoreMessage(QtWarningMsg, "QWaitCondition: cannot wait on QReadWriteLocks with recursive lockForWrite()");
+    QVERIFY(!cond.wait(&recursive, 10));
+    recursive.unlock();
+    QVERIFY(!cond.wait(&recursive, 10));
+    QVERIFY(!tryFromOtherThread(false));
+    recursive.unlock();
+
+    QVERIFY(tryFromOtherThread(true));
+    QVERIFY(recursive.tryLockForRead());
+    QVERIFY(recursive.tryLockForRead());
+    QVERIFY(tryFromOtherThread(false));
+    QVERIFY(!tryFromOtherThread(true));
+    recursive.unlock();
+    recursive.unlock();
+    QVERIFY(tryFromOtherThread(true));
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 
 #include "tst_qreadwritelock.moc"
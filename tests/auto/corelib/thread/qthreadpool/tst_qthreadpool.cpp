@@ -102,6 +102,12 @@ private slots:
     void stressTest();
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
+    void workStealing_data();
+    void workStealing();
+    void workStealingPriority();
+    void workStealingClearAndTake_data();
+    void workStealingClearAndTake();
+    void workStealingWaitForDoneWhileStarting();
 
 private:
     QMutex m_functionTestMutex;
@@ -1348,5 +1354,164 @@ void tst_QThreadPool::waitForDoneAfterTake()
 
 }
 
+void tst_QThreadPool::workStealing_data()
+{
+    QTest::addColumn<int>("maxThreadCount");
+    QTest::newRow("1") << 1;
+    QTest::newRow("2") << 2;
+    QTest::newRow("8") << 8;
+}
+
+void tst_QThreadPool::workStealing()
+{
+    class SplitTask : public QRunnable
+    {
+    public:
+        QThreadPool *pool;
+        int depth;
+        SplitTask(QThreadPool *pool, int depth) : pool(pool), depth(depth) {}
+        void run()
+        {
+            if (depth == 0) {
+                count.ref();
+                return;
+            }
+            pool->start(new SplitTask(pool, depth - 1));
+            pool->start(new SplitTask(pool, depth - 1));
+        }
+    };
+
+    QFETCH(int, maxThreadCount);
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(maxThreadCount);
+    QVERIFY(!threadPool.isWorkStealingEnabled());
+    threadPool.setWorkStealingEnabled(true);
+    QVERIFY(threadPool.isWorkStealingEnabled());
+
+    for (int i = 0; i < 10; ++i) {
+        count.storeRelaxed(0);
+        threadPool.start(new SplitTask(&threadPool, 12));
+        QVERIFY(threadPool.waitForDone());
+        QCOMPARE(count.loadRelaxed(), 1 << 12);
+    }
+}
+
+void tst_QThreadPool::workStealingPriority()
+{
+    class Holder : public QRunnable
+    {
+    public:
+        QSemaphore &sem;
+        Holder(QSemaphore &sem) : sem(sem) {}
+        void run()
+        {
+            sem.acquire();
+        }
+    };
+    class Runner : public QRunnable
+    {
+    public:
+        QAtomicPointer<QRunnable> &ptr;
+        Runner(QAtomicPointer<QRunnable> &ptr) : ptr(ptr) {}
+        void run()
+        {
+            ptr.testAndSetRelaxed(0, this);
+        }
+    };
+
+    QSemaphore sem;
+    QAtomicPointer<QRunnable> firstStarted;
+    QRunnable *expected;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+    threadPool.setWorkStealingEnabled(true);
+
+    // the runners with the default priority are handed to the busy
+    // worker, the one with a higher priority has to overtake them
+    threadPool.start(new Holder(sem));
+    for (int i = 0; i < 3; ++i)
+        threadPool.start(new Runner(firstStarted));
+    threadPool.start(expected = new Runner(firstStarted), 1);
+
+    sem.release();
+    QVERIFY(threadPool.waitForDone());
+    QCOMPARE(firstStarted.loadRelaxed(), expected);
+}
+
+void tst_QThreadPool::workStealingClearAndTake_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::newRow("2") << 2;
+    QTest::newRow("300") << 300;
+}
+
+void tst_QThreadPool::workStealingClearAndTake()
+{
+    QFETCH(int, threadCount);
+    QSemaphore sem;
+    class BlockingRunnable : public QRunnable
+    {
+    public:
+        QSemaphore &sem;
+        BlockingRunnable(QSemaphore &sem) : sem(sem) {}
+        void run()
+        {
+            sem.acquire();
+            count.ref();
+        }
+    };
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    threadPool.setWorkStealingEnabled(true);
+    count.storeRelaxed(0);
+
+    for (int i = 0; i < threadCount; ++i)
+        threadPool.start(new BlockingRunnable(sem));
+
+    QRunnable *taken = createTask(noSleepTestFunction);
+    taken->setAutoDelete(false);
+    threadPool.start(taken);
+    for (int i = 0; i < 8; ++i)
+        threadPool.start(new BlockingRunnable(sem));
+
+    QVERIFY(threadPool.tryTake(taken));
+    delete taken;
+    threadPool.clear();
+
+    sem.release(threadCount);
+    QVERIFY(threadPool.waitForDone());
+    QCOMPARE(count.loadRelaxed(), threadCount);
+}
+
+void tst_QThreadPool::workStealingWaitForDoneWhileStarting()
+{
+    // waitForDone() deletes the threads while another thread keeps
+    // queuing runnables that get handed to busy workers
+    class CountingRunnable : public QRunnable
+    {
+    public:
+        void run() { count.ref(); }
+    };
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(2);
+    threadPool.setWorkStealingEnabled(true);
+    count.storeRelaxed(0);
+
+    const int runs = 5000;
+    QScopedPointer<QThread> starter(QThread::create([&threadPool, runs]() {
+        for (int i = 0; i < runs; ++i)
+            threadPool.start(new CountingRunnable);
+    }));
+    starter->start();
+    while (!starter->isFinished())
+        threadPool.waitForDone(1);
+    starter->wait();
+
+    QVERIFY(threadPool.waitForDone());
+    QCOMPARE(count.loadRelaxed(), runs);
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
@@ -0,0 +1,4 @@
+CONFIG += testcase
+TARGET = tst_qflathash
+QT = core testlib
+SOURCES = tst_qflathash.cpp
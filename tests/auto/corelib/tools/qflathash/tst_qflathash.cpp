@@ -0,0 +1,473 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qflathash.h>
+#include <qflatset.h>
+#include <qhash.h>
+
+class tst_QFlatHash : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insertAndLookup();
+    void operator_bracket();
+    void operator_bracketGrowing();
+    void remove();
+    void take();
+    void eraseWhileIterating();
+    void iterators();
+    void implicitSharing();
+    void reserveAndSqueeze();
+    void heterogeneousLookup();
+    void compare();
+    void rangeConstructor();
+    void manyItems_data();
+    void manyItems();
+    void nonTrivialValues();
+
+    void set();
+    void setOperations();
+    void setHeterogeneousLookup();
+};
+
+struct Tracked
+{
+    static int count;
+    int value;
+
+    Tracked(int v = 0) : value(v) { ++count; }
+    Tracked(const Tracked &other) : value(other.value) { ++count; }
+    ~Tracked() { --count; }
+    Tracked &operator=(const Tracked &other) { value = other.value; return *this; }
+    bool operator==(const Tracked &other) const { return value == other.value; }
+};
+
+int Tracked::count = 0;
+
+inline uint qHash(const Tracked &t, uint seed = 0) { return qHash(t.value, seed); }
+
+// Keys whose hashes all collide, to exercise long probe sequences
+struct Colliding
+{
+    int value;
+    bool operator==(const Colliding &other) const { return value == other.value; }
+};
+
+inline uint qHash(Colliding, uint = 0) { return 42; }
+
+void tst_QFlatHash::insertAndLookup()
+{
+    QFlatHash<int, QString> hash;
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.size(), 0);
+    QCOMPARE(hash.capacity(), 0);
+    QVERIFY(!hash.contains(1));
+    QCOMPARE(hash.value(1), QString());
+    QCOMPARE(hash.value(1, "default"), QString("default"));
+    QVERIFY(hash.find(1) == hash.end());
+
+    QFlatHash<int, QString>::iterator it = hash.insert(1, "one");
+    QCOMPARE(it.key(), 1);
+    QCOMPARE(it.value(), QString("one"));
+    hash.insert(2, "two");
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value(1), QString("one"));
+    QCOMPARE(hash.value(2), QString("two"));
+
+    hash.insert(1, "uno");
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value(1), QString("uno"));
+    QCOMPARE(hash.constFind(2).value(), QString("two"));
+}
+
+void tst_QFlatHash::operator_bracket()
+{
+    QFlatHash<QString, int> hash;
+    hash["a"] = 1;
+    ++hash["a"];
+    ++hash["b"];
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value("a"), 2);
+    QCOMPARE(hash.value("b"), 1);
+
+    const QFlatHash<QString, int> &constHash = hash;
+    QCOMPARE(constHash["c"], 0);
+    QCOMPARE(hash.size(), 2);
+}
+
+void tst_QFlatHash::operator_bracketGrowing()
+{
+    QFlatHash<int, QString> hash;
+    for (int i = 0; i < 1000; ++i) {
+        hash[i] = QString::number(i);
+        QCOMPARE(hash.size(), i + 1);
+    }
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.value(i), QString::number(i));
+
+    QFlatHash<int, int> counts;
+    for (int i = 0; i < 1000; ++i)
+        ++counts[i];
+    QCOMPARE(counts.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(counts.value(i), 1);
+}
+
+void tst_QFlatHash::remove()
+{
+    QFlatHash<int, int> hash;
+    QVERIFY(!hash.remove(1));
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i * 10);
+    for (int i = 0; i < 100; i += 2)
+        QVERIFY(hash.remove(i));
+    QVERIFY(!hash.remove(0));
+    QCOMPARE(hash.size(), 50);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.contains(i), i % 2 == 1);
+
+    // reuse the slots of the removed items
+    for (int i = 0; i < 100; i += 2)
+        hash.insert(i, -i);
+    QCOMPARE(hash.size(), 100);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.value(i), i % 2 ? i * 10 : -i);
+}
+
+void tst_QFlatHash::take()
+{
+    QFlatHash<int, QString> hash;
+    hash.insert(1, "one");
+    hash.insert(2, "two");
+    QCOMPARE(hash.take(1), QString("one"));
+    QCOMPARE(hash.take(1), QString());
+    QCOMPARE(hash.size(), 1);
+    QVERIFY(!hash.contains(1));
+}
+
+void tst_QFlatHash::eraseWhileIterating()
+{
+    QFlatHash<int, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+
+    int visited = 0;
+    for (auto it = hash.begin(); it != hash.end(); ) {
+        ++visited;
+        if (it.key() % 3 == 0)
+            it = hash.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(visited, 1000);
+    QCOMPARE(hash.size(), 1000 - 334);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.contains(i), i % 3 != 0);
+}
+
+void tst_QFlatHash::iterators()
+{
+    QFlatHash<int, int> hash;
+    QVERIFY(hash.begin() == hash.end());
+    QVERIFY(hash.constBegin() == hash.constEnd());
+
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i);
+
+    QSet<int> seen;
+    for (auto it = hash.constBegin(); it != hash.constEnd(); ++it) {
+        QCOMPARE(it.key(), *it);
+        seen.insert(it.key());
+    }
+    QCOMPARE(seen.size(), 100);
+
+    for (auto it = hash.begin(); it != hash.end(); ++it)
+        it.value() *= 2;
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.value(i), 2 * i);
+
+    QSet<int> keys;
+    for (auto it = hash.keyBegin(); it != hash.keyEnd(); ++it)
+        keys.insert(*it);
+    QCOMPARE(keys, seen);
+
+    QList<int> keyList = hash.keys();
+    QList<int> valueList = hash.values();
+    QCOMPARE(keyList.size(), 100);
+    for (int i = 0; i < keyList.size(); ++i)
+        QCOMPARE(valueList.at(i), 2 * keyList.at(i));
+}
+
+void tst_QFlatHash::implicitSharing()
+{
+    QFlatHash<int, int> hash;
+    hash.insert(1, 1);
+    QFlatHash<int, int> copy = hash;
+    QVERIFY(copy.isSharedWith(hash));
+    QVERIFY(!hash.isDetached());
+
+    copy.insert(2, 2);
+    QVERIFY(!copy.isSharedWith(hash));
+    QVERIFY(hash.isDetached());
+    QCOMPARE(hash.size(), 1);
+    QCOMPARE(copy.size(), 2);
+
+    copy = hash;
+    copy.remove(1);
+    QCOMPARE(hash.size(), 1);
+    QVERIFY(copy.isEmpty());
+
+    copy = hash;
+    *copy.begin() = 10;
+    QCOMPARE(hash.value(1), 1);
+    QCOMPARE(copy.value(1), 10);
+
+    QFlatHash<int, int> moved = std::move(copy);
+    QCOMPARE(moved.value(1), 10);
+    QVERIFY(copy.isEmpty());
+}
+
+void tst_QFlatHash::reserveAndSqueeze()
+{
+    QFlatHash<int, int> hash;
+    hash.reserve(1000);
+    const qsizetype capacity = hash.capacity();
+    QVERIFY(capacity >= 1000);
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.capacity(), capacity);
+
+    for (int i = 10; i < 1000; ++i)
+        hash.remove(i);
+    hash.squeeze();
+    QVERIFY(hash.capacity() < capacity);
+    QVERIFY(hash.capacity() >= 10);
+    for (int i = 0; i < 10; ++i)
+        QCOMPARE(hash.value(i), i);
+
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.capacity(), 0);
+}
+
+void tst_QFlatHash::heterogeneousLookup()
+{
+    QFlatHash<QString, int> hash;
+    hash.insert(QStringLiteral("alpha"), 1);
+    hash.insert(QStringLiteral("\u00e9t\u00e9"), 2);
+    hash.insert(QString(), 3);
+
+    QVERIFY(hash.contains(QStringView(u"alpha")));
+    QVERIFY(hash.contains(QLatin1String("alpha")));
+    QVERIFY(!hash.contains(QLatin1String("alph")));
+    QCOMPARE(hash.value(QLatin1String("\xe9t\xe9")), 2);
+    QCOMPARE(hash.value(QStringView(u"\u00e9t\u00e9")), 2);
+    QCOMPARE(hash.value(QLatin1String("")), 3);
+    QCOMPARE(hash.constFind(QLatin1String("alpha")).value(), 1);
+    QVERIFY(hash.find(QStringView(u"beta")) == hash.end());
+
+    // long enough to use more than one chunk of the hash function
+    const QString longKey = QString(200, QLatin1Char('x'));
+    hash.insert(longKey, 4);
+    QCOMPARE(hash.value(QLatin1String(longKey.toLatin1())), 4);
+
+    QFlatHash<QByteArray, int> bytes;
+    bytes.insert("gamma", 5);
+    QVERIFY(bytes.contains(QLatin1String("gamma")));
+    QCOMPARE(bytes.value(QLatin1String("gamma")), 5);
+}
+
+void tst_QFlatHash::compare()
+{
+    QFlatHash<int, int> a{{1, 1}, {2, 2}};
+    QFlatHash<int, int> b;
+    QVERIFY(a != b);
+    b.insert(2, 2);
+    b.insert(1, 1);
+    QVERIFY(a == b);
+    b.insert(1, 0);
+    QVERIFY(a != b);
+    QVERIFY((QFlatHash<int, int>() == QFlatHash<int, int>()));
+}
+
+void tst_QFlatHash::rangeConstructor()
+{
+    QHash<int, int> source;
+    for (int i = 0; i < 50; ++i)
+        source.insert(i, -i);
+    QFlatHash<int, int> fromHash(source.constBegin(), source.constEnd());
+    QCOMPARE(fromHash.size(), 50);
+    for (int i = 0; i < 50; ++i)
+        QCOMPARE(fromHash.value(i), -i);
+
+    std::vector<std::pair<int, int> > pairs = {{1, 2}, {3, 4}};
+    QFlatHash<int, int> fromPairs(pairs.begin(), pairs.end());
+    QCOMPARE(fromPairs, (QFlatHash<int, int>{{1, 2}, {3, 4}}));
+
+    QFlatHash<int, int> other{{5, 6}};
+    fromPairs.insert(other);
+    QCOMPARE(fromPairs.size(), 3);
+}
+
+void tst_QFlatHash::manyItems_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("colliding");
+
+    QTest::newRow("100") << 100 << false;
+    QTest::newRow("100000") << 100000 << false;
+    QTest::newRow("colliding") << 1000 << true;
+}
+
+void tst_QFlatHash::manyItems()
+{
+    QFETCH(int, count);
+    QFETCH(bool, colliding);
+
+    if (colliding) {
+        QFlatHash<Colliding, int> hash;
+        for (int i = 0; i < count; ++i)
+            hash.insert(Colliding{i}, i);
+        for (int i = 0; i < count; i += 2)
+            hash.remove(Colliding{i});
+        QCOMPARE(hash.size(), count / 2);
+        for (int i = 0; i < count; ++i)
+            QCOMPARE(hash.contains(Colliding{i}), i % 2 == 1);
+        return;
+    }
+
+    QFlatHash<int, int> hash;
+    QHash<int, int> reference;
+    for (int i = 0; i < count; ++i) {
+        const int key = (i * 7919) % (count / 2 + 1);
+        if (i % 3 == 2) {
+            QCOMPARE(hash.remove(key), reference.remove(key) == 1);
+        } else {
+            hash.insert(key, i);
+            reference.insert(key, i);
+        }
+    }
+    QCOMPARE(hash.size(), qsizetype(reference.size()));
+    for (auto it = reference.cbegin(); it != reference.cend(); ++it)
+        QCOMPARE(hash.value(it.key(), -1), it.value());
+    qsizetype iterated = 0;
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it, ++iterated)
+        QCOMPARE(reference.value(it.key()), it.value());
+    QCOMPARE(iterated, hash.size());
+}
+
+void tst_QFlatHash::nonTrivialValues()
+{
+    {
+        QFlatHash<Tracked, Tracked> hash;
+        for (int i = 0; i < 500; ++i)
+            hash.insert(Tracked(i), Tracked(i));
+        QCOMPARE(Tracked::count, 1000);
+        for (int i = 0; i < 500; i += 5)
+            hash.remove(Tracked(i));
+        QCOMPARE(Tracked::count, 800);
+
+        QFlatHash<Tracked, Tracked> copy = hash;
+        QCOMPARE(Tracked::count, 800);
+        copy.insert(Tracked(-1), Tracked(-1));
+        QCOMPARE(Tracked::count, 1602);
+        copy.squeeze();
+        QCOMPARE(Tracked::count, 1602);
+    }
+    QCOMPARE(Tracked::count, 0);
+}
+
+void tst_QFlatHash::set()
+{
+    QFlatSet<int> set;
+    QVERIFY(set.isEmpty());
+    set.insert(1);
+    set << 2 << 3 << 2;
+    QCOMPARE(set.size(), 3);
+    QVERIFY(set.contains(2));
+    QVERIFY(set.remove(2));
+    QVERIFY(!set.remove(2));
+    QCOMPARE(set.size(), 2);
+    QCOMPARE(*set.find(3), 3);
+    QVERIFY(set.find(2) == set.end());
+
+    int sum = 0;
+    for (int value : set)
+        sum += value;
+    QCOMPARE(sum, 4);
+
+    for (auto it = set.begin(); it != set.end(); ) {
+        if (*it == 1)
+            it = set.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(set, QFlatSet<int>{3});
+
+    QFlatSet<int> copy = set;
+    copy.insert(4);
+    QCOMPARE(set.size(), 1);
+    QCOMPARE(copy.size(), 2);
+}
+
+void tst_QFlatHash::setOperations()
+{
+    const QFlatSet<int> a{1, 2, 3};
+    const QFlatSet<int> b{2, 3, 4};
+
+    QFlatSet<int> r = a;
+    r.unite(b);
+    QCOMPARE(r, (QFlatSet<int>{1, 2, 3, 4}));
+    r = a;
+    r.intersect(b);
+    QCOMPARE(r, (QFlatSet<int>{2, 3}));
+    r = a;
+    r.subtract(b);
+    QCOMPARE(r, QFlatSet<int>{1});
+    r = a;
+    r -= r;
+    QVERIFY(r.isEmpty());
+
+    QList<int> values = a.values();
+    std::sort(values.begin(), values.end());
+    QCOMPARE(values, (QList<int>{1, 2, 3}));
+}
+
+void tst_QFlatHash::setHeterogeneousLookup()
+{
+    QFlatSet<QString> set{QStringLiteral("one"), QStringLiteral("two")};
+    QVERIFY(set.contains(QLatin1String("one")));
+    QVERIFY(set.contains(QStringView(u"two")));
+    QVERIFY(!set.contains(QLatin1String("three")));
+    QCOMPARE(*set.find(QLatin1String("two")), QStringLiteral("two"));
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatHash)
+#include "tst_qflathash.moc"
@@ -0,0 +1,306 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <qflatmap.h>
+
+class tst_QFlatMap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void construct();
+    void constructFromVectors_data();
+    void constructFromVectors();
+    void insertAndRemove();
+    void lookup();
+    void bounds();
+    void iterators();
+    void eraseWhileIterating();
+    void implicitSharing();
+    void mergeMaps();
+    void customCompare();
+    void matchesQMap();
+};
+
+void tst_QFlatMap::construct()
+{
+    QFlatMap<int, QString> empty;
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(empty.size(), 0);
+    QVERIFY(empty.begin() == empty.end());
+
+    QFlatMap<int, QString> map{{3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}};
+    QCOMPARE(map.size(), 3);
+    QCOMPARE(map.keys(), (QList<int>{1, 2, 3}));
+    QCOMPARE(map.values(), (QList<QString>{"uno", "two", "three"}));
+    QCOMPARE(map.firstKey(), 1);
+    QCOMPARE(map.lastKey(), 3);
+    QCOMPARE(map.first(), QString("uno"));
+    QCOMPARE(map.last(), QString("three"));
+
+    QMap<int, QString> qmap{{5, "five"}, {4, "four"}};
+    QFlatMap<int, QString> fromMap(qmap);
+    QCOMPARE(fromMap.keys(), qmap.keys());
+    QCOMPARE(fromMap.toMap(), qmap);
+
+    QFlatMap<int, QString> fromRange(qmap.constBegin(), qmap.constEnd());
+    QCOMPARE(fromRange, fromMap);
+
+    std::vector<std::pair<int, QString> > pairs = {{9, "nine"}, {8, "eight"}};
+    QFlatMap<int, QString> fromPairs(pairs.begin(), pairs.end());
+    QCOMPARE(fromPairs.keys(), (QList<int>{8, 9}));
+}
+
+void tst_QFlatMap::constructFromVectors_data()
+{
+    QTest::addColumn<QVector<int> >("keys");
+    QTest::addColumn<QVector<int> >("values");
+    QTest::addColumn<QVector<int> >("expectedKeys");
+    QTest::addColumn<QVector<int> >("expectedValues");
+
+    QTest::newRow("empty") << QVector<int>() << QVector<int>()
+                           << QVector<int>() << QVector<int>();
+    QTest::newRow("sorted") << QVector<int>{1, 2, 3} << QVector<int>{10, 20, 30}
+                            << QVector<int>{1, 2, 3} << QVector<int>{10, 20, 30};
+    QTest::newRow("reversed") << QVector<int>{3, 2, 1} << QVector<int>{30, 20, 10}
+                              << QVector<int>{1, 2, 3} << QVector<int>{10, 20, 30};
+    QTest::newRow("duplicates") << QVector<int>{2, 1, 2, 1, 2} << QVector<int>{1, 2, 3, 4, 5}
+                                << QVector<int>{1, 2} << QVector<int>{4, 5};
+    QTest::newRow("sorted-duplicates") << QVector<int>{1, 1, 2} << QVector<int>{1, 2, 3}
+                                       << QVector<int>{1, 2} << QVector<int>{2, 3};
+}
+
+void tst_QFlatMap::constructFromVectors()
+{
+    QFETCH(QVector<int>, keys);
+    QFETCH(QVector<int>, values);
+    QFETCH(QVector<int>, expectedKeys);
+    QFETCH(QVector<int>, expectedValues);
+
+    QFlatMap<int, int> map(keys, values);
+    QCOMPARE(map.keyVector(), expectedKeys);
+    QCOMPARE(map.valueVector(), expectedValues);
+}
+
+void tst_QFlatMap::insertAndRemove()
+{
+    QFlatMap<QString, int> map;
+    QFlatMap<QString, int>::iterator it = map.insert("b", 2);
+    QCOMPARE(it.key(), QString("b"));
+    QCOMPARE(it.value(), 2);
+    map.insert("a", 1);
+    map.insert("c", 3);
+    map.insert("b", 20);
+    QCOMPARE(map.keys(), (QList<QString>{"a", "b", "c"}));
+    QCOMPARE(map.value("b"), 20);
+
+    map["d"] = 4;
+    ++map["a"];
+    QCOMPARE(map.size(), 4);
+    QCOMPARE(map.value("a"), 2);
+
+    QCOMPARE(map.remove("b"), 1);
+    QCOMPARE(map.remove("b"), 0);
+    QCOMPARE(map.take("c"), 3);
+    QCOMPARE(map.take("c"), 0);
+    QCOMPARE(map.keys(), (QList<QString>{"a", "d"}));
+
+    map.clear();
+    QVERIFY(map.isEmpty());
+}
+
+void tst_QFlatMap::lookup()
+{
+    const QFlatMap<int, QString> map{{1, "one"}, {2, "two"}, {4, "four"}};
+    QVERIFY(map.contains(2));
+    QVERIFY(!map.contains(3));
+    QCOMPARE(map.count(4), 1);
+    QCOMPARE(map.count(5), 0);
+    QCOMPARE(map.value(1), QString("one"));
+    QCOMPARE(map.value(3), QString());
+    QCOMPARE(map.value(3, "none"), QString("none"));
+    QCOMPARE(map[4], QString("four"));
+    QCOMPARE(map.key("two"), 2);
+    QCOMPARE(map.key("five", -1), -1);
+    QCOMPARE(map.keys("four"), QList<int>{4});
+    QCOMPARE(map.find(2).value(), QString("two"));
+    QVERIFY(map.constFind(0) == map.constEnd());
+    QVERIFY(map.constFind(5) == map.constEnd());
+}
+
+void tst_QFlatMap::bounds()
+{
+    QFlatMap<int, int> map;
+    QVERIFY(map.lowerBound(1) == map.end());
+    QVERIFY(map.upperBound(1) == map.end());
+
+    for (int i = 0; i < 100; i += 10)
+        map.insert(i, i);
+    QCOMPARE(map.lowerBound(-5).key(), 0);
+    QCOMPARE(map.lowerBound(0).key(), 0);
+    QCOMPARE(map.upperBound(0).key(), 10);
+    QCOMPARE(map.lowerBound(15).key(), 20);
+    QCOMPARE(map.upperBound(15).key(), 20);
+    QVERIFY(map.lowerBound(95) == map.end());
+    QVERIFY(map.upperBound(90) == map.end());
+
+    // every size, so that the search ends on every position at least once
+    for (int size = 0; size < 40; ++size) {
+        QVector<int> keys;
+        for (int i = 0; i < size; ++i)
+            keys.append(2 * i);
+        QFlatMap<int, int> m(keys, keys);
+        for (int key = -1; key <= 2 * size; ++key) {
+            const QFlatMap<int, int> &c = m;
+            QCOMPARE(c.lowerBound(key) - c.begin(), qptrdiff((key + 1) / 2));
+            QCOMPARE(c.contains(key), key >= 0 && key < 2 * size && key % 2 == 0);
+        }
+    }
+}
+
+void tst_QFlatMap::iterators()
+{
+    QFlatMap<int, int> map{{1, 10}, {2, 20}, {3, 30}};
+
+    int expectedKey = 1;
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it, ++expectedKey) {
+        QCOMPARE(it.key(), expectedKey);
+        QCOMPARE(*it, expectedKey * 10);
+    }
+
+    for (auto it = map.begin(); it != map.end(); ++it)
+        it.value() += 1;
+    QCOMPARE(map.values(), (QList<int>{11, 21, 31}));
+
+    auto last = map.end() - 1;
+    QCOMPARE(last.key(), 3);
+    QCOMPARE((--last).key(), 2);
+    QCOMPARE(map.end() - map.begin(), qptrdiff(3));
+    QVERIFY(map.begin() < map.end());
+
+    QList<int> keys;
+    for (auto it = map.keyBegin(); it != map.keyEnd(); ++it)
+        keys.append(*it);
+    QCOMPARE(keys, (QList<int>{1, 2, 3}));
+
+    int sum = 0;
+    for (auto it = map.constKeyValueBegin(); it != map.constKeyValueEnd(); ++it)
+        sum += (*it).first * (*it).second;
+    QCOMPARE(sum, 11 + 42 + 93);
+
+    int total = 0;
+    for (int value : qAsConst(map))
+        total += value;
+    QCOMPARE(total, 63);
+}
+
+void tst_QFlatMap::eraseWhileIterating()
+{
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 20; ++i)
+        map.insert(i, i);
+    for (auto it = map.begin(); it != map.end(); ) {
+        if (it.key() % 2)
+            it = map.erase(it);
+        else
+            ++it;
+    }
+    QCOMPARE(map.size(), 10);
+    for (auto it = map.cbegin(); it != map.cend(); ++it)
+        QCOMPARE(it.key() % 2, 0);
+}
+
+void tst_QFlatMap::implicitSharing()
+{
+    QFlatMap<int, int> map{{1, 1}, {2, 2}};
+    QFlatMap<int, int> copy = map;
+    QVERIFY(copy.isSharedWith(map));
+
+    *copy.begin() = 10;
+    QCOMPARE(map.value(1), 1);
+    QCOMPARE(copy.value(1), 10);
+    // changing the values alone leaves the keys shared
+    QVERIFY(copy.keyVector().isSharedWith(map.keyVector()));
+
+    copy.insert(3, 3);
+    QCOMPARE(map.size(), 2);
+    QCOMPARE(copy.size(), 3);
+}
+
+void tst_QFlatMap::mergeMaps()
+{
+    QFlatMap<int, int> map{{1, 1}, {3, 3}, {5, 5}};
+    map.insert(QFlatMap<int, int>{{0, 0}, {3, 30}, {6, 6}});
+    QCOMPARE(map.keys(), (QList<int>{0, 1, 3, 5, 6}));
+    QCOMPARE(map.value(3), 30);
+
+    QFlatMap<int, int> empty;
+    empty.insert(map);
+    QCOMPARE(empty, map);
+    map.insert(map);
+    QCOMPARE(map.size(), 5);
+}
+
+void tst_QFlatMap::customCompare()
+{
+    QFlatMap<int, int, std::greater<int> > map{{1, 1}, {3, 3}, {2, 2}};
+    QCOMPARE(map.firstKey(), 3);
+    QCOMPARE(map.lastKey(), 1);
+    QCOMPARE(map.lowerBound(2).key(), 2);
+    QCOMPARE(map.upperBound(2).key(), 1);
+    QVERIFY(map.contains(1));
+    QVERIFY(!map.contains(0));
+}
+
+void tst_QFlatMap::matchesQMap()
+{
+    QMap<int, int> reference;
+    QFlatMap<int, int> map;
+    for (int i = 0; i < 2000; ++i) {
+        const int key = (i * 7919) % 997;
+        switch (i % 4) {
+        case 0:
+        case 1:
+            reference.insert(key, i);
+            map.insert(key, i);
+            break;
+        case 2:
+            QCOMPARE(map.remove(key), reference.remove(key));
+            break;
+        case 3:
+            QCOMPARE(map.value(key, -1), reference.value(key, -1));
+            break;
+        }
+    }
+    QCOMPARE(map.toMap(), reference);
+    QCOMPARE((QFlatMap<int, int>(reference)), map);
+}
+
+QTEST_APPLESS_MAIN(tst_QFlatMap)
+#include "tst_qflatmap.moc"
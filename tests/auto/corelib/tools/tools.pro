@@ -12,6 +12,8 @@ SUBDIRS=\
     qcryptographichash \
     qeasingcurve \
     qexplicitlyshareddatapointer \
+    qflathash \
+    qflatmap \
     qfreelist \
     qhash \
     qhash_strictiterators \
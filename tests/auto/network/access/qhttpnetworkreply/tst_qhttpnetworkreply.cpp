@@ -37,8 +37,12 @@ class tst_QHttpNetworkReply: public QObject
 {
     Q_OBJECT
 private Q_SLOTS:
+    void initTestCase();
+
     void parseHeader_data();
     void parseHeader();
+    void sharedFieldNames();
+    void sharedFieldNamesWhenFull();
 
     void parseEndOfHeader_data();
     void parseEndOfHeader();
@@ -101,6 +105,53 @@ void tst_QHttpNetworkReply::parseHeader()
     }
 }
 
+void tst_QHttpNetworkReply::initTestCase()
+{
+    // read once, before the first header is parsed
+    qputenv("QT_HTTP_INTERN_FIELD_NAMES", "1");
+}
+
+void tst_QHttpNetworkReply::sharedFieldNames()
+{
+    const QByteArray headers("Content-Type: text/plain\r\n"
+                             "X-Custom-Header \t: 1\r\n");
+    QHttpNetworkReply first;
+    first.parseHeader(headers);
+    QHttpNetworkReply second;
+    second.parseHeader(headers);
+
+    const auto firstFields = first.header();
+    const auto secondFields = second.header();
+    QCOMPARE(firstFields.size(), 2);
+    QCOMPARE(secondFields.size(), 2);
+    QCOMPARE(firstFields.at(1).first, QByteArray("X-Custom-Header"));
+    QCOMPARE(firstFields.at(1).second, QByteArray("1"));
+
+    // the names are interned, so both replies use the same storage
+    for (int i = 0; i < firstFields.size(); ++i)
+        QCOMPARE(firstFields.at(i).first.constData(), secondFields.at(i).first.constData());
+}
+
+void tst_QHttpNetworkReply::sharedFieldNamesWhenFull()
+{
+    // a peer sending many distinct names does not stop the common ones
+    // from being shared
+    QByteArray flood;
+    for (int i = 0; i < 3000; ++i)
+        flood += "X-Flood-" + QByteArray::number(i) + ": 1\r\n";
+    QHttpNetworkReply flooder;
+    flooder.parseHeader(flood);
+    QCOMPARE(flooder.header().size(), 3000);
+
+    const QByteArray headers("Content-Type: text/plain\r\n");
+    QHttpNetworkReply first;
+    first.parseHeader(headers);
+    QHttpNetworkReply second;
+    second.parseHeader(headers);
+    QCOMPARE(first.header().at(0).first, QByteArray("Content-Type"));
+    QCOMPARE(first.header().at(0).first.constData(), second.header().at(0).first.constData());
+}
+
 class TestHeaderSocket : public QAbstractSocket
 {
 public:
@@ -9,7 +9,8 @@ SUBDIRS = \
         time \
         tools \
         codecs \
-        plugin
+        plugin \
+        serialization
 
 TRUSTED_BENCHMARKS += \
     kernel/qmetaobject \
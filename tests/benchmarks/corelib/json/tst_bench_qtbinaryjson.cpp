@@ -28,7 +28,9 @@
 
 #include <QtTest>
 #include <qjsondocument.h>
+#include <qjsonarray.h>
 #include <qjsonobject.h>
+#include <qjsonstream.h>
 
 class BenchmarkQtBinaryJson: public QObject
 {
@@ -45,6 +47,17 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseLargeJson_data();
+    void parseLargeJson();
+    void parseJsonStream();
+    void parseJsonLines();
+    void parseJsonLinesStream_data();
+    void parseJsonLinesStream();
+    void readThreeKeys_data();
+    void readThreeKeys();
+
+    void writeJson();
+    void writeJsonStream();
 
     void toByteArray();
     void fromByteArray();
@@ -120,6 +133,197 @@ void BenchmarkQtBinaryJson::parseJsonToVariant()
     }
 }
 
+void BenchmarkQtBinaryJson::parseJsonStream()
+{
+    QString testFile = QFINDTESTDATA("test.json");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file test.json!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    QByteArray testJson = file.readAll();
+
+    QBENCHMARK {
+        QJsonStreamReader reader(testJson);
+        while (!reader.atEnd())
+            reader.readNext();
+    }
+}
+
+// 10000 records, one per line
+static QByteArray jsonLines()
+{
+    QByteArray lines;
+    for (int i = 0; i < 10000; ++i) {
+        lines += "{\"id\":" + QByteArray::number(i)
+                + ",\"name\":\"record " + QByteArray::number(i)
+                + "\",\"score\":" + QByteArray::number(i / 7.0)
+                + ",\"tags\":[\"a\",\"b\"],\"valid\":true}\n";
+    }
+    return lines;
+}
+
+void BenchmarkQtBinaryJson::parseLargeJson_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    // the records of jsonLines() as one array
+    QByteArray records = jsonLines();
+    records.chop(1);
+    records.replace('\n', ',');
+    records = '[' + records + ']';
+
+    QTest::newRow("compact") << records;
+    QTest::newRow("indented") << QJsonDocument::fromJson(records).toJson(QJsonDocument::Indented);
+}
+
+void BenchmarkQtBinaryJson::parseLargeJson()
+{
+    QFETCH(QByteArray, json);
+
+    QBENCHMARK {
+        QJsonDocument doc = QJsonDocument::fromJson(json);
+        QCOMPARE(doc.array().size(), 10000);
+    }
+}
+
+void BenchmarkQtBinaryJson::parseJsonLines()
+{
+    // QJsonDocument needs each line on its own, and complete
+    const QByteArray lines = jsonLines();
+
+    QBENCHMARK {
+        double sum = 0;
+        int start = 0;
+        while (start < lines.size()) {
+            const int end = lines.indexOf('\n', start);
+            const QJsonDocument doc = QJsonDocument::fromJson(lines.mid(start, end - start));
+            sum += doc.object().value(QLatin1String("score")).toDouble();
+            start = end + 1;
+        }
+        QVERIFY(sum > 0);
+    }
+}
+
+void BenchmarkQtBinaryJson::parseJsonLinesStream_data()
+{
+    QTest::addColumn<int>("chunkSize");
+
+    QTest::newRow("whole") << 0;
+    QTest::newRow("16k chunks") << 16 * 1024;
+    QTest::newRow("1k chunks") << 1024;
+}
+
+void BenchmarkQtBinaryJson::parseJsonLinesStream()
+{
+    QFETCH(int, chunkSize);
+    const QByteArray lines = jsonLines();
+
+    QBENCHMARK {
+        double sum = 0;
+        QJsonStreamReader reader;
+        int fed = 0;
+        do {
+            if (chunkSize) {
+                reader.addData(lines.constData() + fed, qMin(chunkSize, lines.size() - fed));
+                fed += chunkSize;
+            } else {
+                reader.addData(lines);
+                fed = lines.size();
+            }
+            while (!reader.atEnd()) {
+                if (reader.readNext() == QJsonStreamReader::Number
+                        && reader.name() == QLatin1String("score")) {
+                    sum += reader.toDouble();
+                }
+            }
+            QVERIFY(reader.error() != QJsonStreamReader::NotWellFormedError);
+        } while (fed < lines.size());
+        QVERIFY(sum > 0);
+    }
+}
+
+// A configuration file of about 10 MB
+static QByteArray largeConfig()
+{
+    QByteArray json = "{\n    \"name\": \"service\",\n";
+    for (int i = 0; i < 20000; ++i) {
+        json += "    \"module" + QByteArray::number(i) + "\": {\n"
+                "        \"enabled\": " + (i % 3 ? "true" : "false") + ",\n"
+                "        \"threshold\": " + QByteArray::number(i / 3.0) + ",\n"
+                "        \"paths\": [\"/usr/lib/module" + QByteArray::number(i)
+                + "\", \"/opt/module" + QByteArray::number(i) + "\"],\n"
+                "        \"description\": \"" + QByteArray(300, 'x') + "\"\n"
+                "    },\n";
+        if (i == 10000)
+            json += "    \"port\": 8080,\n";
+    }
+    json += "    \"logging\": { \"level\": \"debug\", \"file\": \"/var/log/service.log\" }\n}\n";
+    return json;
+}
+
+void BenchmarkQtBinaryJson::readThreeKeys_data()
+{
+    QTest::addColumn<bool>("lazily");
+
+    QTest::newRow("fromJson") << false;
+    QTest::newRow("fromJsonLazily") << true;
+}
+
+void BenchmarkQtBinaryJson::readThreeKeys()
+{
+    QFETCH(bool, lazily);
+
+    QTemporaryFile config;
+    QVERIFY(config.open());
+    config.write(largeConfig());
+    config.close();
+
+    // open the file, and read a key at the start, one in the middle and
+    // one at the end
+    QBENCHMARK {
+        QFile file(config.fileName());
+        QVERIFY(file.open(QFile::ReadOnly));
+        const uchar *map = file.map(0, file.size());
+        QVERIFY(map);
+        const QByteArray json = QByteArray::fromRawData(reinterpret_cast<const char *>(map),
+                                                        int(file.size()));
+        const QJsonDocument doc = lazily ? QJsonDocument::fromJsonLazily(json)
+                                         : QJsonDocument::fromJson(json);
+        QCOMPARE(doc[QLatin1String("name")].toString(), QLatin1String("service"));
+        QCOMPARE(doc[QLatin1String("port")].toInt(), 8080);
+        QCOMPARE(doc[QLatin1String("logging")][QLatin1String("level")].toString(),
+                 QLatin1String("debug"));
+    }
+}
+
+void BenchmarkQtBinaryJson::writeJson()
+{
+    QString testFile = QFINDTESTDATA("test.json");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file test.json!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+
+    QBENCHMARK {
+        QByteArray json = doc.toJson(QJsonDocument::Compact);
+    }
+}
+
+void BenchmarkQtBinaryJson::writeJsonStream()
+{
+    QString testFile = QFINDTESTDATA("test.json");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file test.json!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    const QJsonValue value = doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object());
+
+    QBENCHMARK {
+        QByteArray json;
+        QJsonStreamWriter writer(&json);
+        writer.append(value);
+    }
+}
+
 void BenchmarkQtBinaryJson::toByteArray()
 {
     // Example: send information over a datastream to another process
@@ -90,6 +90,7 @@ class EventsBench : public QObject
 private slots:
     void initTestCase();
     void cleanupTestCase();
+    void cleanup();
 
     void noEvent();
     void sendEvent_data();
@@ -106,6 +107,11 @@ void EventsBench::cleanupTestCase()
 {
 }
 
+void EventsBench::cleanup()
+{
+    QEventLoopStatistics::setEnabled(false);
+}
+
 void EventsBench::noEvent()
 {
     EventTester tst;
@@ -118,13 +124,21 @@ void EventsBench::noEvent()
 void EventsBench::sendEvent_data()
 {
     QTest::addColumn<bool>("filterEvents");
-    QTest::newRow("no eventfilter") << false;
-    QTest::newRow("eventfilter") << true;
+    // the event loop statistics time one in sampleInterval events, 0 disables them
+    QTest::addColumn<int>("sampleInterval");
+    QTest::newRow("no eventfilter") << false << 0;
+    QTest::newRow("eventfilter") << true << 0;
+    QTest::newRow("no eventfilter, statistics") << false << 16;
+    QTest::newRow("no eventfilter, statistics of every event") << false << 1;
 }
 
 void EventsBench::sendEvent()
 {
     QFETCH(bool, filterEvents);
+    QFETCH(int, sampleInterval);
+    if (sampleInterval)
+        QEventLoopStatistics::setSampleInterval(sampleInterval);
+    QEventLoopStatistics::setEnabled(sampleInterval != 0);
     EventTester tst;
     if (filterEvents)
         tst.installEventFilter(this);
@@ -140,14 +154,21 @@ void EventsBench::postEvent_data()
     // The first time an eventloop is executed, the case runs radically slower at least
     // on some platforms, so test the "no eventfilter" case to get a comparable results
     // with the "eventfilter" case.
-    QTest::newRow("first time, no eventfilter") << false;
-    QTest::newRow("no eventfilter") << false;
-    QTest::newRow("eventfilter") << true;
+    QTest::addColumn<int>("sampleInterval");
+    QTest::newRow("first time, no eventfilter") << false << 0;
+    QTest::newRow("no eventfilter") << false << 0;
+    QTest::newRow("eventfilter") << true << 0;
+    QTest::newRow("no eventfilter, statistics") << false << 16;
+    QTest::newRow("no eventfilter, statistics of every event") << false << 1;
 }
 
 void EventsBench::postEvent()
 {
     QFETCH(bool, filterEvents);
+    QFETCH(int, sampleInterval);
+    if (sampleInterval)
+        QEventLoopStatistics::setSampleInterval(sampleInterval);
+    QEventLoopStatistics::setEnabled(sampleInterval != 0);
     PingPong ping;
     PingPong pong;
     ping.setPeer(&pong);
@@ -6,8 +6,14 @@ SUBDIRS = \
         qobject \
         qvariant \
         qcoreapplication \
+        qqueuedconnection \
+        qsocketnotifier \
+        qtimer \
         qtimer_vs_qmetaobject
 
+!unix|!qtConfig(private_tests): SUBDIRS -= \
+    qsocketnotifier
+
 !qtHaveModule(widgets): SUBDIRS -= \
     qmetaobject \
     qobject
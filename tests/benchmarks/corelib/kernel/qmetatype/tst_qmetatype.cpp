@@ -28,6 +28,8 @@
 
 #include <qtest.h>
 #include <QtCore/qmetatype.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qvector.h>
 
 class tst_QMetaType : public QObject
 {
@@ -65,6 +67,9 @@ private slots:
     void constructInPlaceCopy();
     void constructInPlaceCopyStaticLess_data();
     void constructInPlaceCopyStaticLess();
+
+    void contention_data();
+    void contention();
 };
 
 tst_QMetaType::tst_QMetaType()
@@ -319,5 +324,73 @@ void tst_QMetaType::constructInPlaceCopyStaticLess()
     qFreeAligned(storage);
 }
 
+struct Converted { int i; };
+Q_DECLARE_METATYPE(Converted);
+
+enum Operation { TypeByName, ConstructDestruct, Convert };
+Q_DECLARE_METATYPE(Operation)
+
+void tst_QMetaType::contention_data()
+{
+    QTest::addColumn<Operation>("operation");
+    QTest::addColumn<int>("threads");
+
+    for (int threads : { 1, 2, 4, 8, 16 }) {
+        QTest::addRow("type(name), %d threads", threads) << TypeByName << threads;
+        QTest::addRow("construct+destruct, %d threads", threads) << ConstructDestruct << threads;
+        QTest::addRow("convert, %d threads", threads) << Convert << threads;
+    }
+}
+
+// Looks up custom types and converters from several threads at once, which
+// is what queued connections and QVariant conversions do.
+void tst_QMetaType::contention()
+{
+    QFETCH(Operation, operation);
+    QFETCH(int, threads);
+
+    const int typeId = qRegisterMetaType<BigClass>("BigClass");
+    const int convertedId = qMetaTypeId<Converted>();
+    static bool converterRegistered = false;
+    if (!converterRegistered) {
+        QMetaType::registerConverter<BigClass, Converted>([](const BigClass &b) {
+            return Converted{ int(b.n) };
+        });
+        converterRegistered = true;
+    }
+
+    const int iterations = 400000 / threads;
+    auto work = [&]() {
+        BigClass from = {};
+        Converted to;
+        alignas(BigClass) char storage[sizeof(BigClass)];
+        for (int i = 0; i < iterations; ++i) {
+            switch (operation) {
+            case TypeByName:
+                QMetaType::type("BigClass");
+                break;
+            case ConstructDestruct:
+                QMetaType::construct(typeId, storage, &from);
+                QMetaType::destruct(typeId, storage);
+                break;
+            case Convert:
+                QMetaType::convert(&from, typeId, &to, convertedId);
+                break;
+            }
+        }
+    };
+
+    QBENCHMARK {
+        QVector<QThread *> workers;
+        for (int i = 0; i < threads; ++i)
+            workers << QThread::create(work);
+        for (QThread *thread : qAsConst(workers))
+            thread->start();
+        for (QThread *thread : qAsConst(workers))
+            thread->wait();
+        qDeleteAll(workers);
+    }
+}
+
 QTEST_MAIN(tst_QMetaType)
 #include "tst_qmetatype.moc"
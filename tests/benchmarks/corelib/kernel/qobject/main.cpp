@@ -53,6 +53,11 @@ private slots:
     void receiver_destroyed_benchmark();
 
     void stdAllocator();
+
+    // run with QT_OBJECT_POOL=1 to measure the object pool
+    void shortLivedObjects_data();
+    void shortLivedObjects();
+    void queuedMetaCalls();
 };
 
 class QObjectUsingStandardAllocator : public QObject
@@ -305,6 +310,52 @@ void QObjectBenchmark::receiver_destroyed_benchmark()
     }
 }
 
+void QObjectBenchmark::shortLivedObjects_data()
+{
+    QTest::addColumn<int>("threads");
+    for (int threads : { 1, 2, 4 })
+        QTest::addRow("%d threads", threads) << threads;
+}
+
+// Creates, connects and deletes objects, like a request handler does. Each
+// object needs a QObjectPrivate and a ConnectionData.
+void QObjectBenchmark::shortLivedObjects()
+{
+    QFETCH(int, threads);
+    const int iterations = 100000 / threads;
+
+    QBENCHMARK {
+        QVector<QThread *> workers;
+        for (int i = 0; i < threads; ++i) {
+            workers << QThread::create([iterations]() {
+                for (int j = 0; j < iterations; ++j) {
+                    Object *object = new Object;
+                    QObject::connect(object, &Object::signal0, object, &Object::slot0);
+                    delete object;
+                }
+            });
+        }
+        for (QThread *thread : qAsConst(workers))
+            thread->start();
+        for (QThread *thread : qAsConst(workers))
+            thread->wait();
+        qDeleteAll(workers);
+    }
+}
+
+// Each queued emission allocates a QMetaCallEvent.
+void QObjectBenchmark::queuedMetaCalls()
+{
+    Object sender;
+    Object receiver;
+    QObject::connect(&sender, &Object::signal0, &receiver, &Object::slot0, Qt::QueuedConnection);
+    QBENCHMARK {
+        for (int i = 0; i < 10000; ++i)
+            sender.emitSignal0();
+        QCoreApplication::processEvents();
+    }
+}
+
 QTEST_MAIN(QObjectBenchmark)
 
 #include "main.moc"
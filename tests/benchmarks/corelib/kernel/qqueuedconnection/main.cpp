@@ -0,0 +1,212 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore>
+#include <qtest.h>
+
+#include <cstdlib>
+#include <new>
+
+// Counts every heap allocation in the process, including the ones made by
+// QtCore, so that allocations() can report them per emission.
+static QBasicAtomicInt allocationCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+void *operator new(std::size_t size)
+{
+    allocationCount.ref();
+    void *p = std::malloc(size ? size : 1);
+    Q_CHECK_PTR(p);
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+static const QEvent::Type CountEventType = QEvent::Type(QEvent::User + 1);
+
+// Counts what the producers send and quits the event loop once all of it
+// has arrived.
+class Consumer : public QObject
+{
+    Q_OBJECT
+
+public:
+    QEventLoop loop;
+    int received = 0;
+    int expected = 0;
+
+    bool event(QEvent *e) override
+    {
+        if (e->type() == CountEventType) {
+            count();
+            return true;
+        }
+        return QObject::event(e);
+    }
+
+public slots:
+    void value(int)
+    {
+        count();
+    }
+
+private:
+    void count()
+    {
+        if (++received == expected)
+            loop.quit();
+    }
+};
+
+class Producer : public QObject
+{
+    Q_OBJECT
+
+signals:
+    void value(int);
+
+public:
+    void emitValues(int count)
+    {
+        for (int i = 0; i < count; ++i)
+            emit value(i);
+    }
+};
+
+class tst_QQueuedConnection : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void throughput_data();
+    void throughput();
+    void allocations_data();
+    void allocations();
+};
+
+enum Mode { Queued, Batched, CustomEvent };
+Q_DECLARE_METATYPE(Mode)
+
+void tst_QQueuedConnection::throughput_data()
+{
+    QTest::addColumn<Mode>("mode");
+    QTest::addColumn<int>("producers");
+
+    for (int producers : { 1, 2, 4 }) {
+        QTest::addRow("queued signal, %d producers", producers) << Queued << producers;
+        QTest::addRow("batched signal, %d producers", producers) << Batched << producers;
+        QTest::addRow("custom event, %d producers", producers) << CustomEvent << producers;
+    }
+}
+
+// Several threads send to one receiver in the main thread, either by
+// emitting a signal over a queued connection or by posting custom events.
+void tst_QQueuedConnection::throughput()
+{
+    QFETCH(Mode, mode);
+    QFETCH(int, producers);
+
+    const int perProducer = 200000 / producers;
+
+    Consumer consumer;
+    Producer producer;
+    connect(&producer, &Producer::value, &consumer, &Consumer::value,
+            mode == Batched ? Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection)
+                            : Qt::QueuedConnection);
+
+    QBENCHMARK {
+        consumer.received = 0;
+        consumer.expected = perProducer * producers;
+
+        QVector<QThread *> threads;
+        for (int i = 0; i < producers; ++i) {
+            threads << QThread::create([&]() {
+                if (mode != CustomEvent) {
+                    producer.emitValues(perProducer);
+                } else {
+                    for (int j = 0; j < perProducer; ++j)
+                        QCoreApplication::postEvent(&consumer, new QEvent(CountEventType));
+                }
+            });
+        }
+        for (QThread *thread : qAsConst(threads))
+            thread->start();
+
+        consumer.loop.exec();
+
+        for (QThread *thread : qAsConst(threads))
+            thread->wait();
+        qDeleteAll(threads);
+    }
+    QCOMPARE(consumer.received, consumer.expected);
+}
+
+void tst_QQueuedConnection::allocations_data()
+{
+    QTest::addColumn<Mode>("mode");
+
+    QTest::newRow("queued signal") << Queued;
+    QTest::newRow("batched signal") << Batched;
+}
+
+// Reports the heap allocations per emission of a queued signal whose
+// receiver lives in the emitting thread, so that every emission made
+// before returning to the event loop is still pending.
+void tst_QQueuedConnection::allocations()
+{
+    QFETCH(Mode, mode);
+
+    const int emissions = 10000;
+
+    Consumer consumer;
+    Producer producer;
+    connect(&producer, &Producer::value, &consumer, &Consumer::value,
+            mode == Batched ? Qt::ConnectionType(Qt::QueuedConnection | Qt::BatchedConnection)
+                            : Qt::QueuedConnection);
+
+    // warm up the argument types and the storage pool
+    consumer.expected = 1;
+    producer.emitValues(1);
+    consumer.loop.exec();
+
+    consumer.received = 0;
+    consumer.expected = emissions;
+    const int before = allocationCount.loadRelaxed();
+    producer.emitValues(emissions);
+    consumer.loop.exec();
+    const int allocated = allocationCount.loadRelaxed() - before;
+
+    QCOMPARE(consumer.received, consumer.expected);
+    QTest::setBenchmarkResult(qreal(allocated) / emissions, QTest::Events);
+}
+
+QTEST_MAIN(tst_QQueuedConnection)
+
+#include "main.moc"
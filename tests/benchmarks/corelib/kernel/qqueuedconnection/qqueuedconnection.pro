@@ -0,0 +1,6 @@
+TEMPLATE = app
+TARGET = tst_bench_qqueuedconnection
+QT = core testlib
+CONFIG += release
+
+SOURCES += main.cpp
@@ -0,0 +1,138 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtCore/QCoreApplication>
+#include <QtCore/QSocketNotifier>
+#include <QtCore/QVector>
+#include <QtCore/private/qeventdispatcher_unix_p.h>
+#if QT_CONFIG(epoll)
+#  include <QtCore/private/qeventdispatcher_epoll_p.h>
+#endif
+#include <QtCore/private/qcore_unix_p.h>
+
+#include <qtest.h>
+
+#include <sys/resource.h>
+
+class tst_QSocketNotifier : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void processEvents_data();
+    void processEvents();
+};
+
+void tst_QSocketNotifier::initTestCase()
+{
+    // the larger rows need more descriptors than the usual soft limit
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+void tst_QSocketNotifier::processEvents_data()
+{
+    QTest::addColumn<QByteArray>("dispatcher");
+    QTest::addColumn<int>("count");
+
+    QByteArrayList dispatchers = { "poll" };
+#if QT_CONFIG(epoll)
+    dispatchers << "epoll";
+#endif
+
+    for (int count : { 10, 100, 1000, 10000 }) {
+        for (const QByteArray &dispatcher : qAsConst(dispatchers)) {
+            const QByteArray name = dispatcher + '-' + QByteArray::number(count);
+            QTest::newRow(name.constData()) << dispatcher << count;
+        }
+    }
+}
+
+// One active pipe among count - 1 idle ones: measures the per-iteration
+// cost of the dispatcher as a function of the number of registered notifiers.
+void tst_QSocketNotifier::processEvents()
+{
+    QFETCH(QByteArray, dispatcher);
+    QFETCH(int, count);
+
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && rlim_t(2 * count + 64) > limit.rlim_cur)
+        QSKIP("Not enough file descriptors available");
+
+    QScopedPointer<QEventDispatcherUNIX> eventDispatcher;
+#if QT_CONFIG(epoll)
+    if (dispatcher == "epoll")
+        eventDispatcher.reset(new QEventDispatcherEpoll);
+#endif
+    if (!eventDispatcher)
+        eventDispatcher.reset(new QEventDispatcherUNIX);
+
+    QVector<int> fds;
+    QVector<QSocketNotifier *> notifiers;
+    fds.reserve(2 * count);
+    notifiers.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        int pipes[2];
+        QVERIFY(qt_safe_pipe(pipes, O_NONBLOCK) == 0);
+        fds << pipes[0] << pipes[1];
+
+        // keep it out of the application's dispatcher, we drive our own
+        QSocketNotifier *notifier = new QSocketNotifier(pipes[0], QSocketNotifier::Read);
+        notifier->setEnabled(false);
+        eventDispatcher->registerSocketNotifier(notifier);
+        notifiers << notifier;
+    }
+
+    int activations = 0;
+    connect(notifiers.first(), &QSocketNotifier::activated, [&](int fd) {
+        char c;
+        qt_safe_read(fd, &c, 1);
+        ++activations;
+    });
+
+    QBENCHMARK {
+        char c = 'x';
+        qt_safe_write(fds.at(1), &c, 1);
+        eventDispatcher->processEvents(QEventLoop::AllEvents);
+    }
+    QVERIFY(activations > 0);
+
+    for (QSocketNotifier *notifier : qAsConst(notifiers))
+        eventDispatcher->unregisterSocketNotifier(notifier);
+    qDeleteAll(notifiers);
+    for (int fd : qAsConst(fds))
+        qt_safe_close(fd);
+}
+
+QTEST_MAIN(tst_QSocketNotifier)
+
+#include "main.moc"
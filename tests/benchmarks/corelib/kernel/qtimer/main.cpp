@@ -0,0 +1,106 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore>
+#include <qtest.h>
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void restart_data();
+    void restart();
+    void startStop_data() { restart_data(); }
+    void startStop();
+
+private:
+    void createTimers(int count, Qt::TimerType type);
+
+    std::vector<std::unique_ptr<QTimer>> timers;
+};
+
+void tst_QTimer::restart_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<Qt::TimerType>("type");
+
+    for (int count : { 1000, 10000, 50000 }) {
+        QTest::addRow("precise, %d timers", count) << count << Qt::PreciseTimer;
+        QTest::addRow("coarse, %d timers", count) << count << Qt::CoarseTimer;
+    }
+}
+
+// Many timers with intervals of a few seconds to a few minutes, like idle
+// timeouts of network connections
+void tst_QTimer::createTimers(int count, Qt::TimerType type)
+{
+    timers.clear();
+    for (int i = 0; i < count; ++i) {
+        timers.emplace_back(new QTimer);
+        timers.back()->setTimerType(type);
+        timers.back()->setInterval(5000 + (i * 7919) % 120000);
+    }
+}
+
+// Restarting a running timer unregisters and registers it again
+void tst_QTimer::restart()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, type);
+
+    createTimers(count, type);
+    for (const auto &timer : timers)
+        timer->start();
+
+    QBENCHMARK {
+        for (const auto &timer : timers)
+            timer->start();
+    }
+    timers.clear();
+}
+
+void tst_QTimer::startStop()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, type);
+
+    createTimers(count, type);
+
+    QBENCHMARK {
+        for (const auto &timer : timers)
+            timer->start();
+        for (const auto &timer : timers)
+            timer->stop();
+    }
+    timers.clear();
+}
+
+QTEST_MAIN(tst_QTimer)
+
+#include "main.moc"
@@ -0,0 +1,6 @@
+TEMPLATE = app
+TARGET = tst_bench_qtimer
+QT = core testlib
+CONFIG += release
+
+SOURCES += main.cpp
@@ -0,0 +1,196 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTest>
+
+#if defined(__GLIBC__)
+// Count the calls into the C library's allocator, which is what QVector,
+// QByteArray and operator new end up using.
+#  define HAVE_ALLOCATION_COUNTER
+static QBasicAtomicInteger<qint64> allocationCount = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t n, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size)
+{
+    allocationCount.fetchAndAddRelaxed(1);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size)
+{
+    allocationCount.fetchAndAddRelaxed(1);
+    return __libc_calloc(n, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    allocationCount.fetchAndAddRelaxed(1);
+    return __libc_realloc(ptr, size);
+}
+}
+#endif
+
+class tst_QCborValue : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parse_data() { sizeData(); }
+    void parse() { parse_template(QCborValue::NoDecodingOption); }
+    void parse_arena_data() { sizeData(); }
+    void parse_arena() { parse_template(QCborValue::UseArena); }
+    void parse_json_data() { sizeData(); }
+    void parse_json();
+
+    void destruction_data() { sizeData(); }
+    void destruction() { destruction_template(QCborValue::NoDecodingOption); }
+    void destruction_arena_data() { sizeData(); }
+    void destruction_arena() { destruction_template(QCborValue::UseArena); }
+
+    void allocations_data() { sizeData(); }
+    void allocations() { allocations_template(QCborValue::NoDecodingOption); }
+    void allocations_arena_data() { sizeData(); }
+    void allocations_arena() { allocations_template(QCborValue::UseArena); }
+    void allocations_json_data() { sizeData(); }
+    void allocations_json();
+
+private:
+    void sizeData();
+    void parse_template(QCborValue::DecodingOptions opts);
+    void destruction_template(QCborValue::DecodingOptions opts);
+    void allocations_template(QCborValue::DecodingOptions opts);
+};
+
+void tst_QCborValue::sizeData()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("10") << 10;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("100000") << 100000;
+}
+
+// An array of records, each with a few nested maps and arrays, like the
+// configuration or telemetry documents that are mostly read after decoding.
+static QCborValue document(int size)
+{
+    QCborArray records;
+    for (int i = 0; i < size; ++i) {
+        QCborArray tags;
+        for (int j = 0; j < i % 5; ++j)
+            tags.append(QLatin1String("tag-") + QString::number(j));
+
+        QCborMap position{{QLatin1String("x"), i * 0.5}, {QLatin1String("y"), -i}};
+        QCborMap record{{QLatin1String("id"), i},
+                        {QLatin1String("name"), QLatin1String("record-") + QString::number(i)},
+                        {QLatin1String("enabled"), i % 3 == 0},
+                        {QLatin1String("position"), position},
+                        {QLatin1String("tags"), tags}};
+        records.append(record);
+    }
+    return records;
+}
+
+void tst_QCborValue::parse_template(QCborValue::DecodingOptions opts)
+{
+    QFETCH(int, size);
+    const QByteArray data = document(size).toCbor();
+
+    QBENCHMARK {
+        QCborValue v = QCborValue::fromCbor(data, nullptr, opts);
+        QVERIFY(v.isArray());
+    }
+}
+
+void tst_QCborValue::parse_json()
+{
+    QFETCH(int, size);
+    const QByteArray data = QJsonDocument(document(size).toJsonValue().toArray()).toJson();
+
+    QBENCHMARK {
+        QJsonDocument doc = QJsonDocument::fromJson(data);
+        QVERIFY(doc.isArray());
+    }
+}
+
+void tst_QCborValue::destruction_template(QCborValue::DecodingOptions opts)
+{
+    QFETCH(int, size);
+    QCborValue v = QCborValue::fromCbor(document(size).toCbor(), nullptr, opts);
+
+    QBENCHMARK_ONCE {
+        v = QCborValue();
+    }
+}
+
+void tst_QCborValue::allocations_template(QCborValue::DecodingOptions opts)
+{
+#ifdef HAVE_ALLOCATION_COUNTER
+    QFETCH(int, size);
+    const QByteArray data = document(size).toCbor();
+
+    const qint64 before = allocationCount.loadRelaxed();
+    QCborValue v = QCborValue::fromCbor(data, nullptr, opts);
+    const qint64 after = allocationCount.loadRelaxed();
+    QVERIFY(v.isArray());
+    QTest::setBenchmarkResult(qreal(after - before), QTest::Events);
+#else
+    Q_UNUSED(opts);
+    QSKIP("Counting the allocations needs glibc");
+#endif
+}
+
+void tst_QCborValue::allocations_json()
+{
+#ifdef HAVE_ALLOCATION_COUNTER
+    QFETCH(int, size);
+    const QByteArray data = QJsonDocument(document(size).toJsonValue().toArray()).toJson();
+
+    const qint64 before = allocationCount.loadRelaxed();
+    QJsonDocument doc = QJsonDocument::fromJson(data);
+    const qint64 after = allocationCount.loadRelaxed();
+    QVERIFY(doc.isArray());
+    QTest::setBenchmarkResult(qreal(after - before), QTest::Events);
+#else
+    QSKIP("Counting the allocations needs glibc");
+#endif
+}
+
+QTEST_MAIN(tst_QCborValue)
+
+#include "main.moc"
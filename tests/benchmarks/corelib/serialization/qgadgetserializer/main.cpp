@@ -0,0 +1,313 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <QCborValue>
+#include <QGadgetSerializer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonStreamReader>
+#include <QJsonStreamWriter>
+#include <QMetaProperty>
+#include <QTest>
+
+struct Position
+{
+    Q_GADGET
+    Q_PROPERTY(double x MEMBER x)
+    Q_PROPERTY(double y MEMBER y)
+public:
+    double x = 0;
+    double y = 0;
+
+    // MEMBER properties compare the old and new value
+    bool operator==(const Position &other) const { return x == other.x && y == other.y; }
+    bool operator!=(const Position &other) const { return !(*this == other); }
+};
+Q_DECLARE_METATYPE(Position)
+
+struct Sample
+{
+    Q_GADGET
+    Q_PROPERTY(int id MEMBER id)
+    Q_PROPERTY(QString name MEMBER name)
+    Q_PROPERTY(bool enabled MEMBER enabled)
+    Q_PROPERTY(qint64 timestamp MEMBER timestamp)
+    Q_PROPERTY(double value MEMBER value)
+    Q_PROPERTY(QString unit MEMBER unit)
+    Q_PROPERTY(Position position MEMBER position)
+public:
+    int id = 0;
+    QString name;
+    bool enabled = false;
+    qint64 timestamp = 0;
+    double value = 0;
+    QString unit;
+    Position position;
+};
+
+class tst_QGadgetSerializer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void toJson_data() { sizeData(); }
+    void toJson();
+    void toJson_variant_data() { sizeData(); }
+    void toJson_variant();
+    void toCbor_data() { sizeData(); }
+    void toCbor();
+    void toCbor_variant_data() { sizeData(); }
+    void toCbor_variant();
+
+    void fromJson_data() { sizeData(); }
+    void fromJson();
+    void fromJson_variant_data() { sizeData(); }
+    void fromJson_variant();
+    void fromCbor_data() { sizeData(); }
+    void fromCbor();
+    void fromCbor_variant_data() { sizeData(); }
+    void fromCbor_variant();
+
+private:
+    void sizeData();
+};
+
+void tst_QGadgetSerializer::initTestCase()
+{
+    qRegisterMetaType<Position>();
+}
+
+void tst_QGadgetSerializer::sizeData()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("100") << 100;
+    QTest::newRow("10000") << 10000;
+}
+
+static QVector<Sample> samples(int size)
+{
+    QVector<Sample> result(size);
+    for (int i = 0; i < size; ++i) {
+        Sample &s = result[i];
+        s.id = i;
+        s.name = QLatin1String("sensor-") + QString::number(i % 64);
+        s.enabled = i % 3 != 0;
+        s.timestamp = Q_INT64_C(1580000000000) + i * 250;
+        s.value = i * 0.75;
+        s.unit = QStringLiteral("kPa");
+        s.position.x = i * 0.5;
+        s.position.y = -i;
+    }
+    return result;
+}
+
+// The conventional path: one QVariant for each property, converted to a
+// QJsonValue or QCborValue, with the nested gadget handled the same way.
+template <typename Object, typename Value>
+static Object objectFromGadget(const QMetaObject &mo, const void *gadget)
+{
+    Object object;
+    for (int i = 0; i < mo.propertyCount(); ++i) {
+        const QMetaProperty property = mo.property(i);
+        const QVariant v = property.readOnGadget(gadget);
+        if (const QMetaObject *nested = QMetaType::metaObjectForType(v.userType()))
+            object.insert(QLatin1String(property.name()), objectFromGadget<Object, Value>(*nested, v.constData()));
+        else
+            object.insert(QLatin1String(property.name()), Value::fromVariant(v));
+    }
+    return object;
+}
+
+static QJsonObject toObject(const QJsonValue &value) { return value.toObject(); }
+static QCborMap toObject(const QCborValue &value) { return value.toMap(); }
+
+template <typename Object>
+static void gadgetFromObject(const QMetaObject &mo, void *gadget, const Object &object)
+{
+    for (int i = 0; i < mo.propertyCount(); ++i) {
+        const QMetaProperty property = mo.property(i);
+        const auto value = object.value(QLatin1String(property.name()));
+        if (const QMetaObject *nested = QMetaType::metaObjectForType(property.userType())) {
+            QVariant v = property.readOnGadget(gadget);
+            gadgetFromObject(*nested, v.data(), toObject(value));
+            property.writeOnGadget(gadget, v);
+        } else {
+            property.writeOnGadget(gadget, value.toVariant());
+        }
+    }
+}
+
+void tst_QGadgetSerializer::toJson()
+{
+    QFETCH(int, size);
+    const QVector<Sample> data = samples(size);
+
+    QBENCHMARK {
+        QByteArray json;
+        QJsonStreamWriter writer(&json);
+        writer.startArray();
+        for (const Sample &s : data)
+            QGadgetSerializer::toJson(writer, s);
+        writer.endArray();
+    }
+}
+
+void tst_QGadgetSerializer::toJson_variant()
+{
+    QFETCH(int, size);
+    const QVector<Sample> data = samples(size);
+
+    QBENCHMARK {
+        QJsonArray array;
+        for (const Sample &s : data)
+            array.append(objectFromGadget<QJsonObject, QJsonValue>(Sample::staticMetaObject, &s));
+        QByteArray json = QJsonDocument(array).toJson(QJsonDocument::Compact);
+    }
+}
+
+void tst_QGadgetSerializer::toCbor()
+{
+    QFETCH(int, size);
+    const QVector<Sample> data = samples(size);
+
+    QBENCHMARK {
+        QByteArray cbor;
+        QCborStreamWriter writer(&cbor);
+        writer.startArray(data.size());
+        for (const Sample &s : data)
+            QGadgetSerializer::toCbor(writer, s);
+        writer.endArray();
+    }
+}
+
+void tst_QGadgetSerializer::toCbor_variant()
+{
+    QFETCH(int, size);
+    const QVector<Sample> data = samples(size);
+
+    QBENCHMARK {
+        QCborArray array;
+        for (const Sample &s : data)
+            array.append(objectFromGadget<QCborMap, QCborValue>(Sample::staticMetaObject, &s));
+        QByteArray cbor = QCborValue(array).toCbor();
+    }
+}
+
+void tst_QGadgetSerializer::fromJson()
+{
+    QFETCH(int, size);
+    QByteArray input;
+    {
+        QJsonStreamWriter writer(&input);
+        writer.startArray();
+        for (const Sample &s : samples(size))
+            QGadgetSerializer::toJson(writer, s);
+        writer.endArray();
+    }
+
+    QVector<Sample> result(size);
+    QBENCHMARK {
+        QJsonStreamReader reader(input);
+        reader.readNext();
+        for (Sample &s : result) {
+            reader.readNext();
+            QGadgetSerializer::fromJson(reader, s);
+        }
+    }
+    QCOMPARE(result.last().id, size - 1);
+}
+
+void tst_QGadgetSerializer::fromJson_variant()
+{
+    QFETCH(int, size);
+    QJsonArray array;
+    for (const Sample &s : samples(size))
+        array.append(objectFromGadget<QJsonObject, QJsonValue>(Sample::staticMetaObject, &s));
+    const QByteArray input = QJsonDocument(array).toJson(QJsonDocument::Compact);
+
+    QVector<Sample> result(size);
+    QBENCHMARK {
+        const QJsonArray parsed = QJsonDocument::fromJson(input).array();
+        for (int i = 0; i < size; ++i)
+            gadgetFromObject(Sample::staticMetaObject, &result[i], parsed.at(i).toObject());
+    }
+    QCOMPARE(result.last().id, size - 1);
+}
+
+void tst_QGadgetSerializer::fromCbor()
+{
+    QFETCH(int, size);
+    QByteArray input;
+    {
+        QCborStreamWriter writer(&input);
+        writer.startArray(size);
+        for (const Sample &s : samples(size))
+            QGadgetSerializer::toCbor(writer, s);
+        writer.endArray();
+    }
+
+    QVector<Sample> result(size);
+    QBENCHMARK {
+        QCborStreamReader reader(input);
+        reader.enterContainer();
+        for (Sample &s : result)
+            QGadgetSerializer::fromCbor(reader, s);
+    }
+    QCOMPARE(result.last().id, size - 1);
+}
+
+void tst_QGadgetSerializer::fromCbor_variant()
+{
+    QFETCH(int, size);
+    QCborArray array;
+    for (const Sample &s : samples(size))
+        array.append(objectFromGadget<QCborMap, QCborValue>(Sample::staticMetaObject, &s));
+    const QByteArray input = QCborValue(array).toCbor();
+
+    QVector<Sample> result(size);
+    QBENCHMARK {
+        const QCborArray parsed = QCborValue::fromCbor(input).toArray();
+        for (int i = 0; i < size; ++i)
+            gadgetFromObject(Sample::staticMetaObject, &result[i], parsed.at(i).toMap());
+    }
+    QCOMPARE(result.last().id, size - 1);
+}
+
+QTEST_MAIN(tst_QGadgetSerializer)
+
+#include "main.moc"
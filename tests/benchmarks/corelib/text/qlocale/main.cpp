@@ -26,8 +26,12 @@
 **
 ****************************************************************************/
 
+#include <QJsonArray>
+#include <QJsonDocument>
 #include <QLocale>
 #include <QTest>
+#include <QTextStream>
+#include <QtMath>
 
 class tst_QLocale : public QObject
 {
@@ -37,6 +41,27 @@ private Q_SLOTS:
     void toUpper_QLocale_1();
     void toUpper_QLocale_2();
     void toUpper_QString();
+
+    void toDouble_QString_data() { numberData(); }
+    void toDouble_QString();
+    void toDouble_QByteArray_data() { numberData(); }
+    void toDouble_QByteArray();
+    void toDouble_QLocale_data() { numberData(); }
+    void toDouble_QLocale();
+    void toDouble_QTextStream_data() { numberData(); }
+    void toDouble_QTextStream();
+    void toDouble_QJsonDocument_data() { numberData(); }
+    void toDouble_QJsonDocument();
+
+    void number_QString_data() { numberData(); }
+    void number_QString();
+    void number_QByteArray_data() { numberData(); }
+    void number_QByteArray();
+    void number_QTextStream_data() { numberData(); }
+    void number_QTextStream();
+
+private:
+    void numberData();
 };
 
 static QString data()
@@ -65,6 +90,150 @@ void tst_QLocale::toUpper_QString()
     QBENCHMARK { LOOP(s.toUpper()) }
 }
 
+// Numbers as they appear in CSV and JSON files: prices with two decimals,
+// coordinates with the shortest representation of an arbitrary double, and
+// physical quantities in scientific notation.
+void tst_QLocale::numberData()
+{
+    QTest::addColumn<QVector<double> >("numbers");
+
+    const int count = 10000;
+    QVector<double> prices, coordinates, scientific;
+    quint64 state = 1;
+    for (int i = 0; i < count; ++i) {
+        state = state * Q_UINT64_C(6364136223846793005) + Q_UINT64_C(1442695040888963407);
+        const quint32 r = quint32(state >> 32);
+        prices.append(QString::number((r % 1000000) / 100.0, 'f', 2).toDouble());
+        coordinates.append((r / 4294967296.0) * 360.0 - 180.0);
+        scientific.append((r % 100000) / 10000.0 * qPow(10.0, int(r % 61) - 30));
+    }
+    QTest::newRow("prices") << prices;
+    QTest::newRow("coordinates") << coordinates;
+    QTest::newRow("scientific") << scientific;
+}
+
+static QStringList toStrings(const QVector<double> &numbers)
+{
+    QStringList strings;
+    for (double d : numbers)
+        strings.append(QString::number(d, 'g', QLocale::FloatingPointShortest));
+    return strings;
+}
+
+void tst_QLocale::toDouble_QString()
+{
+    QFETCH(QVector<double>, numbers);
+    const QStringList strings = toStrings(numbers);
+
+    double sum = 0;
+    QBENCHMARK {
+        for (const QString &s : strings)
+            sum += s.toDouble();
+    }
+    QVERIFY(sum != 0);
+}
+
+void tst_QLocale::toDouble_QByteArray()
+{
+    QFETCH(QVector<double>, numbers);
+    QByteArrayList strings;
+    for (const QString &s : toStrings(numbers))
+        strings.append(s.toLatin1());
+
+    double sum = 0;
+    QBENCHMARK {
+        for (const QByteArray &s : strings)
+            sum += s.toDouble();
+    }
+    QVERIFY(sum != 0);
+}
+
+void tst_QLocale::toDouble_QLocale()
+{
+    QFETCH(QVector<double>, numbers);
+    const QStringList strings = toStrings(numbers);
+    const QLocale c = QLocale::c();
+
+    double sum = 0;
+    QBENCHMARK {
+        for (const QString &s : strings)
+            sum += c.toDouble(s);
+    }
+    QVERIFY(sum != 0);
+}
+
+void tst_QLocale::toDouble_QTextStream()
+{
+    QFETCH(QVector<double>, numbers);
+    const QString text = toStrings(numbers).join(QLatin1Char(','));
+
+    double sum = 0;
+    QBENCHMARK {
+        QString copy = text;
+        QTextStream stream(&copy, QIODevice::ReadOnly);
+        QChar separator;
+        double d;
+        while (!stream.atEnd()) {
+            stream >> d >> separator;
+            sum += d;
+        }
+    }
+    QVERIFY(sum != 0);
+}
+
+void tst_QLocale::toDouble_QJsonDocument()
+{
+    QFETCH(QVector<double>, numbers);
+    const QByteArray json = '[' + toStrings(numbers).join(QLatin1Char(',')).toLatin1() + ']';
+
+    double sum = 0;
+    QBENCHMARK {
+        const QJsonArray array = QJsonDocument::fromJson(json).array();
+        for (const QJsonValue &value : array)
+            sum += value.toDouble();
+    }
+    QVERIFY(sum != 0);
+}
+
+void tst_QLocale::number_QString()
+{
+    QFETCH(QVector<double>, numbers);
+
+    int length = 0;
+    QBENCHMARK {
+        for (double d : numbers)
+            length += QString::number(d, 'g', QLocale::FloatingPointShortest).size();
+    }
+    QVERIFY(length);
+}
+
+void tst_QLocale::number_QByteArray()
+{
+    QFETCH(QVector<double>, numbers);
+
+    int length = 0;
+    QBENCHMARK {
+        for (double d : numbers)
+            length += QByteArray::number(d, 'g', QLocale::FloatingPointShortest).size();
+    }
+    QVERIFY(length);
+}
+
+void tst_QLocale::number_QTextStream()
+{
+    QFETCH(QVector<double>, numbers);
+
+    QString text;
+    QBENCHMARK {
+        text.clear();
+        QTextStream stream(&text);
+        stream.setRealNumberPrecision(17);
+        for (double d : numbers)
+            stream << d << ',';
+    }
+    QVERIFY(!text.isEmpty());
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "main.moc"
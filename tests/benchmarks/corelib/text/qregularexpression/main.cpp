@@ -0,0 +1,140 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QRegularExpression>
+#include <QString>
+#include <QThread>
+
+#include <private/qregularexpression_p.h>
+
+#include <qtest.h>
+
+class tst_QRegularExpression : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void firstMatch_data();
+    void firstMatch();
+    void firstMatchUncached_data() { firstMatch_data(); }
+    void firstMatchUncached();
+    void firstMatchThreads_data() { firstMatch_data(); }
+    void firstMatchThreads();
+
+    void cleanupTestCase();
+};
+
+void tst_QRegularExpression::firstMatch_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<QString>("subject");
+
+    QTest::newRow("literal")
+        << QStringLiteral("needle")
+        << QStringLiteral("a haystack with a needle in it");
+    QTest::newRow("email")
+        << QStringLiteral("\\b([a-z0-9._%+-]+)@([a-z0-9.-]+\\.[a-z]{2,})\\b")
+        << QStringLiteral("please write to joe.doe@example.com by Friday");
+    QTest::newRow("date")
+        << QStringLiteral("^(?<year>\\d{4})-(?<month>\\d{2})-(?<day>\\d{2})(?:T(\\d{2}):(\\d{2}):(\\d{2}))?$")
+        << QStringLiteral("2019-10-17T12:34:56");
+    QTest::newRow("alternation")
+        << QStringLiteral("\\b(?:alpha|bravo|charlie|delta|echo|foxtrot|golf|hotel|india|juliett"
+                          "|kilo|lima|mike|november|oscar|papa|quebec|romeo|sierra|tango)\\b")
+        << QStringLiteral("the last word is tango");
+}
+
+// Constructing a regular expression and running its first match is what
+// code that builds QRegularExpression objects on the fly pays every time.
+// With the cache, only the first iteration compiles the pattern.
+void tst_QRegularExpression::firstMatch()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QString, subject);
+
+    QRegularExpressionCache::clear();
+    QBENCHMARK {
+        const QRegularExpression re(pattern);
+        QVERIFY(re.match(subject).hasMatch());
+    }
+}
+
+void tst_QRegularExpression::firstMatchUncached()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QString, subject);
+
+    const int maxCost = QRegularExpressionCache::statistics().maxCost;
+    QRegularExpressionCache::setMaxCost(0);
+    QBENCHMARK {
+        const QRegularExpression re(pattern);
+        QVERIFY(re.match(subject).hasMatch());
+    }
+    QRegularExpressionCache::setMaxCost(maxCost);
+}
+
+// Every thread creates its own QRegularExpression for the same pattern;
+// the compiled pattern and its JIT code are shared between them.
+void tst_QRegularExpression::firstMatchThreads()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QString, subject);
+
+    enum { Iterations = 1000 };
+    const int threadCount = qMax(2, QThread::idealThreadCount());
+
+    QRegularExpressionCache::clear();
+    QBENCHMARK {
+        QAtomicInt failures;
+        QVector<QThread *> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads.append(QThread::create([&]() {
+                for (int j = 0; j < Iterations; ++j) {
+                    if (!QRegularExpression(pattern).match(subject).hasMatch())
+                        failures.ref();
+                }
+            }));
+            threads.last()->start();
+        }
+        for (QThread *thread : qAsConst(threads))
+            thread->wait();
+        qDeleteAll(threads);
+        QCOMPARE(failures.loadRelaxed(), 0);
+    }
+}
+
+void tst_QRegularExpression::cleanupTestCase()
+{
+    const QRegularExpressionCache::Statistics stats = QRegularExpressionCache::statistics();
+    qDebug("compiled pattern cache: %llu hits, %llu misses, %d patterns, %d of %d bytes",
+           stats.hits, stats.misses, stats.count, stats.totalCost, stats.maxCost);
+}
+
+QTEST_MAIN(tst_QRegularExpression)
+
+#include "main.moc"
@@ -0,0 +1,195 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QRandomGenerator>
+#include <QRope>
+#include <QString>
+#include <QTest>
+#include <QVector>
+
+class tst_QRope : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void insert_data() { sizeData(); }
+    void insert() { insert_template<QString>(); }
+    void insert_rope_data() { sizeData(); }
+    void insert_rope() { insert_template<QRope>(); }
+
+    void remove_data() { sizeData(); }
+    void remove() { remove_template<QString>(); }
+    void remove_rope_data() { sizeData(); }
+    void remove_rope() { remove_template<QRope>(); }
+
+    void typing_data() { sizeData(); }
+    void typing() { typing_template<QString>(); }
+    void typing_rope_data() { sizeData(); }
+    void typing_rope() { typing_template<QRope>(); }
+
+    void mid_data() { sizeData(); }
+    void mid() { mid_template<QString>(); }
+    void mid_rope_data() { sizeData(); }
+    void mid_rope() { mid_template<QRope>(); }
+
+    void randomEdits_data() { sizeData(); }
+    void randomEdits() { randomEdits_template<QString>(); }
+    void randomEdits_rope_data() { sizeData(); }
+    void randomEdits_rope() { randomEdits_template<QRope>(); }
+
+private:
+    void sizeData();
+    template <typename String> void insert_template();
+    template <typename String> void remove_template();
+    template <typename String> void typing_template();
+    template <typename String> void mid_template();
+    template <typename String> void randomEdits_template();
+};
+
+enum { EditCount = 1000 };
+
+void tst_QRope::sizeData()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("1M") << (1 << 20);
+    QTest::newRow("16M") << (16 << 20);
+}
+
+// Lines of a log file, as the text to edit.
+static QString buffer(int size)
+{
+    static const char line[] = "2020-04-01 12:00:00.000 info  network: request finished in 12 ms\n";
+    QString str;
+    str.reserve(size);
+    while (str.size() < size)
+        str += QLatin1String(line);
+    str.truncate(size);
+    return str;
+}
+
+static QVector<int> positions(int size)
+{
+    QRandomGenerator rng(size);
+    QVector<int> result;
+    for (int i = 0; i < EditCount; ++i)
+        result.append(int(rng.bounded(size)));
+    return result;
+}
+
+template <typename String> void tst_QRope::insert_template()
+{
+    QFETCH(int, size);
+    const QString text = buffer(size);
+    const QVector<int> pos = positions(size);
+    const QString inserted = QStringLiteral("inserted text, ");
+
+    QBENCHMARK {
+        String str(text);
+        for (int i : pos)
+            str.insert(i, inserted);
+    }
+}
+
+template <typename String> void tst_QRope::remove_template()
+{
+    QFETCH(int, size);
+    const QString text = buffer(size);
+    const QVector<int> pos = positions(size - 100 * EditCount);
+
+    QBENCHMARK {
+        String str(text);
+        for (int i : pos)
+            str.remove(i, 100);
+    }
+}
+
+// Characters inserted one at a time at a few places, like a user typing.
+template <typename String> void tst_QRope::typing_template()
+{
+    QFETCH(int, size);
+    const QString text = buffer(size);
+    const QVector<int> pos = positions(size);
+    const QString typed = QStringLiteral("the quick brown fox ");
+
+    QBENCHMARK {
+        String str(text);
+        for (int i = 0; i < EditCount; i += typed.size()) {
+            for (int j = 0; j < typed.size(); ++j)
+                str.insert(pos.at(i) + j, typed.at(j));
+        }
+    }
+}
+
+template <typename String> void tst_QRope::mid_template()
+{
+    QFETCH(int, size);
+    const String str(buffer(size));
+    const QVector<int> pos = positions(size);
+
+    qsizetype total = 0;
+    QBENCHMARK {
+        for (int i : pos)
+            total += str.mid(i, 65536).size();
+    }
+    QVERIFY(total);
+}
+
+// A mix of insertions, removals and copies, with a copy of the whole text
+// kept for undo every hundred edits.
+template <typename String> void tst_QRope::randomEdits_template()
+{
+    QFETCH(int, size);
+    const QString text = buffer(size);
+    const QVector<int> pos = positions(size / 2);
+    const QString inserted = QStringLiteral("inserted text, ");
+
+    QBENCHMARK {
+        String str(text);
+        String undo;
+        for (int i = 0; i < EditCount; ++i) {
+            if (i % 100 == 0)
+                undo = str;
+            switch (i % 3) {
+            case 0:
+                str.insert(pos.at(i), inserted);
+                break;
+            case 1:
+                str.remove(pos.at(i), 50);
+                break;
+            case 2:
+                str.replace(pos.at(i), 10, inserted);
+                break;
+            }
+        }
+    }
+}
+
+QTEST_MAIN(tst_QRope)
+
+#include "main.moc"
@@ -0,0 +1,225 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QHash>
+#include <QSmallString>
+#include <QString>
+#include <QTest>
+#include <QVector>
+
+#include <algorithm>
+
+#if defined(__GLIBC__)
+#  include <malloc.h>
+#  if __GLIBC_PREREQ(2, 33)
+#    define HAVE_MALLINFO2
+#  endif
+#endif
+
+class tst_QSmallString : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void construct_data() { lengthData(); }
+    void construct() { construct_template<QString>(); }
+    void construct_small_data() { lengthData(); }
+    void construct_small() { construct_template<QSmallString>(); }
+
+    void copy_data() { lengthData(); }
+    void copy() { copy_template<QString>(); }
+    void copy_small_data() { lengthData(); }
+    void copy_small() { copy_template<QSmallString>(); }
+
+    void sort_data() { lengthData(); }
+    void sort() { sort_template<QString>(); }
+    void sort_small_data() { lengthData(); }
+    void sort_small() { sort_template<QSmallString>(); }
+
+    void hashLookup_data() { lengthData(); }
+    void hashLookup() { hashLookup_template<QString>(); }
+    void hashLookup_small_data() { lengthData(); }
+    void hashLookup_small() { hashLookup_template<QSmallString>(); }
+
+    void memory_data() { lengthData(); }
+    void memory() { memory_template<QString>(); }
+    void memory_small_data() { lengthData(); }
+    void memory_small() { memory_template<QSmallString>(); }
+
+    void memory_bytearray_data() { lengthData(); }
+    void memory_bytearray() { memory_bytes_template<QByteArray>(); }
+    void memory_bytearray_small_data() { lengthData(); }
+    void memory_bytearray_small() { memory_bytes_template<QSmallByteArray>(); }
+
+private:
+    void lengthData();
+    template <typename String> void construct_template();
+    template <typename String> void copy_template();
+    template <typename String> void sort_template();
+    template <typename String> void hashLookup_template();
+    template <typename String> void memory_template();
+    template <typename ByteArray> void memory_bytes_template();
+};
+
+enum { Count = 100000 };
+
+void tst_QSmallString::lengthData()
+{
+    QTest::addColumn<int>("length");
+
+    QTest::newRow("3") << 3;
+    QTest::newRow("8") << 8;
+    QTest::newRow("inline-capacity") << int(QSmallString::InlineCapacity);
+    QTest::newRow("32") << 32;
+}
+
+// Count distinct identifier-like strings of the given length.
+static QVector<QString> words(int length)
+{
+    static const char letters[] = "abcdefghijklmnopqrstuvwxyz_0123456789";
+    QVector<QString> result;
+    result.reserve(Count);
+    for (int i = 0; i < Count; ++i) {
+        QString word(length, Qt::Uninitialized);
+        quint64 n = quint64(i) * 2654435761U;
+        for (int j = 0; j < length; ++j) {
+            word[j] = QLatin1Char(letters[n % 37]);
+            n = n / 37 + quint64(i + j);
+        }
+        result.append(word);
+    }
+    return result;
+}
+
+template <typename String> void tst_QSmallString::construct_template()
+{
+    QFETCH(int, length);
+    const QVector<QString> source = words(length);
+
+    QBENCHMARK {
+        QVector<String> strings;
+        strings.reserve(Count);
+        for (const QString &word : source)
+            strings.append(String(word.constData(), word.size()));
+    }
+}
+
+template <typename String> void tst_QSmallString::copy_template()
+{
+    QFETCH(int, length);
+    const QVector<QString> source = words(length);
+    const QVector<String> strings(source.begin(), source.end());
+
+    QBENCHMARK {
+        // detaching copies every element
+        QVector<String> copy = strings;
+        copy.detach();
+    }
+}
+
+template <typename String> void tst_QSmallString::sort_template()
+{
+    QFETCH(int, length);
+    const QVector<QString> source = words(length);
+    const QVector<String> strings(source.begin(), source.end());
+
+    QBENCHMARK {
+        QVector<String> copy = strings;
+        std::sort(copy.begin(), copy.end());
+    }
+}
+
+template <typename String> void tst_QSmallString::hashLookup_template()
+{
+    QFETCH(int, length);
+    const QVector<QString> source = words(length);
+    const QVector<String> strings(source.begin(), source.end());
+    QHash<String, int> hash;
+    for (int i = 0; i < Count; ++i)
+        hash.insert(strings.at(i), i);
+
+    qint64 sum = 0;
+    QBENCHMARK {
+        for (const String &key : strings)
+            sum += hash.value(key);
+    }
+    QVERIFY(sum);
+}
+
+#ifdef HAVE_MALLINFO2
+// The heap memory in use, as the C library sees it, including the
+// allocator's overhead per block.
+static size_t heapInUse()
+{
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+#endif
+
+template <typename String> void tst_QSmallString::memory_template()
+{
+#ifdef HAVE_MALLINFO2
+    QFETCH(int, length);
+    const QVector<QString> source = words(length);
+    const size_t before = heapInUse();
+    QVector<String> strings;
+    strings.reserve(Count);
+    for (const QString &word : source)
+        strings.append(String(word.constData(), word.size()));
+    const size_t after = heapInUse();
+    QTest::setBenchmarkResult(qreal(after - before) / Count, QTest::BytesAllocated);
+#else
+    QSKIP("Measuring the memory footprint needs glibc 2.33 or later");
+#endif
+}
+
+template <typename ByteArray> void tst_QSmallString::memory_bytes_template()
+{
+#ifdef HAVE_MALLINFO2
+    QFETCH(int, length);
+    const QVector<QString> source = words(length);
+    QVector<QByteArray> latin1;
+    latin1.reserve(Count);
+    for (const QString &word : source)
+        latin1.append(word.toLatin1());
+
+    const size_t before = heapInUse();
+    QVector<ByteArray> arrays;
+    arrays.reserve(Count);
+    for (const QByteArray &word : latin1)
+        arrays.append(ByteArray(word.constData(), word.size()));
+    const size_t after = heapInUse();
+    QTest::setBenchmarkResult(qreal(after - before) / Count, QTest::BytesAllocated);
+#else
+    QSKIP("Measuring the memory footprint needs glibc 2.33 or later");
+#endif
+}
+
+QTEST_APPLESS_MAIN(tst_QSmallString)
+
+#include "main.moc"
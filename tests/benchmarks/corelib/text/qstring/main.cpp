@@ -48,6 +48,10 @@ private slots:
     void toLower();
     void toCaseFolded_data();
     void toCaseFolded();
+    void fromUtf8_data();
+    void fromUtf8();
+    void toUtf8_data();
+    void toUtf8();
 
 private:
     void section_data_impl(bool includeRegExOnly = true);
@@ -188,6 +192,57 @@ void tst_QString::toCaseFolded()
     }
 }
 
+void tst_QString::fromUtf8_data()
+{
+    QTest::addColumn<QByteArray>("utf8");
+
+    // about 4 kB of text each, mostly in a single script
+    const auto row = [](const char *name, const char *piece) {
+        QByteArray text;
+        while (text.size() < 4096)
+            text += piece;
+        QTest::newRow(name) << text;
+    };
+
+    row("ascii", "The quick brown fox jumps over the lazy dog. ");
+    row("latin1", "Falsches \303\234ben von Xylophonmusik qu\303\244lt jeden gr\303\266\303\237eren Zwerg. ");
+    row("cyrillic", "\320\241\321\212\320\265\321\210\321\214 \320\266\320\265 \320\265\321\211\321\221 "
+                    "\321\215\321\202\320\270\321\205 \320\274\321\217\320\263\320\272\320\270\321\205 "
+                    "\321\204\321\200\320\260\320\275\321\206\321\203\320\267\321\201\320\272\320\270\321\205 "
+                    "\320\261\321\203\320\273\320\276\320\272. ");
+    row("cjk", "\346\227\245\346\234\254\350\252\236\343\201\256\346\226\207\347\253\240\343\200\202"
+               "\344\270\255\346\226\207\346\226\207\346\234\254\343\200\202");
+    row("json-cjk", "{\"id\": 42, \"name\": \"\346\235\261\344\272\254\", \"tags\": [\"\351\247\205\", "
+                    "\"\345\205\254\345\234\222\"], \"open\": true}, ");
+    row("emoji", "\360\237\230\200\360\237\221\215\360\237\216\211 ok ");
+}
+
+void tst_QString::fromUtf8()
+{
+    QFETCH(QByteArray, utf8);
+
+    QBENCHMARK {
+        const QString result = QString::fromUtf8(utf8);
+        Q_UNUSED(result);
+    }
+}
+
+void tst_QString::toUtf8_data()
+{
+    fromUtf8_data();
+}
+
+void tst_QString::toUtf8()
+{
+    QFETCH(QByteArray, utf8);
+    const QString s = QString::fromUtf8(utf8);
+
+    QBENCHMARK {
+        const QByteArray result = s.toUtf8();
+        Q_UNUSED(result);
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "main.moc"
@@ -0,0 +1,240 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QByteArray>
+#include <QByteArrayMatcher>
+#include <QMultiByteArrayMatcher>
+#include <QMultiStringMatcher>
+#include <QString>
+#include <QStringList>
+#include <QStringMatcher>
+
+#include <qtest.h>
+
+class tst_QStringMatcher : public QObject
+{
+    Q_OBJECT
+
+    QByteArray latin1Haystack;
+    QString haystack;
+
+private slots:
+    void initTestCase();
+
+    void indexOf_data();
+    void indexOf();
+    void matcher_data() { indexOf_data(); }
+    void matcher();
+    void latin1IndexOf_data() { indexOf_data(); }
+    void latin1IndexOf();
+    void byteArrayIndexOf_data();
+    void byteArrayIndexOf();
+    void byteArrayMatcher_data() { byteArrayIndexOf_data(); }
+    void byteArrayMatcher();
+
+    void stringMatcherLoop_data();
+    void stringMatcherLoop();
+    void multiStringMatcher_data() { stringMatcherLoop_data(); }
+    void multiStringMatcher();
+    void byteArrayMatcherLoop_data() { stringMatcherLoop_data(); }
+    void byteArrayMatcherLoop();
+    void multiByteArrayMatcher_data() { stringMatcherLoop_data(); }
+    void multiByteArrayMatcher();
+};
+
+void tst_QStringMatcher::initTestCase()
+{
+    // 4 MB of text in which none of the needles below occurs
+    const QByteArray sentence = "The quick brown fox jumps over the lazy dog, then naps in the sun. ";
+    while (latin1Haystack.size() < 4 * 1024 * 1024)
+        latin1Haystack += sentence;
+    haystack = QString::fromLatin1(latin1Haystack);
+}
+
+void tst_QStringMatcher::indexOf_data()
+{
+    QTest::addColumn<QString>("needle");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+
+    const QString needles[] = {
+        QStringLiteral("dx"),
+        QStringLiteral("lazy cat"),
+        QStringLiteral("The quick brown fox jumps over the lazy cat"),
+        QStringLiteral("then naps in the sun. The quick brown fox jumps over the lazy dog, then sleeps"),
+    };
+    for (const QString &needle : needles) {
+        QTest::addRow("cs-%d", int(needle.size())) << needle << Qt::CaseSensitive;
+        QTest::addRow("ci-%d", int(needle.size())) << needle.toUpper() << Qt::CaseInsensitive;
+    }
+}
+
+void tst_QStringMatcher::indexOf()
+{
+    QFETCH(QString, needle);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    QBENCHMARK {
+        QCOMPARE(haystack.indexOf(needle, 0, cs), -1);
+    }
+}
+
+void tst_QStringMatcher::matcher()
+{
+    QFETCH(QString, needle);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    const QStringMatcher matcher(needle, cs);
+    QBENCHMARK {
+        QCOMPARE(matcher.indexIn(haystack), -1);
+    }
+}
+
+void tst_QStringMatcher::latin1IndexOf()
+{
+    QFETCH(QString, needle);
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    const QByteArray latin1Needle = needle.toLatin1();
+    const QLatin1String h(latin1Haystack);
+    const QLatin1String n(latin1Needle);
+    QBENCHMARK {
+        QCOMPARE(h.indexOf(n, 0, cs), -1);
+    }
+}
+
+void tst_QStringMatcher::byteArrayIndexOf_data()
+{
+    QTest::addColumn<QByteArray>("needle");
+
+    QTest::newRow("2") << QByteArray("dx");
+    QTest::newRow("8") << QByteArray("lazy cat");
+    QTest::newRow("43") << QByteArray("The quick brown fox jumps over the lazy cat");
+    QTest::newRow("255") << QByteArray(255, 'x');
+}
+
+void tst_QStringMatcher::byteArrayIndexOf()
+{
+    QFETCH(QByteArray, needle);
+
+    QBENCHMARK {
+        QCOMPARE(latin1Haystack.indexOf(needle), -1);
+    }
+}
+
+void tst_QStringMatcher::byteArrayMatcher()
+{
+    QFETCH(QByteArray, needle);
+
+    const QByteArrayMatcher matcher(needle);
+    QBENCHMARK {
+        QCOMPARE(matcher.indexIn(latin1Haystack), -1);
+    }
+}
+
+// Keywords of which two in a hundred occur in the haystack
+static QStringList keywords(int count)
+{
+    const QStringList words = QStringLiteral("quick lazy").split(QLatin1Char(' '));
+    QStringList result;
+    for (int i = 0; i < count; ++i) {
+        if (i % 50 < 2)
+            result += words.at(i % 50);
+        else
+            result += QStringLiteral("keyword%1").arg(i);
+    }
+    return result;
+}
+
+void tst_QStringMatcher::stringMatcherLoop_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+
+    for (int count : { 1, 10, 100, 500 })
+        QTest::addRow("%d", count) << keywords(count);
+}
+
+void tst_QStringMatcher::stringMatcherLoop()
+{
+    QFETCH(QStringList, patterns);
+
+    QVector<QStringMatcher> matchers;
+    for (const QString &pattern : qAsConst(patterns))
+        matchers += QStringMatcher(pattern);
+    QBENCHMARK {
+        qsizetype found = 0;
+        for (const QStringMatcher &matcher : qAsConst(matchers)) {
+            for (qsizetype i = matcher.indexIn(haystack); i >= 0; i = matcher.indexIn(haystack, i + 1))
+                ++found;
+        }
+        QVERIFY(found > 0);
+    }
+}
+
+void tst_QStringMatcher::multiStringMatcher()
+{
+    QFETCH(QStringList, patterns);
+
+    const QMultiStringMatcher matcher(patterns);
+    QBENCHMARK {
+        QVERIFY(!matcher.matches(haystack).isEmpty());
+    }
+}
+
+void tst_QStringMatcher::byteArrayMatcherLoop()
+{
+    QFETCH(QStringList, patterns);
+
+    QVector<QByteArrayMatcher> matchers;
+    for (const QString &pattern : qAsConst(patterns))
+        matchers += QByteArrayMatcher(pattern.toLatin1());
+    QBENCHMARK {
+        qsizetype found = 0;
+        for (const QByteArrayMatcher &matcher : qAsConst(matchers)) {
+            for (int i = matcher.indexIn(latin1Haystack); i >= 0; i = matcher.indexIn(latin1Haystack, i + 1))
+                ++found;
+        }
+        QVERIFY(found > 0);
+    }
+}
+
+void tst_QStringMatcher::multiByteArrayMatcher()
+{
+    QFETCH(QStringList, patterns);
+
+    QByteArrayList latin1Patterns;
+    for (const QString &pattern : qAsConst(patterns))
+        latin1Patterns += pattern.toLatin1();
+    const QMultiByteArrayMatcher matcher(latin1Patterns);
+    QBENCHMARK {
+        QVERIFY(!matcher.matches(latin1Haystack).isEmpty());
+    }
+}
+
+QTEST_MAIN(tst_QStringMatcher)
+
+#include "main.moc"
@@ -0,0 +1,6 @@
+TEMPLATE = app
+TARGET = tst_bench_qstringmatcher
+
+QT = core testlib
+
+SOURCES += main.cpp
@@ -0,0 +1,228 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringPool>
+#include <QTest>
+#include <QVector>
+#include <QXmlStreamReader>
+
+#if defined(__GLIBC__)
+#  include <malloc.h>
+#  if __GLIBC_PREREQ(2, 33)
+#    define HAVE_MALLINFO2
+#  endif
+#endif
+
+class tst_QStringPool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void xmlNames_data() { poolData(); }
+    void xmlNames();
+    void xmlNamesMemory_data() { poolData(); }
+    void xmlNamesMemory();
+    void jsonKeysMemory_data() { poolData(); }
+    void jsonKeysMemory();
+    void httpFieldNames_data() { poolData(); }
+    void httpFieldNames();
+    void httpFieldNamesMemory_data() { poolData(); }
+    void httpFieldNamesMemory();
+
+private:
+    void poolData();
+    QVector<QString> readXmlNames(QStringPool *pool) const;
+    QVector<QByteArray> splitFieldNames(QByteArrayPool *pool) const;
+
+    QByteArray xml;
+    QByteArray json;
+    QByteArray headers;
+};
+
+enum { RecordCount = 20000 };
+
+// Generated records with the field names that a typical REST or feed API
+// uses, and values that differ from record to record.
+void tst_QStringPool::initTestCase()
+{
+    static const char *const fields[] = {
+        "id", "name", "email", "created_at", "updated_at", "status", "owner", "tags"
+    };
+
+    QByteArray x = "<?xml version=\"1.0\"?>\n<records>\n";
+    QJsonArray records;
+    for (int i = 0; i < RecordCount; ++i) {
+        QJsonObject record;
+        x += "  <record>";
+        for (const char *field : fields) {
+            const QByteArray value = QByteArray::number(i * 31 + int(qstrlen(field)));
+            record.insert(QLatin1String(field), QString::fromLatin1(value));
+            x += '<' + QByteArray(field) + '>' + value + "</" + QByteArray(field) + '>';
+        }
+        x += "</record>\n";
+        records.append(record);
+    }
+    x += "</records>\n";
+    xml = x;
+    json = QJsonDocument(records).toJson(QJsonDocument::Compact);
+
+    static const char *const responseHeaders[] = {
+        "Date", "Content-Type", "Content-Length", "Connection", "Cache-Control",
+        "ETag", "Vary", "Server", "Set-Cookie", "Strict-Transport-Security"
+    };
+    for (int i = 0; i < RecordCount; ++i) {
+        for (const char *field : responseHeaders)
+            headers += QByteArray(field) + ": " + QByteArray::number(i) + "\r\n";
+    }
+}
+
+void tst_QStringPool::poolData()
+{
+    QTest::addColumn<bool>("pooled");
+
+    QTest::newRow("copies") << false;
+    QTest::newRow("pooled") << true;
+}
+
+QVector<QString> tst_QStringPool::readXmlNames(QStringPool *pool) const
+{
+    QVector<QString> names;
+    QXmlStreamReader reader(xml);
+    while (!reader.atEnd()) {
+        if (reader.readNext() == QXmlStreamReader::StartElement)
+            names.append(pool ? pool->intern(reader.name()) : reader.name().toString());
+    }
+    return names;
+}
+
+QVector<QByteArray> tst_QStringPool::splitFieldNames(QByteArrayPool *pool) const
+{
+    QVector<QByteArray> names;
+    const char *begin = headers.constData();
+    const char *const end = begin + headers.size();
+    while (begin < end) {
+        const char *colon = static_cast<const char *>(memchr(begin, ':', size_t(end - begin)));
+        const char *eol = static_cast<const char *>(memchr(colon, '\n', size_t(end - colon)));
+        names.append(pool ? pool->intern(begin, colon - begin)
+                          : QByteArray(begin, int(colon - begin)));
+        begin = eol + 1;
+    }
+    return names;
+}
+
+void tst_QStringPool::xmlNames()
+{
+    QFETCH(bool, pooled);
+    QStringPool pool;
+
+    QBENCHMARK {
+        const QVector<QString> names = readXmlNames(pooled ? &pool : nullptr);
+        Q_UNUSED(names);
+    }
+}
+
+void tst_QStringPool::httpFieldNames()
+{
+    QFETCH(bool, pooled);
+    QByteArrayPool pool;
+
+    QBENCHMARK {
+        const QVector<QByteArray> names = splitFieldNames(pooled ? &pool : nullptr);
+        Q_UNUSED(names);
+    }
+}
+
+#ifdef HAVE_MALLINFO2
+// The heap memory in use, as the C library sees it, including the
+// allocator's overhead per block.
+static size_t heapInUse()
+{
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+#endif
+
+// The memory that the names of the whole corpus keep alive, including the
+// pool, per name.
+void tst_QStringPool::xmlNamesMemory()
+{
+#ifdef HAVE_MALLINFO2
+    QFETCH(bool, pooled);
+    const size_t before = heapInUse();
+    QStringPool pool;
+    const QVector<QString> names = readXmlNames(pooled ? &pool : nullptr);
+    const size_t after = heapInUse();
+    QTest::setBenchmarkResult(qreal(after - before) / names.size(), QTest::BytesAllocated);
+#else
+    QSKIP("Measuring the memory footprint needs glibc 2.33 or later");
+#endif
+}
+
+void tst_QStringPool::jsonKeysMemory()
+{
+#ifdef HAVE_MALLINFO2
+    QFETCH(bool, pooled);
+    const QJsonArray records = QJsonDocument::fromJson(json).array();
+
+    const size_t before = heapInUse();
+    QStringPool pool;
+    QVector<QString> keys;
+    for (const QJsonValue &record : records) {
+        const QJsonObject object = record.toObject();
+        for (auto it = object.constBegin(), end = object.constEnd(); it != end; ++it)
+            keys.append(pooled ? pool.intern(it.key()) : it.key());
+    }
+    const size_t after = heapInUse();
+    QTest::setBenchmarkResult(qreal(after - before) / keys.size(), QTest::BytesAllocated);
+#else
+    QSKIP("Measuring the memory footprint needs glibc 2.33 or later");
+#endif
+}
+
+void tst_QStringPool::httpFieldNamesMemory()
+{
+#ifdef HAVE_MALLINFO2
+    QFETCH(bool, pooled);
+    const size_t before = heapInUse();
+    QByteArrayPool pool;
+    const QVector<QByteArray> names = splitFieldNames(pooled ? &pool : nullptr);
+    const size_t after = heapInUse();
+    QTest::setBenchmarkResult(qreal(after - before) / names.size(), QTest::BytesAllocated);
+#else
+    QSKIP("Measuring the memory footprint needs glibc 2.33 or later");
+#endif
+}
+
+QTEST_MAIN(tst_QStringPool)
+
+#include "main.moc"
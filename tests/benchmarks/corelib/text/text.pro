@@ -3,7 +3,12 @@ SUBDIRS = \
         qbytearray \
         qchar \
         qlocale \
+        qregularexpression \
+        qrope \
+        qsmallstring \
         qstringbuilder \
+        qstringmatcher \
+        qstringpool \
         qstringlist
 
 *g++*: SUBDIRS += qstring
@@ -67,7 +67,8 @@ private slots:
     void readOnly();
     void writeOnly_data();
     void writeOnly();
-    // void readWrite();
+    void readWrite_data();
+    void readWrite();
 };
 
 struct FunctionPtrHolder
@@ -256,5 +257,89 @@ void tst_QReadWriteLock::writeOnly()
     holder.value();
 }
 
+static int writesPerHundred;
+
+template <typename Mutex, typename ReadLocker, typename WriteLocker>
+void testReadWrite()
+{
+    struct Thread : QThread
+    {
+        Mutex *lock;
+        void run() override
+        {
+            for (int i = 0; i < Iterations / 10; ++i) {
+                QString s = QString::number(i); // Do something outside the lock
+                if (i % 100 < writesPerHundred) {
+                    WriteLocker locker(lock);
+                    global_hash.insert(s, s);
+                } else {
+                    ReadLocker locker(lock);
+                    global_hash.contains(s);
+                }
+            }
+        }
+    };
+    Mutex lock;
+    global_hash.clear();
+    std::vector<std::unique_ptr<Thread>> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        auto t = qt_make_unique<Thread>();
+        t->lock = &lock;
+        threads.push_back(std::move(t));
+    }
+    QBENCHMARK {
+        for (auto &t : threads) {
+            t->start();
+        }
+        for (auto &t : threads) {
+            t->wait();
+        }
+    }
+    global_hash.clear();
+}
+
+void tst_QReadWriteLock::readWrite_data()
+{
+    QTest::addColumn<FunctionPtrHolder>("holder");
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("writes");
+
+    const struct {
+        const char *name;
+        FunctionPtrHolder holder;
+    } locks[] = {
+        { "QMutex", testReadWrite<QMutex, QMutexLocker, QMutexLocker> },
+        { "QReadWriteLock", testReadWrite<QReadWriteLock, QReadLocker, QWriteLocker> },
+#ifdef __cpp_lib_shared_mutex
+        { "std::shared_mutex",
+          testReadWrite<std::shared_mutex,
+                        LockerWrapper<std::shared_lock<std::shared_mutex>>,
+                        LockerWrapper<std::unique_lock<std::shared_mutex>>> },
+#endif
+    };
+
+    for (const auto &lock : locks) {
+        for (int threads = 1; threads <= 64; threads *= 2) {
+            for (int writes : { 0, 1, 10 }) {
+                QTest::addRow("%s, %d threads, %d%% writes", lock.name, threads, writes)
+                    << lock.holder << threads << writes;
+            }
+        }
+    }
+}
+
+void tst_QReadWriteLock::readWrite()
+{
+    QFETCH(FunctionPtrHolder, holder);
+    QFETCH(int, threads);
+    QFETCH(int, writes);
+
+    const int idealThreadCount = threadCount;
+    threadCount = threads;
+    writesPerHundred = writes;
+    holder.value();
+    threadCount = idealThreadCount;
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 #include "tst_qreadwritelock.moc"
@@ -40,6 +40,10 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void tinyRunnables_data();
+    void tinyRunnables();
+    void splitRunnables_data();
+    void splitRunnables();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -75,5 +79,62 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+void tst_QThreadPool::tinyRunnables_data()
+{
+    QTest::addColumn<bool>("workStealing");
+    QTest::newRow("shared queue") << false;
+    QTest::newRow("work stealing") << true;
+}
+
+// many tiny runnables started from outside of the pool
+void tst_QThreadPool::tinyRunnables()
+{
+    QFETCH(bool, workStealing);
+    QThreadPool threadPool;
+    threadPool.setWorkStealingEnabled(workStealing);
+    QBENCHMARK {
+        for (int i = 0; i < 100000; ++i)
+            threadPool.start(new NoOpRunnable());
+        threadPool.waitForDone();
+    }
+}
+
+class SplitRunnable : public QRunnable
+{
+public:
+    SplitRunnable(QThreadPool *pool, int depth)
+        : pool(pool), depth(depth)
+    {
+    }
+
+    void run() override {
+        if (depth > 0) {
+            pool->start(new SplitRunnable(pool, depth - 1));
+            pool->start(new SplitRunnable(pool, depth - 1));
+        }
+    }
+
+private:
+    QThreadPool *pool;
+    int depth;
+};
+
+void tst_QThreadPool::splitRunnables_data()
+{
+    tinyRunnables_data();
+}
+
+// many tiny runnables started from the pool's own threads
+void tst_QThreadPool::splitRunnables()
+{
+    QFETCH(bool, workStealing);
+    QThreadPool threadPool;
+    threadPool.setWorkStealingEnabled(workStealing);
+    QBENCHMARK {
+        threadPool.start(new SplitRunnable(&threadPool, 16));
+        threadPool.waitForDone();
+    }
+}
+
 QTEST_MAIN(tst_QThreadPool)
 #include "tst_qthreadpool.moc"
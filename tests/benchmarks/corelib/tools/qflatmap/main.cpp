@@ -0,0 +1,208 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QFlatMap>
+#include <QMap>
+#include <QString>
+#include <QTest>
+
+#if defined(__GLIBC__)
+#  include <malloc.h>
+#  if __GLIBC_PREREQ(2, 33)
+#    define HAVE_MALLINFO2
+#  endif
+#endif
+
+class tst_QFlatMap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void lookup_int_int_data() { sizeData(); }
+    void lookup_int_int() { lookup_int_int_template<QMap<int, int> >(); }
+    void lookup_int_int_flat_data() { sizeData(); }
+    void lookup_int_int_flat() { lookup_int_int_template<QFlatMap<int, int> >(); }
+    void lookup_string_int_data() { sizeData(); }
+    void lookup_string_int() { lookup_string_int_template<QMap<QString, int> >(); }
+    void lookup_string_int_flat_data() { sizeData(); }
+    void lookup_string_int_flat() { lookup_string_int_template<QFlatMap<QString, int> >(); }
+
+    void iteration_data() { sizeData(); }
+    void iteration() { iteration_template<QMap<int, int> >(); }
+    void iteration_flat_data() { sizeData(); }
+    void iteration_flat() { iteration_template<QFlatMap<int, int> >(); }
+
+    void construction_data() { sizeData(); }
+    void construction();
+    void construction_flat_data() { sizeData(); }
+    void construction_flat();
+
+    void memory_int_int_data() { sizeData(); }
+    void memory_int_int() { memory_template<QMap<int, int> >(); }
+    void memory_int_int_flat_data() { sizeData(); }
+    void memory_int_int_flat() { memory_template<QFlatMap<int, int> >(); }
+
+private:
+    void sizeData();
+    template <typename Map> void lookup_int_int_template();
+    template <typename Map> void lookup_string_int_template();
+    template <typename Map> void iteration_template();
+    template <typename Map> void memory_template();
+};
+
+void tst_QFlatMap::sizeData()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("1000000") << 1000000;
+}
+
+// A permutation of [0, size), so that lookups do not walk the keys in order.
+static inline int scattered(int i, int size)
+{
+    return int((quint64(i) * 2654435761U) % quint64(size));
+}
+
+template <typename Map> static Map intMap(int size)
+{
+    QMap<int, int> map;
+    for (int i = 0; i < size; ++i)
+        map.insert(2 * i, i);
+    return Map(map);
+}
+
+static QVector<QString> stringKeys(int size)
+{
+    QVector<QString> keys;
+    keys.reserve(size);
+    for (int i = 0; i < size; ++i)
+        keys.append(QLatin1String("Content-Header-") + QString::number(i));
+    return keys;
+}
+
+template <typename Map> void tst_QFlatMap::lookup_int_int_template()
+{
+    QFETCH(int, size);
+    const Map map = intMap<Map>(size);
+
+    // half of the lookups miss
+    int sum = 0;
+    QBENCHMARK {
+        for (int i = 0; i < size; ++i)
+            sum += map.value(scattered(i, 2 * size));
+    }
+    QVERIFY(sum);
+}
+
+template <typename Map> void tst_QFlatMap::lookup_string_int_template()
+{
+    QFETCH(int, size);
+    const QVector<QString> keys = stringKeys(size);
+    Map map;
+    for (int i = 0; i < size; ++i)
+        map[keys.at(i)] = i;
+
+    int sum = 0;
+    QBENCHMARK {
+        for (int i = 0; i < size; ++i)
+            sum += map.value(keys.at(scattered(i, size)));
+    }
+    QVERIFY(sum || size == 1);
+}
+
+template <typename Map> void tst_QFlatMap::iteration_template()
+{
+    QFETCH(int, size);
+    const Map map = intMap<Map>(size);
+
+    int sum = 0;
+    QBENCHMARK {
+        for (auto it = map.constBegin(), end = map.constEnd(); it != end; ++it)
+            sum += it.value();
+    }
+    QVERIFY(sum);
+}
+
+void tst_QFlatMap::construction()
+{
+    QFETCH(int, size);
+    QVector<int> keys;
+    for (int i = 0; i < size; ++i)
+        keys.append(scattered(i, size));
+
+    QBENCHMARK {
+        QMap<int, int> map;
+        for (int i = 0; i < size; ++i)
+            map.insert(keys.at(i), i);
+    }
+}
+
+void tst_QFlatMap::construction_flat()
+{
+    QFETCH(int, size);
+    QVector<int> keys;
+    QVector<int> values;
+    for (int i = 0; i < size; ++i) {
+        keys.append(scattered(i, size));
+        values.append(i);
+    }
+
+    QBENCHMARK {
+        QFlatMap<int, int> map(keys, values);
+    }
+}
+
+#ifdef HAVE_MALLINFO2
+// The heap memory in use, as the C library sees it, including the
+// allocator's overhead per block and the blocks it maps separately.
+static size_t heapInUse()
+{
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+#endif
+
+template <typename Map> void tst_QFlatMap::memory_template()
+{
+#ifdef HAVE_MALLINFO2
+    QFETCH(int, size);
+    const size_t before = heapInUse();
+    const Map map = intMap<Map>(size);
+    const size_t after = heapInUse();
+    QTest::setBenchmarkResult(qreal(after - before), QTest::BytesAllocated);
+#else
+    QSKIP("Measuring the memory footprint needs glibc 2.33 or later");
+#endif
+}
+
+QTEST_MAIN(tst_QFlatMap)
+
+#include "main.moc"
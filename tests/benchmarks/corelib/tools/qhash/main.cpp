@@ -30,6 +30,7 @@
 #include "main.h"
 
 #include <QFile>
+#include <QFlatHash>
 #include <QHash>
 #include <QString>
 #include <QStringList>
@@ -61,10 +62,40 @@ private slots:
     void hashing_javaString_data() { data(); }
     void hashing_javaString() { hashing_template<JavaString>(); }
 
+    void qflathash_current_data() { data(); }
+    void qflathash_current();
+    void lookup_qhash_data() { data(); }
+    void lookup_qhash() { lookup_template<QHash<QString, int> >(); }
+    void lookup_qflathash_data() { data(); }
+    void lookup_qflathash() { lookup_template<QFlatHash<QString, int> >(); }
+    void insert_qhash_data() { data(); }
+    void insert_qhash() { insert_template<QHash<QString, int> >(); }
+    void insert_qflathash_data() { data(); }
+    void insert_qflathash() { insert_template<QFlatHash<QString, int> >(); }
+
+    void insertInt_qhash_data() { sizeData(); }
+    void insertInt_qhash() { insertInt_template<QHash<int, int> >(); }
+    void insertInt_qflathash_data() { sizeData(); }
+    void insertInt_qflathash() { insertInt_template<QFlatHash<int, int> >(); }
+    void lookupInt_qhash_data() { sizeData(); }
+    void lookupInt_qhash() { lookupInt_template<QHash<int, int> >(); }
+    void lookupInt_qflathash_data() { sizeData(); }
+    void lookupInt_qflathash() { lookupInt_template<QFlatHash<int, int> >(); }
+    void eraseInt_qhash_data() { sizeData(); }
+    void eraseInt_qhash() { eraseInt_template<QHash<int, int> >(); }
+    void eraseInt_qflathash_data() { sizeData(); }
+    void eraseInt_qflathash() { eraseInt_template<QFlatHash<int, int> >(); }
+
 private:
     void data();
+    void sizeData();
     template <typename String> void qhash_template();
     template <typename String> void hashing_template();
+    template <typename Hash> void lookup_template();
+    template <typename Hash> void insert_template();
+    template <typename Hash> void insertInt_template();
+    template <typename Hash> void lookupInt_template();
+    template <typename Hash> void eraseInt_template();
 
     QStringList smallFilePaths;
     QStringList uuids;
@@ -168,6 +199,114 @@ template <typename String> void tst_QHash::hashing_template()
     }
 }
 
+///////////////////// QFlatHash /////////////////////
+
+void tst_QHash::sizeData()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("1K") << 1000;
+    QTest::newRow("10K") << 10000;
+    QTest::newRow("100K") << 100000;
+    QTest::newRow("1M") << 1000000;
+    QTest::newRow("10M") << 10000000;
+    QTest::newRow("100M") << 100000000;
+}
+
+// Sizes above 1M take minutes and gigabytes of memory with QHash, so they
+// are skipped unless QT_BENCHMARK_HUGE_HASHES is set.
+#define SKIP_HUGE_SIZE(size) \
+    if (size > 1000000 && !qEnvironmentVariableIsSet("QT_BENCHMARK_HUGE_HASHES")) \
+        QSKIP("Set QT_BENCHMARK_HUGE_HASHES to run the sizes above 1M")
+
+// Spreads the keys over the whole int range, like pointers or ids would.
+static inline int intKey(int i)
+{
+    return int(uint(i) * 2654435761U);
+}
+
+void tst_QHash::qflathash_current()
+{
+    QFETCH(QStringList, items);
+    QFlatHash<QString, int> hash;
+
+    QBENCHMARK {
+        for (int i = 0, n = items.size(); i != n; ++i)
+            hash[items.at(i)] = i;
+    }
+}
+
+template <typename Hash> void tst_QHash::lookup_template()
+{
+    QFETCH(QStringList, items);
+    Hash hash;
+    for (int i = 0, n = items.size(); i != n; ++i)
+        hash.insert(items.at(i), i);
+
+    int found = 0;
+    QBENCHMARK {
+        for (int i = 0, n = items.size(); i != n; ++i)
+            found += hash.contains(items.at(i));
+    }
+    QVERIFY(found);
+}
+
+// Fills a new hash, so that most insertions add a key.
+template <typename Hash> void tst_QHash::insert_template()
+{
+    QFETCH(QStringList, items);
+
+    QBENCHMARK {
+        Hash hash;
+        for (int i = 0, n = items.size(); i != n; ++i)
+            hash.insert(items.at(i), i);
+    }
+}
+
+template <typename Hash> void tst_QHash::insertInt_template()
+{
+    QFETCH(int, size);
+    SKIP_HUGE_SIZE(size);
+
+    QBENCHMARK {
+        Hash hash;
+        for (int i = 0; i < size; ++i)
+            hash.insert(intKey(i), i);
+    }
+}
+
+template <typename Hash> void tst_QHash::lookupInt_template()
+{
+    QFETCH(int, size);
+    SKIP_HUGE_SIZE(size);
+    Hash hash;
+    for (int i = 0; i < size; ++i)
+        hash.insert(intKey(i), i);
+
+    // half of the lookups miss
+    int found = 0;
+    QBENCHMARK {
+        for (int i = 0; i < size; ++i)
+            found += hash.contains(intKey(i + (i & 1) * size));
+    }
+    QVERIFY(found);
+}
+
+template <typename Hash> void tst_QHash::eraseInt_template()
+{
+    QFETCH(int, size);
+    SKIP_HUGE_SIZE(size);
+    Hash hash;
+    for (int i = 0; i < size; ++i)
+        hash.insert(intKey(i), i);
+
+    QBENCHMARK {
+        Hash copy = hash;
+        for (int i = 0; i < size; ++i)
+            copy.remove(intKey(i));
+    }
+}
+
 QTEST_MAIN(tst_QHash)
 
 #include "main.moc"
@@ -0,0 +1,8 @@
+TEMPLATE = app
+TARGET = tst_bench_qtcpsocket
+
+QT = network core-private testlib
+
+CONFIG += release
+
+SOURCES += tst_qtcpsocket.cpp
@@ -0,0 +1,251 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QThread>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+#include <QtCore/private/qeventdispatcher_unix_p.h>
+#if QT_CONFIG(epoll)
+#  include <QtCore/private/qeventdispatcher_epoll_p.h>
+#endif
+#if QT_CONFIG(io_uring)
+#  include <QtCore/private/qeventdispatcher_iouring_p.h>
+#endif
+
+#include <sys/resource.h>
+
+// Echoes data over a number of loopback connections, all served by the
+// event loop of the thread it lives in.
+class LoopbackRun : public QObject
+{
+    Q_OBJECT
+
+public:
+    LoopbackRun(int connections, qint64 bytesPerConnection)
+        : chunk(16384, '@'), buffer(16384, Qt::Uninitialized),
+          bytesPerConnection(bytesPerConnection), connections(connections),
+          remaining(connections)
+    { }
+
+    qint64 transferred = 0;
+
+public slots:
+    void start();
+
+private:
+    struct ClientState
+    {
+        qint64 sent = 0;
+        qint64 received = 0;
+    };
+
+    void connectClient();
+    void echo(QTcpSocket *socket);
+    void clientReadyRead(QTcpSocket *socket);
+    void finish();
+
+    QTcpServer *server = nullptr;
+    QHash<QTcpSocket *, ClientState> clients;
+    QByteArray chunk;
+    QByteArray buffer;
+    qint64 bytesPerConnection;
+    int connections;
+    int remaining;
+};
+
+void LoopbackRun::start()
+{
+    server = new QTcpServer(this);
+    if (!server->listen(QHostAddress::LocalHost)) {
+        finish();
+        return;
+    }
+    server->setMaxPendingConnections(connections);
+
+    connect(server, &QTcpServer::newConnection, this, [this]() {
+        while (QTcpSocket *socket = server->nextPendingConnection()) {
+            socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+            connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { echo(socket); });
+        }
+    });
+
+    connectClient();
+}
+
+// Clients connect one after another so that the listen backlog never
+// overflows.
+void LoopbackRun::connectClient()
+{
+    QTcpSocket *socket = new QTcpSocket(this);
+    clients.insert(socket, ClientState());
+    connect(socket, &QTcpSocket::connected, this, [this, socket]() {
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        socket->write(chunk);
+        clients[socket].sent += chunk.size();
+        if (clients.size() < connections)
+            connectClient();
+    });
+    connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { clientReadyRead(socket); });
+    connect(socket, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error),
+            this, &LoopbackRun::finish);
+    socket->connectToHost(QHostAddress::LocalHost, server->serverPort());
+}
+
+void LoopbackRun::echo(QTcpSocket *socket)
+{
+    while (socket->bytesAvailable()) {
+        const qint64 n = socket->read(buffer.data(), buffer.size());
+        if (n <= 0)
+            break;
+        socket->write(buffer.constData(), n);
+    }
+}
+
+void LoopbackRun::clientReadyRead(QTcpSocket *socket)
+{
+    ClientState &state = clients[socket];
+    while (socket->bytesAvailable()) {
+        const qint64 n = socket->read(buffer.data(), buffer.size());
+        if (n <= 0)
+            break;
+        state.received += n;
+        transferred += 2 * n;
+    }
+
+    if (state.received < state.sent)
+        return;
+
+    if (state.sent < bytesPerConnection) {
+        socket->write(chunk);
+        state.sent += chunk.size();
+    } else if (--remaining == 0) {
+        finish();
+    }
+}
+
+void LoopbackRun::finish()
+{
+    // this may run from inside a socket's signal emission, so defer the
+    // teardown; QThread deletes the objects before it finishes
+    const QList<QTcpSocket *> sockets = clients.keys();
+    for (QTcpSocket *socket : sockets) {
+        socket->disconnect(this);
+        socket->deleteLater();
+    }
+    clients.clear();
+    if (server)
+        server->deleteLater();
+    server = nullptr;
+    thread()->quit();
+}
+
+class tst_QTcpSocket : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void loopbackThroughput_data();
+    void loopbackThroughput();
+};
+
+void tst_QTcpSocket::initTestCase()
+{
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+void tst_QTcpSocket::loopbackThroughput_data()
+{
+    QTest::addColumn<QByteArray>("dispatcher");
+    QTest::addColumn<int>("connections");
+
+    QByteArrayList dispatchers = { "poll" };
+#if QT_CONFIG(epoll)
+    dispatchers << "epoll";
+#endif
+#if QT_CONFIG(io_uring)
+    dispatchers << "io_uring";
+#endif
+
+    for (int connections : { 1, 64, 512 }) {
+        for (const QByteArray &dispatcher : qAsConst(dispatchers)) {
+            const QByteArray name = dispatcher + '-' + QByteArray::number(connections);
+            QTest::newRow(name.constData()) << dispatcher << connections;
+        }
+    }
+}
+
+void tst_QTcpSocket::loopbackThroughput()
+{
+    QFETCH(QByteArray, dispatcher);
+    QFETCH(int, connections);
+
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && rlim_t(2 * connections + 64) > limit.rlim_cur)
+        QSKIP("Not enough file descriptors available");
+
+    const qint64 totalBytes = Q_INT64_C(64) * 1024 * 1024;
+    const qint64 bytesPerConnection = qMax(totalBytes / connections, qint64(16384));
+
+    QThread thread;
+    QAbstractEventDispatcher *eventDispatcher = nullptr;
+#if QT_CONFIG(epoll)
+    if (dispatcher == "epoll")
+        eventDispatcher = new QEventDispatcherEpoll;
+#endif
+#if QT_CONFIG(io_uring)
+    if (dispatcher == "io_uring")
+        eventDispatcher = new QEventDispatcherIoUring;
+#endif
+    if (!eventDispatcher)
+        eventDispatcher = new QEventDispatcherUNIX;
+    thread.setEventDispatcher(eventDispatcher);
+
+    LoopbackRun run(connections, bytesPerConnection);
+    run.moveToThread(&thread);
+    connect(&thread, &QThread::started, &run, &LoopbackRun::start);
+
+    QElapsedTimer timer;
+    timer.start();
+    thread.start();
+    QVERIFY(thread.wait(120000));
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    QVERIFY(run.transferred >= 2 * bytesPerConnection * connections);
+    QTest::setBenchmarkResult(run.transferred * 1e9 / elapsed, QTest::BytesPerSecond);
+}
+
+QTEST_MAIN(tst_QTcpSocket)
+
+#include "tst_qtcpsocket.moc"
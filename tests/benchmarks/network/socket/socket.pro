@@ -1,4 +1,8 @@
 TEMPLATE = subdirs
 SUBDIRS = \
         qtcpserver \
+        qtcpsocket \
         qudpsocket
+
+!unix|!qtConfig(private_tests): SUBDIRS -= \
+    qtcpsocket